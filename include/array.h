@@ -24,9 +24,31 @@
 #define ARRAY_ASCENDING_ORDER   0
 #define ARRAY_DESCENDING_ORDER  1
 
+#define ARRAY_SET_UNION         0
+#define ARRAY_SET_INTERSECTION  1
+#define ARRAY_SET_DIFFERENCE    2
+#define ARRAY_SET_UNIQUE        3
+
+#define ARRAY_HASH_SET_SIZE     16
+
 #define ARRAY_VERSION "1.7"
 
+/* An open addressing hash set of array elements, with a power of two size. */
+typedef struct {
+    Gua_Object **slot;
+    Gua_Length size;
+} Array_HashSet;
+
+Gua_Short Array_IsHashable(Gua_Object *o);
+unsigned long Array_Hash(Gua_Object *o);
+Gua_Short Array_IsEqual(Gua_Object *o1, Gua_Object *o2);
+void Array_NewHashSet(Array_HashSet *set, Gua_Length n);
+void Array_FreeHashSet(Array_HashSet *set);
+Gua_Short Array_HashSetFind(Array_HashSet *set, Gua_Object *o, Gua_Short insert);
+Gua_Element *Array_AppendElement(Gua_Object *c, Gua_Element *previous, Gua_Integer newKey, Gua_Object *o);
+Gua_Status Array_Contains(Gua_Object *a, Gua_Object *value, Gua_Object *object, Gua_String error);
 Gua_Status Array_Intersection(Gua_Object *a, Gua_Object *b, Gua_Object *c, Gua_String error);
+Gua_Status Array_SetOperation(Gua_Object *a, Gua_Object *b, Gua_Short operation, Gua_Object *c, Gua_String error);
 Gua_Status Array_Sort(Gua_Object *target, Gua_Object *source, Gua_Integer order, Gua_String error);
 Gua_Status Array_ArrayFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object *argv, Gua_Object *object, Gua_String error);
 Gua_Status Array_Init(void *nspace, int argc, char *argv[], char **env, Gua_String error);
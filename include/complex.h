@@ -23,5 +23,15 @@
 
 #define COMPLEX_VERSION "1.4"
 
+#define COMPLEX_FUNCTION_NONE  0
+#define COMPLEX_FUNCTION_ABS   1
+#define COMPLEX_FUNCTION_ARG   2
+#define COMPLEX_FUNCTION_CONJ  3
+#define COMPLEX_FUNCTION_IMAG  4
+#define COMPLEX_FUNCTION_REAL  5
+
+Gua_Short Complex_ElementwiseFunction(Gua_String name);
+void Complex_ApplyComplexBuffer(Gua_Short function, Gua_Real *re, Gua_Real *im, Gua_Real *r, Gua_Length n);
+Gua_Status Complex_ApplyToMatrix(void *nspace, Gua_Short argc, Gua_Object *argv, Gua_Object *object, Gua_String error);
 Gua_Status Complex_ComplexFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object *argv, Gua_Object *object, Gua_String error);
 Gua_Status Complex_Init(void *nspace, int argc, char *argv[], char **env, Gua_String error);
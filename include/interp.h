@@ -23,6 +23,7 @@
 
 #include <stdio.h>
 #include <stdbool.h>
+#include <stdint.h>
 
 #define TOKEN_TYPE_INTEGER           0
 #define TOKEN_TYPE_REAL              1
@@ -84,6 +85,7 @@
 #define SINGLE_QUOTE       '\''
 #define DOUBLE_QUOTE       '"'
 #define COMMA              ','
+#define COLON              ':'
 #define SEMI_COLON         ';'
 #define HASH               '#'
 
@@ -133,7 +135,8 @@
 
 #define FUNCTION_TYPE_C        0
 #define FUNCTION_TYPE_SCRIPT   1
-#define FUNCTION_TYPE_UNKNOWN  2
+#define FUNCTION_TYPE_C_VIEW   2
+#define FUNCTION_TYPE_UNKNOWN  3
 
 /* Error codes. */
 #define GUA_OK                          0
@@ -187,6 +190,18 @@
 
 #define NAMESPACE_HASH_SIZE  32
 
+#define GUA_ARGUMENTS_SIZE  8
+
+#define GUA_GEMM_BLOCK_SIZE  128
+
+#define GUA_NUMBER_SIZE         32
+#define GUA_SHORTEST_PRECISION  0
+#define GUA_MAX_PRECISION       17
+
+#define GUA_CODE_CACHE_SIZE        64
+#define GUA_CODE_CACHE_HASH_SIZE   256
+#define GUA_CODE_CACHE_MAX_LENGTH  65536
+
 typedef int Gua_Type;
 typedef int Gua_Short;
 typedef long Gua_Integer;
@@ -199,6 +214,11 @@ typedef long Gua_Length;
 typedef int Gua_Status;
 typedef int Gua_Stored;
 
+typedef struct {
+    uint64_t f;
+    Gua_Short e;
+} Gua_DiyFp;
+
 typedef struct {
     Gua_Type type;
     Gua_String start;
@@ -293,6 +313,34 @@ typedef struct {
     struct Gua_Namespace *next;
 } Gua_Namespace;
 
+typedef struct {
+    Gua_Token token;
+    Gua_String next;
+    Gua_String name;
+} Gua_CodeToken;
+
+typedef struct {
+    unsigned long hash;
+    Gua_Length length;
+    Gua_String code;
+    Gua_Integer *index;
+    struct Gua_CodeToken *token;
+    Gua_Integer tokenc;
+    Gua_Integer size;
+    Gua_Short references;
+    struct Gua_CodeEntry *chain;
+    struct Gua_CodeEntry *previous;
+    struct Gua_CodeEntry *next;
+} Gua_CodeEntry;
+
+typedef struct {
+    Gua_Short argc;
+    Gua_Short size;
+    Gua_Object *argv;
+    Gua_Object stack[GUA_ARGUMENTS_SIZE];
+    Gua_Short views;
+} Gua_Arguments;
+
 typedef struct timeval Gua_Time;
 
 /* 
@@ -327,6 +375,7 @@ typedef struct timeval Gua_Time;
 Gua_String Gua_ScanNumber(Gua_String start, Gua_Token *token);
 Gua_String Gua_ScanOperator(Gua_String start, Gua_Token *token);
 Gua_String Gua_ScanIdentifier(Gua_Namespace *nspace, Gua_String start, Gua_Token *token);
+void Gua_ClassifyIdentifier(Gua_Namespace *nspace, Gua_String name, Gua_Token *token);
 Gua_String Gua_ScanDoubleQuotes(Gua_String start, Gua_Token *token);
 Gua_String Gua_ScanString(Gua_String target, Gua_String source, Gua_Integer n);
 Gua_String Gua_ScanArgSeparator(Gua_String start, Gua_Token *token);
@@ -335,6 +384,8 @@ Gua_String Gua_ScanComment(Gua_String start, Gua_Token *token);
 Gua_String Gua_ScanParenthesis(Gua_String start, Gua_Token *token);
 Gua_String Gua_ScanBracket(Gua_String start, Gua_Token *token);
 Gua_String Gua_ScanBrace(Gua_String start, Gua_Token *token);
+Gua_String Gua_ScanToken(Gua_Namespace *nspace, Gua_String start, Gua_Token *token);
+Gua_String Gua_NextCodeToken(Gua_Namespace *nspace, Gua_CodeEntry *entry, Gua_String start, Gua_Token *token);
 Gua_String Gua_NextToken(Gua_Namespace *nspace, Gua_String start, Gua_Token *token);
 
 /* Parser macros and functions. */
@@ -347,6 +398,23 @@ Gua_Status Gua_ParseFormalArguments(Gua_Namespace *nspace, Gua_String start, Gua
 Gua_Status Gua_CountMatrixElements(Gua_String start);
 Gua_Status Gua_ParseMatrixElements(Gua_Namespace *nspace, Gua_String start, Gua_Short argc, Gua_Object *argv, Gua_Status *status, Gua_String error);
 void Gua_FreeArguments(Gua_Short argc, Gua_Object *argv);
+Gua_Object *Gua_PushArgument(Gua_Arguments *arguments);
+Gua_String Gua_SkipArgument(Gua_String start, Gua_String separators, Gua_Token *token);
+Gua_Status Gua_ScanArguments(Gua_Namespace *nspace, Gua_String start, Gua_Arguments *arguments, Gua_Status *status, Gua_String error);
+Gua_Status Gua_ScanMatrixElements(Gua_Namespace *nspace, Gua_String start, Gua_Arguments *arguments, Gua_Status *status, Gua_String error);
+void Gua_ReleaseArguments(Gua_Arguments *arguments);
+Gua_Status Gua_GetSimpleIndex(Gua_Namespace *nspace, Gua_String start, Gua_String end, Gua_Integer *index);
+Gua_Status Gua_GetMatrixOffset(Gua_Namespace *nspace, Gua_String start, Gua_Length length, Gua_Object *matrix, Gua_Integer *offset);
+void Gua_StoreMatrixElement(Gua_Object *element, Gua_Object *object);
+Gua_Status Gua_ScanSlice(Gua_Namespace *nspace, Gua_String start, Gua_Length length, Gua_Object *matrix, Gua_Length *first, Gua_Length *last, Gua_Status *status, Gua_String error);
+void Gua_CopyMatrixBlock(Gua_Object *source, Gua_Short dimc, Gua_Length rows, Gua_Length cols, Gua_Length stride, Gua_Object *object);
+Gua_Status Gua_GetMatrixSlice(Gua_Object *matrix, Gua_Length *first, Gua_Length *last, Gua_Object *object);
+void Gua_GetMatrixView(Gua_Object *matrix, Gua_Length *first, Gua_Length *last, Gua_Object *object);
+void Gua_FreeMatrixView(Gua_Object *object);
+void Gua_MaterializeView(Gua_Object *object);
+Gua_Short Gua_IsViewArgument(Gua_Namespace *nspace, Gua_String start, Gua_String end, Gua_Token *name, Gua_Token *index);
+Gua_Status Gua_ScanViews(Gua_Namespace *nspace, Gua_Arguments *arguments, Gua_Short count, Gua_Short *position, Gua_Token *name, Gua_Token *index, Gua_Status *status, Gua_String error);
+Gua_Status Gua_SetMatrixSlice(Gua_Object *matrix, Gua_Length *first, Gua_Length *last, Gua_Object *object, Gua_String error);
 Gua_String Gua_ParseIf(Gua_Namespace *nspace, Gua_String start, Gua_Token *token, Gua_Object *object, Gua_Status *status, Gua_String error);
 Gua_String Gua_ParseWhile(Gua_Namespace *nspace, Gua_String start, Gua_Token *token, Gua_Object *object, Gua_Status *status, Gua_String error);
 Gua_String Gua_ParseDo(Gua_Namespace *nspace, Gua_String start, Gua_Token *token, Gua_Object *object, Gua_Status *status, Gua_String error);
@@ -356,6 +424,7 @@ Gua_String Gua_ParseTry(Gua_Namespace *nspace, Gua_String start, Gua_Token *toke
 Gua_String Gua_ParseTest(Gua_Namespace *nspace, Gua_String start, Gua_Token *token, Gua_Object *object, Gua_Status *status, Gua_String error);
 Gua_String Gua_ParseFunction(Gua_Namespace *nspace, Gua_String start, Gua_Token *token, Gua_Object *object, Gua_Status *status, Gua_String error);
 Gua_Status Gua_EvalFunction(void *nspace, Gua_Short argc, Gua_Object *argv, Gua_Object *object, Gua_String error);
+Gua_Status Gua_CallFunction(void *nspace, Gua_Function *function, Gua_Short argc, Gua_Object *argv, Gua_Object *object, Gua_String error);
 Gua_String Gua_ParseAssign(Gua_Namespace *nspace, Gua_String start, Gua_Token *token, Gua_Object *object, Gua_Status *status, Gua_String error);
 Gua_String Gua_ParseAssignVariable(Gua_Namespace *nspace, Gua_String start, Gua_Token *token, Gua_Object *object, Gua_Status *status, Gua_String error);
 Gua_String Gua_ParseAssignFunction(Gua_Namespace *nspace, Gua_String start, Gua_Token *token, Gua_Object *object, Gua_Status *status, Gua_String error);
@@ -893,6 +962,15 @@ Gua_String Gua_ParseObject(Gua_Namespace *nspace, Gua_String start, Gua_Token *t
 #define Gua_PObjectLength(o) (o)->length
 #define Gua_IsPObjectStored(o) (o)->stored
 
+/* A matrix view shares the cells of another matrix; its integer field holds the row stride. */
+#define Gua_IsObjectView(o) (((o).type == OBJECT_TYPE_MATRIX) && ((o).integer > 0))
+#define Gua_IsPObjectView(o) (((o)->type == OBJECT_TYPE_MATRIX) && ((o)->integer > 0))
+#define Gua_ObjectStride(o) (o).integer
+#define Gua_PObjectStride(o) (o)->integer
+
+/* A bracket token holding a colon outside nested brackets, as in a[r0:r1, c0:c1], is a slice. */
+#define Gua_IsSliceToken(t) ((t)->integer)
+
 /* Generic file handles support. */
 #define Gua_NewFile(h,p) { \
     h = (Gua_File *)malloc(sizeof(Gua_File)); \
@@ -1096,6 +1174,16 @@ Gua_String Gua_ParseObject(Gua_Namespace *nspace, Gua_String start, Gua_Token *t
     (f).previous = NULL; \
     (f).next = NULL; \
 }
+#define Gua_LinkCViewFunctionToFunction(f,c) { \
+    (f).type = FUNCTION_TYPE_C_VIEW; \
+    (f).name = NULL; \
+    (f).pointer = (c); \
+    (f).argc = 0; \
+    (f).argv = NULL; \
+    (f).script = NULL; \
+    (f).previous = NULL; \
+    (f).next = NULL; \
+}
 #define Gua_LinkCFunctionToPFunction(f,c) { \
     (f)->type = FUNCTION_TYPE_C; \
     (f)->name = NULL; \
@@ -1122,6 +1210,15 @@ Gua_String Gua_ParseObject(Gua_Namespace *nspace, Gua_String start, Gua_Token *t
     } \
 }
 
+/* Start an argument list on the stack, with its first n entries cleared. */
+#define Gua_InitArguments(a,n) { \
+    (a).argc = n; \
+    (a).size = GUA_ARGUMENTS_SIZE; \
+    (a).argv = (a).stack; \
+    (a).views = false; \
+    Gua_ClearArguments((a).argc, (a).argv); \
+}
+
 #define Gua_ArgName(a) (a).name
 #define Gua_ArgObject(a) (a).object
 
@@ -1151,13 +1248,21 @@ Gua_Status Gua_SetArrayElement(Gua_Object *array, Gua_Object *key, Gua_Object *o
 void Gua_SetStoredArray(Gua_Object *array, Gua_Stored stored);
 Gua_Status Gua_CopyArray(Gua_Object *target, Gua_Object *source, Gua_Stored stored);
 Gua_Status Gua_GetArrayKeys(Gua_Object *keys, Gua_Object *array);
+Gua_DiyFp Gua_MulDiyFp(Gua_DiyFp x, Gua_DiyFp y);
+void Gua_Grisu2(Gua_Real x, Gua_Char *digits, Gua_Short *length, Gua_Short *k);
+Gua_String Gua_FormatInteger(Gua_String p, Gua_Integer n);
+Gua_String Gua_FormatReal(Gua_String p, Gua_Real x, Gua_Short precision);
+Gua_Length Gua_FormatLength(Gua_Object *object);
+Gua_String Gua_FormatObject(Gua_String p, Gua_Object *object, Gua_Short precision);
 Gua_Status Gua_ArrayToString(Gua_Object *array, Gua_Object *object);
+Gua_Status Gua_FormatArray(Gua_Object *array, Gua_Object *object, Gua_Short precision);
 Gua_Status Gua_ArgsToString(Gua_Short argc, Gua_Object *argv, Gua_Object *object);
 Gua_Status Gua_IsArrayEqual(Gua_Object *a, Gua_Object *b);
 void Gua_SetStoredMatrix(Gua_Object *matrix, Gua_Stored stored);
 Gua_Status Gua_CopyMatrix(Gua_Object *target, Gua_Object *source, Gua_Stored stored);
 Gua_Status Gua_GetMatrixDim(Gua_Object *array, Gua_Object *matrix);
 Gua_Status Gua_MatrixToString(Gua_Object *matrix, Gua_Object *object);
+Gua_Status Gua_FormatMatrix(Gua_Object *matrix, Gua_Object *object, Gua_Short precision);
 Gua_Status Gua_IsMatrixEqual(Gua_Object *a, Gua_Object *b);
 Gua_Status Gua_IsMatrixApproximatelyEqual(Gua_Object *a, Gua_Object *b, Gua_Object *c);
 Gua_Status Gua_AddMatrix(Gua_Object *a, Gua_Object *b, Gua_Object *c, Gua_String error);
@@ -1166,6 +1271,12 @@ Gua_Status Gua_NegMatrix(Gua_Object *a, Gua_Object *b, Gua_String error);
 Gua_Status Gua_MulMatrix(Gua_Object *a, Gua_Object *b, Gua_Object *c, Gua_String error);
 Gua_Status Gua_IdentMatrix(Gua_Object *a, Gua_Integer n, Gua_String error);
 Gua_Status Gua_InvMatrix(Gua_Object *a, Gua_Object *b, Gua_String error);
+void Gua_MulIntegerBuffer(Gua_Integer *a, Gua_Integer *b, Gua_Integer *c, Gua_Length n);
+Gua_Short Gua_GetMatrixType(Gua_Object *o, Gua_Length n);
+void Gua_PackMatrix(Gua_Object *o, Gua_Length n, Gua_Real *re, Gua_Real *im);
+void Gua_UnpackMatrix(Gua_Object *o, Gua_Length n, Gua_Real *re, Gua_Real *im);
+void Gua_GemmBuffer(Gua_Real *a, Gua_Real *ai, Gua_Real *b, Gua_Real *bi, Gua_Real *c, Gua_Real *ci, Gua_Length m, Gua_Length n, Gua_Length p);
+void Gua_MulRealBuffer(Gua_Real *a, Gua_Real *ai, Gua_Real *b, Gua_Real *bi, Gua_Real *c, Gua_Real *ci, Gua_Length n);
 Gua_Status Gua_PowMatrix(Gua_Object *a, Gua_Integer n, Gua_Object *b, Gua_String error);
 Gua_Status Gua_AndMatrix(Gua_Object *a, Gua_Object *b, Gua_Object *c, Gua_String error);
 Gua_Status Gua_OrMatrix(Gua_Object *a, Gua_Object *b, Gua_Object *c, Gua_String error);
@@ -1175,6 +1286,15 @@ Gua_Status Gua_CopyHandle(Gua_Object *target, Gua_Object *source, Gua_Stored sto
 Gua_Status Gua_ElapsedTime(Gua_Time *result, Gua_Time *tv1, Gua_Time *tv2);
 Gua_String Gua_Expression(Gua_Namespace *nspace, Gua_String start, Gua_Object *object, Gua_Status *status, Gua_String error);
 Gua_String Gua_Evaluate(Gua_Namespace *nspace, Gua_String start, Gua_Object *object, Gua_Status *status, Gua_String error);
+void Gua_FreeCodeEntry(Gua_CodeEntry *entry);
+void Gua_TrimCodeCache(Gua_Integer size);
+void Gua_SetCodeCacheSize(Gua_Integer size);
+Gua_Integer Gua_GetCodeCacheSize(void);
+void Gua_GetCodeCacheStats(Gua_Integer *entries, Gua_Integer *hits, Gua_Integer *misses);
+void Gua_ClearCodeCache(void);
+Gua_CodeEntry *Gua_AcquireCode(Gua_String start);
+Gua_String Gua_CachedExpression(Gua_Namespace *nspace, Gua_String start, Gua_Object *object, Gua_Status *status, Gua_String error);
+Gua_String Gua_CachedEvaluate(Gua_Namespace *nspace, Gua_String start, Gua_Object *object, Gua_Status *status, Gua_String error);
 void Gua_ParseVarAssignment(Gua_String expression, Gua_String variable, Gua_String value);
 void Gua_KeyValuePairsToArray(Gua_Short n, Gua_String *key, Gua_String *value, Gua_Object *object);
 void Gua_ArgvToArray(int argc, char **argv, Gua_Object *object);
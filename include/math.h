@@ -21,6 +21,8 @@
  * 
  */
 
+#include <stdint.h>
+
 /* It's not defined in <math.h>. */
 double round(double x);
 
@@ -29,5 +31,67 @@ double round(double x);
 #define MATH_E  2.7182818284590452354
 #define MATH_PI 3.14159265358979323846
 
+#define MATH_RANDOM_SEED 1
+
+#define MATH_ZIGGURAT_NORMAL_LAYERS      128
+#define MATH_ZIGGURAT_NORMAL_R           3.442619855899
+#define MATH_ZIGGURAT_NORMAL_V           9.91256303526217e-3
+#define MATH_ZIGGURAT_EXPONENTIAL_LAYERS 256
+#define MATH_ZIGGURAT_EXPONENTIAL_R      7.697117470131487
+#define MATH_ZIGGURAT_EXPONENTIAL_V      3.949659822581572e-3
+
+#ifdef _MSC_VER
+#include <windows.h>
+#define MATH_THREAD_LOCAL __declspec(thread)
+#define MATH_FETCH_AND_INCREMENT(v) (InterlockedIncrement((volatile LONG *)(v)) - 1)
+#else
+#define MATH_THREAD_LOCAL __thread
+#define MATH_FETCH_AND_INCREMENT(v) __sync_fetch_and_add((v), 1)
+#endif
+
+#define MATH_FUNCTION_NONE    0
+#define MATH_FUNCTION_ACOS    1
+#define MATH_FUNCTION_ASIN    2
+#define MATH_FUNCTION_ATAN    3
+#define MATH_FUNCTION_ATAN2   4
+#define MATH_FUNCTION_CEIL    5
+#define MATH_FUNCTION_COS     6
+#define MATH_FUNCTION_COSH    7
+#define MATH_FUNCTION_DEG     8
+#define MATH_FUNCTION_EXP     9
+#define MATH_FUNCTION_FABS   10
+#define MATH_FUNCTION_FLOOR  11
+#define MATH_FUNCTION_FMAX   12
+#define MATH_FUNCTION_FMIN   13
+#define MATH_FUNCTION_FMOD   14
+#define MATH_FUNCTION_LOG    15
+#define MATH_FUNCTION_LOG10  16
+#define MATH_FUNCTION_POW    17
+#define MATH_FUNCTION_RAD    18
+#define MATH_FUNCTION_ROUND  19
+#define MATH_FUNCTION_ROUNDL 20
+#define MATH_FUNCTION_SIN    21
+#define MATH_FUNCTION_SINH   22
+#define MATH_FUNCTION_SQRT   23
+#define MATH_FUNCTION_TAN    24
+#define MATH_FUNCTION_TANH   25
+
+typedef struct {
+    uint64_t s[4];
+} Math_RandomState;
+
+uint64_t Math_NextRandom(Math_RandomState *state);
+void Math_JumpRandom(Math_RandomState *state);
+void Math_SeedRandom(Math_RandomState *state, uint64_t seed, Gua_Integer stream);
+Math_RandomState *Math_GetRandomState(void);
+void Math_SetRandomSeed(uint64_t seed, Gua_Integer stream);
+Gua_Real Math_UniformRandom(Math_RandomState *state);
+void Math_InitZiggurat(void);
+Gua_Real Math_NormalRandom(Math_RandomState *state);
+Gua_Real Math_ExponentialRandom(Math_RandomState *state);
+Gua_Short Math_ElementwiseFunction(Gua_String name);
+Gua_Short Math_IsBinaryFunction(Gua_Short function);
+void Math_ApplyRealBuffer(Gua_Short function, Gua_Real *x, Gua_Real *y, Gua_Real *r, Gua_Length n);
+Gua_Status Math_ApplyToMatrix(void *nspace, Gua_Short argc, Gua_Object *argv, Gua_Object *object, Gua_String error);
 Gua_Status Math_MathFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object *argv, Gua_Object *object, Gua_String error);
 Gua_Status Math_Init(void *nspace, int argc, char *argv[], char **env, Gua_String error);
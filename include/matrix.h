@@ -21,12 +21,67 @@
  * 
  */
 
+#include <stdint.h>
+
 #define MATRIX_VERSION "2.3"
 
+#define MATRIX_REDUCE_SUM    0
+#define MATRIX_REDUCE_SUM2   1
+#define MATRIX_REDUCE_AVG    2
+#define MATRIX_REDUCE_MIN    3
+#define MATRIX_REDUCE_MAX    4
+#define MATRIX_REDUCE_COUNT  5
+#define MATRIX_REDUCE_ARGMIN 6
+#define MATRIX_REDUCE_ARGMAX 7
+
+/* A reduction axis is 0 for the columns, 1 for the rows or -1 for the whole matrix. */
+#define Matrix_IsAxis(o) ((Gua_ObjectType(o) == OBJECT_TYPE_INTEGER) && (Gua_ObjectToInteger(o) >= -1) && (Gua_ObjectToInteger(o) <= 1))
+
+#define MATRIX_PAIRWISE_BLOCK_SIZE 128
+#define MATRIX_TRANSPOSE_BLOCK_SIZE 16
+
+#define MATRIX_FILE_MAGIC "GUAMTX\0\1"
+#define MATRIX_FILE_VERSION 1
+#define MATRIX_FILE_HEADER_SIZE 40
+#define MATRIX_FILE_ALIGNMENT 64
+#define MATRIX_FILE_BUFFER_SIZE 65536
+#define MATRIX_FILE_MAX_DIMENSIONS 64
+#define MATRIX_NUMBER_SIZE 64
+
+#define MATRIX_FILE_TYPE_INTEGER 0
+#define MATRIX_FILE_TYPE_REAL    1
+#define MATRIX_FILE_TYPE_COMPLEX 2
+
+#define MATRIX_SPARSE_ADD 0
+#define MATRIX_SPARSE_SUB 1
+#define MATRIX_SPARSE_MUL 2
+
+typedef struct {
+    Gua_Length rows;
+    Gua_Length cols;
+    Gua_Length nnz;
+    Gua_Length *rowp;
+    Gua_Length *colind;
+    Gua_Real *values;
+} Matrix_Sparse;
+
 Gua_Real Matrix_GaussMatrix(Gua_Object *a, Gua_Object *b, Gua_String error);
 Gua_Real Matrix_JordanMatrix(Gua_Object *a, Gua_Object *b, Gua_String error);
 Gua_Status Matrix_DetMatrix(Gua_Object *a, Gua_Object *object, Gua_String error);
+void Matrix_TransposeBlock(Gua_Object *o1, Gua_Object *o2, Gua_Length rows, Gua_Length cols, Gua_Length r0, Gua_Length r1, Gua_Length c0, Gua_Length c1, Gua_Short copy);
+void Matrix_TransposeSquare(Gua_Object *o, Gua_Length n);
 Gua_Status Matrix_TransMatrix(Gua_Object *a, Gua_Object *b, Gua_String error);
+Gua_Status Matrix_Reshape(Gua_Object *a, Gua_Short dimc, Gua_Length *dimv, Gua_Object *b, Gua_String error);
+void Matrix_PutUInt64(unsigned char *p, uint64_t v);
+uint64_t Matrix_GetUInt64(unsigned char *p);
+Gua_Status Matrix_MapFile(Gua_String fileName, unsigned char **p, Gua_Length *size);
+void Matrix_UnmapFile(unsigned char *p, Gua_Length size);
+Gua_Status Matrix_Save(Gua_Object *a, Gua_String fileName, Gua_String error);
+Gua_Status Matrix_Load(Gua_String fileName, Gua_Object *object, Gua_String error);
+Gua_Char *Matrix_ParseNumber(Gua_Char *p, Gua_Char *end, Gua_Object *o);
+Gua_Length Matrix_ParseFields(Gua_Char *p, Gua_Char *eol, Gua_String separator, Gua_Short blank, Gua_Object *o, Gua_Length cols);
+Gua_Status Matrix_LoadText(Gua_String fileName, Gua_String separator, Gua_Integer skip, Gua_Object *object, Gua_String error);
+Gua_Status Matrix_SaveText(Gua_Object *a, Gua_String fileName, Gua_String separator, Gua_String error);
 Gua_Status Matrix_Cross(Gua_Object *a, Gua_Object *b, Gua_Object *c, Gua_String error);
 Gua_Status Matrix_Dot(Gua_Object *a, Gua_Object *b, Gua_Object *c, Gua_String error);
 Gua_Status Matrix_Sum(Gua_Object *a, Gua_Object *object, Gua_String error);
@@ -38,5 +93,27 @@ Gua_Status Matrix_Count(Gua_Object *a, Gua_Object *object, Gua_String error);
 Gua_Status Matrix_CountCells(Gua_Object *a, Gua_Object x1, Gua_Object y1, Gua_Object x2, Gua_Object y2, Gua_Object *object, Gua_String error);
 Gua_Status Matrix_DelRow(Gua_Object *source, Gua_Object n, Gua_Object *object, Gua_String error);
 Gua_Status Matrix_DelCol(Gua_Object *source, Gua_Object n, Gua_Object *object, Gua_String error);
+Gua_Real Matrix_PairwiseSum(Gua_Real *x, Gua_Length n);
+void Matrix_UnpackLanes(Gua_Object *o, Gua_Short operation, Gua_Length rows, Gua_Length cols, Gua_Length stride, Gua_Short transpose, Gua_Real *x);
+Gua_Real Matrix_ReduceLane(Gua_Short operation, Gua_Real *x, Gua_Length n, Gua_Integer *index);
+Gua_Status Matrix_Reduce(Gua_Object *a, Gua_Short operation, Gua_Integer axis, Gua_Object *object, Gua_String error);
+Matrix_Sparse *Matrix_NewSparse(Gua_Length rows, Gua_Length cols, Gua_Length nnz);
+void Matrix_FreeSparse(Matrix_Sparse *s);
+Matrix_Sparse *Matrix_SparseFromTriplets(Gua_Length rows, Gua_Length cols, Gua_Length n, Gua_Length *ti, Gua_Length *tj, Gua_Real *tv, Gua_Short sum);
+Matrix_Sparse *Matrix_DenseToSparse(Gua_Real *x, Gua_Length rows, Gua_Length cols);
+void Matrix_SparseToDense(Matrix_Sparse *s, Gua_Real *x);
+Matrix_Sparse *Matrix_SparseTranspose(Matrix_Sparse *a);
+void Matrix_SparseMulDense(Matrix_Sparse *a, Gua_Real *x, Gua_Length p, Gua_Real *y);
+void Matrix_DenseMulSparse(Gua_Real *x, Gua_Length m, Matrix_Sparse *a, Gua_Real *y);
+Matrix_Sparse *Matrix_SparseMulSparse(Matrix_Sparse *a, Matrix_Sparse *b);
+Matrix_Sparse *Matrix_SparseCombine(Matrix_Sparse *a, Matrix_Sparse *b, Gua_Short operation);
+Matrix_Sparse *Matrix_SparseScale(Matrix_Sparse *a, Gua_Real alpha);
+Matrix_Sparse *Matrix_GetSparse(Gua_Object *o);
+void Matrix_SparseToPObject(Gua_Object *object, Matrix_Sparse *s);
+Gua_Real *Matrix_GetRealBuffer(Gua_Object *a, Gua_Length *rows, Gua_Length *cols);
+void Matrix_RealBufferToPObject(Gua_Object *object, Gua_Real *x, Gua_Length rows, Gua_Length cols);
+Gua_Status Matrix_SparseFromObjects(Gua_Object *i, Gua_Object *j, Gua_Object *v, Gua_Length rows, Gua_Length cols, Gua_Object *object, Gua_String error);
+Gua_Status Matrix_SparseMul(Gua_Object *a, Gua_Object *b, Gua_Object *object, Gua_String error);
+Gua_Status Matrix_SparseElementwise(Gua_Object *a, Gua_Object *b, Gua_Short operation, Gua_Object *object, Gua_String error);
 Gua_Status Matrix_MatrixFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object *argv, Gua_Object *object, Gua_String error);
 Gua_Status Matrix_Init(void *nspace, int argc, char *argv[], char **env, Gua_String error);
@@ -26,6 +26,166 @@
 #define NUMERIC_X "x"
 #define NUMERIC_XYZ "{\"x\", \"y\", \"z\"}"
 
+#define NUMERIC_TOLERANCE 1e-10
+#define NUMERIC_GMRES_RESTART 30
+
+#define NUMERIC_METHOD_CG       0
+#define NUMERIC_METHOD_BICGSTAB 1
+#define NUMERIC_METHOD_GMRES    2
+
+#define NUMERIC_PRECONDITIONER_NONE   0
+#define NUMERIC_PRECONDITIONER_JACOBI 1
+#define NUMERIC_PRECONDITIONER_ILU    2
+
+#define NUMERIC_FFT_FORWARD      0
+#define NUMERIC_FFT_INVERSE      1
+#define NUMERIC_FFT_REAL         2
+#define NUMERIC_FFT_INVERSE_REAL 3
+
+#define NUMERIC_FFT_PLANS 16
+#define NUMERIC_FFT_MAX_FACTORS 64
+#define NUMERIC_FFT_MAX_RADIX 31
+#define NUMERIC_FFT_BLOCK 8192
+#define NUMERIC_DIRECT_CONVOLUTION 4096
+
+#define NUMERIC_QR_BLOCK 32
+#define NUMERIC_QR_TILE 256
+
+#define NUMERIC_EIGEN_ITERATIONS 60
+#define NUMERIC_SVD_SWEEPS 60
+
+#define NUMERIC_ODE_RK4            0
+#define NUMERIC_ODE_DORMAND_PRINCE 1
+
+#define NUMERIC_RK4_STEPS 100
+#define NUMERIC_ODE_STEPS 100000
+#define NUMERIC_ODE_TOLERANCE 1e-6
+
+#define NUMERIC_STATS_COMPRESSION 100
+#define NUMERIC_STATS_BUFFER 1024
+#define NUMERIC_STATS_CHUNK 4096
+#define NUMERIC_STATS_READ 65536
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+typedef struct {
+    Gua_Short type;
+    Gua_Length n;
+    Gua_Real *diagonal;
+    Matrix_Sparse *lu;
+    Gua_Length *udiagonal;
+} Numeric_Preconditioner;
+
+/* The residual history of an iterative solver, grown as iterations are done. */
+typedef struct {
+    Gua_Real *value;
+    Gua_Length size;
+} Numeric_History;
+
+typedef struct {
+    void *nspace;
+    Gua_Function function;
+    Gua_Object *name;
+    Gua_Length rows;
+    Gua_Length cols;
+    Gua_Short scalar;
+} Numeric_ODE;
+
+typedef struct {
+    Gua_Real mean;
+    Gua_Real weight;
+} Numeric_Centroid;
+
+typedef struct {
+    Gua_Real count;
+    Gua_Real mean;
+    Gua_Real m2;
+    Gua_Real m3;
+    Gua_Real m4;
+    Gua_Real min;
+    Gua_Real max;
+    Gua_Length bins;
+    Gua_Real lower;
+    Gua_Real upper;
+    Gua_Real below;
+    Gua_Real above;
+    Gua_Real *histogram;
+    Gua_Length centroids;
+    Gua_Length buffered;
+    Gua_Length capacity;
+    Numeric_Centroid *centroid;
+    Numeric_Centroid *scratch;
+} Numeric_Stats;
+
+typedef struct Numeric_FFTPlan {
+    Gua_Length n;
+    Gua_Real *twiddlere;
+    Gua_Real *twiddleim;
+    Gua_Short factors;
+    Gua_Length factor[NUMERIC_FFT_MAX_FACTORS];
+    Gua_Length m;
+    Gua_Real *chirpre;
+    Gua_Real *chirpim;
+    Gua_Real *filterre;
+    Gua_Real *filterim;
+    struct Numeric_FFTPlan *inner;
+} Numeric_FFTPlan;
+
 Gua_Status Numeric_GaussLSS(Gua_Object *a, Gua_Object *b, Gua_Object *x, Gua_String error);
+Gua_Real Numeric_Dot(Gua_Real *x, Gua_Real *y, Gua_Length n);
+Gua_Real Numeric_Norm(Gua_Real *x, Gua_Length n);
+Gua_Status Numeric_NewPreconditioner(Matrix_Sparse *a, Gua_Short type, Numeric_Preconditioner *m, Gua_String error);
+void Numeric_FreePreconditioner(Numeric_Preconditioner *m);
+void Numeric_ApplyPreconditioner(Numeric_Preconditioner *m, Gua_Real *r, Gua_Real *z);
+Gua_Real Numeric_RecordResidual(Numeric_History *history, Gua_Length k, Gua_Real residual);
+Gua_Length Numeric_CG(Matrix_Sparse *a, Numeric_Preconditioner *m, Gua_Real *b, Gua_Real *x, Gua_Real tolerance, Gua_Length iterations, Numeric_History *history);
+Gua_Length Numeric_BiCGSTAB(Matrix_Sparse *a, Numeric_Preconditioner *m, Gua_Real *b, Gua_Real *x, Gua_Real tolerance, Gua_Length iterations, Numeric_History *history);
+Gua_Length Numeric_GMRES(Matrix_Sparse *a, Numeric_Preconditioner *m, Gua_Real *b, Gua_Real *x, Gua_Real tolerance, Gua_Length iterations, Gua_Length restart, Numeric_History *history);
+Gua_Status Numeric_IterativeLSS(Gua_Object *a, Gua_Object *b, Gua_Short method, Gua_Real tolerance, Gua_Length iterations, Gua_Short preconditioner, Gua_Length restart, Gua_Object *x, Gua_Object *history, Gua_String error);
+Numeric_FFTPlan *Numeric_NewFFTPlan(Gua_Length n);
+void Numeric_FreeFFTPlan(Numeric_FFTPlan *plan);
+Numeric_FFTPlan *Numeric_GetFFTPlan(Gua_Length n);
+void Numeric_FFTPass(Numeric_FFTPlan *plan, Gua_Real *re, Gua_Real *im, Gua_Length first, Gua_Length last, Gua_Length half);
+void Numeric_FFTRadix2(Numeric_FFTPlan *plan, Gua_Real *re, Gua_Real *im);
+void Numeric_FFTMixedRadix(Numeric_FFTPlan *plan, Gua_Real *inre, Gua_Real *inim, Gua_Real *outre, Gua_Real *outim, Gua_Short factor, Gua_Length stride, Gua_Real *scratchre, Gua_Real *scratchim);
+void Numeric_FFT(Numeric_FFTPlan *plan, Gua_Real *re, Gua_Real *im, Gua_Short inverse);
+void Numeric_RealFFT(Gua_Real *x, Gua_Length n, Gua_Real *re, Gua_Real *im);
+Gua_Status Numeric_Transform(Gua_Object *a, Gua_Short kind, Gua_Length n, Gua_Object *object, Gua_String error);
+Gua_Status Numeric_Convolve(Gua_Object *a, Gua_Object *b, Gua_Short correlate, Gua_Object *object, Gua_String error);
+void Numeric_Householder(Gua_Real *x, Gua_Length n, Gua_Real *tau);
+void Numeric_QRBlockReflector(Gua_Real *a, Gua_Length m, Gua_Length k, Gua_Length nb, Gua_Real *tau, Gua_Real *t);
+void Numeric_QRApplyBlock(Gua_Real *a, Gua_Length m, Gua_Length k, Gua_Length nb, Gua_Real *t, Gua_Real *c, Gua_Length cols, Gua_Short transpose);
+void Numeric_QRPanel(Gua_Real *a, Gua_Length m, Gua_Length k, Gua_Length nb, Gua_Real *tau, Gua_Real *t);
+void Numeric_QR(Gua_Real *a, Gua_Length m, Gua_Length n, Gua_Real *tau);
+void Numeric_QRApply(Gua_Real *a, Gua_Length m, Gua_Length n, Gua_Real *tau, Gua_Real *c, Gua_Length cols, Gua_Short transpose);
+Gua_Real *Numeric_ColumnBuffer(Gua_Object *a, Gua_Length *rows, Gua_Length *cols);
+Gua_Status Numeric_QRDecomposition(Gua_Object *a, Gua_Object *q, Gua_Object *r, Gua_String error);
+Gua_Status Numeric_LeastSquares(Gua_Object *a, Gua_Object *b, Gua_Object *x, Gua_Object *residuals, Gua_String error);
+void Numeric_Tridiagonalize(Gua_Real *v, Gua_Length n, Gua_Real *d, Gua_Real *e, Gua_Short vectors);
+Gua_Status Numeric_TridiagonalQL(Gua_Real *d, Gua_Real *e, Gua_Length n, Gua_Real *v, Gua_Short vectors);
+Gua_Status Numeric_SymmetricEigen(Gua_Real *a, Gua_Length n, Gua_Real *w, Gua_Short vectors);
+Gua_Status Numeric_JacobiSVD(Gua_Real *u, Gua_Length m, Gua_Length n, Gua_Real *s, Gua_Real *v);
+Gua_Status Numeric_SVD(Gua_Real *a, Gua_Length m, Gua_Length n, Gua_Real *s, Gua_Real *u, Gua_Real *v);
+void Numeric_ColumnBufferToPObject(Gua_Object *object, Gua_Real *x, Gua_Length rows, Gua_Length cols);
+Gua_Status Numeric_EigenDecomposition(Gua_Object *a, Gua_Object *w, Gua_Object *v, Gua_String error);
+Gua_Status Numeric_SingularValueDecomposition(Gua_Object *a, Gua_Object *s, Gua_Object *u, Gua_Object *v, Gua_String error);
+Gua_Status Numeric_ODEFunction(Numeric_ODE *ode, Gua_Real t, Gua_Real *y, Gua_Real *dy, Gua_String error);
+Gua_Status Numeric_RK4(Numeric_ODE *ode, Gua_Real *t, Gua_Length k, Gua_Real *y0, Gua_Real *x, Gua_String error);
+Gua_Status Numeric_ODE45(Numeric_ODE *ode, Gua_Real *t, Gua_Length k, Gua_Real *y0, Gua_Real tol, Gua_Real **x, Gua_Length *rows, Gua_String error);
+Gua_Status Numeric_SolveODE(void *nspace, Gua_Short method, Gua_Object *f, Gua_Object *tspan, Gua_Object *y0, Gua_Object *option, Gua_Object *object, Gua_String error);
+Numeric_Stats *Numeric_NewStats(Gua_Length bins, Gua_Real lower, Gua_Real upper);
+void Numeric_FreeStats(Numeric_Stats *s);
+Numeric_Stats *Numeric_GetStats(Gua_Object *o);
+int Numeric_CompareCentroids(const void *a, const void *b);
+void Numeric_StatsCompress(Numeric_Stats *s);
+void Numeric_StatsCombine(Numeric_Stats *s, Gua_Real n, Gua_Real mean, Gua_Real m2, Gua_Real m3, Gua_Real m4);
+void Numeric_StatsAdd(Numeric_Stats *s, Gua_Real *x, Gua_Length n);
+Gua_Status Numeric_StatsMerge(Numeric_Stats *s, Numeric_Stats *t, Gua_String error);
+Gua_Real Numeric_StatsQuantile(Numeric_Stats *s, Gua_Real q);
+Gua_Real Numeric_StatsAddFile(Numeric_Stats *s, Gua_File *f);
+Gua_Status Numeric_StatsAddObject(Numeric_Stats *s, Gua_Object *a, Gua_Object *object, Gua_String error);
+void Numeric_StatsToPObject(Numeric_Stats *s, Gua_Object *object);
 Gua_Status Numeric_NumericFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object *argv, Gua_Object *object, Gua_String error);
 Gua_Status Numeric_Init(void *nspace, int argc, char *argv[], char **env, Gua_String error);
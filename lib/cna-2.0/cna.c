@@ -34,8 +34,13 @@
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
+#ifndef _WINDOWS_
+#include <pthread.h>
+#include <unistd.h>
+#endif
 #include "interp.h"
 #include "matrix.h"
+#include "numeric.h"
 #include "cna.h"
 
 #define ERROR_SIZE 65536
@@ -46,7 +51,213 @@
  *     C
  *
  * Function:
- *     Gua_Status Cna_FloydWarshallShortestPath(Gua_Object *adj, Gua_Object *geodesic, Gua_String error)
+ *     void Cna_FloydWarshallTile(Gua_Real *d, Gua_Length *p, Gua_Length n, Gua_Length ib, Gua_Length jb, Gua_Length kb)
+ *
+ * Description:
+ *     Relax the paths of a tile of the distance matrix through the
+ *     vertices of another tile.
+ *
+ * Arguments:
+ *     d,     the n x n distance matrix;
+ *     p,     the n x n matrix of intermediate vertices, or NULL;
+ *     n,     the number of vertices;
+ *     ib,    the tile row;
+ *     jb,    the tile column;
+ *     kb,    the tile of the intermediate vertices.
+ *
+ * Results:
+ *     The function updates the tile (ib, jb) of d and p.
+ */
+void Cna_FloydWarshallTile(Gua_Real *d, Gua_Length *p, Gua_Length n, Gua_Length ib, Gua_Length jb, Gua_Length kb)
+{
+    Gua_Real *di;
+    Gua_Real *dk;
+    Gua_Real dik;
+    Gua_Real s;
+    Gua_Length i;
+    Gua_Length j;
+    Gua_Length k;
+    Gua_Length i0;
+    Gua_Length i1;
+    Gua_Length j0;
+    Gua_Length j1;
+    Gua_Length k0;
+    Gua_Length k1;
+    
+    i0 = ib * CNA_FLOYD_WARSHALL_BLOCK;
+    j0 = jb * CNA_FLOYD_WARSHALL_BLOCK;
+    k0 = kb * CNA_FLOYD_WARSHALL_BLOCK;
+    
+    i1 = i0 + CNA_FLOYD_WARSHALL_BLOCK < n ? i0 + CNA_FLOYD_WARSHALL_BLOCK : n;
+    j1 = j0 + CNA_FLOYD_WARSHALL_BLOCK < n ? j0 + CNA_FLOYD_WARSHALL_BLOCK : n;
+    k1 = k0 + CNA_FLOYD_WARSHALL_BLOCK < n ? k0 + CNA_FLOYD_WARSHALL_BLOCK : n;
+    
+    for (k = k0; k < k1; k++) {
+        dk = &(d[k * n]);
+        
+        for (i = i0; i < i1; i++) {
+            di = &(d[i * n]);
+            dik = di[k];
+            
+            if (dik == HUGE_VAL) {
+                continue;
+            }
+            
+            for (j = j0; j < j1; j++) {
+                s = dik + dk[j];
+                
+                if (s < di[j]) {
+                    di[j] = s;
+                    
+                    if (p != NULL) {
+                        p[i * n + j] = k;
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void *Cna_FloydWarshallPhase(void *data)
+ *
+ * Description:
+ *     Relax the share of one thread of the independent tiles of a round
+ *     of the blocked Floyd-Warshall algorithm. In phase 1 these are the
+ *     tiles in the row and column of the diagonal tile kb, and in phase 2
+ *     all the other tiles.
+ *
+ * Arguments:
+ *     data,    a pointer to a Cna_FloydWarshallTask structure.
+ *
+ * Results:
+ *     The function updates the tiles of the task.
+ */
+void *Cna_FloydWarshallPhase(void *data)
+{
+    Cna_FloydWarshallTask *task;
+    Gua_Length nb;
+    Gua_Length t;
+    Gua_Length ib;
+    Gua_Length jb;
+    
+    task = (Cna_FloydWarshallTask *)data;
+    
+    nb = (task->n + CNA_FLOYD_WARSHALL_BLOCK - 1) / CNA_FLOYD_WARSHALL_BLOCK;
+    
+    if (task->phase == 1) {
+        for (t = task->id; t < nb; t = t + task->threads) {
+            if (t != task->kb) {
+                Cna_FloydWarshallTile(task->d, task->p, task->n, task->kb, t, task->kb);
+                Cna_FloydWarshallTile(task->d, task->p, task->n, t, task->kb, task->kb);
+            }
+        }
+    } else {
+        for (t = task->id; t < (nb * nb); t = t + task->threads) {
+            ib = t / nb;
+            jb = t % nb;
+            
+            if ((ib != task->kb) && (jb != task->kb)) {
+                Cna_FloydWarshallTile(task->d, task->p, task->n, ib, jb, task->kb);
+            }
+        }
+    }
+    
+    return NULL;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Cna_FloydWarshall(Gua_Real *d, Gua_Length *p, Gua_Length n, Gua_Short threads)
+ *
+ * Description:
+ *     Calculate the shortest path between each pair of vertices with the
+ *     blocked Floyd-Warshall algorithm. Each round relaxes the diagonal
+ *     tile, then its row and column, then the remaining tiles; the tiles
+ *     of the last two phases are shared among the threads.
+ *
+ * Arguments:
+ *     d,          the n x n distance matrix, HUGE_VAL where there is no edge;
+ *     p,          the n x n matrix of intermediate vertices, set to -1, or NULL;
+ *     n,          the number of vertices;
+ *     threads,    the number of threads.
+ *
+ * Results:
+ *     The function replaces d by the geodesic distances and sets in p the
+ *     last intermediate vertex of each shortest path.
+ */
+void Cna_FloydWarshall(Gua_Real *d, Gua_Length *p, Gua_Length n, Gua_Short threads)
+{
+    Cna_FloydWarshallTask task[CNA_MAX_THREADS];
+#ifndef _WINDOWS_
+    pthread_t thread[CNA_MAX_THREADS];
+    Gua_Short started[CNA_MAX_THREADS];
+#endif
+    Gua_Length nb;
+    Gua_Length kb;
+    Gua_Short phase;
+    Gua_Short t;
+    
+    nb = (n + CNA_FLOYD_WARSHALL_BLOCK - 1) / CNA_FLOYD_WARSHALL_BLOCK;
+    
+    if (threads < 1) {
+        threads = 1;
+    } else if (threads > CNA_MAX_THREADS) {
+        threads = CNA_MAX_THREADS;
+    }
+    
+    for (t = 0; t < threads; t++) {
+        task[t].d = d;
+        task[t].p = p;
+        task[t].n = n;
+        task[t].id = t;
+        task[t].threads = threads;
+    }
+    
+    for (kb = 0; kb < nb; kb++) {
+        Cna_FloydWarshallTile(d, p, n, kb, kb, kb);
+        
+        for (phase = 1; phase <= 2; phase++) {
+            for (t = 0; t < threads; t++) {
+                task[t].kb = kb;
+                task[t].phase = phase;
+            }
+#ifndef _WINDOWS_
+            for (t = 1; t < threads; t++) {
+                started[t] = pthread_create(&thread[t], NULL, Cna_FloydWarshallPhase, &task[t]) == 0;
+            }
+            
+            Cna_FloydWarshallPhase(&task[0]);
+            
+            for (t = 1; t < threads; t++) {
+                if (started[t]) {
+                    pthread_join(thread[t], NULL);
+                } else {
+                    Cna_FloydWarshallPhase(&task[t]);
+                }
+            }
+#else
+            for (t = 0; t < threads; t++) {
+                Cna_FloydWarshallPhase(&task[t]);
+            }
+#endif
+        }
+    }
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Cna_FloydWarshallShortestPath(Gua_Object *adj, Gua_Object *geodesic, Gua_Object *path, Gua_Short threads, Gua_String error)
  *
  * Description:
  *     Calculate the shortest path between each pair of vertices of the network, using
@@ -55,25 +266,31 @@
  * Arguments:
  *     adj,         the adjacency matrix;
  *     geodesic,    a matrix containing the shortest path between each pair of vertices of the network;
- *     path,        a matrix containing the path between each pair of vertices of the network;
+ *     path,        a matrix containing the path between each pair of vertices of the network, or NULL;
+ *     threads,     the number of threads;
  *     error,       a pointer to the error message.
  *
  * Results:
  *     The function calculates the shortest path between each pair of vertices of the network.
+ *     Pairs without a path have geodesic 0. The path matrix holds the last intermediate
+ *     vertex of each shortest path, or -1.
  */
-Gua_Status Cna_FloydWarshallShortestPath(Gua_Object *adj, Gua_Object *geodesic, Gua_Object *path, Gua_String error)
+Gua_Status Cna_FloydWarshallShortestPath(Gua_Object *adj, Gua_Object *geodesic, Gua_Object *path, Gua_Short threads, Gua_String error)
 {
     Gua_Matrix *madj;
     Gua_Matrix *mgeodesic;
     Gua_Matrix *mpath;
+    Gua_Object *oadj;
     Gua_Object *ogeodesic;
     Gua_Object *opath;
-    Gua_Integer i;
-    Gua_Integer j;
-    Gua_Integer k;
-    Gua_Integer l;
-    Gua_Integer dim_i;
-    Gua_Integer dim_j;
+    Gua_Real *d;
+    Gua_Length *p;
+    Gua_Real v;
+    Gua_Length i;
+    Gua_Length j;
+    Gua_Length n;
+    Gua_Length l;
+    Gua_Length dim;
     
     if (Gua_PObjectType(adj) != OBJECT_TYPE_MATRIX) {
         return GUA_ERROR;
@@ -81,139 +298,121 @@ Gua_Status Cna_FloydWarshallShortestPath(Gua_Object *adj, Gua_Object *geodesic,
     
     madj = (Gua_Matrix *)Gua_PObjectToMatrix(adj);
     
-    if (madj) {
-        if (!Gua_IsPObjectStored(geodesic)) {
-            Gua_FreeObject(geodesic);
-        } else {
-            Gua_ClearPObject(geodesic);
+    if ((madj->dimc != 2) || (madj->dimv[0] != madj->dimv[1]) || (madj->dimv[0] < 1)) {
+        return GUA_ERROR;
+    }
+    
+    dim = madj->dimv[0];
+    n = dim - 1;
+    l = dim * dim;
+    
+    oadj = (Gua_Object *)madj->object;
+    
+    /* Vertex k of the network is the row and column k - 1 of the distance matrix. */
+    d = (Gua_Real *)Gua_Alloc(sizeof(Gua_Real) * (n * n + 1));
+    
+    for (i = 0; i < n; i++) {
+        for (j = 0; j < n; j++) {
+            if (Gua_ObjectType(oadj[(i + 1) * dim + (j + 1)]) == OBJECT_TYPE_REAL) {
+                v = Gua_ObjectToReal(oadj[(i + 1) * dim + (j + 1)]);
+            } else if (Gua_ObjectType(oadj[(i + 1) * dim + (j + 1)]) == OBJECT_TYPE_INTEGER) {
+                v = (Gua_Real)Gua_ObjectToInteger(oadj[(i + 1) * dim + (j + 1)]);
+            } else {
+                v = 0.0;
+            }
+            
+            if (v == 0.0) {
+                d[i * n + j] = HUGE_VAL;
+            } else {
+                d[i * n + j] = v;
+            }
+        }
+    }
+    
+    p = NULL;
+    
+    if (path != NULL) {
+        p = (Gua_Length *)Gua_Alloc(sizeof(Gua_Length) * (n * n + 1));
+        
+        for (i = 0; i < (n * n); i++) {
+            p[i] = -1;
+        }
+    }
+    
+    /* Calculate the shortest paths. */
+    Cna_FloydWarshall(d, p, n, threads);
+    
+    if (!Gua_IsPObjectStored(geodesic)) {
+        Gua_FreeObject(geodesic);
+    } else {
+        Gua_ClearPObject(geodesic);
+    }
+    
+    Gua_MatrixToPObject(geodesic, (struct Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix)), l);
+    
+    mgeodesic = (Gua_Matrix *)Gua_PObjectToMatrix(geodesic);
+    
+    mgeodesic->dimc = 2;
+    mgeodesic->dimv = Gua_Alloc(mgeodesic->dimc * sizeof(Gua_Integer));
+    mgeodesic->dimv[0] = dim;
+    mgeodesic->dimv[1] = dim;
+    
+    mgeodesic->object = (struct Gua_Object *)Gua_Alloc(l * sizeof(Gua_Object));
+    ogeodesic = (Gua_Object *)mgeodesic->object;
+    
+    for (i = 0; i < dim; i++) {
+        Gua_RealToObject(ogeodesic[0 * dim + i], 0.0);
+        Gua_RealToObject(ogeodesic[i * dim + 0], 0.0);
+    }
+    
+    for (i = 0; i < n; i++) {
+        for (j = 0; j < n; j++) {
+            /* Fix geodesics. */
+            if ((i == j) || (d[i * n + j] == HUGE_VAL)) {
+                Gua_RealToObject(ogeodesic[(i + 1) * dim + (j + 1)], 0.0);
+            } else {
+                Gua_RealToObject(ogeodesic[(i + 1) * dim + (j + 1)], d[i * n + j]);
+            }
         }
+    }
+    
+    Gua_Free(d);
+    
+    if (path != NULL) {
         if (!Gua_IsPObjectStored(path)) {
             Gua_FreeObject(path);
         } else {
             Gua_ClearPObject(path);
         }
         
-        dim_i = madj->dimv[0];
-        dim_j = madj->dimv[1];
-        
-        /* Create matrices zero and one. */
-        l = dim_i * dim_j;
-        
-        /* Create a matrix containing only -1. */
         Gua_MatrixToPObject(path, (struct Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix)), l);
         
         mpath = (Gua_Matrix *)Gua_PObjectToMatrix(path);
         
         mpath->dimc = 2;
         mpath->dimv = Gua_Alloc(mpath->dimc * sizeof(Gua_Integer));
-        mpath->dimv[0] = dim_i;
-        mpath->dimv[1] = dim_j;
+        mpath->dimv[0] = dim;
+        mpath->dimv[1] = dim;
         
         mpath->object = (struct Gua_Object *)Gua_Alloc(l * sizeof(Gua_Object));
         opath = (Gua_Object *)mpath->object;
         
-        for (i = 0; i < l; i++) {
-            Gua_RealToObject(opath[i], -1.0);
+        for (i = 0; i < dim; i++) {
+            Gua_IntegerToObject(opath[0 * dim + i], -1);
+            Gua_IntegerToObject(opath[i * dim + 0], -1);
         }
         
-        /* Calculate the shortest paths. */
-        Gua_CopyMatrix(geodesic, adj, 0);
-        
-        mgeodesic = (Gua_Matrix *)Gua_PObjectToMatrix(geodesic);
-        ogeodesic = (Gua_Object *)mgeodesic->object;
-        
-        for (i = 1; i < dim_i; i = i + 1) {
-            for (j = 1; j < dim_j; j = j + 1) {
-                for (k = 1; k < dim_i; k = k + 1) {
-                    if (Gua_ObjectType(ogeodesic[j * mgeodesic->dimv[1] + k]) == OBJECT_TYPE_REAL) {
-                        if (Gua_ObjectToReal(ogeodesic[j * mgeodesic->dimv[1] + k]) == 0.0) {
-                            Gua_RealToObject(ogeodesic[j * mgeodesic->dimv[1] + k], 999999999);
-                        }
-                    } else if (Gua_ObjectType(ogeodesic[j * mgeodesic->dimv[1] + k]) == OBJECT_TYPE_INTEGER) {
-                        if (Gua_ObjectToInteger(ogeodesic[j * mgeodesic->dimv[1] + k]) == 0) {
-                            Gua_RealToObject(ogeodesic[j * mgeodesic->dimv[1] + k], 999999999);
-                        }
-                    }
-                    
-                    if (Gua_ObjectType(ogeodesic[j * mgeodesic->dimv[1] + i]) == OBJECT_TYPE_REAL) {
-                        if (Gua_ObjectToReal(ogeodesic[j * mgeodesic->dimv[1] + i]) == 0.0) {
-                            Gua_RealToObject(ogeodesic[j * mgeodesic->dimv[1] + i], 999999999);
-                        }
-                    } else if (Gua_ObjectType(ogeodesic[j * mgeodesic->dimv[1] + i]) == OBJECT_TYPE_INTEGER) {
-                        if (Gua_ObjectToInteger(ogeodesic[j * mgeodesic->dimv[1] + i]) == 0) {
-                            Gua_RealToObject(ogeodesic[j * mgeodesic->dimv[1] + i], 999999999);
-                        }
-                    }
-                    
-                    if (Gua_ObjectType(ogeodesic[i * mgeodesic->dimv[1] + k]) == OBJECT_TYPE_REAL) {
-                        if (Gua_ObjectToReal(ogeodesic[i * mgeodesic->dimv[1] + k]) == 0.0) {
-                            Gua_RealToObject(ogeodesic[i * mgeodesic->dimv[1] + k], 999999999);
-                        }
-                    } else if (Gua_ObjectType(ogeodesic[i * mgeodesic->dimv[1] + k]) == OBJECT_TYPE_INTEGER) {
-                        if (Gua_ObjectToInteger(ogeodesic[i * mgeodesic->dimv[1] + k]) == 0) {
-                            Gua_RealToObject(ogeodesic[i * mgeodesic->dimv[1] + k], 999999999);
-                        }
-                    }
-                    
-                    if ((Gua_ObjectType(ogeodesic[j * mgeodesic->dimv[1] + i]) == OBJECT_TYPE_REAL) && (Gua_ObjectType(ogeodesic[i * mgeodesic->dimv[1] + k]) == OBJECT_TYPE_REAL) && (Gua_ObjectType(ogeodesic[j * mgeodesic->dimv[1] + k]) == OBJECT_TYPE_REAL)) {
-                        if ((Gua_ObjectToReal(ogeodesic[j * mgeodesic->dimv[1] + i]) + Gua_ObjectToReal(ogeodesic[i * mgeodesic->dimv[1] + k])) < Gua_ObjectToReal(ogeodesic[j * mgeodesic->dimv[1] + k])) {
-                            Gua_RealToObject(ogeodesic[j * mgeodesic->dimv[1] + k], Gua_ObjectToReal(ogeodesic[j * mgeodesic->dimv[1] + i]) + Gua_ObjectToReal(ogeodesic[i * mgeodesic->dimv[1] + k]));
-                            Gua_RealToObject(opath[j * mgeodesic->dimv[1] + k], i);
-                        }
-                    } else if ((Gua_ObjectType(ogeodesic[j * mgeodesic->dimv[1] + i]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(ogeodesic[i * mgeodesic->dimv[1] + k]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(ogeodesic[j * mgeodesic->dimv[1] + k]) == OBJECT_TYPE_INTEGER)) {
-                        if ((Gua_ObjectToInteger(ogeodesic[j * mgeodesic->dimv[1] + i]) + Gua_ObjectToInteger(ogeodesic[i * mgeodesic->dimv[1] + k])) < Gua_ObjectToInteger(ogeodesic[j * mgeodesic->dimv[1] + k])) {
-                            Gua_RealToObject(ogeodesic[j * mgeodesic->dimv[1] + k], Gua_ObjectToInteger(ogeodesic[j * mgeodesic->dimv[1] + i]) + Gua_ObjectToInteger(ogeodesic[i * mgeodesic->dimv[1] + k]));
-                            Gua_RealToObject(opath[j * mgeodesic->dimv[1] + k], i);
-                        }
-                    } else if ((Gua_ObjectType(ogeodesic[j * mgeodesic->dimv[1] + i]) == OBJECT_TYPE_REAL) && (Gua_ObjectType(ogeodesic[i * mgeodesic->dimv[1] + k]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(ogeodesic[j * mgeodesic->dimv[1] + k]) == OBJECT_TYPE_INTEGER)) {
-                        if ((Gua_ObjectToReal(ogeodesic[j * mgeodesic->dimv[1] + i]) + Gua_ObjectToInteger(ogeodesic[i * mgeodesic->dimv[1] + k])) < Gua_ObjectToInteger(ogeodesic[j * mgeodesic->dimv[1] + k])) {
-                            Gua_RealToObject(ogeodesic[j * mgeodesic->dimv[1] + k], Gua_ObjectToReal(ogeodesic[j * mgeodesic->dimv[1] + i]) + Gua_ObjectToInteger(ogeodesic[i * mgeodesic->dimv[1] + k]));
-                            Gua_RealToObject(opath[j * mgeodesic->dimv[1] + k], i);
-                        }
-                    } else if ((Gua_ObjectType(ogeodesic[j * mgeodesic->dimv[1] + i]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(ogeodesic[i * mgeodesic->dimv[1] + k]) == OBJECT_TYPE_REAL) && (Gua_ObjectType(ogeodesic[j * mgeodesic->dimv[1] + k]) == OBJECT_TYPE_INTEGER)) {
-                        if ((Gua_ObjectToInteger(ogeodesic[j * mgeodesic->dimv[1] + i]) + Gua_ObjectToReal(ogeodesic[i * mgeodesic->dimv[1] + k])) < Gua_ObjectToInteger(ogeodesic[j * mgeodesic->dimv[1] + k])) {
-                            Gua_RealToObject(ogeodesic[j * mgeodesic->dimv[1] + k], Gua_ObjectToInteger(ogeodesic[j * mgeodesic->dimv[1] + i]) + Gua_ObjectToReal(ogeodesic[i * mgeodesic->dimv[1] + k]));
-                            Gua_RealToObject(opath[j * mgeodesic->dimv[1] + k], i);
-                        }
-                    } else if ((Gua_ObjectType(ogeodesic[j * mgeodesic->dimv[1] + i]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(ogeodesic[i * mgeodesic->dimv[1] + k]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(ogeodesic[j * mgeodesic->dimv[1] + k]) == OBJECT_TYPE_REAL)) {
-                        if ((Gua_ObjectToInteger(ogeodesic[j * mgeodesic->dimv[1] + i]) + Gua_ObjectToInteger(ogeodesic[i * mgeodesic->dimv[1] + k])) < Gua_ObjectToReal(ogeodesic[j * mgeodesic->dimv[1] + k])) {
-                            Gua_RealToObject(ogeodesic[j * mgeodesic->dimv[1] + k], Gua_ObjectToInteger(ogeodesic[j * mgeodesic->dimv[1] + i]) + Gua_ObjectToInteger(ogeodesic[i * mgeodesic->dimv[1] + k]));
-                            Gua_RealToObject(opath[j * mgeodesic->dimv[1] + k], i);
-                        }
-                    } else if ((Gua_ObjectType(ogeodesic[j * mgeodesic->dimv[1] + i]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(ogeodesic[i * mgeodesic->dimv[1] + k]) == OBJECT_TYPE_REAL) && (Gua_ObjectType(ogeodesic[j * mgeodesic->dimv[1] + k]) == OBJECT_TYPE_REAL)) {
-                        if ((Gua_ObjectToInteger(ogeodesic[j * mgeodesic->dimv[1] + i]) + Gua_ObjectToReal(ogeodesic[i * mgeodesic->dimv[1] + k])) < Gua_ObjectToReal(ogeodesic[j * mgeodesic->dimv[1] + k])) {
-                            Gua_RealToObject(ogeodesic[j * mgeodesic->dimv[1] + k], Gua_ObjectToInteger(ogeodesic[j * mgeodesic->dimv[1] + i]) + Gua_ObjectToReal(ogeodesic[i * mgeodesic->dimv[1] + k]));
-                            Gua_RealToObject(opath[j * mgeodesic->dimv[1] + k], i);
-                        }
-                    } else if ((Gua_ObjectType(ogeodesic[j * mgeodesic->dimv[1] + i]) == OBJECT_TYPE_REAL) && (Gua_ObjectType(ogeodesic[i * mgeodesic->dimv[1] + k]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(ogeodesic[j * mgeodesic->dimv[1] + k]) == OBJECT_TYPE_REAL)) {
-                        if ((Gua_ObjectToReal(ogeodesic[j * mgeodesic->dimv[1] + i]) + Gua_ObjectToInteger(ogeodesic[i * mgeodesic->dimv[1] + k])) < Gua_ObjectToReal(ogeodesic[j * mgeodesic->dimv[1] + k])) {
-                            Gua_RealToObject(ogeodesic[j * mgeodesic->dimv[1] + k], Gua_ObjectToReal(ogeodesic[j * mgeodesic->dimv[1] + i]) + Gua_ObjectToInteger(ogeodesic[i * mgeodesic->dimv[1] + k]));
-                            Gua_RealToObject(opath[j * mgeodesic->dimv[1] + k], i);
-                        }
-                    } else if ((Gua_ObjectType(ogeodesic[j * mgeodesic->dimv[1] + i]) == OBJECT_TYPE_REAL) && (Gua_ObjectType(ogeodesic[i * mgeodesic->dimv[1] + k]) == OBJECT_TYPE_REAL) && (Gua_ObjectType(ogeodesic[j * mgeodesic->dimv[1] + k]) == OBJECT_TYPE_INTEGER)) {
-                        if ((Gua_ObjectToReal(ogeodesic[j * mgeodesic->dimv[1] + i]) + Gua_ObjectToReal(ogeodesic[i * mgeodesic->dimv[1] + k])) < Gua_ObjectToInteger(ogeodesic[j * mgeodesic->dimv[1] + k])) {
-                            Gua_RealToObject(ogeodesic[j * mgeodesic->dimv[1] + k], Gua_ObjectToReal(ogeodesic[j * mgeodesic->dimv[1] + i]) + Gua_ObjectToReal(ogeodesic[i * mgeodesic->dimv[1] + k]));
-                            Gua_RealToObject(opath[j * mgeodesic->dimv[1] + k], i);
-                        }
-                    }
+        for (i = 0; i < n; i++) {
+            for (j = 0; j < n; j++) {
+                if (p[i * n + j] < 0) {
+                    Gua_IntegerToObject(opath[(i + 1) * dim + (j + 1)], -1);
+                } else {
+                    Gua_IntegerToObject(opath[(i + 1) * dim + (j + 1)], p[i * n + j] + 1);
                 }
             }
         }
         
-        for (i = 0; i < dim_i; i = i + 1) {
-            Gua_RealToObject(ogeodesic[0 * mgeodesic->dimv[1] + i], 0.0);
-            Gua_RealToObject(ogeodesic[i * mgeodesic->dimv[1] + 0], 0.0);
-            Gua_RealToObject(ogeodesic[i * mgeodesic->dimv[1] + i], 0.0);
-        }
-        
-        /* Fix geodesics. */
-        for (i = 0; i < dim_i; i = i + 1) {
-            for (j = 0; j < dim_j; j = j + 1) {
-                if (Gua_ObjectToInteger(ogeodesic[i * mgeodesic->dimv[1] + j]) == 999999999) {
-                    Gua_RealToObject(ogeodesic[i * mgeodesic->dimv[1] + j], 0.0);
-                }
-            }
-        }
+        Gua_Free(p);
     }
     
     return GUA_OK;
@@ -406,110 +605,42 @@ Gua_Status Cna_ShortestPath(Gua_Object *adj, Gua_Object *geodesic, Gua_String er
  *     C
  *
  * Function:
- *     Gua_Status Cna_FunctionWrapper(void *nspace, Gua_Short argc, Gua_Object *argv, Gua_Object *object, Gua_String error)
+ *     Gua_Short Cna_ReadLine(FILE *fp, Gua_Char **line, Gua_Length *size)
  *
  * Description:
- *     Functions wrapper.
+ *     Read a whole line of a file, growing the line buffer as needed.
  *
  * Arguments:
- *     nspace,    a pointer to a structure Gua_Namespace. Must do a cast before use it;
- *     argc,      the number of arguments to pass to the function;
- *     argv,      an array containing the arguments to the function;
- *                argv[0] is the function name;
- *     object,    a structure containing the return object of the function;
- *     error,     a pointer to the error message.
+ *     fp,          the file;
+ *     line,        a pointer to the line buffer;
+ *     size,        a pointer to the size of the line buffer.
  *
  * Results:
- *     The return object of the wrapped function.
+ *     The function returns false at the end of the file. A *Matrix row of
+ *     a large network does not fit in GUA_SIZE characters, so the line is
+ *     never split.
  */
-Gua_Status Cna_FunctionWrapper(void *nspace, Gua_Short argc, Gua_Object *argv, Gua_Object *object, Gua_String error)
+Gua_Short Cna_ReadLine(FILE *fp, Gua_Char **line, Gua_Length *size)
 {
-    Gua_Object path;
-    Gua_String errMessage;
-    
-    Gua_ClearPObject(object);
-    Gua_ClearObject(path);
+    Gua_Length length;
     
-    if (argc == 0) {
-        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-        sprintf(errMessage, "%s\n", "no function specified");
-        strcat(error, errMessage);
-        Gua_Free(errMessage);
-        
-        return GUA_ERROR;
-    }
+    length = 0;
     
-    if (strcmp(Gua_ObjectToString(argv[0]), "cnaFloydWarshallShortestPath") == 0) {
-        if ((argc != 2) && (argc != 3)) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
-        }
-        
-        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
-        }
+    while (fgets(*line + length, *size - length, fp) != NULL) {
+        length = length + strlen(*line + length);
         
-        if (argc == 3) {
-            if (Gua_ObjectType(argv[2]) != OBJECT_TYPE_STRING) {
-                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
-                strcat(error, errMessage);
-                Gua_Free(errMessage);
-                
-                return GUA_ERROR;
-            }
-        }
-        
-        if (Cna_FloydWarshallShortestPath(&argv[1], object, &path, error) != GUA_OK) {
-            return GUA_ERROR;
-        }
-        
-        if (argc == 2) {
-            if (!Gua_IsObjectStored(path)) {
-                Gua_FreeObject(&path);
-            }
-        } else {
-            if (Gua_SetVariable((Gua_Namespace *)nspace, Gua_ObjectToString(argv[2]), &path, SCOPE_STACK) != GUA_OK) {
-                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-                sprintf(errMessage, "%s %-.20s...\n", "can't set variable", Gua_ObjectToString(argv[2]));
-                strcat(error, errMessage);
-                Gua_Free(errMessage);
-            }
-        }
-    } else if (strcmp(Gua_ObjectToString(argv[0]), "cnaShortestPath") == 0) {
-        if (argc != 2) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
+        if ((length > 0) && ((*line)[length - 1] == '\n')) {
+            return true;
         }
-        
-        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
+        if (length < *size - 1) {
+            return true;
         }
         
-        if (Cna_ShortestPath(&argv[1], object, error) != GUA_OK) {
-            return GUA_ERROR;
-        }
+        *size = *size * 2;
+        *line = (Gua_Char *)realloc(*line, *size * sizeof(Gua_Char));
     }
     
-    return GUA_OK;
+    return length > 0;
 }
 
 /**
@@ -517,15 +648,1969 @@ Gua_Status Cna_FunctionWrapper(void *nspace, Gua_Short argc, Gua_Object *argv, G
  *     C
  *
  * Function:
- *     Gua_Status Cna_Init(void *nspace, int argc, char *argv[], char **env, Gua_String error)
+ *     Gua_Short Cna_IsSection(Gua_Char *p, Gua_String keyword)
  *
  * Description:
- *     Install library functions.
+ *     Check if a line of a Pajek file starts the section keyword.
  *
  * Arguments:
- *     nspace,    a pointer to a structure containing the variable and function namespace;
- *     argc,      the number of command line arguments;
- *     argv,      the command line arguments;
+ *     p,           the line, starting at the asterisk;
+ *     keyword,     the section keyword, such as "*edges".
+ *
+ * Results:
+ *     The function returns true if the line holds the whole keyword, in any
+ *     case, followed by a blank or the end of the line.
+ */
+Gua_Short Cna_IsSection(Gua_Char *p, Gua_String keyword)
+{
+    Gua_Length length;
+    
+    length = strlen(keyword);
+    
+    if (strncasecmp(p, keyword, length) != 0) {
+        return false;
+    }
+    
+    p = p + length;
+    
+    return (*p == '\0') || (*p == ' ') || (*p == '\t') || (*p == '\r') || (*p == '\n');
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Cna_GrowTriplets(Gua_Length **ti, Gua_Length **tj, Gua_Real **tv, Gua_Length *size, Gua_Length needed)
+ *
+ * Description:
+ *     Make room for the triplets of a sparse matrix being loaded.
+ *
+ * Arguments:
+ *     ti,          a pointer to the row indices;
+ *     tj,          a pointer to the column indices;
+ *     tv,          a pointer to the values;
+ *     size,        a pointer to the number of triplets allocated;
+ *     needed,      the number of triplets needed.
+ *
+ * Results:
+ *     The function doubles the arrays until they hold the triplets needed.
+ */
+void Cna_GrowTriplets(Gua_Length **ti, Gua_Length **tj, Gua_Real **tv, Gua_Length *size, Gua_Length needed)
+{
+    if (needed <= *size) {
+        return;
+    }
+    
+    *size = 2 * needed;
+    *ti = (Gua_Length *)realloc(*ti, *size * sizeof(Gua_Length));
+    *tj = (Gua_Length *)realloc(*tj, *size * sizeof(Gua_Length));
+    *tv = (Gua_Real *)realloc(*tv, *size * sizeof(Gua_Real));
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Cna_LoadSparse(Gua_String fileName, Gua_Object *adj, Gua_String error)
+ *
+ * Description:
+ *     Load a network in Pajek format to a sparse adjacency matrix. Unlike
+ *     cnaLoadFile, the matrix has no row and column for the vertex labels:
+ *     vertex k of the file is row and column k - 1, so a network with a
+ *     million vertices takes memory in proportion to its edges only.
+ *
+ * Arguments:
+ *     fileName,    the Pajek file;
+ *     adj,         a handle to the sparse adjacency matrix;
+ *     error,       a pointer to the error message.
+ *
+ * Results:
+ *     The function loads the *Vertices, *Edges, *Arcs, *Edgeslist,
+ *     *Arcslist and *Matrix sections of the file, and skips any other
+ *     section, such as *Network. An edge sets both directions; a repeated
+ *     edge or arc keeps its last weight.
+ */
+Gua_Status Cna_LoadSparse(Gua_String fileName, Gua_Object *adj, Gua_String error)
+{
+    FILE *fp;
+    Gua_Char *line;
+    Gua_Char *p;
+    Gua_Char *q;
+    Gua_Length *ti;
+    Gua_Length *tj;
+    Gua_Real *tv;
+    Gua_Length length;
+    Gua_Length n;
+    Gua_Length size;
+    Gua_Length count;
+    Gua_Length row;
+    Gua_Length i;
+    Gua_Length j;
+    Gua_Real v;
+    Gua_Short section;
+    Gua_Short valid;
+    Gua_String errMessage;
+    
+    fp = fopen(fileName, "r");
+    
+    if (fp == NULL) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "could not open file", fileName);
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    length = GUA_SIZE;
+    line = (Gua_Char *)Gua_Alloc(length * sizeof(Gua_Char));
+    
+    size = GUA_SIZE;
+    ti = (Gua_Length *)Gua_Alloc(size * sizeof(Gua_Length));
+    tj = (Gua_Length *)Gua_Alloc(size * sizeof(Gua_Length));
+    tv = (Gua_Real *)Gua_Alloc(size * sizeof(Gua_Real));
+    
+    n = -1;
+    count = 0;
+    row = 0;
+    section = CNA_SECTION_NONE;
+    valid = true;
+    
+    while (valid && Cna_ReadLine(fp, &line, &length)) {
+        p = line;
+        while ((*p == ' ') || (*p == '\t')) {
+            p++;
+        }
+        
+        if (*p == '*') {
+            if (Cna_IsSection(p, "*vertices")) {
+                section = CNA_SECTION_VERTICES;
+                n = strtol(p + 9, NULL, 10);
+                valid = n >= 0;
+            } else if (Cna_IsSection(p, "*edges")) {
+                section = CNA_SECTION_EDGES;
+                valid = n >= 0;
+            } else if (Cna_IsSection(p, "*arcs")) {
+                section = CNA_SECTION_ARCS;
+                valid = n >= 0;
+            } else if (Cna_IsSection(p, "*edgeslist")) {
+                section = CNA_SECTION_EDGESLIST;
+                valid = n >= 0;
+            } else if (Cna_IsSection(p, "*arcslist")) {
+                section = CNA_SECTION_ARCSLIST;
+                valid = n >= 0;
+            } else if (Cna_IsSection(p, "*matrix")) {
+                section = CNA_SECTION_MATRIX;
+                row = 0;
+                valid = n >= 0;
+            } else {
+                section = CNA_SECTION_NONE;
+            }
+            continue;
+        }
+        
+        if ((*p == '\0') || (*p == '\r') || (*p == '\n') || (section == CNA_SECTION_NONE) || (section == CNA_SECTION_VERTICES)) {
+            continue;
+        }
+        
+        /* Make room for the two triplets of an edge or a whole matrix row. */
+        Cna_GrowTriplets(&ti, &tj, &tv, &size, count + n + 2);
+        
+        if (section == CNA_SECTION_MATRIX) {
+            for (j = 0; j < n; j++) {
+                v = strtod(p, &q);
+                if (q == p) {
+                    break;
+                }
+                p = q;
+                if (v != 0.0) {
+                    ti[count] = row;
+                    tj[count] = j;
+                    tv[count] = v;
+                    count++;
+                }
+            }
+            row++;
+            valid = row <= n;
+            continue;
+        }
+        
+        i = strtol(p, &q, 10);
+        valid = (q != p) && (i >= 1) && (i <= n);
+        p = q;
+        
+        if ((section == CNA_SECTION_EDGESLIST) || (section == CNA_SECTION_ARCSLIST)) {
+            /* A list line holds a vertex and all its neighbours, with weight 1. */
+            while (valid) {
+                j = strtol(p, &q, 10);
+                if (q == p) {
+                    break;
+                }
+                valid = (j >= 1) && (j <= n);
+                p = q;
+                
+                Cna_GrowTriplets(&ti, &tj, &tv, &size, count + 2);
+                
+                ti[count] = i - 1;
+                tj[count] = j - 1;
+                tv[count] = 1.0;
+                count++;
+                
+                if ((section == CNA_SECTION_EDGESLIST) && (i != j)) {
+                    ti[count] = j - 1;
+                    tj[count] = i - 1;
+                    tv[count] = 1.0;
+                    count++;
+                }
+            }
+            /* Anything else left on the line is not a vertex. */
+            while ((*p == ' ') || (*p == '\t') || (*p == '\r') || (*p == '\n')) {
+                p++;
+            }
+            valid = valid && (*p == '\0');
+            continue;
+        }
+        
+        j = strtol(p, &q, 10);
+        valid = valid && (q != p) && (j >= 1) && (j <= n);
+        p = q;
+        v = strtod(p, &q);
+        if (q == p) {
+            v = 1.0;
+        }
+        
+        ti[count] = i - 1;
+        tj[count] = j - 1;
+        tv[count] = v;
+        count++;
+        
+        if ((section == CNA_SECTION_EDGES) && (i != j)) {
+            ti[count] = j - 1;
+            tj[count] = i - 1;
+            tv[count] = v;
+            count++;
+        }
+    }
+    
+    fclose(fp);
+    Gua_Free(line);
+    
+    if (!valid || (n < 0)) {
+        Gua_Free(tv);
+        Gua_Free(tj);
+        Gua_Free(ti);
+        
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "illegal network in file", fileName);
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    Matrix_SparseToPObject(adj, Matrix_SparseFromTriplets(n, n, count, ti, tj, tv, false));
+    
+    Gua_Free(tv);
+    Gua_Free(tj);
+    Gua_Free(ti);
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Cna_SparseDegrees(Gua_Object *adj, Gua_Short directed, Gua_Object *degrees, Gua_String error)
+ *
+ * Description:
+ *     Calculate the degree of each vertex of a network stored in a sparse
+ *     adjacency matrix, in one pass over its nonzero elements.
+ *
+ * Arguments:
+ *     adj,         a handle to the sparse adjacency matrix;
+ *     directed,    true if the network is directed;
+ *     degrees,     a matrix with a row per vertex and the columns out
+ *                  degree, in degree and degree;
+ *     error,       a pointer to the error message.
+ *
+ * Results:
+ *     The function calculates the degrees the same way cnaDegrees does,
+ *     with vertex k of the network in row k - 1.
+ */
+Gua_Status Cna_SparseDegrees(Gua_Object *adj, Gua_Short directed, Gua_Object *degrees, Gua_String error)
+{
+    Matrix_Sparse *s;
+    Gua_Matrix *m;
+    Gua_Object *o;
+    Gua_Length *in;
+    Gua_Length out;
+    Gua_Length i;
+    Gua_Length k;
+    Gua_String errMessage;
+    
+    s = Matrix_GetSparse(adj);
+    
+    if ((s == NULL) || (s->rows != s->cols)) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "the adjacency matrix must be a square sparse matrix");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    if (s->rows == 0) {
+        return GUA_OK;
+    }
+    
+    in = (Gua_Length *)Gua_Alloc(s->cols * sizeof(Gua_Length));
+    memset(in, 0, s->cols * sizeof(Gua_Length));
+    
+    for (k = 0; k < s->nnz; k++) {
+        in[s->colind[k]]++;
+    }
+    
+    Gua_MatrixToPObject(degrees, (struct Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix)), s->rows * 3);
+    m = (Gua_Matrix *)Gua_PObjectToMatrix(degrees);
+    m->dimc = 2;
+    m->dimv = (Gua_Length *)Gua_Alloc(2 * sizeof(Gua_Length));
+    m->dimv[0] = s->rows;
+    m->dimv[1] = 3;
+    m->object = (struct Gua_Object *)Gua_Alloc(s->rows * 3 * sizeof(Gua_Object));
+    o = (Gua_Object *)m->object;
+    
+    for (i = 0; i < s->rows; i++) {
+        out = s->rowp[i + 1] - s->rowp[i];
+        
+        Gua_IntegerToObject(o[i * 3], out);
+        Gua_IntegerToObject(o[i * 3 + 1], in[i]);
+        if (directed) {
+            Gua_IntegerToObject(o[i * 3 + 2], out + in[i]);
+        } else {
+            Gua_IntegerToObject(o[i * 3 + 2], out != 0 ? out : in[i]);
+        }
+    }
+    
+    Gua_Free(in);
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Cna_SpectralCentrality(Gua_Object *adj, Gua_Object *centrality, Gua_String error)
+ *
+ * Description:
+ *     Calculate the spectral centralities of each vertex from the
+ *     eigenvalues and eigenvectors of the adjacency matrix. A directed
+ *     network is taken through the symmetric part (A + A') / 2 of its
+ *     adjacency matrix.
+ *
+ * Arguments:
+ *     adj,           the adjacency matrix, or a handle to a sparse
+ *                    adjacency matrix;
+ *     centrality,    a matrix with a row per vertex and the columns
+ *                    eigenvector centrality, normalized to a largest value
+ *                    of one, and subgraph centrality, sum(v[i, j]^2 exp(w[j]));
+ *     error,         a pointer to the error message.
+ *
+ * Results:
+ *     The function keeps the vertex numbering of the adjacency matrix:
+ *     vertex k is in row k for a matrix, whose row and column 0 are not
+ *     part of the network, and in row k - 1 for a sparse matrix.
+ */
+Gua_Status Cna_SpectralCentrality(Gua_Object *adj, Gua_Object *centrality, Gua_String error)
+{
+    Gua_Matrix *madj;
+    Gua_Object *oadj;
+    Matrix_Sparse *s;
+    Gua_Real *a;
+    Gua_Real *w;
+    Gua_Real *c;
+    Gua_Real *v;
+    Gua_Real sum;
+    Gua_Real vmax;
+    Gua_Length rows;
+    Gua_Length first;
+    Gua_Length n;
+    Gua_Length i;
+    Gua_Length j;
+    Gua_Length k;
+    Gua_String errMessage;
+    
+    s = Matrix_GetSparse(adj);
+    
+    if (s != NULL) {
+        if (s->rows != s->cols) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "the adjacency matrix must be a square matrix");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        n = s->rows;
+        first = 0;
+        
+        a = (Gua_Real *)Gua_Alloc((n * n + 1) * sizeof(Gua_Real));
+        memset(a, 0, n * n * sizeof(Gua_Real));
+        
+        for (i = 0; i < n; i++) {
+            for (k = s->rowp[i]; k < s->rowp[i + 1]; k++) {
+                a[s->colind[k] * n + i] += 0.5 * s->values[k];
+                a[i * n + s->colind[k]] += 0.5 * s->values[k];
+            }
+        }
+    } else {
+        madj = Gua_PObjectType(adj) == OBJECT_TYPE_MATRIX ? (Gua_Matrix *)Gua_PObjectToMatrix(adj) : NULL;
+        
+        if ((madj == NULL) || (madj->dimc != 2) || (madj->dimv[0] != madj->dimv[1]) || (madj->dimv[0] < 2)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "the adjacency matrix must be a square matrix");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        oadj = (Gua_Object *)madj->object;
+        rows = madj->dimv[0];
+        n = rows - 1;
+        first = 1;
+        
+        /* Row and column 0 hold the vertex labels and are skipped. */
+        a = (Gua_Real *)Gua_Alloc((n * n + 1) * sizeof(Gua_Real));
+        memset(a, 0, n * n * sizeof(Gua_Real));
+        
+        for (i = 0; i < n; i++) {
+            for (j = 0; j < n; j++) {
+                k = (i + 1) * rows + j + 1;
+                if (Gua_ObjectType(oadj[k]) == OBJECT_TYPE_INTEGER) {
+                    sum = Gua_ObjectToInteger(oadj[k]);
+                } else if (Gua_ObjectType(oadj[k]) == OBJECT_TYPE_REAL) {
+                    sum = Gua_ObjectToReal(oadj[k]);
+                } else {
+                    continue;
+                }
+                a[j * n + i] += 0.5 * sum;
+                a[i * n + j] += 0.5 * sum;
+            }
+        }
+    }
+    
+    if (n == 0) {
+        Gua_Free(a);
+        
+        return GUA_OK;
+    }
+    
+    w = (Gua_Real *)Gua_Alloc((n + 1) * sizeof(Gua_Real));
+    
+    if (Numeric_SymmetricEigen(a, n, w, true) != GUA_OK) {
+        Gua_Free(w);
+        Gua_Free(a);
+        
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "the eigenvalues did not converge");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    c = (Gua_Real *)Gua_Alloc(((n + first) * 2 + 1) * sizeof(Gua_Real));
+    memset(c, 0, (n + first) * 2 * sizeof(Gua_Real));
+    
+    /* The eigenvector of the largest eigenvalue, the last one, with its sign made positive. */
+    v = a + (n - 1) * n;
+    sum = 0.0;
+    vmax = 0.0;
+    for (i = 0; i < n; i++) {
+        sum += v[i];
+        if (fabs(v[i]) > vmax) {
+            vmax = fabs(v[i]);
+        }
+    }
+    if (sum < 0.0) {
+        vmax = -vmax;
+    }
+    
+    for (i = 0; i < n; i++) {
+        c[(i + first) * 2] = vmax != 0.0 ? v[i] / vmax : 0.0;
+    }
+    
+    for (j = 0; j < n; j++) {
+        v = a + j * n;
+        for (i = 0; i < n; i++) {
+            c[(i + first) * 2 + 1] += v[i] * v[i] * exp(w[j]);
+        }
+    }
+    
+    Matrix_RealBufferToPObject(centrality, c, n + first, 2);
+    
+    Gua_Free(c);
+    Gua_Free(w);
+    Gua_Free(a);
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Short Cna_DefaultThreads(void)
+ *
+ * Description:
+ *     Get the default number of threads of the parallel functions.
+ *
+ * Arguments:
+ *     None.
+ *
+ * Results:
+ *     The number of online processors, or 1 where threads are not used.
+ */
+Gua_Short Cna_DefaultThreads(void)
+{
+#ifndef _WINDOWS_
+    long threads;
+    
+    threads = sysconf(_SC_NPROCESSORS_ONLN);
+    
+    if (threads < 1) {
+        return 1;
+    } else if (threads > CNA_MAX_THREADS) {
+        return CNA_MAX_THREADS;
+    }
+    
+    return (Gua_Short)threads;
+#else
+    return 1;
+#endif
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Matrix_Sparse *Cna_GetGraph(Gua_Object *adj, Gua_Length *first, Gua_String error)
+ *
+ * Description:
+ *     Get the CSR graph of a network. A sparse adjacency matrix is used as
+ *     it is; an adjacency matrix, whose row and column 0 hold the vertex
+ *     labels, is converted, and any numeric nonzero element is an arc.
+ *
+ * Arguments:
+ *     adj,      the adjacency matrix, or a handle to a sparse adjacency matrix;
+ *     first,    the row of vertex 1 in the results: 1 for a matrix and 0
+ *               for a sparse matrix;
+ *     error,    a pointer to the error message.
+ *
+ * Results:
+ *     The graph, or NULL on error. A graph converted from a matrix has
+ *     first set to 1 and must be freed with Matrix_FreeSparse.
+ */
+Matrix_Sparse *Cna_GetGraph(Gua_Object *adj, Gua_Length *first, Gua_String error)
+{
+    Gua_Matrix *madj;
+    Gua_Object *oadj;
+    Matrix_Sparse *s;
+    Gua_Length *ti;
+    Gua_Length *tj;
+    Gua_Real *tv;
+    Gua_Real v;
+    Gua_Length rows;
+    Gua_Length count;
+    Gua_Length i;
+    Gua_Length j;
+    Gua_Length k;
+    Gua_String errMessage;
+    
+    s = Matrix_GetSparse(adj);
+    
+    if (s != NULL) {
+        if (s->rows != s->cols) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "the adjacency matrix must be a square matrix");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return NULL;
+        }
+        
+        *first = 0;
+        
+        return s;
+    }
+    
+    madj = Gua_PObjectType(adj) == OBJECT_TYPE_MATRIX ? (Gua_Matrix *)Gua_PObjectToMatrix(adj) : NULL;
+    
+    if ((madj == NULL) || (madj->dimc != 2) || (madj->dimv[0] != madj->dimv[1]) || (madj->dimv[0] < 2)) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "the adjacency matrix must be a square matrix");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return NULL;
+    }
+    
+    oadj = (Gua_Object *)madj->object;
+    rows = madj->dimv[0];
+    
+    count = 0;
+    for (i = 1; i < rows; i++) {
+        for (j = 1; j < rows; j++) {
+            k = i * rows + j;
+            if ((Gua_ObjectType(oadj[k]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectToInteger(oadj[k]) != 0)) {
+                count++;
+            } else if ((Gua_ObjectType(oadj[k]) == OBJECT_TYPE_REAL) && (Gua_ObjectToReal(oadj[k]) != 0.0)) {
+                count++;
+            }
+        }
+    }
+    
+    ti = (Gua_Length *)Gua_Alloc((count + 1) * sizeof(Gua_Length));
+    tj = (Gua_Length *)Gua_Alloc((count + 1) * sizeof(Gua_Length));
+    tv = (Gua_Real *)Gua_Alloc((count + 1) * sizeof(Gua_Real));
+    
+    count = 0;
+    for (i = 1; i < rows; i++) {
+        for (j = 1; j < rows; j++) {
+            k = i * rows + j;
+            if (Gua_ObjectType(oadj[k]) == OBJECT_TYPE_INTEGER) {
+                v = Gua_ObjectToInteger(oadj[k]);
+            } else if (Gua_ObjectType(oadj[k]) == OBJECT_TYPE_REAL) {
+                v = Gua_ObjectToReal(oadj[k]);
+            } else {
+                continue;
+            }
+            if (v != 0.0) {
+                ti[count] = i - 1;
+                tj[count] = j - 1;
+                tv[count] = v;
+                count++;
+            }
+        }
+    }
+    
+    s = Matrix_SparseFromTriplets(rows - 1, rows - 1, count, ti, tj, tv, false);
+    
+    Gua_Free(tv);
+    Gua_Free(tj);
+    Gua_Free(ti);
+    
+    *first = 1;
+    
+    return s;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void *Cna_BreadthFirstSearch(void *data)
+ *
+ * Description:
+ *     Run a breadth first search from each source vertex in the share of
+ *     one thread, counting the shortest paths of each vertex as in the
+ *     Brandes algorithm. The queue of a search holds the vertices in order
+ *     of distance, so the dependencies of the betweenness centrality are
+ *     accumulated walking it backwards, without predecessor lists.
+ *
+ * Arguments:
+ *     data,    a pointer to a Cna_GraphTask structure.
+ *
+ * Results:
+ *     For each source vertex s, the function sets the row s of the
+ *     geodesic matrix and the sum of the distances from s, and adds the
+ *     dependencies of s to the betweenness of the thread, for the outputs
+ *     of the task that are not NULL.
+ */
+void *Cna_BreadthFirstSearch(void *data)
+{
+    Cna_GraphTask *task;
+    Matrix_Sparse *g;
+    Gua_Length *dist;
+    Gua_Length *queue;
+    Gua_Real *sigma;
+    Gua_Real *delta;
+    Gua_Length *rowp;
+    Gua_Length *colind;
+    Gua_Real *row;
+    Gua_Real sum;
+    Gua_Real sv;
+    Gua_Real dv;
+    Gua_Length n;
+    Gua_Length s;
+    Gua_Length v;
+    Gua_Length w;
+    Gua_Length k;
+    Gua_Length q;
+    Gua_Length next;
+    Gua_Length head;
+    Gua_Length tail;
+    
+    task = (Cna_GraphTask *)data;
+    g = task->g;
+    n = g->rows;
+    rowp = g->rowp;
+    colind = g->colind;
+    
+    dist = (Gua_Length *)Gua_Alloc((n + 1) * sizeof(Gua_Length));
+    queue = (Gua_Length *)Gua_Alloc((n + 1) * sizeof(Gua_Length));
+    sigma = (Gua_Real *)Gua_Alloc((n + 1) * sizeof(Gua_Real));
+    delta = (Gua_Real *)Gua_Alloc((n + 1) * sizeof(Gua_Real));
+    
+    for (v = 0; v < n; v++) {
+        dist[v] = -1;
+    }
+    
+    for (s = task->id; s < n; s = s + task->threads) {
+        dist[s] = 0;
+        sigma[s] = 1.0;
+        queue[0] = s;
+        head = 0;
+        tail = 1;
+        sum = 0.0;
+        
+        while (head < tail) {
+            v = queue[head];
+            head++;
+            next = dist[v] + 1;
+            sv = sigma[v];
+            
+            for (k = rowp[v]; k < rowp[v + 1]; k++) {
+                w = colind[k];
+                
+                if (dist[w] < 0) {
+                    dist[w] = next;
+                    sigma[w] = 0.0;
+                    sum += next;
+                    queue[tail] = w;
+                    tail++;
+                }
+                if (dist[w] == next) {
+                    sigma[w] += sv;
+                }
+            }
+        }
+        
+        if (task->geodesic != NULL) {
+            row = task->geodesic + (s + task->first) * (n + task->first) + task->first;
+            for (q = 1; q < tail; q++) {
+                row[queue[q]] = dist[queue[q]];
+            }
+        }
+        
+        if (task->distance != NULL) {
+            task->distance[s] = sum;
+        }
+        
+        if (task->betweenness != NULL) {
+            for (q = tail - 1; q >= 0; q--) {
+                v = queue[q];
+                next = dist[v] + 1;
+                dv = 0.0;
+                
+                for (k = rowp[v]; k < rowp[v + 1]; k++) {
+                    w = colind[k];
+                    
+                    if (dist[w] == next) {
+                        dv += (1.0 + delta[w]) / sigma[w];
+                    }
+                }
+                delta[v] = sigma[v] * dv;
+                if (v != s) {
+                    task->betweenness[v] += delta[v];
+                }
+            }
+        }
+        
+        for (q = 0; q < tail; q++) {
+            dist[queue[q]] = -1;
+        }
+    }
+    
+    Gua_Free(delta);
+    Gua_Free(sigma);
+    Gua_Free(queue);
+    Gua_Free(dist);
+    
+    return NULL;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void *Cna_LocalClustering(void *data)
+ *
+ * Description:
+ *     Calculate the clustering coefficient of the vertices in the share of
+ *     one thread, marking the neighbors of each vertex and counting the
+ *     arcs among them.
+ *
+ * Arguments:
+ *     data,    a pointer to a Cna_GraphTask structure.
+ *
+ * Results:
+ *     The function sets the clustering coefficient of the vertices of the
+ *     task. Loops are ignored.
+ */
+void *Cna_LocalClustering(void *data)
+{
+    Cna_GraphTask *task;
+    Matrix_Sparse *g;
+    Gua_Length *mark;
+    Gua_Length links;
+    Gua_Length ki;
+    Gua_Length n;
+    Gua_Length i;
+    Gua_Length u;
+    Gua_Length k;
+    Gua_Length l;
+    
+    task = (Cna_GraphTask *)data;
+    g = task->g;
+    n = g->rows;
+    
+    mark = (Gua_Length *)Gua_Alloc((n + 1) * sizeof(Gua_Length));
+    
+    for (i = 0; i < n; i++) {
+        mark[i] = -1;
+    }
+    
+    for (i = task->id; i < n; i = i + task->threads) {
+        ki = 0;
+        for (k = g->rowp[i]; k < g->rowp[i + 1]; k++) {
+            if (g->colind[k] != i) {
+                mark[g->colind[k]] = i;
+                ki++;
+            }
+        }
+        
+        links = 0;
+        for (k = g->rowp[i]; k < g->rowp[i + 1]; k++) {
+            u = g->colind[k];
+            
+            if (u == i) {
+                continue;
+            }
+            for (l = g->rowp[u]; l < g->rowp[u + 1]; l++) {
+                if ((g->colind[l] != u) && (mark[g->colind[l]] == i)) {
+                    links++;
+                }
+            }
+        }
+        
+        if (ki > 1) {
+            task->clustering[i + task->first] = links / (ki * (ki - 1.0));
+        }
+    }
+    
+    Gua_Free(mark);
+    
+    return NULL;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Cna_RunGraphTasks(void *(*worker)(void *), Cna_GraphTask *task, Gua_Short threads)
+ *
+ * Description:
+ *     Run a worker on each task, one thread per task.
+ *
+ * Arguments:
+ *     worker,     the worker function;
+ *     task,       the array of tasks;
+ *     threads,    the number of tasks.
+ *
+ * Results:
+ *     The function returns when all the tasks are done. A task whose
+ *     thread could not be started runs in the calling thread.
+ */
+void Cna_RunGraphTasks(void *(*worker)(void *), Cna_GraphTask *task, Gua_Short threads)
+{
+#ifndef _WINDOWS_
+    pthread_t thread[CNA_MAX_THREADS];
+    Gua_Short started[CNA_MAX_THREADS];
+#endif
+    Gua_Short t;
+
+#ifndef _WINDOWS_
+    for (t = 1; t < threads; t++) {
+        started[t] = pthread_create(&thread[t], NULL, worker, &task[t]) == 0;
+    }
+    
+    worker(&task[0]);
+    
+    for (t = 1; t < threads; t++) {
+        if (started[t]) {
+            pthread_join(thread[t], NULL);
+        } else {
+            worker(&task[t]);
+        }
+    }
+#else
+    for (t = 0; t < threads; t++) {
+        worker(&task[t]);
+    }
+#endif
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Cna_SearchGraph(Matrix_Sparse *g, Gua_Length first, Gua_Real *geodesic, Gua_Real *distance, Gua_Real *betweenness, Gua_Short threads)
+ *
+ * Description:
+ *     Run a breadth first search from every vertex of a graph, sharing the
+ *     source vertices among the threads.
+ *
+ * Arguments:
+ *     g,              the graph;
+ *     first,          the row and column of vertex 1 in geodesic;
+ *     geodesic,       the (n + first) x (n + first) geodesic matrix, set to
+ *                     zero, or NULL;
+ *     distance,       the sum of the distances from each vertex, or NULL;
+ *     betweenness,    the betweenness of each vertex, set to zero, or NULL;
+ *     threads,        the number of threads.
+ *
+ * Results:
+ *     The function fills the outputs that are not NULL. The betweenness
+ *     counts each ordered pair of vertices.
+ */
+void Cna_SearchGraph(Matrix_Sparse *g, Gua_Length first, Gua_Real *geodesic, Gua_Real *distance, Gua_Real *betweenness, Gua_Short threads)
+{
+    Cna_GraphTask task[CNA_MAX_THREADS];
+    Gua_Length n;
+    Gua_Length i;
+    Gua_Short t;
+    
+    n = g->rows;
+    
+    if (threads > n) {
+        threads = n;
+    }
+    if (threads < 1) {
+        threads = 1;
+    } else if (threads > CNA_MAX_THREADS) {
+        threads = CNA_MAX_THREADS;
+    }
+    
+    for (t = 0; t < threads; t++) {
+        task[t].g = g;
+        task[t].first = first;
+        task[t].geodesic = geodesic;
+        task[t].distance = distance;
+        task[t].betweenness = NULL;
+        task[t].clustering = NULL;
+        task[t].id = t;
+        task[t].threads = threads;
+        
+        /* Each thread adds its dependencies to a betweenness of its own. */
+        if (betweenness != NULL) {
+            if (t == 0) {
+                task[t].betweenness = betweenness;
+            } else {
+                task[t].betweenness = (Gua_Real *)Gua_Alloc((n + 1) * sizeof(Gua_Real));
+                memset(task[t].betweenness, 0, n * sizeof(Gua_Real));
+            }
+        }
+    }
+    
+    Cna_RunGraphTasks(Cna_BreadthFirstSearch, task, threads);
+    
+    if (betweenness != NULL) {
+        for (t = 1; t < threads; t++) {
+            for (i = 0; i < n; i++) {
+                betweenness[i] += task[t].betweenness[i];
+            }
+            Gua_Free(task[t].betweenness);
+        }
+    }
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Cna_Graph(Gua_Object *adj, Gua_Object *graph, Gua_String error)
+ *
+ * Description:
+ *     Convert an adjacency matrix to a CSR graph.
+ *
+ * Arguments:
+ *     adj,      the adjacency matrix;
+ *     graph,    a handle to the sparse adjacency matrix of the graph;
+ *     error,    a pointer to the error message.
+ *
+ * Results:
+ *     Vertex k of the adjacency matrix is row and column k - 1 of the
+ *     graph, as in cnaLoadSparse.
+ */
+Gua_Status Cna_Graph(Gua_Object *adj, Gua_Object *graph, Gua_String error)
+{
+    Matrix_Sparse *g;
+    Gua_Length first;
+    
+    g = Cna_GetGraph(adj, &first, error);
+    
+    if (g == NULL) {
+        return GUA_ERROR;
+    }
+    
+    Matrix_SparseToPObject(graph, g);
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Cna_GraphEdges(Gua_Object *edges, Gua_Length n, Gua_Short directed, Gua_Object *graph, Gua_String error)
+ *
+ * Description:
+ *     Build a CSR graph from an edge list.
+ *
+ * Arguments:
+ *     edges,       a matrix with a row per edge and the columns source
+ *                  vertex, target vertex and, optionally, weight, with the
+ *                  vertices numbered from 1;
+ *     n,           the number of vertices, or 0 to take the largest vertex;
+ *     directed,    true if the edges are arcs;
+ *     graph,       a handle to the sparse adjacency matrix of the graph;
+ *     error,       a pointer to the error message.
+ *
+ * Results:
+ *     As in cnaLoadSparse, an edge sets both directions, the weight is 1
+ *     if not given and a repeated edge keeps its last weight.
+ */
+Gua_Status Cna_GraphEdges(Gua_Object *edges, Gua_Length n, Gua_Short directed, Gua_Object *graph, Gua_String error)
+{
+    Gua_Real *x;
+    Gua_Length *ti;
+    Gua_Length *tj;
+    Gua_Real *tv;
+    Gua_Length rows;
+    Gua_Length cols;
+    Gua_Length count;
+    Gua_Length i;
+    Gua_Length j;
+    Gua_Length k;
+    Gua_String errMessage;
+    
+    x = Matrix_GetRealBuffer(edges, &rows, &cols);
+    
+    if ((x == NULL) || ((cols != 2) && (cols != 3))) {
+        if (x != NULL) {
+            Gua_Free(x);
+        }
+        
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "the edge list must be a matrix with 2 or 3 columns");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    if (n <= 0) {
+        for (k = 0; k < rows; k++) {
+            if (x[k * cols] > n) {
+                n = (Gua_Length)x[k * cols];
+            }
+            if (x[k * cols + 1] > n) {
+                n = (Gua_Length)x[k * cols + 1];
+            }
+        }
+    }
+    
+    ti = (Gua_Length *)Gua_Alloc((2 * rows + 1) * sizeof(Gua_Length));
+    tj = (Gua_Length *)Gua_Alloc((2 * rows + 1) * sizeof(Gua_Length));
+    tv = (Gua_Real *)Gua_Alloc((2 * rows + 1) * sizeof(Gua_Real));
+    
+    count = 0;
+    for (k = 0; k < rows; k++) {
+        i = (Gua_Length)x[k * cols];
+        j = (Gua_Length)x[k * cols + 1];
+        
+        if ((i != x[k * cols]) || (j != x[k * cols + 1]) || (i < 1) || (i > n) || (j < 1) || (j > n)) {
+            Gua_Free(tv);
+            Gua_Free(tj);
+            Gua_Free(ti);
+            Gua_Free(x);
+            
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %ld...\n", "illegal vertex in edge", (long)(k + 1));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        ti[count] = i - 1;
+        tj[count] = j - 1;
+        tv[count] = cols == 3 ? x[k * cols + 2] : 1.0;
+        count++;
+        
+        if (!directed && (i != j)) {
+            ti[count] = j - 1;
+            tj[count] = i - 1;
+            tv[count] = cols == 3 ? x[k * cols + 2] : 1.0;
+            count++;
+        }
+    }
+    
+    Matrix_SparseToPObject(graph, Matrix_SparseFromTriplets(n, n, count, ti, tj, tv, false));
+    
+    Gua_Free(tv);
+    Gua_Free(tj);
+    Gua_Free(ti);
+    Gua_Free(x);
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Cna_GraphShortestPath(Gua_Object *adj, Gua_Object *geodesic, Gua_Short threads, Gua_String error)
+ *
+ * Description:
+ *     Calculate the number of arcs of the shortest path between each pair
+ *     of vertices with a breadth first search from every vertex, in time
+ *     proportional to the number of vertices times the number of arcs.
+ *
+ * Arguments:
+ *     adj,         the adjacency matrix, or a handle to a sparse adjacency matrix;
+ *     geodesic,    a matrix containing the shortest path between each pair of vertices of the network;
+ *     threads,     the number of threads;
+ *     error,       a pointer to the error message.
+ *
+ * Results:
+ *     As in cnaShortestPath, pairs without a path have geodesic 0 and
+ *     vertex k is in row k for a matrix and in row k - 1 for a sparse matrix.
+ */
+Gua_Status Cna_GraphShortestPath(Gua_Object *adj, Gua_Object *geodesic, Gua_Short threads, Gua_String error)
+{
+    Matrix_Sparse *g;
+    Gua_Real *d;
+    Gua_Length first;
+    Gua_Length l;
+    
+    g = Cna_GetGraph(adj, &first, error);
+    
+    if (g == NULL) {
+        return GUA_ERROR;
+    }
+    
+    l = (g->rows + first) * (g->rows + first);
+    
+    d = (Gua_Real *)Gua_Alloc((l + 1) * sizeof(Gua_Real));
+    memset(d, 0, l * sizeof(Gua_Real));
+    
+    Cna_SearchGraph(g, first, d, NULL, NULL, threads);
+    
+    Matrix_RealBufferToPObject(geodesic, d, g->rows + first, g->rows + first);
+    
+    Gua_Free(d);
+    
+    if (first) {
+        Matrix_FreeSparse(g);
+    }
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Cna_GraphCentrality(Gua_Object *adj, Gua_Short directed, Gua_Object *centrality, Gua_Short threads, Gua_String error)
+ *
+ * Description:
+ *     Calculate the closeness and betweenness centralities of each vertex
+ *     with the Brandes algorithm, a breadth first search from every vertex.
+ *
+ * Arguments:
+ *     adj,           the adjacency matrix, or a handle to a sparse adjacency matrix;
+ *     directed,      true if the network is directed;
+ *     centrality,    a matrix with a row per vertex and the same columns
+ *                    as cnaCentrality: closeness, betweenness, normalized
+ *                    closeness, normalized betweenness and the sum of the
+ *                    distances to the other vertices;
+ *     threads,       the number of threads;
+ *     error,         a pointer to the error message.
+ *
+ * Results:
+ *     The betweenness counts each pair of vertices once in an undirected
+ *     network and each ordered pair in a directed one, and is normalized
+ *     by the number of such pairs not including the vertex. Vertex k is in
+ *     row k for a matrix and in row k - 1 for a sparse matrix. The
+ *     closeness columns equal those of cnaCentrality. The betweenness is
+ *     the exact sum of sigma_ji * sigma_ik / sigma_jk, so it differs from
+ *     the fmax approximation of cnaCentrality whenever a pair of vertices
+ *     has more than one geodesic.
+ */
+Gua_Status Cna_GraphCentrality(Gua_Object *adj, Gua_Short directed, Gua_Object *centrality, Gua_Short threads, Gua_String error)
+{
+    Matrix_Sparse *g;
+    Gua_Real *distance;
+    Gua_Real *betweenness;
+    Gua_Real *c;
+    Gua_Real pairs;
+    Gua_Length first;
+    Gua_Length n;
+    Gua_Length i;
+    
+    g = Cna_GetGraph(adj, &first, error);
+    
+    if (g == NULL) {
+        return GUA_ERROR;
+    }
+    
+    n = g->rows;
+    
+    distance = (Gua_Real *)Gua_Alloc((n + 1) * sizeof(Gua_Real));
+    betweenness = (Gua_Real *)Gua_Alloc((n + 1) * sizeof(Gua_Real));
+    memset(betweenness, 0, n * sizeof(Gua_Real));
+    
+    Cna_SearchGraph(g, first, NULL, distance, betweenness, threads);
+    
+    c = (Gua_Real *)Gua_Alloc(((n + first) * 5 + 1) * sizeof(Gua_Real));
+    memset(c, 0, (n + first) * 5 * sizeof(Gua_Real));
+    
+    pairs = (n - 1.0) * (n - 2.0);
+    if (!directed) {
+        pairs = pairs / 2.0;
+    }
+    
+    for (i = 0; i < n; i++) {
+        if (distance[i] > 0.0) {
+            c[(i + first) * 5] = 1.0 / distance[i];
+            c[(i + first) * 5 + 2] = (n - 1.0) / distance[i];
+            c[(i + first) * 5 + 4] = distance[i];
+        }
+        
+        /* An undirected network has each path searched from both ends. */
+        c[(i + first) * 5 + 1] = directed ? betweenness[i] : betweenness[i] / 2.0;
+        if (pairs > 0.0) {
+            c[(i + first) * 5 + 3] = c[(i + first) * 5 + 1] / pairs;
+        }
+    }
+    
+    Matrix_RealBufferToPObject(centrality, c, n + first, 5);
+    
+    Gua_Free(c);
+    Gua_Free(betweenness);
+    Gua_Free(distance);
+    
+    if (first) {
+        Matrix_FreeSparse(g);
+    }
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Cna_GraphClustering(Gua_Object *adj, Gua_Short directed, Gua_Object *clustering, Gua_Short threads, Gua_String error)
+ *
+ * Description:
+ *     Calculate the clustering coefficient of each vertex, sharing the
+ *     vertices among the threads.
+ *
+ * Arguments:
+ *     adj,           the adjacency matrix, or a handle to a sparse adjacency matrix;
+ *     directed,      true if the network is directed;
+ *     clustering,    a matrix with a row per vertex and its clustering coefficient;
+ *     threads,       the number of threads;
+ *     error,         a pointer to the error message.
+ *
+ * Results:
+ *     As in cnaClustering, a directed network is taken as undirected.
+ *     Vertex k is in row k for a matrix and in row k - 1 for a sparse matrix.
+ */
+Gua_Status Cna_GraphClustering(Gua_Object *adj, Gua_Short directed, Gua_Object *clustering, Gua_Short threads, Gua_String error)
+{
+    Cna_GraphTask task[CNA_MAX_THREADS];
+    Matrix_Sparse *g;
+    Matrix_Sparse *u;
+    Gua_Length *ti;
+    Gua_Length *tj;
+    Gua_Real *tv;
+    Gua_Real *c;
+    Gua_Length first;
+    Gua_Length n;
+    Gua_Length i;
+    Gua_Length k;
+    Gua_Short t;
+    
+    g = Cna_GetGraph(adj, &first, error);
+    
+    if (g == NULL) {
+        return GUA_ERROR;
+    }
+    
+    n = g->rows;
+    u = g;
+    
+    /* The undirected graph has an edge wherever there is an arc in either direction. */
+    if (directed) {
+        ti = (Gua_Length *)Gua_Alloc((2 * g->nnz + 1) * sizeof(Gua_Length));
+        tj = (Gua_Length *)Gua_Alloc((2 * g->nnz + 1) * sizeof(Gua_Length));
+        tv = (Gua_Real *)Gua_Alloc((2 * g->nnz + 1) * sizeof(Gua_Real));
+        
+        for (i = 0; i < n; i++) {
+            for (k = g->rowp[i]; k < g->rowp[i + 1]; k++) {
+                ti[2 * k] = i;
+                tj[2 * k] = g->colind[k];
+                tv[2 * k] = 1.0;
+                ti[2 * k + 1] = g->colind[k];
+                tj[2 * k + 1] = i;
+                tv[2 * k + 1] = 1.0;
+            }
+        }
+        
+        u = Matrix_SparseFromTriplets(n, n, 2 * g->nnz, ti, tj, tv, false);
+        
+        Gua_Free(tv);
+        Gua_Free(tj);
+        Gua_Free(ti);
+    }
+    
+    c = (Gua_Real *)Gua_Alloc((n + first + 1) * sizeof(Gua_Real));
+    memset(c, 0, (n + first) * sizeof(Gua_Real));
+    
+    if (threads > n) {
+        threads = n;
+    }
+    if (threads < 1) {
+        threads = 1;
+    } else if (threads > CNA_MAX_THREADS) {
+        threads = CNA_MAX_THREADS;
+    }
+    
+    for (t = 0; t < threads; t++) {
+        task[t].g = u;
+        task[t].first = first;
+        task[t].geodesic = NULL;
+        task[t].distance = NULL;
+        task[t].betweenness = NULL;
+        task[t].clustering = c;
+        task[t].id = t;
+        task[t].threads = threads;
+    }
+    
+    Cna_RunGraphTasks(Cna_LocalClustering, task, threads);
+    
+    Matrix_RealBufferToPObject(clustering, c, n + first, 1);
+    
+    Gua_Free(c);
+    
+    if (u != g) {
+        Matrix_FreeSparse(u);
+    }
+    if (first) {
+        Matrix_FreeSparse(g);
+    }
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Cna_GraphDegreeDistribution(Gua_Object *adj, Gua_Short directed, Gua_Object *distribution, Gua_String error)
+ *
+ * Description:
+ *     Calculate the degree distribution of a network with a counting sort
+ *     of the degrees of its vertices.
+ *
+ * Arguments:
+ *     adj,             the adjacency matrix, or a handle to a sparse adjacency matrix;
+ *     directed,        true if the network is directed;
+ *     distribution,    a matrix with a row per degree found and the same
+ *                      columns as cnaDegreeDistribution: degree, number of
+ *                      vertices and percentage of the vertices;
+ *     error,           a pointer to the error message.
+ *
+ * Results:
+ *     The degrees are taken as in cnaDegrees and sorted in ascending order.
+ */
+Gua_Status Cna_GraphDegreeDistribution(Gua_Object *adj, Gua_Short directed, Gua_Object *distribution, Gua_String error)
+{
+    Matrix_Sparse *g;
+    Gua_Matrix *m;
+    Gua_Object *o;
+    Gua_Length *in;
+    Gua_Length *degree;
+    Gua_Length *count;
+    Gua_Length first;
+    Gua_Length out;
+    Gua_Length max;
+    Gua_Length rows;
+    Gua_Length n;
+    Gua_Length i;
+    Gua_Length k;
+    
+    g = Cna_GetGraph(adj, &first, error);
+    
+    if (g == NULL) {
+        return GUA_ERROR;
+    }
+    
+    n = g->rows;
+    
+    if (n == 0) {
+        if (first) {
+            Matrix_FreeSparse(g);
+        }
+        
+        return GUA_OK;
+    }
+    
+    in = (Gua_Length *)Gua_Alloc((n + 1) * sizeof(Gua_Length));
+    degree = (Gua_Length *)Gua_Alloc((n + 1) * sizeof(Gua_Length));
+    memset(in, 0, n * sizeof(Gua_Length));
+    
+    for (k = 0; k < g->nnz; k++) {
+        in[g->colind[k]]++;
+    }
+    
+    max = 0;
+    for (i = 0; i < n; i++) {
+        out = g->rowp[i + 1] - g->rowp[i];
+        
+        if (directed) {
+            degree[i] = out + in[i];
+        } else {
+            degree[i] = out != 0 ? out : in[i];
+        }
+        if (degree[i] > max) {
+            max = degree[i];
+        }
+    }
+    
+    count = (Gua_Length *)Gua_Alloc((max + 2) * sizeof(Gua_Length));
+    memset(count, 0, (max + 1) * sizeof(Gua_Length));
+    
+    rows = 0;
+    for (i = 0; i < n; i++) {
+        if (count[degree[i]] == 0) {
+            rows++;
+        }
+        count[degree[i]]++;
+    }
+    
+    Gua_MatrixToPObject(distribution, (struct Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix)), rows * 3);
+    m = (Gua_Matrix *)Gua_PObjectToMatrix(distribution);
+    m->dimc = 2;
+    m->dimv = (Gua_Length *)Gua_Alloc(2 * sizeof(Gua_Length));
+    m->dimv[0] = rows;
+    m->dimv[1] = 3;
+    m->object = (struct Gua_Object *)Gua_Alloc((rows * 3 + 1) * sizeof(Gua_Object));
+    o = (Gua_Object *)m->object;
+    
+    i = 0;
+    for (k = 0; k <= max; k++) {
+        if (count[k] > 0) {
+            Gua_IntegerToObject(o[i * 3], k);
+            Gua_IntegerToObject(o[i * 3 + 1], count[k]);
+            Gua_RealToObject(o[i * 3 + 2], (count[k] * 100.0) / n);
+            i++;
+        }
+    }
+    
+    Gua_Free(count);
+    Gua_Free(degree);
+    Gua_Free(in);
+    
+    if (first) {
+        Matrix_FreeSparse(g);
+    }
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Cna_FunctionWrapper(void *nspace, Gua_Short argc, Gua_Object *argv, Gua_Object *object, Gua_String error)
+ *
+ * Description:
+ *     Functions wrapper.
+ *
+ * Arguments:
+ *     nspace,    a pointer to a structure Gua_Namespace. Must do a cast before use it;
+ *     argc,      the number of arguments to pass to the function;
+ *     argv,      an array containing the arguments to the function;
+ *                argv[0] is the function name;
+ *     object,    a structure containing the return object of the function;
+ *     error,     a pointer to the error message.
+ *
+ * Results:
+ *     The return object of the wrapped function.
+ */
+Gua_Status Cna_FunctionWrapper(void *nspace, Gua_Short argc, Gua_Object *argv, Gua_Object *object, Gua_String error)
+{
+    Gua_Object path;
+    Gua_Short threads;
+    Gua_String errMessage;
+    
+    Gua_ClearPObject(object);
+    Gua_ClearObject(path);
+    
+    if (argc == 0) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s\n", "no function specified");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    if (strcmp(Gua_ObjectToString(argv[0]), "cnaFloydWarshallShortestPath") == 0) {
+        if ((argc < 2) || (argc > 4)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (argc >= 3) {
+            if (Gua_ObjectType(argv[2]) != OBJECT_TYPE_STRING) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+        }
+        
+        threads = Cna_DefaultThreads();
+        
+        if (argc == 4) {
+            if (Gua_ObjectType(argv[3]) != OBJECT_TYPE_INTEGER) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 3 for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+            
+            threads = (Gua_Short)Gua_ObjectToInteger(argv[3]);
+        }
+        
+        /* Only build the path matrix if a variable was given to hold it. */
+        if ((argc >= 3) && (Gua_ObjectLength(argv[2]) > 0)) {
+            if (Cna_FloydWarshallShortestPath(&argv[1], object, &path, threads, error) != GUA_OK) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "illegal arguments for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+            
+            if (Gua_SetVariable((Gua_Namespace *)nspace, Gua_ObjectToString(argv[2]), &path, SCOPE_STACK) != GUA_OK) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "can't set variable", Gua_ObjectToString(argv[2]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+            }
+        } else {
+            if (Cna_FloydWarshallShortestPath(&argv[1], object, NULL, threads, error) != GUA_OK) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "illegal arguments for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "cnaGraph") == 0) {
+        if (argc != 2) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Cna_Graph(&argv[1], object, error) != GUA_OK) {
+            return GUA_ERROR;
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "cnaGraphCentrality") == 0) {
+        if ((argc < 2) || (argc > 4)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if ((Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) && (Gua_ObjectType(argv[1]) != OBJECT_TYPE_HANDLE)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (argc >= 3) {
+            if (Gua_ObjectType(argv[2]) != OBJECT_TYPE_INTEGER) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+        }
+        
+        if (argc >= 4) {
+            if (Gua_ObjectType(argv[3]) != OBJECT_TYPE_INTEGER) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 3 for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+        }
+        
+        if (Cna_GraphCentrality(&argv[1], argc >= 3 ? Gua_ObjectToInteger(argv[2]) != 0 : false, object, argc == 4 ? (Gua_Short)Gua_ObjectToInteger(argv[3]) : Cna_DefaultThreads(), error) != GUA_OK) {
+            return GUA_ERROR;
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "cnaGraphClustering") == 0) {
+        if ((argc < 2) || (argc > 4)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if ((Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) && (Gua_ObjectType(argv[1]) != OBJECT_TYPE_HANDLE)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (argc >= 3) {
+            if (Gua_ObjectType(argv[2]) != OBJECT_TYPE_INTEGER) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+        }
+        
+        if (argc >= 4) {
+            if (Gua_ObjectType(argv[3]) != OBJECT_TYPE_INTEGER) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 3 for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+        }
+        
+        if (Cna_GraphClustering(&argv[1], argc >= 3 ? Gua_ObjectToInteger(argv[2]) != 0 : false, object, argc == 4 ? (Gua_Short)Gua_ObjectToInteger(argv[3]) : Cna_DefaultThreads(), error) != GUA_OK) {
+            return GUA_ERROR;
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "cnaGraphDegreeDistribution") == 0) {
+        if ((argc < 2) || (argc > 3)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if ((Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) && (Gua_ObjectType(argv[1]) != OBJECT_TYPE_HANDLE)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (argc >= 3) {
+            if (Gua_ObjectType(argv[2]) != OBJECT_TYPE_INTEGER) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+        }
+        
+        if (Cna_GraphDegreeDistribution(&argv[1], argc >= 3 ? Gua_ObjectToInteger(argv[2]) != 0 : false, object, error) != GUA_OK) {
+            return GUA_ERROR;
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "cnaGraphEdges") == 0) {
+        if ((argc < 2) || (argc > 4)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (argc >= 3) {
+            if (Gua_ObjectType(argv[2]) != OBJECT_TYPE_INTEGER) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+        }
+        
+        if (argc >= 4) {
+            if (Gua_ObjectType(argv[3]) != OBJECT_TYPE_INTEGER) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 3 for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+        }
+        
+        if (Cna_GraphEdges(&argv[1], argc >= 3 ? Gua_ObjectToInteger(argv[2]) : 0, argc == 4 ? Gua_ObjectToInteger(argv[3]) != 0 : false, object, error) != GUA_OK) {
+            return GUA_ERROR;
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "cnaGraphShortestPath") == 0) {
+        if ((argc < 2) || (argc > 3)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if ((Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) && (Gua_ObjectType(argv[1]) != OBJECT_TYPE_HANDLE)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (argc >= 3) {
+            if (Gua_ObjectType(argv[2]) != OBJECT_TYPE_INTEGER) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+        }
+        
+        if (Cna_GraphShortestPath(&argv[1], object, argc == 3 ? (Gua_Short)Gua_ObjectToInteger(argv[2]) : Cna_DefaultThreads(), error) != GUA_OK) {
+            return GUA_ERROR;
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "cnaLoadSparse") == 0) {
+        if (argc != 2) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_STRING) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Cna_LoadSparse(Gua_ObjectToString(argv[1]), object, error) != GUA_OK) {
+            return GUA_ERROR;
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "cnaShortestPath") == 0) {
+        if (argc != 2) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Cna_ShortestPath(&argv[1], object, error) != GUA_OK) {
+            return GUA_ERROR;
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "cnaSpectralCentrality") == 0) {
+        if (argc != 2) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if ((Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) && (Gua_ObjectType(argv[1]) != OBJECT_TYPE_HANDLE)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Cna_SpectralCentrality(&argv[1], object, error) != GUA_OK) {
+            return GUA_ERROR;
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "cnaSparseDegrees") == 0) {
+        if ((argc != 2) && (argc != 3)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_HANDLE) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (argc == 3) {
+            if (Gua_ObjectType(argv[2]) != OBJECT_TYPE_INTEGER) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+        }
+        
+        if (Cna_SparseDegrees(&argv[1], argc == 3 ? Gua_ObjectToInteger(argv[2]) != 0 : false, object, error) != GUA_OK) {
+            return GUA_ERROR;
+        }
+    }
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Cna_Init(void *nspace, int argc, char *argv[], char **env, Gua_String error)
+ *
+ * Description:
+ *     Install library functions.
+ *
+ * Arguments:
+ *     nspace,    a pointer to a structure containing the variable and function namespace;
+ *     argc,      the number of command line arguments;
+ *     argv,      the command line arguments;
  *     env,       a pointer to the environment variables;
  *     error,     a pointer to the error message.
  *
@@ -546,12 +2631,75 @@ Gua_Status Cna_Init(void *nspace, int argc, char *argv[], char **env, Gua_String
         Gua_Free(errMessage);
     }
     Gua_LinkCFunctionToFunction(function, Cna_FunctionWrapper);
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "cnaGraph", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "cnaGraph");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    Gua_LinkCFunctionToFunction(function, Cna_FunctionWrapper);
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "cnaGraphCentrality", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "cnaGraphCentrality");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    Gua_LinkCFunctionToFunction(function, Cna_FunctionWrapper);
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "cnaGraphClustering", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "cnaGraphClustering");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    Gua_LinkCFunctionToFunction(function, Cna_FunctionWrapper);
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "cnaGraphDegreeDistribution", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "cnaGraphDegreeDistribution");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    Gua_LinkCFunctionToFunction(function, Cna_FunctionWrapper);
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "cnaGraphEdges", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "cnaGraphEdges");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    Gua_LinkCFunctionToFunction(function, Cna_FunctionWrapper);
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "cnaGraphShortestPath", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "cnaGraphShortestPath");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    Gua_LinkCFunctionToFunction(function, Cna_FunctionWrapper);
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "cnaLoadSparse", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "cnaLoadSparse");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    Gua_LinkCFunctionToFunction(function, Cna_FunctionWrapper);
     if (Gua_SetFunction((Gua_Namespace *)nspace, "cnaShortestPath", &function) != GUA_OK) {
         errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
         sprintf(errMessage, "%s %-.20s...\n", "can't set function", "cnaShortestPath");
         strcat(error, errMessage);
         Gua_Free(errMessage);
     }
+    Gua_LinkCFunctionToFunction(function, Cna_FunctionWrapper);
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "cnaSparseDegrees", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "cnaSparseDegrees");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    Gua_LinkCFunctionToFunction(function, Cna_FunctionWrapper);
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "cnaSpectralCentrality", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "cnaSpectralCentrality");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
     
     /**
      * Group:
@@ -28,7 +28,63 @@
 
 #define CNA_VERSION "2.0"
 
+#define CNA_SECTION_NONE      0
+#define CNA_SECTION_VERTICES  1
+#define CNA_SECTION_EDGES     2
+#define CNA_SECTION_ARCS      3
+#define CNA_SECTION_MATRIX    4
+#define CNA_SECTION_EDGESLIST 5
+#define CNA_SECTION_ARCSLIST  6
+
+#define CNA_FLOYD_WARSHALL_BLOCK 64
+#define CNA_MAX_THREADS          64
+
+/* A share of the tiles of one phase of a blocked Floyd-Warshall round. */
+typedef struct {
+    Gua_Real *d;
+    Gua_Length *p;
+    Gua_Length n;
+    Gua_Length kb;
+    Gua_Short phase;
+    Gua_Short id;
+    Gua_Short threads;
+} Cna_FloydWarshallTask;
+
+/* A share of the vertices of a graph for one thread. */
+typedef struct {
+    Matrix_Sparse *g;
+    Gua_Length first;
+    Gua_Real *geodesic;
+    Gua_Real *distance;
+    Gua_Real *betweenness;
+    Gua_Real *clustering;
+    Gua_Short id;
+    Gua_Short threads;
+} Cna_GraphTask;
+
+void Cna_FloydWarshallTile(Gua_Real *d, Gua_Length *p, Gua_Length n, Gua_Length ib, Gua_Length jb, Gua_Length kb);
+void *Cna_FloydWarshallPhase(void *data);
+void Cna_FloydWarshall(Gua_Real *d, Gua_Length *p, Gua_Length n, Gua_Short threads);
+Gua_Status Cna_FloydWarshallShortestPath(Gua_Object *adj, Gua_Object *geodesic, Gua_Object *path, Gua_Short threads, Gua_String error);
 Gua_Status Cna_ShortestPath(Gua_Object *adj, Gua_Object *geodesic, Gua_String error);
+Gua_Short Cna_ReadLine(FILE *fp, Gua_Char **line, Gua_Length *size);
+Gua_Short Cna_IsSection(Gua_Char *p, Gua_String keyword);
+void Cna_GrowTriplets(Gua_Length **ti, Gua_Length **tj, Gua_Real **tv, Gua_Length *size, Gua_Length needed);
+Gua_Status Cna_LoadSparse(Gua_String fileName, Gua_Object *adj, Gua_String error);
+Gua_Status Cna_SparseDegrees(Gua_Object *adj, Gua_Short directed, Gua_Object *degrees, Gua_String error);
+Gua_Status Cna_SpectralCentrality(Gua_Object *adj, Gua_Object *centrality, Gua_String error);
+Gua_Short Cna_DefaultThreads(void);
+Matrix_Sparse *Cna_GetGraph(Gua_Object *adj, Gua_Length *first, Gua_String error);
+void *Cna_BreadthFirstSearch(void *data);
+void *Cna_LocalClustering(void *data);
+void Cna_RunGraphTasks(void *(*worker)(void *), Cna_GraphTask *task, Gua_Short threads);
+void Cna_SearchGraph(Matrix_Sparse *g, Gua_Length first, Gua_Real *geodesic, Gua_Real *distance, Gua_Real *betweenness, Gua_Short threads);
+Gua_Status Cna_Graph(Gua_Object *adj, Gua_Object *graph, Gua_String error);
+Gua_Status Cna_GraphEdges(Gua_Object *edges, Gua_Length n, Gua_Short directed, Gua_Object *graph, Gua_String error);
+Gua_Status Cna_GraphShortestPath(Gua_Object *adj, Gua_Object *geodesic, Gua_Short threads, Gua_String error);
+Gua_Status Cna_GraphCentrality(Gua_Object *adj, Gua_Short directed, Gua_Object *centrality, Gua_Short threads, Gua_String error);
+Gua_Status Cna_GraphClustering(Gua_Object *adj, Gua_Short directed, Gua_Object *clustering, Gua_Short threads, Gua_String error);
+Gua_Status Cna_GraphDegreeDistribution(Gua_Object *adj, Gua_Short directed, Gua_Object *distribution, Gua_String error);
 Gua_Status Cna_FunctionWrapper(void *nspace, Gua_Short argc, Gua_Object *argv, Gua_Object *object, Gua_String error);
 Gua_Status Cna_Init(void *nspace, int argc, char *argv[], char **env, Gua_String error);
 
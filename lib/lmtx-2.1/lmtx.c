@@ -36,6 +36,553 @@
 #include "interp.h"
 #include "lmtx.h"
 
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Real *Lmtx_GetRealBuffer(Gua_Object *object)
+ *
+ * Description:
+ *     Copy the cells of a numeric matrix to a buffer of reals.
+ *
+ * Arguments:
+ *     object,    the matrix.
+ *
+ * Results:
+ *     The function returns a new buffer with the matrix length, or NULL
+ *     if some cell is not an integer or a real.
+ */
+Gua_Real *Lmtx_GetRealBuffer(Gua_Object *object)
+{
+    Gua_Matrix *matrix;
+    Gua_Object *cell;
+    Gua_Real *buffer;
+    Gua_Length i;
+    
+    matrix = (Gua_Matrix *)Gua_PObjectToMatrix(object);
+    cell = (Gua_Object *)matrix->object;
+    
+    buffer = (Gua_Real *)Gua_Alloc(sizeof(Gua_Real) * (Gua_PObjectLength(object) + 1));
+    
+    for (i = 0; i < Gua_PObjectLength(object); i++) {
+        if (Gua_ObjectType(cell[i]) == OBJECT_TYPE_INTEGER) {
+            buffer[i] = (Gua_Real)Gua_ObjectToInteger(cell[i]);
+        } else if (Gua_ObjectType(cell[i]) == OBJECT_TYPE_REAL) {
+            buffer[i] = Gua_ObjectToReal(cell[i]);
+        } else {
+            Gua_Free(buffer);
+            
+            return NULL;
+        }
+    }
+    
+    return buffer;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Real *Lmtx_GetWeights(Gua_Object *nn, Gua_Integer *dim)
+ *
+ * Description:
+ *     Copy the weights of a learning matrix to a buffer of reals.
+ *
+ * Arguments:
+ *     nn,     the learning matrix;
+ *     dim,    returns the learning matrix dimension.
+ *
+ * Results:
+ *     The function returns a new dim x dim buffer, with the first and
+ *     last rows and columns set to zero, or NULL if the learning matrix
+ *     is not square or has non numeric weights.
+ */
+Gua_Real *Lmtx_GetWeights(Gua_Object *nn, Gua_Integer *dim)
+{
+    Gua_Matrix *mnn;
+    Gua_Object *onn;
+    Gua_Real *w;
+    Gua_Integer n;
+    Gua_Integer i;
+    Gua_Integer j;
+    
+    if (Gua_PObjectType(nn) != OBJECT_TYPE_MATRIX) {
+        return NULL;
+    }
+    
+    mnn = (Gua_Matrix *)Gua_PObjectToMatrix(nn);
+    
+    if (mnn->dimc != 2) {
+        return NULL;
+    }
+    if ((mnn->dimv[0] != mnn->dimv[1]) || (mnn->dimv[0] < 3)) {
+        return NULL;
+    }
+    
+    n = mnn->dimv[0];
+    
+    onn = (Gua_Object *)mnn->object;
+    
+    /* Linear matrix cell access: k = i * dim + j */
+    w = (Gua_Real *)Gua_Alloc(sizeof(Gua_Real) * n * n);
+    memset(w, 0, sizeof(Gua_Real) * n * n);
+    
+    for (i = 1; i < (n - 1); i++) {
+        for (j = 1; j < (n - 1); j++) {
+            if (Gua_ObjectType(onn[i * n + j]) == OBJECT_TYPE_INTEGER) {
+                w[i * n + j] = (Gua_Real)Gua_ObjectToInteger(onn[i * n + j]);
+            } else if (Gua_ObjectType(onn[i * n + j]) == OBJECT_TYPE_REAL) {
+                w[i * n + j] = Gua_ObjectToReal(onn[i * n + j]);
+            } else {
+                Gua_Free(w);
+                
+                return NULL;
+            }
+        }
+    }
+    
+    *dim = n;
+    
+    return w;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Lmtx_Network *Lmtx_NewNetwork(Gua_Object *nn, Gua_Integer ni, Gua_Integer no, Gua_Integer batch)
+ *
+ * Description:
+ *     Unpack a learning matrix into a network able to process batch
+ *     samples at once.
+ *
+ * Arguments:
+ *     nn,       the learning matrix;
+ *     ni,       number of input neurons;
+ *     no,       number of output neurons;
+ *     batch,    number of samples processed at once.
+ *
+ * Results:
+ *     The function returns the new network, or NULL if the learning
+ *     matrix is not square or has non numeric weights.
+ */
+Lmtx_Network *Lmtx_NewNetwork(Gua_Object *nn, Gua_Integer ni, Gua_Integer no, Gua_Integer batch)
+{
+    Lmtx_Network *net;
+    Gua_Real *w;
+    Gua_Integer dim;
+    Gua_Integer last;
+    Gua_Integer i;
+    Gua_Integer j;
+    Gua_Integer k;
+    
+    w = Lmtx_GetWeights(nn, &dim);
+    
+    if (w == NULL) {
+        return NULL;
+    }
+    
+    if ((ni < 1) || (no < 1) || (batch < 1) || ((ni + no + 2) > dim)) {
+        Gua_Free(w);
+        
+        return NULL;
+    }
+    
+    net = (Lmtx_Network *)Gua_Alloc(sizeof(Lmtx_Network));
+    
+    net->dim = dim;
+    net->ni = ni;
+    net->no = no;
+    net->batch = batch;
+    net->w = w;
+    
+    /* Only the connections already present in the learning matrix are
+       used. Output neurons do not feed other neurons. */
+    last = dim - 2 - no;
+    
+    net->first = (Gua_Integer *)Gua_Alloc(sizeof(Gua_Integer) * (dim + 1));
+    
+    k = 0;
+    
+    for (j = 0; j < dim; j++) {
+        if ((j > ni) && (j < (dim - 1))) {
+            for (i = 1; (i < j) && (i <= last); i++) {
+                if (net->w[i * dim + j] != 0.0) {
+                    k++;
+                }
+            }
+        }
+    }
+    
+    net->source = (Gua_Integer *)Gua_Alloc(sizeof(Gua_Integer) * (k + 1));
+    
+    k = 0;
+    
+    for (j = 0; j < dim; j++) {
+        net->first[j] = k;
+        
+        if ((j > ni) && (j < (dim - 1))) {
+            for (i = 1; (i < j) && (i <= last); i++) {
+                if (net->w[i * dim + j] != 0.0) {
+                    net->source[k] = i;
+                    k++;
+                }
+            }
+        }
+    }
+    
+    net->first[dim] = k;
+    
+    net->x = (Gua_Real *)Gua_Alloc(sizeof(Gua_Real) * dim * batch);
+    net->y = (Gua_Real *)Gua_Alloc(sizeof(Gua_Real) * dim * batch);
+    net->df = (Gua_Real *)Gua_Alloc(sizeof(Gua_Real) * dim * batch);
+    net->d = (Gua_Real *)Gua_Alloc(sizeof(Gua_Real) * dim * batch);
+    net->e = (Gua_Real *)Gua_Alloc(sizeof(Gua_Real) * batch);
+    
+    memset(net->x, 0, sizeof(Gua_Real) * dim * batch);
+    memset(net->y, 0, sizeof(Gua_Real) * dim * batch);
+    memset(net->df, 0, sizeof(Gua_Real) * dim * batch);
+    memset(net->d, 0, sizeof(Gua_Real) * dim * batch);
+    
+    return net;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Lmtx_FreeNetwork(Lmtx_Network *net)
+ *
+ * Description:
+ *     Free a network created by Lmtx_NewNetwork.
+ *
+ * Arguments:
+ *     net,    the network.
+ *
+ * Results:
+ *     The function frees the network buffers.
+ */
+void Lmtx_FreeNetwork(Lmtx_Network *net)
+{
+    Gua_Free(net->w);
+    Gua_Free(net->first);
+    Gua_Free(net->source);
+    Gua_Free(net->x);
+    Gua_Free(net->y);
+    Gua_Free(net->df);
+    Gua_Free(net->d);
+    Gua_Free(net->e);
+    Gua_Free(net);
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Lmtx_SetNetwork(Lmtx_Network *net, Gua_Object *nn, Gua_Integer sample)
+ *
+ * Description:
+ *     Pack a network back into its learning matrix.
+ *
+ * Arguments:
+ *     net,       the network;
+ *     nn,        the learning matrix;
+ *     sample,    the sample whose sums, outputs, derivatives and
+ *                deltas are stored in the first and last rows and
+ *                columns of the learning matrix.
+ *
+ * Results:
+ *     The function stores the weights and the neurons state in the
+ *     learning matrix.
+ */
+void Lmtx_SetNetwork(Lmtx_Network *net, Gua_Object *nn, Gua_Integer sample)
+{
+    Gua_Matrix *mnn;
+    Gua_Object *onn;
+    Gua_Integer dim;
+    Gua_Integer batch;
+    Gua_Integer i;
+    Gua_Integer j;
+    
+    mnn = (Gua_Matrix *)Gua_PObjectToMatrix(nn);
+    onn = (Gua_Object *)mnn->object;
+    
+    dim = net->dim;
+    batch = net->batch;
+    
+    for (i = 1; i < (dim - 1); i++) {
+        for (j = 1; j < (dim - 1); j++) {
+            Gua_RealToObject(onn[i * dim + j], net->w[i * dim + j]);
+        }
+    }
+    
+    for (i = 0; i < dim - 1; i++) {
+        if (Gua_ObjectType(onn[0 * dim + i]) == OBJECT_TYPE_STRING) {
+            Gua_FreeObject(&(onn[0 * dim + i]));
+        }
+        Gua_RealToObject(onn[0 * dim + i], net->x[i * batch + sample]);
+        
+        if (Gua_ObjectType(onn[i * dim + 0]) == OBJECT_TYPE_STRING) {
+            Gua_FreeObject(&(onn[i * dim + 0]));
+        }
+        Gua_RealToObject(onn[i * dim + 0], net->y[i * batch + sample]);
+        
+        if (Gua_ObjectType(onn[i * dim + (dim - 1)]) == OBJECT_TYPE_STRING) {
+            Gua_FreeObject(&(onn[i * dim + (dim - 1)]));
+        }
+        Gua_RealToObject(onn[i * dim + (dim - 1)], net->df[i * batch + sample]);
+        
+        if (Gua_ObjectType(onn[(dim - 1) * dim + i]) == OBJECT_TYPE_STRING) {
+            Gua_FreeObject(&(onn[(dim - 1) * dim + i]));
+        }
+        Gua_RealToObject(onn[(dim - 1) * dim + i], net->d[i * batch + sample]);
+    }
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Lmtx_Activate(Gua_Integer f, Gua_Real *x, Gua_Real *y, Gua_Real *df, Gua_Integer n)
+ *
+ * Description:
+ *     Apply an activation function to a row of weighted sums.
+ *
+ * Arguments:
+ *     f,     activation function;
+ *     x,     weighted sums;
+ *     y,     neuron outputs;
+ *     df,    derivatives of the activation function;
+ *     n,     number of samples.
+ *
+ * Results:
+ *     The function sets y = f(x) and df(x)/dx.
+ */
+void Lmtx_Activate(Gua_Integer f, Gua_Real *x, Gua_Real *y, Gua_Real *df, Gua_Integer n)
+{
+    Gua_Integer b;
+    
+    /* Linear: f(x) = x
+               df(x)/dx = 1 */
+    if (f == LMTX_LINEAR_ACTIVATION_FUNCTION) {
+        for (b = 0; b < n; b++) {
+            y[b] = x[b];
+            df[b] = 1.0;
+        }
+    /* Hyperbolic tangent: f(x) = 2 / (1 + e^(-2x)) - 1
+                           df(x)/dx = 1 - f(x)^2 */
+    } else if (f == LMTX_TANH_ACTIVATION_FUNCTION) {
+        for (b = 0; b < n; b++) {
+            y[b] = 2.0 / (1.0 + exp(-2.0 * x[b])) - 1.0;
+            df[b] = 1.0 - y[b] * y[b];
+        }
+    /* Logistic: f(x) = 1.0 / (1.0 + e^(-x))
+                 df(x)/dx = f(x) * (1 - f(x)) */
+    } else {
+        for (b = 0; b < n; b++) {
+            y[b] = 1.0 / (1.0 + exp(-(x[b])));
+            df[b] = y[b] * (1.0 - y[b]);
+        }
+    }
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Lmtx_Forward(Lmtx_Network *net, Gua_Real *in, Gua_Integer count, Gua_Integer af, Gua_Integer oaf)
+ *
+ * Description:
+ *     Process a batch of samples. The weighted sums of each neuron are
+ *     accumulated for the whole batch before moving to the next neuron.
+ *
+ * Arguments:
+ *     net,      the network;
+ *     in,       count rows of ni inputs;
+ *     count,    number of samples, up to the network batch size;
+ *     af,       activation function;
+ *     oaf,      output layer activation function.
+ *
+ * Results:
+ *     The function sets the sums, outputs and derivatives of each neuron.
+ */
+void Lmtx_Forward(Lmtx_Network *net, Gua_Real *in, Gua_Integer count, Gua_Integer af, Gua_Integer oaf)
+{
+    Gua_Integer dim;
+    Gua_Integer batch;
+    Gua_Integer first_out;
+    Gua_Integer i;
+    Gua_Integer j;
+    Gua_Integer k;
+    Gua_Integer b;
+    Gua_Real w;
+    Gua_Real *x;
+    Gua_Real *y;
+    
+    dim = net->dim;
+    batch = net->batch;
+    
+    first_out = dim - 1 - net->no;
+    
+    /* Clear inputs and outputs. */
+    memset(net->x, 0, sizeof(Gua_Real) * dim * batch);
+    memset(net->y, 0, sizeof(Gua_Real) * dim * batch);
+    memset(net->df, 0, sizeof(Gua_Real) * dim * batch);
+    memset(net->d, 0, sizeof(Gua_Real) * dim * batch);
+    
+    /* Assign inputs. */
+    for (b = 0; b < count; b++) {
+        for (j = 0; j < net->ni; j++) {
+            net->y[(j + 1) * batch + b] = in[b * net->ni + j];
+        }
+    }
+    
+    /* Calculate the neurons output. */
+    for (j = net->ni + 1; j < (dim - 1); j++) {
+        x = &(net->x[j * batch]);
+        
+        /* Weighted sums.
+           x = x1 * w1 + x2 * w2 + ... */
+        for (k = net->first[j]; k < net->first[j + 1]; k++) {
+            i = net->source[k];
+            w = net->w[i * dim + j];
+            y = &(net->y[i * batch]);
+            
+            for (b = 0; b < count; b++) {
+                x[b] += w * y[b];
+            }
+        }
+        
+        /* Bias. */
+        if (j < first_out) {
+            w = net->w[j * dim + j];
+            
+            if (w != 0.0) {
+                for (b = 0; b < count; b++) {
+                    x[b] += w;
+                }
+            }
+        }
+        
+        /* Activation function. */
+        if (j < first_out) {
+            Lmtx_Activate(af, x, &(net->y[j * batch]), &(net->df[j * batch]), count);
+        } else {
+            Lmtx_Activate(oaf, x, &(net->y[j * batch]), &(net->df[j * batch]), count);
+        }
+    }
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Lmtx_Backward(Lmtx_Network *net, Gua_Real *out, Gua_Integer count, Gua_Real lrate)
+ *
+ * Description:
+ *     Backpropagate the errors of the batch processed by Lmtx_Forward
+ *     and adjust the weights by the mean of the sample corrections.
+ *
+ * Arguments:
+ *     net,      the network;
+ *     out,      count rows of no expected outputs;
+ *     count,    number of samples;
+ *     lrate,    learning rate.
+ *
+ * Results:
+ *     The function sets the neuron deltas and updates the weights.
+ */
+void Lmtx_Backward(Lmtx_Network *net, Gua_Real *out, Gua_Integer count, Gua_Real lrate)
+{
+    Gua_Integer dim;
+    Gua_Integer batch;
+    Gua_Integer first_out;
+    Gua_Integer i;
+    Gua_Integer j;
+    Gua_Integer k;
+    Gua_Integer b;
+    Gua_Real w;
+    Gua_Real sum;
+    Gua_Real *d;
+    Gua_Real *y;
+    
+    dim = net->dim;
+    batch = net->batch;
+    
+    first_out = dim - 1 - net->no;
+    
+    /* Calculate delta for the output neurons.
+       d = z - y */
+    for (i = 0; i < net->no; i++) {
+        for (b = 0; b < count; b++) {
+            net->d[(first_out + i) * batch + b] = out[b * net->no + i] - net->y[(first_out + i) * batch + b];
+        }
+    }
+    
+    /* Calculate delta for hidden neurons.
+       d1 = w1 * d2 + w2 * d2 + ... */
+    for (j = dim - 2; j > net->ni; j--) {
+        d = &(net->d[j * batch]);
+        
+        for (k = net->first[j]; k < net->first[j + 1]; k++) {
+            i = net->source[k];
+            
+            if (i <= net->ni) {
+                continue;
+            }
+            
+            w = net->w[i * dim + j];
+            
+            for (b = 0; b < count; b++) {
+                net->d[i * batch + b] += w * d[b];
+            }
+        }
+    }
+    
+    /* Adjust weights.
+       x = x1 * w1 + x2 * w2 + ...
+       w1 = w1 + n * d * df(x)/dx * x1
+       w2 = w2 + n * d * df(x)/dx * x2
+       The first neuron adjusted is the same as in the one sample rule. */
+    for (j = (net->no > net->ni ? net->no : net->ni) + 1; j < (dim - 1); j++) {
+        for (b = 0; b < count; b++) {
+            net->e[b] = net->d[j * batch + b] * net->df[j * batch + b];
+        }
+        
+        for (k = net->first[j]; k < net->first[j + 1]; k++) {
+            i = net->source[k];
+            
+            if (net->w[i * dim + j] != 0.0) {
+                y = &(net->y[i * batch]);
+                
+                sum = 0.0;
+                for (b = 0; b < count; b++) {
+                    sum += net->e[b] * y[b];
+                }
+                
+                net->w[i * dim + j] += lrate * sum / count;
+            }
+        }
+        
+        if ((j < first_out) && (net->w[j * dim + j] != 0.0)) {
+            sum = 0.0;
+            for (b = 0; b < count; b++) {
+                sum += net->e[b];
+            }
+            
+            net->w[j * dim + j] += lrate * sum / count;
+        }
+    }
+}
+
 /**
  * Group:
  *     C
@@ -61,211 +608,539 @@
  */
 Gua_Status Lmtx_Learn(Gua_Object *nn, Gua_Object *in, Gua_Object *out, Gua_Integer ni, Gua_Integer no, Gua_Real lrate, Gua_Integer af, Gua_Integer oaf)
 {
-    Gua_Matrix *mnn;
-    Gua_Matrix *min;
+    Lmtx_Network *net;
+    Gua_Real *xin;
+    Gua_Real *xout;
+    
+    if (!((Gua_PObjectType(nn) == OBJECT_TYPE_MATRIX) && (Gua_PObjectType(in) == OBJECT_TYPE_MATRIX) && (Gua_PObjectType(out) == OBJECT_TYPE_MATRIX))) {
+        return GUA_ERROR;
+    }
+    if ((Gua_PObjectLength(in) < ni) || (Gua_PObjectLength(out) < no)) {
+        return GUA_ERROR;
+    }
+    
+    net = Lmtx_NewNetwork(nn, ni, no, 1);
+    
+    if (net == NULL) {
+        return GUA_ERROR;
+    }
+    
+    xin = Lmtx_GetRealBuffer(in);
+    xout = Lmtx_GetRealBuffer(out);
+    
+    if ((xin == NULL) || (xout == NULL)) {
+        if (xin != NULL) {
+            Gua_Free(xin);
+        }
+        if (xout != NULL) {
+            Gua_Free(xout);
+        }
+        
+        Lmtx_FreeNetwork(net);
+        
+        return GUA_ERROR;
+    }
+    
+    Lmtx_Forward(net, xin, 1, af, oaf);
+    Lmtx_Backward(net, xout, 1, lrate);
+    
+    Lmtx_SetNetwork(net, nn, 0);
+    
+    Gua_Free(xin);
+    Gua_Free(xout);
+    
+    Lmtx_FreeNetwork(net);
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Lmtx_Pulse(Gua_Object *nn, Gua_Real *in, Gua_Integer rows, Gua_Integer ni, Gua_Integer no, Gua_Integer af, Gua_Integer oaf, Gua_Integer of, Gua_Real *c, Gua_Object *out)
+ *
+ * Description:
+ *     Process rows pulses in an artificial neural network, up to
+ *     LMTX_BATCH_SIZE pulses at once.
+ *
+ * Arguments:
+ *     nn,      the learning matrix;
+ *     in,      rows rows of ni inputs;
+ *     rows,    number of pulses;
+ *     ni,      number of input neurons;
+ *     no,      number of output neurons;
+ *     af,      activation function;
+ *     oaf,     output layer activation function;
+ *     of,      output function;
+ *     c,       output function constants;
+ *     out,     the output matrix.
+ *
+ * Results:
+ *     The function returns the ANN output, one row for each pulse.
+ */
+Gua_Status Lmtx_Pulse(Gua_Object *nn, Gua_Real *in, Gua_Integer rows, Gua_Integer ni, Gua_Integer no, Gua_Integer af, Gua_Integer oaf, Gua_Integer of, Gua_Real *c, Gua_Object *out)
+{
+    Lmtx_Network *net;
     Gua_Matrix *mout;
-    Gua_Object *onn;
-    Gua_Object *oin;
     Gua_Object *oout;
-    Gua_Integer i;
-    Gua_Integer j;
-    Gua_Integer dim_i;
-    Gua_Integer dim_j;
+    Gua_Real y;
+    Gua_Real threshold;
+    Gua_Integer batch;
+    Gua_Integer count;
     Gua_Integer first_out;
+    Gua_Integer s;
+    Gua_Integer i;
+    Gua_Integer b;
     
-    if (!((Gua_PObjectType(nn) == OBJECT_TYPE_MATRIX) && (Gua_PObjectType(in) == OBJECT_TYPE_MATRIX) && (Gua_PObjectType(out) == OBJECT_TYPE_MATRIX))) {
+    if (rows < 1) {
         return GUA_ERROR;
     }
     
-    mnn = (Gua_Matrix *)Gua_PObjectToMatrix(nn);
-    min = (Gua_Matrix *)Gua_PObjectToMatrix(in);
+    batch = rows;
+    
+    if (batch > LMTX_BATCH_SIZE) {
+        batch = LMTX_BATCH_SIZE;
+    }
+    
+    net = Lmtx_NewNetwork(nn, ni, no, batch);
+    
+    if (net == NULL) {
+        return GUA_ERROR;
+    }
+    
+    if (!Gua_IsPObjectStored(out)) {
+        Gua_FreeObject(out);
+    } else {
+        Gua_ClearPObject(out);
+    }
+    
+    /* Set the output matrix. */
+    Gua_MatrixToPObject(out, (struct Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix)), rows * no);
+    
     mout = (Gua_Matrix *)Gua_PObjectToMatrix(out);
     
-    if (mnn && min && mout) {
-        dim_i = mnn->dimv[0];
-        dim_j = mnn->dimv[1];
+    mout->dimc = 2;
+    mout->dimv = Gua_Alloc(mout->dimc * sizeof(Gua_Integer));
+    mout->dimv[0] = rows;
+    mout->dimv[1] = no;
+    
+    mout->object = (struct Gua_Object *)Gua_Alloc(rows * no * sizeof(Gua_Object));
+    
+    oout = (Gua_Object *)mout->object;
+    
+    first_out = net->dim - 1 - no;
+    
+    /* The step output function fires at the middle of the output
+       layer activation function range. */
+    if (oaf == LMTX_LOGISTIC_ACTIVATION_FUNCTION) {
+        threshold = 0.5;
+    } else {
+        threshold = 0.0;
+    }
+    
+    for (s = 0; s < rows; s = s + batch) {
+        count = rows - s;
         
-        onn = (Gua_Object *)mnn->object;
-        oin = (Gua_Object *)min->object;
-        oout = (Gua_Object *)mout->object;
+        if (count > batch) {
+            count = batch;
+        }
         
-        /* Linear matrix cell access: k = i * dim_j + j */
-        first_out = dim_j - 1 - no;
+        Lmtx_Forward(net, &(in[s * ni]), count, af, oaf);
         
-        /* Convert integer values to real. */
-        for (i = 0; i < Gua_PObjectLength(nn); i++) {
-            if (Gua_ObjectType(onn[i]) == OBJECT_TYPE_INTEGER) {
-                Gua_ConvertIntegerObjectToReal(onn[i]);
+        for (b = 0; b < count; b++) {
+            for (i = 0; i < no; i++) {
+                y = net->y[(first_out + i) * batch + b];
+                
+                if (of == LMTX_LINEAR_OUTPUT_FUNCTION) {
+                    Gua_RealToObject(oout[(s + b) * no + i], c[0] * y + c[1]);
+                } else if (of == LMTX_STEP_OUTPUT_FUNCTION) {
+                    if (y >= threshold) {
+                        Gua_RealToObject(oout[(s + b) * no + i], 1.0);
+                    } else {
+                        Gua_RealToObject(oout[(s + b) * no + i], 0.0);
+                    }
+                } else {
+                    Gua_RealToObject(oout[(s + b) * no + i], y);
+                }
             }
         }
-        for (i = 0; i < Gua_PObjectLength(in); i++) {
-            if (Gua_ObjectType(oin[i]) == OBJECT_TYPE_INTEGER) {
-                Gua_ConvertIntegerObjectToReal(oin[i]);
-            }
+    }
+    
+    Lmtx_FreeNetwork(net);
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Lmtx_Process(Gua_Object *nn, Gua_Object *in, Gua_Object *out, Gua_Integer ni, Gua_Integer no, Gua_Integer af, Gua_Integer oaf, Gua_Integer of, Gua_Object *ofc)
+ *
+ * Description:
+ *     Process a pulse in an artificial neural network. If the input
+ *     matrix has more than one row of ni columns, each row is a pulse.
+ *
+ * Arguments:
+ *     nn,     the learning matrix;
+ *     in,     input training set;
+ *     out,    input training set;
+ *     ni,     number of input neurons;
+ *     no,     number of input neurons;
+ *     af,     activation function;
+ *     oaf,    output layer activation function;
+ *     of,     output function;
+ *     ofc,    output function constants.
+ *
+ * Results:
+ *     The function returns the ANN output after the pulse, one row
+ *     for each pulse.
+ */
+Gua_Status Lmtx_Process(Gua_Object *nn, Gua_Object *in, Gua_Object *out, Gua_Integer ni, Gua_Integer no, Gua_Integer af, Gua_Integer oaf, Gua_Integer of, Gua_Object *ofc)
+{
+    Gua_Matrix *min;
+    Gua_Real *xin;
+    Gua_Real *c;
+    Gua_Integer count;
+    Gua_Status status;
+    
+    if (!((Gua_PObjectType(nn) == OBJECT_TYPE_MATRIX) && (Gua_PObjectType(in) == OBJECT_TYPE_MATRIX))) {
+        return GUA_ERROR;
+    }
+    
+    min = (Gua_Matrix *)Gua_PObjectToMatrix(in);
+    
+    if ((min->dimc == 2) && (min->dimv[0] > 1) && (min->dimv[1] == ni)) {
+        count = min->dimv[0];
+    } else {
+        count = 1;
+    }
+    
+    if (Gua_PObjectLength(in) < (count * ni)) {
+        return GUA_ERROR;
+    }
+    
+    c = NULL;
+    
+    if (of == LMTX_LINEAR_OUTPUT_FUNCTION) {
+        if (ofc == NULL) {
+            return GUA_ERROR;
         }
-        for (i = 0; i < Gua_PObjectLength(out); i++) {
-            if (Gua_ObjectType(oout[i]) == OBJECT_TYPE_INTEGER) {
-                Gua_ConvertIntegerObjectToReal(oout[i]);
-            }
+        if (Gua_PObjectType(ofc) != OBJECT_TYPE_MATRIX) {
+            return GUA_ERROR;
+        }
+        if (Gua_PObjectLength(ofc) < 2) {
+            return GUA_ERROR;
         }
         
-        /* Clear inputs and outputs. */
-        for (i = 0; i < dim_i - 1; i++) {
-            if (Gua_ObjectType(onn[0 * dim_j + i]) == OBJECT_TYPE_STRING) {
-                Gua_FreeObject(&(onn[0 * dim_j + i]));
-            }
-            Gua_RealToObject(onn[0 * dim_j + i], 0.0);
-            
-            if (Gua_ObjectType(onn[i * dim_j + 0]) == OBJECT_TYPE_STRING) {
-                Gua_FreeObject(&(onn[i * dim_j + 0]));
-            }
-            Gua_RealToObject(onn[i * dim_j + 0], 0.0);
-            
-            if (Gua_ObjectType(onn[i * dim_j + (dim_j - 1)]) == OBJECT_TYPE_STRING) {
-                Gua_FreeObject(&(onn[i * dim_j + (dim_j - 1)]));
-            }
-            Gua_RealToObject(onn[i * dim_j + (dim_j - 1)], 0.0);
-            
-            if (Gua_ObjectType(onn[(dim_i - 1) * dim_j + i]) == OBJECT_TYPE_STRING) {
-                Gua_FreeObject(&(onn[(dim_i - 1) * dim_j + i]));
-            }
-            Gua_RealToObject(onn[(dim_i - 1) * dim_j + i], 0.0);
+        c = Lmtx_GetRealBuffer(ofc);
+        
+        if (c == NULL) {
+            return GUA_ERROR;
         }
+    }
+    
+    xin = Lmtx_GetRealBuffer(in);
+    
+    if (xin == NULL) {
+        status = GUA_ERROR;
+    } else {
+        status = Lmtx_Pulse(nn, xin, count, ni, no, af, oaf, of, c, out);
         
-        /* Assign inputs. */
-        for (j = 0; j < ni; j++) {
-            Gua_RealToObject(onn[(j + 1) * dim_j + 0], Gua_ObjectToReal(oin[j]));
+        Gua_Free(xin);
+    }
+    
+    if (c != NULL) {
+        Gua_Free(c);
+    }
+    
+    return status;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Lmtx_Train(Gua_Object *nn, Gua_Object *in, Gua_Object *out, Gua_Integer epochs, Gua_Integer batch, Gua_Real lrate, Gua_Integer af, Gua_Integer oaf)
+ *
+ * Description:
+ *     Teach an artificial neural network for a number of epochs, using
+ *     mini-batches of the training set. With batch = 1 each epoch is the
+ *     same as calling Lmtx_Learn for each row of the training set.
+ *
+ * Arguments:
+ *     nn,        the learning matrix;
+ *     in,        input training set, one sample by row;
+ *     out,       output training set, one sample by row;
+ *     epochs,    number of epochs;
+ *     batch,     number of samples in each mini-batch;
+ *     lrate,     learning rate;
+ *     af,        activation function;
+ *     oaf,       output layer activation function.
+ *
+ * Results:
+ *     The function returns the trained ANN.
+ */
+Gua_Status Lmtx_Train(Gua_Object *nn, Gua_Object *in, Gua_Object *out, Gua_Integer epochs, Gua_Integer batch, Gua_Real lrate, Gua_Integer af, Gua_Integer oaf)
+{
+    Lmtx_Network *net;
+    Gua_Matrix *min;
+    Gua_Matrix *mout;
+    Gua_Real *xin;
+    Gua_Real *xout;
+    Gua_Integer ni;
+    Gua_Integer no;
+    Gua_Integer rows;
+    Gua_Integer count;
+    Gua_Integer epoch;
+    Gua_Integer s;
+    
+    if (!((Gua_PObjectType(nn) == OBJECT_TYPE_MATRIX) && (Gua_PObjectType(in) == OBJECT_TYPE_MATRIX) && (Gua_PObjectType(out) == OBJECT_TYPE_MATRIX))) {
+        return GUA_ERROR;
+    }
+    
+    min = (Gua_Matrix *)Gua_PObjectToMatrix(in);
+    mout = (Gua_Matrix *)Gua_PObjectToMatrix(out);
+    
+    if ((min->dimc != 2) || (mout->dimc != 2)) {
+        return GUA_ERROR;
+    }
+    if (min->dimv[0] != mout->dimv[0]) {
+        return GUA_ERROR;
+    }
+    if ((epochs < 0) || (batch < 1)) {
+        return GUA_ERROR;
+    }
+    
+    rows = min->dimv[0];
+    ni = min->dimv[1];
+    no = mout->dimv[1];
+    
+    if (batch > rows) {
+        batch = rows;
+    }
+    
+    net = Lmtx_NewNetwork(nn, ni, no, batch);
+    
+    if (net == NULL) {
+        return GUA_ERROR;
+    }
+    
+    xin = Lmtx_GetRealBuffer(in);
+    xout = Lmtx_GetRealBuffer(out);
+    
+    if ((xin == NULL) || (xout == NULL)) {
+        if (xin != NULL) {
+            Gua_Free(xin);
+        }
+        if (xout != NULL) {
+            Gua_Free(xout);
         }
         
-        /* Calculate the neurons output. */
-        for (j = ni + 1; j < (dim_j - 1); j++) {
-            Gua_RealToObject(onn[0 * dim_j + j], 0.0);
+        Lmtx_FreeNetwork(net);
+        
+        return GUA_ERROR;
+    }
+    
+    count = 0;
+    
+    for (epoch = 0; epoch < epochs; epoch++) {
+        for (s = 0; s < rows; s = s + batch) {
+            count = rows - s;
             
-            /* Weighted sums.
-               x = x1 * w1 + x2 * w2 + ... */
-            for (i = 1; i < (dim_i - 1 - no); i++) {
-                if (i < j) {
-                    if (Gua_ObjectToReal(onn[i * dim_j + j]) != 0.0) {
-                        Gua_RealToObject(onn[0 * dim_j + j], Gua_ObjectToReal(onn[0 * dim_j + j]) + Gua_ObjectToReal(onn[i * dim_j + j]) * (Gua_ObjectToReal(onn[i * dim_j + 0]) * 1.0));
-                    }
-                } else if (i == j) {
-                    if (Gua_ObjectToReal(onn[i * dim_j + j]) != 0.0) {
-                        Gua_RealToObject(onn[0 * dim_j + j], Gua_ObjectToReal(onn[0 * dim_j + j]) + Gua_ObjectToReal(onn[i * dim_j + j]) * 1.0);
-                    }
-                } else {
-                    break;
-                }
+            if (count > batch) {
+                count = batch;
             }
             
-            /* Activation function. */
-            if (j < first_out) {
-                /* Linear: f(x) = x
-                           df(x)/dx = 1 */
-                if (af == LMTX_LINEAR_ACTIVATION_FUNCTION) {
-                    /* Calculate y = f(x). */
-                    Gua_RealToObject(onn[j * dim_j + 0], Gua_ObjectToReal(onn[0 * dim_j + j]));
-                    /* Calculate df(x)/dx for backpropagation. */
-                    Gua_RealToObject(onn[j * dim_j + (dim_j - 1)], 1.0);
-                /* Logistic: f(x) = 1.0 / (1.0 + e^(-x))
-                             df(x)/dx = f(x) * (1 - f(x)) */
-                } else if (af == LMTX_LOGISTIC_ACTIVATION_FUNCTION) {
-                    /* Calculate y = f(x). */
-                    Gua_RealToObject(onn[j * dim_j + 0], 1.0 / (1.0 + exp(-(Gua_ObjectToReal(onn[0 * dim_j + j])))));
-                    /* Calculate df(x)/dx for backpropagation. */
-                    Gua_RealToObject(onn[j * dim_j + (dim_j - 1)], Gua_ObjectToReal(onn[j * dim_j + 0]) * (1.0 - Gua_ObjectToReal(onn[j * dim_j + 0])));
-                /* Hyperbolic tangent: f(x) = 2 / (1 + e^(-2x)) - 1
-                                       df(x)/dx = 1 - f(x)^2 */
-                } else if (af == LMTX_TANH_ACTIVATION_FUNCTION) {
-                    /* Calculate y = f(x). */
-                    Gua_RealToObject(onn[j * dim_j + 0], 2.0 / (1.0 + exp(-2.0 * Gua_ObjectToReal(onn[0 * dim_j + j]))) - 1.0);
-                    /* Calculate df(x)/dx for backpropagation. */
-                    Gua_RealToObject(onn[j * dim_j + (dim_j - 1)], 1.0 - Gua_ObjectToReal(onn[j * dim_j + 0]) * Gua_ObjectToReal(onn[j * dim_j + 0]));
-                /* Logistic: f(x) = 1.0 / (1.0 + e^(-x))
-                             df(x)/dx = f(x) * (1 - f(x)) */
-                } else {
-                    /* Calculate y = f(x). */
-                    Gua_RealToObject(onn[j * dim_j + 0], 1.0 / (1.0 + exp(-(Gua_ObjectToReal(onn[0 * dim_j + j])))));
-                    /* Calculate df(x)/dx for backpropagation. */
-                    Gua_RealToObject(onn[j * dim_j + (dim_j - 1)], Gua_ObjectToReal(onn[j * dim_j + 0]) * (1.0 - Gua_ObjectToReal(onn[j * dim_j + 0])));
-                }
-            /* Output layer activation function. */
-            } else {
-                /* Linear: f(x) = x
-                           df(x)/dx = 1 */
-                if (oaf == LMTX_LINEAR_ACTIVATION_FUNCTION) {
-                    /* Calculate y = f(x). */
-                    Gua_RealToObject(onn[j * dim_j + 0], Gua_ObjectToReal(onn[0 * dim_j + j]));
-                    /* Calculate df(x)/dx for backpropagation. */
-                    Gua_RealToObject(onn[j * dim_j + (dim_j - 1)], 1.0);
-                /* Logistic: f(x) = 1.0 / (1.0 + e^(-x))
-                             df(x)/dx = f(x) * (1 - f(x)) */
-                } else if (oaf == LMTX_LOGISTIC_ACTIVATION_FUNCTION) {
-                    /* Calculate y = f(x). */
-                    Gua_RealToObject(onn[j * dim_j + 0], 1.0 / (1.0 + exp(-(Gua_ObjectToReal(onn[0 * dim_j + j])))));
-                    /* Calculate df(x)/dx for backpropagation. */
-                    Gua_RealToObject(onn[j * dim_j + (dim_j - 1)], Gua_ObjectToReal(onn[j * dim_j + 0]) * (1.0 - Gua_ObjectToReal(onn[j * dim_j + 0])));
-                /* Hyperbolic tangent: f(x) = 2 / (1 + e^(-2x)) - 1
-                                       df(x)/dx = 1 - f(x)^2 */
-                } else if (oaf == LMTX_TANH_ACTIVATION_FUNCTION) {
-                    /* Calculate y = f(x). */
-                    Gua_RealToObject(onn[j * dim_j + 0], 2.0 / (1.0 + exp(-2.0 * Gua_ObjectToReal(onn[0 * dim_j + j]))) - 1.0);
-                    /* Calculate df(x)/dx for backpropagation. */
-                    Gua_RealToObject(onn[j * dim_j + (dim_j - 1)], 1.0 - Gua_ObjectToReal(onn[j * dim_j + 0]) * Gua_ObjectToReal(onn[j * dim_j + 0]));
-                /* Logistic: f(x) = 1.0 / (1.0 + e^(-x))
-                             df(x)/dx = f(x) * (1 - f(x)) */
-                } else {
-                    /* Calculate y = f(x). */
-                    Gua_RealToObject(onn[j * dim_j + 0], 1.0 / (1.0 + exp(-(Gua_ObjectToReal(onn[0 * dim_j + j])))));
-                    /* Calculate df(x)/dx for backpropagation. */
-                    Gua_RealToObject(onn[j * dim_j + (dim_j - 1)], Gua_ObjectToReal(onn[j * dim_j + 0]) * (1.0 - Gua_ObjectToReal(onn[j * dim_j + 0])));
-                }
+            Lmtx_Forward(net, &(xin[s * ni]), count, af, oaf);
+            Lmtx_Backward(net, &(xout[s * no]), count, lrate);
+        }
+    }
+    
+    if (count > 0) {
+        Lmtx_SetNetwork(net, nn, count - 1);
+    } else {
+        Lmtx_SetNetwork(net, nn, 0);
+    }
+    
+    Gua_Free(xin);
+    Gua_Free(xout);
+    
+    Lmtx_FreeNetwork(net);
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Integer Lmtx_GetOutputs(Gua_Real *w, Gua_Integer dim)
+ *
+ * Description:
+ *     Count the output neurons of a learning matrix, the last neurons
+ *     that do not feed any other neuron.
+ *
+ * Arguments:
+ *     w,      the weights returned by Lmtx_GetWeights;
+ *     dim,    the learning matrix dimension.
+ *
+ * Results:
+ *     The function returns the number of output neurons.
+ */
+Gua_Integer Lmtx_GetOutputs(Gua_Real *w, Gua_Integer dim)
+{
+    Gua_Integer i;
+    Gua_Integer j;
+    
+    for (i = dim - 2; i > 0; i--) {
+        for (j = i + 1; j < (dim - 1); j++) {
+            if (w[i * dim + j] != 0.0) {
+                return dim - 2 - i;
             }
         }
+    }
+    
+    return 0;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Lmtx_Predict(Gua_Object *nn, Gua_Object *in, Gua_Object *out, Gua_Integer af, Gua_Integer oaf, Gua_Integer of, Gua_Object *ofc)
+ *
+ * Description:
+ *     Process each row of a matrix of inputs in an artificial neural
+ *     network. The number of inputs is the number of columns of the
+ *     matrix and the number of outputs is found by Lmtx_GetOutputs.
+ *
+ * Arguments:
+ *     nn,     the learning matrix;
+ *     in,     input matrix, one pulse by row;
+ *     out,    the output matrix;
+ *     af,     activation function;
+ *     oaf,    output layer activation function;
+ *     of,     output function;
+ *     ofc,    output function constants.
+ *
+ * Results:
+ *     The function returns the ANN output, one row for each input row.
+ */
+Gua_Status Lmtx_Predict(Gua_Object *nn, Gua_Object *in, Gua_Object *out, Gua_Integer af, Gua_Integer oaf, Gua_Integer of, Gua_Object *ofc)
+{
+    Gua_Matrix *min;
+    Gua_Real *w;
+    Gua_Integer dim;
+    Gua_Integer ni;
+    Gua_Integer no;
+    
+    if (Gua_PObjectType(in) != OBJECT_TYPE_MATRIX) {
+        return GUA_ERROR;
+    }
+    
+    min = (Gua_Matrix *)Gua_PObjectToMatrix(in);
+    
+    if (min->dimc == 2) {
+        ni = min->dimv[1];
+    } else {
+        ni = Gua_PObjectLength(in);
+    }
+    
+    w = Lmtx_GetWeights(nn, &dim);
+    
+    if (w == NULL) {
+        return GUA_ERROR;
+    }
+    
+    no = Lmtx_GetOutputs(w, dim);
+    
+    Gua_Free(w);
+    
+    return Lmtx_Process(nn, in, out, ni, no, af, oaf, of, ofc);
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Lmtx_Save(Gua_String fileName, Gua_Object *nn, Gua_String error)
+ *
+ * Description:
+ *     Save the weights of a learning matrix to a binary file. The file
+ *     has a Lmtx_FileHeader followed by the dim x dim weights as native
+ *     reals, in the Lmtx_Network layout, so it can be mapped in memory.
+ *     The first and last rows and columns are saved as zeros.
+ *
+ * Arguments:
+ *     fileName,    the file name;
+ *     nn,          the learning matrix;
+ *     error,       a pointer to the error message.
+ *
+ * Results:
+ *     The function saves the learning matrix weights.
+ */
+Gua_Status Lmtx_Save(Gua_String fileName, Gua_Object *nn, Gua_String error)
+{
+    FILE *fp;
+    Lmtx_FileHeader header;
+    Gua_Real *w;
+    Gua_Integer dim;
+    Gua_Integer written;
+    Gua_String errMessage;
+    
+    w = Lmtx_GetWeights(nn, &dim);
+    
+    if (w == NULL) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "the learning matrix must be square and numeric");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
         
-        /* Calculate delta for the output neurons.
-           d = z - y */
-        for (i = 0; i < no; i++) {
-            Gua_RealToObject(onn[(dim_i - 1) * dim_j + (first_out + i)], Gua_ObjectToReal(oout[i]) - Gua_ObjectToReal(onn[(first_out + i) * dim_j + 0]));
-        }
+        return GUA_ERROR;
+    }
+    
+    fp = fopen(fileName, "wb");
+    
+    if (fp == NULL) {
+        Gua_Free(w);
         
-        /* Calculate delta for hidden neurons.
-           d1 = w1 * d2 + w2 * d2 + ... */
-        for (j = dim_j - 2; j > ni; j--) {
-            for (i = ni + 1; i < (dim_i - 1 - no); i++) {
-                if (i == j) {
-                    break;
-                }
-                
-                if (Gua_ObjectToReal(onn[i * dim_j + j]) != 0.0) {
-                    Gua_RealToObject(onn[(dim_i - 1) * dim_j + i], Gua_ObjectToReal(onn[(dim_i - 1) * dim_j + i]) + Gua_ObjectToReal(onn[i * dim_j + j]) * Gua_ObjectToReal(onn[(dim_i - 1) * dim_j + j]));
-                }
-            }
-        }
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "could not open file", fileName);
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
         
-        /* Adjust weights.
-           x = x1 * w1 + x2 * w2 + ...
-           w1 = w1 + n * d * df(x)/dx * x1
-           w2 = w2 + n * d * df(x)/dx * x2 */
-        for (j = no + 1; j < (dim_j - 1); j++) {
-            for (i = 1; i < (dim_i - 1 - no); i++) {
-                if (i < j) {
-                    if (Gua_ObjectToReal(onn[i * dim_j + j]) != 0.0) {
-                        Gua_RealToObject(onn[i * dim_j + j], Gua_ObjectToReal(onn[i * dim_j + j]) + lrate * Gua_ObjectToReal(onn[(dim_i - 1) * dim_j + j]) * Gua_ObjectToReal(onn[j * dim_j + (dim_j - 1)]) * Gua_ObjectToReal(onn[i * dim_j + 0]));
-                    }
-                } else if (i == j) {
-                    if (Gua_ObjectToReal(onn[i * dim_j + j]) != 0.0) {
-                        Gua_RealToObject(onn[i * dim_j + j], Gua_ObjectToReal(onn[i * dim_j + j]) + lrate * Gua_ObjectToReal(onn[(dim_i - 1) * dim_j + j]) * Gua_ObjectToReal(onn[j * dim_j + (dim_j - 1)]) * 1.0);
-                    }
-                } else {
-                    break;
-                }
-            }
-        }
+        return GUA_ERROR;
+    }
+    
+    memset(&header, 0, sizeof(Lmtx_FileHeader));
+    memcpy(header.magic, LMTX_FILE_MAGIC, 4);
+    header.order = LMTX_FILE_ORDER;
+    header.version = LMTX_FILE_VERSION;
+    header.dim = (unsigned int)dim;
+    
+    written = fwrite(&header, sizeof(Lmtx_FileHeader), 1, fp);
+    written = written + fwrite(w, sizeof(Gua_Real), dim * dim, fp);
+    
+    Gua_Free(w);
+    
+    if ((fclose(fp) != 0) || (written != (1 + dim * dim))) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "could not write file", fileName);
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
         
-        return GUA_OK;
+        return GUA_ERROR;
     }
     
-    return GUA_ERROR;
+    return GUA_OK;
 }
 
 /**
@@ -273,227 +1148,94 @@ Gua_Status Lmtx_Learn(Gua_Object *nn, Gua_Object *in, Gua_Object *out, Gua_Integ
  *     C
  *
  * Function:
- *     Gua_Status Lmtx_Process(Gua_Object *nn, Gua_Object *in, Gua_Object *out, Gua_Integer ni, Gua_Integer no, Gua_Integer af, Gua_Integer oaf, Gua_Integer of, Gua_Object *ofc)
+ *     Gua_Status Lmtx_Load(Gua_String fileName, Gua_Object *nn, Gua_String error)
  *
  * Description:
- *     Process a pulse in an artificial neural network.
+ *     Load a learning matrix saved by Lmtx_Save.
  *
  * Arguments:
- *     nn,     the learning matrix;
- *     in,     input training set;
- *     out,    input training set;
- *     ni,     number of input neurons;
- *     no,     number of input neurons;
- *     af,     activation function;
- *     oaf,    output layer activation function;
- *     of,     output function;
- *     ofc,    output function constants.
+ *     fileName,    the file name;
+ *     nn,          the learning matrix;
+ *     error,       a pointer to the error message.
  *
  * Results:
- *     The function returns the ANN output after the pulse.
+ *     The function returns a real learning matrix.
  */
-Gua_Status Lmtx_Process(Gua_Object *nn, Gua_Object *in, Gua_Object *out, Gua_Integer ni, Gua_Integer no, Gua_Integer af, Gua_Integer oaf, Gua_Integer of, Gua_Object *ofc)
+Gua_Status Lmtx_Load(Gua_String fileName, Gua_Object *nn, Gua_String error)
 {
+    FILE *fp;
+    Lmtx_FileHeader header;
     Gua_Matrix *mnn;
-    Gua_Matrix *min;
-    Gua_Matrix *mout;
-    Gua_Matrix *mofc;
     Gua_Object *onn;
-    Gua_Object *oin;
-    Gua_Object *oout;
-    Gua_Object *oofc;
+    Gua_Real *w;
+    Gua_Integer dim;
     Gua_Integer i;
-    Gua_Integer j;
-    Gua_Integer dim_i;
-    Gua_Integer dim_j;
-    Gua_Integer first_out;
+    Gua_String errMessage;
     
-    if (!((Gua_PObjectType(nn) == OBJECT_TYPE_MATRIX) && (Gua_PObjectType(in) == OBJECT_TYPE_MATRIX))) {
+    fp = fopen(fileName, "rb");
+    
+    if (fp == NULL) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "could not open file", fileName);
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
         return GUA_ERROR;
     }
     
-    mnn = (Gua_Matrix *)Gua_PObjectToMatrix(nn);
-    min = (Gua_Matrix *)Gua_PObjectToMatrix(in);
-    
-    if (ofc != NULL) {
-        mofc = (Gua_Matrix *)Gua_PObjectToMatrix(ofc);
-    }
+    w = NULL;
+    dim = 0;
     
-    if (mnn && min) {
-        if (!Gua_IsPObjectStored(out)) {
-            Gua_FreeObject(out);
-        } else {
-            Gua_ClearPObject(out);
-        }
-        
-        dim_i = mnn->dimv[0];
-        dim_j = mnn->dimv[1];
-        
-        onn = (Gua_Object *)mnn->object;
-        oin = (Gua_Object *)min->object;
-        
-        if (ofc != NULL) {
-            oofc = (Gua_Object *)mofc->object;
-        }
-        
-        /* Linear matrix cell access: k = i * dim_j + j */
-        first_out = dim_j - 1 - no;
-        
-        /* Convert integer values to real. */
-        for (i = 0; i < Gua_PObjectLength(nn); i++) {
-            if (Gua_ObjectType(onn[i]) == OBJECT_TYPE_INTEGER) {
-                Gua_ConvertIntegerObjectToReal(onn[i]);
-            }
-        }
-        for (i = 0; i < Gua_PObjectLength(in); i++) {
-            if (Gua_ObjectType(oin[i]) == OBJECT_TYPE_INTEGER) {
-                Gua_ConvertIntegerObjectToReal(oin[i]);
-            }
-        }
-        
-        /* Clear inputs and outputs. */
-        for (i = 0; i < dim_i - 1; i++) {
-            if (Gua_ObjectType(onn[0 * dim_j + i]) == OBJECT_TYPE_STRING) {
-                Gua_FreeObject(&(onn[0 * dim_j + i]));
-            }
-            Gua_RealToObject(onn[0 * dim_j + i], 0.0);
-            
-            if (Gua_ObjectType(onn[i * dim_j + 0]) == OBJECT_TYPE_STRING) {
-                Gua_FreeObject(&(onn[i * dim_j + 0]));
-            }
-            Gua_RealToObject(onn[i * dim_j + 0], 0.0);
-            
-            if (Gua_ObjectType(onn[i * dim_j + (dim_j - 1)]) == OBJECT_TYPE_STRING) {
-                Gua_FreeObject(&(onn[i * dim_j + (dim_j - 1)]));
-            }
-            Gua_RealToObject(onn[i * dim_j + (dim_j - 1)], 0.0);
-            
-            if (Gua_ObjectType(onn[(dim_i - 1) * dim_j + i]) == OBJECT_TYPE_STRING) {
-                Gua_FreeObject(&(onn[(dim_i - 1) * dim_j + i]));
-            }
-            Gua_RealToObject(onn[(dim_i - 1) * dim_j + i], 0.0);
-        }
-        
-        /* Assign inputs. */
-        for (j = 0; j < ni; j++) {
-            Gua_RealToObject(onn[(j + 1) * dim_j + 0], Gua_ObjectToReal(oin[j]));
-        }
-        
-        /* Calculate the neurons output. */
-        for (j = ni + 1; j < (dim_j - 1); j++) {
-            Gua_RealToObject(onn[0 * dim_j + j], 0.0);
+    if (fread(&header, sizeof(Lmtx_FileHeader), 1, fp) == 1) {
+        if ((memcmp(header.magic, LMTX_FILE_MAGIC, 4) == 0) && (header.order == LMTX_FILE_ORDER) && (header.version == LMTX_FILE_VERSION) && (header.dim >= 3)) {
+            dim = header.dim;
             
-            /* Weighted sums.
-               x = x1 * w1 + x2 * w2 + ... */
-            for (i = 1; i < (dim_i - 1 - no); i++) {
-                if (i < j) {
-                    if (Gua_ObjectToReal(onn[i * dim_j + j]) != 0.0) {
-                        Gua_RealToObject(onn[0 * dim_j + j], Gua_ObjectToReal(onn[0 * dim_j + j]) + Gua_ObjectToReal(onn[i * dim_j + j]) * (Gua_ObjectToReal(onn[i * dim_j + 0]) * 1.0));
-                    }
-                } else if (i == j) {
-                    if (Gua_ObjectToReal(onn[i * dim_j + j]) != 0.0) {
-                        Gua_RealToObject(onn[0 * dim_j + j], Gua_ObjectToReal(onn[0 * dim_j + j]) + Gua_ObjectToReal(onn[i * dim_j + j]) * 1.0);
-                    }
-                } else {
-                    break;
-                }
-            }
+            w = (Gua_Real *)Gua_Alloc(sizeof(Gua_Real) * dim * dim);
             
-            /* Activation function. */
-            if (j < first_out) {
-                /* Linear: f(x) = x */
-                if (af == LMTX_LINEAR_ACTIVATION_FUNCTION) {
-                    /* Calculate y = f(x). */
-                    Gua_RealToObject(onn[j * dim_j + 0], Gua_ObjectToReal(onn[0 * dim_j + j]));
-                /* Logistic: f(x) = 1.0 / (1.0 + e^(-x)) */
-                } else if (af == LMTX_LOGISTIC_ACTIVATION_FUNCTION) {
-                    /* Calculate y = f(x). */
-                    Gua_RealToObject(onn[j * dim_j + 0], 1.0 / (1.0 + exp(-(Gua_ObjectToReal(onn[0 * dim_j + j])))));
-                /* Hyperbolic tangent: f(x) = 2 / (1 + e^(-2x)) - 1 */
-                } else if (af == LMTX_TANH_ACTIVATION_FUNCTION) {
-                    /* Calculate y = f(x). */
-                    Gua_RealToObject(onn[j * dim_j + 0], 2.0 / (1.0 + exp(-2.0 * Gua_ObjectToReal(onn[0 * dim_j + j]))) - 1.0);
-                /* Logistic: f(x) = 1.0 / (1.0 + e^(-x)) */
-                } else {
-                    /* Calculate y = f(x). */
-                    Gua_RealToObject(onn[j * dim_j + 0], 1.0 / (1.0 + exp(-(Gua_ObjectToReal(onn[0 * dim_j + j])))));
-                }
-            /* Output layer activation function. */
-            } else {
-                /* Linear: f(x) = x */
-                if (oaf == LMTX_LINEAR_ACTIVATION_FUNCTION) {
-                    /* Calculate y = f(x). */
-                    Gua_RealToObject(onn[j * dim_j + 0], Gua_ObjectToReal(onn[0 * dim_j + j]));
-                /* Logistic: f(x) = 1.0 / (1.0 + e^(-x)) */
-                } else if (oaf == LMTX_LOGISTIC_ACTIVATION_FUNCTION) {
-                    /* Calculate y = f(x). */
-                    Gua_RealToObject(onn[j * dim_j + 0], 1.0 / (1.0 + exp(-(Gua_ObjectToReal(onn[0 * dim_j + j])))));
-                /* Hyperbolic tangent: f(x) = 2 / (1 + e^(-2x)) - 1 */
-                } else if (oaf == LMTX_TANH_ACTIVATION_FUNCTION) {
-                    /* Calculate y = f(x). */
-                    Gua_RealToObject(onn[j * dim_j + 0], 2.0 / (1.0 + exp(-2.0 * Gua_ObjectToReal(onn[0 * dim_j + j]))) - 1.0);
-                /* Logistic: f(x) = 1.0 / (1.0 + e^(-x)) */
-                } else {
-                    /* Calculate y = f(x). */
-                    Gua_RealToObject(onn[j * dim_j + 0], 1.0 / (1.0 + exp(-(Gua_ObjectToReal(onn[0 * dim_j + j])))));
-                }
-            }
-        }
-        
-        /* Set the output matrix. */
-        Gua_MatrixToPObject(out, (struct Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix)), no);
-        
-        mout = (Gua_Matrix *)Gua_PObjectToMatrix(out);
-        
-        mout->dimc = 2;
-        mout->dimv = Gua_Alloc(mout->dimc * sizeof(Gua_Integer));
-        mout->dimv[0] = 1;
-        mout->dimv[1] = no;
-        
-        mout->object = (struct Gua_Object *)Gua_Alloc(no * sizeof(Gua_Object));
-        
-        oout = (Gua_Object *)mout->object;
-        
-        for (i = 0; i < no; i = i + 1) {
-            if (of == LMTX_LINEAR_OUTPUT_FUNCTION) {
-                Gua_RealToObject(oout[i], Gua_ObjectToReal(oofc[0]) * Gua_ObjectToReal(onn[(first_out + i) * dim_j + 0]) + Gua_ObjectToReal(oofc[1]));
-            } else if (of == LMTX_STEP_OUTPUT_FUNCTION) {
-                if (oaf == LMTX_LINEAR_ACTIVATION_FUNCTION) {
-                    if (Gua_ObjectToReal(onn[(first_out + i) * dim_j + 0]) >= 0.0) {
-                        Gua_RealToObject(oout[i], 1.0);
-                    } else {
-                        Gua_RealToObject(oout[i], 0.0);
-                    }
-                } else if (oaf == LMTX_LOGISTIC_ACTIVATION_FUNCTION) {
-                    if (Gua_ObjectToReal(onn[(first_out + i) * dim_j + 0]) >= 0.5) {
-                        Gua_RealToObject(oout[i], 1.0);
-                    } else {
-                        Gua_RealToObject(oout[i], 0.0);
-                    }
-                } else if (oaf == LMTX_TANH_ACTIVATION_FUNCTION) {
-                    if (Gua_ObjectToReal(onn[(first_out + i) * dim_j + 0]) >= 0.0) {
-                        Gua_RealToObject(oout[i], 1.0);
-                    } else {
-                        Gua_RealToObject(oout[i], 0.0);
-                    }
-                } else {
-                    if (Gua_ObjectToReal(onn[(first_out + i) * dim_j + 0]) >= 0.0) {
-                        Gua_RealToObject(oout[i], 1.0);
-                    } else {
-                        Gua_RealToObject(oout[i], 0.0);
-                    }
-                }
-            } else if (of == LMTX_NO_OUTPUT_FUNCTION) {
-                Gua_RealToObject(oout[i], Gua_ObjectToReal(onn[(first_out + i) * dim_j + 0]));
-            } else {
-                Gua_RealToObject(oout[i], Gua_ObjectToReal(onn[(first_out + i) * dim_j + 0]));
+            if (fread(w, sizeof(Gua_Real), dim * dim, fp) != (dim * dim)) {
+                Gua_Free(w);
+                w = NULL;
             }
         }
+    }
+    
+    fclose(fp);
+    
+    if (w == NULL) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "not a learning matrix file", fileName);
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
         
-        return GUA_OK;
+        return GUA_ERROR;
+    }
+    
+    if (!Gua_IsPObjectStored(nn)) {
+        Gua_FreeObject(nn);
+    } else {
+        Gua_ClearPObject(nn);
+    }
+    
+    Gua_MatrixToPObject(nn, (struct Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix)), dim * dim);
+    
+    mnn = (Gua_Matrix *)Gua_PObjectToMatrix(nn);
+    
+    mnn->dimc = 2;
+    mnn->dimv = Gua_Alloc(mnn->dimc * sizeof(Gua_Integer));
+    mnn->dimv[0] = dim;
+    mnn->dimv[1] = dim;
+    
+    mnn->object = (struct Gua_Object *)Gua_Alloc(dim * dim * sizeof(Gua_Object));
+    
+    onn = (Gua_Object *)mnn->object;
+    
+    for (i = 0; i < (dim * dim); i++) {
+        Gua_RealToObject(onn[i], w[i]);
     }
     
-    return GUA_ERROR;
+    Gua_Free(w);
+    
+    return GUA_OK;
 }
 
 /**
@@ -525,6 +1267,9 @@ Gua_Status Lmtx_FunctionWrapper(void *nspace, Gua_Short argc, Gua_Object *argv,
     Gua_Integer oaf;
     Gua_Integer of;
     Gua_Object *ofc;
+    Gua_Object *fargv;
+    Gua_Short i;
+    Gua_Status status;
     
     Gua_ClearPObject(object);
     
@@ -548,16 +1293,131 @@ Gua_Status Lmtx_FunctionWrapper(void *nspace, Gua_Short argc, Gua_Object *argv,
      *     Scripting
      *
      * Function:
-     *     lmtxLearn(nn, in, out, ni, no, lrate, af, oaf)
+     *     lmtxLearn(nn, in, out, ni, no, lrate, af, oaf)
+     *
+     * Description:
+     *      Teach an artificial neural network for step of one epoch.
+     *
+     * Examples:
+     *     lmtx = lmtxLearn(lmtx, input, output, dim_in_j, dim_out_j, 0.45, LMTX_SIGMOID_ACTIVATION_FUNCTION).
+     */
+    if (strcmp(Gua_ObjectToString(argv[0]), "lmtxLearn") == 0) {
+        if (argc < 6) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (Gua_ObjectType(argv[2]) != OBJECT_TYPE_MATRIX) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (Gua_ObjectType(argv[3]) != OBJECT_TYPE_MATRIX) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 3 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (Gua_ObjectType(argv[4]) != OBJECT_TYPE_INTEGER) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 4 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (Gua_ObjectType(argv[5]) != OBJECT_TYPE_INTEGER) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 5 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (argc >= 7) {
+            if (Gua_ObjectType(argv[6]) != OBJECT_TYPE_REAL) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 6 for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+            
+            lrate = Gua_ObjectToReal(argv[6]);
+        }
+        
+        if (argc >= 8) {
+            if (Gua_ObjectType(argv[7]) != OBJECT_TYPE_INTEGER) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 7 for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+            
+            af = Gua_ObjectToInteger(argv[7]);
+        }
+        
+        if (argc == 9) {
+            if (Gua_ObjectType(argv[8]) != OBJECT_TYPE_INTEGER) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 8 for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+            
+            oaf = Gua_ObjectToInteger(argv[8]);
+        } else {
+            oaf = af;
+        }
+        
+        Gua_CopyMatrix(object, &(argv[1]), false);
+        
+        if (Lmtx_Learn(object, &(argv[2]), &(argv[3]), Gua_ObjectToInteger(argv[4]), Gua_ObjectToInteger(argv[5]), lrate, af, oaf) != GUA_OK) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+    /**
+     * Group:
+     *     Scripting
+     *
+     * Function:
+     *     lmtxLoad(file_name)
      *
      * Description:
-     *      Teach an artificial neural network for step of one epoch.
+     *      Load a learning matrix saved by lmtxSave.
      *
      * Examples:
-     *     lmtx = lmtxLearn(lmtx, input, output, dim_in_j, dim_out_j, 0.45, LMTX_SIGMOID_ACTIVATION_FUNCTION).
+     *     lmtx = lmtxLoad("xor.lmtx").
      */
-    if (strcmp(Gua_ObjectToString(argv[0]), "lmtxLearn") == 0) {
-        if (argc < 6) {
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "lmtxLoad") == 0) {
+        if (argc != 2) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
             sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
@@ -566,7 +1426,7 @@ Gua_Status Lmtx_FunctionWrapper(void *nspace, Gua_Short argc, Gua_Object *argv,
             return GUA_ERROR;
         }
         
-        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_STRING) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
             sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
@@ -574,83 +1434,111 @@ Gua_Status Lmtx_FunctionWrapper(void *nspace, Gua_Short argc, Gua_Object *argv,
             
             return GUA_ERROR;
         }
-        if (Gua_ObjectType(argv[2]) != OBJECT_TYPE_MATRIX) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
+        
+        if (Lmtx_Load(Gua_ObjectToString(argv[1]), object, error) != GUA_OK) {
             return GUA_ERROR;
         }
-        if (Gua_ObjectType(argv[3]) != OBJECT_TYPE_MATRIX) {
+    /**
+     * Group:
+     *     Scripting
+     *
+     * Function:
+     *     lmtxPredict(nn, in, af, oaf, of, c)
+     *
+     * Description:
+     *      Process each row of the input matrix in an artificial neural
+     *      network, a batch of rows at once, and return one row of
+     *      outputs for each. The number of outputs is the number of last
+     *      neurons that do not feed other neurons. Returns the output
+     *      layer values unless an output function is given.
+     *
+     * Examples:
+     *     scores = lmtxPredict(lmtx, input, LMTX_LOGISTIC_ACTIVATION_FUNCTION).
+     */
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "lmtxPredict") == 0) {
+        if (argc < 3) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 3 for function", Gua_ObjectToString(argv[0]));
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
             Gua_Free(errMessage);
             
             return GUA_ERROR;
         }
-        if (Gua_ObjectType(argv[4]) != OBJECT_TYPE_INTEGER) {
+        
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 4 for function", Gua_ObjectToString(argv[0]));
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
             Gua_Free(errMessage);
             
             return GUA_ERROR;
         }
-        if (Gua_ObjectType(argv[5]) != OBJECT_TYPE_INTEGER) {
+        if (Gua_ObjectType(argv[2]) != OBJECT_TYPE_MATRIX) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 5 for function", Gua_ObjectToString(argv[0]));
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
             Gua_Free(errMessage);
             
             return GUA_ERROR;
         }
         
-        if (argc >= 7) {
-            if (Gua_ObjectType(argv[6]) != OBJECT_TYPE_REAL) {
+        of = LMTX_NO_OUTPUT_FUNCTION;
+        
+        if (argc >= 4) {
+            if (Gua_ObjectType(argv[3]) != OBJECT_TYPE_INTEGER) {
                 errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 6 for function", Gua_ObjectToString(argv[0]));
+                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 3 for function", Gua_ObjectToString(argv[0]));
                 strcat(error, errMessage);
                 Gua_Free(errMessage);
                 
                 return GUA_ERROR;
             }
             
-            lrate = Gua_ObjectToReal(argv[6]);
+            af = Gua_ObjectToInteger(argv[3]);
         }
         
-        if (argc >= 8) {
-            if (Gua_ObjectType(argv[7]) != OBJECT_TYPE_INTEGER) {
+        if (argc >= 5) {
+            if (Gua_ObjectType(argv[4]) != OBJECT_TYPE_INTEGER) {
                 errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 7 for function", Gua_ObjectToString(argv[0]));
+                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 4 for function", Gua_ObjectToString(argv[0]));
                 strcat(error, errMessage);
                 Gua_Free(errMessage);
                 
                 return GUA_ERROR;
             }
             
-            af = Gua_ObjectToInteger(argv[7]);
+            oaf = Gua_ObjectToInteger(argv[4]);
+        } else {
+            oaf = af;
         }
         
-        if (argc == 9) {
-            if (Gua_ObjectType(argv[8]) != OBJECT_TYPE_INTEGER) {
+        if (argc >= 6) {
+            if (Gua_ObjectType(argv[5]) != OBJECT_TYPE_INTEGER) {
                 errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 8 for function", Gua_ObjectToString(argv[0]));
+                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 5 for function", Gua_ObjectToString(argv[0]));
                 strcat(error, errMessage);
                 Gua_Free(errMessage);
                 
                 return GUA_ERROR;
             }
             
-            oaf = Gua_ObjectToInteger(argv[8]);
-        } else {
-            oaf = af;
+            of = Gua_ObjectToInteger(argv[5]);
         }
         
-        Gua_CopyMatrix(object, &(argv[1]), false);
+        if (argc == 7) {
+            if (Gua_ObjectType(argv[6]) != OBJECT_TYPE_MATRIX) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 6 for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+            
+            ofc = &(argv[6]);
+        }
         
-        if (Lmtx_Learn(object, &(argv[2]), &(argv[3]), Gua_ObjectToInteger(argv[4]), Gua_ObjectToInteger(argv[5]), lrate, af, oaf) != GUA_OK) {
+        if (Lmtx_Predict(&(argv[1]), &(argv[2]), object, af, oaf, of, ofc) != GUA_OK) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
             sprintf(errMessage, "%s %-.20s...\n", "illegal arguments for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
@@ -666,7 +1554,8 @@ Gua_Status Lmtx_FunctionWrapper(void *nspace, Gua_Short argc, Gua_Object *argv,
      *     lmtxProcess(nn, in, ni, no, af, oaf, of, c)
      *
      * Description:
-     *      Process a pulse in an artificial neural network.
+     *      Process a pulse in an artificial neural network. If in has
+     *      more than one row of ni columns, returns one row for each.
      *
      * Examples:
      *     output == lmtxProcess(lmtx, input, dim_in_j, dim_out_j, LMTX_SIGMOID_ACTIVATION_FUNCTION, LMTX_SIGMOID_ACTIVATION_FUNCTION, LMTX_STEP_OUTPUT_FUNCTION, c).
@@ -742,7 +1631,7 @@ Gua_Status Lmtx_FunctionWrapper(void *nspace, Gua_Short argc, Gua_Object *argv,
             oaf = af;
         }
         
-        if (argc == 8) {
+        if (argc >= 8) {
             if (Gua_ObjectType(argv[7]) != OBJECT_TYPE_INTEGER) {
                 errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
                 sprintf(errMessage, "%s %-.20s...\n", "illegal argument 7 for function", Gua_ObjectToString(argv[0]));
@@ -774,6 +1663,191 @@ Gua_Status Lmtx_FunctionWrapper(void *nspace, Gua_Short argc, Gua_Object *argv,
             strcat(error, errMessage);
             Gua_Free(errMessage);
             
+            return GUA_ERROR;
+        }
+    /**
+     * Group:
+     *     Scripting
+     *
+     * Function:
+     *     lmtxSave(file_name, nn)
+     *
+     * Description:
+     *      Save the weights of a learning matrix to a binary file. Row
+     *      and column 0 and the last row and column, which hold the
+     *      labels and the neurons state, are saved as zeros.
+     *
+     * Examples:
+     *     lmtxSave("xor.lmtx", lmtx).
+     */
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "lmtxSave") == 0) {
+        if (argc != 3) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_STRING) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (Gua_ObjectType(argv[2]) != OBJECT_TYPE_MATRIX) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Lmtx_Save(Gua_ObjectToString(argv[1]), &(argv[2]), error) != GUA_OK) {
+            return GUA_ERROR;
+        }
+    /**
+     * Group:
+     *     Scripting
+     *
+     * Function:
+     *     lmtxTrain(nn, in, out, epochs, batch, lrate, af, oaf)
+     *
+     * Description:
+     *      Teach an artificial neural network for a number of epochs,
+     *      using mini-batches of the rows of the training set. With
+     *      batch = 1 it is the same as calling lmtxLearn for each row.
+     *      The old form, lmtxTrain("ann", in, out, lrate, af, oaf, of, ofc,
+     *      max_epochs, minimum_correctness, "correctness", callback, interval),
+     *      is passed to lmtxTrainOnline.
+     *
+     * Examples:
+     *     lmtx = lmtxTrain(lmtx, input, output, 1000, 16, 0.45, LMTX_LOGISTIC_ACTIVATION_FUNCTION).
+     */
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "lmtxTrain") == 0) {
+        if (argc >= 2) {
+            if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_STRING) {
+                fargv = (Gua_Object *)Gua_Alloc(sizeof(Gua_Object) * argc);
+                
+                Gua_LinkStringToObject(fargv[0], "lmtxTrainOnline");
+                Gua_SetStoredObject(fargv[0]);
+                
+                for (i = 1; i < argc; i++) {
+                    fargv[i] = argv[i];
+                    Gua_SetStoredObject(fargv[i]);
+                }
+                
+                status = Gua_EvalFunction(nspace, argc, fargv, object, error);
+                
+                Gua_Free(fargv);
+                
+                return status;
+            }
+        }
+        
+        if (argc < 6) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (Gua_ObjectType(argv[2]) != OBJECT_TYPE_MATRIX) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (Gua_ObjectType(argv[3]) != OBJECT_TYPE_MATRIX) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 3 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (Gua_ObjectType(argv[4]) != OBJECT_TYPE_INTEGER) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 4 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (Gua_ObjectType(argv[5]) != OBJECT_TYPE_INTEGER) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 5 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (argc >= 7) {
+            if (Gua_ObjectType(argv[6]) != OBJECT_TYPE_REAL) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 6 for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+            
+            lrate = Gua_ObjectToReal(argv[6]);
+        }
+        
+        if (argc >= 8) {
+            if (Gua_ObjectType(argv[7]) != OBJECT_TYPE_INTEGER) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 7 for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+            
+            af = Gua_ObjectToInteger(argv[7]);
+        }
+        
+        if (argc == 9) {
+            if (Gua_ObjectType(argv[8]) != OBJECT_TYPE_INTEGER) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 8 for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+            
+            oaf = Gua_ObjectToInteger(argv[8]);
+        } else {
+            oaf = af;
+        }
+        
+        Gua_CopyMatrix(object, &(argv[1]), false);
+        
+        if (Lmtx_Train(object, &(argv[2]), &(argv[3]), Gua_ObjectToInteger(argv[4]), Gua_ObjectToInteger(argv[5]), lrate, af, oaf) != GUA_OK) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
             return GUA_ERROR;
         }
     }
@@ -816,12 +1890,40 @@ Gua_Status Lmtx_Init(void *nspace, int argc, char *argv[], char **env, Gua_Strin
         Gua_Free(errMessage);
     }
     Gua_LinkCFunctionToFunction(function, Lmtx_FunctionWrapper);
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "lmtxLoad", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "lmtxLoad");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    Gua_LinkCFunctionToFunction(function, Lmtx_FunctionWrapper);
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "lmtxPredict", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "lmtxPredict");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    Gua_LinkCFunctionToFunction(function, Lmtx_FunctionWrapper);
     if (Gua_SetFunction((Gua_Namespace *)nspace, "lmtxProcess", &function) != GUA_OK) {
         errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
         sprintf(errMessage, "%s %-.20s...\n", "can't set function", "lmtxProcess");
         strcat(error, errMessage);
         Gua_Free(errMessage);
     }
+    Gua_LinkCFunctionToFunction(function, Lmtx_FunctionWrapper);
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "lmtxSave", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "lmtxSave");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    Gua_LinkCFunctionToFunction(function, Lmtx_FunctionWrapper);
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "lmtxTrain", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "lmtxTrain");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
     
     /* Define each extension constant... */
     
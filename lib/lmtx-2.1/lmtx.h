@@ -35,8 +35,56 @@
 #define LMTX_LINEAR_OUTPUT_FUNCTION        1
 #define LMTX_STEP_OUTPUT_FUNCTION          2
 
+#define LMTX_BATCH_SIZE                    1024
+
+#define LMTX_FILE_MAGIC                    "LMTX"
+#define LMTX_FILE_ORDER                    0x01020304
+#define LMTX_FILE_VERSION                  1
+
+/* A learning matrix unpacked into contiguous buffers. The neuron state
+   buffers hold one row of batch samples per neuron, and the weights
+   reaching neuron j come from the neurons listed in source[first[j]] to
+   source[first[j + 1] - 1]. */
+typedef struct {
+    Gua_Integer dim;
+    Gua_Integer ni;
+    Gua_Integer no;
+    Gua_Integer batch;
+    Gua_Real *w;
+    Gua_Integer *first;
+    Gua_Integer *source;
+    Gua_Real *x;
+    Gua_Real *y;
+    Gua_Real *df;
+    Gua_Real *d;
+    Gua_Real *e;
+} Lmtx_Network;
+
+/* Header of a learning matrix file. The order field tells the byte order
+   of the machine that saved the file. */
+typedef struct {
+    char magic[4];
+    unsigned int order;
+    unsigned int version;
+    unsigned int dim;
+} Lmtx_FileHeader;
+
+Gua_Real *Lmtx_GetRealBuffer(Gua_Object *object);
+Gua_Real *Lmtx_GetWeights(Gua_Object *nn, Gua_Integer *dim);
+Lmtx_Network *Lmtx_NewNetwork(Gua_Object *nn, Gua_Integer ni, Gua_Integer no, Gua_Integer batch);
+void Lmtx_FreeNetwork(Lmtx_Network *net);
+void Lmtx_SetNetwork(Lmtx_Network *net, Gua_Object *nn, Gua_Integer sample);
+void Lmtx_Activate(Gua_Integer f, Gua_Real *x, Gua_Real *y, Gua_Real *df, Gua_Integer n);
+void Lmtx_Forward(Lmtx_Network *net, Gua_Real *in, Gua_Integer count, Gua_Integer af, Gua_Integer oaf);
+void Lmtx_Backward(Lmtx_Network *net, Gua_Real *out, Gua_Integer count, Gua_Real lrate);
 Gua_Status Lmtx_Learn(Gua_Object *nn, Gua_Object *in, Gua_Object *out, Gua_Integer ni, Gua_Integer no, Gua_Real lrate, Gua_Integer af, Gua_Integer oaf);
+Gua_Status Lmtx_Pulse(Gua_Object *nn, Gua_Real *in, Gua_Integer rows, Gua_Integer ni, Gua_Integer no, Gua_Integer af, Gua_Integer oaf, Gua_Integer of, Gua_Real *c, Gua_Object *out);
 Gua_Status Lmtx_Process(Gua_Object *nn, Gua_Object *in, Gua_Object *out, Gua_Integer ni, Gua_Integer no, Gua_Integer af, Gua_Integer oaf, Gua_Integer of, Gua_Object *c);
+Gua_Status Lmtx_Train(Gua_Object *nn, Gua_Object *in, Gua_Object *out, Gua_Integer epochs, Gua_Integer batch, Gua_Real lrate, Gua_Integer af, Gua_Integer oaf);
+Gua_Integer Lmtx_GetOutputs(Gua_Real *w, Gua_Integer dim);
+Gua_Status Lmtx_Predict(Gua_Object *nn, Gua_Object *in, Gua_Object *out, Gua_Integer af, Gua_Integer oaf, Gua_Integer of, Gua_Object *ofc);
+Gua_Status Lmtx_Save(Gua_String fileName, Gua_Object *nn, Gua_String error);
+Gua_Status Lmtx_Load(Gua_String fileName, Gua_Object *nn, Gua_String error);
 
 Gua_Status Lmtx_FunctionWrapper(void *nspace, Gua_Short argc, Gua_Object *argv, Gua_Object *object, Gua_String error);
 Gua_Status Lmtx_Init(void *nspace, int argc, char *argv[], char **env, Gua_String error);
@@ -35,6 +35,363 @@
 #include "interp.h"
 #include "array.h"
 
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Short Array_IsHashable(Gua_Object *o)
+ *
+ * Description:
+ *     Check if an array element can be stored in a hash set.
+ *
+ * Arguments:
+ *     o,    the element object.
+ *
+ * Results:
+ *     The function returns true for integers, reals, complex numbers and
+ *     strings. A NaN never equals anything, so it is not hashable.
+ */
+Gua_Short Array_IsHashable(Gua_Object *o)
+{
+    if (Gua_PObjectType(o) == OBJECT_TYPE_INTEGER) {
+        return true;
+    } else if (Gua_PObjectType(o) == OBJECT_TYPE_REAL) {
+        return !isnan(Gua_PObjectToReal(o));
+    } else if (Gua_PObjectType(o) == OBJECT_TYPE_COMPLEX) {
+        return !isnan(Gua_PObjectToReal(o)) && !isnan(Gua_PObjectToImaginary(o));
+    } else if (Gua_PObjectType(o) == OBJECT_TYPE_STRING) {
+        return true;
+    }
+    
+    return false;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     unsigned long Array_Hash(Gua_Object *o)
+ *
+ * Description:
+ *     Calculate the FNV-1a hash of the type and value of an array element.
+ *
+ * Arguments:
+ *     o,    a hashable element object.
+ *
+ * Results:
+ *     The hash of the element. Equal elements have equal hashes.
+ */
+unsigned long Array_Hash(Gua_Object *o)
+{
+    unsigned char *p;
+    unsigned long hash;
+    Gua_Real v[2];
+    Gua_Integer i;
+    Gua_Length n;
+    Gua_Length k;
+    
+    hash = (2166136261UL ^ (unsigned char)Gua_PObjectType(o)) * 16777619UL;
+    
+    if (Gua_PObjectType(o) == OBJECT_TYPE_INTEGER) {
+        i = Gua_PObjectToInteger(o);
+        p = (unsigned char *)&i;
+        n = sizeof(Gua_Integer);
+    } else if (Gua_PObjectType(o) == OBJECT_TYPE_STRING) {
+        p = (unsigned char *)Gua_PObjectToString(o);
+        n = Gua_PObjectLength(o);
+    } else {
+        /* Adding 0.0 turns -0.0, which equals 0.0, into 0.0. */
+        memset(v, 0, sizeof(v));
+        v[0] = Gua_PObjectToReal(o) + 0.0;
+        if (Gua_PObjectType(o) == OBJECT_TYPE_COMPLEX) {
+            v[1] = Gua_PObjectToImaginary(o) + 0.0;
+        }
+        p = (unsigned char *)v;
+        n = sizeof(v);
+    }
+    
+    for (k = 0; k < n; k++) {
+        hash = (hash ^ p[k]) * 16777619UL;
+    }
+    
+    return hash;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Short Array_IsEqual(Gua_Object *o1, Gua_Object *o2)
+ *
+ * Description:
+ *     Compare two array elements.
+ *
+ * Arguments:
+ *     o1,    an element object;
+ *     o2,    an element object.
+ *
+ * Results:
+ *     The function returns true if the elements have the same type and value.
+ */
+Gua_Short Array_IsEqual(Gua_Object *o1, Gua_Object *o2)
+{
+    if (Gua_PObjectType(o1) != Gua_PObjectType(o2)) {
+        return false;
+    }
+    
+    if (Gua_PObjectType(o1) == OBJECT_TYPE_INTEGER) {
+        return Gua_PObjectToInteger(o1) == Gua_PObjectToInteger(o2);
+    } else if (Gua_PObjectType(o1) == OBJECT_TYPE_REAL) {
+        return Gua_PObjectToReal(o1) == Gua_PObjectToReal(o2);
+    } else if (Gua_PObjectType(o1) == OBJECT_TYPE_COMPLEX) {
+        return (Gua_PObjectToReal(o1) == Gua_PObjectToReal(o2)) && (Gua_PObjectToImaginary(o1) == Gua_PObjectToImaginary(o2));
+    } else if (Gua_PObjectType(o1) == OBJECT_TYPE_STRING) {
+        if (Gua_PObjectLength(o1) == Gua_PObjectLength(o2)) {
+            return memcmp(Gua_PObjectToString(o1), Gua_PObjectToString(o2), Gua_PObjectLength(o1)) == 0;
+        }
+    }
+    
+    return false;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Array_NewHashSet(Array_HashSet *set, Gua_Length n)
+ *
+ * Description:
+ *     Create an empty hash set.
+ *
+ * Arguments:
+ *     set,    the hash set;
+ *     n,      the largest number of elements the set will hold.
+ *
+ * Results:
+ *     The set has at least twice as many slots as elements, so it never
+ *     needs to grow.
+ */
+void Array_NewHashSet(Array_HashSet *set, Gua_Length n)
+{
+    set->size = ARRAY_HASH_SET_SIZE;
+    while (set->size < 2 * n) {
+        set->size = 2 * set->size;
+    }
+    
+    set->slot = (Gua_Object **)Gua_Alloc(set->size * sizeof(Gua_Object *));
+    memset(set->slot, 0, set->size * sizeof(Gua_Object *));
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Array_FreeHashSet(Array_HashSet *set)
+ *
+ * Description:
+ *     Free a hash set. The elements belong to their arrays and are not freed.
+ *
+ * Arguments:
+ *     set,    the hash set.
+ *
+ * Results:
+ *     The function frees the slots of the set.
+ */
+void Array_FreeHashSet(Array_HashSet *set)
+{
+    Gua_Free(set->slot);
+    set->slot = NULL;
+    set->size = 0;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Short Array_HashSetFind(Array_HashSet *set, Gua_Object *o, Gua_Short insert)
+ *
+ * Description:
+ *     Look up an element in a hash set with linear probing.
+ *
+ * Arguments:
+ *     set,       the hash set;
+ *     o,         a hashable element object;
+ *     insert,    true to add the element if it is not in the set.
+ *
+ * Results:
+ *     The function returns true if the set already held an equal element.
+ */
+Gua_Short Array_HashSetFind(Array_HashSet *set, Gua_Object *o, Gua_Short insert)
+{
+    Gua_Length i;
+    
+    i = Array_Hash(o) & (set->size - 1);
+    
+    while (set->slot[i] != NULL) {
+        if (Array_IsEqual(set->slot[i], o)) {
+            return true;
+        }
+        i = (i + 1) & (set->size - 1);
+    }
+    
+    if (insert) {
+        set->slot[i] = o;
+    }
+    
+    return false;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Element *Array_AppendElement(Gua_Object *c, Gua_Element *previous, Gua_Integer newKey, Gua_Object *o)
+ *
+ * Description:
+ *     Append a copy of an element to an array.
+ *
+ * Arguments:
+ *     c,           the target array;
+ *     previous,    the last element of the target array, or NULL;
+ *     newKey,      the key of the new element;
+ *     o,           the element object.
+ *
+ * Results:
+ *     The function returns the new element.
+ */
+Gua_Element *Array_AppendElement(Gua_Object *c, Gua_Element *previous, Gua_Integer newKey, Gua_Object *o)
+{
+    Gua_Element *newElement;
+    
+    /* Create a new element. */
+    newElement = (Gua_Element *)Gua_Alloc(sizeof(Gua_Element));
+    
+    Gua_ClearObject(newElement->key);
+    Gua_ClearObject(newElement->object);
+    
+    /* The element key. */
+    Gua_IntegerToObject(newElement->key, newKey);
+    /* The element object. */
+    if (Gua_PObjectType(o) == OBJECT_TYPE_STRING) {
+        Gua_ByteArrayToObject(newElement->object, Gua_PObjectToString(o), Gua_PObjectLength(o));
+    } else if (Gua_PObjectType(o) == OBJECT_TYPE_FILE) {
+        Gua_CopyFile(&(newElement->object), o, false);
+    } else if (Gua_PObjectType(o) == OBJECT_TYPE_HANDLE) {
+        Gua_CopyHandle(&(newElement->object), o, false);
+    } else {
+        Gua_LinkObjects(newElement->object, *o);
+    }
+    
+    if (previous) {
+        /* Set the target array chain. */
+        newElement->previous = (struct Gua_Element *)previous;
+        newElement->next = NULL;
+        previous->next = (struct Gua_Element *)newElement;
+    } else {
+        newElement->previous = NULL;
+        newElement->next = NULL;
+        
+        /* Link the first element. */
+        Gua_ArrayToPObject(c, (struct Gua_Element *)newElement, 1);
+    }
+    
+    return newElement;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Array_Contains(Gua_Object *a, Gua_Object *value, Gua_Object *object, Gua_String error)
+ *
+ * Description:
+ *     Check if an associative array contains a value, or each of the
+ *     values of another array.
+ *
+ * Arguments:
+ *     a,         an associative array;
+ *     value,     the value, or an associative array of values;
+ *     object,    1 if the value was found and 0 if not, or an array with
+ *                the result for each of the values;
+ *     error,     a pointer to the error message.
+ *
+ * Results:
+ *     An array of values is looked up in a hash set of the elements of a,
+ *     in time proportional to the sizes of both arrays.
+ */
+Gua_Status Array_Contains(Gua_Object *a, Gua_Object *value, Gua_Object *object, Gua_String error)
+{
+    Array_HashSet set;
+    Gua_Element *e;
+    Gua_Element *previous;
+    Gua_Object found;
+    Gua_Integer newKey;
+    Gua_String errMessage;
+    
+    if (Gua_PObjectType(a) != OBJECT_TYPE_ARRAY) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s\n", "illegal argument 1");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    if (Gua_PObjectType(value) != OBJECT_TYPE_ARRAY) {
+        Gua_IntegerToPObject(object, 0);
+        
+        if (Array_IsHashable(value)) {
+            for (e = (Gua_Element *)Gua_PObjectToArray(a); e != NULL; e = (Gua_Element *)e->next) {
+                if (Array_IsEqual(&(e->object), value)) {
+                    Gua_IntegerToPObject(object, 1);
+                    break;
+                }
+            }
+        }
+        
+        return GUA_OK;
+    }
+    
+    Array_NewHashSet(&set, Gua_PObjectLength(a));
+    
+    for (e = (Gua_Element *)Gua_PObjectToArray(a); e != NULL; e = (Gua_Element *)e->next) {
+        if (Array_IsHashable(&(e->object))) {
+            Array_HashSetFind(&set, &(e->object), true);
+        }
+    }
+    
+    Gua_FreeObject(object);
+    
+    previous = NULL;
+    newKey = 0;
+    
+    for (e = (Gua_Element *)Gua_PObjectToArray(value); e != NULL; e = (Gua_Element *)e->next) {
+        if (Array_IsHashable(&(e->object)) && Array_HashSetFind(&set, &(e->object), false)) {
+            Gua_IntegerToObject(found, 1);
+        } else {
+            Gua_IntegerToObject(found, 0);
+        }
+        
+        previous = Array_AppendElement(object, previous, newKey, &found);
+        newKey++;
+    }
+    
+    /* Update the array length entry. */
+    Gua_SetPObjectLength(object, newKey);
+    
+    Array_FreeHashSet(&set);
+    
+    return GUA_OK;
+}
+
 /**
  * Group:
  *     C
@@ -56,19 +413,47 @@
  */
 Gua_Status Array_Intersection(Gua_Object *a, Gua_Object *b, Gua_Object *c, Gua_String error)
 {
-    Gua_Element *e1;
-    Gua_Element *e2;
-    Gua_Object o1;
-    Gua_Object o2;
-    Gua_Integer newKey;
-    Gua_Object newObject;
+    return Array_SetOperation(a, b, ARRAY_SET_INTERSECTION, c, error);
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Array_SetOperation(Gua_Object *a, Gua_Object *b, Gua_Short operation, Gua_Object *c, Gua_String error)
+ *
+ * Description:
+ *     Get the union, intersection or difference of two associative arrays,
+ *     or the unique elements of one, using hash sets of the elements.
+ *
+ * Arguments:
+ *     a,            an associative array;
+ *     b,            an associative array, or NULL for ARRAY_SET_UNIQUE;
+ *     operation,    ARRAY_SET_UNION, ARRAY_SET_INTERSECTION,
+ *                   ARRAY_SET_DIFFERENCE or ARRAY_SET_UNIQUE;
+ *     c,            the resulting associative array;
+ *     error,        a pointer to the error message.
+ *
+ * Results:
+ *     The function returns an associative array c with integer keys from 0
+ *     holding each element once, in order of first occurrence in a and then
+ *     in b, in time proportional to the sizes of the arrays. Elements are
+ *     equal if they have the same type and value; files and handles are
+ *     never equal to anything.
+ */
+Gua_Status Array_SetOperation(Gua_Object *a, Gua_Object *b, Gua_Short operation, Gua_Object *c, Gua_String error)
+{
+    Array_HashSet seen;
+    Array_HashSet other;
+    Gua_Element *e;
     Gua_Element *previous;
-    Gua_Element *newElement;
-    Gua_Short isEqual;
+    Gua_Integer newKey;
+    Gua_Short hashable;
+    Gua_Short keep;
     Gua_String errMessage;
     
     previous = NULL;
-    newElement = NULL;
     newKey = 0;
     
     if (Gua_PObjectType(a) != OBJECT_TYPE_ARRAY) {
@@ -79,7 +464,7 @@ Gua_Status Array_Intersection(Gua_Object *a, Gua_Object *b, Gua_Object *c, Gua_S
         
         return GUA_ERROR;
     }
-    if (Gua_PObjectType(b) != OBJECT_TYPE_ARRAY) {
+    if ((operation != ARRAY_SET_UNIQUE) && (Gua_PObjectType(b) != OBJECT_TYPE_ARRAY)) {
         errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
         sprintf(errMessage, "%s\n", "illegal argument 2");
         strcat(error, errMessage);
@@ -88,100 +473,66 @@ Gua_Status Array_Intersection(Gua_Object *a, Gua_Object *b, Gua_Object *c, Gua_S
         return GUA_ERROR;
     }
     
-    e1 = (Gua_Element *)Gua_PObjectToArray(a);
-    e2 = (Gua_Element *)Gua_PObjectToArray(b);
+    Gua_FreeObject(c);
     
-    if ((e1 != NULL) && (e2 != NULL)) {
-        Gua_FreeObject(c);
+    if (operation == ARRAY_SET_UNION) {
+        Array_NewHashSet(&seen, Gua_PObjectLength(a) + Gua_PObjectLength(b));
+    } else {
+        Array_NewHashSet(&seen, Gua_PObjectLength(a));
+    }
+    
+    /* The elements of b to look up for the intersection and the difference. */
+    if ((operation == ARRAY_SET_INTERSECTION) || (operation == ARRAY_SET_DIFFERENCE)) {
+        Array_NewHashSet(&other, Gua_PObjectLength(b));
         
-        while (true) {
-            o1 = e1->object;
-            
-            while (true) {
-                o2 = e2->object;
-                isEqual = false;
-                
-                if (Gua_ObjectType(o1) == Gua_ObjectType(o2)) {
-                    Gua_ClearObject(newObject);
-                    
-                    if (Gua_ObjectType(o1) == OBJECT_TYPE_INTEGER) {
-                        if (Gua_ObjectToInteger(o1) == Gua_ObjectToInteger(o2)) {
-                            Gua_IntegerToObject(newObject, Gua_ObjectToInteger(o1));
-                            isEqual = true;
-                        }
-                    }
-                    if (Gua_ObjectType(o1) == OBJECT_TYPE_REAL) {
-                        if (Gua_ObjectToReal(o1) == Gua_ObjectToReal(o2)) {
-                            Gua_RealToObject(newObject, Gua_ObjectToReal(o1));
-                            isEqual = true;
-                        }
-                    }
-                    if (Gua_ObjectType(o1) == OBJECT_TYPE_COMPLEX) {
-                        if ((Gua_ObjectToReal(o1) == Gua_ObjectToReal(o2)) && (Gua_ObjectToImaginary(o1) == Gua_ObjectToImaginary(o2))) {
-                            Gua_ComplexToObject(newObject, Gua_ObjectToReal(o1), Gua_ObjectToImaginary(o1));
-                            isEqual = true;
-                        }
-                    }
-                    if (Gua_ObjectType(o1) == OBJECT_TYPE_STRING) {
-                        if (Gua_ObjectLength(o1) == Gua_ObjectLength(o2)) {
-                            if (Gua_ObjectLength(o1) == Gua_ObjectLength(o2)) {
-                                if (memcmp(Gua_ObjectToString(o1), Gua_ObjectToString(o2), Gua_ObjectLength(o1)) == 0) {
-                                    Gua_ByteArrayToObject(newObject, Gua_ObjectToString(o1), Gua_ObjectLength(o1));
-                                    isEqual = true;
-                                }
-                            }
-                        }
-                    }
-                    
-                    if (isEqual) {
-                        /* Create a new element. */
-                        newElement = (Gua_Element *)Gua_Alloc(sizeof(Gua_Element));
-                        /* The element key. */
-                        Gua_IntegerToObject(newElement->key, newKey);
-                        /* The element object. */
-                        Gua_LinkObjects(newElement->object, newObject);
-                        
-                        if (previous) {
-                            /* Set the target array chain. */
-                            newElement->previous = (struct Gua_Element *)previous;
-                            newElement->next = NULL;
-                            previous->next = (struct Gua_Element *)newElement;
-                        } else {
-                            newElement->previous = NULL;
-                            newElement->next = NULL;
-                            
-                            /* Link the first element. */
-                            Gua_ArrayToPObject(c, (struct Gua_Element *)newElement, 1);
-                        }
-                        
-                        previous = newElement;
-                        
-                        newKey++;
-                    }
-                }
-                
-                if (e2->next) {
-                    e2 = (Gua_Element *)e2->next;
-                } else {            
-                    e2 = (Gua_Element *)Gua_PObjectToArray(b);
-                    break;
-                }
-            }
-            
-            if (e1->next) {
-                e1 = (Gua_Element *)e1->next;
-            } else {
-                break;
+        for (e = (Gua_Element *)Gua_PObjectToArray(b); e != NULL; e = (Gua_Element *)e->next) {
+            if (Array_IsHashable(&(e->object))) {
+                Array_HashSetFind(&other, &(e->object), true);
             }
         }
+    }
+    
+    for (e = (Gua_Element *)Gua_PObjectToArray(a); e != NULL; e = (Gua_Element *)e->next) {
+        hashable = Array_IsHashable(&(e->object));
         
-        /* Update the array length entry. */
-        Gua_SetPObjectLength(c, newKey);
+        if (hashable && Array_HashSetFind(&seen, &(e->object), true)) {
+            continue;
+        }
         
-        return GUA_OK;
+        if (operation == ARRAY_SET_INTERSECTION) {
+            keep = hashable && Array_HashSetFind(&other, &(e->object), false);
+        } else if (operation == ARRAY_SET_DIFFERENCE) {
+            keep = !hashable || !Array_HashSetFind(&other, &(e->object), false);
+        } else {
+            keep = true;
+        }
+        
+        if (keep) {
+            previous = Array_AppendElement(c, previous, newKey, &(e->object));
+            newKey++;
+        }
     }
     
-    return GUA_ERROR;
+    if (operation == ARRAY_SET_UNION) {
+        for (e = (Gua_Element *)Gua_PObjectToArray(b); e != NULL; e = (Gua_Element *)e->next) {
+            if (Array_IsHashable(&(e->object)) && Array_HashSetFind(&seen, &(e->object), true)) {
+                continue;
+            }
+            
+            previous = Array_AppendElement(c, previous, newKey, &(e->object));
+            newKey++;
+        }
+    }
+    
+    if ((operation == ARRAY_SET_INTERSECTION) || (operation == ARRAY_SET_DIFFERENCE)) {
+        Array_FreeHashSet(&other);
+    }
+    Array_FreeHashSet(&seen);
+    
+    /* Update the array length entry. */
+    Gua_SetPObjectLength(c, newKey);
+    
+    return GUA_OK;
 }
 
 /**
@@ -386,6 +737,90 @@ Gua_Status Array_ArrayFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object *
         return GUA_ERROR;
     }
     
+    /**
+     * Group:
+     *     Scripting
+     *
+     * Function:
+     *     contains(array, value)
+     *
+     * Description:
+     *     Returns 1 if the array contains the given value and 0 if not. If the value
+     *     is an array, returns an array with the result for each of its elements.
+     *
+     * Examples:
+     *     a={1,2,"hello"}
+     *     c=contains(a,"hello") # Return 1.
+     *     c=contains(a,{2,5}) # Return {1,0}.
+     */
+    if (strcmp(Gua_ObjectToString(argv[0]), "contains") == 0) {
+        if (argc != 3) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_ARRAY) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Array_Contains(&argv[1], &argv[2], object, error) != GUA_OK) {
+            return GUA_ERROR;
+        }
+    /**
+     * Group:
+     *     Scripting
+     *
+     * Function:
+     *     difference(array1, array2)
+     *
+     * Description:
+     *     Returns a new array containing the elements of the first array that are
+     *     not in the second one, each once, in order of first occurrence.
+     *
+     * Examples:
+     *     a={1,2,3,4,3}
+     *     b={3,4,5,6}
+     *     c=difference(a,b) # Return {1,2}.
+     */
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "difference") == 0) {
+        if (argc != 3) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_ARRAY) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (Gua_ObjectType(argv[2]) != OBJECT_TYPE_ARRAY) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Array_SetOperation(&argv[1], &argv[2], ARRAY_SET_DIFFERENCE, object, error) != GUA_OK) {
+            return GUA_ERROR;
+        }
     /**
      * Group:
      *     Scripting
@@ -394,14 +829,15 @@ Gua_Status Array_ArrayFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object *
      *     intersection(array1, array2)
      *
      * Description:
-     *     Returns a new array containing the intersection of two supplied arrays.
+     *     Returns a new array containing the elements of the first array that are
+     *     also in the second one, each once, in order of first occurrence.
      *
      * Examples:
      *     a={1,2,3,4}
      *     b={3,4,5,6}
      *     c=intersection(a,b) # Return {3,4}.
      */
-    if (strcmp(Gua_ObjectToString(argv[0]), "intersection") == 0) {
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "intersection") == 0) {
         if (argc != 3) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
             sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
@@ -576,6 +1012,89 @@ Gua_Status Array_ArrayFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object *
                 return GUA_ERROR;
             }
         }
+    /**
+     * Group:
+     *     Scripting
+     *
+     * Function:
+     *     union(array1, array2)
+     *
+     * Description:
+     *     Returns a new array containing the elements of both arrays, each once, in
+     *     order of first occurrence.
+     *
+     * Examples:
+     *     a={1,2,3,4}
+     *     b={3,4,5,6}
+     *     c=union(a,b) # Return {1,2,3,4,5,6}.
+     */
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "union") == 0) {
+        if (argc != 3) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_ARRAY) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (Gua_ObjectType(argv[2]) != OBJECT_TYPE_ARRAY) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Array_SetOperation(&argv[1], &argv[2], ARRAY_SET_UNION, object, error) != GUA_OK) {
+            return GUA_ERROR;
+        }
+    /**
+     * Group:
+     *     Scripting
+     *
+     * Function:
+     *     unique(array)
+     *
+     * Description:
+     *     Returns a new array containing the elements of the array, each once, in
+     *     order of first occurrence.
+     *
+     * Examples:
+     *     a={3,1,3,2,1}
+     *     c=unique(a) # Return {3,1,2}.
+     */
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "unique") == 0) {
+        if (argc != 2) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_ARRAY) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Array_SetOperation(&argv[1], NULL, ARRAY_SET_UNIQUE, object, error) != GUA_OK) {
+            return GUA_ERROR;
+        }
     }
     
     return GUA_OK;
@@ -608,6 +1127,18 @@ Gua_Status Array_Init(void *nspace, int argc, char *argv[], char **env, Gua_Stri
     Gua_String errMessage;
     
     Gua_LinkCFunctionToFunction(function, Array_ArrayFunctionWrapper);
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "contains", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "contains");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "difference", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "difference");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
     if (Gua_SetFunction((Gua_Namespace *)nspace, "intersection", &function) != GUA_OK) {
         errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
         sprintf(errMessage, "%s %-.20s...\n", "can't set function", "intersection");
@@ -626,6 +1157,18 @@ Gua_Status Array_Init(void *nspace, int argc, char *argv[], char **env, Gua_Stri
         strcat(error, errMessage);
         Gua_Free(errMessage);
     }
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "union", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "union");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "unique", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "unique");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
     
     /**
      * Group:
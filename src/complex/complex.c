@@ -34,6 +34,190 @@
 #include "interp.h"
 #include "complex.h"
 
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Short Complex_ElementwiseFunction(Gua_String name)
+ *
+ * Description:
+ *     Find the code of a complex function that can be applied element by element.
+ *
+ * Arguments:
+ *     name,      the function name.
+ *
+ * Results:
+ *     The function code, or COMPLEX_FUNCTION_NONE.
+ */
+Gua_Short Complex_ElementwiseFunction(Gua_String name)
+{
+    if (strcmp(name, "abs") == 0) {
+        return COMPLEX_FUNCTION_ABS;
+    } else if (strcmp(name, "arg") == 0) {
+        return COMPLEX_FUNCTION_ARG;
+    } else if (strcmp(name, "conj") == 0) {
+        return COMPLEX_FUNCTION_CONJ;
+    } else if (strcmp(name, "imag") == 0) {
+        return COMPLEX_FUNCTION_IMAG;
+    } else if (strcmp(name, "real") == 0) {
+        return COMPLEX_FUNCTION_REAL;
+    }
+    
+    return COMPLEX_FUNCTION_NONE;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Complex_ApplyComplexBuffer(Gua_Short function, Gua_Real *re, Gua_Real *im, Gua_Real *r, Gua_Length n)
+ *
+ * Description:
+ *     Apply a real valued complex function to every element of a buffer of
+ *     complex numbers, stored as separate planes of real and imaginary parts.
+ *     Each function has its own loop, so the compiler can unroll and
+ *     vectorize it.
+ *
+ * Arguments:
+ *     function,  the function code;
+ *     re,        the real parts of the arguments;
+ *     im,        the imaginary parts of the arguments;
+ *     r,         the results;
+ *     n,         the number of elements.
+ *
+ * Results:
+ *     The function stores the results in r.
+ */
+void Complex_ApplyComplexBuffer(Gua_Short function, Gua_Real *re, Gua_Real *im, Gua_Real *r, Gua_Length n)
+{
+    Gua_Length i;
+    
+    switch (function) {
+        case COMPLEX_FUNCTION_ABS:
+            for (i = 0; i < n; i++) r[i] = sqrt(re[i] * re[i] + im[i] * im[i]);
+            break;
+        case COMPLEX_FUNCTION_ARG:
+            for (i = 0; i < n; i++) r[i] = atan2(im[i], re[i]);
+            break;
+        case COMPLEX_FUNCTION_IMAG:
+            for (i = 0; i < n; i++) r[i] = im[i];
+            break;
+        case COMPLEX_FUNCTION_REAL:
+            for (i = 0; i < n; i++) r[i] = re[i];
+            break;
+    }
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Complex_ApplyToMatrix(void *nspace, Gua_Short argc, Gua_Object *argv, Gua_Object *object, Gua_String error)
+ *
+ * Description:
+ *     Apply a complex function to every element of a numeric matrix. For
+ *     abs, arg, imag and real the elements are packed into planes of real
+ *     and imaginary parts, where integer and real elements have a zero
+ *     imaginary part, and computed in one pass. The conj function negates
+ *     the imaginary part of the complex elements of a copy of the matrix.
+ *
+ * Arguments:
+ *     nspace,    a pointer to a structure Gua_Namespace. Must do a cast before use it;
+ *     argc,      the number of arguments to pass to the function;
+ *     argv,      an array containing the arguments to the function;
+ *                argv[0] is the function name;
+ *     object,    a structure containing the return value of the function;
+ *     error,     a pointer to the error message.
+ *
+ * Results:
+ *     A matrix with the same dimensions as the argument.
+ */
+Gua_Status Complex_ApplyToMatrix(void *nspace, Gua_Short argc, Gua_Object *argv, Gua_Object *object, Gua_String error)
+{
+    Gua_Matrix *m1;
+    Gua_Matrix *m2;
+    Gua_Object *o1;
+    Gua_Object *o2;
+    Gua_Real *buffer;
+    Gua_Real *re;
+    Gua_Real *im;
+    Gua_Real *r;
+    Gua_Length length;
+    Gua_Length i;
+    Gua_Short function;
+    Gua_Short type;
+    Gua_String errMessage;
+    
+    function = Complex_ElementwiseFunction(Gua_ObjectToString(argv[0]));
+    
+    if (argc != 2) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    m1 = (Gua_Matrix *)Gua_ObjectToMatrix(argv[1]);
+    length = Gua_ObjectLength(argv[1]);
+    
+    type = m1 ? Gua_GetMatrixType((Gua_Object *)m1->object, length) : OBJECT_TYPE_UNKNOWN;
+    
+    if (type == OBJECT_TYPE_UNKNOWN) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    if (function == COMPLEX_FUNCTION_CONJ) {
+        if (Gua_CopyMatrix(object, &argv[1], false) != GUA_OK) {
+            return GUA_ERROR;
+        }
+        
+        o2 = (Gua_Object *)((Gua_Matrix *)Gua_PObjectToMatrix(object))->object;
+        
+        for (i = 0; i < length; i++) {
+            if (Gua_ObjectType(o2[i]) == OBJECT_TYPE_COMPLEX) {
+                Gua_ComplexToObject(o2[i], Gua_ObjectToReal(o2[i]), -Gua_ObjectToImaginary(o2[i]));
+            }
+        }
+        
+        return GUA_OK;
+    }
+    
+    o1 = (Gua_Object *)m1->object;
+    
+    Gua_MatrixToPObject(object, (struct Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix)), length);
+    m2 = (Gua_Matrix *)Gua_PObjectToMatrix(object);
+    m2->dimc = m1->dimc;
+    m2->dimv = (Gua_Length *)Gua_Alloc(m1->dimc * sizeof(Gua_Length));
+    memcpy(m2->dimv, m1->dimv, m1->dimc * sizeof(Gua_Length));
+    m2->object = (struct Gua_Object *)Gua_Alloc(length * sizeof(Gua_Object));
+    o2 = (Gua_Object *)m2->object;
+    
+    buffer = (Gua_Real *)Gua_Alloc(3 * length * sizeof(Gua_Real));
+    re = buffer;
+    im = re + length;
+    r = im + length;
+    
+    Gua_PackMatrix(o1, length, re, im);
+    
+    Complex_ApplyComplexBuffer(function, re, im, r, length);
+    
+    Gua_UnpackMatrix(o2, length, r, NULL);
+    
+    Gua_Free(buffer);
+    
+    return GUA_OK;
+}
+
 /**
  * Group:
  *     C
@@ -70,6 +254,11 @@ Gua_Status Complex_ComplexFunctionWrapper(void *nspace, Gua_Short argc, Gua_Obje
         return GUA_ERROR;
     }
     
+    /* Matrix arguments are mapped element by element. */
+    if ((argc > 1) && (Gua_ObjectType(argv[1]) == OBJECT_TYPE_MATRIX) && (Complex_ElementwiseFunction(Gua_ObjectToString(argv[0])) != COMPLEX_FUNCTION_NONE)) {
+        return Complex_ApplyToMatrix(nspace, argc, argv, object, error);
+    }
+    
     /**
      * Group:
      *     Scripting
@@ -78,7 +267,8 @@ Gua_Status Complex_ComplexFunctionWrapper(void *nspace, Gua_Short argc, Gua_Obje
      *     abs(value)
      *
      * Description:
-     *     Returns the modulus of a complex number.
+     *     Returns the modulus of a complex number. Applied to a matrix,
+     *     returns the modulus of each element.
      */
     if (strcmp(Gua_ObjectToString(argv[0]), "abs") == 0) {
         if (argc != 2) {
@@ -108,7 +298,8 @@ Gua_Status Complex_ComplexFunctionWrapper(void *nspace, Gua_Short argc, Gua_Obje
      *     arg(value)
      *
      * Description:
-     *     Returns the argument of a complex number.
+     *     Returns the argument of a complex number, in the range
+     *     [-pi, pi]. Applied to a matrix, returns the argument of each element.
      */
     } else if (strcmp(Gua_ObjectToString(argv[0]), "arg") == 0) {
         if (argc != 2) {
@@ -129,7 +320,7 @@ Gua_Status Complex_ComplexFunctionWrapper(void *nspace, Gua_Short argc, Gua_Obje
             return GUA_ERROR;
         }
         
-        Gua_RealToPObject(object, (asin(Gua_ObjectToImaginary(argv[1]) / (sqrt(Gua_ObjectToReal(argv[1]) * Gua_ObjectToReal(argv[1]) + Gua_ObjectToImaginary(argv[1]) * Gua_ObjectToImaginary(argv[1]))))));
+        Gua_RealToPObject(object, atan2(Gua_ObjectToImaginary(argv[1]), Gua_ObjectToReal(argv[1])));
     /**
      * Group:
      *     Scripting
@@ -138,7 +329,8 @@ Gua_Status Complex_ComplexFunctionWrapper(void *nspace, Gua_Short argc, Gua_Obje
      *     conj(value)
      *
      * Description:
-     *     Returns the complex conjugate number.
+     *     Returns the complex conjugate number. Applied to a matrix,
+     *     returns the conjugate of each element.
      */
     } else if (strcmp(Gua_ObjectToString(argv[0]), "conj") == 0) {
         if (argc != 2) {
@@ -168,7 +360,8 @@ Gua_Status Complex_ComplexFunctionWrapper(void *nspace, Gua_Short argc, Gua_Obje
      *     imag(value)
      *
      * Description:
-     *     Returns the imaginary part of a complex number.
+     *     Returns the imaginary part of a complex number. Applied to
+     *     a matrix, returns the imaginary part of each element.
      *
      * Examples:
      *     a=1.0+2.0*i
@@ -202,7 +395,8 @@ Gua_Status Complex_ComplexFunctionWrapper(void *nspace, Gua_Short argc, Gua_Obje
      *     real(value)
      *
      * Description:
-     *     Returns the real part of a complex number.
+     *     Returns the real part of a complex number. Applied to a
+     *     matrix, returns the real part of each element.
      *
      * Examples:
      *     a=1.0+2.0*i
@@ -21,8 +21,8 @@
  *         GUA_ARRAY, GUA_MATRIX, GUA_HANDLE, GUA_NAMESPACE, TRUE, FALSE, NULL, i, argc, argv, env
  *
  *     functions:
- *         array, arrayToString, complex, dim, error, eval, exists, expr, ident, inv, keys, length, matrix,
- *         matrix2D, matrixToString, toString, type and user defined functions
+ *         array, arrayToString, complex, dim, error, eval, evalCacheSize, evalCacheStats, exists, expr,
+ *         ident, inv, keys, length, matrix, matrix2D, matrixToString, toString, type and user defined functions
  *
  *     variables:
  *         automatic(integer, real, complex, string, array, matrix, handle, namespace)
@@ -60,6 +60,7 @@
 
 #include <ctype.h>
 #include <errno.h>
+#include <limits.h>
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
@@ -151,6 +152,16 @@ static Gua_Variable Gua_ConstantTable[] = {
     {"", {OBJECT_TYPE_UNKNOWN, 0, 0.0, 0.0, NULL, NULL, NULL, NULL, NULL, NULL, 0, true}, NULL, NULL}
 };
 
+/* Compiled code cache, used by the eval and expr functions. */
+static Gua_CodeEntry *Gua_CodeCacheTable[GUA_CODE_CACHE_HASH_SIZE];
+static Gua_CodeEntry *Gua_CodeCacheFirst = NULL;
+static Gua_CodeEntry *Gua_CodeCacheLast = NULL;
+static Gua_CodeEntry *Gua_ActiveCode = NULL;
+static Gua_Integer Gua_CodeCacheSize = GUA_CODE_CACHE_SIZE;
+static Gua_Integer Gua_CodeCacheEntries = 0;
+static Gua_Integer Gua_CodeCacheHits = 0;
+static Gua_Integer Gua_CodeCacheMisses = 0;
+
 /**
  * Group:
  *     C
@@ -215,10 +226,11 @@ Gua_String Gua_ScanNumber(Gua_String start, Gua_Token *token)
         }
     } else {
         token->real = strtod(start, NULL);
+        /* Subnormal numbers also set ERANGE, but they are exact enough. */
         if (errno == ERANGE) {
             if (token->real == 0.0) {
                 token->status = GUA_ERROR_UNDERFLOW;
-            } else {
+            } else if (isinf(token->real)) {
                 token->status = GUA_ERROR_OVERFLOW;
             }
         }
@@ -409,9 +421,6 @@ Gua_String Gua_ScanIdentifier(Gua_Namespace *nspace, Gua_String start, Gua_Token
 {
     Gua_String p;
     Gua_String name;
-    Gua_Object object;
-    Gua_Function function;
-    Gua_Integer i;
     
     /* The default token object is: TOKEN_TYPE_UNKNOWN; GUA_ERROR_UNEXPECTED_TOKEN. */
     Gua_ClearPToken(token);
@@ -507,11 +516,42 @@ Gua_String Gua_ScanIdentifier(Gua_Namespace *nspace, Gua_String start, Gua_Token
         return p;
     }
     
+    Gua_ClassifyIdentifier(nspace, name, token);
+    
+    Gua_Free(name);
+    
+    return p;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Gua_ClassifyIdentifier(Gua_Namespace *nspace, Gua_String name, Gua_Token *token)
+ *
+ * Description:
+ *     Check if an identifier, that is not a reserved word, names a variable,
+ *     a constant or a function.
+ *
+ * Arguments:
+ *     nspace,    a pointer to a structure containing the variable and function namespace;
+ *     name,      the identifier;
+ *     token,     a structure containing the token found in the expression.
+ *
+ * Results:
+ *     The function sets the token type and status.
+ */
+void Gua_ClassifyIdentifier(Gua_Namespace *nspace, Gua_String name, Gua_Token *token)
+{
+    Gua_Object object;
+    Gua_Function function;
+    Gua_Integer i;
+    
     if (Gua_SearchVariable(nspace, name, &object, SCOPE_STACK) != OBJECT_TYPE_UNKNOWN) {
         token->type = TOKEN_TYPE_VARIABLE;
         token->status = GUA_OK;
-        Gua_Free(name);
-        return p;
+        return;
     }
     
     i = 0;
@@ -520,8 +560,7 @@ Gua_String Gua_ScanIdentifier(Gua_Namespace *nspace, Gua_String start, Gua_Token
         if (strcmp(Gua_ConstantTable[i].name, name) == 0) {
             token->type = TOKEN_TYPE_VARIABLE;
             token->status = GUA_OK;
-            Gua_Free(name);
-            return p;
+            return;
         }
         i++;
     }
@@ -529,13 +568,11 @@ Gua_String Gua_ScanIdentifier(Gua_Namespace *nspace, Gua_String start, Gua_Token
     if (Gua_SearchFunction(nspace, name, &function) == GUA_OK) {
         token->type = TOKEN_TYPE_FUNCTION;
         token->status = GUA_OK;
-        Gua_Free(name);
-        return p;
+        return;
     }
     
-    Gua_Free(name);
-    
-    return p;
+    token->type = TOKEN_TYPE_UNKNOWN;
+    token->status = GUA_ERROR_UNEXPECTED_TOKEN;
 }
 
 /**
@@ -997,13 +1034,17 @@ Gua_String Gua_ScanParenthesis(Gua_String start, Gua_Token *token)
  *
  * Results:
  *     The function returns the next start point to search tokens in
- *     the expression.
+ *     the expression. The integer field of the token is true if the
+ *     brackets hold a slice, as in a[r0:r1, c0:c1], so the parser does
+ *     not have to scan the index again.
  */
 Gua_String Gua_ScanBracket(Gua_String start, Gua_Token *token)
 {
     Gua_String p;
     Gua_Short opened;
     Gua_Short closed;
+    Gua_Short nested;
+    Gua_Short slice;
     
     /* The default token object is: TOKEN_TYPE_UNKNOWN; GUA_ERROR_UNEXPECTED_TOKEN. */
     Gua_ClearPToken(token);
@@ -1029,6 +1070,9 @@ Gua_String Gua_ScanBracket(Gua_String start, Gua_Token *token)
     
     token->status = GUA_OK;
     
+    nested = 0;
+    slice = false;
+    
     while ((*p != EXPRESSION_END) && (opened > closed)) {
         if (*p == SINGLE_QUOTE) {
             p = Gua_ScanSingleQuotes(p, token);
@@ -1042,6 +1086,15 @@ Gua_String Gua_ScanBracket(Gua_String start, Gua_Token *token)
         if (*p == BRACKET_CLOSE) {
             closed++;
         }
+        if ((*p == PARENTHESIS_OPEN) || (*p == BRACE_OPEN)) {
+            nested++;
+        }
+        if ((*p == PARENTHESIS_CLOSE) || (*p == BRACE_CLOSE)) {
+            nested--;
+        }
+        if ((*p == COLON) && (opened - closed == 1) && (nested == 0)) {
+            slice = true;
+        }
         p++;
     }
     
@@ -1050,6 +1103,7 @@ Gua_String Gua_ScanBracket(Gua_String start, Gua_Token *token)
     }
     
     token->type = TOKEN_TYPE_BRACKET;
+    token->integer = slice;
     
     if (*p == EXPRESSION_END) {
         if (opened > closed) {
@@ -1161,7 +1215,7 @@ Gua_String Gua_ScanBrace(Gua_String start, Gua_Token *token)
  *     C
  *
  * Function:
- *     Gua_String Gua_NextToken(Gua_Namespace *nspace, Gua_String start, Gua_Token *token)
+ *     Gua_String Gua_ScanToken(Gua_Namespace *nspace, Gua_String start, Gua_Token *token)
  *
  * Description:
  *     Get the next token from expr.
@@ -1176,7 +1230,7 @@ Gua_String Gua_ScanBrace(Gua_String start, Gua_Token *token)
  *     The function returns the next start point to search tokens in
  *     the expression.
  */
-Gua_String Gua_NextToken(Gua_Namespace *nspace, Gua_String start, Gua_Token *token)
+Gua_String Gua_ScanToken(Gua_Namespace *nspace, Gua_String start, Gua_Token *token)
 {
     Gua_String p;
     
@@ -1246,6 +1300,114 @@ Gua_String Gua_NextToken(Gua_Namespace *nspace, Gua_String start, Gua_Token *tok
     return p;
 }
 
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_String Gua_NextCodeToken(Gua_Namespace *nspace, Gua_CodeEntry *entry, Gua_String start, Gua_Token *token)
+ *
+ * Description:
+ *     Get the next token of a cached code. Tokens are scanned only once and
+ *     stored in the cache entry. Identifiers are classified again at each
+ *     call, because variables and functions may be created or deleted.
+ *
+ * Arguments:
+ *     nspace,    a pointer to a structure containing the variable and function namespace;
+ *     entry,     the cache entry containing the code;
+ *     start,     a pointer to the start point of the expression to parse;
+ *     token,     a structure containing the start and end pointers to the token
+ *                found in the expression, and also the token type.
+ *
+ * Results:
+ *     The function returns the next start point to search tokens in
+ *     the expression.
+ */
+Gua_String Gua_NextCodeToken(Gua_Namespace *nspace, Gua_CodeEntry *entry, Gua_String start, Gua_Token *token)
+{
+    Gua_CodeToken *code;
+    Gua_String p;
+    Gua_Integer offset;
+    Gua_Integer n;
+    
+    offset = (Gua_Integer)(start - entry->code);
+    
+    if (entry->index[offset] > 0) {
+        code = (Gua_CodeToken *)entry->token + (entry->index[offset] - 1);
+        
+        *token = code->token;
+        
+        if (code->name != NULL) {
+            Gua_ClassifyIdentifier(nspace, code->name, token);
+        }
+        
+        return code->next;
+    }
+    
+    p = Gua_ScanToken(nspace, start, token);
+    
+    if (entry->tokenc == entry->size) {
+        n = entry->size == 0 ? 32 : entry->size * 2;
+        entry->token = (struct Gua_CodeToken *)Gua_Realloc(entry->token, sizeof(Gua_CodeToken) * n);
+        entry->size = n;
+    }
+    
+    code = (Gua_CodeToken *)entry->token + entry->tokenc;
+    
+    code->token = *token;
+    code->next = p;
+    code->name = NULL;
+    
+    if ((token->type == TOKEN_TYPE_VARIABLE) || (token->type == TOKEN_TYPE_FUNCTION) || (token->type == TOKEN_TYPE_UNKNOWN)) {
+        while (Gua_IsSpace(*start)) {
+            start++;
+        }
+        if (Gua_IsIdentifier(*start)) {
+            n = (Gua_Integer)(p - start);
+            code->name = (char *)Gua_Alloc(sizeof(char) * (n + 1));
+            strncpy(code->name, start, n);
+            code->name[n] = '\0';
+        }
+    }
+    
+    entry->tokenc++;
+    entry->index[offset] = entry->tokenc;
+    
+    return p;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_String Gua_NextToken(Gua_Namespace *nspace, Gua_String start, Gua_Token *token)
+ *
+ * Description:
+ *     Get the next token in the expression. If the expression belongs
+ *     to the code being evaluated from the code cache, the cached token is used.
+ *
+ * Arguments:
+ *     nspace,    a pointer to a structure containing the variable and function namespace;
+ *     start,     a pointer to the start point of the expression to parse;
+ *     token,     a structure containing the start and end pointers to the token
+ *                found in the expression, and also the token type.
+ *
+ * Results:
+ *     The function returns the next start point to search tokens in
+ *     the expression.
+ */
+Gua_String Gua_NextToken(Gua_Namespace *nspace, Gua_String start, Gua_Token *token)
+{
+    if (Gua_ActiveCode != NULL) {
+        if ((start >= Gua_ActiveCode->code) && (start <= (Gua_ActiveCode->code + Gua_ActiveCode->length))) {
+            return Gua_NextCodeToken(nspace, Gua_ActiveCode, start, token);
+        }
+    }
+    
+    return Gua_ScanToken(nspace, start, token);
+}
+
 /**
  * Group:
  *     C
@@ -3037,77 +3199,713 @@ Gua_Status Gua_GetArrayKeys(Gua_Object *keys, Gua_Object *array)
     return GUA_ERROR;
 }
 
+/* Normalized 64 bits approximations of 10^k, for k = -348, -340, ..., 340. */
+static Gua_DiyFp Gua_CachedPowers[] = {
+    { 0xfa8fd5a0081c0288ULL, -1220 },
+    { 0xbaaee17fa23ebf76ULL, -1193 },
+    { 0x8b16fb203055ac76ULL, -1166 },
+    { 0xcf42894a5dce35eaULL, -1140 },
+    { 0x9a6bb0aa55653b2dULL, -1113 },
+    { 0xe61acf033d1a45dfULL, -1087 },
+    { 0xab70fe17c79ac6caULL, -1060 },
+    { 0xff77b1fcbebcdc4fULL, -1034 },
+    { 0xbe5691ef416bd60cULL, -1007 },
+    { 0x8dd01fad907ffc3cULL,  -980 },
+    { 0xd3515c2831559a83ULL,  -954 },
+    { 0x9d71ac8fada6c9b5ULL,  -927 },
+    { 0xea9c227723ee8bcbULL,  -901 },
+    { 0xaecc49914078536dULL,  -874 },
+    { 0x823c12795db6ce57ULL,  -847 },
+    { 0xc21094364dfb5637ULL,  -821 },
+    { 0x9096ea6f3848984fULL,  -794 },
+    { 0xd77485cb25823ac7ULL,  -768 },
+    { 0xa086cfcd97bf97f4ULL,  -741 },
+    { 0xef340a98172aace5ULL,  -715 },
+    { 0xb23867fb2a35b28eULL,  -688 },
+    { 0x84c8d4dfd2c63f3bULL,  -661 },
+    { 0xc5dd44271ad3cdbaULL,  -635 },
+    { 0x936b9fcebb25c996ULL,  -608 },
+    { 0xdbac6c247d62a584ULL,  -582 },
+    { 0xa3ab66580d5fdaf6ULL,  -555 },
+    { 0xf3e2f893dec3f126ULL,  -529 },
+    { 0xb5b5ada8aaff80b8ULL,  -502 },
+    { 0x87625f056c7c4a8bULL,  -475 },
+    { 0xc9bcff6034c13053ULL,  -449 },
+    { 0x964e858c91ba2655ULL,  -422 },
+    { 0xdff9772470297ebdULL,  -396 },
+    { 0xa6dfbd9fb8e5b88fULL,  -369 },
+    { 0xf8a95fcf88747d94ULL,  -343 },
+    { 0xb94470938fa89bcfULL,  -316 },
+    { 0x8a08f0f8bf0f156bULL,  -289 },
+    { 0xcdb02555653131b6ULL,  -263 },
+    { 0x993fe2c6d07b7facULL,  -236 },
+    { 0xe45c10c42a2b3b06ULL,  -210 },
+    { 0xaa242499697392d3ULL,  -183 },
+    { 0xfd87b5f28300ca0eULL,  -157 },
+    { 0xbce5086492111aebULL,  -130 },
+    { 0x8cbccc096f5088ccULL,  -103 },
+    { 0xd1b71758e219652cULL,   -77 },
+    { 0x9c40000000000000ULL,   -50 },
+    { 0xe8d4a51000000000ULL,   -24 },
+    { 0xad78ebc5ac620000ULL,     3 },
+    { 0x813f3978f8940984ULL,    30 },
+    { 0xc097ce7bc90715b3ULL,    56 },
+    { 0x8f7e32ce7bea5c70ULL,    83 },
+    { 0xd5d238a4abe98068ULL,   109 },
+    { 0x9f4f2726179a2245ULL,   136 },
+    { 0xed63a231d4c4fb27ULL,   162 },
+    { 0xb0de65388cc8ada8ULL,   189 },
+    { 0x83c7088e1aab65dbULL,   216 },
+    { 0xc45d1df942711d9aULL,   242 },
+    { 0x924d692ca61be758ULL,   269 },
+    { 0xda01ee641a708deaULL,   295 },
+    { 0xa26da3999aef774aULL,   322 },
+    { 0xf209787bb47d6b85ULL,   348 },
+    { 0xb454e4a179dd1877ULL,   375 },
+    { 0x865b86925b9bc5c2ULL,   402 },
+    { 0xc83553c5c8965d3dULL,   428 },
+    { 0x952ab45cfa97a0b3ULL,   455 },
+    { 0xde469fbd99a05fe3ULL,   481 },
+    { 0xa59bc234db398c25ULL,   508 },
+    { 0xf6c69a72a3989f5cULL,   534 },
+    { 0xb7dcbf5354e9beceULL,   561 },
+    { 0x88fcf317f22241e2ULL,   588 },
+    { 0xcc20ce9bd35c78a5ULL,   614 },
+    { 0x98165af37b2153dfULL,   641 },
+    { 0xe2a0b5dc971f303aULL,   667 },
+    { 0xa8d9d1535ce3b396ULL,   694 },
+    { 0xfb9b7cd9a4a7443cULL,   720 },
+    { 0xbb764c4ca7a44410ULL,   747 },
+    { 0x8bab8eefb6409c1aULL,   774 },
+    { 0xd01fef10a657842cULL,   800 },
+    { 0x9b10a4e5e9913129ULL,   827 },
+    { 0xe7109bfba19c0c9dULL,   853 },
+    { 0xac2820d9623bf429ULL,   880 },
+    { 0x80444b5e7aa7cf85ULL,   907 },
+    { 0xbf21e44003acdd2dULL,   933 },
+    { 0x8e679c2f5e44ff8fULL,   960 },
+    { 0xd433179d9c8cb841ULL,   986 },
+    { 0x9e19db92b4e31ba9ULL,  1013 },
+    { 0xeb96bf6ebadf77d9ULL,  1039 },
+    { 0xaf87023b9bf0ee6bULL,  1066 }
+};
+
 /**
  * Group:
  *     C
  *
  * Function:
- *     Gua_Status Gua_ArrayToString(Gua_Object *array, Gua_Object *object)
+ *     Gua_DiyFp Gua_MulDiyFp(Gua_DiyFp x, Gua_DiyFp y)
  *
  * Description:
- *     Convert an associative array object to a string object.
+ *     Multiply two extended floating point numbers, keeping the upper 64 bits
+ *     of the product rounded to nearest.
  *
  * Arguments:
- *     array,     a pointer to an associative array;
- *     object,    a pointer to a string object.
+ *     x,    the first operand;
+ *     y,    the second operand.
  *
  * Results:
- *     The function converts an associative array object to a string object.
+ *     The function returns the product.
  */
-Gua_Status Gua_ArrayToString(Gua_Object *array, Gua_Object *object)
+Gua_DiyFp Gua_MulDiyFp(Gua_DiyFp x, Gua_DiyFp y)
 {
-    Gua_Element *element;
-    Gua_String string;
-    Gua_String newString;
-    Gua_String p;
-    Gua_Length length;
-    Gua_Integer i;
-    Gua_Integer j;
+    Gua_DiyFp r;
+    uint64_t a;
+    uint64_t b;
+    uint64_t c;
+    uint64_t d;
+    uint64_t t;
     
-    Gua_ClearPObject(object);
+    a = x.f >> 32;
+    b = x.f & 0xffffffffULL;
+    c = y.f >> 32;
+    d = y.f & 0xffffffffULL;
+    
+    t = ((b * d) >> 32) + ((a * d) & 0xffffffffULL) + ((b * c) & 0xffffffffULL) + (1ULL << 31);
+    
+    r.f = a * c + ((a * d) >> 32) + ((b * c) >> 32) + (t >> 32);
+    r.e = x.e + y.e + 64;
+    
+    return r;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Gua_Grisu2(Gua_Real x, Gua_Char *digits, Gua_Short *length, Gua_Short *k)
+ *
+ * Description:
+ *     Generate the shortest decimal digits that read back as x, using the
+ *     Grisu2 algorithm of Florian Loitsch. The result is digits * 10^k.
+ *     x must be positive and finite.
+ *
+ * Arguments:
+ *     x,         the number to convert;
+ *     digits,    the generated digits, not terminated;
+ *     length,    the number of digits;
+ *     k,         the decimal exponent.
+ *
+ * Results:
+ *     The function writes the digits of x.
+ */
+void Gua_Grisu2(Gua_Real x, Gua_Char *digits, Gua_Short *length, Gua_Short *k)
+{
+    static const uint64_t power[] = {
+        1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL,
+        1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+        100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL,
+        1000000000000000000ULL, 10000000000000000000ULL
+    };
+    Gua_DiyFp v;
+    Gua_DiyFp plus;
+    Gua_DiyFp minus;
+    Gua_DiyFp cached;
+    Gua_DiyFp w;
+    Gua_DiyFp wp;
+    Gua_DiyFp wm;
+    uint64_t u;
+    uint64_t delta;
+    uint64_t one;
+    uint64_t distance;
+    uint64_t p2;
+    uint64_t rest;
+    uint64_t unit;
+    uint32_t p1;
+    uint32_t d;
+    Gua_Real dk;
+    Gua_Integer index;
+    Gua_Short kappa;
+    Gua_Short shift;
+    Gua_Short n;
+    bool found;
+    
+    memcpy(&u, &x, sizeof(u));
+    
+    if ((u & 0x7ff0000000000000ULL) != 0) {
+        v.f = (u & 0x000fffffffffffffULL) + 0x0010000000000000ULL;
+        v.e = (Gua_Short)((u & 0x7ff0000000000000ULL) >> 52) - 1075;
+    } else {
+        v.f = u & 0x000fffffffffffffULL;
+        v.e = -1074;
+    }
+    
+    /* The boundaries m- and m+ halfway to the neighbours of v. */
+    plus.f = (v.f << 1) + 1;
+    plus.e = v.e - 1;
+    while (!(plus.f & (0x0010000000000000ULL << 1))) {
+        plus.f <<= 1;
+        plus.e--;
+    }
+    plus.f <<= 64 - 52 - 2;
+    plus.e = plus.e - (64 - 52 - 2);
+    
+    if (v.f == 0x0010000000000000ULL) {
+        minus.f = (v.f << 2) - 1;
+        minus.e = v.e - 2;
+    } else {
+        minus.f = (v.f << 1) - 1;
+        minus.e = v.e - 1;
+    }
+    minus.f <<= minus.e - plus.e;
+    minus.e = plus.e;
+    
+    while (!(v.f & 0x8000000000000000ULL)) {
+        v.f <<= 1;
+        v.e--;
+    }
+    
+    /* Pick the cached power bringing the exponent to [-60, -32]. */
+    dk = (-61 - plus.e) * 0.30102999566398114 + 347;
+    index = (Gua_Integer)dk;
+    if (dk - index > 0.0) {
+        index++;
+    }
+    index = (index >> 3) + 1;
+    *k = -(-348 + (Gua_Short)index * 8);
+    cached = Gua_CachedPowers[index];
+    
+    w = Gua_MulDiyFp(v, cached);
+    wp = Gua_MulDiyFp(plus, cached);
+    wm = Gua_MulDiyFp(minus, cached);
+    wm.f++;
+    wp.f--;
+    
+    /* Generate the digits of wp until they fall inside the rounding interval. */
+    delta = wp.f - wm.f;
+    distance = wp.f - w.f;
+    shift = -wp.e;
+    one = 1ULL << shift;
+    p1 = (uint32_t)(wp.f >> shift);
+    p2 = wp.f & (one - 1);
+    
+    kappa = 10;
+    while ((kappa > 1) && (p1 < power[kappa - 1])) {
+        kappa--;
+    }
+    
+    n = 0;
+    found = false;
+    while (kappa > 0) {
+        d = p1 / (uint32_t)power[kappa - 1];
+        p1 = p1 % (uint32_t)power[kappa - 1];
+        if (d || n) {
+            digits[n++] = '0' + d;
+        }
+        kappa--;
+        rest = ((uint64_t)p1 << shift) + p2;
+        if (rest <= delta) {
+            *k = *k + kappa;
+            unit = power[kappa] << shift;
+            found = true;
+            break;
+        }
+    }
+    
+    if (!found) {
+        for (;;) {
+            p2 = p2 * 10;
+            delta = delta * 10;
+            d = (uint32_t)(p2 >> shift);
+            if (d || n) {
+                digits[n++] = '0' + d;
+            }
+            p2 = p2 & (one - 1);
+            kappa--;
+            if (p2 < delta) {
+                *k = *k + kappa;
+                rest = p2;
+                unit = one;
+                distance = distance * (-kappa < 20 ? power[-kappa] : 0);
+                break;
+            }
+        }
+    }
+    
+    /* Move the last digit towards w while it stays inside the interval. */
+    while ((rest < distance) && (delta - rest >= unit) && ((rest + unit < distance) || (distance - rest > rest + unit - distance))) {
+        digits[n - 1]--;
+        rest = rest + unit;
+    }
+    
+    *length = n;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_String Gua_FormatInteger(Gua_String p, Gua_Integer n)
+ *
+ * Description:
+ *     Write an integer in decimal notation.
+ *
+ * Arguments:
+ *     p,    the output buffer, at least GUA_NUMBER_SIZE bytes long;
+ *     n,    the number to write.
+ *
+ * Results:
+ *     The function returns a pointer to the terminating null character.
+ */
+Gua_String Gua_FormatInteger(Gua_String p, Gua_Integer n)
+{
+    Gua_Char buffer[GUA_NUMBER_SIZE];
+    Gua_Short i;
+    uint64_t u;
+    
+    if (n < 0) {
+        *p++ = '-';
+        u = -(uint64_t)n;
+    } else {
+        u = n;
+    }
     
-    string = (char *)Gua_Alloc(sizeof(char) * EXPRESSION_SIZE);
-    length = EXPRESSION_SIZE;
     i = 0;
+    do {
+        buffer[i++] = '0' + (u % 10);
+        u = u / 10;
+    } while (u);
     
-    element = (Gua_Element *)Gua_PObjectToArray(array);
+    while (i > 0) {
+        *p++ = buffer[--i];
+    }
+    *p = '\0';
     
-    if (element) {
-        /* Open the brace. */
-        string[i] = '{';
-        i++;
-        
-        /* Fill the string with a representation of the array. */
-        while (true) {
-            if (Gua_ObjectType(element->object) == OBJECT_TYPE_INTEGER) {
-                p = (char *)Gua_Alloc(sizeof(char) * BUFFER_SIZE);
-                sprintf(p, "%ld", Gua_ObjectToInteger(element->object));
-                j = 0;
-                while (p[j]) {
-                    if (i == (length - 1)) {
-                        length = length * 2;
-                        newString = (char *)Gua_Realloc(string, length);
-                        
-                        if (newString == NULL) {
-                            Gua_Free(p);
-                            Gua_Free(string);
-                            return GUA_ERROR;
-                        } else {
-                            string = newString;
-                        }
-                    }
-                    string[i] = p[j];
-                    i++;
-                    j++;
+    return p;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_String Gua_FormatReal(Gua_String p, Gua_Real x, Gua_Short precision)
+ *
+ * Description:
+ *     Write a real number. With precision GUA_SHORTEST_PRECISION the number
+ *     is written with the fewest digits that read back exactly, in fixed
+ *     notation for exponents from -5 to 15 and in scientific notation, as
+ *     with "%g", otherwise. Any other precision is the number of significant
+ *     digits, as with "%.*g".
+ *
+ * Arguments:
+ *     p,            the output buffer, at least GUA_NUMBER_SIZE bytes long;
+ *     x,            the number to write;
+ *     precision,    the number of significant digits.
+ *
+ * Results:
+ *     The function returns a pointer to the terminating null character.
+ */
+Gua_String Gua_FormatReal(Gua_String p, Gua_Real x, Gua_Short precision)
+{
+    Gua_Char digits[GUA_NUMBER_SIZE];
+    Gua_Short length;
+    Gua_Short k;
+    Gua_Short exponent;
+    Gua_Short i;
+    
+    if (precision != GUA_SHORTEST_PRECISION) {
+        if (precision > GUA_MAX_PRECISION) {
+            precision = GUA_MAX_PRECISION;
+        }
+        return p + sprintf(p, "%.*g", precision, x);
+    }
+    
+    if (isnan(x) || isinf(x)) {
+        return p + sprintf(p, "%g", x);
+    }
+    
+    if (signbit(x)) {
+        *p++ = '-';
+        x = -x;
+    }
+    
+    if (x == 0.0) {
+        *p++ = '0';
+        *p = '\0';
+        return p;
+    }
+    
+    Gua_Grisu2(x, digits, &length, &k);
+    
+    /* The exponent of the first digit in scientific notation. */
+    exponent = length + k - 1;
+    
+    if ((exponent >= -5) && (exponent < 16)) {
+        if (k >= 0) {
+            /* An integer: 12300. */
+            for (i = 0; i < length; i++) {
+                *p++ = digits[i];
+            }
+            for (i = 0; i < k; i++) {
+                *p++ = '0';
+            }
+        } else if (exponent >= 0) {
+            /* A number with integer and fraction parts: 12.3. */
+            for (i = 0; i < length; i++) {
+                if (i == exponent + 1) {
+                    *p++ = '.';
+                }
+                *p++ = digits[i];
+            }
+        } else {
+            /* A number less than one: 0.00123. */
+            *p++ = '0';
+            *p++ = '.';
+            for (i = 0; i < -exponent - 1; i++) {
+                *p++ = '0';
+            }
+            for (i = 0; i < length; i++) {
+                *p++ = digits[i];
+            }
+        }
+    } else {
+        /* Scientific notation: 1.23e+20. */
+        *p++ = digits[0];
+        if (length > 1) {
+            *p++ = '.';
+            for (i = 1; i < length; i++) {
+                *p++ = digits[i];
+            }
+        }
+        *p++ = 'e';
+        if (exponent < 0) {
+            *p++ = '-';
+            exponent = -exponent;
+        } else {
+            *p++ = '+';
+        }
+        if (exponent < 10) {
+            *p++ = '0';
+        }
+        p = Gua_FormatInteger(p, exponent);
+    }
+    
+    *p = '\0';
+    
+    return p;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Length Gua_FormatLength(Gua_Object *object)
+ *
+ * Description:
+ *     Return an upper bound of the number of characters Gua_FormatObject
+ *     writes for an object.
+ *
+ * Arguments:
+ *     object,    a pointer to the object.
+ *
+ * Results:
+ *     The function returns the upper bound, without the null terminator.
+ */
+Gua_Length Gua_FormatLength(Gua_Object *object)
+{
+    if (Gua_PObjectType(object) == OBJECT_TYPE_COMPLEX) {
+        return GUA_NUMBER_SIZE * 2 + 2;
+    } else if (Gua_PObjectType(object) == OBJECT_TYPE_STRING) {
+        return Gua_PObjectLength(object) * 2 + 2;
+    } else if (Gua_PObjectType(object) == OBJECT_TYPE_HANDLE) {
+        return strlen((Gua_String)Gua_GetHandleType((Gua_Handle *)Gua_PObjectToHandle(object))) + GUA_NUMBER_SIZE;
+    } else if (Gua_PObjectType(object) == OBJECT_TYPE_FILE) {
+        return GUA_NUMBER_SIZE + 4;
+    }
+    
+    return GUA_NUMBER_SIZE;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_String Gua_FormatObject(Gua_String p, Gua_Object *object, Gua_Short precision)
+ *
+ * Description:
+ *     Write a scalar object as it is written in a script: numbers with
+ *     Gua_FormatInteger and Gua_FormatReal, strings between quotes.
+ *
+ * Arguments:
+ *     p,            the output buffer, at least Gua_FormatLength(object) + 1 bytes long;
+ *     object,       a pointer to the object;
+ *     precision,    the number of significant digits of real numbers.
+ *
+ * Results:
+ *     The function returns a pointer to the terminating null character,
+ *     or NULL if the object can not be written.
+ */
+Gua_String Gua_FormatObject(Gua_String p, Gua_Object *object, Gua_Short precision)
+{
+    Gua_String s;
+    Gua_Length i;
+    
+    if (Gua_PObjectType(object) == OBJECT_TYPE_INTEGER) {
+        p = Gua_FormatInteger(p, Gua_PObjectToInteger(object));
+    } else if (Gua_PObjectType(object) == OBJECT_TYPE_REAL) {
+        p = Gua_FormatReal(p, Gua_PObjectToReal(object), precision);
+    } else if (Gua_PObjectType(object) == OBJECT_TYPE_COMPLEX) {
+        p = Gua_FormatReal(p, Gua_PObjectToReal(object), precision);
+        if (!signbit(Gua_PObjectToImaginary(object))) {
+            *p++ = '+';
+        }
+        p = Gua_FormatReal(p, Gua_PObjectToImaginary(object), precision);
+        *p++ = '*';
+        *p++ = 'i';
+        *p = '\0';
+    } else if (Gua_PObjectType(object) == OBJECT_TYPE_STRING) {
+        s = Gua_PObjectToString(object);
+        *p++ = '"';
+        for (i = 0; i < Gua_PObjectLength(object); i++) {
+            if (s[i] == '"') {
+                *p++ = '\\';
+            }
+            *p++ = s[i];
+        }
+        *p++ = '"';
+        *p = '\0';
+    } else if (Gua_PObjectType(object) == OBJECT_TYPE_FILE) {
+        p = p + sprintf(p, "File%lu", (Gua_Integer)Gua_GetFileHandle((Gua_File *)Gua_PObjectToFile(object)));
+    } else if (Gua_PObjectType(object) == OBJECT_TYPE_HANDLE) {
+        p = p + sprintf(p, "%s%lu", (Gua_String)Gua_GetHandleType((Gua_Handle *)Gua_PObjectToHandle(object)), (Gua_Integer)Gua_GetHandlePointer((Gua_Handle *)Gua_PObjectToHandle(object)));
+    } else {
+        return NULL;
+    }
+    
+    return p;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Gua_ArrayToString(Gua_Object *array, Gua_Object *object)
+ *
+ * Description:
+ *     Convert an associative array object to a string object.
+ *
+ * Arguments:
+ *     array,     a pointer to an associative array;
+ *     object,    a pointer to a string object.
+ *
+ * Results:
+ *     The function converts an associative array object to a string object.
+ */
+Gua_Status Gua_ArrayToString(Gua_Object *array, Gua_Object *object)
+{
+    return Gua_FormatArray(array, object, GUA_SHORTEST_PRECISION);
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Gua_FormatArray(Gua_Object *array, Gua_Object *object, Gua_Short precision)
+ *
+ * Description:
+ *     Convert an associative array object to a string object, writing real
+ *     numbers with the given number of significant digits. The size of the
+ *     string is bounded first, so it is allocated only once.
+ *
+ * Arguments:
+ *     array,        a pointer to an associative array;
+ *     object,       a pointer to a string object;
+ *     precision,    the number of significant digits, or
+ *                   GUA_SHORTEST_PRECISION for the shortest exact form.
+ *
+ * Results:
+ *     The function converts an associative array object to a string object.
+ */
+Gua_Status Gua_FormatArray(Gua_Object *array, Gua_Object *object, Gua_Short precision)
+{
+    Gua_Element *element;
+    Gua_String string;
+    Gua_String p;
+    Gua_Length length;
+    
+    Gua_ClearPObject(object);
+    
+    element = (Gua_Element *)Gua_PObjectToArray(array);
+    
+    if (element == NULL) {
+        return GUA_ERROR;
+    }
+    
+    /* Bound the length of the string. */
+    length = 3;
+    while (element) {
+        length = length + Gua_FormatLength(&element->object) + 1;
+        element = (Gua_Element *)element->next;
+    }
+    
+    string = (char *)Gua_Alloc(sizeof(char) * length);
+    p = string;
+    
+    /* Open the brace. */
+    *p++ = '{';
+    
+    /* Fill the string with a representation of the array. */
+    element = (Gua_Element *)Gua_PObjectToArray(array);
+    while (element) {
+        p = Gua_FormatObject(p, &element->object, precision);
+        
+        if (p == NULL) {
+            Gua_Free(string);
+            return GUA_ERROR;
+        }
+        
+        element = (Gua_Element *)element->next;
+        if (element) {
+            *p++ = ',';
+        }
+    }
+    
+    /* Close the brace. */
+    *p++ = '}';
+    *p = '\0';
+    
+    /* Set the string object. */
+    Gua_LinkByteArrayToPObject(object, string, p - string);
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Gua_ArgsToString(Gua_Short argc, Gua_Object *argv, Gua_Object *object)
+ *
+ * Description:
+ *     Convert an array of arguments to a string object.
+ *
+ * Arguments:
+ *     argc,      the number of arguments;
+ *     argv,      an array containing the arguments;
+ *                argv[0] is the function name;
+ *     object,    a pointer to a string object.
+ *
+ * Results:
+ *     The function converts an array of arguments to a string object.
+ */
+Gua_Status Gua_ArgsToString(Gua_Short argc, Gua_Object *argv, Gua_Object *object)
+{
+    Gua_String string;
+    Gua_String newString;
+    Gua_String p;
+    Gua_Length length;
+    Gua_Integer i;
+    Gua_Integer j;
+    Gua_Short k;
+    
+    Gua_ClearPObject(object);
+    
+    string = (char *)Gua_Alloc(sizeof(char) * EXPRESSION_SIZE);
+    length = EXPRESSION_SIZE;
+    i = 0;
+    
+    if (argc > 0) {
+        /* Fill the string with a representation of the arguments. */
+        for (k = 1; k < argc; k++) {
+            if (Gua_ObjectType(argv[k]) == OBJECT_TYPE_INTEGER) {
+                p = (char *)Gua_Alloc(sizeof(char) * BUFFER_SIZE);
+                sprintf(p, "%ld", Gua_ObjectToInteger(argv[k]));
+                j = 0;
+                while (p[j]) {
+                    if (i == (length - 1)) {
+                        length = length * 2;
+                        newString = (char *)Gua_Realloc(string, length);
+                        
+                        if (newString == NULL) {
+                            Gua_Free(p);
+                            Gua_Free(string);
+                            return GUA_ERROR;
+                        } else {
+                            string = newString;
+                        }
+                    }
+                    string[i] = p[j];
+                    i++;
+                    j++;
                 }
                 Gua_Free(p);
-            } else if (Gua_ObjectType(element->object) == OBJECT_TYPE_REAL) {
+            } else if (Gua_ObjectType(argv[k]) == OBJECT_TYPE_REAL) {
                 p = (char *)Gua_Alloc(sizeof(char) * BUFFER_SIZE);
-                if (Gua_ObjectToReal(element->object) >= ZERO) {
-                    sprintf(p, "%g", Gua_ObjectToReal(element->object));
+                if (fabs(Gua_ObjectToReal(argv[k])) >= ZERO) {
+                    sprintf(p, "%g", Gua_ObjectToReal(argv[k]));
                 } else {
                     sprintf(p, "%g", 0.0);
                 }
+                sprintf(p, "%g", Gua_ObjectToReal(argv[k]));
                 j = 0;
                 while (p[j]) {
                     if (i == (length - 1)) {
@@ -3127,10 +3925,10 @@ Gua_Status Gua_ArrayToString(Gua_Object *array, Gua_Object *object)
                     j++;
                 }
                 Gua_Free(p);
-            } else if (Gua_ObjectType(element->object) == OBJECT_TYPE_COMPLEX) {
+            } else if (Gua_ObjectType(argv[k]) == OBJECT_TYPE_COMPLEX) {
                 p = (char *)Gua_Alloc(sizeof(char) * BUFFER_SIZE);
-                if (Gua_ObjectToReal(element->object) >= ZERO) {
-                    sprintf(p, "%g", Gua_ObjectToReal(element->object));
+                if (fabs(Gua_ObjectToReal(argv[k])) >= ZERO) {
+                    sprintf(p, "%g", Gua_ObjectToReal(argv[k]));
                 } else {
                     sprintf(p, "%g", 0.0);
                 }
@@ -3152,8 +3950,8 @@ Gua_Status Gua_ArrayToString(Gua_Object *array, Gua_Object *object)
                     i++;
                     j++;
                 }
-                if (Gua_ObjectToImaginary(element->object) >= ZERO) {
-                    sprintf(p, "%+g*i", Gua_ObjectToImaginary(element->object));
+                if (fabs(Gua_ObjectToImaginary(argv[k])) >= ZERO) {
+                    sprintf(p, "%+g*i", Gua_ObjectToImaginary(argv[k]));
                 } else {
                     sprintf(p, "%+g*i", 0.0);
                 }
@@ -3176,8 +3974,8 @@ Gua_Status Gua_ArrayToString(Gua_Object *array, Gua_Object *object)
                     j++;
                 }
                 Gua_Free(p);
-            } else if (Gua_ObjectType(element->object) == OBJECT_TYPE_STRING) {
-                p = Gua_ObjectToString(element->object);
+            } else if (Gua_ObjectType(argv[k]) == OBJECT_TYPE_STRING) {
+                p = Gua_ObjectToString(argv[k]);
                 string[i] = '"';
                 i++;
                 if (i == (length - 1)) {
@@ -3235,9 +4033,9 @@ Gua_Status Gua_ArrayToString(Gua_Object *array, Gua_Object *object)
                         string = newString;
                     }
                 }
-            } else if (Gua_ObjectType(element->object) == OBJECT_TYPE_FILE) {
+            } else if (Gua_ObjectType(argv[k]) == OBJECT_TYPE_FILE) {
                 p = (char *)Gua_Alloc(sizeof(char) * BUFFER_SIZE);
-                sprintf(p, "File%lu", (Gua_Integer)Gua_GetFileHandle((Gua_File *)Gua_ObjectToFile(element->object)));
+                sprintf(p, "File%lu", (Gua_Integer)Gua_GetFileHandle((Gua_File *)Gua_ObjectToFile(argv[k])));
                 j = 0;
                 while (p[j]) {
                     if (i == (length - 1)) {
@@ -3257,9 +4055,9 @@ Gua_Status Gua_ArrayToString(Gua_Object *array, Gua_Object *object)
                     j++;
                 }
                 Gua_Free(p);
-            } else if (Gua_ObjectType(element->object) == OBJECT_TYPE_HANDLE) {
+            } else if (Gua_ObjectType(argv[k]) == OBJECT_TYPE_HANDLE) {
                 p = (char *)Gua_Alloc(sizeof(char) * BUFFER_SIZE);
-                sprintf(p, "%s%lu", (Gua_String)Gua_GetHandleType((Gua_Handle *)Gua_ObjectToHandle(element->object)), (Gua_Integer)Gua_GetHandlePointer((Gua_Handle *)Gua_ObjectToHandle(element->object)));
+                sprintf(p, "%s%lu", (Gua_String)Gua_GetHandleType((Gua_Handle *)Gua_ObjectToHandle(argv[k])), (Gua_Integer)Gua_GetHandlePointer((Gua_Handle *)Gua_ObjectToHandle(argv[k])));
                 j = 0;
                 while (p[j]) {
                     if (i == (length - 1)) {
@@ -3284,8 +4082,7 @@ Gua_Status Gua_ArrayToString(Gua_Object *array, Gua_Object *object)
                 return GUA_ERROR;
             }
             
-            if (element->next) {
-                element = (Gua_Element *)element->next;
+            if (k < (argc - 1)) {
                 string[i] = ',';
                 i++;
                 if (i == (length - 1)) {
@@ -3299,14 +4096,9 @@ Gua_Status Gua_ArrayToString(Gua_Object *array, Gua_Object *object)
                         string = newString;
                     }
                 }
-            } else {
-                break;
             }
         }
         
-        /* Close the brace. */
-        string[i] = '}';
-        i++;
         if (i == (length - 1)) {
             length = length * 2;
             newString = (char *)Gua_Realloc(string, length);
@@ -3321,9 +4113,7 @@ Gua_Status Gua_ArrayToString(Gua_Object *array, Gua_Object *object)
         string[i] = '\0';
         
         /* Set the string object. */
-        Gua_StringToPObject(object, string);
-        
-        Gua_Free(string);
+        Gua_LinkStringToPObject(object, string);
         
         return GUA_OK;
     }
@@ -3336,312 +4126,29 @@ Gua_Status Gua_ArrayToString(Gua_Object *array, Gua_Object *object)
  *     C
  *
  * Function:
- *     Gua_Status Gua_ArgsToString(Gua_Short argc, Gua_Object *argv, Gua_Object *object)
+ *     Gua_Status Gua_IsArrayEqual(Gua_Object *a, Gua_Object *b)
  *
  * Description:
- *     Convert an array of arguments to a string object.
+ *     Compare two associative arrays.
  *
  * Arguments:
- *     argc,      the number of arguments;
- *     argv,      an array containing the arguments;
- *                argv[0] is the function name;
- *     object,    a pointer to a string object.
+ *     a,    an associative array;
+ *     b,    an associative array.
  *
  * Results:
- *     The function converts an array of arguments to a string object.
+ *     The function returns 1 if the arrays are equivalent, 0 otherwise.
  */
-Gua_Status Gua_ArgsToString(Gua_Short argc, Gua_Object *argv, Gua_Object *object)
+Gua_Status Gua_IsArrayEqual(Gua_Object *a, Gua_Object *b)
 {
-    Gua_String string;
-    Gua_String newString;
-    Gua_String p;
-    Gua_Length length;
-    Gua_Integer i;
-    Gua_Integer j;
-    Gua_Short k;
+    Gua_Element *element1;
+    Gua_Element *element2;
     
-    Gua_ClearPObject(object);
+    if (Gua_PObjectLength(a) != Gua_PObjectLength(b)) {
+        return 0;
+    }
     
-    string = (char *)Gua_Alloc(sizeof(char) * EXPRESSION_SIZE);
-    length = EXPRESSION_SIZE;
-    i = 0;
-    
-    if (argc > 0) {
-        /* Fill the string with a representation of the arguments. */
-        for (k = 1; k < argc; k++) {
-            if (Gua_ObjectType(argv[k]) == OBJECT_TYPE_INTEGER) {
-                p = (char *)Gua_Alloc(sizeof(char) * BUFFER_SIZE);
-                sprintf(p, "%ld", Gua_ObjectToInteger(argv[k]));
-                j = 0;
-                while (p[j]) {
-                    if (i == (length - 1)) {
-                        length = length * 2;
-                        newString = (char *)Gua_Realloc(string, length);
-                        
-                        if (newString == NULL) {
-                            Gua_Free(p);
-                            Gua_Free(string);
-                            return GUA_ERROR;
-                        } else {
-                            string = newString;
-                        }
-                    }
-                    string[i] = p[j];
-                    i++;
-                    j++;
-                }
-                Gua_Free(p);
-            } else if (Gua_ObjectType(argv[k]) == OBJECT_TYPE_REAL) {
-                p = (char *)Gua_Alloc(sizeof(char) * BUFFER_SIZE);
-                if (fabs(Gua_ObjectToReal(argv[k])) >= ZERO) {
-                    sprintf(p, "%g", Gua_ObjectToReal(argv[k]));
-                } else {
-                    sprintf(p, "%g", 0.0);
-                }
-                sprintf(p, "%g", Gua_ObjectToReal(argv[k]));
-                j = 0;
-                while (p[j]) {
-                    if (i == (length - 1)) {
-                        length = length * 2;
-                        newString = (char *)Gua_Realloc(string, length);
-                        
-                        if (newString == NULL) {
-                            Gua_Free(p);
-                            Gua_Free(string);
-                            return GUA_ERROR;
-                        } else {
-                            string = newString;
-                        }
-                    }
-                    string[i] = p[j];
-                    i++;
-                    j++;
-                }
-                Gua_Free(p);
-            } else if (Gua_ObjectType(argv[k]) == OBJECT_TYPE_COMPLEX) {
-                p = (char *)Gua_Alloc(sizeof(char) * BUFFER_SIZE);
-                if (fabs(Gua_ObjectToReal(argv[k])) >= ZERO) {
-                    sprintf(p, "%g", Gua_ObjectToReal(argv[k]));
-                } else {
-                    sprintf(p, "%g", 0.0);
-                }
-                j = 0;
-                while (p[j]) {
-                    if (i == (length - 1)) {
-                        length = length * 2;
-                        newString = (char *)Gua_Realloc(string, length);
-                        
-                        if (newString == NULL) {
-                            Gua_Free(p);
-                            Gua_Free(string);
-                            return GUA_ERROR;
-                        } else {
-                            string = newString;
-                        }
-                    }
-                    string[i] = p[j];
-                    i++;
-                    j++;
-                }
-                if (fabs(Gua_ObjectToImaginary(argv[k])) >= ZERO) {
-                    sprintf(p, "%+g*i", Gua_ObjectToImaginary(argv[k]));
-                } else {
-                    sprintf(p, "%+g*i", 0.0);
-                }
-                j = 0;
-                while (p[j]) {
-                    if (i == (length - 1)) {
-                        length = length * 2;
-                        newString = (char *)Gua_Realloc(string, length);
-                        
-                        if (newString == NULL) {
-                            Gua_Free(p);
-                            Gua_Free(string);
-                            return GUA_ERROR;
-                        } else {
-                            string = newString;
-                        }
-                    }
-                    string[i] = p[j];
-                    i++;
-                    j++;
-                }
-                Gua_Free(p);
-            } else if (Gua_ObjectType(argv[k]) == OBJECT_TYPE_STRING) {
-                p = Gua_ObjectToString(argv[k]);
-                string[i] = '"';
-                i++;
-                if (i == (length - 1)) {
-                    length = length * 2;
-                    newString = (char *)Gua_Realloc(string, length);
-                    
-                    if (newString == NULL) {
-                        Gua_Free(string);
-                        return GUA_ERROR;
-                    } else {
-                        string = newString;
-                    }
-                }
-                while (*p) {
-                    if (*p == '"') {
-                        if (i == (length - 1)) {
-                            length = length * 2;
-                            newString = (char *)Gua_Realloc(string, length);
-                            
-                            if (newString == NULL) {
-                                Gua_Free(string);
-                                return GUA_ERROR;
-                            } else {
-                                string = newString;
-                            }
-                        }
-                        string[i] = '\\';
-                        i++;
-                    }
-                    if (i == (length - 1)) {
-                        length = length * 2;
-                        newString = (char *)Gua_Realloc(string, length);
-                        
-                        if (newString == NULL) {
-                            Gua_Free(string);
-                            return GUA_ERROR;
-                        } else {
-                            string = newString;
-                        }
-                    }
-                    string[i] = *p;
-                    i++;
-                    p++;
-                }
-                string[i] = '"';
-                i++;
-                if (i == (length - 1)) {
-                    length = length * 2;
-                    newString = (char *)Gua_Realloc(string, length);
-                    
-                    if (newString == NULL) {
-                        Gua_Free(string);
-                        return GUA_ERROR;
-                    } else {
-                        string = newString;
-                    }
-                }
-            } else if (Gua_ObjectType(argv[k]) == OBJECT_TYPE_FILE) {
-                p = (char *)Gua_Alloc(sizeof(char) * BUFFER_SIZE);
-                sprintf(p, "File%lu", (Gua_Integer)Gua_GetFileHandle((Gua_File *)Gua_ObjectToFile(argv[k])));
-                j = 0;
-                while (p[j]) {
-                    if (i == (length - 1)) {
-                        length = length * 2;
-                        newString = (char *)Gua_Realloc(string, length);
-                        
-                        if (newString == NULL) {
-                            Gua_Free(p);
-                            Gua_Free(string);
-                            return GUA_ERROR;
-                        } else {
-                            string = newString;
-                        }
-                    }
-                    string[i] = p[j];
-                    i++;
-                    j++;
-                }
-                Gua_Free(p);
-            } else if (Gua_ObjectType(argv[k]) == OBJECT_TYPE_HANDLE) {
-                p = (char *)Gua_Alloc(sizeof(char) * BUFFER_SIZE);
-                sprintf(p, "%s%lu", (Gua_String)Gua_GetHandleType((Gua_Handle *)Gua_ObjectToHandle(argv[k])), (Gua_Integer)Gua_GetHandlePointer((Gua_Handle *)Gua_ObjectToHandle(argv[k])));
-                j = 0;
-                while (p[j]) {
-                    if (i == (length - 1)) {
-                        length = length * 2;
-                        newString = (char *)Gua_Realloc(string, length);
-                        
-                        if (newString == NULL) {
-                            Gua_Free(p);
-                            Gua_Free(string);
-                            return GUA_ERROR;
-                        } else {
-                            string = newString;
-                        }
-                    }
-                    string[i] = p[j];
-                    i++;
-                    j++;
-                }
-                Gua_Free(p);
-            } else {
-                Gua_Free(string);
-                return GUA_ERROR;
-            }
-            
-            if (k < (argc - 1)) {
-                string[i] = ',';
-                i++;
-                if (i == (length - 1)) {
-                    length = length * 2;
-                    newString = (char *)Gua_Realloc(string, length);
-                    
-                    if (newString == NULL) {
-                        Gua_Free(string);
-                        return GUA_ERROR;
-                    } else {
-                        string = newString;
-                    }
-                }
-            }
-        }
-        
-        if (i == (length - 1)) {
-            length = length * 2;
-            newString = (char *)Gua_Realloc(string, length);
-            
-            if (newString == NULL) {
-                Gua_Free(string);
-                return GUA_ERROR;
-            } else {
-                string = newString;
-            }
-        }
-        string[i] = '\0';
-        
-        /* Set the string object. */
-        Gua_LinkStringToPObject(object, string);
-        
-        return GUA_OK;
-    }
-    
-    return GUA_ERROR;
-}
-
-/**
- * Group:
- *     C
- *
- * Function:
- *     Gua_Status Gua_IsArrayEqual(Gua_Object *a, Gua_Object *b)
- *
- * Description:
- *     Compare two associative arrays.
- *
- * Arguments:
- *     a,    an associative array;
- *     b,    an associative array.
- *
- * Results:
- *     The function returns 1 if the arrays are equivalent, 0 otherwise.
- */
-Gua_Status Gua_IsArrayEqual(Gua_Object *a, Gua_Object *b)
-{
-    Gua_Element *element1;
-    Gua_Element *element2;
-    
-    if (Gua_PObjectLength(a) != Gua_PObjectLength(b)) {
-        return 0;
-    }
-    
-    element1 = (Gua_Element *)Gua_PObjectToArray(a);
-    element2 = (Gua_Element *)Gua_PObjectToArray(b);
+    element1 = (Gua_Element *)Gua_PObjectToArray(a);
+    element2 = (Gua_Element *)Gua_PObjectToArray(b);
     
     if (element1 && element2) {
         while (true) {
@@ -3954,376 +4461,180 @@ Gua_Status Gua_GetMatrixDim(Gua_Object *array, Gua_Object *matrix)
  *     The function converts a matrix object to a string object.
  */
 Gua_Status Gua_MatrixToString(Gua_Object *matrix, Gua_Object *object)
+{
+    return Gua_FormatMatrix(matrix, object, GUA_SHORTEST_PRECISION);
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Gua_FormatMatrix(Gua_Object *matrix, Gua_Object *object, Gua_Short precision)
+ *
+ * Description:
+ *     Convert a matrix object to a string object, writing real numbers with
+ *     the given number of significant digits. The size of the string is
+ *     bounded first, so it is allocated only once.
+ *
+ * Arguments:
+ *     matrix,       a pointer to a matrix;
+ *     object,       a pointer to a string object;
+ *     precision,    the number of significant digits, or
+ *                   GUA_SHORTEST_PRECISION for the shortest exact form.
+ *
+ * Results:
+ *     The function converts a matrix object to a string object.
+ */
+Gua_Status Gua_FormatMatrix(Gua_Object *matrix, Gua_Object *object, Gua_Short precision)
 {
     Gua_Matrix *m;
     Gua_Object *o;
     Gua_String string;
-    Gua_String newString;
     Gua_String p;
     Gua_Length length;
-    Gua_Integer i;
-    Gua_Integer j;
     Gua_Integer k;
     Gua_Integer c;
     
     Gua_ClearPObject(object);
     
-    string = (char *)Gua_Alloc(sizeof(char) * EXPRESSION_SIZE);
-    length = EXPRESSION_SIZE;
-    i = 0;
-    
     m = (Gua_Matrix *)Gua_PObjectToMatrix(matrix);
     
-    if (m) {
-        /* Open the bracket. */
-        string[i] = '[';
-        i++;
+    if (m == NULL) {
+        return GUA_ERROR;
+    }
+    
+    o = (Gua_Object *)m->object;
+    
+    /* Bound the length of the string. */
+    length = 3;
+    for (k = 0; k < Gua_PObjectLength(matrix); k++) {
+        length = length + Gua_FormatLength(&o[k]) + 1;
+    }
+    
+    string = (char *)Gua_Alloc(sizeof(char) * length);
+    p = string;
+    
+    /* Open the bracket. */
+    *p++ = '[';
+    
+    c = 0;
+    
+    /* Fill the string with a representation of the matrix. */
+    for (k = 0; k < Gua_PObjectLength(matrix); k++) {
+        p = Gua_FormatObject(p, &o[k], precision);
         
-        o = (Gua_Object *)m->object;
-        c = 0;
+        if (p == NULL) {
+            Gua_Free(string);
+            return GUA_ERROR;
+        }
         
-        /* Fill the string with a representation of the matrix. */
-        for (k = 0; k < Gua_PObjectLength(matrix); k++) {
-            if (Gua_ObjectType(o[k]) == OBJECT_TYPE_INTEGER) {
-                p = (char *)Gua_Alloc(sizeof(char) * BUFFER_SIZE);
-                sprintf(p, "%ld", Gua_ObjectToInteger(o[k]));
-                j = 0;
-                while (p[j]) {
-                    if (i == (length - 1)) {
-                        length = length * 2;
-                        newString = (char *)Gua_Realloc(string, length);
-                        
-                        if (newString == NULL) {
-                            Gua_Free(p);
-                            Gua_Free(string);
-                            return GUA_ERROR;
-                        } else {
-                            string = newString;
-                        }
-                    }
-                    string[i] = p[j];
-                    i++;
-                    j++;
-                }
-                Gua_Free(p);
-            } else if (Gua_ObjectType(o[k]) == OBJECT_TYPE_REAL) {
-                p = (char *)Gua_Alloc(sizeof(char) * BUFFER_SIZE);
-                if (fabs(Gua_ObjectToReal(o[k])) >= ZERO) {
-                    sprintf(p, "%g", Gua_ObjectToReal(o[k]));
+        if (k < (Gua_PObjectLength(matrix) - 1)) {
+            if (m->dimc == 2) {
+                if (c < (m->dimv[1] - 1)) {
+                    *p++ = ',';
+                    c++;
                 } else {
-                    sprintf(p, "%g", 0.0);
+                    *p++ = ';';
+                    c = 0;
                 }
-                j = 0;
-                while (p[j]) {
-                    if (i == (length - 1)) {
-                        length = length * 2;
-                        newString = (char *)Gua_Realloc(string, length);
-                        
-                        if (newString == NULL) {
-                            Gua_Free(p);
-                            Gua_Free(string);
-                            return GUA_ERROR;
-                        } else {
-                            string = newString;
-                        }
-                    }
-                    string[i] = p[j];
-                    i++;
-                    j++;
+            } else {
+                *p++ = ',';
+            }
+        }
+    }
+    
+    /* Close the bracket. */
+    *p++ = ']';
+    *p = '\0';
+    
+    /* Set the string object. */
+    Gua_LinkByteArrayToPObject(object, string, p - string);
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Gua_IsMatrixEqual(Gua_Object *a, Gua_Object *b)
+ *
+ * Description:
+ *     Compare two matrices.
+ *
+ * Arguments:
+ *     a,    a matrix;
+ *     b,    a matrix.
+ *
+ * Results:
+ *     The function returns 1 if the matrices are equivalent, 0 otherwise.
+ */
+Gua_Status Gua_IsMatrixEqual(Gua_Object *a, Gua_Object *b)
+{
+    Gua_Matrix *m1;
+    Gua_Matrix *m2;
+    Gua_Object *o1;
+    Gua_Object *o2;
+    Gua_Integer i;
+    
+    if (Gua_PObjectLength(a) != Gua_PObjectLength(b)) {
+        return 0;
+    }
+    
+    m1 = (Gua_Matrix *)Gua_PObjectToMatrix(a);
+    m2 = (Gua_Matrix *)Gua_PObjectToMatrix(b);
+    
+    if (m1 && m2) {
+        if (m1->dimc != m2->dimc) {
+            return 0;
+        }
+        
+        for (i = 0; i < m1->dimc; i++) {
+            if (m1->dimv[i] != m2->dimv[i]) {
+                return 0;
+            }
+        }
+        
+        o1 = (Gua_Object *)m1->object;
+        o2 = (Gua_Object *)m2->object;
+        
+        for (i = 0; i < Gua_PObjectLength(a); i++) {
+            if ((Gua_ObjectType(o1[i]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(o2[i]) == OBJECT_TYPE_INTEGER)) {
+                if (Gua_ObjectToInteger(o1[i]) != Gua_ObjectToInteger(o2[i])) {
+                    return 0;
                 }
-                Gua_Free(p);
-            } else if (Gua_ObjectType(o[k]) == OBJECT_TYPE_COMPLEX) {
-                p = (char *)Gua_Alloc(sizeof(char) * BUFFER_SIZE);
-                if (fabs(Gua_ObjectToReal(o[k])) >= ZERO) {
-                    sprintf(p, "%g", Gua_ObjectToReal(o[k]));
-                } else {
-                    sprintf(p, "%g", 0.0);
+            } else if ((Gua_ObjectType(o1[i]) == OBJECT_TYPE_REAL) && (Gua_ObjectType(o2[i]) == OBJECT_TYPE_REAL)) {
+                if (Gua_ObjectToReal(o1[i]) != Gua_ObjectToReal(o2[i])) {
+                    return 0;
                 }
-                j = 0;
-                while (p[j]) {
-                    if (i == (length - 1)) {
-                        length = length * 2;
-                        newString = (char *)Gua_Realloc(string, length);
-                        
-                        if (newString == NULL) {
-                            Gua_Free(p);
-                            Gua_Free(string);
-                            return GUA_ERROR;
-                        } else {
-                            string = newString;
-                        }
-                    }
-                    string[i] = p[j];
-                    i++;
-                    j++;
+            } else if ((Gua_ObjectType(o1[i]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(o2[i]) == OBJECT_TYPE_REAL)) {
+                if (Gua_ObjectToInteger(o1[i]) != Gua_ObjectToReal(o2[i])) {
+                    return 0;
                 }
-                if (fabs(Gua_ObjectToImaginary(o[k])) >= ZERO) {
-                    sprintf(p, "%+g*i", Gua_ObjectToImaginary(o[k]));
-                } else {
-                    sprintf(p, "%+g*i", 0.0);
+            } else if ((Gua_ObjectType(o1[i]) == OBJECT_TYPE_REAL) && (Gua_ObjectType(o2[i]) == OBJECT_TYPE_INTEGER)) {
+                if (Gua_ObjectToReal(o1[i]) != Gua_ObjectToInteger(o2[i])) {
+                    return 0;
                 }
-                j = 0;
-                while (p[j]) {
-                    if (i == (length - 1)) {
-                        length = length * 2;
-                        newString = (char *)Gua_Realloc(string, length);
-                        
-                        if (newString == NULL) {
-                            Gua_Free(p);
-                            Gua_Free(string);
-                            return GUA_ERROR;
-                        } else {
-                            string = newString;
-                        }
-                    }
-                    string[i] = p[j];
-                    i++;
-                    j++;
+            } else if ((Gua_ObjectType(o1[i]) == OBJECT_TYPE_COMPLEX) && (Gua_ObjectType(o2[i]) == OBJECT_TYPE_COMPLEX)) {
+                if (Gua_ObjectToReal(o1[i]) != Gua_ObjectToReal(o2[i])) {
+                    return 0;
                 }
-                Gua_Free(p);
-            } else if (Gua_ObjectType(o[k]) == OBJECT_TYPE_STRING) {
-                p = Gua_ObjectToString(o[k]);
-                string[i] = '"';
-                i++;
-                if (i == (length - 1)) {
-                    length = length * 2;
-                    newString = (char *)Gua_Realloc(string, length);
-                    
-                    if (newString == NULL) {
-                        Gua_Free(string);
-                        return GUA_ERROR;
-                    } else {
-                        string = newString;
-                    }
+                if (Gua_ObjectToImaginary(o1[i]) != Gua_ObjectToImaginary(o2[i])) {
+                    return 0;
                 }
-                while (*p) {
-                    if (*p == '"') {
-                        if (i == (length - 1)) {
-                            length = length * 2;
-                            newString = (char *)Gua_Realloc(string, length);
-                            
-                            if (newString == NULL) {
-                                Gua_Free(string);
-                                return GUA_ERROR;
-                            } else {
-                                string = newString;
-                            }
-                        }
-                        string[i] = '\\';
-                        i++;
-                    }
-                    if (i == (length - 1)) {
-                        length = length * 2;
-                        newString = (char *)Gua_Realloc(string, length);
-                        
-                        if (newString == NULL) {
-                            Gua_Free(string);
-                            return GUA_ERROR;
-                        } else {
-                            string = newString;
-                        }
+            } else if ((Gua_ObjectType(o1[i]) == OBJECT_TYPE_STRING) && (Gua_ObjectType(o2[i]) == OBJECT_TYPE_STRING)) {
+                if (Gua_ObjectLength(o1[i]) == Gua_ObjectLength(o2[i])) {
+                    if (memcmp(Gua_ObjectToString(o1[i]), Gua_ObjectToString(o2[i]), Gua_ObjectLength(o1[i])) != 0) {
+                        return 0;
                     }
-                    string[i] = *p;
-                    i++;
-                    p++;
+                } else {
+                    return 0;
                 }
-                string[i] = '"';
-                i++;
-                if (i == (length - 1)) {
-                    length = length * 2;
-                    newString = (char *)Gua_Realloc(string, length);
-                    
-                    if (newString == NULL) {
-                        Gua_Free(string);
-                        return GUA_ERROR;
-                    } else {
-                        string = newString;
-                    }
-                }
-            } else if (Gua_ObjectType(o[k]) == OBJECT_TYPE_FILE) {
-                p = (char *)Gua_Alloc(sizeof(char) * BUFFER_SIZE);
-                sprintf(p, "File%lu", (Gua_Integer)Gua_GetFileHandle((Gua_File *)Gua_ObjectToFile(o[k])));
-                j = 0;
-                while (p[j]) {
-                    if (i == (length - 1)) {
-                        length = length * 2;
-                        newString = (char *)Gua_Realloc(string, length);
-                        
-                        if (newString == NULL) {
-                            Gua_Free(p);
-                            Gua_Free(string);
-                            return GUA_ERROR;
-                        } else {
-                            string = newString;
-                        }
-                    }
-                    string[i] = p[j];
-                    i++;
-                    j++;
-                }
-                Gua_Free(p);
-            } else if (Gua_ObjectType(o[k]) == OBJECT_TYPE_HANDLE) {
-                p = (char *)Gua_Alloc(sizeof(char) * BUFFER_SIZE);
-                sprintf(p, "%s%lu", (Gua_String)Gua_GetHandleType((Gua_Handle *)Gua_ObjectToHandle(o[k])), (Gua_Integer)Gua_GetHandlePointer((Gua_Handle *)Gua_ObjectToHandle(o[k])));
-                j = 0;
-                while (p[j]) {
-                    if (i == (length - 1)) {
-                        length = length * 2;
-                        newString = (char *)Gua_Realloc(string, length);
-                        
-                        if (newString == NULL) {
-                            Gua_Free(p);
-                            Gua_Free(string);
-                            return GUA_ERROR;
-                        } else {
-                            string = newString;
-                        }
-                    }
-                    string[i] = p[j];
-                    i++;
-                    j++;
-                }
-                Gua_Free(p);
-            } else {
-                Gua_Free(string);
-                return GUA_ERROR;
-            }
-            
-            if (k < (Gua_PObjectLength(matrix) - 1)) {
-                if (m->dimc == 2) {
-                    if (c < (m->dimv[1] - 1)) {
-                        string[i] = ',';
-                        c++;
-                    } else {
-                        string[i] = ';';
-                        c = 0;
-                    }
-                } else {
-                    string[i] = ',';
-                }
-                i++;
-                if (i == (length - 1)) {
-                    length = length * 2;
-                    newString = (char *)Gua_Realloc(string, length);
-                    
-                    if (newString == NULL) {
-                        Gua_Free(string);
-                        return GUA_ERROR;
-                    } else {
-                        string = newString;
-                    }
-                }
-            }
-        }
-        
-        /* Close the bracket. */
-        string[i] = ']';
-        i++;
-        if (i == (length - 1)) {
-            length = length * 2;
-            newString = (char *)Gua_Realloc(string, length);
-            
-            if (newString == NULL) {
-                Gua_Free(string);
-                return GUA_ERROR;
-            } else {
-                string = newString;
-            }
-        }
-        string[i] = '\0';
-        
-        /* Set the string object. */
-        Gua_StringToPObject(object, string);
-        
-        Gua_Free(string);
-        
-        return GUA_OK;
-    }
-    
-    return GUA_ERROR;
-}
-
-/**
- * Group:
- *     C
- *
- * Function:
- *     Gua_Status Gua_IsMatrixEqual(Gua_Object *a, Gua_Object *b)
- *
- * Description:
- *     Compare two matrices.
- *
- * Arguments:
- *     a,    a matrix;
- *     b,    a matrix.
- *
- * Results:
- *     The function returns 1 if the matrices are equivalent, 0 otherwise.
- */
-Gua_Status Gua_IsMatrixEqual(Gua_Object *a, Gua_Object *b)
-{
-    Gua_Matrix *m1;
-    Gua_Matrix *m2;
-    Gua_Object *o1;
-    Gua_Object *o2;
-    Gua_Integer i;
-    
-    if (Gua_PObjectLength(a) != Gua_PObjectLength(b)) {
-        return 0;
-    }
-    
-    m1 = (Gua_Matrix *)Gua_PObjectToMatrix(a);
-    m2 = (Gua_Matrix *)Gua_PObjectToMatrix(b);
-    
-    if (m1 && m2) {
-        if (m1->dimc != m2->dimc) {
-            return 0;
-        }
-        
-        for (i = 0; i < m1->dimc; i++) {
-            if (m1->dimv[i] != m2->dimv[i]) {
-                return 0;
-            }
-        }
-        
-        o1 = (Gua_Object *)m1->object;
-        o2 = (Gua_Object *)m2->object;
-        
-        for (i = 0; i < Gua_PObjectLength(a); i++) {
-            if ((Gua_ObjectType(o1[i]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(o2[i]) == OBJECT_TYPE_INTEGER)) {
-                if (Gua_ObjectToInteger(o1[i]) != Gua_ObjectToInteger(o2[i])) {
-                    return 0;
-                }
-            } else if ((Gua_ObjectType(o1[i]) == OBJECT_TYPE_REAL) && (Gua_ObjectType(o2[i]) == OBJECT_TYPE_REAL)) {
-                if (Gua_ObjectToReal(o1[i]) != Gua_ObjectToReal(o2[i])) {
-                    return 0;
-                }
-            } else if ((Gua_ObjectType(o1[i]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(o2[i]) == OBJECT_TYPE_REAL)) {
-                if (Gua_ObjectToInteger(o1[i]) != Gua_ObjectToReal(o2[i])) {
-                    return 0;
-                }
-            } else if ((Gua_ObjectType(o1[i]) == OBJECT_TYPE_REAL) && (Gua_ObjectType(o2[i]) == OBJECT_TYPE_INTEGER)) {
-                if (Gua_ObjectToReal(o1[i]) != Gua_ObjectToInteger(o2[i])) {
-                    return 0;
-                }
-            } else if ((Gua_ObjectType(o1[i]) == OBJECT_TYPE_COMPLEX) && (Gua_ObjectType(o2[i]) == OBJECT_TYPE_COMPLEX)) {
-                if (Gua_ObjectToReal(o1[i]) != Gua_ObjectToReal(o2[i])) {
-                    return 0;
-                }
-                if (Gua_ObjectToImaginary(o1[i]) != Gua_ObjectToImaginary(o2[i])) {
-                    return 0;
-                }
-            } else if ((Gua_ObjectType(o1[i]) == OBJECT_TYPE_STRING) && (Gua_ObjectType(o2[i]) == OBJECT_TYPE_STRING)) {
-                if (Gua_ObjectLength(o1[i]) == Gua_ObjectLength(o2[i])) {
-                    if (memcmp(Gua_ObjectToString(o1[i]), Gua_ObjectToString(o2[i]), Gua_ObjectLength(o1[i])) != 0) {
-                        return 0;
-                    }
-                } else {
-                    return 0;
-                }
-            } else if ((Gua_ObjectType(o1[i]) == OBJECT_TYPE_FILE) && (Gua_ObjectType(o2[i]) == OBJECT_TYPE_FILE)) {
-                if (Gua_ObjectToFile(o1[i]) != Gua_ObjectToFile(o2[i])) {
-                    return 0;
+            } else if ((Gua_ObjectType(o1[i]) == OBJECT_TYPE_FILE) && (Gua_ObjectType(o2[i]) == OBJECT_TYPE_FILE)) {
+                if (Gua_ObjectToFile(o1[i]) != Gua_ObjectToFile(o2[i])) {
+                    return 0;
                 }
             } else if ((Gua_ObjectType(o1[i]) == OBJECT_TYPE_HANDLE) && (Gua_ObjectType(o2[i]) == OBJECT_TYPE_HANDLE)) {
                 if (Gua_ObjectToHandle(o1[i]) != Gua_ObjectToHandle(o2[i])) {
@@ -4828,6 +5139,15 @@ Gua_Status Gua_MulMatrix(Gua_Object *a, Gua_Object *b, Gua_Object *c, Gua_String
     Gua_Integer m;
     Gua_Integer n;
     Gua_Integer p;
+    Gua_Real *buffer;
+    Gua_Real *re1;
+    Gua_Real *im1;
+    Gua_Real *re2;
+    Gua_Real *im2;
+    Gua_Real *re3;
+    Gua_Real *im3;
+    Gua_Short type1;
+    Gua_Short type2;
     Gua_String errMessage;
     
     if (!((Gua_PObjectType(a) == OBJECT_TYPE_INTEGER) || (Gua_PObjectType(a) == OBJECT_TYPE_REAL) || (Gua_PObjectType(a) == OBJECT_TYPE_COMPLEX) || (Gua_PObjectType(a) == OBJECT_TYPE_MATRIX))) {
@@ -4905,6 +5225,40 @@ Gua_Status Gua_MulMatrix(Gua_Object *a, Gua_Object *b, Gua_Object *c, Gua_String
             m3->object = (struct Gua_Object *)Gua_Alloc(m * p * sizeof(Gua_Object));
             o3 = (Gua_Object *)m3->object;
             
+            type1 = Gua_GetMatrixType(o1, m * n);
+            type2 = Gua_GetMatrixType(o2, n * p);
+            
+            /*
+             * Real and complex products run over packed planes of real and
+             * imaginary parts, instead of dispatching on the element types.
+             */
+            if ((type1 != OBJECT_TYPE_UNKNOWN) && (type2 != OBJECT_TYPE_UNKNOWN) && !((type1 == OBJECT_TYPE_INTEGER) && (type2 == OBJECT_TYPE_INTEGER))) {
+                buffer = (Gua_Real *)Gua_Alloc(((type1 == OBJECT_TYPE_COMPLEX) || (type2 == OBJECT_TYPE_COMPLEX) ? 2 : 1) * (m * n + n * p + m * p) * sizeof(Gua_Real));
+                re1 = buffer;
+                re2 = re1 + m * n;
+                re3 = re2 + n * p;
+                im1 = NULL;
+                im2 = NULL;
+                im3 = NULL;
+                
+                if ((type1 == OBJECT_TYPE_COMPLEX) || (type2 == OBJECT_TYPE_COMPLEX)) {
+                    im1 = re3 + m * p;
+                    im2 = im1 + m * n;
+                    im3 = im2 + n * p;
+                }
+                
+                Gua_PackMatrix(o1, m * n, re1, im1);
+                Gua_PackMatrix(o2, n * p, re2, im2);
+                
+                Gua_GemmBuffer(re1, im1, re2, im2, re3, im3, m, n, p);
+                
+                Gua_UnpackMatrix(o3, m * p, re3, im3);
+                
+                Gua_Free(buffer);
+                
+                return GUA_OK;
+            }
+            
             /* Clear each element of matrix C. */ 
             for (i = 0; i < m; i++) {
                 for (j = 0; j < p; j++) {
@@ -5247,95 +5601,49 @@ Gua_Status Gua_InvMatrix(Gua_Object *a, Gua_Object *b, Gua_String error)
  *     C
  *
  * Function:
- *     Gua_Status Gua_PowMatrix(Gua_Object *a, Gua_Integer n, Gua_Object *b, Gua_String error)
+ *     void Gua_MulIntegerBuffer(Gua_Integer *a, Gua_Integer *b, Gua_Integer *c, Gua_Length n)
  *
  * Description:
- *     Calculate the power of the matrix a by n.
+ *     Multiply the n x n row-major integer buffers a and b into c.
  *
  * Arguments:
- *     a,        a matrix;
- *     n,        a positive integer power, or 0 or -1;
- *     b,        a structure containing the return object of the function;
- *     error,    a pointer to the error message.
+ *     a,        the left operand;
+ *     b,        the right operand;
+ *     c,        the result buffer, which must not overlap a or b;
+ *     n,        the order of the matrices.
  *
  * Results:
- *     The function returns the matrix B = A ** n.
+ *     The function stores C = A * B in c.
  */
-Gua_Status Gua_PowMatrix(Gua_Object *a, Gua_Integer n, Gua_Object *b, Gua_String error)
+void Gua_MulIntegerBuffer(Gua_Integer *a, Gua_Integer *b, Gua_Integer *c, Gua_Length n)
 {
-    Gua_Object c;
-    Gua_Matrix *m1;
-    Gua_Integer i;
-    Gua_String errMessage;
-    
-    if (Gua_PObjectType(a) != OBJECT_TYPE_MATRIX) {
-        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-        sprintf(errMessage, "%s...\n", "illegal operand");
-        strcat(error, errMessage);
-        Gua_Free(errMessage);
-        
-        return GUA_ERROR;
-    }
-    
-    Gua_ClearObject(c);
+    Gua_Integer *row;
+    Gua_Integer *brow;
+    Gua_Integer x;
+    Gua_Length i;
+    Gua_Length j;
+    Gua_Length k;
     
-    m1 = (Gua_Matrix *)Gua_PObjectToMatrix(a);
-    
-    if (m1) {
-        if (!Gua_IsPObjectStored(b)) {
-            Gua_FreeObject(b);
-        } else {
-            Gua_ClearPObject(b);
-        }
+    for (i = 0; i < n; i++) {
+        row = c + i * n;
         
-        if (m1->dimc > 2) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "only bidimensional matrices are supported");
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
+        for (j = 0; j < n; j++) {
+            row[j] = 0;
         }
-        
-        if ((n < 0) && (n != -1)) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "illegal operand");
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
+        for (k = 0; k < n; k++) {
+            x = a[i * n + k];
             
-            return GUA_ERROR;
-        }
-        
-        if (n == 0) {
-            Gua_IdentMatrix(b, m1->dimv[0], error);
-            return GUA_OK;
-        }
-        if (n == -1) {
-            Gua_InvMatrix(a, b, error);
-            return GUA_OK;
-        }
-        
-        Gua_CopyMatrix(&c, a, false);
-        
-        for (i = 1; i < n; i++) {
-            if (Gua_MulMatrix(a, &c, b, error) != GUA_OK) {
-                if (!Gua_IsObjectStored(c)) {
-                    Gua_FreeObject(&c);
-                }
-                return GUA_ERROR;
+            if (x == 0) {
+                continue;
             }
-            if (!Gua_IsObjectStored(c)) {
-                Gua_FreeObject(&c);
+            
+            brow = b + k * n;
+            
+            for (j = 0; j < n; j++) {
+                row[j] = row[j] + x * brow[j];
             }
-            Gua_CopyMatrix(&c, b, false);
-        }
-        
-        if (!Gua_IsObjectStored(c)) {
-            Gua_FreeObject(&c);
         }
     }
-    
-    return GUA_OK;
 }
 
 /**
@@ -5343,110 +5651,41 @@ Gua_Status Gua_PowMatrix(Gua_Object *a, Gua_Integer n, Gua_Object *b, Gua_String
  *     C
  *
  * Function:
- *     Gua_Status Gua_AndMatrix(Gua_Object *a, Gua_Object *b, Gua_Object *c, Gua_String error)
+ *     Gua_Short Gua_GetMatrixType(Gua_Object *o, Gua_Length n)
  *
  * Description:
- *     Perform boolean AND between two matrices.
+ *     Find the narrowest numeric type holding every element of a matrix.
  *
  * Arguments:
- *     a,        a matrix;
- *     b,        a matrix;
- *     c,        a structure containing the return object of the function;
- *     error,    a pointer to the error message.
+ *     o,    the matrix elements;
+ *     n,    the number of elements.
  *
  * Results:
- *     The function returns the matrix C = A && B.
+ *     The function returns OBJECT_TYPE_INTEGER, OBJECT_TYPE_REAL or
+ *     OBJECT_TYPE_COMPLEX, or OBJECT_TYPE_UNKNOWN if an element is not a number.
  */
-Gua_Status Gua_AndMatrix(Gua_Object *a, Gua_Object *b, Gua_Object *c, Gua_String error)
+Gua_Short Gua_GetMatrixType(Gua_Object *o, Gua_Length n)
 {
-    Gua_Matrix *m1;
-    Gua_Matrix *m2;
-    Gua_Matrix *m3;
-    Gua_Object *o1;
-    Gua_Object *o2;
-    Gua_Object *o3;
-    Gua_Integer i;
-    Gua_String errMessage;
-    
-    if (!((Gua_PObjectType(a) == OBJECT_TYPE_MATRIX) && (Gua_PObjectType(b) == OBJECT_TYPE_MATRIX))) {
-        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-        sprintf(errMessage, "%s...\n", "illegal operand");
-        strcat(error, errMessage);
-        Gua_Free(errMessage);
-        
-        return GUA_ERROR;
-    }
+    Gua_Short type;
+    Gua_Length i;
     
-    m1 = (Gua_Matrix *)Gua_PObjectToMatrix(a);
-    m2 = (Gua_Matrix *)Gua_PObjectToMatrix(b);
+    type = OBJECT_TYPE_INTEGER;
     
-    if (m1 && m2) {
-        if (!Gua_IsPObjectStored(c)) {
-            Gua_FreeObject(c);
-        } else {
-            Gua_ClearPObject(c);
-        }
-        
-        if (Gua_PObjectLength(a) != Gua_PObjectLength(b)) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "the matrices do not have the same size");
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
-        }
-        if (m1->dimc > 2) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "only bidimensional matrices are supported");
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
-        }
-        
-        for (i = 0; i < m1->dimc; i++) {
-            if (m1->dimv[i] != m2->dimv[i]) {
-                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-                sprintf(errMessage, "%s...\n", "the matrices do not have the same dimensions");
-                strcat(error, errMessage);
-                Gua_Free(errMessage);
-                
-                return GUA_ERROR;
-            }
-        }
-        
-        o1 = (Gua_Object *)m1->object;
-        o2 = (Gua_Object *)m2->object;
-        
-        Gua_MatrixToPObject(c, (struct Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix)), Gua_PObjectLength(a));
-        
-        m3 = (Gua_Matrix *)Gua_PObjectToMatrix(c);
-        
-        m3->dimc = m1->dimc;
-        
-        m3->dimv = Gua_Alloc(m3->dimc * sizeof(Gua_Integer));
-        
-        for (i = 0; i < m3->dimc; i++) {
-            m3->dimv[i] = m1->dimv[i];
-        }
-        
-        m3->object = (struct Gua_Object *)Gua_Alloc(Gua_PObjectLength(a) * sizeof(Gua_Object));
-        o3 = (Gua_Object *)m3->object;
-        
-        for (i = 0; i < Gua_PObjectLength(a); i++) {
-            if ((Gua_ObjectType(o1[i]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(o2[i]) == OBJECT_TYPE_INTEGER)) {
-                Gua_IntegerToObject(o3[i], Gua_ObjectToInteger(o1[i]) && Gua_ObjectToInteger(o2[i]));
-            } else if ((Gua_ObjectType(o1[i]) == OBJECT_TYPE_REAL) && (Gua_ObjectType(o2[i]) == OBJECT_TYPE_REAL)) {
-                Gua_IntegerToObject(o3[i], Gua_ObjectToReal(o1[i]) && Gua_ObjectToReal(o2[i]));
-            } else if ((Gua_ObjectType(o1[i]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(o2[i]) == OBJECT_TYPE_REAL)) {
-                Gua_IntegerToObject(o3[i], Gua_ObjectToInteger(o1[i]) && Gua_ObjectToReal(o2[i]));
-            } else if ((Gua_ObjectType(o1[i]) == OBJECT_TYPE_REAL) && (Gua_ObjectType(o2[i]) == OBJECT_TYPE_INTEGER)) {
-                Gua_IntegerToObject(o3[i], Gua_ObjectToReal(o1[i]) && Gua_ObjectToInteger(o2[i]));
+    for (i = 0; i < n; i++) {
+        if (Gua_ObjectType(o[i]) == OBJECT_TYPE_INTEGER) {
+            continue;
+        } else if (Gua_ObjectType(o[i]) == OBJECT_TYPE_REAL) {
+            if (type == OBJECT_TYPE_INTEGER) {
+                type = OBJECT_TYPE_REAL;
             }
+        } else if (Gua_ObjectType(o[i]) == OBJECT_TYPE_COMPLEX) {
+            type = OBJECT_TYPE_COMPLEX;
+        } else {
+            return OBJECT_TYPE_UNKNOWN;
         }
     }
     
-    return GUA_OK;
+    return type;
 }
 
 /**
@@ -5454,110 +5693,171 @@ Gua_Status Gua_AndMatrix(Gua_Object *a, Gua_Object *b, Gua_Object *c, Gua_String
  *     C
  *
  * Function:
- *     Gua_Status Gua_OrMatrix(Gua_Object *a, Gua_Object *b, Gua_Object *c, Gua_String error)
+ *     void Gua_PackMatrix(Gua_Object *o, Gua_Length n, Gua_Real *re, Gua_Real *im)
  *
  * Description:
- *     Perform boolean OR between two matrices.
+ *     Copy the numeric elements of a matrix to separate planes of real and
+ *     imaginary parts, which the arithmetic kernels can run over without
+ *     testing the type of each element.
  *
  * Arguments:
- *     a,        a matrix;
- *     b,        a matrix;
- *     c,        a structure containing the return object of the function;
- *     error,    a pointer to the error message.
+ *     o,     the matrix elements;
+ *     n,     the number of elements;
+ *     re,    the real parts;
+ *     im,    the imaginary parts, or NULL to drop them.
  *
  * Results:
- *     The function returns the matrix C = A && B.
+ *     The function fills re and im.
  */
-Gua_Status Gua_OrMatrix(Gua_Object *a, Gua_Object *b, Gua_Object *c, Gua_String error)
+void Gua_PackMatrix(Gua_Object *o, Gua_Length n, Gua_Real *re, Gua_Real *im)
 {
-    Gua_Matrix *m1;
-    Gua_Matrix *m2;
-    Gua_Matrix *m3;
-    Gua_Object *o1;
-    Gua_Object *o2;
-    Gua_Object *o3;
-    Gua_Integer i;
-    Gua_String errMessage;
+    Gua_Length i;
     
-    if (!((Gua_PObjectType(a) == OBJECT_TYPE_MATRIX) && (Gua_PObjectType(b) == OBJECT_TYPE_MATRIX))) {
-        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-        sprintf(errMessage, "%s...\n", "illegal operand");
-        strcat(error, errMessage);
-        Gua_Free(errMessage);
-        
-        return GUA_ERROR;
+    for (i = 0; i < n; i++) {
+        if (Gua_ObjectType(o[i]) == OBJECT_TYPE_INTEGER) {
+            re[i] = Gua_ObjectToInteger(o[i]);
+        } else {
+            re[i] = Gua_ObjectToReal(o[i]);
+        }
     }
     
-    m1 = (Gua_Matrix *)Gua_PObjectToMatrix(a);
-    m2 = (Gua_Matrix *)Gua_PObjectToMatrix(b);
+    if (im != NULL) {
+        for (i = 0; i < n; i++) {
+            im[i] = Gua_ObjectType(o[i]) == OBJECT_TYPE_COMPLEX ? Gua_ObjectToImaginary(o[i]) : 0.0;
+        }
+    }
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Gua_UnpackMatrix(Gua_Object *o, Gua_Length n, Gua_Real *re, Gua_Real *im)
+ *
+ * Description:
+ *     Store planes of real and imaginary parts in the elements of a matrix.
+ *
+ * Arguments:
+ *     o,     the matrix elements;
+ *     n,     the number of elements;
+ *     re,    the real parts;
+ *     im,    the imaginary parts, or NULL to store real numbers.
+ *
+ * Results:
+ *     The function overwrites the n elements with real or complex numbers.
+ */
+void Gua_UnpackMatrix(Gua_Object *o, Gua_Length n, Gua_Real *re, Gua_Real *im)
+{
+    Gua_Length i;
     
-    if (m1 && m2) {
-        if (!Gua_IsPObjectStored(c)) {
-            Gua_FreeObject(c);
-        } else {
-            Gua_ClearPObject(c);
+    if (im != NULL) {
+        for (i = 0; i < n; i++) {
+            Gua_ComplexToObject(o[i], re[i], im[i]);
         }
-        
-        if (Gua_PObjectLength(a) != Gua_PObjectLength(b)) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "the matrices do not have the same size");
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
+    } else {
+        for (i = 0; i < n; i++) {
+            Gua_RealToObject(o[i], re[i]);
         }
-        if (m1->dimc > 2) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "only bidimensional matrices are supported");
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
+    }
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Gua_GemmBuffer(Gua_Real *a, Gua_Real *ai, Gua_Real *b, Gua_Real *bi, Gua_Real *c, Gua_Real *ci, Gua_Length m, Gua_Length n, Gua_Length p)
+ *
+ * Description:
+ *     Multiply the m x n row-major buffer a by the n x p buffer b into c.
+ *     When the imaginary parts ai, bi and ci are not NULL the buffers hold
+ *     complex numbers, with the real and imaginary parts kept in separate
+ *     planes, so the inner loop is a plain stream of multiply-adds the
+ *     compiler can vectorize. The loops over n and p are blocked so the
+ *     rows of b in use stay in the cache.
+ *
+ * Arguments:
+ *     a,        the real part of the left operand;
+ *     ai,       the imaginary part of the left operand, or NULL;
+ *     b,        the real part of the right operand;
+ *     bi,       the imaginary part of the right operand, or NULL;
+ *     c,        the real part of the result, which must not overlap a or b;
+ *     ci,       the imaginary part of the result, or NULL;
+ *     m,        the number of rows of a and c;
+ *     n,        the number of columns of a and rows of b;
+ *     p,        the number of columns of b and c.
+ *
+ * Results:
+ *     The function stores C = A * B in c and ci.
+ */
+void Gua_GemmBuffer(Gua_Real *a, Gua_Real *ai, Gua_Real *b, Gua_Real *bi, Gua_Real *c, Gua_Real *ci, Gua_Length m, Gua_Length n, Gua_Length p)
+{
+    Gua_Real *row;
+    Gua_Real *rowi;
+    Gua_Real *brow;
+    Gua_Real *browi;
+    Gua_Real x;
+    Gua_Real xi;
+    Gua_Length i;
+    Gua_Length j;
+    Gua_Length k;
+    Gua_Length j0;
+    Gua_Length j1;
+    Gua_Length k0;
+    Gua_Length k1;
+    
+    memset(c, 0, m * p * sizeof(Gua_Real));
+    if (ci != NULL) {
+        memset(ci, 0, m * p * sizeof(Gua_Real));
+    }
+    
+    for (j0 = 0; j0 < p; j0 = j0 + GUA_GEMM_BLOCK_SIZE) {
+        j1 = j0 + GUA_GEMM_BLOCK_SIZE < p ? j0 + GUA_GEMM_BLOCK_SIZE : p;
+        
+        for (k0 = 0; k0 < n; k0 = k0 + GUA_GEMM_BLOCK_SIZE) {
+            k1 = k0 + GUA_GEMM_BLOCK_SIZE < n ? k0 + GUA_GEMM_BLOCK_SIZE : n;
             
-            return GUA_ERROR;
-        }
-        
-        for (i = 0; i < m1->dimc; i++) {
-            if (m1->dimv[i] != m2->dimv[i]) {
-                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-                sprintf(errMessage, "%s...\n", "the matrices do not have the same dimensions");
-                strcat(error, errMessage);
-                Gua_Free(errMessage);
+            for (i = 0; i < m; i++) {
+                row = c + i * p;
                 
-                return GUA_ERROR;
-            }
-        }
-        
-        o1 = (Gua_Object *)m1->object;
-        o2 = (Gua_Object *)m2->object;
-        
-        Gua_MatrixToPObject(c, (struct Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix)), Gua_PObjectLength(a));
-        
-        m3 = (Gua_Matrix *)Gua_PObjectToMatrix(c);
-        
-        m3->dimc = m1->dimc;
-        
-        m3->dimv = Gua_Alloc(m3->dimc * sizeof(Gua_Integer));
-        
-        for (i = 0; i < m3->dimc; i++) {
-            m3->dimv[i] = m1->dimv[i];
-        }
-        
-        m3->object = (struct Gua_Object *)Gua_Alloc(Gua_PObjectLength(a) * sizeof(Gua_Object));
-        o3 = (Gua_Object *)m3->object;
-        
-        for (i = 0; i < Gua_PObjectLength(a); i++) {
-            if ((Gua_ObjectType(o1[i]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(o2[i]) == OBJECT_TYPE_INTEGER)) {
-                Gua_IntegerToObject(o3[i], Gua_ObjectToInteger(o1[i]) || Gua_ObjectToInteger(o2[i]));
-            } else if ((Gua_ObjectType(o1[i]) == OBJECT_TYPE_REAL) && (Gua_ObjectType(o2[i]) == OBJECT_TYPE_REAL)) {
-                Gua_IntegerToObject(o3[i], Gua_ObjectToReal(o1[i]) || Gua_ObjectToReal(o2[i]));
-            } else if ((Gua_ObjectType(o1[i]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(o2[i]) == OBJECT_TYPE_REAL)) {
-                Gua_IntegerToObject(o3[i], Gua_ObjectToInteger(o1[i]) || Gua_ObjectToReal(o2[i]));
-            } else if ((Gua_ObjectType(o1[i]) == OBJECT_TYPE_REAL) && (Gua_ObjectType(o2[i]) == OBJECT_TYPE_INTEGER)) {
-                Gua_IntegerToObject(o3[i], Gua_ObjectToReal(o1[i]) || Gua_ObjectToInteger(o2[i]));
+                if (ci == NULL) {
+                    for (k = k0; k < k1; k++) {
+                        x = a[i * n + k];
+                        
+                        if (x == 0.0) {
+                            continue;
+                        }
+                        
+                        brow = b + k * p;
+                        
+                        for (j = j0; j < j1; j++) {
+                            row[j] = row[j] + x * brow[j];
+                        }
+                    }
+                } else {
+                    rowi = ci + i * p;
+                    
+                    for (k = k0; k < k1; k++) {
+                        x = a[i * n + k];
+                        xi = ai[i * n + k];
+                        
+                        if ((x == 0.0) && (xi == 0.0)) {
+                            continue;
+                        }
+                        
+                        brow = b + k * p;
+                        browi = bi + k * p;
+                        
+                        for (j = j0; j < j1; j++) {
+                            row[j] = row[j] + x * brow[j] - xi * browi[j];
+                            rowi[j] = rowi[j] + x * browi[j] + xi * brow[j];
+                        }
+                    }
+                }
             }
         }
     }
-    
-    return GUA_OK;
 }
 
 /**
@@ -5565,210 +5865,316 @@ Gua_Status Gua_OrMatrix(Gua_Object *a, Gua_Object *b, Gua_Object *c, Gua_String
  *     C
  *
  * Function:
- *     Gua_Status Gua_AndOrMatrix(Gua_Object *a, Gua_Object *b, Gua_Object *c, Gua_String error)
+ *     void Gua_MulRealBuffer(Gua_Real *a, Gua_Real *ai, Gua_Real *b, Gua_Real *bi, Gua_Real *c, Gua_Real *ci, Gua_Length n)
  *
  * Description:
- *     Multiply two boolean matrices.
+ *     Multiply the n x n row-major real buffers a and b into c. When the
+ *     imaginary parts ai, bi and ci are not NULL the buffers hold complex
+ *     numbers, with the real and imaginary parts kept in separate arrays.
  *
  * Arguments:
- *     a,        a matrix;
- *     b,        a matrix;
- *     c,        a structure containing the return object of the function;
+ *     a,        the real part of the left operand;
+ *     ai,       the imaginary part of the left operand, or NULL;
+ *     b,        the real part of the right operand;
+ *     bi,       the imaginary part of the right operand, or NULL;
+ *     c,        the real part of the result, which must not overlap a or b;
+ *     ci,       the imaginary part of the result, or NULL;
+ *     n,        the order of the matrices.
+ *
+ * Results:
+ *     The function stores C = A * B in c and ci.
+ */
+void Gua_MulRealBuffer(Gua_Real *a, Gua_Real *ai, Gua_Real *b, Gua_Real *bi, Gua_Real *c, Gua_Real *ci, Gua_Length n)
+{
+    Gua_GemmBuffer(a, ai, b, bi, c, ci, n, n, n);
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Gua_PowMatrix(Gua_Object *a, Gua_Integer n, Gua_Object *b, Gua_String error)
+ *
+ * Description:
+ *     Calculate the power of the matrix a by n. Numeric matrices are raised
+ *     by repeated squaring over flat work buffers, so only O(log n) matrix
+ *     products are needed. A negative power inverts the matrix once and then
+ *     raises the inverse to -n.
+ *
+ * Arguments:
+ *     a,        a square matrix;
+ *     n,        an integer power;
+ *     b,        a structure containing the return object of the function;
  *     error,    a pointer to the error message.
  *
  * Results:
- *     The function returns the matrix C = A * B(boolean multiplication).
+ *     The function returns the matrix B = A ** n.
  */
-Gua_Status Gua_AndOrMatrix(Gua_Object *a, Gua_Object *b, Gua_Object *c, Gua_String error)
+Gua_Status Gua_PowMatrix(Gua_Object *a, Gua_Integer n, Gua_Object *b, Gua_String error)
 {
+    Gua_Object c;
+    Gua_Object d;
+    Gua_Object e;
+    Gua_Object inverse;
     Gua_Matrix *m1;
     Gua_Matrix *m2;
-    Gua_Matrix *m3;
     Gua_Object *o1;
     Gua_Object *o2;
-    Gua_Object *o3;
-    Gua_Integer i;
-    Gua_Integer j;
-    Gua_Integer k;
-    Gua_Integer m;
-    Gua_Integer n;
-    Gua_Integer p;
+    Gua_Integer *ibuffer;
+    Gua_Integer *ir;
+    Gua_Integer *is;
+    Gua_Integer *it;
+    Gua_Integer *iswap;
+    Gua_Real *buffer;
+    Gua_Real *r;
+    Gua_Real *ri;
+    Gua_Real *s;
+    Gua_Real *si;
+    Gua_Real *t;
+    Gua_Real *ti;
+    Gua_Real *swap;
+    Gua_Length order;
+    Gua_Length size;
+    Gua_Length i;
+    Gua_Short type;
+    Gua_Short first;
+    Gua_Status status;
     Gua_String errMessage;
     
     if (Gua_PObjectType(a) != OBJECT_TYPE_MATRIX) {
         errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-        sprintf(errMessage, "%s...\n", "illegal operand 1");
+        sprintf(errMessage, "%s...\n", "illegal operand");
         strcat(error, errMessage);
         Gua_Free(errMessage);
         
         return GUA_ERROR;
     }
-    if (Gua_PObjectType(b) != OBJECT_TYPE_MATRIX) {
+    
+    m1 = (Gua_Matrix *)Gua_PObjectToMatrix(a);
+    
+    if (m1 == NULL) {
+        return GUA_OK;
+    }
+    
+    if (m1->dimc > 2) {
         errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-        sprintf(errMessage, "%s...\n", "illegal operand 2");
+        sprintf(errMessage, "%s...\n", "only bidimensional matrices are supported");
         strcat(error, errMessage);
         Gua_Free(errMessage);
         
         return GUA_ERROR;
     }
     
-    m1 = (Gua_Matrix *)Gua_PObjectToMatrix(a);
-    m2 = (Gua_Matrix *)Gua_PObjectToMatrix(b);
+    if ((m1->dimc != 2) || (m1->dimv[0] != m1->dimv[1])) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "the matrix must be square");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
     
-    if (m1 && m2) {
-        if (!Gua_IsPObjectStored(c)) {
-            Gua_FreeObject(c);
-        } else {
-            Gua_ClearPObject(c);
-        }
+    if (n == 0) {
+        return Gua_IdentMatrix(b, m1->dimv[0], error);
+    }
+    
+    /* A negative power is the positive power of the inverse. */
+    if (n < 0) {
+        Gua_ClearObject(inverse);
         
-        if (m1->dimc > 2) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "only bidimensional matrices are supported");
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
+        if (Gua_InvMatrix(a, &inverse, error) != GUA_OK) {
+            Gua_FreeObject(&inverse);
             return GUA_ERROR;
         }
-        
-        if (m1->dimv[1] != m2->dimv[0]) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "the matrices do not have compatible dimensions");
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
+        if (n == -1) {
+            if (!Gua_IsPObjectStored(b)) {
+                Gua_FreeObject(b);
+            } else {
+                Gua_ClearPObject(b);
+            }
+            Gua_LinkToPObject(b, inverse);
             
-            return GUA_ERROR;
+            return GUA_OK;
         }
         
-        o1 = (Gua_Object *)m1->object;
-        o2 = (Gua_Object *)m2->object;
-        
-        /* A(m x n), B(n x p), C(m x p) */
-        m = m1->dimv[0];
-        n = m1->dimv[1];
-        p = m2->dimv[1];
+        status = Gua_PowMatrix(&inverse, -n, b, error);
         
-        Gua_MatrixToPObject(c, (struct Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix)), m * p);
-        m3 = (Gua_Matrix *)Gua_PObjectToMatrix(c);
+        Gua_FreeObject(&inverse);
         
-        m3->dimc = 2;
-        m3->dimv = Gua_Alloc(m3->dimc * sizeof(Gua_Integer));
+        return status;
+    }
+    
+    order = m1->dimv[0];
+    size = order * order;
+    o1 = (Gua_Object *)m1->object;
+    
+    /* Find the narrowest numeric type holding every element. */
+    type = Gua_GetMatrixType(o1, size);
+    
+    if (type == OBJECT_TYPE_UNKNOWN) {
+        /* Non numeric elements keep the generic product semantics. */
+        Gua_ClearObject(c);
+        Gua_ClearObject(d);
+        Gua_ClearObject(e);
         
-        m3->dimv[0] = m;
-        m3->dimv[1] = p;
+        Gua_CopyMatrix(&c, a, false);
         
-        m3->object = (struct Gua_Object *)Gua_Alloc(m * p * sizeof(Gua_Object));
-        o3 = (Gua_Object *)m3->object;
+        first = true;
+        status = GUA_OK;
         
-        /* Clear each element of matrix C. */ 
-        for (i = 0; i < m; i++) {
-            for (j = 0; j < p; j++) {
-                Gua_ClearObject(o3[i * p + j]);
-            }
-        }
-
-        /* C(i,j) = sum(A(i,k) * B(k,j)) */
-        for (i = 0; i < m; i++) {
-            for (j = 0; j < p; j++) {
-                for (k = 0; k < n; k++) {            
-                    if ((Gua_ObjectType(o1[i * n + k]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(o2[k * p + j]) == OBJECT_TYPE_INTEGER)) {
-                        Gua_IntegerToObject(o3[i * p + j], Gua_ObjectToInteger(o3[i * p + j]) || (Gua_ObjectToInteger(o1[i * n + k]) && Gua_ObjectToInteger(o2[k * p + j])));
-                    } else if ((Gua_ObjectType(o1[i * n + k]) == OBJECT_TYPE_REAL) && (Gua_ObjectType(o2[k * p + j]) == OBJECT_TYPE_REAL)) {
-                        Gua_RealToObject(o3[i * p + j], Gua_ObjectToReal(o3[i * p + j]) || (Gua_ObjectToReal(o1[i * n + k]) && Gua_ObjectToReal(o2[k * p + j])));
-                    } else if ((Gua_ObjectType(o1[i * n + k]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(o2[k * p + j]) == OBJECT_TYPE_REAL)) {
-                        Gua_RealToObject(o3[i * p + j], Gua_ObjectToReal(o3[i * p + j]) || (Gua_ObjectToInteger(o1[i * n + k]) && Gua_ObjectToReal(o2[k * p + j])));
-                    } else if ((Gua_ObjectType(o1[i * n + k]) == OBJECT_TYPE_REAL) && (Gua_ObjectType(o2[k * p + j]) == OBJECT_TYPE_INTEGER)) {
-                        Gua_RealToObject(o3[i * p + j], Gua_ObjectToReal(o3[i * p + j]) || (Gua_ObjectToReal(o1[i * n + k]) && Gua_ObjectToInteger(o2[k * p + j])));
+        while (n > 0) {
+            if (n & 1) {
+                if (first) {
+                    Gua_CopyMatrix(&d, &c, false);
+                    first = false;
+                } else {
+                    if ((status = Gua_MulMatrix(&d, &c, &e, error)) != GUA_OK) {
+                        break;
                     }
+                    Gua_FreeObject(&d);
+                    Gua_LinkObjects(d, e);
+                    Gua_ClearObject(e);
+                }
+            }
+            
+            n = n >> 1;
+            
+            if (n > 0) {
+                if ((status = Gua_MulMatrix(&c, &c, &e, error)) != GUA_OK) {
+                    break;
                 }
+                Gua_FreeObject(&c);
+                Gua_LinkObjects(c, e);
+                Gua_ClearObject(e);
             }
         }
+        
+        Gua_FreeObject(&c);
+        Gua_FreeObject(&e);
+        
+        if (status != GUA_OK) {
+            Gua_FreeObject(&d);
+            return status;
+        }
+        
+        if (!Gua_IsPObjectStored(b)) {
+            Gua_FreeObject(b);
+        } else {
+            Gua_ClearPObject(b);
+        }
+        Gua_LinkToPObject(b, d);
+        
+        return GUA_OK;
     }
     
-    return GUA_OK;
-}
-
-/**
- * Group:
- *     C
- *
- * Function:
- *     Gua_Status Gua_CopyFile(Gua_Object *target, Gua_Object *source, Gua_Stored stored)
- *
- * Description:
- *     Copy a handle to other.
- *
- * Arguments:
- *     target,    the target handle;
- *     source,    the source handle;
- *     stored,    if TRUE the object of the target handle is stored in a variable.
- *
- * Results:
- *     The function makes a copy of a handle to other.
- */
-Gua_Status Gua_CopyFile(Gua_Object *target, Gua_Object *source, Gua_Stored stored)
-{
-    Gua_File *ht;
-    Gua_File *hs;
+    if (!Gua_IsPObjectStored(b)) {
+        Gua_FreeObject(b);
+    } else {
+        Gua_ClearPObject(b);
+    }
     
-    hs = (Gua_File *)Gua_PObjectToFile(source);
+    Gua_MatrixToPObject(b, (struct Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix)), size);
+    m2 = (Gua_Matrix *)Gua_PObjectToMatrix(b);
     
-    if (hs) {
-        if (!Gua_IsPObjectStored(target)) {
-            Gua_FreeObject(target);
-        } else {
-            Gua_ClearPObject(target);
+    m2->dimc = 2;
+    m2->dimv = (Gua_Length *)Gua_Alloc(2 * sizeof(Gua_Length));
+    m2->dimv[0] = order;
+    m2->dimv[1] = order;
+    m2->object = (struct Gua_Object *)Gua_Alloc(size * sizeof(Gua_Object));
+    o2 = (Gua_Object *)m2->object;
+    
+    /*
+     * The result, the running square and one scratch buffer are swapped
+     * between products, so no memory is allocated inside the loop.
+     */
+    if (type == OBJECT_TYPE_INTEGER) {
+        ibuffer = (Gua_Integer *)Gua_Alloc(3 * size * sizeof(Gua_Integer));
+        ir = ibuffer;
+        is = ir + size;
+        it = is + size;
+        
+        for (i = 0; i < size; i++) {
+            is[i] = Gua_ObjectToInteger(o1[i]);
         }
         
-        Gua_NewFile(ht, hs->file);
-        Gua_LinkFilesFunctions(ht, hs);
+        first = true;
         
-        Gua_FileToPObject(target, (struct Gua_File *)ht);
-        Gua_SetPObjectStoredState(target, stored);
+        while (n > 0) {
+            if (n & 1) {
+                if (first) {
+                    memcpy(ir, is, size * sizeof(Gua_Integer));
+                    first = false;
+                } else {
+                    Gua_MulIntegerBuffer(ir, is, it, order);
+                    iswap = ir; ir = it; it = iswap;
+                }
+            }
+            
+            n = n >> 1;
+            
+            if (n > 0) {
+                Gua_MulIntegerBuffer(is, is, it, order);
+                iswap = is; is = it; it = iswap;
+            }
+        }
+        
+        for (i = 0; i < size; i++) {
+            Gua_IntegerToObject(o2[i], ir[i]);
+        }
+        
+        Gua_Free(ibuffer);
+        
+        return GUA_OK;
     }
     
-    return GUA_ERROR;
-}
-
-/**
- * Group:
- *     C
- *
- * Function:
- *     Gua_Status Gua_CopyHandle(Gua_Object *target, Gua_Object *source, Gua_Stored stored)
- *
- * Description:
- *     Copy a handle to other.
- *
- * Arguments:
- *     target,    the target handle;
- *     source,    the source handle;
- *     stored,    if TRUE the object of the target handle is stored in a variable.
- *
- * Results:
- *     The function makes a copy of a handle to other.
- */
-Gua_Status Gua_CopyHandle(Gua_Object *target, Gua_Object *source, Gua_Stored stored)
-{
-    Gua_Handle *ht;
-    Gua_Handle *hs;
+    buffer = (Gua_Real *)Gua_Alloc((type == OBJECT_TYPE_COMPLEX ? 6 : 3) * size * sizeof(Gua_Real));
+    r = buffer;
+    s = r + size;
+    t = s + size;
+    ri = NULL;
+    si = NULL;
+    ti = NULL;
     
-    hs = (Gua_Handle *)Gua_PObjectToHandle(source);
+    if (type == OBJECT_TYPE_COMPLEX) {
+        ri = t + size;
+        si = ri + size;
+        ti = si + size;
+    }
     
-    if (hs) {
-        if (!Gua_IsPObjectStored(target)) {
-            Gua_FreeObject(target);
-        } else {
-            Gua_ClearPObject(target);
+    Gua_PackMatrix(o1, size, s, si);
+    
+    first = true;
+    
+    while (n > 0) {
+        if (n & 1) {
+            if (first) {
+                memcpy(r, s, size * sizeof(Gua_Real));
+                if (si != NULL) {
+                    memcpy(ri, si, size * sizeof(Gua_Real));
+                }
+                first = false;
+            } else {
+                Gua_MulRealBuffer(r, ri, s, si, t, ti, order);
+                swap = r; r = t; t = swap;
+                swap = ri; ri = ti; ti = swap;
+            }
         }
         
-        Gua_NewHandle(ht, hs->type, hs->pointer);
+        n = n >> 1;
         
-        Gua_HandleToPObject(target, (struct Gua_Handle *)ht);
-        Gua_SetPObjectStoredState(target, stored);
+        if (n > 0) {
+            Gua_MulRealBuffer(s, si, s, si, t, ti, order);
+            swap = s; s = t; t = swap;
+            swap = si; si = ti; ti = swap;
+        }
     }
     
-    return GUA_ERROR;
+    Gua_UnpackMatrix(o2, size, r, ri);
+    
+    Gua_Free(buffer);
+    
+    return GUA_OK;
 }
 
 /**
@@ -5776,443 +6182,509 @@ Gua_Status Gua_CopyHandle(Gua_Object *target, Gua_Object *source, Gua_Stored sto
  *     C
  *
  * Function:
- *     Gua_Status Gua_BuiltInFunction(void *nspace, Gua_Short argc, Gua_Object *argv, Gua_Object *object, Gua_String error)
+ *     Gua_Status Gua_AndMatrix(Gua_Object *a, Gua_Object *b, Gua_Object *c, Gua_String error)
  *
  * Description:
- *     Built in functions wrapper.
+ *     Perform boolean AND between two matrices.
  *
  * Arguments:
- *     nspace,    a pointer to a structure Gua_Namespace. Must do a cast before use it;
- *     argc,      the number of arguments to pass to the function;
- *     argv,      an array containing the arguments to the function,
- *                argv[0] is the function name;
- *     object,    a structure containing the return object of the function;
- *     error,     a pointer to the error message.
+ *     a,        a matrix;
+ *     b,        a matrix;
+ *     c,        a structure containing the return object of the function;
+ *     error,    a pointer to the error message.
  *
  * Results:
- *     The return object of the wrapped funcion.
+ *     The function returns the matrix C = A && B.
  */
-Gua_Status Gua_BuiltInFunction(void *nspace, Gua_Short argc, Gua_Object *argv, Gua_Object *object, Gua_String error)
+Gua_Status Gua_AndMatrix(Gua_Object *a, Gua_Object *b, Gua_Object *c, Gua_String error)
 {
-    Gua_Status status;
-    Gua_Object key;
-    Gua_Matrix *m;
-    Gua_Object *o;
-    Gua_Object v1;
-    Gua_Function f1;
-    Gua_String string;
-    Gua_Length length;
+    Gua_Matrix *m1;
+    Gua_Matrix *m2;
+    Gua_Matrix *m3;
+    Gua_Object *o1;
+    Gua_Object *o2;
+    Gua_Object *o3;
     Gua_Integer i;
-    Gua_Integer j;
-    Gua_Integer n;
-    Gua_Integer p;
     Gua_String errMessage;
     
-    Gua_ClearPObject(object);
-    
-    if (argc == 0) {
+    if (!((Gua_PObjectType(a) == OBJECT_TYPE_MATRIX) && (Gua_PObjectType(b) == OBJECT_TYPE_MATRIX))) {
         errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-        sprintf(errMessage, "%s\n", "no function specified");
+        sprintf(errMessage, "%s...\n", "illegal operand");
         strcat(error, errMessage);
         Gua_Free(errMessage);
         
         return GUA_ERROR;
     }
     
-    if (strcmp(Gua_ObjectToString(argv[0]), "array") == 0) {
-        if (argc < 2) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
-        }
-        
-        for (i = 1; i < argc; i++) {
-            Gua_IntegerToObject(key, i - 1);
-            
-            status = Gua_SetArrayElement(object, &key, &argv[i], false);
-            
-            if (status != GUA_OK) {
-                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-                sprintf(errMessage, "%s...", Gua_StatusTable[GUA_ERROR_ILLEGAL_ASSIGNMENT]);
-                strcat(error, errMessage);
-                Gua_Free(errMessage);
-                
-                return GUA_ERROR;
-            }
-        }
-    } else if (strcmp(Gua_ObjectToString(argv[0]), "arrayToString") == 0) {
-        if (argc != 2) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
-        }
-        
-        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_ARRAY) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
+    m1 = (Gua_Matrix *)Gua_PObjectToMatrix(a);
+    m2 = (Gua_Matrix *)Gua_PObjectToMatrix(b);
+    
+    if (m1 && m2) {
+        if (!Gua_IsPObjectStored(c)) {
+            Gua_FreeObject(c);
+        } else {
+            Gua_ClearPObject(c);
         }
         
-        if (Gua_ArrayToString(&argv[1], object) != GUA_OK) {
+        if (Gua_PObjectLength(a) != Gua_PObjectLength(b)) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...", Gua_StatusTable[GUA_ERROR]);
+            sprintf(errMessage, "%s...\n", "the matrices do not have the same size");
             strcat(error, errMessage);
             Gua_Free(errMessage);
             
             return GUA_ERROR;
         }
-    } else if (strcmp(Gua_ObjectToString(argv[0]), "break") == 0) {
-        if (argc != 1) {
+        if (m1->dimc > 2) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            sprintf(errMessage, "%s...\n", "only bidimensional matrices are supported");
             strcat(error, errMessage);
             Gua_Free(errMessage);
             
             return GUA_ERROR;
         }
         
-        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-        sprintf(errMessage, "%s...\n", "\"break\" outside of a loop");
-        strcat(error, errMessage);
-        Gua_Free(errMessage);
-        
-        return GUA_BREAK;
-    } else if (strcmp(Gua_ObjectToString(argv[0]), "complex") == 0) {
-        if (argc != 3) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
+        for (i = 0; i < m1->dimc; i++) {
+            if (m1->dimv[i] != m2->dimv[i]) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s...\n", "the matrices do not have the same dimensions");
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
         }
         
-        if (!((Gua_ObjectType(argv[1]) == OBJECT_TYPE_INTEGER) || (Gua_ObjectType(argv[1]) == OBJECT_TYPE_REAL))) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
-        }
+        o1 = (Gua_Object *)m1->object;
+        o2 = (Gua_Object *)m2->object;
         
-        if (!((Gua_ObjectType(argv[2]) == OBJECT_TYPE_INTEGER) || (Gua_ObjectType(argv[2]) == OBJECT_TYPE_REAL))) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
-        }
+        Gua_MatrixToPObject(c, (struct Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix)), Gua_PObjectLength(a));
         
-        if ((Gua_ObjectType(argv[1]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(argv[2]) == OBJECT_TYPE_INTEGER)) {
-            Gua_ComplexToPObject(object, Gua_ObjectToInteger(argv[1]), Gua_ObjectToInteger(argv[2]));
-        } else if ((Gua_ObjectType(argv[1]) == OBJECT_TYPE_REAL) && (Gua_ObjectType(argv[2]) == OBJECT_TYPE_REAL)) {
-            Gua_ComplexToPObject(object, Gua_ObjectToReal(argv[1]), Gua_ObjectToReal(argv[2]));
-        } else if ((Gua_ObjectType(argv[1]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(argv[2]) == OBJECT_TYPE_REAL)) {
-            Gua_ComplexToPObject(object, Gua_ObjectToInteger(argv[1]), Gua_ObjectToReal(argv[2]));
-        } else if ((Gua_ObjectType(argv[1]) == OBJECT_TYPE_REAL) && (Gua_ObjectType(argv[2]) == OBJECT_TYPE_INTEGER)) {
-            Gua_ComplexToPObject(object, Gua_ObjectToReal(argv[1]), Gua_ObjectToInteger(argv[2]));
-        }
-    } else if (strcmp(Gua_ObjectToString(argv[0]), "continue") == 0) {
-        if (argc != 1) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
-        }
+        m3 = (Gua_Matrix *)Gua_PObjectToMatrix(c);
         
-        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-        sprintf(errMessage, "%s...\n", "\"continue\" outside of a loop");
-        strcat(error, errMessage);
-        Gua_Free(errMessage);
+        m3->dimc = m1->dimc;
         
-        return GUA_CONTINUE;
-    } else if (strcmp(Gua_ObjectToString(argv[0]), "dim") == 0) {
-        if (argc != 2) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
-        }
+        m3->dimv = Gua_Alloc(m3->dimc * sizeof(Gua_Integer));
         
-        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
+        for (i = 0; i < m3->dimc; i++) {
+            m3->dimv[i] = m1->dimv[i];
         }
         
-        if (Gua_GetMatrixDim(object, &argv[1]) != GUA_OK) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...", Gua_StatusTable[GUA_ERROR]);
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
-        }
-    } else if (strcmp(Gua_ObjectToString(argv[0]), "error") == 0) {
-        if (argc != 2) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
-        }
+        m3->object = (struct Gua_Object *)Gua_Alloc(Gua_PObjectLength(a) * sizeof(Gua_Object));
+        o3 = (Gua_Object *)m3->object;
         
-        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_STRING) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
+        for (i = 0; i < Gua_PObjectLength(a); i++) {
+            if ((Gua_ObjectType(o1[i]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(o2[i]) == OBJECT_TYPE_INTEGER)) {
+                Gua_IntegerToObject(o3[i], Gua_ObjectToInteger(o1[i]) && Gua_ObjectToInteger(o2[i]));
+            } else if ((Gua_ObjectType(o1[i]) == OBJECT_TYPE_REAL) && (Gua_ObjectType(o2[i]) == OBJECT_TYPE_REAL)) {
+                Gua_IntegerToObject(o3[i], Gua_ObjectToReal(o1[i]) && Gua_ObjectToReal(o2[i]));
+            } else if ((Gua_ObjectType(o1[i]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(o2[i]) == OBJECT_TYPE_REAL)) {
+                Gua_IntegerToObject(o3[i], Gua_ObjectToInteger(o1[i]) && Gua_ObjectToReal(o2[i]));
+            } else if ((Gua_ObjectType(o1[i]) == OBJECT_TYPE_REAL) && (Gua_ObjectType(o2[i]) == OBJECT_TYPE_INTEGER)) {
+                Gua_IntegerToObject(o3[i], Gua_ObjectToReal(o1[i]) && Gua_ObjectToInteger(o2[i]));
+            }
         }
-        
+    }
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Gua_OrMatrix(Gua_Object *a, Gua_Object *b, Gua_Object *c, Gua_String error)
+ *
+ * Description:
+ *     Perform boolean OR between two matrices.
+ *
+ * Arguments:
+ *     a,        a matrix;
+ *     b,        a matrix;
+ *     c,        a structure containing the return object of the function;
+ *     error,    a pointer to the error message.
+ *
+ * Results:
+ *     The function returns the matrix C = A && B.
+ */
+Gua_Status Gua_OrMatrix(Gua_Object *a, Gua_Object *b, Gua_Object *c, Gua_String error)
+{
+    Gua_Matrix *m1;
+    Gua_Matrix *m2;
+    Gua_Matrix *m3;
+    Gua_Object *o1;
+    Gua_Object *o2;
+    Gua_Object *o3;
+    Gua_Integer i;
+    Gua_String errMessage;
+    
+    if (!((Gua_PObjectType(a) == OBJECT_TYPE_MATRIX) && (Gua_PObjectType(b) == OBJECT_TYPE_MATRIX))) {
         errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-        sprintf(errMessage, "%s...\n", Gua_ObjectToString(argv[1]));
+        sprintf(errMessage, "%s...\n", "illegal operand");
         strcat(error, errMessage);
         Gua_Free(errMessage);
         
         return GUA_ERROR;
-    } else if (strcmp(Gua_ObjectToString(argv[0]), "eval") == 0) {
-        if (argc != 2) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
+    }
+    
+    m1 = (Gua_Matrix *)Gua_PObjectToMatrix(a);
+    m2 = (Gua_Matrix *)Gua_PObjectToMatrix(b);
+    
+    if (m1 && m2) {
+        if (!Gua_IsPObjectStored(c)) {
+            Gua_FreeObject(c);
+        } else {
+            Gua_ClearPObject(c);
         }
         
-        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_STRING) {
+        if (Gua_PObjectLength(a) != Gua_PObjectLength(b)) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            sprintf(errMessage, "%s...\n", "the matrices do not have the same size");
             strcat(error, errMessage);
             Gua_Free(errMessage);
             
             return GUA_ERROR;
         }
-        
-        Gua_Evaluate((Gua_Namespace *)nspace, Gua_ObjectToString(argv[1]), object, &status, error);
-        
-        if (status != GUA_OK) {
-            return status;
-        }
-    } else if (strcmp(Gua_ObjectToString(argv[0]), "exists") == 0) {
-        if (argc != 2) {
+        if (m1->dimc > 2) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            sprintf(errMessage, "%s...\n", "only bidimensional matrices are supported");
             strcat(error, errMessage);
             Gua_Free(errMessage);
             
             return GUA_ERROR;
         }
         
-        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_STRING) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
+        for (i = 0; i < m1->dimc; i++) {
+            if (m1->dimv[i] != m2->dimv[i]) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s...\n", "the matrices do not have the same dimensions");
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
         }
         
-        Gua_IntegerToPObject(object, 0);
-        
-        if (Gua_SearchVariable(nspace, Gua_ObjectToString(argv[1]), &v1, SCOPE_STACK) != OBJECT_TYPE_UNKNOWN) {
-            Gua_IntegerToPObject(object, 1);
+        o1 = (Gua_Object *)m1->object;
+        o2 = (Gua_Object *)m2->object;
+        
+        Gua_MatrixToPObject(c, (struct Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix)), Gua_PObjectLength(a));
+        
+        m3 = (Gua_Matrix *)Gua_PObjectToMatrix(c);
+        
+        m3->dimc = m1->dimc;
+        
+        m3->dimv = Gua_Alloc(m3->dimc * sizeof(Gua_Integer));
+        
+        for (i = 0; i < m3->dimc; i++) {
+            m3->dimv[i] = m1->dimv[i];
         }
         
-        i = 0;
+        m3->object = (struct Gua_Object *)Gua_Alloc(Gua_PObjectLength(a) * sizeof(Gua_Object));
+        o3 = (Gua_Object *)m3->object;
         
-        while (strlen(Gua_ConstantTable[i].name) > 0) {
-            if (strcmp(Gua_ConstantTable[i].name, Gua_ObjectToString(argv[1])) == 0) {
-                Gua_IntegerToPObject(object, 1);
+        for (i = 0; i < Gua_PObjectLength(a); i++) {
+            if ((Gua_ObjectType(o1[i]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(o2[i]) == OBJECT_TYPE_INTEGER)) {
+                Gua_IntegerToObject(o3[i], Gua_ObjectToInteger(o1[i]) || Gua_ObjectToInteger(o2[i]));
+            } else if ((Gua_ObjectType(o1[i]) == OBJECT_TYPE_REAL) && (Gua_ObjectType(o2[i]) == OBJECT_TYPE_REAL)) {
+                Gua_IntegerToObject(o3[i], Gua_ObjectToReal(o1[i]) || Gua_ObjectToReal(o2[i]));
+            } else if ((Gua_ObjectType(o1[i]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(o2[i]) == OBJECT_TYPE_REAL)) {
+                Gua_IntegerToObject(o3[i], Gua_ObjectToInteger(o1[i]) || Gua_ObjectToReal(o2[i]));
+            } else if ((Gua_ObjectType(o1[i]) == OBJECT_TYPE_REAL) && (Gua_ObjectType(o2[i]) == OBJECT_TYPE_INTEGER)) {
+                Gua_IntegerToObject(o3[i], Gua_ObjectToReal(o1[i]) || Gua_ObjectToInteger(o2[i]));
             }
-            i++;
         }
+    }
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Gua_AndOrMatrix(Gua_Object *a, Gua_Object *b, Gua_Object *c, Gua_String error)
+ *
+ * Description:
+ *     Multiply two boolean matrices.
+ *
+ * Arguments:
+ *     a,        a matrix;
+ *     b,        a matrix;
+ *     c,        a structure containing the return object of the function;
+ *     error,    a pointer to the error message.
+ *
+ * Results:
+ *     The function returns the matrix C = A * B(boolean multiplication).
+ */
+Gua_Status Gua_AndOrMatrix(Gua_Object *a, Gua_Object *b, Gua_Object *c, Gua_String error)
+{
+    Gua_Matrix *m1;
+    Gua_Matrix *m2;
+    Gua_Matrix *m3;
+    Gua_Object *o1;
+    Gua_Object *o2;
+    Gua_Object *o3;
+    Gua_Integer i;
+    Gua_Integer j;
+    Gua_Integer k;
+    Gua_Integer m;
+    Gua_Integer n;
+    Gua_Integer p;
+    Gua_String errMessage;
+    
+    if (Gua_PObjectType(a) != OBJECT_TYPE_MATRIX) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "illegal operand 1");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
         
-        if (Gua_SearchFunction(nspace, Gua_ObjectToString(argv[1]), &f1) == GUA_OK) {
-            Gua_IntegerToPObject(object, 1);
-        }
-    } else if (strcmp(Gua_ObjectToString(argv[0]), "exit") == 0) {
-        if (argc > 2) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
-        }
+        return GUA_ERROR;
+    }
+    if (Gua_PObjectType(b) != OBJECT_TYPE_MATRIX) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "illegal operand 2");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
         
-        if (argc == 2) {
-            if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_INTEGER) {
-                Gua_LinkToPObject(object, argv[1]);
-            } else {
-                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
-                strcat(error, errMessage);
-                Gua_Free(errMessage);
-                
-                return GUA_ERROR;
-            }
+        return GUA_ERROR;
+    }
+    
+    m1 = (Gua_Matrix *)Gua_PObjectToMatrix(a);
+    m2 = (Gua_Matrix *)Gua_PObjectToMatrix(b);
+    
+    if (m1 && m2) {
+        if (!Gua_IsPObjectStored(c)) {
+            Gua_FreeObject(c);
+        } else {
+            Gua_ClearPObject(c);
         }
         
-        return GUA_EXIT;
-    } else if (strcmp(Gua_ObjectToString(argv[0]), "expr") == 0) {
-        if (argc != 2) {
+        if (m1->dimc > 2) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            sprintf(errMessage, "%s...\n", "only bidimensional matrices are supported");
             strcat(error, errMessage);
             Gua_Free(errMessage);
             
             return GUA_ERROR;
         }
         
-        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_STRING) {
+        if (m1->dimv[1] != m2->dimv[0]) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            sprintf(errMessage, "%s...\n", "the matrices do not have compatible dimensions");
             strcat(error, errMessage);
             Gua_Free(errMessage);
             
             return GUA_ERROR;
         }
         
-        Gua_Expression((Gua_Namespace *)nspace, Gua_ObjectToString(argv[1]), object, &status, error);
+        o1 = (Gua_Object *)m1->object;
+        o2 = (Gua_Object *)m2->object;
+        
+        /* A(m x n), B(n x p), C(m x p) */
+        m = m1->dimv[0];
+        n = m1->dimv[1];
+        p = m2->dimv[1];
         
-        if (status != GUA_OK) {
-            return status;
-        }
-    } else if (strcmp(Gua_ObjectToString(argv[0]), "getMatrixElement") == 0) {
-        if (argc < 3) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
-        }
+        Gua_MatrixToPObject(c, (struct Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix)), m * p);
+        m3 = (Gua_Matrix *)Gua_PObjectToMatrix(c);
         
-        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
-        }
+        m3->dimc = 2;
+        m3->dimv = Gua_Alloc(m3->dimc * sizeof(Gua_Integer));
         
-        m = (Gua_Matrix *)Gua_ObjectToMatrix(argv[1]);
+        m3->dimv[0] = m;
+        m3->dimv[1] = p;
         
-        if (argc == 3) {
-            if (Gua_ObjectType(argv[2]) != OBJECT_TYPE_INTEGER) {
-                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
-                strcat(error, errMessage);
-                Gua_Free(errMessage);
-                
-                return GUA_ERROR;
-            }
-            if ((Gua_ObjectToInteger(argv[2]) < 0) || (Gua_ObjectToInteger(argv[2]) >= Gua_ObjectLength(argv[1]))) {
-                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-                sprintf(errMessage, "%s %ld...\n", "index out of bound", Gua_ObjectToInteger(argv[2]));
-                strcat(error, errMessage);
-                Gua_Free(errMessage);
-                
-                return GUA_ERROR;
-            }
-        } else {
-            if ((argc - 2) != m->dimc) {
-                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-                sprintf(errMessage, "%s...\n", "index out of bound");
-                strcat(error, errMessage);
-                Gua_Free(errMessage);
-                
-                return GUA_ERROR;
-            }
-            
-            for (i = 2; i < argc; i++) {
-                if (Gua_ObjectType(argv[i]) != OBJECT_TYPE_INTEGER) {
-                    errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-                    sprintf(errMessage, "%s %ld %s %-.20s...\n", "illegal argument", i, "for function", Gua_ObjectToString(argv[0]));
-                    strcat(error, errMessage);
-                    Gua_Free(errMessage);
-                    
-                    return GUA_ERROR;
-                }
-                if ((Gua_ObjectToInteger(argv[i]) < 0) || (Gua_ObjectToInteger(argv[i]) >= m->dimv[i - 2])) {
-                    errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-                    sprintf(errMessage, "%s %ld...\n", "index out of bound", Gua_ObjectToInteger(argv[i]));
-                    strcat(error, errMessage);
-                    Gua_Free(errMessage);
-                    
-                    return GUA_ERROR;
-                }
+        m3->object = (struct Gua_Object *)Gua_Alloc(m * p * sizeof(Gua_Object));
+        o3 = (Gua_Object *)m3->object;
+        
+        /* Clear each element of matrix C. */ 
+        for (i = 0; i < m; i++) {
+            for (j = 0; j < p; j++) {
+                Gua_ClearObject(o3[i * p + j]);
             }
         }
-        
-        o = (Gua_Object *)m->object;
-        
-        if (argc == 3) {
-            n = Gua_ObjectToInteger(argv[2]);
-            
-            Gua_LinkToPObject(object, o[n]);
-        } else {
-            n = Gua_ObjectToInteger(argv[2]) * m->dimv[1] + argv[3].integer;
-            
-            if (argc > 4) {
-                p = m->dimv[0];
-                j = 1;
-                for (i = 4; i < argc; i++) {
-                    p = p * m->dimv[j];
-                    n = n + Gua_ObjectToInteger(argv[i]) * p;
-                    j++;
+
+        /* C(i,j) = sum(A(i,k) * B(k,j)) */
+        for (i = 0; i < m; i++) {
+            for (j = 0; j < p; j++) {
+                for (k = 0; k < n; k++) {            
+                    if ((Gua_ObjectType(o1[i * n + k]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(o2[k * p + j]) == OBJECT_TYPE_INTEGER)) {
+                        Gua_IntegerToObject(o3[i * p + j], Gua_ObjectToInteger(o3[i * p + j]) || (Gua_ObjectToInteger(o1[i * n + k]) && Gua_ObjectToInteger(o2[k * p + j])));
+                    } else if ((Gua_ObjectType(o1[i * n + k]) == OBJECT_TYPE_REAL) && (Gua_ObjectType(o2[k * p + j]) == OBJECT_TYPE_REAL)) {
+                        Gua_RealToObject(o3[i * p + j], Gua_ObjectToReal(o3[i * p + j]) || (Gua_ObjectToReal(o1[i * n + k]) && Gua_ObjectToReal(o2[k * p + j])));
+                    } else if ((Gua_ObjectType(o1[i * n + k]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(o2[k * p + j]) == OBJECT_TYPE_REAL)) {
+                        Gua_RealToObject(o3[i * p + j], Gua_ObjectToReal(o3[i * p + j]) || (Gua_ObjectToInteger(o1[i * n + k]) && Gua_ObjectToReal(o2[k * p + j])));
+                    } else if ((Gua_ObjectType(o1[i * n + k]) == OBJECT_TYPE_REAL) && (Gua_ObjectType(o2[k * p + j]) == OBJECT_TYPE_INTEGER)) {
+                        Gua_RealToObject(o3[i * p + j], Gua_ObjectToReal(o3[i * p + j]) || (Gua_ObjectToReal(o1[i * n + k]) && Gua_ObjectToInteger(o2[k * p + j])));
+                    }
                 }
             }
-            
-            Gua_LinkToPObject(object, o[n]);
-        }
-    } else if (strcmp(Gua_ObjectToString(argv[0]), "ident") == 0) {
-        if (argc != 2) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
         }
-        
-        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_INTEGER) {
+    }
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Gua_CopyFile(Gua_Object *target, Gua_Object *source, Gua_Stored stored)
+ *
+ * Description:
+ *     Copy a handle to other.
+ *
+ * Arguments:
+ *     target,    the target handle;
+ *     source,    the source handle;
+ *     stored,    if TRUE the object of the target handle is stored in a variable.
+ *
+ * Results:
+ *     The function makes a copy of a handle to other.
+ */
+Gua_Status Gua_CopyFile(Gua_Object *target, Gua_Object *source, Gua_Stored stored)
+{
+    Gua_File *ht;
+    Gua_File *hs;
+    
+    hs = (Gua_File *)Gua_PObjectToFile(source);
+    
+    if (hs) {
+        if (!Gua_IsPObjectStored(target)) {
+            Gua_FreeObject(target);
+        } else {
+            Gua_ClearPObject(target);
+        }
+        
+        Gua_NewFile(ht, hs->file);
+        Gua_LinkFilesFunctions(ht, hs);
+        
+        Gua_FileToPObject(target, (struct Gua_File *)ht);
+        Gua_SetPObjectStoredState(target, stored);
+    }
+    
+    return GUA_ERROR;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Gua_CopyHandle(Gua_Object *target, Gua_Object *source, Gua_Stored stored)
+ *
+ * Description:
+ *     Copy a handle to other.
+ *
+ * Arguments:
+ *     target,    the target handle;
+ *     source,    the source handle;
+ *     stored,    if TRUE the object of the target handle is stored in a variable.
+ *
+ * Results:
+ *     The function makes a copy of a handle to other.
+ */
+Gua_Status Gua_CopyHandle(Gua_Object *target, Gua_Object *source, Gua_Stored stored)
+{
+    Gua_Handle *ht;
+    Gua_Handle *hs;
+    
+    hs = (Gua_Handle *)Gua_PObjectToHandle(source);
+    
+    if (hs) {
+        if (!Gua_IsPObjectStored(target)) {
+            Gua_FreeObject(target);
+        } else {
+            Gua_ClearPObject(target);
+        }
+        
+        Gua_NewHandle(ht, hs->type, hs->pointer);
+        
+        Gua_HandleToPObject(target, (struct Gua_Handle *)ht);
+        Gua_SetPObjectStoredState(target, stored);
+    }
+    
+    return GUA_ERROR;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Gua_BuiltInFunction(void *nspace, Gua_Short argc, Gua_Object *argv, Gua_Object *object, Gua_String error)
+ *
+ * Description:
+ *     Built in functions wrapper.
+ *
+ * Arguments:
+ *     nspace,    a pointer to a structure Gua_Namespace. Must do a cast before use it;
+ *     argc,      the number of arguments to pass to the function;
+ *     argv,      an array containing the arguments to the function,
+ *                argv[0] is the function name;
+ *     object,    a structure containing the return object of the function;
+ *     error,     a pointer to the error message.
+ *
+ * Results:
+ *     The return object of the wrapped funcion.
+ */
+Gua_Status Gua_BuiltInFunction(void *nspace, Gua_Short argc, Gua_Object *argv, Gua_Object *object, Gua_String error)
+{
+    Gua_Status status;
+    Gua_Object key;
+    Gua_Matrix *m;
+    Gua_Object *o;
+    Gua_Object v1;
+    Gua_Function f1;
+    Gua_String string;
+    Gua_Length length;
+    Gua_Integer i;
+    Gua_Integer j;
+    Gua_Integer n;
+    Gua_Integer p;
+    Gua_Short precision;
+    Gua_String errMessage;
+    
+    Gua_ClearPObject(object);
+    
+    if (argc == 0) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s\n", "no function specified");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    if (strcmp(Gua_ObjectToString(argv[0]), "array") == 0) {
+        if (argc < 2) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
             Gua_Free(errMessage);
             
             return GUA_ERROR;
         }
         
-        if (Gua_IdentMatrix(object, Gua_ObjectToInteger(argv[1]), error) != GUA_OK) {
-            return GUA_ERROR;
+        for (i = 1; i < argc; i++) {
+            Gua_IntegerToObject(key, i - 1);
+            
+            status = Gua_SetArrayElement(object, &key, &argv[i], false);
+            
+            if (status != GUA_OK) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s...", Gua_StatusTable[GUA_ERROR_ILLEGAL_ASSIGNMENT]);
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
         }
-    } else if (strcmp(Gua_ObjectToString(argv[0]), "inv") == 0) {
-        if (argc != 2) {
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "arrayToString") == 0) {
+        if ((argc < 2) || (argc > 3)) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
             sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
@@ -6221,7 +6693,7 @@ Gua_Status Gua_BuiltInFunction(void *nspace, Gua_Short argc, Gua_Object *argv, G
             return GUA_ERROR;
         }
         
-        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_ARRAY) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
             sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
@@ -6230,11 +6702,30 @@ Gua_Status Gua_BuiltInFunction(void *nspace, Gua_Short argc, Gua_Object *argv, G
             return GUA_ERROR;
         }
         
-        if (Gua_InvMatrix(&argv[1], object, error) != GUA_OK) {
+        precision = GUA_SHORTEST_PRECISION;
+        
+        if (argc == 3) {
+            if ((Gua_ObjectType(argv[2]) != OBJECT_TYPE_INTEGER) || (Gua_ObjectToInteger(argv[2]) < 0)) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+            precision = Gua_ObjectToInteger(argv[2]);
+        }
+        
+        if (Gua_FormatArray(&argv[1], object, precision) != GUA_OK) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...", Gua_StatusTable[GUA_ERROR]);
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
             return GUA_ERROR;
         }
-    } else if (strcmp(Gua_ObjectToString(argv[0]), "isMatrixApproximatelyEqual") == 0) {
-        if (argc != 4) {
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "break") == 0) {
+        if (argc != 1) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
             sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
@@ -6243,7 +6734,23 @@ Gua_Status Gua_BuiltInFunction(void *nspace, Gua_Short argc, Gua_Object *argv, G
             return GUA_ERROR;
         }
         
-        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "\"break\" outside of a loop");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_BREAK;
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "complex") == 0) {
+        if (argc != 3) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (!((Gua_ObjectType(argv[1]) == OBJECT_TYPE_INTEGER) || (Gua_ObjectType(argv[1]) == OBJECT_TYPE_REAL))) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
             sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
@@ -6251,7 +6758,8 @@ Gua_Status Gua_BuiltInFunction(void *nspace, Gua_Short argc, Gua_Object *argv, G
             
             return GUA_ERROR;
         }
-        if (Gua_ObjectType(argv[2]) != OBJECT_TYPE_MATRIX) {
+        
+        if (!((Gua_ObjectType(argv[2]) == OBJECT_TYPE_INTEGER) || (Gua_ObjectType(argv[2]) == OBJECT_TYPE_REAL))) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
             sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
@@ -6259,21 +6767,33 @@ Gua_Status Gua_BuiltInFunction(void *nspace, Gua_Short argc, Gua_Object *argv, G
             
             return GUA_ERROR;
         }
-        if (Gua_ObjectType(argv[3]) != OBJECT_TYPE_REAL) {
+        
+        if ((Gua_ObjectType(argv[1]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(argv[2]) == OBJECT_TYPE_INTEGER)) {
+            Gua_ComplexToPObject(object, Gua_ObjectToInteger(argv[1]), Gua_ObjectToInteger(argv[2]));
+        } else if ((Gua_ObjectType(argv[1]) == OBJECT_TYPE_REAL) && (Gua_ObjectType(argv[2]) == OBJECT_TYPE_REAL)) {
+            Gua_ComplexToPObject(object, Gua_ObjectToReal(argv[1]), Gua_ObjectToReal(argv[2]));
+        } else if ((Gua_ObjectType(argv[1]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(argv[2]) == OBJECT_TYPE_REAL)) {
+            Gua_ComplexToPObject(object, Gua_ObjectToInteger(argv[1]), Gua_ObjectToReal(argv[2]));
+        } else if ((Gua_ObjectType(argv[1]) == OBJECT_TYPE_REAL) && (Gua_ObjectType(argv[2]) == OBJECT_TYPE_INTEGER)) {
+            Gua_ComplexToPObject(object, Gua_ObjectToReal(argv[1]), Gua_ObjectToInteger(argv[2]));
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "continue") == 0) {
+        if (argc != 1) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 3 for function", Gua_ObjectToString(argv[0]));
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
             Gua_Free(errMessage);
             
             return GUA_ERROR;
         }
         
-        if (Gua_IsMatrixApproximatelyEqual(&argv[1], &argv[2], &argv[3])) {
-            Gua_IntegerToPObject(object, 1);
-        } else {
-            Gua_IntegerToPObject(object, 0);
-        }
-    } else if (strcmp(Gua_ObjectToString(argv[0]), "keys") == 0) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "\"continue\" outside of a loop");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_CONTINUE;
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "dim") == 0) {
         if (argc != 2) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
             sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
@@ -6283,7 +6803,7 @@ Gua_Status Gua_BuiltInFunction(void *nspace, Gua_Short argc, Gua_Object *argv, G
             return GUA_ERROR;
         }
         
-        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_ARRAY) {
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
             sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
@@ -6292,7 +6812,7 @@ Gua_Status Gua_BuiltInFunction(void *nspace, Gua_Short argc, Gua_Object *argv, G
             return GUA_ERROR;
         }
         
-        if (Gua_GetArrayKeys(object, &argv[1]) != GUA_OK) {
+        if (Gua_GetMatrixDim(object, &argv[1]) != GUA_OK) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
             sprintf(errMessage, "%s...", Gua_StatusTable[GUA_ERROR]);
             strcat(error, errMessage);
@@ -6300,7 +6820,7 @@ Gua_Status Gua_BuiltInFunction(void *nspace, Gua_Short argc, Gua_Object *argv, G
             
             return GUA_ERROR;
         }
-    } else if (strcmp(Gua_ObjectToString(argv[0]), "length") == 0) {
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "error") == 0) {
         if (argc != 2) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
             sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
@@ -6310,100 +6830,102 @@ Gua_Status Gua_BuiltInFunction(void *nspace, Gua_Short argc, Gua_Object *argv, G
             return GUA_ERROR;
         }
         
-        Gua_IntegerToPObject(object, Gua_ObjectLength(argv[1]));
-    } else if (strcmp(Gua_ObjectToString(argv[0]), "matrix2D") == 0) {
-        if (argc < 3) {
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_STRING) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
             Gua_Free(errMessage);
             
             return GUA_ERROR;
         }
-        if (!((Gua_ObjectType(argv[1]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(argv[2]) == OBJECT_TYPE_INTEGER))) {
+        
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", Gua_ObjectToString(argv[1]));
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "eval") == 0) {
+        if (argc != 2) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "illegal argument for function", Gua_ObjectToString(argv[0]));
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
             Gua_Free(errMessage);
             
             return GUA_ERROR;
         }
         
-        Gua_MatrixToPObject(object, (struct Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix)), 0);
-        m = (Gua_Matrix *)Gua_PObjectToMatrix(object);
-        
-        m->dimc = 2;
-        m->dimv = Gua_Alloc(2 * sizeof(Gua_Integer));
-        m->dimv[0] = Gua_ObjectToInteger(argv[1]);
-        m->dimv[1] = Gua_ObjectToInteger(argv[2]);
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_STRING) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
         
-        length = Gua_ObjectToInteger(argv[1]) * Gua_ObjectToInteger(argv[2]);
+        Gua_CachedEvaluate((Gua_Namespace *)nspace, Gua_ObjectToString(argv[1]), object, &status, error);
         
-        if (length != (argc - 3)) {
+        if (status != GUA_OK) {
+            return status;
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "evalCacheSize") == 0) {
+        if (argc > 2) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
             sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
             Gua_Free(errMessage);
             
-            Gua_FreeObject(object);
-            
             return GUA_ERROR;
         }
         
-        if (length == 0) {
-            Gua_FreeObject(object);
-            return GUA_OK;
-        }
-        
-        for (i = 3; i < argc; i++) {
-            if (!((Gua_ObjectType(argv[i]) == OBJECT_TYPE_INTEGER) || (Gua_ObjectType(argv[i]) == OBJECT_TYPE_REAL) || (Gua_ObjectType(argv[i]) == OBJECT_TYPE_COMPLEX) || (Gua_ObjectType(argv[i]) == OBJECT_TYPE_STRING) || (Gua_ObjectType(argv[i]) == OBJECT_TYPE_FILE) || (Gua_ObjectType(argv[i]) == OBJECT_TYPE_HANDLE))) {
+        if (argc == 2) {
+            if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_INTEGER) {
                 errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-                sprintf(errMessage, "%s %ld %s %-.20s...\n", "illegal argument", i, "for function", Gua_ObjectToString(argv[0]));
+                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
                 strcat(error, errMessage);
                 Gua_Free(errMessage);
                 
-                Gua_FreeObject(object);
-                
                 return GUA_ERROR;
             }
+            
+            Gua_SetCodeCacheSize(Gua_ObjectToInteger(argv[1]));
         }
         
-        m->object = (struct Gua_Object *)Gua_Alloc(length * sizeof(Gua_Object));
-        o = (Gua_Object *)m->object;
-        
-        for (i = 0; i < length; i++) {
-            Gua_ClearObject(o[i]);
+        Gua_IntegerToPObject(object, Gua_GetCodeCacheSize());
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "evalCacheStats") == 0) {
+        if (argc != 1) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
             
-            if (Gua_ObjectType(argv[i + 3]) == OBJECT_TYPE_STRING) {
-                if (Gua_IsObjectStored(argv[i + 3])) {
-                    Gua_ByteArrayToObject(o[i], Gua_ObjectToString(argv[i + 3]), Gua_ObjectLength(argv[i + 3]));
-                } else {
-                    Gua_LinkByteArrayToObject(o[i], Gua_ObjectToString(argv[i + 3]), Gua_ObjectLength(argv[i + 3]));
-                    Gua_SetStoredObject(argv[i + 3]);
-                }
-            } else if (Gua_ObjectType(argv[i + 3]) == OBJECT_TYPE_FILE) {
-                if (Gua_IsObjectStored(argv[i + 3])) {
-                    Gua_CopyFile(&(o[i]), &(argv[i + 3]), false);
-                } else {
-                    Gua_LinkObjects(o[i], argv[i + 3]);
-                    Gua_SetStoredObject(argv[i + 3]);
-                }
-            } else if (Gua_ObjectType(argv[i + 3]) == OBJECT_TYPE_HANDLE) {
-                if (Gua_IsObjectStored(argv[i + 3])) {
-                    Gua_CopyHandle(&(o[i]), &(argv[i + 3]), false);
-                } else {
-                    Gua_LinkObjects(o[i], argv[i + 3]);
-                    Gua_SetStoredObject(argv[i + 3]);
-                }
-            } else {
-                Gua_LinkObjects(o[i], argv[i + 3]);
-            }
-            Gua_SetNotStoredObject(o[i]);
+            return GUA_ERROR;
         }
         
-        Gua_SetPObjectLength(object, length);
-    } else if (strcmp(Gua_ObjectToString(argv[0]), "matrix") == 0) {
-        if (argc < 3) {
+        Gua_GetCodeCacheStats(&n, &i, &j);
+        
+        Gua_LinkStringToObject(key, "size");
+        Gua_SetStoredObject(key);
+        Gua_IntegerToObject(v1, Gua_GetCodeCacheSize());
+        Gua_SetArrayElement(object, &key, &v1, false);
+        
+        Gua_LinkStringToObject(key, "entries");
+        Gua_SetStoredObject(key);
+        Gua_IntegerToObject(v1, n);
+        Gua_SetArrayElement(object, &key, &v1, false);
+        
+        Gua_LinkStringToObject(key, "hits");
+        Gua_SetStoredObject(key);
+        Gua_IntegerToObject(v1, i);
+        Gua_SetArrayElement(object, &key, &v1, false);
+        
+        Gua_LinkStringToObject(key, "misses");
+        Gua_SetStoredObject(key);
+        Gua_IntegerToObject(v1, j);
+        Gua_SetArrayElement(object, &key, &v1, false);
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "exists") == 0) {
+        if (argc != 2) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
             sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
@@ -6411,7 +6933,8 @@ Gua_Status Gua_BuiltInFunction(void *nspace, Gua_Short argc, Gua_Object *argv, G
             
             return GUA_ERROR;
         }
-        if (!((Gua_ObjectType(argv[1]) == OBJECT_TYPE_INTEGER) || (Gua_ObjectType(argv[1]) == OBJECT_TYPE_REAL) || (Gua_ObjectType(argv[1]) == OBJECT_TYPE_COMPLEX) || (Gua_ObjectType(argv[1]) == OBJECT_TYPE_STRING) || (Gua_ObjectType(argv[1]) == OBJECT_TYPE_FILE) || (Gua_ObjectType(argv[1]) == OBJECT_TYPE_HANDLE))) {
+        
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_STRING) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
             sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
@@ -6420,104 +6943,26 @@ Gua_Status Gua_BuiltInFunction(void *nspace, Gua_Short argc, Gua_Object *argv, G
             return GUA_ERROR;
         }
         
-        Gua_MatrixToPObject(object, (struct Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix)), 0);
-        m = (Gua_Matrix *)Gua_PObjectToMatrix(object);
+        Gua_IntegerToPObject(object, 0);
         
-        if (argc > 3) {
-            m->dimc = 0;
-            length = 1;
-            
-            for (i = 2; i < argc; i++) {
-                if (Gua_ObjectType(argv[i]) != OBJECT_TYPE_INTEGER) {
-                    errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-                    sprintf(errMessage, "%s %ld %s %-.20s...\n", "illegal argument", i, "for function", Gua_ObjectToString(argv[0]));
-                    strcat(error, errMessage);
-                    Gua_Free(errMessage);
-                    
-                    Gua_FreeObject(object);
-                    
-                    return GUA_ERROR;
-                }
-                
-                m->dimc++;
-                length = length * Gua_ObjectToInteger(argv[i]);
-            }
-            
-            m->dimv = Gua_Alloc(m->dimc * sizeof(Gua_Integer));
-            
-            for (i = 2; i < argc; i++) {
-                if (Gua_ObjectType(argv[i]) != OBJECT_TYPE_INTEGER) {
-                    errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-                    sprintf(errMessage, "%s %ld %s %-.20s...\n", "illegal argument", i, "for function", Gua_ObjectToString(argv[0]));
-                    strcat(error, errMessage);
-                    Gua_Free(errMessage);
-                    
-                    Gua_FreeObject(object);
-                    
-                    return GUA_ERROR;
-                }
-                
-                m->dimv[i - 2] = Gua_ObjectToInteger(argv[i]);
-            }
-        } else {
-            if (Gua_ObjectType(argv[2]) != OBJECT_TYPE_INTEGER) {
-                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
-                strcat(error, errMessage);
-                Gua_Free(errMessage);
-                
-                Gua_FreeObject(object);
-                
-                return GUA_ERROR;
-            }
-            
-            m->dimc = 1;
-            m->dimv = Gua_Alloc(m->dimc * sizeof(Gua_Integer));
-            m->dimv[0] = Gua_ObjectToInteger(argv[2]);
-            length = Gua_ObjectToInteger(argv[2]);
+        if (Gua_SearchVariable(nspace, Gua_ObjectToString(argv[1]), &v1, SCOPE_STACK) != OBJECT_TYPE_UNKNOWN) {
+            Gua_IntegerToPObject(object, 1);
         }
         
-        if (length == 0) {
-            Gua_FreeObject(object);
-            return GUA_OK;
-        }
+        i = 0;
         
-        m->object = (struct Gua_Object *)Gua_Alloc(length * sizeof(Gua_Object));
-        o = (Gua_Object *)m->object;
-
-        for (j = 0; j < length; j++) {
-            Gua_ClearObject(o[j]);
-            
-            if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_STRING) {
-                if (Gua_IsObjectStored(argv[1])) {
-                    Gua_ByteArrayToObject(o[j], Gua_ObjectToString(argv[1]), Gua_ObjectLength(argv[1]));
-                } else {
-                    Gua_LinkByteArrayToObject(o[j], Gua_ObjectToString(argv[1]), Gua_ObjectLength(argv[1]));
-                    Gua_SetStoredObject(argv[1]);
-                }
-            } else if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_FILE) {
-                if (Gua_IsObjectStored(argv[1])) {
-                    Gua_CopyFile(&(o[j]), &(argv[1]), false);
-                } else {
-                    Gua_LinkObjects(o[j], argv[1]);
-                    Gua_SetStoredObject(argv[1]);
-                }
-            } else if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_HANDLE) {
-                if (Gua_IsObjectStored(argv[1])) {
-                    Gua_CopyHandle(&(o[j]), &(argv[1]), false);
-                } else {
-                    Gua_LinkObjects(o[j], argv[1]);
-                    Gua_SetStoredObject(argv[1]);
-                }
-            } else {
-                Gua_LinkObjects(o[j], argv[1]);
+        while (strlen(Gua_ConstantTable[i].name) > 0) {
+            if (strcmp(Gua_ConstantTable[i].name, Gua_ObjectToString(argv[1])) == 0) {
+                Gua_IntegerToPObject(object, 1);
             }
-            Gua_SetNotStoredObject(o[j]);
+            i++;
         }
         
-        Gua_SetPObjectLength(object, length);
-    } else if (strcmp(Gua_ObjectToString(argv[0]), "matrixToString") == 0) {
-        if (argc != 2) {
+        if (Gua_SearchFunction(nspace, Gua_ObjectToString(argv[1]), &f1) == GUA_OK) {
+            Gua_IntegerToPObject(object, 1);
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "exit") == 0) {
+        if (argc > 2) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
             sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
@@ -6526,52 +6971,45 @@ Gua_Status Gua_BuiltInFunction(void *nspace, Gua_Short argc, Gua_Object *argv, G
             return GUA_ERROR;
         }
         
-        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
+        if (argc == 2) {
+            if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_INTEGER) {
+                Gua_LinkToPObject(object, argv[1]);
+            } else {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
         }
         
-        if (Gua_MatrixToString(&argv[1], object) != GUA_OK) {
+        return GUA_EXIT;
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "expr") == 0) {
+        if (argc != 2) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", Gua_StatusTable[GUA_ERROR]);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
             Gua_Free(errMessage);
             
             return GUA_ERROR;
         }
-    } else if (strcmp(Gua_ObjectToString(argv[0]), "return") == 0) {
-        if (argc > 2) {
+        
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_STRING) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
             Gua_Free(errMessage);
             
             return GUA_ERROR;
         }
         
-        if (argc == 2) {
-            if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_STRING) {
-                Gua_ByteArrayToPObject(object, Gua_ObjectToString(argv[1]), Gua_ObjectLength(argv[1]));
-            } else if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_ARRAY) {
-                Gua_CopyArray(object, &(argv[1]), false);
-            } else if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_MATRIX) {
-                Gua_CopyMatrix(object, &(argv[1]), false);
-            } else {
-                Gua_LinkToPObject(object, argv[1]);
-            }
-        }
-        
-        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-        sprintf(errMessage, "%s...\n", "\"return\" outside of a function");
-        strcat(error, errMessage);
-        Gua_Free(errMessage);
+        Gua_CachedExpression((Gua_Namespace *)nspace, Gua_ObjectToString(argv[1]), object, &status, error);
         
-        return GUA_RETURN;
-    } else if (strcmp(Gua_ObjectToString(argv[0]), "setMatrixElement") == 0) {
+        if (status != GUA_OK) {
+            return status;
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "getMatrixElement") == 0) {
         if (argc < 3) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
             sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
@@ -6590,41 +7028,45 @@ Gua_Status Gua_BuiltInFunction(void *nspace, Gua_Short argc, Gua_Object *argv, G
             return GUA_ERROR;
         }
         
-        if ((Gua_ObjectType(argv[2]) == OBJECT_TYPE_ARRAY) || (Gua_ObjectType(argv[2]) == OBJECT_TYPE_MATRIX) || (Gua_ObjectType(argv[2]) == OBJECT_TYPE_UNKNOWN)) {
-            return GUA_ERROR_ILLEGAL_ASSIGNMENT;
-        }
-        
         m = (Gua_Matrix *)Gua_ObjectToMatrix(argv[1]);
         
-        if (argc == 4) {
-            if ((Gua_ObjectToInteger(argv[3]) < 0) || (Gua_ObjectToInteger(argv[3]) >= Gua_ObjectLength(argv[1]))) {
+        if (argc == 3) {
+            if (Gua_ObjectType(argv[2]) != OBJECT_TYPE_INTEGER) {
                 errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-                sprintf(errMessage, "%s %ld...\n", "index out of bound", Gua_ObjectToInteger(argv[3]));
+                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
                 strcat(error, errMessage);
                 Gua_Free(errMessage);
                 
                 return GUA_ERROR;
             }
-        } else {
-            if ((argc - 3) != m->dimc) {
+            if ((Gua_ObjectToInteger(argv[2]) < 0) || (Gua_ObjectToInteger(argv[2]) >= Gua_ObjectLength(argv[1]))) {
                 errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-                sprintf(errMessage, "%s...\n", "index out of bound");
+                sprintf(errMessage, "%s %ld...\n", "index out of bound", Gua_ObjectToInteger(argv[2]));
                 strcat(error, errMessage);
                 Gua_Free(errMessage);
                 
                 return GUA_ERROR;
             }
-            
-            for (i = 3; i < argc; i++) {
-                if (Gua_ObjectType(argv[i]) != OBJECT_TYPE_INTEGER) {
-                    errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        } else {
+            if ((argc - 2) != m->dimc) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s...\n", "index out of bound");
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+            
+            for (i = 2; i < argc; i++) {
+                if (Gua_ObjectType(argv[i]) != OBJECT_TYPE_INTEGER) {
+                    errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
                     sprintf(errMessage, "%s %ld %s %-.20s...\n", "illegal argument", i, "for function", Gua_ObjectToString(argv[0]));
                     strcat(error, errMessage);
                     Gua_Free(errMessage);
                     
                     return GUA_ERROR;
                 }
-                if ((Gua_ObjectToInteger(argv[i]) < 0) || (Gua_ObjectToInteger(argv[i]) >= m->dimv[i - 3])) {
+                if ((Gua_ObjectToInteger(argv[i]) < 0) || (Gua_ObjectToInteger(argv[i]) >= m->dimv[i - 2])) {
                     errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
                     sprintf(errMessage, "%s %ld...\n", "index out of bound", Gua_ObjectToInteger(argv[i]));
                     strcat(error, errMessage);
@@ -6637,88 +7079,48 @@ Gua_Status Gua_BuiltInFunction(void *nspace, Gua_Short argc, Gua_Object *argv, G
         
         o = (Gua_Object *)m->object;
         
-        if (argc == 4) {
-            n = Gua_ObjectToInteger(argv[3]);
-            
-            if (Gua_ObjectType(o[n]) == OBJECT_TYPE_STRING) {
-                Gua_FreeObject(&(o[n]));
-            }
-            
-            if (Gua_ObjectType(argv[2]) == OBJECT_TYPE_STRING) {
-                if (Gua_IsObjectStored(argv[2])) {
-                    Gua_ByteArrayToObject(o[n], Gua_ObjectToString(argv[2]), Gua_ObjectLength(argv[2]));
-                } else {
-                    Gua_LinkByteArrayToObject(o[n], Gua_ObjectToString(argv[2]), Gua_ObjectLength(argv[2]));
-                    Gua_SetStoredObject(argv[2]);
-                }
-            } else if (Gua_ObjectType(argv[2]) == OBJECT_TYPE_FILE) {
-                if (Gua_IsObjectStored(argv[2])) {
-                    Gua_CopyFile(&(o[n]), &(argv[2]), true);
-                } else {
-                    Gua_LinkObjects(o[n], argv[2]);
-                    Gua_SetStoredObject(argv[2]);
-                }
-            } else if (Gua_ObjectType(argv[2]) == OBJECT_TYPE_HANDLE) {
-                if (Gua_IsObjectStored(argv[2])) {
-                    Gua_CopyHandle(&(o[n]), &(argv[2]), true);
-                } else {
-                    Gua_LinkObjects(o[n], argv[2]);
-                    Gua_SetStoredObject(argv[2]);
-                }
-            } else {
-                Gua_LinkObjects(o[n], argv[2]);
-            }
-            Gua_SetStoredObject(o[n]);
+        if (argc == 3) {
+            n = Gua_ObjectToInteger(argv[2]);
             
-            Gua_LinkToPObject(object, argv[2]);
-            Gua_SetStoredPObject(object);
+            Gua_LinkToPObject(object, o[n]);
         } else {
-            n = Gua_ObjectToInteger(argv[3]) * m->dimv[1] + Gua_ObjectToInteger(argv[4]);
+            n = Gua_ObjectToInteger(argv[2]) * m->dimv[1] + argv[3].integer;
             
-            if (argc > 5) {
+            if (argc > 4) {
                 p = m->dimv[0];
                 j = 1;
-                for (i = 5; i < argc; i++) {
+                for (i = 4; i < argc; i++) {
                     p = p * m->dimv[j];
                     n = n + Gua_ObjectToInteger(argv[i]) * p;
                     j++;
                 }
             }
             
-            if (Gua_ObjectType(o[n]) == OBJECT_TYPE_STRING) {
-                Gua_FreeObject(&(o[n]));
-            }
+            Gua_LinkToPObject(object, o[n]);
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "ident") == 0) {
+        if (argc != 2) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
             
-            if (Gua_ObjectType(argv[2]) == OBJECT_TYPE_STRING) {
-                if (Gua_IsObjectStored(argv[2])) {
-                    Gua_ByteArrayToObject(o[n], Gua_ObjectToString(argv[2]), Gua_ObjectLength(argv[2]));
-                } else {
-                    Gua_LinkByteArrayToObject(o[n], Gua_ObjectToString(argv[2]), Gua_ObjectLength(argv[2]));
-                    Gua_SetStoredObject(argv[2]);
-                }
-            } else if (Gua_ObjectType(argv[2]) == OBJECT_TYPE_FILE) {
-                if (Gua_IsObjectStored(argv[2])) {
-                    Gua_CopyFile(&(o[n]), &(argv[2]), true);
-                } else {
-                    Gua_LinkObjects(o[n], argv[2]);
-                    Gua_SetStoredObject(argv[2]);
-                }
-            } else if (Gua_ObjectType(argv[2]) == OBJECT_TYPE_HANDLE) {
-                if (Gua_IsObjectStored(argv[2])) {
-                    Gua_CopyHandle(&(o[n]), &(argv[2]), true);
-                } else {
-                    Gua_LinkObjects(o[n], argv[2]);
-                    Gua_SetStoredObject(argv[2]);
-                }
-            } else {
-                Gua_LinkObjects(o[n], argv[2]);
-            }
-            Gua_SetStoredObject(o[n]);
+            return GUA_ERROR;
+        }
+        
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_INTEGER) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
             
-            Gua_LinkToPObject(object, argv[2]);
-            Gua_SetStoredPObject(object);
+            return GUA_ERROR;
         }
-    } else if (strcmp(Gua_ObjectToString(argv[0]), "toString") == 0) {
+        
+        if (Gua_IdentMatrix(object, Gua_ObjectToInteger(argv[1]), error) != GUA_OK) {
+            return GUA_ERROR;
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "inv") == 0) {
         if (argc != 2) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
             sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
@@ -6727,71 +7129,1672 @@ Gua_Status Gua_BuiltInFunction(void *nspace, Gua_Short argc, Gua_Object *argv, G
             
             return GUA_ERROR;
         }
-
-        if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_INTEGER) {
-            string = (char *)Gua_Alloc(sizeof(char) * EXPRESSION_SIZE);
-            sprintf(string, "%ld", Gua_ObjectToInteger(argv[1]));
-            Gua_StringToPObject(object, string);
-            Gua_Free(string);
-        } else if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_REAL) {
-            string = (char *)Gua_Alloc(sizeof(char) * EXPRESSION_SIZE);
-            sprintf(string, "%g", Gua_ObjectToReal(argv[1]));
-            Gua_StringToPObject(object, string);
-            Gua_Free(string);
-        } else if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_STRING) {
-            Gua_StringToPObject(object, Gua_ObjectToString(argv[1]));
-        } else if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_COMPLEX) {
-            string = (char *)Gua_Alloc(sizeof(char) * EXPRESSION_SIZE);
-            sprintf(string, "%g%+g*i", Gua_ObjectToReal(argv[1]), Gua_ObjectToImaginary(argv[1]));
-            Gua_StringToPObject(object, string);
-            Gua_Free(string);
-        } else if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_ARRAY) {
-            if (Gua_ArrayToString(&argv[1], object) != GUA_OK) {
-                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-                sprintf(errMessage, "%s...\n", Gua_StatusTable[GUA_ERROR]);
-                strcat(error, errMessage);
-                Gua_Free(errMessage);
-                
-                return GUA_ERROR;
-            }
-        } else if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_MATRIX) {
-            if (Gua_MatrixToString(&argv[1], object) != GUA_OK) {
-                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-                sprintf(errMessage, "%s...\n", Gua_StatusTable[GUA_ERROR]);
-                strcat(error, errMessage);
-                Gua_Free(errMessage);
-                
-                return GUA_ERROR;
-            }
-        } else if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_FILE) {
-            string = (char *)Gua_Alloc(sizeof(char) * EXPRESSION_SIZE);
-            sprintf(string, "File%lu", (Gua_Integer)Gua_GetFileHandle((Gua_File *)Gua_ObjectToFile(argv[1])));
-            Gua_StringToPObject(object, string);
-            Gua_Free(string);
-        } else if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_HANDLE) {
-            string = (char *)Gua_Alloc(sizeof(char) * EXPRESSION_SIZE);
-            sprintf(string, "%s%lu\n", (Gua_String)Gua_GetHandleType((Gua_Handle *)Gua_ObjectToHandle(argv[1])), (Gua_Integer)Gua_GetHandlePointer((Gua_Handle *)Gua_ObjectToHandle(argv[1])));
-            Gua_StringToPObject(object, string);
-            Gua_Free(string);
+        
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Gua_InvMatrix(&argv[1], object, error) != GUA_OK) {
+            return GUA_ERROR;
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "isMatrixApproximatelyEqual") == 0) {
+        if (argc != 4) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (Gua_ObjectType(argv[2]) != OBJECT_TYPE_MATRIX) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (Gua_ObjectType(argv[3]) != OBJECT_TYPE_REAL) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 3 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Gua_IsMatrixApproximatelyEqual(&argv[1], &argv[2], &argv[3])) {
+            Gua_IntegerToPObject(object, 1);
+        } else {
+            Gua_IntegerToPObject(object, 0);
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "keys") == 0) {
+        if (argc != 2) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_ARRAY) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Gua_GetArrayKeys(object, &argv[1]) != GUA_OK) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...", Gua_StatusTable[GUA_ERROR]);
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "length") == 0) {
+        if (argc != 2) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        Gua_IntegerToPObject(object, Gua_ObjectLength(argv[1]));
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "matrix2D") == 0) {
+        if (argc < 3) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (!((Gua_ObjectType(argv[1]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(argv[2]) == OBJECT_TYPE_INTEGER))) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        Gua_MatrixToPObject(object, (struct Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix)), 0);
+        m = (Gua_Matrix *)Gua_PObjectToMatrix(object);
+        
+        m->dimc = 2;
+        m->dimv = Gua_Alloc(2 * sizeof(Gua_Integer));
+        m->dimv[0] = Gua_ObjectToInteger(argv[1]);
+        m->dimv[1] = Gua_ObjectToInteger(argv[2]);
+        
+        length = Gua_ObjectToInteger(argv[1]) * Gua_ObjectToInteger(argv[2]);
+        
+        if (length != (argc - 3)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            Gua_FreeObject(object);
+            
+            return GUA_ERROR;
+        }
+        
+        if (length == 0) {
+            Gua_FreeObject(object);
+            return GUA_OK;
+        }
+        
+        for (i = 3; i < argc; i++) {
+            if (!((Gua_ObjectType(argv[i]) == OBJECT_TYPE_INTEGER) || (Gua_ObjectType(argv[i]) == OBJECT_TYPE_REAL) || (Gua_ObjectType(argv[i]) == OBJECT_TYPE_COMPLEX) || (Gua_ObjectType(argv[i]) == OBJECT_TYPE_STRING) || (Gua_ObjectType(argv[i]) == OBJECT_TYPE_FILE) || (Gua_ObjectType(argv[i]) == OBJECT_TYPE_HANDLE))) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %ld %s %-.20s...\n", "illegal argument", i, "for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                Gua_FreeObject(object);
+                
+                return GUA_ERROR;
+            }
+        }
+        
+        m->object = (struct Gua_Object *)Gua_Alloc(length * sizeof(Gua_Object));
+        o = (Gua_Object *)m->object;
+        
+        for (i = 0; i < length; i++) {
+            Gua_ClearObject(o[i]);
+            
+            if (Gua_ObjectType(argv[i + 3]) == OBJECT_TYPE_STRING) {
+                if (Gua_IsObjectStored(argv[i + 3])) {
+                    Gua_ByteArrayToObject(o[i], Gua_ObjectToString(argv[i + 3]), Gua_ObjectLength(argv[i + 3]));
+                } else {
+                    Gua_LinkByteArrayToObject(o[i], Gua_ObjectToString(argv[i + 3]), Gua_ObjectLength(argv[i + 3]));
+                    Gua_SetStoredObject(argv[i + 3]);
+                }
+            } else if (Gua_ObjectType(argv[i + 3]) == OBJECT_TYPE_FILE) {
+                if (Gua_IsObjectStored(argv[i + 3])) {
+                    Gua_CopyFile(&(o[i]), &(argv[i + 3]), false);
+                } else {
+                    Gua_LinkObjects(o[i], argv[i + 3]);
+                    Gua_SetStoredObject(argv[i + 3]);
+                }
+            } else if (Gua_ObjectType(argv[i + 3]) == OBJECT_TYPE_HANDLE) {
+                if (Gua_IsObjectStored(argv[i + 3])) {
+                    Gua_CopyHandle(&(o[i]), &(argv[i + 3]), false);
+                } else {
+                    Gua_LinkObjects(o[i], argv[i + 3]);
+                    Gua_SetStoredObject(argv[i + 3]);
+                }
+            } else {
+                Gua_LinkObjects(o[i], argv[i + 3]);
+            }
+            Gua_SetNotStoredObject(o[i]);
+        }
+        
+        Gua_SetPObjectLength(object, length);
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "matrix") == 0) {
+        if (argc < 3) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (!((Gua_ObjectType(argv[1]) == OBJECT_TYPE_INTEGER) || (Gua_ObjectType(argv[1]) == OBJECT_TYPE_REAL) || (Gua_ObjectType(argv[1]) == OBJECT_TYPE_COMPLEX) || (Gua_ObjectType(argv[1]) == OBJECT_TYPE_STRING) || (Gua_ObjectType(argv[1]) == OBJECT_TYPE_FILE) || (Gua_ObjectType(argv[1]) == OBJECT_TYPE_HANDLE))) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        Gua_MatrixToPObject(object, (struct Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix)), 0);
+        m = (Gua_Matrix *)Gua_PObjectToMatrix(object);
+        
+        if (argc > 3) {
+            m->dimc = 0;
+            length = 1;
+            
+            for (i = 2; i < argc; i++) {
+                if (Gua_ObjectType(argv[i]) != OBJECT_TYPE_INTEGER) {
+                    errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                    sprintf(errMessage, "%s %ld %s %-.20s...\n", "illegal argument", i, "for function", Gua_ObjectToString(argv[0]));
+                    strcat(error, errMessage);
+                    Gua_Free(errMessage);
+                    
+                    Gua_FreeObject(object);
+                    
+                    return GUA_ERROR;
+                }
+                
+                m->dimc++;
+                length = length * Gua_ObjectToInteger(argv[i]);
+            }
+            
+            m->dimv = Gua_Alloc(m->dimc * sizeof(Gua_Integer));
+            
+            for (i = 2; i < argc; i++) {
+                if (Gua_ObjectType(argv[i]) != OBJECT_TYPE_INTEGER) {
+                    errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                    sprintf(errMessage, "%s %ld %s %-.20s...\n", "illegal argument", i, "for function", Gua_ObjectToString(argv[0]));
+                    strcat(error, errMessage);
+                    Gua_Free(errMessage);
+                    
+                    Gua_FreeObject(object);
+                    
+                    return GUA_ERROR;
+                }
+                
+                m->dimv[i - 2] = Gua_ObjectToInteger(argv[i]);
+            }
+        } else {
+            if (Gua_ObjectType(argv[2]) != OBJECT_TYPE_INTEGER) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                Gua_FreeObject(object);
+                
+                return GUA_ERROR;
+            }
+            
+            m->dimc = 1;
+            m->dimv = Gua_Alloc(m->dimc * sizeof(Gua_Integer));
+            m->dimv[0] = Gua_ObjectToInteger(argv[2]);
+            length = Gua_ObjectToInteger(argv[2]);
+        }
+        
+        if (length == 0) {
+            Gua_FreeObject(object);
+            return GUA_OK;
+        }
+        
+        m->object = (struct Gua_Object *)Gua_Alloc(length * sizeof(Gua_Object));
+        o = (Gua_Object *)m->object;
+
+        for (j = 0; j < length; j++) {
+            Gua_ClearObject(o[j]);
+            
+            if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_STRING) {
+                if (Gua_IsObjectStored(argv[1])) {
+                    Gua_ByteArrayToObject(o[j], Gua_ObjectToString(argv[1]), Gua_ObjectLength(argv[1]));
+                } else {
+                    Gua_LinkByteArrayToObject(o[j], Gua_ObjectToString(argv[1]), Gua_ObjectLength(argv[1]));
+                    Gua_SetStoredObject(argv[1]);
+                }
+            } else if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_FILE) {
+                if (Gua_IsObjectStored(argv[1])) {
+                    Gua_CopyFile(&(o[j]), &(argv[1]), false);
+                } else {
+                    Gua_LinkObjects(o[j], argv[1]);
+                    Gua_SetStoredObject(argv[1]);
+                }
+            } else if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_HANDLE) {
+                if (Gua_IsObjectStored(argv[1])) {
+                    Gua_CopyHandle(&(o[j]), &(argv[1]), false);
+                } else {
+                    Gua_LinkObjects(o[j], argv[1]);
+                    Gua_SetStoredObject(argv[1]);
+                }
+            } else {
+                Gua_LinkObjects(o[j], argv[1]);
+            }
+            Gua_SetNotStoredObject(o[j]);
+        }
+        
+        Gua_SetPObjectLength(object, length);
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "matrixToString") == 0) {
+        if ((argc < 2) || (argc > 3)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        precision = GUA_SHORTEST_PRECISION;
+        
+        if (argc == 3) {
+            if ((Gua_ObjectType(argv[2]) != OBJECT_TYPE_INTEGER) || (Gua_ObjectToInteger(argv[2]) < 0)) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+            precision = Gua_ObjectToInteger(argv[2]);
+        }
+        
+        if (Gua_FormatMatrix(&argv[1], object, precision) != GUA_OK) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", Gua_StatusTable[GUA_ERROR]);
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "return") == 0) {
+        if (argc > 2) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (argc == 2) {
+            if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_STRING) {
+                Gua_ByteArrayToPObject(object, Gua_ObjectToString(argv[1]), Gua_ObjectLength(argv[1]));
+            } else if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_ARRAY) {
+                Gua_CopyArray(object, &(argv[1]), false);
+            } else if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_MATRIX) {
+                Gua_CopyMatrix(object, &(argv[1]), false);
+            } else {
+                Gua_LinkToPObject(object, argv[1]);
+            }
+        }
+        
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "\"return\" outside of a function");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_RETURN;
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "setMatrixElement") == 0) {
+        if (argc < 3) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if ((Gua_ObjectType(argv[2]) == OBJECT_TYPE_ARRAY) || (Gua_ObjectType(argv[2]) == OBJECT_TYPE_MATRIX) || (Gua_ObjectType(argv[2]) == OBJECT_TYPE_UNKNOWN)) {
+            return GUA_ERROR_ILLEGAL_ASSIGNMENT;
+        }
+        
+        m = (Gua_Matrix *)Gua_ObjectToMatrix(argv[1]);
+        
+        if (argc == 4) {
+            if ((Gua_ObjectToInteger(argv[3]) < 0) || (Gua_ObjectToInteger(argv[3]) >= Gua_ObjectLength(argv[1]))) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %ld...\n", "index out of bound", Gua_ObjectToInteger(argv[3]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+        } else {
+            if ((argc - 3) != m->dimc) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s...\n", "index out of bound");
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+            
+            for (i = 3; i < argc; i++) {
+                if (Gua_ObjectType(argv[i]) != OBJECT_TYPE_INTEGER) {
+                    errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                    sprintf(errMessage, "%s %ld %s %-.20s...\n", "illegal argument", i, "for function", Gua_ObjectToString(argv[0]));
+                    strcat(error, errMessage);
+                    Gua_Free(errMessage);
+                    
+                    return GUA_ERROR;
+                }
+                if ((Gua_ObjectToInteger(argv[i]) < 0) || (Gua_ObjectToInteger(argv[i]) >= m->dimv[i - 3])) {
+                    errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                    sprintf(errMessage, "%s %ld...\n", "index out of bound", Gua_ObjectToInteger(argv[i]));
+                    strcat(error, errMessage);
+                    Gua_Free(errMessage);
+                    
+                    return GUA_ERROR;
+                }
+            }
+        }
+        
+        o = (Gua_Object *)m->object;
+        
+        if (argc == 4) {
+            n = Gua_ObjectToInteger(argv[3]);
+            
+            if (Gua_ObjectType(o[n]) == OBJECT_TYPE_STRING) {
+                Gua_FreeObject(&(o[n]));
+            }
+            
+            if (Gua_ObjectType(argv[2]) == OBJECT_TYPE_STRING) {
+                if (Gua_IsObjectStored(argv[2])) {
+                    Gua_ByteArrayToObject(o[n], Gua_ObjectToString(argv[2]), Gua_ObjectLength(argv[2]));
+                } else {
+                    Gua_LinkByteArrayToObject(o[n], Gua_ObjectToString(argv[2]), Gua_ObjectLength(argv[2]));
+                    Gua_SetStoredObject(argv[2]);
+                }
+            } else if (Gua_ObjectType(argv[2]) == OBJECT_TYPE_FILE) {
+                if (Gua_IsObjectStored(argv[2])) {
+                    Gua_CopyFile(&(o[n]), &(argv[2]), true);
+                } else {
+                    Gua_LinkObjects(o[n], argv[2]);
+                    Gua_SetStoredObject(argv[2]);
+                }
+            } else if (Gua_ObjectType(argv[2]) == OBJECT_TYPE_HANDLE) {
+                if (Gua_IsObjectStored(argv[2])) {
+                    Gua_CopyHandle(&(o[n]), &(argv[2]), true);
+                } else {
+                    Gua_LinkObjects(o[n], argv[2]);
+                    Gua_SetStoredObject(argv[2]);
+                }
+            } else {
+                Gua_LinkObjects(o[n], argv[2]);
+            }
+            Gua_SetStoredObject(o[n]);
+            
+            Gua_LinkToPObject(object, argv[2]);
+            Gua_SetStoredPObject(object);
+        } else {
+            n = Gua_ObjectToInteger(argv[3]) * m->dimv[1] + Gua_ObjectToInteger(argv[4]);
+            
+            if (argc > 5) {
+                p = m->dimv[0];
+                j = 1;
+                for (i = 5; i < argc; i++) {
+                    p = p * m->dimv[j];
+                    n = n + Gua_ObjectToInteger(argv[i]) * p;
+                    j++;
+                }
+            }
+            
+            if (Gua_ObjectType(o[n]) == OBJECT_TYPE_STRING) {
+                Gua_FreeObject(&(o[n]));
+            }
+            
+            if (Gua_ObjectType(argv[2]) == OBJECT_TYPE_STRING) {
+                if (Gua_IsObjectStored(argv[2])) {
+                    Gua_ByteArrayToObject(o[n], Gua_ObjectToString(argv[2]), Gua_ObjectLength(argv[2]));
+                } else {
+                    Gua_LinkByteArrayToObject(o[n], Gua_ObjectToString(argv[2]), Gua_ObjectLength(argv[2]));
+                    Gua_SetStoredObject(argv[2]);
+                }
+            } else if (Gua_ObjectType(argv[2]) == OBJECT_TYPE_FILE) {
+                if (Gua_IsObjectStored(argv[2])) {
+                    Gua_CopyFile(&(o[n]), &(argv[2]), true);
+                } else {
+                    Gua_LinkObjects(o[n], argv[2]);
+                    Gua_SetStoredObject(argv[2]);
+                }
+            } else if (Gua_ObjectType(argv[2]) == OBJECT_TYPE_HANDLE) {
+                if (Gua_IsObjectStored(argv[2])) {
+                    Gua_CopyHandle(&(o[n]), &(argv[2]), true);
+                } else {
+                    Gua_LinkObjects(o[n], argv[2]);
+                    Gua_SetStoredObject(argv[2]);
+                }
+            } else {
+                Gua_LinkObjects(o[n], argv[2]);
+            }
+            Gua_SetStoredObject(o[n]);
+            
+            Gua_LinkToPObject(object, argv[2]);
+            Gua_SetStoredPObject(object);
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "toString") == 0) {
+        if (argc != 2) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+
+        /* Numbers are written as print and matrixToString write them. */
+        if ((Gua_ObjectType(argv[1]) == OBJECT_TYPE_INTEGER) || (Gua_ObjectType(argv[1]) == OBJECT_TYPE_REAL) || (Gua_ObjectType(argv[1]) == OBJECT_TYPE_COMPLEX)) {
+            string = (char *)Gua_Alloc(sizeof(char) * EXPRESSION_SIZE);
+            Gua_FormatObject(string, &argv[1], GUA_SHORTEST_PRECISION);
+            Gua_StringToPObject(object, string);
+            Gua_Free(string);
+        } else if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_STRING) {
+            Gua_StringToPObject(object, Gua_ObjectToString(argv[1]));
+        } else if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_ARRAY) {
+            if (Gua_ArrayToString(&argv[1], object) != GUA_OK) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s...\n", Gua_StatusTable[GUA_ERROR]);
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+        } else if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_MATRIX) {
+            if (Gua_MatrixToString(&argv[1], object) != GUA_OK) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s...\n", Gua_StatusTable[GUA_ERROR]);
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+        } else if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_FILE) {
+            string = (char *)Gua_Alloc(sizeof(char) * EXPRESSION_SIZE);
+            sprintf(string, "File%lu", (Gua_Integer)Gua_GetFileHandle((Gua_File *)Gua_ObjectToFile(argv[1])));
+            Gua_StringToPObject(object, string);
+            Gua_Free(string);
+        } else if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_HANDLE) {
+            string = (char *)Gua_Alloc(sizeof(char) * EXPRESSION_SIZE);
+            sprintf(string, "%s%lu\n", (Gua_String)Gua_GetHandleType((Gua_Handle *)Gua_ObjectToHandle(argv[1])), (Gua_Integer)Gua_GetHandlePointer((Gua_Handle *)Gua_ObjectToHandle(argv[1])));
+            Gua_StringToPObject(object, string);
+            Gua_Free(string);
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "type") == 0) {
+        if (argc != 2) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        Gua_IntegerToPObject(object, Gua_ObjectType(argv[1]));
+    } else {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "unknown function", Gua_ObjectToString(argv[0]));
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Gua_CountArguments(Gua_String start)
+ *
+ * Description:
+ *     Parse the expression and count the number o arguments separated by comma.
+ *
+ * Arguments:
+ *     start,    a pointer to the start point of the expression to parse.
+ *
+ * Results:
+ *     The function returns the number o arguments separated by comma.
+ *
+ */
+Gua_Status Gua_CountArguments(Gua_String start)
+{
+    Gua_String p;
+    Gua_Short argc;
+    Gua_Token token;
+    
+    p = start;
+    
+    argc = 0;
+    
+    if (strlen(start) > 0) {
+        argc++;
+        
+        while (*p != EXPRESSION_END) {
+            if (*p == SINGLE_QUOTE) {
+                p = Gua_ScanSingleQuotes(p, &token);
+                p--;
+            } else if (*p == DOUBLE_QUOTE) {
+                p = Gua_ScanDoubleQuotes(p, &token);
+                p--;
+            } else if (*p == PARENTHESIS_OPEN) {
+                p = Gua_ScanParenthesis(p, &token);
+                p--;
+            } else if (*p == BRACKET_OPEN) {
+                p = Gua_ScanBracket(p, &token);
+                p--;
+            } else if (*p == BRACE_OPEN) {
+                p = Gua_ScanBrace(p, &token);
+                p--;
+            } else if (*p == COMMA) {
+                argc++;
+            }
+            p++;
+        }
+    }
+    
+    return argc;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Gua_ParseArguments(Gua_Namespace *nspace, Gua_String start, Gua_Short argc, Gua_Object *argv, Gua_Short first, Gua_Status *status, Gua_String error)
+ *
+ * Description:
+ *     Parse the expression and return a vector containing each argument.
+ *
+ * Arguments:
+ *     nspace,    a pointer to a structure containing the variable and function namespace;
+ *     start,     a pointer to the start point of the expression to parse;
+ *     argc,      the number of arguments;
+ *     argv,      an array containing the arguments;
+ *     first,     the first element in array to fill;
+ *     status,    the parse status. GUA_OK if no error has occurred,
+ *                a parse error number otherwise;
+ *     error,     the error message if any.
+ *
+ * Results:
+ *     The function returns a vector containing each argument in expression.
+ *
+ */
+Gua_Status Gua_ParseArguments(Gua_Namespace *nspace, Gua_String start, Gua_Short argc, Gua_Object *argv, Gua_Short first, Gua_Status *status, Gua_String error)
+{
+    Gua_String p;
+    Gua_String s;
+    Gua_String expression;
+    Gua_Token token;
+    Gua_Short i;
+    Gua_String errMessage;
+    
+    p = start;
+    
+    expression = (char *)Gua_Alloc(sizeof(char) * (strlen(start) + 1));
+    memset(expression, '\0', sizeof(char) * (strlen(start) + 1));
+    
+    i = first;
+    
+    s = p;
+    
+    if (argc > 1) {
+        while (true) {
+            p = Gua_NextToken(nspace, p, &token);
+            
+            if (token.status != GUA_OK) {
+                *status = token.status;
+                
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s...\n", Gua_StatusTable[token.status]);
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                Gua_Free(expression);
+                
+                return GUA_ERROR;
+            }
+            
+            if (token.type == TOKEN_TYPE_ARG_SEPARATOR) {
+                strncpy(expression, s, (Gua_Length)(p - s - 1));
+                
+                Gua_Evaluate(nspace, expression, &argv[i], status, error);
+                
+                if (*status != GUA_OK) {
+                    Gua_Free(expression);
+                    return GUA_ERROR;
+                }
+                
+                s = p;
+                
+                if (i < (argc - 1)) {
+                    memset(expression, '\0', sizeof(char) * (strlen(start) + 1));
+                    i++;
+                } else {
+                    break;
+                }
+            } else if (token.type == TOKEN_TYPE_END) {
+                break;
+            }
+        }
+    }
+    
+    strcpy(expression, s);
+    
+    Gua_Evaluate(nspace, expression, &argv[i], status, error);
+    
+    Gua_Free(expression);
+    
+    if (*status != GUA_OK) {
+        return GUA_ERROR;
+    }
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Gua_CountCommands(Gua_String start)
+ *
+ * Description:
+ *     Parse the expression and count the number o arguments separated by comma.
+ *
+ * Arguments:
+ *     start,    a pointer to the start point of the expression to parse.
+ *
+ * Results:
+ *     The function returns the number o arguments separated by comma.
+ *
+ */
+Gua_Status Gua_CountCommands(Gua_String start)
+{
+    Gua_String p;
+    Gua_Short argc;
+    Gua_Token token;
+    
+    p = start;
+    
+    argc = 0;
+    
+    if (strlen(start) > 0) {
+        argc++;
+        
+        while (*p != EXPRESSION_END) {
+            if (*p == SINGLE_QUOTE) {
+                p = Gua_ScanSingleQuotes(p, &token);
+                p--;
+            } else if (*p == DOUBLE_QUOTE) {
+                p = Gua_ScanDoubleQuotes(p, &token);
+                p--;
+            } else if (*p == PARENTHESIS_OPEN) {
+                p = Gua_ScanParenthesis(p, &token);
+                p--;
+            } else if (*p == BRACKET_OPEN) {
+                p = Gua_ScanBracket(p, &token);
+                p--;
+            } else if (*p == BRACE_OPEN) {
+                p = Gua_ScanBrace(p, &token);
+                p--;
+            } else if (*p == SEMI_COLON) {
+                argc++;
+            }
+            p++;
+        }
+    }
+    
+    return argc;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Gua_ParseCommands(Gua_Namespace *nspace, Gua_String start, Gua_Short argc, Gua_Object *argv, Gua_Status *status, Gua_String error)
+ *
+ * Description:
+ *     Parse the expression and return a vector containing each argument.
+ *
+ * Arguments:
+ *     nspace,    a pointer to a structure containing the variable and function namespace;
+ *     start,     a pointer to the start point of the expression to parse;
+ *     argc,      the number of arguments;
+ *     argv,      an array containing the arguments;
+ *     status,    the parse status. GUA_OK if no error has occurred,
+ *                a parse error number otherwise;
+ *     error,     the error message if any.
+ *
+ * Results:
+ *     The function returns a vector containing each argument in expression.
+ *
+ */
+Gua_Status Gua_ParseCommands(Gua_Namespace *nspace, Gua_String start, Gua_Short argc, Gua_Object *argv, Gua_Status *status, Gua_String error)
+{
+    Gua_String p;
+    Gua_String s;
+    Gua_Token token;
+    Gua_Short i;
+    
+    p = start;
+    
+    i = 0;
+    
+    s = p;
+    
+    if (argc > 1) {
+        while (true) {
+            p = Gua_NextToken(nspace, p, &token);
+            
+            if (token.type == TOKEN_TYPE_SEPARATOR) {
+                Gua_ByteArrayToObject(argv[i], s, (Gua_Length)(p - s - 1));
+                
+                s = p;
+                
+                if (i < (argc - 1)) {
+                    i++;
+                } else {
+                    break;
+                }
+            } else if (token.type == TOKEN_TYPE_END) {
+                break;
+            }
+        }
+    }
+    
+    Gua_ByteArrayToObject(argv[i], s, (Gua_Length)(p - s + 1));
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Gua_ParseFormalArguments(Gua_Namespace *nspace, Gua_String start, Gua_Short argc, Gua_Object *argv, Gua_Status *status, Gua_String error)
+ *
+ * Description:
+ *     Parse the expression and return a vector containing each argument.
+ *
+ * Arguments:
+ *     nspace,    a pointer to a structure containing the variable and function namespace;
+ *     start,     a pointer to the start point of the expression to parse;
+ *     argc,      the number of arguments;
+ *     argv,      an array containing the arguments;
+ *     status,    the parse status. GUA_OK if no error has occurred,
+ *                a parse error number otherwise;
+ *     error,     the error message if any.
+ *
+ * Results:
+ *     The function returns a vector containing each argument in expression.
+ *
+ */
+Gua_Status Gua_ParseFormalArguments(Gua_Namespace *nspace, Gua_String start, Gua_Short argc, Gua_Object *argv, Gua_Status *status, Gua_String error)
+{
+    Gua_String p;
+    Gua_String s;
+    Gua_Token token;
+    Gua_Short i;
+    
+    p = start;
+    
+    i = 0;
+    
+    s = p;
+    
+    if (argc > 1) {
+        while (true) {
+            p = Gua_NextToken(nspace, p, &token);
+            
+            if (token.type == TOKEN_TYPE_ARG_SEPARATOR) {
+                Gua_ByteArrayToObject(argv[i], s, (Gua_Length)(p - s - 1));
+                
+                s = p;
+                
+                if (i < (argc - 1)) {
+                    i++;
+                } else {
+                    break;
+                }
+            } else if (token.type == TOKEN_TYPE_END) {
+                break;
+            }
+        }
+    }
+    
+    Gua_StringToObject(argv[i], s);
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Gua_CountMatrixElements(Gua_String start)
+ *
+ * Description:
+ *     Parse the expression and count the number o arguments separated by comma.
+ *
+ * Arguments:
+ *     start,    a pointer to the start point of the expression to parse.
+ *
+ * Results:
+ *     The function returns the number o arguments separated by comma.
+ *
+ */
+Gua_Status Gua_CountMatrixElements(Gua_String start)
+{
+    Gua_String p;
+    Gua_Short argc;
+    Gua_Token token;
+    
+    p = start;
+    
+    argc = 0;
+    
+    if (strlen(start) > 0) {
+        argc++;
+        
+        while (*p != EXPRESSION_END) {
+            if (*p == SINGLE_QUOTE) {
+                p = Gua_ScanSingleQuotes(p, &token);
+                p--;
+            } else if (*p == DOUBLE_QUOTE) {
+                p = Gua_ScanDoubleQuotes(p, &token);
+                p--;
+            } else if (*p == PARENTHESIS_OPEN) {
+                p = Gua_ScanParenthesis(p, &token);
+                p--;
+            } else if (*p == BRACKET_OPEN) {
+                p = Gua_ScanBracket(p, &token);
+                p--;
+            } else if (*p == BRACE_OPEN) {
+                p = Gua_ScanBrace(p, &token);
+                p--;
+            } else if (*p == COMMA) {
+                argc++;
+            } else if (*p == SEMI_COLON) {
+                argc++;
+            }
+            p++;
+        }
+    }
+    
+    return argc;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Gua_ParseMatrixElements(Gua_Namespace *nspace, Gua_String start, Gua_Short argc, Gua_Object *argv, Gua_Status *status, Gua_String error)
+ *
+ * Description:
+ *     Parse the expression and return a vector containing each argument.
+ *
+ * Arguments:
+ *     nspace,    a pointer to a structure containing the variable and function namespace;
+ *     start,     a pointer to the start point of the expression to parse;
+ *     argc,      the number of arguments;
+ *     argv,      an array containing the arguments, where
+ *                argv[0] will be the function name,
+ *                argv[1] will be the m size(m x n),
+ *                argv[2] will be the n size(m x n);
+ *     status,    the parse status. GUA_OK if no error has occurred,
+ *                a parse error number otherwise;
+ *     error,     the error message if any.
+ *
+ * Results:
+ *     The function returns a vector containing each argument in expression.
+ *
+ */
+Gua_Status Gua_ParseMatrixElements(Gua_Namespace *nspace, Gua_String start, Gua_Short argc, Gua_Object *argv, Gua_Status *status, Gua_String error)
+{
+    Gua_String p;
+    Gua_String s;
+    Gua_String expression;
+    Gua_Token token;
+    Gua_Short i;
+    Gua_Integer n;
+    Gua_String errMessage;
+    
+    p = start;
+    
+    expression = (char *)Gua_Alloc(sizeof(char) * (strlen(start) + 1));
+    memset(expression, '\0', sizeof(char) * (strlen(start) + 1));
+    
+    i = 3;
+    
+    Gua_IntegerToObject(argv[1], 1);
+    Gua_IntegerToObject(argv[2], 1);
+    
+    n = 1;
+    
+    s = p;
+    
+    if (argc > 4) {       
+        while (true) {
+            p = Gua_NextToken(nspace, p, &token);
+            
+            if (token.status != GUA_OK) {
+                *status = token.status;
+                
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s...\n", Gua_StatusTable[token.status]);
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                Gua_Free(expression);
+                
+                return GUA_ERROR;
+            }
+            
+            if (token.type == TOKEN_TYPE_SEPARATOR) {
+                if (Gua_ObjectToInteger(argv[2]) == 1) {
+                    Gua_IntegerToObject(argv[2], n);
+                } else {
+                    if (Gua_ObjectToInteger(argv[2]) != n) {
+                        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                        sprintf(errMessage, "%s...\n", "the matrix has rows with diferent number of elements");
+                        strcat(error, errMessage);
+                        Gua_Free(errMessage);
+                        
+                        Gua_Free(expression);
+                        
+                        return GUA_ERROR;
+                    }
+                }
+                
+                Gua_IntegerToObject(argv[1], Gua_ObjectToInteger(argv[1]) + 1);
+                n = 1;
+                
+                strncpy(expression, s, (Gua_Length)(p - s - 1));
+                
+                Gua_Evaluate(nspace, expression, &argv[i], status, error);
+                
+                if (*status != GUA_OK) {
+                    Gua_Free(expression);
+                    return GUA_ERROR;
+                }
+                
+                s = p;
+                
+                if (i < (argc - 1)) {
+                    memset(expression, '\0', sizeof(char) * (strlen(start) + 1));
+                    i++;
+                } else {
+                    break;
+                }
+           } else if (token.type == TOKEN_TYPE_ARG_SEPARATOR) {
+                n++;
+                
+                strncpy(expression, s, (Gua_Length)(p - s - 1));
+                
+                Gua_Evaluate(nspace, expression, &argv[i], status, error);
+                
+                if (*status != GUA_OK) {
+                    Gua_Free(expression);
+                    return GUA_ERROR;
+                }
+                
+                s = p;
+                
+                if (i < (argc - 1)) {
+                    memset(expression, '\0', sizeof(char) * (strlen(start) + 1));
+                    i++;
+                } else {
+                    break;
+                }
+            } else if (token.type == TOKEN_TYPE_END) {
+                if (Gua_ObjectToInteger(argv[2]) == 1) {
+                    Gua_IntegerToObject(argv[2], n);
+                }
+                break;
+            }
+        }
+    }
+    
+    if (Gua_ObjectToInteger(argv[2]) != n) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "the matrix has rows with diferent number of elements");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        Gua_Free(expression);
+        
+        return GUA_ERROR;
+    }
+    
+    strcpy(expression, s);
+    
+    Gua_Evaluate(nspace, expression, &argv[i], status, error);
+    
+    if (*status != GUA_OK) {
+        Gua_Free(expression);
+        return GUA_ERROR;
+    }
+    
+    Gua_Free(expression);
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Gua_FreeArguments(Gua_Short argc, Gua_Object *argv)
+ *
+ * Description:
+ *     Free argument's memory.
+ *
+ * Arguments:
+ *     argc,    the number of arguments;
+ *     argv,    an array containing the arguments;
+ *              argv[0] is the function name.
+ *
+ * Results:
+ *     The memory used by the arguments is Gua_Freed.
+ */
+void Gua_FreeArguments(Gua_Short argc, Gua_Object *argv)
+{
+    Gua_Short i;
+    
+    for (i = 0; i < argc; i++) {
+        if (!Gua_IsObjectStored(argv[i])) {
+            Gua_FreeObject(&argv[i]);
+        }
+    }
+    
+    Gua_Free(argv);
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Object *Gua_PushArgument(Gua_Arguments *arguments)
+ *
+ * Description:
+ *     Add a new argument to an argument list. The list starts on the stack
+ *     and is moved to the heap only when it grows beyond GUA_ARGUMENTS_SIZE entries.
+ *
+ * Arguments:
+ *     arguments,    the argument list.
+ *
+ * Results:
+ *     The function returns a pointer to the new, cleared, argument.
+ */
+Gua_Object *Gua_PushArgument(Gua_Arguments *arguments)
+{
+    Gua_Object *argv;
+    Gua_Object *argument;
+    
+    if (arguments->argc == arguments->size) {
+        argv = (Gua_Object *)Gua_Alloc(sizeof(Gua_Object) * arguments->size * 2);
+        memcpy(argv, arguments->argv, sizeof(Gua_Object) * arguments->argc);
+        
+        if (arguments->argv != arguments->stack) {
+            Gua_Free(arguments->argv);
+        }
+        
+        arguments->argv = argv;
+        arguments->size = arguments->size * 2;
+    }
+    
+    argument = &arguments->argv[arguments->argc];
+    
+    Gua_ClearPObject(argument);
+    
+    arguments->argc++;
+    
+    return argument;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_String Gua_SkipArgument(Gua_String start, Gua_String separators, Gua_Token *token)
+ *
+ * Description:
+ *     Skip an argument, stopping at the first separator not enclosed
+ *     by quotes, parenthesis, brackets or braces.
+ *
+ * Arguments:
+ *     start,         a pointer to the start point of the expression to parse;
+ *     separators,    the characters ending the argument;
+ *     token,         the token status will be set to an error code if a
+ *                    quote or a delimiter is not closed.
+ *
+ * Results:
+ *     The function returns a pointer to the separator found or to the
+ *     end of the expression.
+ */
+Gua_String Gua_SkipArgument(Gua_String start, Gua_String separators, Gua_Token *token)
+{
+    Gua_String p;
+    
+    p = start;
+    
+    token->status = GUA_OK;
+    
+    while (*p != EXPRESSION_END) {
+        if (*p == SINGLE_QUOTE) {
+            p = Gua_ScanSingleQuotes(p, token);
+        } else if (*p == DOUBLE_QUOTE) {
+            p = Gua_ScanDoubleQuotes(p, token);
+        } else if (*p == PARENTHESIS_OPEN) {
+            p = Gua_ScanParenthesis(p, token);
+        } else if (*p == BRACKET_OPEN) {
+            p = Gua_ScanBracket(p, token);
+        } else if (*p == BRACE_OPEN) {
+            p = Gua_ScanBrace(p, token);
+        } else if (strchr(separators, *p) != NULL) {
+            break;
+        } else {
+            p++;
+        }
+        
+        if (token->status != GUA_OK) {
+            break;
+        }
+    }
+    
+    return p;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Gua_ScanArguments(Gua_Namespace *nspace, Gua_String start, Gua_Arguments *arguments, Gua_Status *status, Gua_String error)
+ *
+ * Description:
+ *     Parse the expression in a single pass, evaluating each argument
+ *     separated by comma and appending it to the argument list. If the
+ *     views field of the argument list is true, an argument that is just
+ *     a slice of a matrix variable is passed as a view of the matrix.
+ *
+ * Arguments:
+ *     nspace,       a pointer to a structure containing the variable and function namespace;
+ *     start,        a pointer to the start point of the expression to parse;
+ *     arguments,    the argument list;
+ *     status,       the parse status. GUA_OK if no error has occurred,
+ *                   a parse error number otherwise;
+ *     error,        the error message if any.
+ *
+ * Results:
+ *     The function returns GUA_OK if all arguments were evaluated,
+ *     GUA_ERROR otherwise.
+ */
+Gua_Status Gua_ScanArguments(Gua_Namespace *nspace, Gua_String start, Gua_Arguments *arguments, Gua_Status *status, Gua_String error)
+{
+    Gua_String p;
+    Gua_String s;
+    Gua_String expression;
+    Gua_Token token;
+    Gua_Token name[GUA_ARGUMENTS_SIZE];
+    Gua_Token index[GUA_ARGUMENTS_SIZE];
+    Gua_Short position[GUA_ARGUMENTS_SIZE];
+    Gua_Short views;
+    Gua_String errMessage;
+    
+    expression = (char *)Gua_Alloc(sizeof(char) * (strlen(start) + 1));
+    
+    views = 0;
+    p = start;
+    
+    while (true) {
+        s = p;
+        
+        p = Gua_SkipArgument(p, ",", &token);
+        
+        if (token.status != GUA_OK) {
+            *status = token.status;
+            
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", Gua_StatusTable[token.status]);
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            Gua_Free(expression);
+            
+            return GUA_ERROR;
+        }
+        
+        /* A slice is passed as a view once the other arguments are evaluated. */
+        if (arguments->views && (views < GUA_ARGUMENTS_SIZE) && (memchr(s, COLON, (Gua_Length)(p - s)) != NULL) && Gua_IsViewArgument(nspace, s, p, &name[views], &index[views])) {
+            position[views] = arguments->argc;
+            Gua_PushArgument(arguments);
+            views++;
+        } else {
+            memcpy(expression, s, (Gua_Length)(p - s));
+            expression[p - s] = '\0';
+            
+            Gua_Evaluate(nspace, expression, Gua_PushArgument(arguments), status, error);
+            
+            if (*status != GUA_OK) {
+                Gua_Free(expression);
+                return GUA_ERROR;
+            }
+        }
+        
+        if (*p == EXPRESSION_END) {
+            break;
+        }
+        
+        p++;
+    }
+    
+    Gua_Free(expression);
+    
+    if (views > 0) {
+        return Gua_ScanViews(nspace, arguments, views, position, name, index, status, error);
+    }
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Gua_ScanMatrixElements(Gua_Namespace *nspace, Gua_String start, Gua_Arguments *arguments, Gua_Status *status, Gua_String error)
+ *
+ * Description:
+ *     Parse a matrix literal in a single pass. Two arguments, the
+ *     number of rows and columns, are appended to the argument list,
+ *     followed by the matrix elements. Rows are separated by semicolon
+ *     or new line.
+ *
+ * Arguments:
+ *     nspace,       a pointer to a structure containing the variable and function namespace;
+ *     start,        a pointer to the start point of the expression to parse;
+ *     arguments,    the argument list, where argv[0] is the function name;
+ *     status,       the parse status. GUA_OK if no error has occurred,
+ *                   a parse error number otherwise;
+ *     error,        the error message if any.
+ *
+ * Results:
+ *     The function returns GUA_OK if all elements were evaluated,
+ *     GUA_ERROR otherwise.
+ */
+Gua_Status Gua_ScanMatrixElements(Gua_Namespace *nspace, Gua_String start, Gua_Arguments *arguments, Gua_Status *status, Gua_String error)
+{
+    Gua_String p;
+    Gua_String s;
+    Gua_String expression;
+    Gua_Token token;
+    Gua_Short first;
+    Gua_Integer rows;
+    Gua_Integer columns;
+    Gua_Integer n;
+    Gua_String errMessage;
+    
+    first = arguments->argc;
+    
+    Gua_PushArgument(arguments);
+    Gua_PushArgument(arguments);
+    
+    expression = (char *)Gua_Alloc(sizeof(char) * (strlen(start) + 1));
+    
+    rows = 0;
+    columns = 0;
+    n = 0;
+    
+    p = start;
+    
+    while (true) {
+        s = p;
+        
+        p = Gua_SkipArgument(p, ",;\n", &token);
+        
+        if (token.status != GUA_OK) {
+            *status = token.status;
+            
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", Gua_StatusTable[token.status]);
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            Gua_Free(expression);
+            
+            return GUA_ERROR;
+        }
+        
+        while ((s < p) && Gua_IsSpace(*s)) {
+            s++;
+        }
+        
+        /* Blank lines between rows are not elements. */
+        if ((s < p) || (n > 0) || (*p == COMMA)) {
+            memcpy(expression, s, (Gua_Length)(p - s));
+            expression[p - s] = '\0';
+            
+            Gua_Evaluate(nspace, expression, Gua_PushArgument(arguments), status, error);
+            
+            if (*status != GUA_OK) {
+                Gua_Free(expression);
+                return GUA_ERROR;
+            }
+            
+            n++;
+        }
+        
+        if ((*p != COMMA) && (n > 0)) {
+            if (columns == 0) {
+                columns = n;
+            } else if (columns != n) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s...\n", "the matrix has rows with diferent number of elements");
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                Gua_Free(expression);
+                
+                return GUA_ERROR;
+            }
+            
+            rows++;
+            n = 0;
+        }
+        
+        if (*p == EXPRESSION_END) {
+            break;
+        }
+        
+        p++;
+    }
+    
+    Gua_IntegerToObject(arguments->argv[first], rows);
+    Gua_IntegerToObject(arguments->argv[first + 1], columns);
+    
+    Gua_Free(expression);
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Gua_ReleaseArguments(Gua_Arguments *arguments)
+ *
+ * Description:
+ *     Free the memory used by an argument list.
+ *
+ * Arguments:
+ *     arguments,    the argument list.
+ *
+ * Results:
+ *     The arguments not stored elsewhere are freed, and so is the list
+ *     if it was moved to the heap.
+ */
+void Gua_ReleaseArguments(Gua_Arguments *arguments)
+{
+    Gua_Short i;
+    
+    for (i = 0; i < arguments->argc; i++) {
+        if (Gua_IsObjectView(arguments->argv[i])) {
+            Gua_FreeMatrixView(&arguments->argv[i]);
+        } else if (!Gua_IsObjectStored(arguments->argv[i])) {
+            Gua_FreeObject(&arguments->argv[i]);
+        }
+    }
+    
+    if (arguments->argv != arguments->stack) {
+        Gua_Free(arguments->argv);
+    }
+    
+    arguments->argc = 0;
+    arguments->size = GUA_ARGUMENTS_SIZE;
+    arguments->argv = arguments->stack;
+    arguments->views = false;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Gua_GetSimpleIndex(Gua_Namespace *nspace, Gua_String start, Gua_String end, Gua_Integer *index)
+ *
+ * Description:
+ *     Get the value of an index that is an integer number or
+ *     the name of a variable holding an integer.
+ *
+ * Arguments:
+ *     nspace,    a pointer to a structure containing the variable and function namespace;
+ *     start,     a pointer to the start point of the index;
+ *     end,       a pointer to the end of the index;
+ *     index,     the index value.
+ *
+ * Results:
+ *     The function returns GUA_OK if the index is a simple integer index,
+ *     GUA_ERROR otherwise. In this case the index must be evaluated.
+ */
+Gua_Status Gua_GetSimpleIndex(Gua_Namespace *nspace, Gua_String start, Gua_String end, Gua_Integer *index)
+{
+    Gua_String p;
+    Gua_Char name[64];
+    Gua_Object object;
+    Gua_Integer n;
+    
+    while ((start < end) && Gua_IsSpace(*start)) {
+        start++;
+    }
+    while ((end > start) && Gua_IsSpace(*(end - 1))) {
+        end--;
+    }
+    
+    if (start == end) {
+        return GUA_ERROR;
+    }
+    
+    if (isdigit(*start)) {
+        n = 0;
+        for (p = start; p < end; p++) {
+            if (!isdigit(*p)) {
+                return GUA_ERROR;
+            }
+            /* No matrix is that large; let the parser report the error. */
+            if (n > (LONG_MAX - (*p - '0')) / 10) {
+                return GUA_ERROR;
+            }
+            n = n * 10 + (*p - '0');
+        }
+        *index = n;
+        
+        return GUA_OK;
+    }
+    
+    if (!Gua_IsIdentifier(*start) || ((end - start) >= sizeof(name))) {
+        return GUA_ERROR;
+    }
+    
+    for (p = start; p < end; p++) {
+        if (!(isalnum(*p) || (*p == '.') || (*p == '_'))) {
+            return GUA_ERROR;
+        }
+    }
+    
+    memcpy(name, start, (Gua_Length)(end - start));
+    name[end - start] = '\0';
+    
+    if (Gua_GetVariable(nspace, name, &object, SCOPE_STACK) != OBJECT_TYPE_INTEGER) {
+        return GUA_ERROR;
+    }
+    
+    *index = Gua_ObjectToInteger(object);
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Gua_GetMatrixOffset(Gua_Namespace *nspace, Gua_String start, Gua_Length length, Gua_Object *matrix, Gua_Integer *offset)
+ *
+ * Description:
+ *     Compute the position of a matrix element from a list of one or two
+ *     simple indices, as in a[k] or a[i, j], without evaluating them.
+ *
+ * Arguments:
+ *     nspace,    a pointer to a structure containing the variable and function namespace;
+ *     start,     a pointer to the start point of the index list;
+ *     length,    the index list length;
+ *     matrix,    the matrix object;
+ *     offset,    the element position in the matrix object array.
+ *
+ * Results:
+ *     The function returns GUA_OK if the offset was computed. Otherwise
+ *     it returns GUA_ERROR, and the index list must be evaluated.
+ */
+Gua_Status Gua_GetMatrixOffset(Gua_Namespace *nspace, Gua_String start, Gua_Length length, Gua_Object *matrix, Gua_Integer *offset)
+{
+    Gua_Matrix *m;
+    Gua_String p;
+    Gua_String s;
+    Gua_String end;
+    Gua_Integer index[2];
+    Gua_Short n;
+    
+    if (Gua_PObjectType(matrix) != OBJECT_TYPE_MATRIX) {
+        return GUA_ERROR;
+    }
+    
+    m = (Gua_Matrix *)Gua_PObjectToMatrix(matrix);
+    
+    p = start;
+    end = start + length;
+    
+    n = 0;
+    
+    while (true) {
+        if (n == 2) {
+            return GUA_ERROR;
+        }
+        
+        s = p;
+        
+        while ((p < end) && (*p != COMMA)) {
+            p++;
         }
-    } else if (strcmp(Gua_ObjectToString(argv[0]), "type") == 0) {
-        if (argc != 2) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
+        
+        if (Gua_GetSimpleIndex(nspace, s, p, &index[n]) != GUA_OK) {
             return GUA_ERROR;
         }
         
-        Gua_IntegerToPObject(object, Gua_ObjectType(argv[1]));
+        n++;
+        
+        if (p == end) {
+            break;
+        }
+        
+        p++;
+    }
+    
+    if (n == 1) {
+        if ((index[0] < 0) || (index[0] >= Gua_PObjectLength(matrix))) {
+            return GUA_ERROR;
+        }
+        
+        *offset = index[0];
     } else {
-        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-        sprintf(errMessage, "%s %-.20s...\n", "unknown function", Gua_ObjectToString(argv[0]));
-        strcat(error, errMessage);
-        Gua_Free(errMessage);
+        if (m->dimc != 2) {
+            return GUA_ERROR;
+        }
+        if ((index[0] < 0) || (index[0] >= m->dimv[0]) || (index[1] < 0) || (index[1] >= m->dimv[1])) {
+            return GUA_ERROR;
+        }
         
-        return GUA_ERROR;
+        *offset = index[0] * m->dimv[1] + index[1];
     }
     
     return GUA_OK;
@@ -6802,55 +8805,57 @@ Gua_Status Gua_BuiltInFunction(void *nspace, Gua_Short argc, Gua_Object *argv, G
  *     C
  *
  * Function:
- *     Gua_Status Gua_CountArguments(Gua_String start)
+ *     void Gua_StoreMatrixElement(Gua_Object *element, Gua_Object *object)
  *
  * Description:
- *     Parse the expression and count the number o arguments separated by comma.
+ *     Store an object in a matrix element, in place.
  *
  * Arguments:
- *     start,    a pointer to the start point of the expression to parse.
+ *     element,    the matrix element;
+ *     object,     the object to store. Strings, files and handles not
+ *                 stored elsewhere are linked and marked as stored.
  *
  * Results:
- *     The function returns the number o arguments separated by comma.
- *
+ *     The matrix element is replaced. Storing an element in itself does
+ *     nothing.
  */
-Gua_Status Gua_CountArguments(Gua_String start)
+void Gua_StoreMatrixElement(Gua_Object *element, Gua_Object *object)
 {
-    Gua_String p;
-    Gua_Short argc;
-    Gua_Token token;
-    
-    p = start;
+    /* The object may be the element itself, as in m[0, 0] = m[0, 0]. */
+    if ((Gua_PObjectType(element) == OBJECT_TYPE_STRING) && (Gua_PObjectType(object) == OBJECT_TYPE_STRING) && (Gua_PObjectToString(element) == Gua_PObjectToString(object))) {
+        return;
+    }
     
-    argc = 0;
+    if (Gua_PObjectType(element) == OBJECT_TYPE_STRING) {
+        Gua_FreeObject(element);
+    }
     
-    if (strlen(start) > 0) {
-        argc++;
-        
-        while (*p != EXPRESSION_END) {
-            if (*p == SINGLE_QUOTE) {
-                p = Gua_ScanSingleQuotes(p, &token);
-                p--;
-            } else if (*p == DOUBLE_QUOTE) {
-                p = Gua_ScanDoubleQuotes(p, &token);
-                p--;
-            } else if (*p == PARENTHESIS_OPEN) {
-                p = Gua_ScanParenthesis(p, &token);
-                p--;
-            } else if (*p == BRACKET_OPEN) {
-                p = Gua_ScanBracket(p, &token);
-                p--;
-            } else if (*p == BRACE_OPEN) {
-                p = Gua_ScanBrace(p, &token);
-                p--;
-            } else if (*p == COMMA) {
-                argc++;
-            }
-            p++;
+    if (Gua_PObjectType(object) == OBJECT_TYPE_STRING) {
+        if (Gua_IsPObjectStored(object)) {
+            Gua_ByteArrayToPObject(element, Gua_PObjectToString(object), Gua_PObjectLength(object));
+        } else {
+            Gua_LinkByteArrayToPObject(element, Gua_PObjectToString(object), Gua_PObjectLength(object));
+            Gua_SetStoredPObject(object);
+        }
+    } else if (Gua_PObjectType(object) == OBJECT_TYPE_FILE) {
+        if (Gua_IsPObjectStored(object)) {
+            Gua_CopyFile(element, object, true);
+        } else {
+            Gua_LinkPObjects(element, object);
+            Gua_SetStoredPObject(object);
+        }
+    } else if (Gua_PObjectType(object) == OBJECT_TYPE_HANDLE) {
+        if (Gua_IsPObjectStored(object)) {
+            Gua_CopyHandle(element, object, true);
+        } else {
+            Gua_LinkPObjects(element, object);
+            Gua_SetStoredPObject(object);
         }
+    } else {
+        Gua_LinkPObjects(element, object);
     }
     
-    return argc;
+    Gua_SetStoredPObject(element);
 }
 
 /**
@@ -6858,94 +8863,219 @@ Gua_Status Gua_CountArguments(Gua_String start)
  *     C
  *
  * Function:
- *     Gua_Status Gua_ParseArguments(Gua_Namespace *nspace, Gua_String start, Gua_Short argc, Gua_Object *argv, Gua_Short first, Gua_Status *status, Gua_String error)
+ *     Gua_Status Gua_ScanSlice(Gua_Namespace *nspace, Gua_String start, Gua_Length length, Gua_Object *matrix, Gua_Length *first, Gua_Length *last, Gua_Status *status, Gua_String error)
  *
  * Description:
- *     Parse the expression and return a vector containing each argument.
+ *     Evaluate the bounds of a slice. Each index may be a single row or
+ *     column, or a range lower:upper including lower and excluding upper.
+ *     An omitted bound is the first or the last row or column. A slice
+ *     with a single index selects a range of a vector.
  *
  * Arguments:
  *     nspace,    a pointer to a structure containing the variable and function namespace;
- *     start,     a pointer to the start point of the expression to parse;
- *     argc,      the number of arguments;
- *     argv,      an array containing the arguments;
- *     first,     the first element in array to fill;
+ *     start,     a pointer to the start point of the index list;
+ *     length,    the index list length;
+ *     matrix,    the matrix object;
+ *     first,     the first row and column of the block;
+ *     last,      the row and column after the last ones of the block;
  *     status,    the parse status. GUA_OK if no error has occurred,
  *                a parse error number otherwise;
  *     error,     the error message if any.
  *
  * Results:
- *     The function returns a vector containing each argument in expression.
- *
+ *     The function returns GUA_OK if the slice is valid, GUA_ERROR otherwise.
  */
-Gua_Status Gua_ParseArguments(Gua_Namespace *nspace, Gua_String start, Gua_Short argc, Gua_Object *argv, Gua_Short first, Gua_Status *status, Gua_String error)
+Gua_Status Gua_ScanSlice(Gua_Namespace *nspace, Gua_String start, Gua_Length length, Gua_Object *matrix, Gua_Length *first, Gua_Length *last, Gua_Status *status, Gua_String error)
 {
+    Gua_Matrix *m;
+    Gua_String expression;
     Gua_String p;
     Gua_String s;
-    Gua_String expression;
+    Gua_String t;
+    Gua_Object bound;
     Gua_Token token;
+    Gua_Length size[2];
+    Gua_Integer value[2][2];
+    Gua_Short range[2];
+    Gua_Short given[2][2];
+    Gua_Short axis[2];
+    Gua_Char separator;
+    Gua_Short valid;
+    Gua_Short n;
+    Gua_Short k;
     Gua_Short i;
     Gua_String errMessage;
     
-    p = start;
+    m = (Gua_Matrix *)Gua_PObjectToMatrix(matrix);
     
-    expression = (char *)Gua_Alloc(sizeof(char) * (strlen(start) + 1));
-    memset(expression, '\0', sizeof(char) * (strlen(start) + 1));
+    if ((m == NULL) || (m->dimc > 2)) {
+        *status = GUA_ERROR;
+        
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "only bidimensional matrices can be sliced");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
     
-    i = first;
+    expression = (char *)Gua_Alloc(sizeof(char) * (length + 1));
+    memcpy(expression, start, length);
+    expression[length] = '\0';
     
-    s = p;
+    Gua_ClearObject(bound);
     
-    if (argc > 1) {
-        while (true) {
-            p = Gua_NextToken(nspace, p, &token);
+    valid = true;
+    n = 0;
+    k = 0;
+    range[0] = false;
+    given[0][0] = false;
+    given[0][1] = false;
+    
+    p = expression;
+    
+    /* Split the index list at the commas and colons, evaluating each bound. */
+    while (true) {
+        s = p;
+        
+        p = Gua_SkipArgument(p, ",:", &token);
+        
+        if (token.status != GUA_OK) {
+            *status = token.status;
             
-            if (token.status != GUA_OK) {
-                *status = token.status;
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", Gua_StatusTable[token.status]);
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            Gua_Free(expression);
+            
+            return GUA_ERROR;
+        }
+        
+        separator = *p;
+        *p = '\0';
+        
+        for (t = s; (*t != '\0') && Gua_IsSpace(*t); t++);
+        
+        if (*t != '\0') {
+            Gua_Evaluate(nspace, s, &bound, status, error);
+            
+            if (*status != GUA_OK) {
+                Gua_Free(expression);
+                return GUA_ERROR;
+            }
+            
+            if (Gua_ObjectType(bound) != OBJECT_TYPE_INTEGER) {
+                *status = GUA_ERROR;
                 
                 errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-                sprintf(errMessage, "%s...\n", Gua_StatusTable[token.status]);
+                sprintf(errMessage, "%s %-.20s...\n", "illegal index", s);
                 strcat(error, errMessage);
                 Gua_Free(errMessage);
                 
+                if (!Gua_IsObjectStored(bound)) {
+                    Gua_FreeObject(&bound);
+                }
                 Gua_Free(expression);
                 
                 return GUA_ERROR;
             }
             
-            if (token.type == TOKEN_TYPE_ARG_SEPARATOR) {
-                strncpy(expression, s, (Gua_Length)(p - s - 1));
-                
-                Gua_Evaluate(nspace, expression, &argv[i], status, error);
-                
-                if (*status != GUA_OK) {
-                    Gua_Free(expression);
-                    return GUA_ERROR;
-                }
-                
-                s = p;
-                
-                if (i < (argc - 1)) {
-                    memset(expression, '\0', sizeof(char) * (strlen(start) + 1));
-                    i++;
-                } else {
-                    break;
-                }
-            } else if (token.type == TOKEN_TYPE_END) {
+            value[n][k] = Gua_ObjectToInteger(bound);
+            given[n][k] = true;
+        }
+        
+        if (separator == COLON) {
+            if (range[n]) {
+                valid = false;
+                break;
+            }
+            
+            range[n] = true;
+            k = 1;
+        } else {
+            if (!range[n] && !given[n][0]) {
+                valid = false;
+                break;
+            }
+            
+            n++;
+            
+            if ((separator == EXPRESSION_END) || (n == 2)) {
                 break;
             }
+            
+            k = 0;
+            range[n] = false;
+            given[n][0] = false;
+            given[n][1] = false;
         }
+        
+        p++;
     }
     
-    strcpy(expression, s);
+    Gua_Free(expression);
     
-    Gua_Evaluate(nspace, expression, &argv[i], status, error);
+    if (!valid || (separator != EXPRESSION_END)) {
+        *status = GUA_ERROR;
+        
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "illegal slice");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
     
-    Gua_Free(expression);
+    /* A vector is seen as a single row. */
+    size[0] = m->dimc == 2 ? m->dimv[0] : 1;
+    size[1] = m->dimc == 2 ? m->dimv[1] : m->dimv[0];
     
-    if (*status != GUA_OK) {
+    first[0] = 0;
+    last[0] = size[0];
+    first[1] = 0;
+    last[1] = size[1];
+    
+    if (n == 2) {
+        axis[0] = 0;
+        axis[1] = 1;
+    } else if (size[0] == 1) {
+        axis[0] = 1;
+    } else if (size[1] == 1) {
+        axis[0] = 0;
+    } else {
+        *status = GUA_ERROR;
+        
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "a slice of a matrix needs two indices");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
         return GUA_ERROR;
     }
     
+    for (i = 0; i < n; i++) {
+        if (range[i]) {
+            first[axis[i]] = given[i][0] ? value[i][0] : 0;
+            last[axis[i]] = given[i][1] ? value[i][1] : size[axis[i]];
+        } else {
+            first[axis[i]] = value[i][0];
+            last[axis[i]] = value[i][0] + 1;
+        }
+        
+        if ((first[axis[i]] < 0) || (first[axis[i]] >= last[axis[i]]) || (last[axis[i]] > size[axis[i]])) {
+            *status = GUA_ERROR;
+            
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "index out of bound");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+    }
+    
     return GUA_OK;
 }
 
@@ -6954,55 +9084,89 @@ Gua_Status Gua_ParseArguments(Gua_Namespace *nspace, Gua_String start, Gua_Short
  *     C
  *
  * Function:
- *     Gua_Status Gua_CountCommands(Gua_String start)
+ *     void Gua_CopyMatrixBlock(Gua_Object *source, Gua_Short dimc, Gua_Length rows, Gua_Length cols, Gua_Length stride, Gua_Object *object)
  *
  * Description:
- *     Parse the expression and count the number o arguments separated by comma.
+ *     Copy a block of cells to a new matrix.
  *
  * Arguments:
- *     start,    a pointer to the start point of the expression to parse.
+ *     source,    the first cell of the block;
+ *     dimc,      the number of dimensions of the new matrix, 1 or 2;
+ *     rows,      the number of rows of the block;
+ *     cols,      the number of columns of the block;
+ *     stride,    the distance between the rows of the block;
+ *     object,    a structure containing the return object of the function.
  *
  * Results:
- *     The function returns the number o arguments separated by comma.
- *
+ *     A new matrix holding the block. A matrix with one dimension is a
+ *     vector with cols elements.
  */
-Gua_Status Gua_CountCommands(Gua_String start)
+void Gua_CopyMatrixBlock(Gua_Object *source, Gua_Short dimc, Gua_Length rows, Gua_Length cols, Gua_Length stride, Gua_Object *object)
 {
-    Gua_String p;
-    Gua_Short argc;
-    Gua_Token token;
-    
-    p = start;
+    Gua_Matrix *b;
+    Gua_Object *target;
+    Gua_Object cell;
+    Gua_Length i;
+    Gua_Length j;
+    
+    b = (Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix));
+    b->dimc = dimc;
+    b->dimv = (Gua_Length *)Gua_Alloc(b->dimc * sizeof(Gua_Length));
+    
+    if (b->dimc == 2) {
+        b->dimv[0] = rows;
+        b->dimv[1] = cols;
+    } else {
+        b->dimv[0] = cols;
+    }
     
-    argc = 0;
+    b->object = (struct Gua_Object *)Gua_Alloc(rows * cols * sizeof(Gua_Object));
+    target = (Gua_Object *)b->object;
     
-    if (strlen(start) > 0) {
-        argc++;
-        
-        while (*p != EXPRESSION_END) {
-            if (*p == SINGLE_QUOTE) {
-                p = Gua_ScanSingleQuotes(p, &token);
-                p--;
-            } else if (*p == DOUBLE_QUOTE) {
-                p = Gua_ScanDoubleQuotes(p, &token);
-                p--;
-            } else if (*p == PARENTHESIS_OPEN) {
-                p = Gua_ScanParenthesis(p, &token);
-                p--;
-            } else if (*p == BRACKET_OPEN) {
-                p = Gua_ScanBracket(p, &token);
-                p--;
-            } else if (*p == BRACE_OPEN) {
-                p = Gua_ScanBrace(p, &token);
-                p--;
-            } else if (*p == SEMI_COLON) {
-                argc++;
-            }
-            p++;
+    for (i = 0; i < rows; i++) {
+        for (j = 0; j < cols; j++) {
+            /* Stored cells are copied, so the block owns its strings. */
+            Gua_LinkObjects(cell, source[i * stride + j]);
+            Gua_SetStoredObject(cell);
+            
+            Gua_ClearObject(target[i * cols + j]);
+            Gua_StoreMatrixElement(&target[i * cols + j], &cell);
         }
     }
     
-    return argc;
+    Gua_MatrixToPObject(object, (struct Gua_Matrix *)b, rows * cols);
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Gua_GetMatrixSlice(Gua_Object *matrix, Gua_Length *first, Gua_Length *last, Gua_Object *object)
+ *
+ * Description:
+ *     Copy a block of a matrix. Only the cells of the block are read.
+ *
+ * Arguments:
+ *     matrix,    the matrix object;
+ *     first,     the first row and column of the block;
+ *     last,      the row and column after the last ones of the block;
+ *     object,    a structure containing the return object of the function.
+ *
+ * Results:
+ *     A new matrix holding the block. Slices of vectors are vectors.
+ */
+Gua_Status Gua_GetMatrixSlice(Gua_Object *matrix, Gua_Length *first, Gua_Length *last, Gua_Object *object)
+{
+    Gua_Matrix *m;
+    Gua_Length columns;
+    
+    m = (Gua_Matrix *)Gua_PObjectToMatrix(matrix);
+    columns = m->dimc == 2 ? m->dimv[1] : m->dimv[0];
+    
+    Gua_CopyMatrixBlock((Gua_Object *)m->object + first[0] * columns + first[1], m->dimc, last[0] - first[0], last[1] - first[1], columns, object);
+    
+    return GUA_OK;
 }
 
 /**
@@ -7010,60 +9174,48 @@ Gua_Status Gua_CountCommands(Gua_String start)
  *     C
  *
  * Function:
- *     Gua_Status Gua_ParseCommands(Gua_Namespace *nspace, Gua_String start, Gua_Short argc, Gua_Object *argv, Gua_Status *status, Gua_String error)
+ *     void Gua_GetMatrixView(Gua_Object *matrix, Gua_Length *first, Gua_Length *last, Gua_Object *object)
  *
  * Description:
- *     Parse the expression and return a vector containing each argument.
+ *     Make a read only view of a block of a matrix. The view points to the
+ *     cells of the matrix, so no cell is copied.
  *
  * Arguments:
- *     nspace,    a pointer to a structure containing the variable and function namespace;
- *     start,     a pointer to the start point of the expression to parse;
- *     argc,      the number of arguments;
- *     argv,      an array containing the arguments;
- *     status,    the parse status. GUA_OK if no error has occurred,
- *                a parse error number otherwise;
- *     error,     the error message if any.
+ *     matrix,    the matrix object;
+ *     first,     the first row and column of the block;
+ *     last,      the row and column after the last ones of the block;
+ *     object,    a structure containing the view.
  *
  * Results:
- *     The function returns a vector containing each argument in expression.
- *
+ *     A matrix object with the shape of the block, whose cells are rows of
+ *     the block one row stride apart. A view is marked as stored, so it
+ *     never frees the cells, and must be released with Gua_FreeMatrixView.
  */
-Gua_Status Gua_ParseCommands(Gua_Namespace *nspace, Gua_String start, Gua_Short argc, Gua_Object *argv, Gua_Status *status, Gua_String error)
+void Gua_GetMatrixView(Gua_Object *matrix, Gua_Length *first, Gua_Length *last, Gua_Object *object)
 {
-    Gua_String p;
-    Gua_String s;
-    Gua_Token token;
-    Gua_Short i;
-    
-    p = start;
+    Gua_Matrix *m;
+    Gua_Matrix *v;
+    Gua_Length columns;
     
-    i = 0;
+    m = (Gua_Matrix *)Gua_PObjectToMatrix(matrix);
+    columns = m->dimc == 2 ? m->dimv[1] : m->dimv[0];
     
-    s = p;
+    v = (Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix));
+    v->dimc = m->dimc;
+    v->dimv = (Gua_Length *)Gua_Alloc(v->dimc * sizeof(Gua_Length));
     
-    if (argc > 1) {
-        while (true) {
-            p = Gua_NextToken(nspace, p, &token);
-            
-            if (token.type == TOKEN_TYPE_SEPARATOR) {
-                Gua_ByteArrayToObject(argv[i], s, (Gua_Length)(p - s - 1));
-                
-                s = p;
-                
-                if (i < (argc - 1)) {
-                    i++;
-                } else {
-                    break;
-                }
-            } else if (token.type == TOKEN_TYPE_END) {
-                break;
-            }
-        }
+    if (v->dimc == 2) {
+        v->dimv[0] = last[0] - first[0];
+        v->dimv[1] = last[1] - first[1];
+    } else {
+        v->dimv[0] = last[1] - first[1];
     }
     
-    Gua_ByteArrayToObject(argv[i], s, (Gua_Length)(p - s + 1));
+    v->object = (struct Gua_Object *)((Gua_Object *)m->object + first[0] * columns + first[1]);
     
-    return GUA_OK;
+    Gua_MatrixToPObject(object, (struct Gua_Matrix *)v, (last[0] - first[0]) * (last[1] - first[1]));
+    Gua_PObjectStride(object) = columns;
+    Gua_SetStoredPObject(object);
 }
 
 /**
@@ -7071,60 +9223,27 @@ Gua_Status Gua_ParseCommands(Gua_Namespace *nspace, Gua_String start, Gua_Short
  *     C
  *
  * Function:
- *     Gua_Status Gua_ParseFormalArguments(Gua_Namespace *nspace, Gua_String start, Gua_Short argc, Gua_Object *argv, Gua_Status *status, Gua_String error)
+ *     void Gua_FreeMatrixView(Gua_Object *object)
  *
  * Description:
- *     Parse the expression and return a vector containing each argument.
+ *     Free a matrix view, leaving the cells it points to untouched.
  *
  * Arguments:
- *     nspace,    a pointer to a structure containing the variable and function namespace;
- *     start,     a pointer to the start point of the expression to parse;
- *     argc,      the number of arguments;
- *     argv,      an array containing the arguments;
- *     status,    the parse status. GUA_OK if no error has occurred,
- *                a parse error number otherwise;
- *     error,     the error message if any.
+ *     object,    the view.
  *
  * Results:
- *     The function returns a vector containing each argument in expression.
- *
+ *     The object is cleared.
  */
-Gua_Status Gua_ParseFormalArguments(Gua_Namespace *nspace, Gua_String start, Gua_Short argc, Gua_Object *argv, Gua_Status *status, Gua_String error)
+void Gua_FreeMatrixView(Gua_Object *object)
 {
-    Gua_String p;
-    Gua_String s;
-    Gua_Token token;
-    Gua_Short i;
-    
-    p = start;
-    
-    i = 0;
-    
-    s = p;
+    Gua_Matrix *v;
     
-    if (argc > 1) {
-        while (true) {
-            p = Gua_NextToken(nspace, p, &token);
-            
-            if (token.type == TOKEN_TYPE_ARG_SEPARATOR) {
-                Gua_ByteArrayToObject(argv[i], s, (Gua_Length)(p - s - 1));
-                
-                s = p;
-                
-                if (i < (argc - 1)) {
-                    i++;
-                } else {
-                    break;
-                }
-            } else if (token.type == TOKEN_TYPE_END) {
-                break;
-            }
-        }
-    }
+    v = (Gua_Matrix *)Gua_PObjectToMatrix(object);
     
-    Gua_StringToObject(argv[i], s);
+    Gua_Free(v->dimv);
+    Gua_Free(v);
     
-    return GUA_OK;
+    Gua_ClearPObject(object);
 }
 
 /**
@@ -7132,57 +9251,40 @@ Gua_Status Gua_ParseFormalArguments(Gua_Namespace *nspace, Gua_String start, Gua
  *     C
  *
  * Function:
- *     Gua_Status Gua_CountMatrixElements(Gua_String start)
+ *     void Gua_MaterializeView(Gua_Object *object)
  *
  * Description:
- *     Parse the expression and count the number o arguments separated by comma.
+ *     Replace a matrix view with a copy of its block, for code that needs
+ *     the cells of a matrix to be contiguous.
  *
  * Arguments:
- *     start,    a pointer to the start point of the expression to parse.
+ *     object,    a matrix view or any other object.
  *
  * Results:
- *     The function returns the number o arguments separated by comma.
- *
+ *     If the object is a view, it becomes a new matrix that is not
+ *     stored; other objects are left untouched.
  */
-Gua_Status Gua_CountMatrixElements(Gua_String start)
+void Gua_MaterializeView(Gua_Object *object)
 {
-    Gua_String p;
-    Gua_Short argc;
-    Gua_Token token;
+    Gua_Matrix *v;
+    Gua_Object copy;
     
-    p = start;
+    if (!Gua_IsPObjectView(object)) {
+        return;
+    }
     
-    argc = 0;
+    v = (Gua_Matrix *)Gua_PObjectToMatrix(object);
     
-    if (strlen(start) > 0) {
-        argc++;
-        
-        while (*p != EXPRESSION_END) {
-            if (*p == SINGLE_QUOTE) {
-                p = Gua_ScanSingleQuotes(p, &token);
-                p--;
-            } else if (*p == DOUBLE_QUOTE) {
-                p = Gua_ScanDoubleQuotes(p, &token);
-                p--;
-            } else if (*p == PARENTHESIS_OPEN) {
-                p = Gua_ScanParenthesis(p, &token);
-                p--;
-            } else if (*p == BRACKET_OPEN) {
-                p = Gua_ScanBracket(p, &token);
-                p--;
-            } else if (*p == BRACE_OPEN) {
-                p = Gua_ScanBrace(p, &token);
-                p--;
-            } else if (*p == COMMA) {
-                argc++;
-            } else if (*p == SEMI_COLON) {
-                argc++;
-            }
-            p++;
-        }
+    Gua_ClearObject(copy);
+    
+    if (v->dimc == 2) {
+        Gua_CopyMatrixBlock((Gua_Object *)v->object, 2, v->dimv[0], v->dimv[1], Gua_PObjectStride(object), &copy);
+    } else {
+        Gua_CopyMatrixBlock((Gua_Object *)v->object, 1, 1, v->dimv[0], Gua_PObjectStride(object), &copy);
     }
     
-    return argc;
+    Gua_FreeMatrixView(object);
+    Gua_LinkToPObject(object, copy);
 }
 
 /**
@@ -7190,156 +9292,156 @@ Gua_Status Gua_CountMatrixElements(Gua_String start)
  *     C
  *
  * Function:
- *     Gua_Status Gua_ParseMatrixElements(Gua_Namespace *nspace, Gua_String start, Gua_Short argc, Gua_Object *argv, Gua_Status *status, Gua_String error)
+ *     Gua_Short Gua_IsViewArgument(Gua_Namespace *nspace, Gua_String start, Gua_String end, Gua_Token *name, Gua_Token *index)
  *
  * Description:
- *     Parse the expression and return a vector containing each argument.
+ *     Check if a function argument is a slice of a variable and nothing
+ *     else, as in sum(a[r0:r1, c0:c1]).
  *
  * Arguments:
  *     nspace,    a pointer to a structure containing the variable and function namespace;
- *     start,     a pointer to the start point of the expression to parse;
- *     argc,      the number of arguments;
- *     argv,      an array containing the arguments, where
- *                argv[0] will be the function name,
- *                argv[1] will be the m size(m x n),
- *                argv[2] will be the n size(m x n);
- *     status,    the parse status. GUA_OK if no error has occurred,
- *                a parse error number otherwise;
- *     error,     the error message if any.
+ *     start,     a pointer to the start point of the argument;
+ *     end,       a pointer to the end of the argument;
+ *     name,      the token of the variable name;
+ *     index,     the token of the slice.
  *
  * Results:
- *     The function returns a vector containing each argument in expression.
- *
+ *     The function returns true if the argument can be passed as a view.
+ *     Nothing is evaluated.
  */
-Gua_Status Gua_ParseMatrixElements(Gua_Namespace *nspace, Gua_String start, Gua_Short argc, Gua_Object *argv, Gua_Status *status, Gua_String error)
+Gua_Short Gua_IsViewArgument(Gua_Namespace *nspace, Gua_String start, Gua_String end, Gua_Token *name, Gua_Token *index)
 {
     Gua_String p;
-    Gua_String s;
-    Gua_String expression;
-    Gua_Token token;
-    Gua_Short i;
-    Gua_Integer n;
-    Gua_String errMessage;
-    
-    p = start;
     
-    expression = (char *)Gua_Alloc(sizeof(char) * (strlen(start) + 1));
-    memset(expression, '\0', sizeof(char) * (strlen(start) + 1));
+    p = Gua_NextToken(nspace, start, name);
     
-    i = 3;
+    if ((name->status != GUA_OK) || (name->type != TOKEN_TYPE_VARIABLE)) {
+        return false;
+    }
     
-    Gua_IntegerToObject(argv[1], 1);
-    Gua_IntegerToObject(argv[2], 1);
+    p = Gua_NextToken(nspace, p, index);
     
-    n = 1;
+    if ((index->status != GUA_OK) || (index->type != TOKEN_TYPE_BRACKET) || !Gua_IsSliceToken(index)) {
+        return false;
+    }
     
-    s = p;
+    while ((p < end) && Gua_IsSpace(*p)) {
+        p++;
+    }
     
-    if (argc > 4) {       
-        while (true) {
-            p = Gua_NextToken(nspace, p, &token);
-            
-            if (token.status != GUA_OK) {
-                *status = token.status;
-                
-                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-                sprintf(errMessage, "%s...\n", Gua_StatusTable[token.status]);
-                strcat(error, errMessage);
-                Gua_Free(errMessage);
-                
-                Gua_Free(expression);
-                
-                return GUA_ERROR;
-            }
-            
-            if (token.type == TOKEN_TYPE_SEPARATOR) {
-                if (Gua_ObjectToInteger(argv[2]) == 1) {
-                    Gua_IntegerToObject(argv[2], n);
-                } else {
-                    if (Gua_ObjectToInteger(argv[2]) != n) {
-                        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-                        sprintf(errMessage, "%s...\n", "the matrix has rows with diferent number of elements");
-                        strcat(error, errMessage);
-                        Gua_Free(errMessage);
-                        
-                        Gua_Free(expression);
-                        
-                        return GUA_ERROR;
-                    }
-                }
-                
-                Gua_IntegerToObject(argv[1], Gua_ObjectToInteger(argv[1]) + 1);
-                n = 1;
-                
-                strncpy(expression, s, (Gua_Length)(p - s - 1));
-                
-                Gua_Evaluate(nspace, expression, &argv[i], status, error);
-                
-                if (*status != GUA_OK) {
-                    Gua_Free(expression);
-                    return GUA_ERROR;
-                }
-                
-                s = p;
-                
-                if (i < (argc - 1)) {
-                    memset(expression, '\0', sizeof(char) * (strlen(start) + 1));
-                    i++;
-                } else {
-                    break;
-                }
-           } else if (token.type == TOKEN_TYPE_ARG_SEPARATOR) {
-                n++;
-                
-                strncpy(expression, s, (Gua_Length)(p - s - 1));
-                
-                Gua_Evaluate(nspace, expression, &argv[i], status, error);
-                
-                if (*status != GUA_OK) {
-                    Gua_Free(expression);
-                    return GUA_ERROR;
-                }
-                
-                s = p;
-                
-                if (i < (argc - 1)) {
-                    memset(expression, '\0', sizeof(char) * (strlen(start) + 1));
-                    i++;
-                } else {
-                    break;
-                }
-            } else if (token.type == TOKEN_TYPE_END) {
-                if (Gua_ObjectToInteger(argv[2]) == 1) {
-                    Gua_IntegerToObject(argv[2], n);
-                }
-                break;
-            }
+    return p == end;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Gua_ScanViews(Gua_Namespace *nspace, Gua_Arguments *arguments, Gua_Short count, Gua_Short *position, Gua_Token *name, Gua_Token *index, Gua_Status *status, Gua_String error)
+ *
+ * Description:
+ *     Evaluate the slices left out by Gua_ScanArguments and store a view of
+ *     each one in its argument. The bounds of every slice are evaluated
+ *     before any view is made, and each matrix is looked up again after
+ *     that, so no script code can change a matrix under a view.
+ *
+ * Arguments:
+ *     nspace,       a pointer to a structure containing the variable and function namespace;
+ *     arguments,    the argument list;
+ *     count,        the number of slices;
+ *     position,     the argument of each slice;
+ *     name,         the token of the variable name of each slice;
+ *     index,        the token of each slice;
+ *     status,       the parse status. GUA_OK if no error has occurred,
+ *                   a parse error number otherwise;
+ *     error,        the error message if any.
+ *
+ * Results:
+ *     The function returns GUA_OK if all slices were evaluated,
+ *     GUA_ERROR otherwise. A slice of anything but a matrix is evaluated
+ *     as an ordinary argument.
+ */
+Gua_Status Gua_ScanViews(Gua_Namespace *nspace, Gua_Arguments *arguments, Gua_Short count, Gua_Short *position, Gua_Token *name, Gua_Token *index, Gua_Status *status, Gua_String error)
+{
+    Gua_String variable[GUA_ARGUMENTS_SIZE];
+    Gua_String expression;
+    Gua_Object matrix;
+    Gua_Length first[GUA_ARGUMENTS_SIZE][2];
+    Gua_Length last[GUA_ARGUMENTS_SIZE][2];
+    Gua_Matrix *m;
+    Gua_Length size[2];
+    Gua_Length length;
+    Gua_Short valid;
+    Gua_Short k;
+    Gua_String errMessage;
+    
+    for (k = 0; k < count; k++) {
+        variable[k] = (char *)Gua_Alloc(sizeof(char) * (name[k].length + 1));
+        memcpy(variable[k], name[k].start, name[k].length);
+        variable[k][name[k].length] = '\0';
+    }
+    
+    valid = true;
+    
+    for (k = 0; valid && (k < count); k++) {
+        if (Gua_GetVariable(nspace, variable[k], &matrix, SCOPE_STACK) == OBJECT_TYPE_MATRIX) {
+            valid = Gua_ScanSlice(nspace, index[k].start, index[k].length, &matrix, first[k], last[k], status, error) == GUA_OK;
+        } else {
+            /* Let the ordinary parser handle, or reject, the index. */
+            length = (Gua_Length)(index[k].start + index[k].length + 1 - name[k].start);
+            expression = (char *)Gua_Alloc(sizeof(char) * (length + 1));
+            memcpy(expression, name[k].start, length);
+            expression[length] = '\0';
+            
+            Gua_Evaluate(nspace, expression, &arguments->argv[position[k]], status, error);
+            
+            Gua_Free(expression);
+            
+            valid = *status == GUA_OK;
+            
+            Gua_Free(variable[k]);
+            variable[k] = NULL;
         }
     }
     
-    if (Gua_ObjectToInteger(argv[2]) != n) {
-        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-        sprintf(errMessage, "%s...\n", "the matrix has rows with diferent number of elements");
-        strcat(error, errMessage);
-        Gua_Free(errMessage);
+    for (k = 0; valid && (k < count); k++) {
+        if (variable[k] == NULL) {
+            continue;
+        }
         
-        Gua_Free(expression);
+        m = NULL;
         
-        return GUA_ERROR;
+        if (Gua_GetVariable(nspace, variable[k], &matrix, SCOPE_STACK) == OBJECT_TYPE_MATRIX) {
+            m = (Gua_Matrix *)Gua_ObjectToMatrix(matrix);
+        }
+        
+        if ((m == NULL) || (m->dimc > 2)) {
+            valid = false;
+        } else {
+            size[0] = m->dimc == 2 ? m->dimv[0] : 1;
+            size[1] = m->dimc == 2 ? m->dimv[1] : m->dimv[0];
+            valid = (last[k][0] <= size[0]) && (last[k][1] <= size[1]);
+        }
+        
+        if (!valid) {
+            *status = GUA_ERROR;
+            
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "index out of bound", variable[k]);
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+        } else {
+            Gua_GetMatrixView(&matrix, first[k], last[k], &arguments->argv[position[k]]);
+        }
     }
     
-    strcpy(expression, s);
-    
-    Gua_Evaluate(nspace, expression, &argv[i], status, error);
-    
-    if (*status != GUA_OK) {
-        Gua_Free(expression);
-        return GUA_ERROR;
+    for (k = 0; k < count; k++) {
+        if (variable[k] != NULL) {
+            Gua_Free(variable[k]);
+        }
     }
     
-    Gua_Free(expression);
-    
-    return GUA_OK;
+    return valid ? GUA_OK : GUA_ERROR;
 }
 
 /**
@@ -7347,30 +9449,82 @@ Gua_Status Gua_ParseMatrixElements(Gua_Namespace *nspace, Gua_String start, Gua_
  *     C
  *
  * Function:
- *     void Gua_FreeArguments(Gua_Short argc, Gua_Object *argv)
+ *     Gua_Status Gua_SetMatrixSlice(Gua_Object *matrix, Gua_Length *first, Gua_Length *last, Gua_Object *object, Gua_String error)
  *
  * Description:
- *     Free argument's memory.
+ *     Overwrite a block of a matrix, in place.
  *
  * Arguments:
- *     argc,    the number of arguments;
- *     argv,    an array containing the arguments;
- *              argv[0] is the function name.
+ *     matrix,    the matrix object;
+ *     first,     the first row and column of the block;
+ *     last,      the row and column after the last ones of the block;
+ *     object,    a scalar stored in every cell of the block, or a matrix
+ *                with as many rows and columns as the block;
+ *     error,     a pointer to the error message.
  *
  * Results:
- *     The memory used by the arguments is Gua_Freed.
+ *     The function returns GUA_OK if the block was written, GUA_ERROR
+ *     otherwise.
  */
-void Gua_FreeArguments(Gua_Short argc, Gua_Object *argv)
+Gua_Status Gua_SetMatrixSlice(Gua_Object *matrix, Gua_Length *first, Gua_Length *last, Gua_Object *object, Gua_String error)
 {
-    Gua_Short i;
+    Gua_Matrix *m;
+    Gua_Matrix *b;
+    Gua_Object *target;
+    Gua_Object *source;
+    Gua_Object cell;
+    Gua_Length columns;
+    Gua_Length rows;
+    Gua_Length cols;
+    Gua_Length i;
+    Gua_Length j;
+    Gua_String errMessage;
     
-    for (i = 0; i < argc; i++) {
-        if (!Gua_IsObjectStored(argv[i])) {
-            Gua_FreeObject(&argv[i]);
+    m = (Gua_Matrix *)Gua_PObjectToMatrix(matrix);
+    target = (Gua_Object *)m->object;
+    columns = m->dimc == 2 ? m->dimv[1] : m->dimv[0];
+    
+    rows = last[0] - first[0];
+    cols = last[1] - first[1];
+    
+    if (Gua_PObjectType(object) == OBJECT_TYPE_MATRIX) {
+        b = (Gua_Matrix *)Gua_PObjectToMatrix(object);
+        
+        if ((b == NULL) || (b->dimc > 2) || ((b->dimc == 2) && ((b->dimv[0] != rows) || (b->dimv[1] != cols))) || ((b->dimc == 1) && ((rows != 1) || (b->dimv[0] != cols)))) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "the matrix does not fit the slice");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        source = (Gua_Object *)b->object;
+        
+        for (i = 0; i < rows; i++) {
+            for (j = 0; j < cols; j++) {
+                Gua_LinkObjects(cell, source[i * cols + j]);
+                Gua_SetStoredObject(cell);
+                
+                Gua_StoreMatrixElement(&target[(first[0] + i) * columns + first[1] + j], &cell);
+            }
+        }
+    } else if ((Gua_PObjectType(object) == OBJECT_TYPE_ARRAY) || (Gua_PObjectType(object) == OBJECT_TYPE_UNKNOWN)) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", Gua_StatusTable[GUA_ERROR_ILLEGAL_ASSIGNMENT]);
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    } else {
+        for (i = 0; i < rows; i++) {
+            for (j = 0; j < cols; j++) {
+                Gua_StoreMatrixElement(&target[(first[0] + i) * columns + first[1] + j], object);
+            }
         }
     }
     
-    Gua_Free(argv);
+    return GUA_OK;
 }
 
 /**
@@ -7411,6 +9565,11 @@ Gua_String Gua_ParseObject(Gua_Namespace *nspace, Gua_String start, Gua_Token *t
     Gua_Function function;
     Gua_Short argc;
     Gua_Object *argv;
+    Gua_Arguments arguments;
+    Gua_Integer offset;
+    Gua_Object *element;
+    Gua_Length first[2];
+    Gua_Length last[2];
     Gua_Object argObject;
     Gua_Object strObject;
     Gua_String errMessage;
@@ -7478,17 +9637,13 @@ Gua_String Gua_ParseObject(Gua_Namespace *nspace, Gua_String start, Gua_Token *t
             memset(expression, '\0', sizeof(char) * (token->length + 1));
             strncpy(expression, token->start, token->length);
             
-            argc = Gua_CountMatrixElements(expression);
-            argc += 3;
-            argv = (Gua_Object *)Gua_Alloc(sizeof(Gua_Object) * argc);
+            Gua_InitArguments(arguments, 1);
             
-            Gua_ClearArguments(argc, argv);
+            Gua_LinkStringToObject(arguments.argv[0], "matrix2D");
+            Gua_SetStoredObject(arguments.argv[0]);
             
-            Gua_LinkStringToObject(argv[0], "matrix2D");
-            Gua_SetStoredObject(argv[0]);
-            
-            if (Gua_ParseMatrixElements(nspace, expression, argc, argv, status, error) == GUA_OK) {
-                if (Gua_BuiltInFunction(nspace, argc, argv, object, error) != GUA_OK) {
+            if (Gua_ScanMatrixElements(nspace, expression, &arguments, status, error) == GUA_OK) {
+                if (Gua_BuiltInFunction(nspace, arguments.argc, arguments.argv, object, error) != GUA_OK) {
                     Gua_FreeObject(object);
                     *status = GUA_ERROR;
                 }
@@ -7496,7 +9651,7 @@ Gua_String Gua_ParseObject(Gua_Namespace *nspace, Gua_String start, Gua_Token *t
                 *status = GUA_ERROR;
             }
             
-            Gua_FreeArguments(argc, argv);
+            Gua_ReleaseArguments(&arguments);
             Gua_Free(expression);
         }
     /* Parse BRACES. */
@@ -7506,17 +9661,13 @@ Gua_String Gua_ParseObject(Gua_Namespace *nspace, Gua_String start, Gua_Token *t
             memset(expression, '\0', sizeof(char) * (token->length + 1));
             strncpy(expression, token->start, token->length);
             
-            argc = Gua_CountArguments(expression);
-            argc++;
-            argv = (Gua_Object *)Gua_Alloc(sizeof(Gua_Object) * argc);
+            Gua_InitArguments(arguments, 1);
             
-            Gua_ClearArguments(argc, argv);
+            Gua_LinkStringToObject(arguments.argv[0], "array");
+            Gua_SetStoredObject(arguments.argv[0]);
             
-            Gua_LinkStringToObject(argv[0], "array");
-            Gua_SetStoredObject(argv[0]);
-            
-            if (Gua_ParseArguments(nspace, expression, argc, argv, 1, status, error) == GUA_OK) {
-                if (Gua_BuiltInFunction(nspace, argc, argv, object, error) != GUA_OK) {
+            if (Gua_ScanArguments(nspace, expression, &arguments, status, error) == GUA_OK) {
+                if (Gua_BuiltInFunction(nspace, arguments.argc, arguments.argv, object, error) != GUA_OK) {
                     Gua_FreeObject(object);
                     *status = GUA_ERROR;
                 }
@@ -7524,7 +9675,7 @@ Gua_String Gua_ParseObject(Gua_Namespace *nspace, Gua_String start, Gua_Token *t
                 *status = GUA_ERROR;
             }
             
-            Gua_FreeArguments(argc, argv);
+            Gua_ReleaseArguments(&arguments);
             Gua_Free(expression);
         }
     /* Parse a VARIABLE. */
@@ -7570,18 +9721,16 @@ Gua_String Gua_ParseObject(Gua_Namespace *nspace, Gua_String start, Gua_Token *t
                     memset(expression, '\0', sizeof(char) * (token->length + 1));
                     strncpy(expression, token->start, token->length);
                     
-                    argc = Gua_CountArguments(expression);
-                    argc++;
-                    argv = (Gua_Object *)Gua_Alloc(sizeof(Gua_Object) * argc);
-                    
-                    Gua_ClearArguments(argc, argv);
+                    Gua_InitArguments(arguments, 1);
                     
-                    Gua_LinkFromPObject(argv[0], object);
+                    Gua_LinkFromPObject(arguments.argv[0], object);
                     
-                    if (Gua_ParseArguments(nspace, expression, argc, argv, 1, status, error) == GUA_OK) {
-                        if (argc > 2) {
-                            Gua_ArgsToString(argc, argv, &argObject);
-                        } else if (argc == 2) {
+                    if (Gua_ScanArguments(nspace, expression, &arguments, status, error) == GUA_OK) {
+                        argv = arguments.argv;
+                        
+                        if (arguments.argc > 2) {
+                            Gua_ArgsToString(arguments.argc, argv, &argObject);
+                        } else if (arguments.argc == 2) {
                             if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_STRING) {
                                 Gua_ByteArrayToObject(argObject, Gua_ObjectToString(argv[1]), Gua_ObjectLength(argv[1]));
                             } else {
@@ -7600,28 +9749,33 @@ Gua_String Gua_ParseObject(Gua_Namespace *nspace, Gua_String start, Gua_Token *t
                         }
                     }
                     
-                    Gua_FreeArguments(argc, argv);
+                    Gua_ReleaseArguments(&arguments);
                     Gua_FreeObject(&argObject);
                     Gua_Free(expression);
+                /* Parse a MATRIX element with simple indices, a[k] or a[i, j]. */
+                } else if (Gua_GetMatrixOffset(nspace, token->start, token->length, object, &offset) == GUA_OK) {
+                    element = (Gua_Object *)((Gua_Matrix *)Gua_PObjectToMatrix(object))->object + offset;
+                    Gua_LinkPObjects(object, element);
+                /* Parse a MATRIX slice, a[r0:r1, c0:c1]. */
+                } else if ((Gua_PObjectType(object) == OBJECT_TYPE_MATRIX) && Gua_IsSliceToken(token)) {
+                    if (Gua_ScanSlice(nspace, token->start, token->length, object, first, last, status, error) == GUA_OK) {
+                        Gua_GetMatrixSlice(object, first, last, object);
+                    }
                 /* Parse a MATRIX. */
                 } else if (Gua_PObjectType(object) == OBJECT_TYPE_MATRIX) {
                     expression = (char *)Gua_Alloc(sizeof(char) * (token->length + 1));
                     memset(expression, '\0', sizeof(char) * (token->length + 1));
                     strncpy(expression, token->start, token->length);
                     
-                    argc = Gua_CountArguments(expression);
-                    argc += 2;
-                    argv = (Gua_Object *)Gua_Alloc(sizeof(Gua_Object) * argc);
-                    
-                    Gua_ClearArguments(argc, argv);
+                    Gua_InitArguments(arguments, 2);
                     
-                    Gua_LinkStringToObject(argv[0], "getMatrixElement");
-                    Gua_SetStoredObject(argv[0]);
+                    Gua_LinkStringToObject(arguments.argv[0], "getMatrixElement");
+                    Gua_SetStoredObject(arguments.argv[0]);
                     
-                    Gua_LinkFromPObject(argv[1], object);
+                    Gua_LinkFromPObject(arguments.argv[1], object);
                     
-                    if (Gua_ParseArguments(nspace, expression, argc, argv, 2, status, error) == GUA_OK) {
-                        if (Gua_BuiltInFunction(nspace, argc, argv, object, error) != GUA_OK) {
+                    if (Gua_ScanArguments(nspace, expression, &arguments, status, error) == GUA_OK) {
+                        if (Gua_BuiltInFunction(nspace, arguments.argc, arguments.argv, object, error) != GUA_OK) {
                             *status = GUA_ERROR;
                             
                             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
@@ -7631,7 +9785,7 @@ Gua_String Gua_ParseObject(Gua_Namespace *nspace, Gua_String start, Gua_Token *t
                         }
                     }
                     
-                    Gua_FreeArguments(argc, argv);
+                    Gua_ReleaseArguments(&arguments);
                     Gua_Free(expression);
                 /* Parse a STRING. */
                 } else if (Gua_PObjectType(object) == OBJECT_TYPE_STRING) {
@@ -7708,17 +9862,18 @@ Gua_String Gua_ParseObject(Gua_Namespace *nspace, Gua_String start, Gua_Token *t
                 memset(expression, '\0', sizeof(char) * (token->length + 1));
                 strncpy(expression, token->start, token->length);
                 
-                argc = Gua_CountArguments(expression);
-                argc++;
-                argv = (Gua_Object *)Gua_Alloc(sizeof(Gua_Object) * argc);
+                Gua_InitArguments(arguments, 1);
                 
-                Gua_ClearArguments(argc, argv);
+                Gua_LinkStringToObject(arguments.argv[0], name);
                 
-                Gua_LinkStringToObject(argv[0], name);
+                /* Functions that read matrix views take slices without copying them. */
+                if ((memchr(expression, COLON, token->length) != NULL) && (Gua_GetFunction(nspace, name, &function) == GUA_OK)) {
+                    arguments.views = function.type == FUNCTION_TYPE_C_VIEW;
+                }
                 
-                if (Gua_ParseArguments(nspace, expression, argc, argv, 1, status, error) == GUA_OK) {
+                if (Gua_ScanArguments(nspace, expression, &arguments, status, error) == GUA_OK) {
                     if (Gua_GetFunction(nspace, name, &function) == GUA_OK) {
-                        if ((*status = function.pointer(nspace, argc, argv, object, error)) != GUA_OK) {
+                        if ((*status = function.pointer(nspace, arguments.argc, arguments.argv, object, error)) != GUA_OK) {
                             if (!((*status == GUA_RETURN) || (*status == GUA_EXIT))) {
                                 if (!Gua_IsPObjectStored(object)) {
                                     Gua_FreeObject(object);
@@ -7736,18 +9891,15 @@ Gua_String Gua_ParseObject(Gua_Namespace *nspace, Gua_String start, Gua_Token *t
                 }
                 
                 Gua_Free(expression);
-                Gua_FreeArguments(argc, argv);
+                Gua_ReleaseArguments(&arguments);
             /* The FUNCTION has no arguments. */
             } else {
-                argc = 1;
-                argv = (Gua_Object *)Gua_Alloc(sizeof(Gua_Object) * argc);
+                Gua_InitArguments(arguments, 1);
                 
-                Gua_ClearArguments(argc, argv);
-                
-                Gua_LinkStringToObject(argv[0], name);
+                Gua_LinkStringToObject(arguments.argv[0], name);
                 
                 if (Gua_GetFunction(nspace, name, &function) == GUA_OK) {
-                    if ((*status = function.pointer(nspace, argc, argv, object, error)) != GUA_OK) {
+                    if ((*status = function.pointer(nspace, arguments.argc, arguments.argv, object, error)) != GUA_OK) {
                         if (!((*status == GUA_RETURN) || (*status == GUA_EXIT))) {
                             if (!Gua_IsPObjectStored(object)) {
                                 Gua_FreeObject(object);
@@ -7763,19 +9915,16 @@ Gua_String Gua_ParseObject(Gua_Namespace *nspace, Gua_String start, Gua_Token *t
                     Gua_Free(errMessage);
                 }
                 
-                Gua_FreeArguments(argc, argv);
+                Gua_ReleaseArguments(&arguments);
             }
         /* The FUNCTION has no arguments. */
         } else {
-            argc = 1;
-            argv = (Gua_Object *)Gua_Alloc(sizeof(Gua_Object) * argc);
-            
-            Gua_ClearArguments(argc, argv);
+            Gua_InitArguments(arguments, 1);
             
-            Gua_LinkStringToObject(argv[0], name);
+            Gua_LinkStringToObject(arguments.argv[0], name);
             
             if (Gua_GetFunction(nspace, name, &function) == GUA_OK) {
-                if ((*status = function.pointer(nspace, argc, argv, object, error)) != GUA_OK) {
+                if ((*status = function.pointer(nspace, arguments.argc, arguments.argv, object, error)) != GUA_OK) {
                     if (!((*status == GUA_RETURN) || (*status == GUA_EXIT))) {
                         if (!Gua_IsPObjectStored(object)) {
                             Gua_FreeObject(object);
@@ -7791,7 +9940,7 @@ Gua_String Gua_ParseObject(Gua_Namespace *nspace, Gua_String start, Gua_Token *t
                 Gua_Free(errMessage);
             }
             
-            Gua_FreeArguments(argc, argv);
+            Gua_ReleaseArguments(&arguments);
         }
     /* Parse a MACRO substitution. */
     } else if (token->type == TOKEN_TYPE_MACRO) {
@@ -13955,6 +16104,11 @@ Gua_String Gua_ParseAssignVariable(Gua_Namespace *nspace, Gua_String start, Gua_
     Gua_Object argObject;
     Gua_Object variableObject;
     Gua_Short objectType;
+    Gua_String index;
+    Gua_Length indexLength;
+    Gua_Integer offset;
+    Gua_Length first[2];
+    Gua_Length last[2];
     Gua_String errMessage;
     
     p = start;
@@ -14142,6 +16296,113 @@ Gua_String Gua_ParseAssignVariable(Gua_Namespace *nspace, Gua_String start, Gua_
                     Gua_Free(expression);
                     Gua_FreeArguments(argc, argv);
                     Gua_FreeObject(&argObject);
+                /* The VARIABLE is a MATRIX and the indices are simple, a[k] = x or a[i, j] = x. */
+                } else if ((objectType == OBJECT_TYPE_MATRIX) && (Gua_GetMatrixOffset(nspace, token->start, token->length, &variableObject, &offset) == GUA_OK)) {
+                    index = token->start;
+                    indexLength = token->length;
+                    
+                    p = Gua_NextToken(nspace, p, token);
+                    
+                    if (token->status != GUA_OK) {
+                        *status = token->status;
+                        
+                        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                        sprintf(errMessage, "%s...\n", Gua_StatusTable[token->status]);
+                        strcat(error, errMessage);
+                        Gua_Free(errMessage);
+                        
+                        Gua_Free(name);
+                        
+                        return p;
+                    }
+                    
+                    if (token->type == TOKEN_TYPE_ASSIGN) {
+                        p = Gua_NextToken(nspace, p, token);
+                        
+                        p = Gua_ParseAssign(nspace, p, token, object, status, error);
+                        
+                        if (*status != GUA_OK) {
+                            Gua_Free(name);
+                            return p;
+                        }
+                        
+                        if (Gua_PObjectType(object) == OBJECT_TYPE_UNKNOWN) {
+                            *status = GUA_ERROR;
+                            
+                            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                            sprintf(errMessage, "%s %-.20s...\n", "can't unset matrix", name);
+                            strcat(error, errMessage);
+                            Gua_Free(errMessage);
+                        } else if ((Gua_PObjectType(object) == OBJECT_TYPE_ARRAY) || (Gua_PObjectType(object) == OBJECT_TYPE_MATRIX)) {
+                            *status = GUA_ERROR;
+                            
+                            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                            sprintf(errMessage, "%s %-.20s...\n", Gua_StatusTable[GUA_ERROR_ILLEGAL_ASSIGNMENT], name);
+                            strcat(error, errMessage);
+                            Gua_Free(errMessage);
+                        /* The right side may have changed the matrix or its indices. */
+                        } else if ((Gua_GetVariable(nspace, name, &variableObject, SCOPE_LOCAL) == OBJECT_TYPE_MATRIX) && (Gua_GetMatrixOffset(nspace, index, indexLength, &variableObject, &offset) == GUA_OK)) {
+                            Gua_StoreMatrixElement((Gua_Object *)((Gua_Matrix *)Gua_ObjectToMatrix(variableObject))->object + offset, object);
+                            Gua_SetStoredPObject(object);
+                        } else {
+                            *status = GUA_ERROR;
+                            
+                            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                            sprintf(errMessage, "%s %-.20s...\n", "index out of bound", name);
+                            strcat(error, errMessage);
+                            Gua_Free(errMessage);
+                        }
+                    } else {
+                        *token = firstToken;
+                        p = Gua_ParseLogicOr(nspace, start, token, object, status, error);
+                    }
+                /* The VARIABLE is a MATRIX and the index is a slice, a[r0:r1, c0:c1] = x. */
+                } else if ((objectType == OBJECT_TYPE_MATRIX) && Gua_IsSliceToken(token)) {
+                    index = token->start;
+                    indexLength = token->length;
+                    
+                    p = Gua_NextToken(nspace, p, token);
+                    
+                    if (token->status != GUA_OK) {
+                        *status = token->status;
+                        
+                        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                        sprintf(errMessage, "%s...\n", Gua_StatusTable[token->status]);
+                        strcat(error, errMessage);
+                        Gua_Free(errMessage);
+                        
+                        Gua_Free(name);
+                        
+                        return p;
+                    }
+                    
+                    if (token->type == TOKEN_TYPE_ASSIGN) {
+                        p = Gua_NextToken(nspace, p, token);
+                        
+                        p = Gua_ParseAssign(nspace, p, token, object, status, error);
+                        
+                        if (*status != GUA_OK) {
+                            Gua_Free(name);
+                            return p;
+                        }
+                        
+                        /* The right side may have changed the matrix, so the slice is evaluated now. */
+                        if (Gua_GetVariable(nspace, name, &variableObject, SCOPE_LOCAL) != OBJECT_TYPE_MATRIX) {
+                            *status = GUA_ERROR;
+                            
+                            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                            sprintf(errMessage, "%s %-.20s...\n", "can't set matrix", name);
+                            strcat(error, errMessage);
+                            Gua_Free(errMessage);
+                        } else if (Gua_ScanSlice(nspace, index, indexLength, &variableObject, first, last, status, error) == GUA_OK) {
+                            if (Gua_SetMatrixSlice(&variableObject, first, last, object, error) != GUA_OK) {
+                                *status = GUA_ERROR;
+                            }
+                        }
+                    } else {
+                        *token = firstToken;
+                        p = Gua_ParseLogicOr(nspace, start, token, object, status, error);
+                    }
                 /* The VARIABLE is a MATRIX.*/
                 } else if (objectType == OBJECT_TYPE_MATRIX) {
                     expression = (char *)Gua_Alloc(sizeof(char) * (token->length + 1));
@@ -14445,10 +16706,52 @@ Gua_String Gua_ParseAssign(Gua_Namespace *nspace, Gua_String start, Gua_Token *t
             return p;
         }
         
-        p = Gua_ParseLogicOr(nspace, start, token, object, status, error);
+        p = Gua_ParseLogicOr(nspace, start, token, object, status, error);
+    }
+    
+    return p;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Gua_EvalFunction(void *nspace, Gua_Short argc, Gua_Object *argv, Gua_Object *object, Gua_String error)
+ *
+ * Description:
+ *     Evaluate a scripted function.
+ *
+ * Arguments:
+ *     nspace,    a pointer to a structure Gua_Namespace. Must do a cast before use it;
+ *     argc,      the number of arguments to pass to the function;
+ *     argv,      an array containing the arguments to the function, where
+ *                argv[0] is the function name;
+ *     object,    a structure containing the return object of the function;
+ *     error,     a pointer to the error message.
+ *
+ * Results:
+ *     The function returns the return object of the scripted funcion.
+ */
+Gua_Status Gua_EvalFunction(void *nspace, Gua_Short argc, Gua_Object *argv, Gua_Object *object, Gua_String error)
+{
+    Gua_Function function;
+    Gua_String errMessage;
+    
+    Gua_LinkStringToPObject(object, "");
+    Gua_SetStoredPObject(object);
+    
+    /* Get the function arguments. */
+    if (Gua_GetFunction(nspace, Gua_ObjectToString(argv[0]), &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "unknown function", Gua_ObjectToString(argv[0]));
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
     }
     
-    return p;
+    return Gua_CallFunction(nspace, &function, argc, argv, object, error);
 }
 
 /**
@@ -14456,47 +16759,43 @@ Gua_String Gua_ParseAssign(Gua_Namespace *nspace, Gua_String start, Gua_Token *t
  *     C
  *
  * Function:
- *     Gua_Status Gua_EvalFunction(void *nspace, Gua_Short argc, Gua_Object *argv, Gua_Object *object, Gua_String error)
+ *     Gua_Status Gua_CallFunction(void *nspace, Gua_Function *function, Gua_Short argc, Gua_Object *argv, Gua_Object *object, Gua_String error)
  *
  * Description:
- *     Evaluate a scripted function.
+ *     Call a function already found with Gua_GetFunction, without
+ *     searching for its name again. C code that calls the same function
+ *     many times should keep the function structure and use this call.
  *
  * Arguments:
- *     nspace,    a pointer to a structure Gua_Namespace. Must do a cast before use it;
- *     argc,      the number of arguments to pass to the function;
- *     argv,      an array containing the arguments to the function, where
- *                argv[0] is the function name;
- *     object,    a structure containing the return object of the function;
- *     error,     a pointer to the error message.
+ *     nspace,      a pointer to a structure Gua_Namespace. Must do a cast before use it;
+ *     function,    the function to call;
+ *     argc,        the number of arguments to pass to the function;
+ *     argv,        an array containing the arguments to the function, where
+ *                  argv[0] is the function name;
+ *     object,      a structure containing the return object of the function;
+ *     error,       a pointer to the error message.
  *
  * Results:
- *     The function returns the return object of the scripted funcion.
+ *     The function returns the return object of the called funcion.
  */
-Gua_Status Gua_EvalFunction(void *nspace, Gua_Short argc, Gua_Object *argv, Gua_Object *object, Gua_String error)
+Gua_Status Gua_CallFunction(void *nspace, Gua_Function *function, Gua_Short argc, Gua_Object *argv, Gua_Object *object, Gua_String error)
 {
     Gua_Namespace *previous;
     Gua_Namespace *local;
-    Gua_Function function;
     Gua_Argument *args;
     Gua_Status status;
     Gua_Short i;
     Gua_Short j;
     Gua_String errMessage;
     
+    if (function->type != FUNCTION_TYPE_SCRIPT) {
+        return function->pointer(nspace, argc, argv, object, error);
+    }
+    
     Gua_LinkStringToPObject(object, "");
     Gua_SetStoredPObject(object);
     
-    /* Get the function arguments. */
-    if (Gua_GetFunction(nspace, Gua_ObjectToString(argv[0]), &function) != GUA_OK) {
-        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-        sprintf(errMessage, "%s %-.20s...\n", "unknown function", Gua_ObjectToString(argv[0]));
-        strcat(error, errMessage);
-        Gua_Free(errMessage);
-        
-        return GUA_ERROR;
-    }
-    
-    if ((argc - 1) > function.argc) {
+    if ((argc - 1) > function->argc) {
         errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
         sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
         strcat(error, errMessage);
@@ -14518,7 +16817,7 @@ Gua_Status Gua_EvalFunction(void *nspace, Gua_Short argc, Gua_Object *argv, Gua_
     
     if (argc > 0) {
         /* Set the local variables from the arguments. */
-        args = (Gua_Argument *)function.argv;
+        args = (Gua_Argument *)function->argv;
         for (i = 1; i < argc; i++) {
             if (Gua_SetVariable(local, Gua_ArgName(args[i - 1]), &argv[i], SCOPE_LOCAL) != GUA_OK) {
                 Gua_FreeNamespace(local);
@@ -14532,8 +16831,8 @@ Gua_Status Gua_EvalFunction(void *nspace, Gua_Short argc, Gua_Object *argv, Gua_
                 return GUA_ERROR;
             }
         }
-        if ((i - 1) < function.argc) {
-            for (j = i - 1; j < function.argc; j++) {
+        if ((i - 1) < function->argc) {
+            for (j = i - 1; j < function->argc; j++) {
                 if (Gua_ObjectType(Gua_ArgObject(args[j])) != OBJECT_TYPE_UNKNOWN) {
                     if (Gua_SetVariable(local, Gua_ArgName(args[j]), &(Gua_ArgObject(args[j])), SCOPE_LOCAL) != GUA_OK) {
                         Gua_FreeNamespace(local);
@@ -14562,7 +16861,7 @@ Gua_Status Gua_EvalFunction(void *nspace, Gua_Short argc, Gua_Object *argv, Gua_
     }
     
     /* Now run the script. */
-    Gua_Evaluate(local, function.script, object, &status, error);
+    Gua_Evaluate(local, function->script, object, &status, error);
     
     Gua_FreeNamespace(local);
     previous->next = NULL;
@@ -17515,6 +19814,402 @@ Gua_String Gua_Evaluate(Gua_Namespace *nspace, Gua_String start, Gua_Object *obj
     return p;
 }
 
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Gua_FreeCodeEntry(Gua_CodeEntry *entry)
+ *
+ * Description:
+ *     Remove an entry from the code cache and free it.
+ *
+ * Arguments:
+ *     entry,    the cache entry to free.
+ *
+ * Results:
+ *     The entry is unlinked from the cache and its memory is released.
+ */
+void Gua_FreeCodeEntry(Gua_CodeEntry *entry)
+{
+    Gua_CodeEntry *p;
+    Gua_CodeToken *code;
+    Gua_Integer slot;
+    Gua_Integer i;
+    
+    slot = entry->hash % GUA_CODE_CACHE_HASH_SIZE;
+    
+    if (Gua_CodeCacheTable[slot] == entry) {
+        Gua_CodeCacheTable[slot] = (Gua_CodeEntry *)entry->chain;
+    } else {
+        p = Gua_CodeCacheTable[slot];
+        while ((Gua_CodeEntry *)p->chain != entry) {
+            p = (Gua_CodeEntry *)p->chain;
+        }
+        p->chain = entry->chain;
+    }
+    
+    if (entry->previous != NULL) {
+        ((Gua_CodeEntry *)entry->previous)->next = entry->next;
+    } else {
+        Gua_CodeCacheFirst = (Gua_CodeEntry *)entry->next;
+    }
+    if (entry->next != NULL) {
+        ((Gua_CodeEntry *)entry->next)->previous = entry->previous;
+    } else {
+        Gua_CodeCacheLast = (Gua_CodeEntry *)entry->previous;
+    }
+    
+    code = (Gua_CodeToken *)entry->token;
+    
+    for (i = 0; i < entry->tokenc; i++) {
+        if (code[i].name != NULL) {
+            Gua_Free(code[i].name);
+        }
+    }
+    
+    if (entry->token != NULL) {
+        Gua_Free(entry->token);
+    }
+    
+    Gua_Free(entry->index);
+    Gua_Free(entry->code);
+    Gua_Free(entry);
+    
+    Gua_CodeCacheEntries--;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Gua_TrimCodeCache(Gua_Integer size)
+ *
+ * Description:
+ *     Free the least recently used entries of the code cache, until it
+ *     holds at most size entries. Entries in use are never freed.
+ *
+ * Arguments:
+ *     size,    the maximum number of entries to keep.
+ *
+ * Results:
+ *     The least recently used entries are freed.
+ */
+void Gua_TrimCodeCache(Gua_Integer size)
+{
+    Gua_CodeEntry *entry;
+    Gua_CodeEntry *previous;
+    
+    entry = Gua_CodeCacheLast;
+    
+    while ((entry != NULL) && (Gua_CodeCacheEntries > size)) {
+        previous = (Gua_CodeEntry *)entry->previous;
+        if (entry->references == 0) {
+            Gua_FreeCodeEntry(entry);
+        }
+        entry = previous;
+    }
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Gua_SetCodeCacheSize(Gua_Integer size)
+ *
+ * Description:
+ *     Set the maximum number of entries in the code cache.
+ *     A size of zero disables the cache.
+ *
+ * Arguments:
+ *     size,    the maximum number of entries.
+ *
+ * Results:
+ *     The cache size is changed and the exceeding entries are freed.
+ */
+void Gua_SetCodeCacheSize(Gua_Integer size)
+{
+    if (size < 0) {
+        size = 0;
+    }
+    
+    Gua_CodeCacheSize = size;
+    
+    Gua_TrimCodeCache(size);
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Integer Gua_GetCodeCacheSize(void)
+ *
+ * Description:
+ *     Get the maximum number of entries in the code cache.
+ *
+ * Arguments:
+ *     None.
+ *
+ * Results:
+ *     The function returns the cache size.
+ */
+Gua_Integer Gua_GetCodeCacheSize(void)
+{
+    return Gua_CodeCacheSize;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Gua_GetCodeCacheStats(Gua_Integer *entries, Gua_Integer *hits, Gua_Integer *misses)
+ *
+ * Description:
+ *     Get the code cache usage statistics.
+ *
+ * Arguments:
+ *     entries,    the number of entries in the cache;
+ *     hits,       the number of evaluations that found its code in the cache;
+ *     misses,     the number of evaluations that did not.
+ *
+ * Results:
+ *     The statistics are stored in the arguments.
+ */
+void Gua_GetCodeCacheStats(Gua_Integer *entries, Gua_Integer *hits, Gua_Integer *misses)
+{
+    *entries = Gua_CodeCacheEntries;
+    *hits = Gua_CodeCacheHits;
+    *misses = Gua_CodeCacheMisses;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Gua_ClearCodeCache(void)
+ *
+ * Description:
+ *     Free all entries not in use and reset the code cache statistics.
+ *
+ * Arguments:
+ *     None.
+ *
+ * Results:
+ *     The code cache is cleared.
+ */
+void Gua_ClearCodeCache(void)
+{
+    Gua_TrimCodeCache(0);
+    
+    Gua_CodeCacheHits = 0;
+    Gua_CodeCacheMisses = 0;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_CodeEntry *Gua_AcquireCode(Gua_String start)
+ *
+ * Description:
+ *     Search the code cache for an expression, creating a new entry if it is not found.
+ *     The entry found is marked as the most recently used and as in use.
+ *
+ * Arguments:
+ *     start,    a pointer to the start point of the expression.
+ *
+ * Results:
+ *     The function returns the cache entry, or NULL if the expression
+ *     can not be cached.
+ */
+Gua_CodeEntry *Gua_AcquireCode(Gua_String start)
+{
+    Gua_CodeEntry *entry;
+    Gua_Length length;
+    unsigned long hash;
+    Gua_Integer slot;
+    Gua_String p;
+    
+    if (Gua_CodeCacheSize <= 0) {
+        return NULL;
+    }
+    
+    /* FNV-1a hash. */
+    hash = 2166136261UL;
+    
+    for (p = start; *p; p++) {
+        hash = (hash ^ (unsigned char)*p) * 16777619UL;
+    }
+    
+    length = (Gua_Length)(p - start);
+    
+    if (length > GUA_CODE_CACHE_MAX_LENGTH) {
+        return NULL;
+    }
+    
+    slot = hash % GUA_CODE_CACHE_HASH_SIZE;
+    
+    for (entry = Gua_CodeCacheTable[slot]; entry != NULL; entry = (Gua_CodeEntry *)entry->chain) {
+        if ((entry->hash == hash) && (entry->length == length) && (memcmp(entry->code, start, length) == 0)) {
+            break;
+        }
+    }
+    
+    if (entry != NULL) {
+        Gua_CodeCacheHits++;
+        
+        if (entry != Gua_CodeCacheFirst) {
+            ((Gua_CodeEntry *)entry->previous)->next = entry->next;
+            if (entry->next != NULL) {
+                ((Gua_CodeEntry *)entry->next)->previous = entry->previous;
+            } else {
+                Gua_CodeCacheLast = (Gua_CodeEntry *)entry->previous;
+            }
+            entry->previous = NULL;
+            entry->next = (struct Gua_CodeEntry *)Gua_CodeCacheFirst;
+            Gua_CodeCacheFirst->previous = (struct Gua_CodeEntry *)entry;
+            Gua_CodeCacheFirst = entry;
+        }
+        
+        entry->references++;
+        
+        return entry;
+    }
+    
+    Gua_CodeCacheMisses++;
+    
+    if (Gua_CodeCacheEntries >= Gua_CodeCacheSize) {
+        Gua_TrimCodeCache(Gua_CodeCacheSize - 1);
+        
+        /* All entries are in use. */
+        if (Gua_CodeCacheEntries >= Gua_CodeCacheSize) {
+            return NULL;
+        }
+    }
+    
+    entry = (Gua_CodeEntry *)Gua_Alloc(sizeof(Gua_CodeEntry));
+    
+    entry->hash = hash;
+    entry->length = length;
+    entry->code = (char *)Gua_Alloc(sizeof(char) * (length + 1));
+    memcpy(entry->code, start, length + 1);
+    entry->index = (Gua_Integer *)calloc(length + 1, sizeof(Gua_Integer));
+    entry->token = NULL;
+    entry->tokenc = 0;
+    entry->size = 0;
+    entry->references = 1;
+    
+    entry->chain = (struct Gua_CodeEntry *)Gua_CodeCacheTable[slot];
+    Gua_CodeCacheTable[slot] = entry;
+    
+    entry->previous = NULL;
+    entry->next = (struct Gua_CodeEntry *)Gua_CodeCacheFirst;
+    if (Gua_CodeCacheFirst != NULL) {
+        Gua_CodeCacheFirst->previous = (struct Gua_CodeEntry *)entry;
+    } else {
+        Gua_CodeCacheLast = entry;
+    }
+    Gua_CodeCacheFirst = entry;
+    
+    Gua_CodeCacheEntries++;
+    
+    return entry;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_String Gua_CachedExpression(Gua_Namespace *nspace, Gua_String start, Gua_Object *object, Gua_Status *status, Gua_String error)
+ *
+ * Description:
+ *     Same as Gua_Expression, but the tokens of the expression are kept
+ *     in the code cache, so an expression evaluated many times is scanned only once.
+ *
+ * Arguments:
+ *     nspace,    a pointer to a structure containing the variable and function namespace;
+ *     start,     a pointer to the start point of the expression to parse;
+ *     object,    a structure containing the return object of the expression;
+ *     status,    the status of the parser;
+ *     error,     a pointer to the error message.
+ *
+ * Results:
+ *     The function returns the next start point to parse in the expression.
+ */
+Gua_String Gua_CachedExpression(Gua_Namespace *nspace, Gua_String start, Gua_Object *object, Gua_Status *status, Gua_String error)
+{
+    Gua_CodeEntry *entry;
+    Gua_CodeEntry *active;
+    Gua_String p;
+    
+    entry = Gua_AcquireCode(start);
+    
+    if (entry == NULL) {
+        return Gua_Expression(nspace, start, object, status, error);
+    }
+    
+    active = Gua_ActiveCode;
+    Gua_ActiveCode = entry;
+    
+    p = Gua_Expression(nspace, entry->code, object, status, error);
+    
+    Gua_ActiveCode = active;
+    entry->references--;
+    
+    return start + (p - entry->code);
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_String Gua_CachedEvaluate(Gua_Namespace *nspace, Gua_String start, Gua_Object *object, Gua_Status *status, Gua_String error)
+ *
+ * Description:
+ *     Same as Gua_Evaluate, but the tokens of the script are kept
+ *     in the code cache, so a script evaluated many times is scanned only once.
+ *
+ * Arguments:
+ *     nspace,    a pointer to a structure containing the variable and function namespace;
+ *     start,     a pointer to the start point of the script to parse;
+ *     object,    a structure containing the return object of the script;
+ *     status,    the status of the parser;
+ *     error,     a pointer to the error message.
+ *
+ * Results:
+ *     The function returns the next start point to parse in the script.
+ */
+Gua_String Gua_CachedEvaluate(Gua_Namespace *nspace, Gua_String start, Gua_Object *object, Gua_Status *status, Gua_String error)
+{
+    Gua_CodeEntry *entry;
+    Gua_CodeEntry *active;
+    Gua_String p;
+    
+    entry = Gua_AcquireCode(start);
+    
+    if (entry == NULL) {
+        return Gua_Evaluate(nspace, start, object, status, error);
+    }
+    
+    active = Gua_ActiveCode;
+    Gua_ActiveCode = entry;
+    
+    p = Gua_Evaluate(nspace, entry->code, object, status, error);
+    
+    Gua_ActiveCode = active;
+    entry->references--;
+    
+    return start + (p - entry->code);
+}
+
 /**
  * Group:
  *     C
@@ -17804,6 +20499,18 @@ Gua_Status Gua_Init(Gua_Namespace *nspace, int argc, char *argv[], char **env, G
         strcat(error, errMessage);
         Gua_Free(errMessage);
     }
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "evalCacheSize", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "evalCacheSize");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "evalCacheStats", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "evalCacheStats");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
     if (Gua_SetFunction((Gua_Namespace *)nspace, "exists", &function) != GUA_OK) {
         errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
         sprintf(errMessage, "%s %-.20s...\n", "can't set function", "exists");
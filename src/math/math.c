@@ -34,6 +34,783 @@
 #include "interp.h"
 #include "math.h"
 
+/* Ziggurat tables for the normal and the exponential distributions, built by Math_Init. */
+static uint32_t Math_NormalK[MATH_ZIGGURAT_NORMAL_LAYERS];
+static Gua_Real Math_NormalW[MATH_ZIGGURAT_NORMAL_LAYERS];
+static Gua_Real Math_NormalF[MATH_ZIGGURAT_NORMAL_LAYERS];
+static uint32_t Math_ExponentialK[MATH_ZIGGURAT_EXPONENTIAL_LAYERS];
+static Gua_Real Math_ExponentialW[MATH_ZIGGURAT_EXPONENTIAL_LAYERS];
+static Gua_Real Math_ExponentialF[MATH_ZIGGURAT_EXPONENTIAL_LAYERS];
+
+/* Every thread has its own generator, on its own stream. */
+static MATH_THREAD_LOCAL Math_RandomState Math_RandomGenerator;
+static MATH_THREAD_LOCAL Gua_Short Math_RandomSeeded = false;
+static Gua_Integer Math_RandomStreams = 0;
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     uint64_t Math_NextRandom(Math_RandomState *state)
+ *
+ * Description:
+ *     Generate the next 64 bits of a xoshiro256** generator.
+ *
+ * Arguments:
+ *     state,    the generator state.
+ *
+ * Results:
+ *     The function returns a 64 bits random number.
+ */
+uint64_t Math_NextRandom(Math_RandomState *state)
+{
+    uint64_t *s;
+    uint64_t result;
+    uint64_t t;
+    
+    s = state->s;
+    
+    result = s[1] * 5;
+    result = ((result << 7) | (result >> 57)) * 9;
+    
+    t = s[1] << 17;
+    
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    
+    s[2] ^= t;
+    
+    s[3] = (s[3] << 45) | (s[3] >> 19);
+    
+    return result;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Math_JumpRandom(Math_RandomState *state)
+ *
+ * Description:
+ *     Advance a generator by 2^128 numbers. Jumping k times from the same
+ *     seed gives the k-th of 2^128 non-overlapping streams.
+ *
+ * Arguments:
+ *     state,    the generator state.
+ *
+ * Results:
+ *     The function changes the generator state.
+ */
+void Math_JumpRandom(Math_RandomState *state)
+{
+    static const uint64_t jump[] = { 0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL };
+    uint64_t s[4];
+    Gua_Short i;
+    Gua_Short b;
+    
+    s[0] = 0;
+    s[1] = 0;
+    s[2] = 0;
+    s[3] = 0;
+    
+    for (i = 0; i < 4; i++) {
+        for (b = 0; b < 64; b++) {
+            if (jump[i] & ((uint64_t)1 << b)) {
+                s[0] ^= state->s[0];
+                s[1] ^= state->s[1];
+                s[2] ^= state->s[2];
+                s[3] ^= state->s[3];
+            }
+            Math_NextRandom(state);
+        }
+    }
+    
+    state->s[0] = s[0];
+    state->s[1] = s[1];
+    state->s[2] = s[2];
+    state->s[3] = s[3];
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Math_SeedRandom(Math_RandomState *state, uint64_t seed, Gua_Integer stream)
+ *
+ * Description:
+ *     Seed a generator. The state is expanded from the seed with splitmix64
+ *     and then moved to the given stream.
+ *
+ * Arguments:
+ *     state,     the generator state;
+ *     seed,      the seed;
+ *     stream,    the stream number.
+ *
+ * Results:
+ *     The function initializes the generator state.
+ */
+void Math_SeedRandom(Math_RandomState *state, uint64_t seed, Gua_Integer stream)
+{
+    uint64_t z;
+    Gua_Short i;
+    
+    for (i = 0; i < 4; i++) {
+        seed = seed + 0x9e3779b97f4a7c15ULL;
+        z = seed;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        state->s[i] = z ^ (z >> 31);
+    }
+    
+    for (; stream > 0; stream--) {
+        Math_JumpRandom(state);
+    }
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Math_RandomState *Math_GetRandomState(void)
+ *
+ * Description:
+ *     Get the generator of the calling thread. A thread that never called
+ *     srandom gets the default seed on the next free stream, so parallel
+ *     workers never share numbers.
+ *
+ * Arguments:
+ *     None.
+ *
+ * Results:
+ *     The function returns the generator of the calling thread.
+ */
+Math_RandomState *Math_GetRandomState(void)
+{
+    if (!Math_RandomSeeded) {
+        Math_SeedRandom(&Math_RandomGenerator, MATH_RANDOM_SEED, MATH_FETCH_AND_INCREMENT(&Math_RandomStreams));
+        Math_RandomSeeded = true;
+    }
+    
+    return &Math_RandomGenerator;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Math_SetRandomSeed(uint64_t seed, Gua_Integer stream)
+ *
+ * Description:
+ *     Seed the generator of the calling thread.
+ *
+ * Arguments:
+ *     seed,      the seed;
+ *     stream,    the stream number.
+ *
+ * Results:
+ *     The function initializes the generator of the calling thread.
+ */
+void Math_SetRandomSeed(uint64_t seed, Gua_Integer stream)
+{
+    Math_SeedRandom(&Math_RandomGenerator, seed, stream);
+    Math_RandomSeeded = true;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Real Math_UniformRandom(Math_RandomState *state)
+ *
+ * Description:
+ *     Generate a uniform random number in [0, 1) with 53 random bits.
+ *
+ * Arguments:
+ *     state,    the generator state.
+ *
+ * Results:
+ *     The function returns a random number.
+ */
+Gua_Real Math_UniformRandom(Math_RandomState *state)
+{
+    return (Math_NextRandom(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Math_InitZiggurat(void)
+ *
+ * Description:
+ *     Build the ziggurat tables of Marsaglia and Tsang for the standard
+ *     normal and exponential distributions. Math_Init calls it once, before
+ *     any script runs, so the threads only ever read the tables.
+ *
+ * Arguments:
+ *     None.
+ *
+ * Results:
+ *     The function fills the ziggurat tables.
+ */
+void Math_InitZiggurat(void)
+{
+    Gua_Real m1 = 2147483648.0;
+    Gua_Real m2 = 4294967296.0;
+    Gua_Real dn = MATH_ZIGGURAT_NORMAL_R;
+    Gua_Real tn = dn;
+    Gua_Real vn = MATH_ZIGGURAT_NORMAL_V;
+    Gua_Real de = MATH_ZIGGURAT_EXPONENTIAL_R;
+    Gua_Real te = de;
+    Gua_Real ve = MATH_ZIGGURAT_EXPONENTIAL_V;
+    Gua_Real q;
+    Gua_Integer i;
+    
+    q = vn / exp(-0.5 * dn * dn);
+    Math_NormalK[0] = (uint32_t)((dn / q) * m1);
+    Math_NormalK[1] = 0;
+    Math_NormalW[0] = q / m1;
+    Math_NormalW[MATH_ZIGGURAT_NORMAL_LAYERS - 1] = dn / m1;
+    Math_NormalF[0] = 1.0;
+    Math_NormalF[MATH_ZIGGURAT_NORMAL_LAYERS - 1] = exp(-0.5 * dn * dn);
+    
+    for (i = MATH_ZIGGURAT_NORMAL_LAYERS - 2; i >= 1; i--) {
+        dn = sqrt(-2.0 * log(vn / dn + exp(-0.5 * dn * dn)));
+        Math_NormalK[i + 1] = (uint32_t)((dn / tn) * m1);
+        tn = dn;
+        Math_NormalF[i] = exp(-0.5 * dn * dn);
+        Math_NormalW[i] = dn / m1;
+    }
+    
+    q = ve / exp(-de);
+    Math_ExponentialK[0] = (uint32_t)((de / q) * m2);
+    Math_ExponentialK[1] = 0;
+    Math_ExponentialW[0] = q / m2;
+    Math_ExponentialW[MATH_ZIGGURAT_EXPONENTIAL_LAYERS - 1] = de / m2;
+    Math_ExponentialF[0] = 1.0;
+    Math_ExponentialF[MATH_ZIGGURAT_EXPONENTIAL_LAYERS - 1] = exp(-de);
+    
+    for (i = MATH_ZIGGURAT_EXPONENTIAL_LAYERS - 2; i >= 1; i--) {
+        de = -log(ve / de + exp(-de));
+        Math_ExponentialK[i + 1] = (uint32_t)((de / te) * m2);
+        te = de;
+        Math_ExponentialF[i] = exp(-de);
+        Math_ExponentialW[i] = de / m2;
+    }
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Real Math_NormalRandom(Math_RandomState *state)
+ *
+ * Description:
+ *     Generate a standard normal random number with the ziggurat method.
+ *     The layer and the value come from different bits of the same draw.
+ *
+ * Arguments:
+ *     state,    the generator state.
+ *
+ * Results:
+ *     The function returns a random number.
+ */
+Gua_Real Math_NormalRandom(Math_RandomState *state)
+{
+    uint64_t u;
+    int32_t hz;
+    Gua_Integer iz;
+    Gua_Real x;
+    Gua_Real y;
+    
+    for (;;) {
+        u = Math_NextRandom(state);
+        iz = u & (MATH_ZIGGURAT_NORMAL_LAYERS - 1);
+        hz = (int32_t)(u >> 32);
+        
+        if ((uint32_t)(hz < 0 ? -(int64_t)hz : hz) < Math_NormalK[iz]) {
+            return hz * Math_NormalW[iz];
+        }
+        
+        x = hz * Math_NormalW[iz];
+        
+        /* Sample the tail. */
+        if (iz == 0) {
+            do {
+                x = -log(1.0 - Math_UniformRandom(state)) / MATH_ZIGGURAT_NORMAL_R;
+                y = -log(1.0 - Math_UniformRandom(state));
+            } while (y + y < x * x);
+            
+            return hz > 0 ? MATH_ZIGGURAT_NORMAL_R + x : -MATH_ZIGGURAT_NORMAL_R - x;
+        }
+        
+        if (Math_NormalF[iz] + Math_UniformRandom(state) * (Math_NormalF[iz - 1] - Math_NormalF[iz]) < exp(-0.5 * x * x)) {
+            return x;
+        }
+    }
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Real Math_ExponentialRandom(Math_RandomState *state)
+ *
+ * Description:
+ *     Generate a standard exponential random number with the ziggurat method.
+ *
+ * Arguments:
+ *     state,    the generator state.
+ *
+ * Results:
+ *     The function returns a random number.
+ */
+Gua_Real Math_ExponentialRandom(Math_RandomState *state)
+{
+    uint64_t u;
+    uint32_t jz;
+    Gua_Integer iz;
+    Gua_Real x;
+    
+    for (;;) {
+        u = Math_NextRandom(state);
+        iz = u & (MATH_ZIGGURAT_EXPONENTIAL_LAYERS - 1);
+        jz = (uint32_t)(u >> 32);
+        
+        if (jz < Math_ExponentialK[iz]) {
+            return jz * Math_ExponentialW[iz];
+        }
+        
+        /* Sample the tail. */
+        if (iz == 0) {
+            return MATH_ZIGGURAT_EXPONENTIAL_R - log(1.0 - Math_UniformRandom(state));
+        }
+        
+        x = jz * Math_ExponentialW[iz];
+        
+        if (Math_ExponentialF[iz] + Math_UniformRandom(state) * (Math_ExponentialF[iz - 1] - Math_ExponentialF[iz]) < exp(-x)) {
+            return x;
+        }
+    }
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Short Math_ElementwiseFunction(Gua_String name)
+ *
+ * Description:
+ *     Find the code of a math function that can be applied element by element.
+ *
+ * Arguments:
+ *     name,      the function name.
+ *
+ * Results:
+ *     The function code, or MATH_FUNCTION_NONE.
+ */
+Gua_Short Math_ElementwiseFunction(Gua_String name)
+{
+    if (strcmp(name, "acos") == 0) {
+        return MATH_FUNCTION_ACOS;
+    } else if (strcmp(name, "asin") == 0) {
+        return MATH_FUNCTION_ASIN;
+    } else if (strcmp(name, "atan") == 0) {
+        return MATH_FUNCTION_ATAN;
+    } else if (strcmp(name, "atan2") == 0) {
+        return MATH_FUNCTION_ATAN2;
+    } else if (strcmp(name, "ceil") == 0) {
+        return MATH_FUNCTION_CEIL;
+    } else if (strcmp(name, "cos") == 0) {
+        return MATH_FUNCTION_COS;
+    } else if (strcmp(name, "cosh") == 0) {
+        return MATH_FUNCTION_COSH;
+    } else if (strcmp(name, "deg") == 0) {
+        return MATH_FUNCTION_DEG;
+    } else if (strcmp(name, "exp") == 0) {
+        return MATH_FUNCTION_EXP;
+    } else if (strcmp(name, "fabs") == 0) {
+        return MATH_FUNCTION_FABS;
+    } else if (strcmp(name, "floor") == 0) {
+        return MATH_FUNCTION_FLOOR;
+    } else if (strcmp(name, "fmax") == 0) {
+        return MATH_FUNCTION_FMAX;
+    } else if (strcmp(name, "fmin") == 0) {
+        return MATH_FUNCTION_FMIN;
+    } else if (strcmp(name, "fmod") == 0) {
+        return MATH_FUNCTION_FMOD;
+    } else if (strcmp(name, "log") == 0) {
+        return MATH_FUNCTION_LOG;
+    } else if (strcmp(name, "log10") == 0) {
+        return MATH_FUNCTION_LOG10;
+    } else if (strcmp(name, "pow") == 0) {
+        return MATH_FUNCTION_POW;
+    } else if (strcmp(name, "rad") == 0) {
+        return MATH_FUNCTION_RAD;
+    } else if (strcmp(name, "round") == 0) {
+        return MATH_FUNCTION_ROUND;
+    } else if (strcmp(name, "roundl") == 0) {
+        return MATH_FUNCTION_ROUNDL;
+    } else if (strcmp(name, "sin") == 0) {
+        return MATH_FUNCTION_SIN;
+    } else if (strcmp(name, "sinh") == 0) {
+        return MATH_FUNCTION_SINH;
+    } else if (strcmp(name, "sqrt") == 0) {
+        return MATH_FUNCTION_SQRT;
+    } else if (strcmp(name, "tan") == 0) {
+        return MATH_FUNCTION_TAN;
+    } else if (strcmp(name, "tanh") == 0) {
+        return MATH_FUNCTION_TANH;
+    }
+    
+    return MATH_FUNCTION_NONE;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Short Math_IsBinaryFunction(Gua_Short function)
+ *
+ * Description:
+ *     Check if an elementwise math function takes two arguments.
+ *
+ * Arguments:
+ *     function,  the function code.
+ *
+ * Results:
+ *     Returns true if the function takes two arguments.
+ */
+Gua_Short Math_IsBinaryFunction(Gua_Short function)
+{
+    return (function == MATH_FUNCTION_ATAN2) || (function == MATH_FUNCTION_FMAX) || (function == MATH_FUNCTION_FMIN) || (function == MATH_FUNCTION_FMOD) || (function == MATH_FUNCTION_POW);
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Math_ApplyRealBuffer(Gua_Short function, Gua_Real *x, Gua_Real *y, Gua_Real *r, Gua_Length n)
+ *
+ * Description:
+ *     Apply a math function to every element of a real buffer. Each function
+ *     has its own loop, so the compiler can unroll and vectorize it.
+ *
+ * Arguments:
+ *     function,  the function code;
+ *     x,         the first argument buffer;
+ *     y,         the second argument buffer, used only by binary functions;
+ *     r,         the result buffer;
+ *     n,         the number of elements.
+ *
+ * Results:
+ *     The function stores the results in r.
+ */
+void Math_ApplyRealBuffer(Gua_Short function, Gua_Real *x, Gua_Real *y, Gua_Real *r, Gua_Length n)
+{
+    Gua_Length i;
+    
+    switch (function) {
+        case MATH_FUNCTION_ACOS:
+            for (i = 0; i < n; i++) r[i] = acos(x[i]);
+            break;
+        case MATH_FUNCTION_ASIN:
+            for (i = 0; i < n; i++) r[i] = asin(x[i]);
+            break;
+        case MATH_FUNCTION_ATAN:
+            for (i = 0; i < n; i++) r[i] = atan(x[i]);
+            break;
+        case MATH_FUNCTION_ATAN2:
+            for (i = 0; i < n; i++) r[i] = atan2(x[i], y[i]);
+            break;
+        case MATH_FUNCTION_CEIL:
+            for (i = 0; i < n; i++) r[i] = ceil(x[i]);
+            break;
+        case MATH_FUNCTION_COS:
+            for (i = 0; i < n; i++) r[i] = cos(x[i]);
+            break;
+        case MATH_FUNCTION_COSH:
+            for (i = 0; i < n; i++) r[i] = cosh(x[i]);
+            break;
+        case MATH_FUNCTION_DEG:
+            for (i = 0; i < n; i++) r[i] = x[i] * 180.0 / MATH_PI;
+            break;
+        case MATH_FUNCTION_EXP:
+            for (i = 0; i < n; i++) r[i] = exp(x[i]);
+            break;
+        case MATH_FUNCTION_FABS:
+            for (i = 0; i < n; i++) r[i] = fabs(x[i]);
+            break;
+        case MATH_FUNCTION_FLOOR:
+            for (i = 0; i < n; i++) r[i] = floor(x[i]);
+            break;
+        case MATH_FUNCTION_FMAX:
+            for (i = 0; i < n; i++) r[i] = x[i] > y[i] ? x[i] : y[i];
+            break;
+        case MATH_FUNCTION_FMIN:
+            for (i = 0; i < n; i++) r[i] = x[i] < y[i] ? x[i] : y[i];
+            break;
+        case MATH_FUNCTION_FMOD:
+            for (i = 0; i < n; i++) r[i] = fmod(x[i], y[i]);
+            break;
+        case MATH_FUNCTION_LOG:
+            for (i = 0; i < n; i++) r[i] = log(x[i]);
+            break;
+        case MATH_FUNCTION_LOG10:
+            for (i = 0; i < n; i++) r[i] = log10(x[i]);
+            break;
+        case MATH_FUNCTION_POW:
+            for (i = 0; i < n; i++) r[i] = pow(x[i], y[i]);
+            break;
+        case MATH_FUNCTION_RAD:
+            for (i = 0; i < n; i++) r[i] = x[i] * MATH_PI / 180.0;
+            break;
+        case MATH_FUNCTION_ROUND:
+        case MATH_FUNCTION_ROUNDL:
+            for (i = 0; i < n; i++) r[i] = round(x[i]);
+            break;
+        case MATH_FUNCTION_SIN:
+            for (i = 0; i < n; i++) r[i] = sin(x[i]);
+            break;
+        case MATH_FUNCTION_SINH:
+            for (i = 0; i < n; i++) r[i] = sinh(x[i]);
+            break;
+        case MATH_FUNCTION_SQRT:
+            for (i = 0; i < n; i++) r[i] = sqrt(x[i]);
+            break;
+        case MATH_FUNCTION_TAN:
+            for (i = 0; i < n; i++) r[i] = tan(x[i]);
+            break;
+        case MATH_FUNCTION_TANH:
+            for (i = 0; i < n; i++) r[i] = tanh(x[i]);
+            break;
+    }
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Math_ApplyToMatrix(void *nspace, Gua_Short argc, Gua_Object *argv, Gua_Object *object, Gua_String error)
+ *
+ * Description:
+ *     Apply a math function to every element of its matrix arguments. The
+ *     arguments of a binary function may mix a matrix with a scalar, which is
+ *     used for every element. Integer and real elements are unpacked into
+ *     flat buffers and computed in one pass; any other element, and any
+ *     element whose scalar result would not be real, goes through the scalar
+ *     function, so each element gets exactly the scalar result.
+ *
+ * Arguments:
+ *     nspace,    a pointer to a structure Gua_Namespace. Must do a cast before use it;
+ *     argc,      the number of arguments to pass to the function;
+ *     argv,      an array containing the arguments to the function;
+ *                argv[0] is the function name;
+ *     object,    a structure containing the return value of the function;
+ *     error,     a pointer to the error message.
+ *
+ * Results:
+ *     A matrix with the same dimensions as the matrix arguments.
+ */
+Gua_Status Math_ApplyToMatrix(void *nspace, Gua_Short argc, Gua_Object *argv, Gua_Object *object, Gua_String error)
+{
+    Gua_Object element[3];
+    Gua_Object o;
+    Gua_Object *p;
+    Gua_Matrix *m;
+    Gua_Matrix *shape;
+    Gua_Object *source[3];
+    Gua_Object *target;
+    Gua_Real *buffer;
+    Gua_Real *x[3];
+    Gua_Real *r;
+    Gua_Length length;
+    Gua_Length i;
+    Gua_Short function;
+    Gua_Short fast;
+    Gua_Short real[3];
+    Gua_Short j;
+    Gua_String errMessage;
+    
+    function = Math_ElementwiseFunction(Gua_ObjectToString(argv[0]));
+    
+    if (argc != (Math_IsBinaryFunction(function) ? 3 : 2)) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    /* All the matrix arguments must have the same dimensions. */
+    shape = NULL;
+    
+    for (j = 1; j < argc; j++) {
+        if (Gua_ObjectType(argv[j]) != OBJECT_TYPE_MATRIX) {
+            continue;
+        }
+        
+        m = (Gua_Matrix *)Gua_ObjectToMatrix(argv[j]);
+        
+        if (m == NULL) {
+            continue;
+        } else if (shape == NULL) {
+            shape = m;
+        } else if ((m->dimc != shape->dimc) || (memcmp(m->dimv, shape->dimv, m->dimc * sizeof(Gua_Length)) != 0)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "the matrices must have the same dimensions for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+    }
+    
+    if (shape == NULL) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    length = 1;
+    
+    for (j = 0; j < shape->dimc; j++) {
+        length = length * shape->dimv[j];
+    }
+    
+    for (j = 1; j < argc; j++) {
+        if ((Gua_ObjectType(argv[j]) == OBJECT_TYPE_MATRIX) && (Gua_ObjectToMatrix(argv[j]) != NULL)) {
+            source[j] = (Gua_Object *)((Gua_Matrix *)Gua_ObjectToMatrix(argv[j]))->object;
+        } else {
+            source[j] = NULL;
+        }
+    }
+    
+    /*
+     * The fast path needs integer or real arguments whose results are real,
+     * as the scalar functions return them.
+     */
+    fast = true;
+    
+    for (j = 1; (j < argc) && fast; j++) {
+        real[j] = true;
+        
+        for (i = 0; i < (source[j] ? length : 1); i++) {
+            p = source[j] ? &(source[j][i]) : &(argv[j]);
+            
+            if (Gua_PObjectType(p) == OBJECT_TYPE_INTEGER) {
+                real[j] = false;
+                
+                if ((function == MATH_FUNCTION_SQRT) && (Gua_PObjectToInteger(p) <= 0)) {
+                    fast = false;
+                    break;
+                }
+            } else if (Gua_PObjectType(p) == OBJECT_TYPE_REAL) {
+                if ((function == MATH_FUNCTION_SQRT) && (Gua_PObjectToReal(p) <= 0)) {
+                    fast = false;
+                    break;
+                }
+            } else {
+                fast = false;
+                break;
+            }
+        }
+    }
+    
+    /* fmax and fmin keep integers when both arguments are integers. */
+    if (fast && ((function == MATH_FUNCTION_FMAX) || (function == MATH_FUNCTION_FMIN)) && !real[1] && !real[2]) {
+        fast = false;
+    }
+    
+    Gua_MatrixToPObject(object, (struct Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix)), length);
+    m = (Gua_Matrix *)Gua_PObjectToMatrix(object);
+    m->dimc = shape->dimc;
+    m->dimv = (Gua_Length *)Gua_Alloc(shape->dimc * sizeof(Gua_Length));
+    memcpy(m->dimv, shape->dimv, shape->dimc * sizeof(Gua_Length));
+    m->object = (struct Gua_Object *)Gua_Alloc(length * sizeof(Gua_Object));
+    target = (Gua_Object *)m->object;
+    
+    if (fast) {
+        buffer = (Gua_Real *)Gua_Alloc(argc * length * sizeof(Gua_Real));
+        r = buffer;
+        
+        for (j = 1; j < argc; j++) {
+            x[j] = buffer + j * length;
+            
+            for (i = 0; i < length; i++) {
+                p = source[j] ? &(source[j][i]) : &(argv[j]);
+                
+                if (Gua_PObjectType(p) == OBJECT_TYPE_INTEGER) {
+                    x[j][i] = Gua_PObjectToInteger(p);
+                } else {
+                    x[j][i] = Gua_PObjectToReal(p);
+                }
+            }
+        }
+        
+        Math_ApplyRealBuffer(function, x[1], argc > 2 ? x[2] : NULL, r, length);
+        
+        if (function == MATH_FUNCTION_ROUNDL) {
+            for (i = 0; i < length; i++) {
+                Gua_IntegerToObject(target[i], r[i]);
+            }
+        } else {
+            for (i = 0; i < length; i++) {
+                Gua_RealToObject(target[i], r[i]);
+            }
+        }
+        
+        Gua_Free(buffer);
+        
+        return GUA_OK;
+    }
+    
+    /* Fall back to the scalar function for each element. */
+    Gua_LinkObjects(element[0], argv[0]);
+    
+    for (i = 0; i < length; i++) {
+        Gua_ClearObject(target[i]);
+    }
+    
+    for (i = 0; i < length; i++) {
+        for (j = 1; j < argc; j++) {
+            p = source[j] ? &(source[j][i]) : &(argv[j]);
+            Gua_LinkFromPObject(element[j], p);
+        }
+        
+        Gua_ClearObject(o);
+        
+        if (Math_MathFunctionWrapper(nspace, argc, element, &o, error) != GUA_OK) {
+            Gua_FreeObject(object);
+            
+            return GUA_ERROR;
+        }
+        
+        Gua_LinkObjects(target[i], o);
+    }
+    
+    return GUA_OK;
+}
+
 /**
  * Group:
  *     C
@@ -83,6 +860,15 @@ Gua_Status Math_MathFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object *ar
         return GUA_ERROR;
     }
     
+    /* Matrix arguments are mapped element by element. */
+    if ((argc > 1) && (Math_ElementwiseFunction(Gua_ObjectToString(argv[0])) != MATH_FUNCTION_NONE)) {
+        for (i = 1; i < argc; i++) {
+            if (Gua_ObjectType(argv[i]) == OBJECT_TYPE_MATRIX) {
+                return Math_ApplyToMatrix(nspace, argc, argv, object, error);
+            }
+        }
+    }
+    
     /*
      * Complex numbers functions:
      *
@@ -868,11 +1654,7 @@ Gua_Status Math_MathFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object *ar
             return GUA_ERROR;
         }
         
-#ifdef _WINDOWS_
-        Gua_RealToPObject(object, (1.0 * (rand() / (RAND_MAX + 1.0))));
-#else
-        Gua_RealToPObject(object, (1.0 * (random() / (RAND_MAX + 1.0))));
-#endif
+        Gua_RealToPObject(object, Math_UniformRandom(Math_GetRandomState()));
     } else if (strcmp(Gua_ObjectToString(argv[0]), "round") == 0) {
         if (argc != 2) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
@@ -1016,7 +1798,7 @@ Gua_Status Math_MathFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object *ar
             Gua_ComplexToPObject(object, sqrt(r) * cos(t / 2), sqrt(r) * sin(t / 2));
         }
     } else if (strcmp(Gua_ObjectToString(argv[0]), "srandom") == 0) {
-        if (argc != 2) {
+        if ((argc != 2) && (argc != 3)) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
             sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
@@ -1033,20 +1815,24 @@ Gua_Status Math_MathFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object *ar
             
             return GUA_ERROR;
         }
+        if (argc == 3) {
+            if (!((Gua_ObjectType(argv[2]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectToInteger(argv[2]) >= 0))) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+        }
         
+        /* srandom(seed, stream) selects one of the independent streams of the seed. */
         if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_INTEGER) {
-#ifdef _WINDOWS_
-            srand(Gua_ObjectToInteger(argv[1]));
-#else
-            srandom(Gua_ObjectToInteger(argv[1]));
-#endif            
+            Math_SetRandomSeed((uint64_t)Gua_ObjectToInteger(argv[1]), argc == 3 ? Gua_ObjectToInteger(argv[2]) : 0);
+            
             Gua_IntegerToPObject(object, Gua_ObjectToInteger(argv[1]));
         } else if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_REAL) {
-#ifdef _WINDOWS_
-            srand(Gua_ObjectToReal(argv[1]));
-#else
-            srandom(Gua_ObjectToReal(argv[1]));
-#endif            
+            Math_SetRandomSeed((uint64_t)(Gua_Integer)Gua_ObjectToReal(argv[1]), argc == 3 ? Gua_ObjectToInteger(argv[2]) : 0);
             
             Gua_RealToPObject(object, Gua_ObjectToReal(argv[1]));
         }
@@ -1156,6 +1942,9 @@ Gua_Status Math_Init(void *nspace, int argc, char *argv[], char **env, Gua_Strin
     Gua_Object object;
     Gua_String errMessage;
     
+    /* Build the tables here, while only one thread is running. */
+    Math_InitZiggurat();
+    
     Gua_LinkCFunctionToFunction(function, Math_MathFunctionWrapper);
     if (Gua_SetFunction((Gua_Namespace *)nspace, "acos", &function) != GUA_OK) {
         errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
@@ -31,7 +31,14 @@
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
+#ifndef _WINDOWS_
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 #include "interp.h"
+#include "math.h"
 #include "matrix.h"
 
 /**
@@ -290,6 +297,105 @@ Gua_Status Matrix_DetMatrix(Gua_Object *a, Gua_Object *object, Gua_String error)
     return GUA_OK;
 }
 
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Matrix_TransposeBlock(Gua_Object *o1, Gua_Object *o2, Gua_Length rows, Gua_Length cols, Gua_Length r0, Gua_Length r1, Gua_Length c0, Gua_Length c1, Gua_Short copy)
+ *
+ * Description:
+ *     Transpose the block [r0, r1) x [c0, c1) of a rows x cols cell array.
+ *     The block is split in halves along its longest side until it fits in
+ *     MATRIX_TRANSPOSE_BLOCK_SIZE, so the source and the target tiles stay in cache.
+ *
+ * Arguments:
+ *     o1,      the source cells;
+ *     o2,      the target cells, a cols x rows array;
+ *     rows,    the number of rows of the source;
+ *     cols,    the number of columns of the source;
+ *     r0,      the first row of the block;
+ *     r1,      the row after the last row of the block;
+ *     c0,      the first column of the block;
+ *     c1,      the column after the last column of the block;
+ *     copy,    if TRUE the strings are duplicated, otherwise the cells are moved.
+ *
+ * Results:
+ *     The function writes the transposed block to o2.
+ */
+void Matrix_TransposeBlock(Gua_Object *o1, Gua_Object *o2, Gua_Length rows, Gua_Length cols, Gua_Length r0, Gua_Length r1, Gua_Length c0, Gua_Length c1, Gua_Short copy)
+{
+    Gua_Length i;
+    Gua_Length j;
+    Gua_Length half;
+    
+    if (((r1 - r0) <= MATRIX_TRANSPOSE_BLOCK_SIZE) && ((c1 - c0) <= MATRIX_TRANSPOSE_BLOCK_SIZE)) {
+        for (j = c0; j < c1; j++) {
+            for (i = r0; i < r1; i++) {
+                if (copy && (Gua_ObjectType(o1[i * cols + j]) == OBJECT_TYPE_STRING)) {
+                    Gua_ByteArrayToObject(o2[j * rows + i], Gua_ObjectToString(o1[i * cols + j]), Gua_ObjectLength(o1[i * cols + j]));
+                } else {
+                    o2[j * rows + i] = o1[i * cols + j];
+                    Gua_SetStoredObject(o2[j * rows + i]);
+                }
+            }
+        }
+    } else if ((r1 - r0) >= (c1 - c0)) {
+        half = r0 + (r1 - r0) / 2;
+        Matrix_TransposeBlock(o1, o2, rows, cols, r0, half, c0, c1, copy);
+        Matrix_TransposeBlock(o1, o2, rows, cols, half, r1, c0, c1, copy);
+    } else {
+        half = c0 + (c1 - c0) / 2;
+        Matrix_TransposeBlock(o1, o2, rows, cols, r0, r1, c0, half, copy);
+        Matrix_TransposeBlock(o1, o2, rows, cols, r0, r1, half, c1, copy);
+    }
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Matrix_TransposeSquare(Gua_Object *o, Gua_Length n)
+ *
+ * Description:
+ *     Transpose a n x n cell array in place, swapping the tiles above the
+ *     diagonal with the tiles below it.
+ *
+ * Arguments:
+ *     o,    the cells;
+ *     n,    the order of the matrix.
+ *
+ * Results:
+ *     The function transposes the cell array.
+ */
+void Matrix_TransposeSquare(Gua_Object *o, Gua_Length n)
+{
+    Gua_Length ib;
+    Gua_Length jb;
+    Gua_Length i;
+    Gua_Length j;
+    Gua_Length iend;
+    Gua_Length jend;
+    Gua_Object t;
+    
+    for (ib = 0; ib < n; ib = ib + MATRIX_TRANSPOSE_BLOCK_SIZE) {
+        iend = ib + MATRIX_TRANSPOSE_BLOCK_SIZE < n ? ib + MATRIX_TRANSPOSE_BLOCK_SIZE : n;
+        
+        for (jb = ib; jb < n; jb = jb + MATRIX_TRANSPOSE_BLOCK_SIZE) {
+            jend = jb + MATRIX_TRANSPOSE_BLOCK_SIZE < n ? jb + MATRIX_TRANSPOSE_BLOCK_SIZE : n;
+            
+            for (i = ib; i < iend; i++) {
+                for (j = (jb == ib ? i + 1 : jb); j < jend; j++) {
+                    t = o[i * n + j];
+                    o[i * n + j] = o[j * n + i];
+                    o[j * n + i] = t;
+                }
+            }
+        }
+    }
+}
+
 /**
  * Group:
  *     C
@@ -298,7 +404,9 @@ Gua_Status Matrix_DetMatrix(Gua_Object *a, Gua_Object *object, Gua_String error)
  *     Gua_Status Matrix_TransMatrix(Gua_Object *a, Gua_Object *b, Gua_String error)
  *
  * Description:
- *     Calculate the transpose of a.
+ *     Calculate the transpose of a. When a is a temporary object its buffer
+ *     is reused: square matrices are transposed in place and the cells of
+ *     the others are moved instead of copied.
  *
  * Arguments:
  *     a,        a matrix;
@@ -314,8 +422,8 @@ Gua_Status Matrix_TransMatrix(Gua_Object *a, Gua_Object *b, Gua_String error)
     Gua_Matrix *m2;
     Gua_Object *o1;
     Gua_Object *o2;
-    Gua_Integer i;
-    Gua_Integer j;
+    Gua_Length rows;
+    Gua_Length cols;
     Gua_String errMessage;
     
     if (Gua_PObjectType(a) != OBJECT_TYPE_MATRIX) {
@@ -345,29 +453,54 @@ Gua_Status Matrix_TransMatrix(Gua_Object *a, Gua_Object *b, Gua_String error)
             return GUA_ERROR;
         }
         
+        /* A vector is treated as a row vector and becomes a column vector. */
+        if (m1->dimc == 1) {
+            rows = 1;
+            cols = m1->dimv[0];
+        } else {
+            rows = m1->dimv[0];
+            cols = m1->dimv[1];
+        }
+        
         o1 = (Gua_Object *)m1->object;
         
+        /* The argument is a temporary object, so its buffer can be reused. */
+        if (!Gua_IsPObjectStored(a)) {
+            if (m1->dimc == 1) {
+                Gua_Free(m1->dimv);
+                m1->dimc = 2;
+                m1->dimv = Gua_Alloc(m1->dimc * sizeof(Gua_Length));
+            } else if (rows == cols) {
+                Matrix_TransposeSquare(o1, rows);
+            } else {
+                o2 = (Gua_Object *)Gua_Alloc(Gua_PObjectLength(a) * sizeof(Gua_Object));
+                Matrix_TransposeBlock(o1, o2, rows, cols, 0, rows, 0, cols, false);
+                Gua_Free(o1);
+                m1->object = (struct Gua_Object *)o2;
+            }
+            
+            m1->dimv[0] = cols;
+            m1->dimv[1] = rows;
+            
+            Gua_MatrixToPObject(b, (struct Gua_Matrix *)m1, Gua_PObjectLength(a));
+            Gua_SetStoredPObject(a);
+            
+            return GUA_OK;
+        }
+        
         Gua_MatrixToPObject(b, (struct Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix)), Gua_PObjectLength(a));
         m2 = (Gua_Matrix *)Gua_PObjectToMatrix(b);
         
-        m2->dimc = m1->dimc;
-        m2->dimv = Gua_Alloc(m2->dimc * sizeof(Gua_Integer));
+        m2->dimc = 2;
+        m2->dimv = Gua_Alloc(m2->dimc * sizeof(Gua_Length));
         
-        m2->dimv[0] = m1->dimv[1];
-        m2->dimv[1] = m1->dimv[0];
+        m2->dimv[0] = cols;
+        m2->dimv[1] = rows;
         
         m2->object = (struct Gua_Object *)Gua_Alloc(Gua_PObjectLength(a) * sizeof(Gua_Object));
         o2 = (Gua_Object *)m2->object;
         
-        for (i = 0; i < m1->dimv[0]; i++) {
-            for (j = 0; j < m1->dimv[1]; j++) {
-                if (Gua_ObjectType(o1[j * m2->dimv[1] + i]) == OBJECT_TYPE_STRING) {
-                    Gua_ByteArrayToObject(o2[j * m2->dimv[1] + i], Gua_ObjectToString(o1[i * m1->dimv[1] + j]), Gua_ObjectLength(o1[i * m1->dimv[1] + j]));
-                } else {
-                    Gua_LinkObjects(o2[j * m2->dimv[1] + i], o1[i * m1->dimv[1] + j]);
-                }
-            }
-        }
+        Matrix_TransposeBlock(o1, o2, rows, cols, 0, rows, 0, cols, true);
     }
     
     return GUA_OK;
@@ -378,187 +511,66 @@ Gua_Status Matrix_TransMatrix(Gua_Object *a, Gua_Object *b, Gua_String error)
  *     C
  *
  * Function:
- *     Gua_Status Matrix_Cross(Gua_Object *a, Gua_Object *b, Gua_Object *c, Gua_String error)
+ *     Gua_Status Matrix_Reshape(Gua_Object *a, Gua_Short dimc, Gua_Length *dimv, Gua_Object *b, Gua_String error)
  *
  * Description:
- *     Calculate the cross product of two vectors a and b.
+ *     Change the dimensions of a keeping its cells in row-major order. When a
+ *     is a temporary object only its dimension vector is rewritten.
  *
  * Arguments:
- *     a,        vector a(an one row matrix);
- *     b,        vector b(an one row matrix);
- *     c,        a structure containing the return object of the function;
+ *     a,        a matrix;
+ *     dimc,     the number of dimensions of the result;
+ *     dimv,     the dimensions of the result;
+ *     b,        a structure containing the return object of the function;
  *     error,    a pointer to the error message.
  *
  * Results:
- *     The function returns the cross product of two vectors a and b.
+ *     The function returns a with the new dimensions.
  */
-Gua_Status Matrix_Cross(Gua_Object *a, Gua_Object *b, Gua_Object *c, Gua_String error)
+Gua_Status Matrix_Reshape(Gua_Object *a, Gua_Short dimc, Gua_Length *dimv, Gua_Object *b, Gua_String error)
 {
-    Gua_Matrix *m1;
-    Gua_Matrix *m2;
-    Gua_Matrix *m3;
-    Gua_Object *o1;
-    Gua_Object *o2;
-    Gua_Object *v3;
-    Gua_Object u;
-    Gua_Object v;
-    Gua_Integer i;
+    Gua_Matrix *m;
+    Gua_Length length;
+    Gua_Short i;
     Gua_String errMessage;
     
-    Gua_ClearObject(u);
-    Gua_ClearObject(v);
-
-    if (Gua_PObjectType(a) != OBJECT_TYPE_MATRIX) {
-        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-        sprintf(errMessage, "%s...\n", "illegal argument 1");
-        strcat(error, errMessage);
-        Gua_Free(errMessage);
-        
-        return GUA_ERROR;
+    length = 1;
+    for (i = 0; i < dimc; i++) {
+        length = length * dimv[i];
     }
-    if (Gua_PObjectType(b) != OBJECT_TYPE_MATRIX) {
+    
+    if ((Gua_PObjectType(a) != OBJECT_TYPE_MATRIX) || (length != Gua_PObjectLength(a))) {
         errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-        sprintf(errMessage, "%s...\n", "illegal argument 2");
+        sprintf(errMessage, "%s...\n", "the new dimensions do not match the number of elements");
         strcat(error, errMessage);
         Gua_Free(errMessage);
         
         return GUA_ERROR;
     }
     
-    m1 = (Gua_Matrix *)Gua_PObjectToMatrix(a);
-    m2 = (Gua_Matrix *)Gua_PObjectToMatrix(b);
-
-    if (m1 && m2) {
-        if(!Gua_IsPObjectStored(c)) {
-            Gua_FreeObject(c);
+    if (!Gua_IsPObjectStored(a)) {
+        if(!Gua_IsPObjectStored(b)) {
+            Gua_FreeObject(b);
         } else {
-            Gua_ClearPObject(c);
-        }
-        
-        if (m1->dimc != m2->dimc) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "the matrices do not have compatible dimensions");
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
-        }
-        if (m1->dimv[0] != m2->dimv[0]) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "the matrices do not have compatible dimensions");
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
-        }
-        if (m1->dimv[1] != m2->dimv[1]) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "the matrices do not have compatible dimensions");
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
-        }
-        if (m1->dimc != 2) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "only bidimensional matrices are supported");
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
-        }
-        if (m2->dimc != 2) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "only bidimensional matrices are supported");
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
-        }
-        if ((m1->dimv[0] != 1) || (m2->dimv[0] != 1)) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "only 1x2 or 1x3 matrices are supported");
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
-        }
-        if ((m1->dimv[1] < 2) || (m1->dimv[1] > 3)) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "only 1x2 or 1x3 matrices are supported");
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
-        }
-        if ((m2->dimv[1] < 2) || (m2->dimv[1] > 3)) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "only 1x2 or 1x3 matrices are supported");
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
-        }
-        
-        /* We will work with copies, to not change the original matrices. */
-        Gua_CopyMatrix(&u, a, false);
-        Gua_CopyMatrix(&v, b, false);
-        
-        m1 = (Gua_Matrix *)Gua_ObjectToMatrix(u);
-        o1 = (Gua_Object *)m1->object;
-        
-        m2 = (Gua_Matrix *)Gua_ObjectToMatrix(v);
-        o2 = (Gua_Object *)m2->object;
-        
-        /* Convert the matrices to real. */
-        for (i = 0; i < Gua_ObjectLength(u); i++) {
-            if (Gua_ObjectType(o1[i]) == OBJECT_TYPE_INTEGER) {
-                Gua_ConvertIntegerObjectToReal(o1[i]);
-            } else {
-                if (Gua_ObjectType(o1[i]) != OBJECT_TYPE_REAL) {
-                    Gua_FreeObject(&o1[i]);
-                    Gua_RealToObject(o1[i], 0.0);
-                }
-            }
-        }
-        for (i = 0; i < Gua_ObjectLength(v); i++) {
-            if (Gua_ObjectType(o2[i]) == OBJECT_TYPE_INTEGER) {
-                Gua_ConvertIntegerObjectToReal(o2[i]);
-            } else {
-                if (Gua_ObjectType(o2[i]) != OBJECT_TYPE_REAL) {
-                    Gua_FreeObject(&o2[i]);
-                    Gua_RealToObject(o2[i], 0.0);
-                }
-            }
-        }
-        
-        
-        /* Create the result matrix. */
-        Gua_MatrixToPObject(c, (struct Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix)), Gua_PObjectLength(a));
-        m3 = (Gua_Matrix *)Gua_PObjectToMatrix(c);
-        
-        m3->dimc = m1->dimc;
-        m3->dimv = Gua_Alloc(m1->dimc * sizeof(long));
-        
-        for (i = 0; i < m1->dimc; i++) {
-            m3->dimv[i] = m1->dimv[i];
+            Gua_ClearPObject(b);
         }
         
-        m3->object = (struct Gua_Object *)Gua_Alloc(Gua_PObjectLength(a) * sizeof(Gua_Object));
-        v3 = (Gua_Object *)m3->object;
-        
-        /* This release only supports real numbers. */
-        if (m1->dimv[1] == 2) {
-            Gua_RealToObject(v3[0], (Gua_ObjectToReal(o1[0]) * Gua_ObjectToReal(o2[1])));
-            Gua_RealToObject(v3[1], (-Gua_ObjectToReal(o1[1]) * Gua_ObjectToReal(o2[0])));
-        } else {
-            Gua_RealToObject(v3[0], (Gua_ObjectToReal(o1[1]) * Gua_ObjectToReal(o2[2]) - Gua_ObjectToReal(o2[1]) * Gua_ObjectToReal(o1[2])));
-            Gua_RealToObject(v3[1], (Gua_ObjectToReal(o1[2]) * Gua_ObjectToReal(o2[0]) - Gua_ObjectToReal(o2[2]) * Gua_ObjectToReal(o1[0])));
-            Gua_RealToObject(v3[2], (Gua_ObjectToReal(o1[0]) * Gua_ObjectToReal(o2[1]) - Gua_ObjectToReal(o2[0]) * Gua_ObjectToReal(o1[1])));
-        }
-                
-        Gua_FreeObject(&u);
-        Gua_FreeObject(&v);
+        Gua_MatrixToPObject(b, Gua_PObjectToMatrix(a), Gua_PObjectLength(a));
+        Gua_SetStoredPObject(a);
+    } else {
+        Gua_CopyMatrix(b, a, false);
+    }
+    
+    m = (Gua_Matrix *)Gua_PObjectToMatrix(b);
+    
+    if (m->dimc != dimc) {
+        Gua_Free(m->dimv);
+        m->dimc = dimc;
+        m->dimv = Gua_Alloc(m->dimc * sizeof(Gua_Length));
+    }
+    
+    for (i = 0; i < dimc; i++) {
+        m->dimv[i] = dimv[i];
     }
     
     return GUA_OK;
@@ -569,169 +581,144 @@ Gua_Status Matrix_Cross(Gua_Object *a, Gua_Object *b, Gua_Object *c, Gua_String
  *     C
  *
  * Function:
- *     Gua_Status Matrix_Dot(Gua_Object *a, Gua_Object *b, Gua_Object *c, Gua_String error)
+ *     void Matrix_PutUInt64(unsigned char *p, uint64_t v)
  *
  * Description:
- *     Calculate the dot product of two vectors a and b.
+ *     Write a 64 bits unsigned integer in little-endian byte order.
  *
  * Arguments:
- *     a,        vector a(an one row matrix);
- *     b,        vector b(an one row matrix);
- *     c,        a structure containing the return object of the function;
- *     error,    a pointer to the error message.
+ *     p,    the target bytes;
+ *     v,    the value.
  *
  * Results:
- *     The function returns the dot product of two vectors a and b.
+ *     The function writes 8 bytes to p.
  */
-Gua_Status Matrix_Dot(Gua_Object *a, Gua_Object *b, Gua_Object *c, Gua_String error)
+void Matrix_PutUInt64(unsigned char *p, uint64_t v)
 {
-    Gua_Matrix *m1;
-    Gua_Matrix *m2;
-    Gua_Object *o1;
-    Gua_Object *o2;
-    Gua_Object u;
-    Gua_Object v;
-    Gua_Integer i;
-    Gua_String errMessage;
+    Gua_Short i;
     
-    Gua_ClearObject(u);
-    Gua_ClearObject(v);
+    for (i = 0; i < 8; i++) {
+        p[i] = (unsigned char)(v >> (8 * i));
+    }
+}
 
-    if (Gua_PObjectType(a) != OBJECT_TYPE_MATRIX) {
-        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-        sprintf(errMessage, "%s...\n", "illegal argument 1");
-        strcat(error, errMessage);
-        Gua_Free(errMessage);
-        
-        return GUA_ERROR;
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     uint64_t Matrix_GetUInt64(unsigned char *p)
+ *
+ * Description:
+ *     Read a 64 bits unsigned integer stored in little-endian byte order.
+ *
+ * Arguments:
+ *     p,    the source bytes.
+ *
+ * Results:
+ *     The function returns the value.
+ */
+uint64_t Matrix_GetUInt64(unsigned char *p)
+{
+    uint64_t v;
+    Gua_Short i;
+    
+    v = 0;
+    for (i = 7; i >= 0; i--) {
+        v = (v << 8) | p[i];
     }
-    if (Gua_PObjectType(b) != OBJECT_TYPE_MATRIX) {
-        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-        sprintf(errMessage, "%s...\n", "illegal argument 2");
-        strcat(error, errMessage);
-        Gua_Free(errMessage);
-        
+    
+    return v;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Matrix_MapFile(Gua_String fileName, unsigned char **p, Gua_Length *size)
+ *
+ * Description:
+ *     Map a whole file in memory for reading. On Windows the file is read
+ *     into a buffer instead.
+ *
+ * Arguments:
+ *     fileName,    the file name;
+ *     p,           a pointer to the first byte of the file, NULL if the file is empty;
+ *     size,        the size of the file.
+ *
+ * Results:
+ *     The function returns GUA_ERROR if the file could not be opened.
+ */
+Gua_Status Matrix_MapFile(Gua_String fileName, unsigned char **p, Gua_Length *size)
+{
+#ifdef _WINDOWS_
+    FILE *fp;
+    
+    *p = NULL;
+    *size = 0;
+    
+    fp = fopen(fileName, "rb");
+    
+    if (fp == NULL) {
         return GUA_ERROR;
     }
     
-    m1 = (Gua_Matrix *)Gua_PObjectToMatrix(a);
-    m2 = (Gua_Matrix *)Gua_PObjectToMatrix(b);
+    fseek(fp, 0, SEEK_END);
+    *size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
     
-    if (m1 && m2) {
-        if(!Gua_IsPObjectStored(c)) {
-            Gua_FreeObject(c);
-        } else {
-            Gua_ClearPObject(c);
-        }
-        
-        if (m1->dimc != m2->dimc) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "the matrices do not have compatible dimensions");
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
-        }
-        if (m1->dimv[0] != m2->dimv[0]) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "the matrices do not have compatible dimensions");
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
-        }
-        if (m1->dimv[1] != m2->dimv[1]) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "the matrices do not have compatible dimensions");
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
-        }
-        if (m1->dimc != 2) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "only bidimensional matrices are supported");
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
-        }
-        if (m2->dimc != 2) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "only bidimensional matrices are supported");
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
-        }
-        if ((m1->dimv[0] != 1) || (m2->dimv[0] != 1)) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "only 1x2 or 1x3 matrices are supported");
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
-        }
-        if ((m1->dimv[1] < 2) || (m1->dimv[1] > 3)) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "only 1x2 or 1x3 matrices are supported");
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
-        }
-        if ((m2->dimv[1] < 2) || (m2->dimv[1] > 3)) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "only 1x2 or 1x3 matrices are supported");
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
+    if (*size > 0) {
+        *p = (unsigned char *)Gua_Alloc(*size);
+        
+        if (fread(*p, 1, *size, fp) != (size_t)*size) {
+            Gua_Free(*p);
+            *p = NULL;
+            *size = 0;
+            fclose(fp);
             
             return GUA_ERROR;
         }
+    }
+    
+    fclose(fp);
+#else
+    int fd;
+    struct stat st;
+    
+    *p = NULL;
+    *size = 0;
+    
+    fd = open(fileName, O_RDONLY);
+    
+    if (fd < 0) {
+        return GUA_ERROR;
+    }
+    
+    if (fstat(fd, &st) != 0) {
+        close(fd);
         
-        /* We will work with copies, to not change the original matrices. */
-        Gua_CopyMatrix(&u, a, false);
-        Gua_CopyMatrix(&v, b, false);
-        
-        m1 = (Gua_Matrix *)Gua_ObjectToMatrix(u);
-        o1 = (Gua_Object *)m1->object;
-        
-        m2 = (Gua_Matrix *)Gua_ObjectToMatrix(v);
-        o2 = (Gua_Object *)m2->object;
+        return GUA_ERROR;
+    }
+    
+    if (st.st_size > 0) {
+        *p = (unsigned char *)mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
         
-        /* Convert the matrices to real. */
-        for (i = 0; i < Gua_ObjectLength(u); i++) {
-            if (Gua_ObjectType(o1[i]) == OBJECT_TYPE_INTEGER) {
-                Gua_ConvertIntegerObjectToReal(o1[i]);
-            } else {
-                if (Gua_ObjectType(o1[i]) != OBJECT_TYPE_REAL) {
-                    Gua_FreeObject(&o1[i]);
-                    Gua_RealToObject(o1[i], 0.0);
-                }
-            }
-        }
-        for (i = 0; i < Gua_ObjectLength(v); i++) {
-            if (Gua_ObjectType(o2[i]) == OBJECT_TYPE_INTEGER) {
-                Gua_ConvertIntegerObjectToReal(o2[i]);
-            } else {
-                if (Gua_ObjectType(o2[i]) != OBJECT_TYPE_REAL) {
-                    Gua_FreeObject(&o2[i]);
-                    Gua_RealToObject(o2[i], 0.0);
-                }
-            }
+        if (*p == (unsigned char *)MAP_FAILED) {
+            *p = NULL;
+            close(fd);
+            
+            return GUA_ERROR;
         }
         
-        /* This release only supports real numbers. */
-        if (m1->dimv[1] == 2) {
-            Gua_RealToPObject(c, (Gua_ObjectToReal(o1[0]) * Gua_ObjectToReal(o2[0]) + Gua_ObjectToReal(o1[1]) * Gua_ObjectToReal(o2[1])));
-        } else {
-            Gua_RealToPObject(c, (Gua_ObjectToReal(o1[0]) * Gua_ObjectToReal(o2[0]) + Gua_ObjectToReal(o1[1]) * Gua_ObjectToReal(o2[1]) + Gua_ObjectToReal(o1[2]) * Gua_ObjectToReal(o2[2])));
-        }
+        *size = st.st_size;
         
-        Gua_FreeObject(&u);
-        Gua_FreeObject(&v);
+        madvise(*p, *size, MADV_SEQUENTIAL);
     }
     
+    close(fd);
+#endif
+    
     return GUA_OK;
 }
 
@@ -740,61 +727,169 @@ Gua_Status Matrix_Dot(Gua_Object *a, Gua_Object *b, Gua_Object *c, Gua_String er
  *     C
  *
  * Function:
- *     Gua_Status Matrix_Sum(Gua_Object *a, Gua_Object *object, Gua_String error)
+ *     void Matrix_UnmapFile(unsigned char *p, Gua_Length size)
  *
  * Description:
- *     Calculate the sum of all cells in the matrix.
+ *     Release a file mapped by Matrix_MapFile.
  *
  * Arguments:
- *     a,         a matrix;
- *     object,    a structure containing the return object of the function;
- *     error,     a pointer to the error message.
+ *     p,       the first byte of the file;
+ *     size,    the size of the file.
  *
  * Results:
- *     The function returns the sum of all cells in the matrix.
+ *     The function releases the memory used by the file.
  */
-Gua_Status Matrix_Sum(Gua_Object *a, Gua_Object *object, Gua_String error)
+void Matrix_UnmapFile(unsigned char *p, Gua_Length size)
+{
+    if (p == NULL) {
+        return;
+    }
+    
+#ifdef _WINDOWS_
+    Gua_Free(p);
+#else
+    munmap(p, size);
+#endif
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Matrix_Save(Gua_Object *a, Gua_String fileName, Gua_String error)
+ *
+ * Description:
+ *     Save a numeric matrix to a binary file. The file starts with a header
+ *     holding the magic number, the version, the element type, the number of
+ *     dimensions, the payload offset and the dimensions, all little-endian.
+ *     The payload starts at the next MATRIX_FILE_ALIGNMENT bytes boundary and
+ *     holds the raw elements in row-major order: 64 bits integers, doubles or
+ *     pairs of doubles for complex matrices.
+ *
+ * Arguments:
+ *     a,           a matrix;
+ *     fileName,    the file name;
+ *     error,       a pointer to the error message.
+ *
+ * Results:
+ *     The function writes the matrix to the file.
+ */
+Gua_Status Matrix_Save(Gua_Object *a, Gua_String fileName, Gua_String error)
 {
     Gua_Matrix *m;
     Gua_Object *o;
     Gua_Length length;
-    Gua_Integer i;
-    Gua_Real sum;
+    Gua_Length offset;
+    Gua_Length size;
+    Gua_Length i;
+    Gua_Length n;
+    Gua_Short dtype;
+    Gua_Short width;
+    unsigned char *buffer;
+    Gua_Real r;
+    uint64_t v;
+    FILE *fp;
     Gua_String errMessage;
     
-    if (Gua_PObjectType(a) != OBJECT_TYPE_MATRIX) {
+    m = (Gua_Matrix *)Gua_PObjectToMatrix(a);
+    o = (Gua_Object *)m->object;
+    length = Gua_PObjectLength(a);
+    
+    /* Choose the narrowest element type able to hold every cell. */
+    dtype = MATRIX_FILE_TYPE_INTEGER;
+    for (i = 0; i < length; i++) {
+        if (Gua_ObjectType(o[i]) == OBJECT_TYPE_INTEGER) {
+            continue;
+        } else if (Gua_ObjectType(o[i]) == OBJECT_TYPE_REAL) {
+            if (dtype == MATRIX_FILE_TYPE_INTEGER) {
+                dtype = MATRIX_FILE_TYPE_REAL;
+            }
+        } else if (Gua_ObjectType(o[i]) == OBJECT_TYPE_COMPLEX) {
+            dtype = MATRIX_FILE_TYPE_COMPLEX;
+        } else {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "only numeric matrices can be saved");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+    }
+    
+    width = dtype == MATRIX_FILE_TYPE_COMPLEX ? 16 : 8;
+    
+    offset = MATRIX_FILE_HEADER_SIZE + m->dimc * 8;
+    offset = ((offset + MATRIX_FILE_ALIGNMENT - 1) / MATRIX_FILE_ALIGNMENT) * MATRIX_FILE_ALIGNMENT;
+    
+    fp = fopen(fileName, "wb");
+    
+    if (fp == NULL) {
         errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-        sprintf(errMessage, "%s...\n", "illegal argument");
+        sprintf(errMessage, "%s %-.20s...\n", "could not open file", fileName);
         strcat(error, errMessage);
         Gua_Free(errMessage);
         
         return GUA_ERROR;
     }
     
-    m = (Gua_Matrix *)Gua_PObjectToMatrix(a);
+    size = offset > MATRIX_FILE_BUFFER_SIZE ? offset : MATRIX_FILE_BUFFER_SIZE;
+    buffer = (unsigned char *)Gua_Alloc(size);
+    memset(buffer, 0, offset);
     
-    if (m) {
-        if(!Gua_IsPObjectStored(object)) {
-            Gua_FreeObject(object);
+    memcpy(buffer, MATRIX_FILE_MAGIC, 8);
+    Matrix_PutUInt64(buffer + 8, MATRIX_FILE_VERSION);
+    Matrix_PutUInt64(buffer + 16, dtype);
+    Matrix_PutUInt64(buffer + 24, m->dimc);
+    Matrix_PutUInt64(buffer + 32, offset);
+    for (i = 0; i < m->dimc; i++) {
+        Matrix_PutUInt64(buffer + MATRIX_FILE_HEADER_SIZE + i * 8, m->dimv[i]);
+    }
+    
+    n = fwrite(buffer, 1, offset, fp) == (size_t)offset;
+    
+    /* Write the payload in blocks of MATRIX_FILE_BUFFER_SIZE bytes. */
+    size = 0;
+    for (i = 0; (i < length) && n; i++) {
+        if (dtype == MATRIX_FILE_TYPE_INTEGER) {
+            Matrix_PutUInt64(buffer + size, (uint64_t)Gua_ObjectToInteger(o[i]));
         } else {
-            Gua_ClearPObject(object);
+            if (Gua_ObjectType(o[i]) == OBJECT_TYPE_INTEGER) {
+                r = Gua_ObjectToInteger(o[i]);
+            } else {
+                r = Gua_ObjectToReal(o[i]);
+            }
+            memcpy(&v, &r, 8);
+            Matrix_PutUInt64(buffer + size, v);
+            
+            if (dtype == MATRIX_FILE_TYPE_COMPLEX) {
+                if (Gua_ObjectType(o[i]) == OBJECT_TYPE_COMPLEX) {
+                    r = Gua_ObjectToImaginary(o[i]);
+                } else {
+                    r = 0.0;
+                }
+                memcpy(&v, &r, 8);
+                Matrix_PutUInt64(buffer + size + 8, v);
+            }
         }
         
-        o = (Gua_Object *)m->object;
+        size = size + width;
         
-        length = Gua_PObjectLength(a);
-
-        sum = 0;
-
-        for (i = 0; i < length; i++) {
-            if (Gua_ObjectType(o[i]) == OBJECT_TYPE_INTEGER) {
-                sum = sum + Gua_ObjectToInteger(o[i]);
-            } else if (Gua_ObjectType(o[i]) == OBJECT_TYPE_REAL) {
-                sum = sum + Gua_ObjectToReal(o[i]);
-            }
+        if ((size + width > MATRIX_FILE_BUFFER_SIZE) || (i == length - 1)) {
+            n = fwrite(buffer, 1, size, fp) == (size_t)size;
+            size = 0;
         }
-
-        Gua_RealToPObject(object, sum);
+    }
+    
+    Gua_Free(buffer);
+    
+    if ((fclose(fp) != 0) || !n) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "could not write file", fileName);
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
     }
     
     return GUA_OK;
@@ -805,63 +900,130 @@ Gua_Status Matrix_Sum(Gua_Object *a, Gua_Object *object, Gua_String error)
  *     C
  *
  * Function:
- *     Gua_Status Matrix_Sum2(Gua_Object *a, Gua_Object *object, Gua_String error)
+ *     Gua_Status Matrix_Load(Gua_String fileName, Gua_Object *object, Gua_String error)
  *
  * Description:
- *     Calculate the squared sum of all cells in the matrix.
+ *     Load a matrix saved by Matrix_Save. The file is mapped in memory and
+ *     the cells are decoded straight from the mapping.
  *
  * Arguments:
- *     a,         a matrix;
- *     object,    a structure containing the return object of the function;
- *     error,     a pointer to the error message.
+ *     fileName,    the file name;
+ *     object,      a structure containing the return object of the function;
+ *     error,       a pointer to the error message.
  *
  * Results:
- *     The function returns the squared sum of all cells in the matrix.
+ *     The function returns the matrix stored in the file.
  */
-Gua_Status Matrix_Sum2(Gua_Object *a, Gua_Object *object, Gua_String error)
+Gua_Status Matrix_Load(Gua_String fileName, Gua_Object *object, Gua_String error)
 {
     Gua_Matrix *m;
     Gua_Object *o;
+    unsigned char *p;
+    unsigned char *q;
+    Gua_Length size;
+    Gua_Length offset;
     Gua_Length length;
-    Gua_Integer i;
-    Gua_Real sum;
+    Gua_Length dimc;
+    Gua_Length i;
+    Gua_Short dtype;
+    Gua_Short width;
+    Gua_Short valid;
+    Gua_Real r;
+    Gua_Real im;
+    uint64_t v;
     Gua_String errMessage;
     
-    if (Gua_PObjectType(a) != OBJECT_TYPE_MATRIX) {
+    if (Matrix_MapFile(fileName, &p, &size) != GUA_OK) {
         errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-        sprintf(errMessage, "%s...\n", "illegal argument");
+        sprintf(errMessage, "%s %-.20s...\n", "could not open file", fileName);
         strcat(error, errMessage);
         Gua_Free(errMessage);
         
         return GUA_ERROR;
     }
     
-    m = (Gua_Matrix *)Gua_PObjectToMatrix(a);
+    /* Check the header before touching the payload. */
+    valid = (size >= MATRIX_FILE_HEADER_SIZE) && (memcmp(p, MATRIX_FILE_MAGIC, 8) == 0) && (Matrix_GetUInt64(p + 8) == MATRIX_FILE_VERSION);
     
-    if (m) {
-        if(!Gua_IsPObjectStored(object)) {
-            Gua_FreeObject(object);
-        } else {
-            Gua_ClearPObject(object);
+    dtype = 0;
+    dimc = 0;
+    offset = 0;
+    length = 0;
+    width = 8;
+    
+    if (valid) {
+        dtype = Matrix_GetUInt64(p + 16);
+        dimc = Matrix_GetUInt64(p + 24);
+        offset = Matrix_GetUInt64(p + 32);
+        width = dtype == MATRIX_FILE_TYPE_COMPLEX ? 16 : 8;
+        
+        valid = (dtype <= MATRIX_FILE_TYPE_COMPLEX) && (dimc > 0) && (dimc <= MATRIX_FILE_MAX_DIMENSIONS) && (offset >= MATRIX_FILE_HEADER_SIZE + dimc * 8) && (offset <= size);
+    }
+    
+    if (valid) {
+        length = 1;
+        for (i = 0; i < dimc; i++) {
+            v = Matrix_GetUInt64(p + MATRIX_FILE_HEADER_SIZE + i * 8);
+            if ((v == 0) || (v > (uint64_t)(size - offset) / width) || ((Gua_Length)v > (size - offset) / width / length)) {
+                valid = false;
+                break;
+            }
+            length = length * v;
         }
+        valid = valid && (length * width == size - offset);
+    }
+    
+    if (!valid) {
+        Matrix_UnmapFile(p, size);
         
-        o = (Gua_Object *)m->object;
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "invalid matrix file", fileName);
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
         
-        length = Gua_PObjectLength(a);
-
-        sum = 0;
-
-        for (i = 0; i < length; i++) {
-            if (Gua_ObjectType(o[i]) == OBJECT_TYPE_INTEGER) {
-                sum = sum + Gua_ObjectToInteger(o[i]) * Gua_ObjectToInteger(o[i]);
-            } else if (Gua_ObjectType(o[i]) == OBJECT_TYPE_REAL) {
-                sum = sum + Gua_ObjectToReal(o[i]) * Gua_ObjectToReal(o[i]);
+        return GUA_ERROR;
+    }
+    
+    if (!Gua_IsPObjectStored(object)) {
+        Gua_FreeObject(object);
+    } else {
+        Gua_ClearPObject(object);
+    }
+    
+    Gua_MatrixToPObject(object, (struct Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix)), length);
+    m = (Gua_Matrix *)Gua_PObjectToMatrix(object);
+    
+    m->dimc = dimc;
+    m->dimv = (Gua_Length *)Gua_Alloc(m->dimc * sizeof(Gua_Length));
+    for (i = 0; i < dimc; i++) {
+        m->dimv[i] = Matrix_GetUInt64(p + MATRIX_FILE_HEADER_SIZE + i * 8);
+    }
+    
+    m->object = (struct Gua_Object *)Gua_Alloc(length * sizeof(Gua_Object));
+    o = (Gua_Object *)m->object;
+    
+    q = p + offset;
+    for (i = 0; i < length; i++) {
+        if (dtype == MATRIX_FILE_TYPE_INTEGER) {
+            Gua_IntegerToObject(o[i], (Gua_Integer)Matrix_GetUInt64(q));
+        } else {
+            v = Matrix_GetUInt64(q);
+            memcpy(&r, &v, 8);
+            
+            if (dtype == MATRIX_FILE_TYPE_COMPLEX) {
+                v = Matrix_GetUInt64(q + 8);
+                memcpy(&im, &v, 8);
+                Gua_ComplexToObject(o[i], r, im);
+            } else {
+                Gua_RealToObject(o[i], r);
             }
         }
-
-        Gua_RealToPObject(object, sum);
+        
+        q = q + width;
     }
     
+    Matrix_UnmapFile(p, size);
+    
     return GUA_OK;
 }
 
@@ -870,109 +1032,201 @@ Gua_Status Matrix_Sum2(Gua_Object *a, Gua_Object *object, Gua_String error)
  *     C
  *
  * Function:
- *     Gua_Status Matrix_SumCells(Gua_Object *a, Gua_Object x1, Gua_Object y1, Gua_Object x2, Gua_Object y2, Gua_Object *object, Gua_String error)
+ *     Gua_Char *Matrix_ParseNumber(Gua_Char *p, Gua_Char *end, Gua_Object *o)
  *
  * Description:
- *     Calculate the sum of specified cells in the matrix.
+ *     Parse a decimal number without going through the C library. Numbers
+ *     without a fraction or an exponent become integers. Reals with up to
+ *     15 significant digits and a small exponent are computed exactly with
+ *     a single multiplication or division; the others are handed to strtod.
  *
  * Arguments:
- *     a,         a matrix;
- *     x1,        row of the top left corner;
- *     y1,        column of the top left corner;
- *     x2,        row of the bottom right corner;
- *     y2,        column of the bottom right corner;
- *     object,    a structure containing the return object of the function;
- *     error,     a pointer to the error message.
+ *     p,      the first character of the number;
+ *     end,    the end of the buffer;
+ *     o,      the object receiving the number.
  *
  * Results:
- *     The function returns the sum of specified cells in the matrix.
+ *     The function returns a pointer to the character after the number, or
+ *     NULL if there is no number at p.
  */
-Gua_Status Matrix_SumCells(Gua_Object *a, Gua_Object x1, Gua_Object y1, Gua_Object x2, Gua_Object y2, Gua_Object *object, Gua_String error)
+Gua_Char *Matrix_ParseNumber(Gua_Char *p, Gua_Char *end, Gua_Object *o)
 {
-    Gua_Matrix *m;
-    Gua_Object *o;
-    Gua_Integer i;
-    Gua_Integer j;
-    Gua_Real sum;
-    Gua_String errMessage;
+    static const Gua_Real power[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    Gua_Char *start;
+    Gua_Char buffer[MATRIX_NUMBER_SIZE + 1];
+    uint64_t mantissa;
+    Gua_Integer exponent;
+    Gua_Integer e;
+    Gua_Short digits;
+    Gua_Short negative;
+    Gua_Short esign;
+    Gua_Short real;
+    Gua_Short any;
+    Gua_Real r;
     
-    if (Gua_PObjectType(a) != OBJECT_TYPE_MATRIX) {
-        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-        sprintf(errMessage, "%s...\n", "illegal argument");
-        strcat(error, errMessage);
-        Gua_Free(errMessage);
-        
-        return GUA_ERROR;
+    start = p;
+    mantissa = 0;
+    exponent = 0;
+    digits = 0;
+    negative = false;
+    real = false;
+    any = false;
+    
+    if ((p < end) && ((*p == '-') || (*p == '+'))) {
+        negative = *p == '-';
+        p++;
     }
     
-    m = (Gua_Matrix *)Gua_PObjectToMatrix(a);
+    for (; (p < end) && (*p >= '0') && (*p <= '9'); p++) {
+        any = true;
+        if (digits < 19) {
+            mantissa = mantissa * 10 + (*p - '0');
+            if (mantissa > 0) {
+                digits++;
+            }
+        } else {
+            exponent++;
+        }
+    }
     
-    if (m) {
-        if(!Gua_IsPObjectStored(object)) {
-            Gua_FreeObject(object);
+    if ((p < end) && (*p == '.')) {
+        real = true;
+        for (p++; (p < end) && (*p >= '0') && (*p <= '9'); p++) {
+            any = true;
+            if (digits < 19) {
+                mantissa = mantissa * 10 + (*p - '0');
+                exponent--;
+                if (mantissa > 0) {
+                    digits++;
+                }
+            }
+        }
+    }
+    
+    if (!any) {
+        /* Let the C library deal with inf and nan. */
+        if ((p < end) && ((*p == 'i') || (*p == 'I') || (*p == 'n') || (*p == 'N'))) {
+            digits = 20;
         } else {
-            Gua_ClearPObject(object);
+            return NULL;
+        }
+    } else if ((p < end) && ((*p == 'e') || (*p == 'E'))) {
+        real = true;
+        p++;
+        esign = 1;
+        if ((p < end) && ((*p == '-') || (*p == '+'))) {
+            esign = *p == '-' ? -1 : 1;
+            p++;
+        }
+        if (!((p < end) && (*p >= '0') && (*p <= '9'))) {
+            return NULL;
+        }
+        for (e = 0; (p < end) && (*p >= '0') && (*p <= '9'); p++) {
+            if (e < 100000) {
+                e = e * 10 + (*p - '0');
+            }
         }
-
-        if (m->dimc != 2) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "only bidimensional matrices are supported");
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
+        exponent = exponent + esign * e;
+    }
+    
+    if (!real && (digits <= 18) && (exponent == 0)) {
+        Gua_IntegerToPObject(o, negative ? -(Gua_Integer)mantissa : (Gua_Integer)mantissa);
+        
+        return p;
+    }
+    
+    if ((digits <= 15) && (exponent >= -22) && (exponent <= 22)) {
+        r = (Gua_Real)mantissa;
+        if (exponent < 0) {
+            r = r / power[-exponent];
+        } else {
+            r = r * power[exponent];
         }
-        if (Gua_ObjectToInteger(x1) < 0) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "index out of bound");
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
+    } else {
+        /* Slow path: too many digits or a large exponent. */
+        if (digits == 20) {
+            while ((p < end) && (((*p >= 'a') && (*p <= 'z')) || ((*p >= 'A') && (*p <= 'Z')))) {
+                p++;
+            }
         }
-        if (Gua_ObjectToInteger(y1) < 0) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "index out of bound");
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
+        if (p - start > MATRIX_NUMBER_SIZE) {
+            return NULL;
         }
-        if (Gua_ObjectToInteger(x2) > (m->dimv[0] - 1)) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "index out of bound");
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
+        memcpy(buffer, start, p - start);
+        buffer[p - start] = '\0';
+        
+        r = strtod(buffer, NULL);
+        negative = false;
+    }
+    
+    Gua_RealToPObject(o, negative ? -r : r);
+    
+    return p;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Length Matrix_ParseFields(Gua_Char *p, Gua_Char *eol, Gua_String separator, Gua_Short blank, Gua_Object *o, Gua_Length cols)
+ *
+ * Description:
+ *     Parse the numbers of a line of a delimited text file.
+ *
+ * Arguments:
+ *     p,            the first character of the line;
+ *     eol,          the end of the line;
+ *     separator,    the set of characters separating the fields;
+ *     blank,        if TRUE runs of spaces and tabs also separate the fields;
+ *     o,            the cells receiving the numbers;
+ *     cols,         the maximum number of fields.
+ *
+ * Results:
+ *     The function returns the number of fields, or -1 if the line is not
+ *     a list of at most cols numbers.
+ */
+Gua_Length Matrix_ParseFields(Gua_Char *p, Gua_Char *eol, Gua_String separator, Gua_Short blank, Gua_Object *o, Gua_Length cols)
+{
+    Gua_Object number;
+    Gua_Char *q;
+    Gua_Length col;
+    
+    for (col = 0; col < cols; ) {
+        while ((p < eol) && ((*p == ' ') || (*p == '\t'))) {
+            p++;
         }
-        if (Gua_ObjectToInteger(y2) > (m->dimv[1] - 1)) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "index out of bound");
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
+        
+        Gua_ClearObject(number);
+        q = Matrix_ParseNumber(p, eol, &number);
+        
+        if (q == NULL) {
+            return -1;
         }
         
-        o = (Gua_Object *)m->object;
+        o[col] = number;
+        col++;
         
-        sum = 0;
-
-        for (i = Gua_ObjectToInteger(x1); i <= Gua_ObjectToInteger(x2); i++) {
-            for (j = Gua_ObjectToInteger(y1); j <= Gua_ObjectToInteger(y2); j++) {
-                if (Gua_ObjectType(o[i * m->dimv[1] + j]) == OBJECT_TYPE_INTEGER) {
-                    sum = sum + Gua_ObjectToInteger(o[i * m->dimv[1] + j]);
-                } else if (Gua_ObjectType(o[i * m->dimv[1] + j]) == OBJECT_TYPE_REAL) {
-                    sum = sum + Gua_ObjectToReal(o[i * m->dimv[1] + j]);
-                }
-            }
+        p = q;
+        while ((p < eol) && ((*p == ' ') || (*p == '\t') || (*p == '\r'))) {
+            p++;
+        }
+        
+        if (p == eol) {
+            return col;
+        }
+        
+        if ((*p != ' ') && (*p != '\t') && (*p != '\0') && strchr(separator, *p)) {
+            p++;
+        } else if (!(blank && (p > q))) {
+            return -1;
         }
-
-        Gua_RealToPObject(object, sum);
     }
     
-    return GUA_OK;
+    return -1;
 }
 
 /**
@@ -980,66 +1234,165 @@ Gua_Status Matrix_SumCells(Gua_Object *a, Gua_Object x1, Gua_Object y1, Gua_Obje
  *     C
  *
  * Function:
- *     Gua_Status Matrix_Avg(Gua_Object *a, Gua_Object *object, Gua_String error)
+ *     Gua_Status Matrix_LoadText(Gua_String fileName, Gua_String separator, Gua_Integer skip, Gua_Object *object, Gua_String error)
  *
  * Description:
- *     Calculate the average of all cells in the matrix.
+ *     Load a delimited text file into a matrix. Each line is a row and the
+ *     number of columns is taken from the first row. Blank lines and lines
+ *     starting with '#' are ignored. Spaces and tabs around the fields are
+ *     always skipped; when the separator has a space or a tab, runs of
+ *     white space count as a single separator.
  *
  * Arguments:
- *     a,         a matrix;
- *     object,    a structure containing the return object of the function;
- *     error,     a pointer to the error message.
+ *     fileName,     the file name;
+ *     separator,    the set of characters separating the fields;
+ *     skip,         the number of lines to skip at the top of the file;
+ *     object,       a structure containing the return object of the function;
+ *     error,        a pointer to the error message.
  *
  * Results:
- *     The function returns the average of all cells in the matrix.
+ *     The function returns a matrix with the numbers in the file.
  */
-Gua_Status Matrix_Avg(Gua_Object *a, Gua_Object *object, Gua_String error)
+Gua_Status Matrix_LoadText(Gua_String fileName, Gua_String separator, Gua_Integer skip, Gua_Object *object, Gua_String error)
 {
     Gua_Matrix *m;
     Gua_Object *o;
-    Gua_Length length;
-    Gua_Integer i;
-    Gua_Real sum;
-    Gua_Real avg;
+    unsigned char *buffer;
+    Gua_Char *p;
+    Gua_Char *q;
+    Gua_Char *end;
+    Gua_Char *eol;
+    Gua_Length size;
+    Gua_Length rows;
+    Gua_Length cols;
+    Gua_Length row;
+    Gua_Length line;
+    Gua_Short blank;
     Gua_String errMessage;
     
-    if (Gua_PObjectType(a) != OBJECT_TYPE_MATRIX) {
+    if (Matrix_MapFile(fileName, &buffer, &size) != GUA_OK) {
         errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-        sprintf(errMessage, "%s...\n", "illegal argument");
+        sprintf(errMessage, "%s %-.20s...\n", "could not open file", fileName);
         strcat(error, errMessage);
         Gua_Free(errMessage);
         
         return GUA_ERROR;
     }
     
-    m = (Gua_Matrix *)Gua_PObjectToMatrix(a);
+    p = (Gua_Char *)buffer;
+    end = p + size;
     
-    if (m) {
-        if(!Gua_IsPObjectStored(object)) {
-            Gua_FreeObject(object);
-        } else {
-            Gua_ClearPObject(object);
+    blank = (strchr(separator, ' ') != NULL) || (strchr(separator, '\t') != NULL);
+    
+    for (line = 0; (line < skip) && (p < end); line++) {
+        eol = memchr(p, '\n', end - p);
+        p = eol ? eol + 1 : end;
+    }
+    
+    /* Count the data rows, so the matrix is allocated only once. */
+    rows = 0;
+    for (q = p; q < end; q = eol + 1) {
+        eol = memchr(q, '\n', end - q);
+        if (eol == NULL) {
+            eol = end;
         }
+        while ((q < eol) && ((*q == ' ') || (*q == '\t') || (*q == '\r'))) {
+            q++;
+        }
+        if ((q == eol) || (*q == '#')) {
+            continue;
+        }
+        rows++;
+    }
+    
+    if (rows == 0) {
+        Matrix_UnmapFile(buffer, size);
         
-        o = (Gua_Object *)m->object;
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "no data in file", fileName);
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
         
-        length = Gua_PObjectLength(a);
-
-        sum = 0;
-
-        for (i = 0; i < length; i++) {
-            if (Gua_ObjectType(o[i]) == OBJECT_TYPE_INTEGER) {
-                sum = sum + Gua_ObjectToInteger(o[i]);
-            } else if (Gua_ObjectType(o[i]) == OBJECT_TYPE_REAL) {
-                sum = sum + Gua_ObjectToReal(o[i]);
+        return GUA_ERROR;
+    }
+    
+    m = (Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix));
+    m->dimc = 2;
+    m->dimv = (Gua_Length *)Gua_Alloc(m->dimc * sizeof(Gua_Length));
+    m->object = NULL;
+    o = NULL;
+    
+    cols = 0;
+    row = 0;
+    for (; (p < end) && (row < rows); p = eol + 1, line++) {
+        eol = memchr(p, '\n', end - p);
+        if (eol == NULL) {
+            eol = end;
+        }
+        q = p;
+        while ((q < eol) && ((*q == ' ') || (*q == '\t') || (*q == '\r'))) {
+            q++;
+        }
+        if ((q == eol) || (*q == '#')) {
+            continue;
+        }
+        
+        /* The first row sets the number of columns. */
+        if (row == 0) {
+            cols = 1;
+            for (q = p; q < eol; q++) {
+                if (((*q != '\0') && strchr(separator, *q)) || (*q == ' ') || (*q == '\t')) {
+                    cols++;
+                }
             }
+            o = (Gua_Object *)Gua_Alloc(cols * sizeof(Gua_Object));
+            
+            cols = Matrix_ParseFields(p, eol, separator, blank, o, cols);
+            
+            if (cols > 0) {
+                m->object = (struct Gua_Object *)Gua_Alloc(rows * cols * sizeof(Gua_Object));
+                memcpy(m->object, o, cols * sizeof(Gua_Object));
+            }
+            Gua_Free(o);
+            
+            o = (Gua_Object *)m->object;
+        } else if (Matrix_ParseFields(p, eol, separator, blank, o + row * cols, cols) != cols) {
+            cols = -1;
         }
-
-        avg = sum / length;
-
-        Gua_RealToPObject(object, avg);
+        
+        if (cols < 0) {
+            Matrix_UnmapFile(buffer, size);
+            
+            if (m->object != NULL) {
+                Gua_Free(m->object);
+            }
+            Gua_Free(m->dimv);
+            Gua_Free(m);
+            
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %ld %s %-.20s...\n", "illegal data at line", line + 1, "of file", fileName);
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        row++;
+    }
+    
+    Matrix_UnmapFile(buffer, size);
+    
+    m->dimv[0] = rows;
+    m->dimv[1] = cols;
+    
+    if (!Gua_IsPObjectStored(object)) {
+        Gua_FreeObject(object);
+    } else {
+        Gua_ClearPObject(object);
     }
     
+    Gua_MatrixToPObject(object, (struct Gua_Matrix *)m, rows * cols);
+    
     return GUA_OK;
 }
 
@@ -1048,186 +1401,91 @@ Gua_Status Matrix_Avg(Gua_Object *a, Gua_Object *object, Gua_String error)
  *     C
  *
  * Function:
- *     Gua_Status Matrix_AvgCells(Gua_Object *a, Gua_Object x1, Gua_Object y1, Gua_Object x2, Gua_Object y2, Gua_Object *object, Gua_String error)
+ *     Gua_Status Matrix_SaveText(Gua_Object *a, Gua_String fileName, Gua_String separator, Gua_String error)
  *
  * Description:
- *     Calculate the average of specified cells in the matrix.
+ *     Save a numeric matrix to a delimited text file, one row per line.
+ *     Reals are written with 17 significant digits so they read back exactly.
  *
  * Arguments:
- *     a,         a matrix;
- *     x1,        row of the top left corner;
- *     y1,        column of the top left corner;
- *     x2,        row of the bottom right corner;
- *     y2,        column of the bottom right corner;
- *     object,    a structure containing the return object of the function;
- *     error,     a pointer to the error message.
+ *     a,            a matrix;
+ *     fileName,     the file name;
+ *     separator,    the string written between the fields;
+ *     error,        a pointer to the error message.
  *
  * Results:
- *     The function returns the average of specified cells in the matrix.
+ *     The function writes the matrix to the file.
  */
-Gua_Status Matrix_AvgCells(Gua_Object *a, Gua_Object x1, Gua_Object y1, Gua_Object x2, Gua_Object y2, Gua_Object *object, Gua_String error)
+Gua_Status Matrix_SaveText(Gua_Object *a, Gua_String fileName, Gua_String separator, Gua_String error)
 {
     Gua_Matrix *m;
     Gua_Object *o;
-    Gua_Integer i;
-    Gua_Integer j;
-    Gua_Real sum;
-    Gua_Real avg;
-    Gua_Integer n;
+    Gua_Length length;
+    Gua_Length cols;
+    Gua_Length i;
+    Gua_Short status;
+    FILE *fp;
     Gua_String errMessage;
     
-    if (Gua_PObjectType(a) != OBJECT_TYPE_MATRIX) {
+    m = (Gua_Matrix *)Gua_PObjectToMatrix(a);
+    o = (Gua_Object *)m->object;
+    length = Gua_PObjectLength(a);
+    
+    if (m->dimc > 2) {
         errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-        sprintf(errMessage, "%s...\n", "illegal argument");
+        sprintf(errMessage, "%s...\n", "only bidimensional matrices are supported");
         strcat(error, errMessage);
         Gua_Free(errMessage);
         
         return GUA_ERROR;
     }
     
-    m = (Gua_Matrix *)Gua_PObjectToMatrix(a);
-    
-    if (m) {
-        if(!Gua_IsPObjectStored(object)) {
-            Gua_FreeObject(object);
-        } else {
-            Gua_ClearPObject(object);
-        }
-
-        if (m->dimc != 2) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "only bidimensional matrices are supported");
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
-        }
-        if (Gua_ObjectToInteger(x1) < 0) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "index out of bound");
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
-        }
-        if (Gua_ObjectToInteger(y1) < 0) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "index out of bound");
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
-        }
-        if (Gua_ObjectToInteger(x2) > (m->dimv[0] - 1)) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "index out of bound");
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
-        }
-        if (Gua_ObjectToInteger(y2) > (m->dimv[1] - 1)) {
+    for (i = 0; i < length; i++) {
+        if ((Gua_ObjectType(o[i]) != OBJECT_TYPE_INTEGER) && (Gua_ObjectType(o[i]) != OBJECT_TYPE_REAL)) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "index out of bound");
+            sprintf(errMessage, "%s...\n", "only integer and real matrices can be saved as text");
             strcat(error, errMessage);
             Gua_Free(errMessage);
             
             return GUA_ERROR;
         }
-        
-        o = (Gua_Object *)m->object;
-        
-        sum = 0;
-        n = 0;
-
-        for (i = Gua_ObjectToInteger(x1); i <= Gua_ObjectToInteger(x2); i++) {
-            for (j = Gua_ObjectToInteger(y1); j <= Gua_ObjectToInteger(y2); j++) {
-                if (Gua_ObjectType(o[i * m->dimv[1] + j]) == OBJECT_TYPE_INTEGER) {
-                    sum = sum + Gua_ObjectToInteger(o[i * m->dimv[1] + j]);
-                    n++;
-                } else if (Gua_ObjectType(o[i * m->dimv[1] + j]) == OBJECT_TYPE_REAL) {
-                    sum = sum + Gua_ObjectToReal(o[i * m->dimv[1] + j]);
-                    n++;
-                }
-            }
-        }
-
-        avg = sum / n;
-
-        Gua_RealToPObject(object, avg);
     }
     
-    return GUA_OK;
-}
-
-/**
- * Group:
- *     C
- *
- * Function:
- *     Gua_Status Matrix_Count(Gua_Object *a, Gua_Object *object, Gua_String error)
- *
- * Description:
- *     Calculate the number of all cells in the matrix.
- *
- * Arguments:
- *     a,         a matrix;
- *     object,    a structure containing the return object of the function;
- *     error,     a pointer to the error message.
- *
- * Results:
- *     The function returns the number of all cells in the matrix.
- */
-Gua_Status Matrix_Count(Gua_Object *a, Gua_Object *object, Gua_String error)
-{
-    Gua_Matrix *m;
-    Gua_Object *o;
-    Gua_Length length;
-    Gua_Integer i;
-    Gua_Integer count;
-    Gua_String errMessage;
+    /* A vector is written as a column. */
+    cols = m->dimc == 2 ? m->dimv[1] : 1;
     
-    if (Gua_PObjectType(a) != OBJECT_TYPE_MATRIX) {
+    fp = fopen(fileName, "w");
+    
+    if (fp == NULL) {
         errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-        sprintf(errMessage, "%s...\n", "illegal argument");
+        sprintf(errMessage, "%s %-.20s...\n", "could not open file", fileName);
         strcat(error, errMessage);
         Gua_Free(errMessage);
         
         return GUA_ERROR;
     }
     
-    m = (Gua_Matrix *)Gua_PObjectToMatrix(a);
+    setvbuf(fp, NULL, _IOFBF, MATRIX_FILE_BUFFER_SIZE);
     
-    if (m) {
-        if(!Gua_IsPObjectStored(object)) {
-            Gua_FreeObject(object);
+    status = true;
+    for (i = 0; (i < length) && status; i++) {
+        if (Gua_ObjectType(o[i]) == OBJECT_TYPE_INTEGER) {
+            status = fprintf(fp, "%ld", Gua_ObjectToInteger(o[i])) > 0;
         } else {
-            Gua_ClearPObject(object);
+            status = fprintf(fp, "%.17g", Gua_ObjectToReal(o[i])) > 0;
         }
-        
-        o = (Gua_Object *)m->object;
-        
-        length = Gua_PObjectLength(a);
-        
-        count = 0;
-
-        for (i = 0; i < length; i++) {
-            if (Gua_ObjectType(o[i]) == OBJECT_TYPE_INTEGER) {
-				if (Gua_ObjectToInteger(o[i]) != 0) {
-                    count = count + 1;
-				}
-            } else if (Gua_ObjectType(o[i]) == OBJECT_TYPE_REAL) {
-				if (Gua_ObjectToReal(o[i]) != 0) {
-                    count = count + 1;
-				}
-            } else {
-				if (Gua_ObjectType(o[i]) != OBJECT_TYPE_UNKNOWN) {
-					count = count + 1;
-				}
-			}
+        if (status) {
+            status = fputs(((i + 1) % cols) == 0 ? "\n" : separator, fp) != EOF;
         }
-
-        Gua_IntegerToPObject(object, count);
+    }
+    
+    if ((fclose(fp) != 0) || !status) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "could not write file", fileName);
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
     }
     
     return GUA_OK;
@@ -1238,51 +1496,88 @@ Gua_Status Matrix_Count(Gua_Object *a, Gua_Object *object, Gua_String error)
  *     C
  *
  * Function:
- *     Gua_Status Matrix_CountCells(Gua_Object *a, Gua_Object x1, Gua_Object y1, Gua_Object x2, Gua_Object y2, Gua_Object *object, Gua_String error)
+ *     Gua_Status Matrix_Cross(Gua_Object *a, Gua_Object *b, Gua_Object *c, Gua_String error)
  *
  * Description:
- *     Calculate the number of specified cells in the matrix.
+ *     Calculate the cross product of two vectors a and b.
  *
  * Arguments:
- *     a,         a matrix;
- *     x1,        row of the top left corner;
- *     y1,        column of the top left corner;
- *     x2,        row of the bottom right corner;
- *     y2,        column of the bottom right corner;
- *     object,    a structure containing the return object of the function;
- *     error,     a pointer to the error message.
+ *     a,        vector a(an one row matrix);
+ *     b,        vector b(an one row matrix);
+ *     c,        a structure containing the return object of the function;
+ *     error,    a pointer to the error message.
  *
  * Results:
- *     The function returns the number of specified cells in the matrix.
+ *     The function returns the cross product of two vectors a and b.
  */
-Gua_Status Matrix_CountCells(Gua_Object *a, Gua_Object x1, Gua_Object y1, Gua_Object x2, Gua_Object y2, Gua_Object *object, Gua_String error)
+Gua_Status Matrix_Cross(Gua_Object *a, Gua_Object *b, Gua_Object *c, Gua_String error)
 {
-    Gua_Matrix *m;
-    Gua_Object *o;
+    Gua_Matrix *m1;
+    Gua_Matrix *m2;
+    Gua_Matrix *m3;
+    Gua_Object *o1;
+    Gua_Object *o2;
+    Gua_Object *v3;
+    Gua_Object u;
+    Gua_Object v;
     Gua_Integer i;
-    Gua_Integer j;
-    Gua_Integer count;
     Gua_String errMessage;
     
+    Gua_ClearObject(u);
+    Gua_ClearObject(v);
+
     if (Gua_PObjectType(a) != OBJECT_TYPE_MATRIX) {
         errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-        sprintf(errMessage, "%s...\n", "illegal argument");
+        sprintf(errMessage, "%s...\n", "illegal argument 1");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    if (Gua_PObjectType(b) != OBJECT_TYPE_MATRIX) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "illegal argument 2");
         strcat(error, errMessage);
         Gua_Free(errMessage);
         
         return GUA_ERROR;
     }
     
-    m = (Gua_Matrix *)Gua_PObjectToMatrix(a);
-    
-    if (m) {
-        if(!Gua_IsPObjectStored(object)) {
-            Gua_FreeObject(object);
+    m1 = (Gua_Matrix *)Gua_PObjectToMatrix(a);
+    m2 = (Gua_Matrix *)Gua_PObjectToMatrix(b);
+
+    if (m1 && m2) {
+        if(!Gua_IsPObjectStored(c)) {
+            Gua_FreeObject(c);
         } else {
-            Gua_ClearPObject(object);
+            Gua_ClearPObject(c);
         }
-
-        if (m->dimc != 2) {
+        
+        if (m1->dimc != m2->dimc) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "the matrices do not have compatible dimensions");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (m1->dimv[0] != m2->dimv[0]) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "the matrices do not have compatible dimensions");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (m1->dimv[1] != m2->dimv[1]) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "the matrices do not have compatible dimensions");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (m1->dimc != 2) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
             sprintf(errMessage, "%s...\n", "only bidimensional matrices are supported");
             strcat(error, errMessage);
@@ -1290,64 +1585,100 @@ Gua_Status Matrix_CountCells(Gua_Object *a, Gua_Object x1, Gua_Object y1, Gua_Ob
             
             return GUA_ERROR;
         }
-        if (Gua_ObjectToInteger(x1) < 0) {
+        if (m2->dimc != 2) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "index out of bound");
+            sprintf(errMessage, "%s...\n", "only bidimensional matrices are supported");
             strcat(error, errMessage);
             Gua_Free(errMessage);
             
             return GUA_ERROR;
         }
-        if (Gua_ObjectToInteger(y1) < 0) {
+        if ((m1->dimv[0] != 1) || (m2->dimv[0] != 1)) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "index out of bound");
+            sprintf(errMessage, "%s...\n", "only 1x2 or 1x3 matrices are supported");
             strcat(error, errMessage);
             Gua_Free(errMessage);
             
             return GUA_ERROR;
         }
-        if (Gua_ObjectToInteger(x2) > (m->dimv[0] - 1)) {
+        if ((m1->dimv[1] < 2) || (m1->dimv[1] > 3)) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "index out of bound");
+            sprintf(errMessage, "%s...\n", "only 1x2 or 1x3 matrices are supported");
             strcat(error, errMessage);
             Gua_Free(errMessage);
             
             return GUA_ERROR;
         }
-        if (Gua_ObjectToInteger(y2) > (m->dimv[1] - 1)) {
+        if ((m2->dimv[1] < 2) || (m2->dimv[1] > 3)) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "index out of bound");
+            sprintf(errMessage, "%s...\n", "only 1x2 or 1x3 matrices are supported");
             strcat(error, errMessage);
             Gua_Free(errMessage);
             
             return GUA_ERROR;
         }
         
-        o = (Gua_Object *)m->object;
+        /* We will work with copies, to not change the original matrices. */
+        Gua_CopyMatrix(&u, a, false);
+        Gua_CopyMatrix(&v, b, false);
         
-        count = 0;
-
-        for (i = Gua_ObjectToInteger(x1); i <= Gua_ObjectToInteger(x2); i++) {
-            for (j = Gua_ObjectToInteger(y1); j <= Gua_ObjectToInteger(y2); j++) {
-				if (Gua_ObjectType(o[i * m->dimv[1] + j]) == OBJECT_TYPE_INTEGER) {
-					if (Gua_ObjectToInteger(o[i * m->dimv[1] + j]) != 0) {
-	                    count = count + 1;
-					}
-	            } else if (Gua_ObjectType(o[i * m->dimv[1] + j]) == OBJECT_TYPE_REAL) {
-					if (Gua_ObjectToReal(o[i * m->dimv[1] + j]) != 0) {
-	                    count = count + 1;
-					}
-	            } else {
-					if (Gua_ObjectType(o[i * m->dimv[1] + j]) != OBJECT_TYPE_UNKNOWN) {
-						count = count + 1;
-					}
-				}
-            }
-        }
-
-        Gua_IntegerToPObject(object, count);
-    }
-    
+        m1 = (Gua_Matrix *)Gua_ObjectToMatrix(u);
+        o1 = (Gua_Object *)m1->object;
+        
+        m2 = (Gua_Matrix *)Gua_ObjectToMatrix(v);
+        o2 = (Gua_Object *)m2->object;
+        
+        /* Convert the matrices to real. */
+        for (i = 0; i < Gua_ObjectLength(u); i++) {
+            if (Gua_ObjectType(o1[i]) == OBJECT_TYPE_INTEGER) {
+                Gua_ConvertIntegerObjectToReal(o1[i]);
+            } else {
+                if (Gua_ObjectType(o1[i]) != OBJECT_TYPE_REAL) {
+                    Gua_FreeObject(&o1[i]);
+                    Gua_RealToObject(o1[i], 0.0);
+                }
+            }
+        }
+        for (i = 0; i < Gua_ObjectLength(v); i++) {
+            if (Gua_ObjectType(o2[i]) == OBJECT_TYPE_INTEGER) {
+                Gua_ConvertIntegerObjectToReal(o2[i]);
+            } else {
+                if (Gua_ObjectType(o2[i]) != OBJECT_TYPE_REAL) {
+                    Gua_FreeObject(&o2[i]);
+                    Gua_RealToObject(o2[i], 0.0);
+                }
+            }
+        }
+        
+        
+        /* Create the result matrix. */
+        Gua_MatrixToPObject(c, (struct Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix)), Gua_PObjectLength(a));
+        m3 = (Gua_Matrix *)Gua_PObjectToMatrix(c);
+        
+        m3->dimc = m1->dimc;
+        m3->dimv = Gua_Alloc(m1->dimc * sizeof(long));
+        
+        for (i = 0; i < m1->dimc; i++) {
+            m3->dimv[i] = m1->dimv[i];
+        }
+        
+        m3->object = (struct Gua_Object *)Gua_Alloc(Gua_PObjectLength(a) * sizeof(Gua_Object));
+        v3 = (Gua_Object *)m3->object;
+        
+        /* This release only supports real numbers. */
+        if (m1->dimv[1] == 2) {
+            Gua_RealToObject(v3[0], (Gua_ObjectToReal(o1[0]) * Gua_ObjectToReal(o2[1])));
+            Gua_RealToObject(v3[1], (-Gua_ObjectToReal(o1[1]) * Gua_ObjectToReal(o2[0])));
+        } else {
+            Gua_RealToObject(v3[0], (Gua_ObjectToReal(o1[1]) * Gua_ObjectToReal(o2[2]) - Gua_ObjectToReal(o2[1]) * Gua_ObjectToReal(o1[2])));
+            Gua_RealToObject(v3[1], (Gua_ObjectToReal(o1[2]) * Gua_ObjectToReal(o2[0]) - Gua_ObjectToReal(o2[2]) * Gua_ObjectToReal(o1[0])));
+            Gua_RealToObject(v3[2], (Gua_ObjectToReal(o1[0]) * Gua_ObjectToReal(o2[1]) - Gua_ObjectToReal(o2[0]) * Gua_ObjectToReal(o1[1])));
+        }
+                
+        Gua_FreeObject(&u);
+        Gua_FreeObject(&v);
+    }
+    
     return GUA_OK;
 }
 
@@ -1356,58 +1687,86 @@ Gua_Status Matrix_CountCells(Gua_Object *a, Gua_Object x1, Gua_Object y1, Gua_Ob
  *     C
  *
  * Function:
- *     Gua_Status Matrix_DelRow(Gua_Object *source, Gua_Integer n, Gua_Object *object, Gua_String error)
+ *     Gua_Status Matrix_Dot(Gua_Object *a, Gua_Object *b, Gua_Object *c, Gua_String error)
  *
  * Description:
- *     Copy a matrix to other deleting the specified row.
+ *     Calculate the dot product of two vectors a and b.
  *
  * Arguments:
- *     source,    the source matrix;
- *     n,         the row number;
- *     object,    a structure containing the return object of the function;
- *     error,     a pointer to the error message.
+ *     a,        vector a(an one row matrix);
+ *     b,        vector b(an one row matrix);
+ *     c,        a structure containing the return object of the function;
+ *     error,    a pointer to the error message.
  *
  * Results:
- *     The function makes a copy of a matrix to other deleting the specified row.
+ *     The function returns the dot product of two vectors a and b.
  */
-Gua_Status Matrix_DelRow(Gua_Object *source, Gua_Object n, Gua_Object *object, Gua_String error)
+Gua_Status Matrix_Dot(Gua_Object *a, Gua_Object *b, Gua_Object *c, Gua_String error)
 {
-    Gua_Matrix *mt;
-    Gua_Matrix *ms;
-    Gua_Object *ot;
-    Gua_Object *os;
+    Gua_Matrix *m1;
+    Gua_Matrix *m2;
+    Gua_Object *o1;
+    Gua_Object *o2;
+    Gua_Object u;
+    Gua_Object v;
     Gua_Integer i;
-    Gua_Integer j;
-    Gua_Integer k;
     Gua_String errMessage;
     
-    if (Gua_PObjectType(source) != OBJECT_TYPE_MATRIX) {
+    Gua_ClearObject(u);
+    Gua_ClearObject(v);
+
+    if (Gua_PObjectType(a) != OBJECT_TYPE_MATRIX) {
         errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-        sprintf(errMessage, "%s...\n", "illegal argument");
+        sprintf(errMessage, "%s...\n", "illegal argument 1");
         strcat(error, errMessage);
         Gua_Free(errMessage);
         
         return GUA_ERROR;
     }
-    if (Gua_ObjectType(n) != OBJECT_TYPE_INTEGER) {
+    if (Gua_PObjectType(b) != OBJECT_TYPE_MATRIX) {
         errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-        sprintf(errMessage, "%s...\n", "illegal argument");
+        sprintf(errMessage, "%s...\n", "illegal argument 2");
         strcat(error, errMessage);
         Gua_Free(errMessage);
         
         return GUA_ERROR;
     }
     
-    ms = (Gua_Matrix *)Gua_PObjectToMatrix(source);
+    m1 = (Gua_Matrix *)Gua_PObjectToMatrix(a);
+    m2 = (Gua_Matrix *)Gua_PObjectToMatrix(b);
     
-    if (ms) {
-        if(!Gua_IsPObjectStored(object)) {
-            Gua_FreeObject(object);
+    if (m1 && m2) {
+        if(!Gua_IsPObjectStored(c)) {
+            Gua_FreeObject(c);
         } else {
-            Gua_ClearPObject(object);
+            Gua_ClearPObject(c);
         }
-
-        if (ms->dimc > 2) {
+        
+        if (m1->dimc != m2->dimc) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "the matrices do not have compatible dimensions");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (m1->dimv[0] != m2->dimv[0]) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "the matrices do not have compatible dimensions");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (m1->dimv[1] != m2->dimv[1]) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "the matrices do not have compatible dimensions");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (m1->dimc != 2) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
             sprintf(errMessage, "%s...\n", "only bidimensional matrices are supported");
             strcat(error, errMessage);
@@ -1415,50 +1774,83 @@ Gua_Status Matrix_DelRow(Gua_Object *source, Gua_Object n, Gua_Object *object, G
             
             return GUA_ERROR;
         }
-
-        if ((Gua_ObjectToInteger(n) < 0) || (Gua_ObjectToInteger(n) > (ms->dimv[0] - 1))) {
+        if (m2->dimc != 2) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "index out of bound");
+            sprintf(errMessage, "%s...\n", "only bidimensional matrices are supported");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if ((m1->dimv[0] != 1) || (m2->dimv[0] != 1)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "only 1x2 or 1x3 matrices are supported");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if ((m1->dimv[1] < 2) || (m1->dimv[1] > 3)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "only 1x2 or 1x3 matrices are supported");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if ((m2->dimv[1] < 2) || (m2->dimv[1] > 3)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "only 1x2 or 1x3 matrices are supported");
             strcat(error, errMessage);
             Gua_Free(errMessage);
             
             return GUA_ERROR;
         }
         
-        os = (Gua_Object *)ms->object;
-        
-        mt = (Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix));
-        
-        mt->dimc = ms->dimc;
-        mt->dimv = Gua_Alloc(mt->dimc * sizeof(Gua_Integer));
+        /* We will work with copies, to not change the original matrices. */
+        Gua_CopyMatrix(&u, a, false);
+        Gua_CopyMatrix(&v, b, false);
         
-        mt->dimv[0] = ms->dimv[0] - 1;
-        mt->dimv[1] = ms->dimv[1];
+        m1 = (Gua_Matrix *)Gua_ObjectToMatrix(u);
+        o1 = (Gua_Object *)m1->object;
         
-        mt->object = (struct Gua_Object *)Gua_Alloc((Gua_PObjectLength(source) - ms->dimv[1]) * sizeof(Gua_Object));
-        ot = (Gua_Object *)mt->object;
+        m2 = (Gua_Matrix *)Gua_ObjectToMatrix(v);
+        o2 = (Gua_Object *)m2->object;
         
-        k = 0;
-        for (i = 0; i < ms->dimv[0]; i++) {
-            if (i != Gua_ObjectToInteger(n)) {
-                for (j = 0; j < ms->dimv[1]; j++) {
-                    if (Gua_ObjectType(os[i * ms->dimv[1] + j]) == OBJECT_TYPE_STRING) {
-                        Gua_ByteArrayToObject(ot[k * mt->dimv[1] + j], Gua_ObjectToString(os[i * ms->dimv[1] + j]), Gua_ObjectLength(os[i * ms->dimv[1] + j]));
-                    } else {
-                        Gua_LinkObjects(ot[k * mt->dimv[1] + j], os[i * ms->dimv[1] + j]);
-                    }
+        /* Convert the matrices to real. */
+        for (i = 0; i < Gua_ObjectLength(u); i++) {
+            if (Gua_ObjectType(o1[i]) == OBJECT_TYPE_INTEGER) {
+                Gua_ConvertIntegerObjectToReal(o1[i]);
+            } else {
+                if (Gua_ObjectType(o1[i]) != OBJECT_TYPE_REAL) {
+                    Gua_FreeObject(&o1[i]);
+                    Gua_RealToObject(o1[i], 0.0);
+                }
+            }
+        }
+        for (i = 0; i < Gua_ObjectLength(v); i++) {
+            if (Gua_ObjectType(o2[i]) == OBJECT_TYPE_INTEGER) {
+                Gua_ConvertIntegerObjectToReal(o2[i]);
+            } else {
+                if (Gua_ObjectType(o2[i]) != OBJECT_TYPE_REAL) {
+                    Gua_FreeObject(&o2[i]);
+                    Gua_RealToObject(o2[i], 0.0);
                 }
-                k++;
             }
         }
         
-        /* Fix the target matrix fields. */
-        Gua_MatrixToPObject(object, (struct Gua_Matrix *)mt, (Gua_PObjectLength(source) - ms->dimv[1]));
+        /* This release only supports real numbers. */
+        if (m1->dimv[1] == 2) {
+            Gua_RealToPObject(c, (Gua_ObjectToReal(o1[0]) * Gua_ObjectToReal(o2[0]) + Gua_ObjectToReal(o1[1]) * Gua_ObjectToReal(o2[1])));
+        } else {
+            Gua_RealToPObject(c, (Gua_ObjectToReal(o1[0]) * Gua_ObjectToReal(o2[0]) + Gua_ObjectToReal(o1[1]) * Gua_ObjectToReal(o2[1]) + Gua_ObjectToReal(o1[2]) * Gua_ObjectToReal(o2[2])));
+        }
         
-        return GUA_OK;
+        Gua_FreeObject(&u);
+        Gua_FreeObject(&v);
     }
     
-    return GUA_ERROR;
+    return GUA_OK;
 }
 
 /**
@@ -1466,109 +1858,22 @@ Gua_Status Matrix_DelRow(Gua_Object *source, Gua_Object n, Gua_Object *object, G
  *     C
  *
  * Function:
- *     Gua_Status Matrix_DelCol(Gua_Object *source, Gua_Integer n, Gua_Object *object, Gua_String error)
+ *     Gua_Status Matrix_Sum(Gua_Object *a, Gua_Object *object, Gua_String error)
  *
  * Description:
- *     Copy a matrix to other deleting the specified Column.
+ *     Calculate the sum of all cells in the matrix.
  *
  * Arguments:
- *     source,    the source matrix;
- *     n,         the column number;
+ *     a,         a matrix;
  *     object,    a structure containing the return object of the function;
  *     error,     a pointer to the error message.
  *
  * Results:
- *     The function makes a copy of a matrix to other deleting the specified Column.
+ *     The function returns the sum of all cells in the matrix.
  */
-Gua_Status Matrix_DelCol(Gua_Object *source, Gua_Object n, Gua_Object *object, Gua_String error)
+Gua_Status Matrix_Sum(Gua_Object *a, Gua_Object *object, Gua_String error)
 {
-    Gua_Matrix *mt;
-    Gua_Matrix *ms;
-    Gua_Object *ot;
-    Gua_Object *os;
-    Gua_Integer i;
-    Gua_Integer j;
-    Gua_Integer k;
-    Gua_String errMessage;
-    
-    if (Gua_PObjectType(source) != OBJECT_TYPE_MATRIX) {
-        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-        sprintf(errMessage, "%s...\n", "illegal argument");
-        strcat(error, errMessage);
-        Gua_Free(errMessage);
-        
-        return GUA_ERROR;
-    }
-    if (Gua_ObjectType(n) != OBJECT_TYPE_INTEGER) {
-        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-        sprintf(errMessage, "%s...\n", "illegal argument");
-        strcat(error, errMessage);
-        Gua_Free(errMessage);
-        
-        return GUA_ERROR;
-    }
-    
-    ms = (Gua_Matrix *)Gua_PObjectToMatrix(source);
-    
-    if (ms) {
-        if(!Gua_IsPObjectStored(object)) {
-            Gua_FreeObject(object);
-        } else {
-            Gua_ClearPObject(object);
-        }
-
-        if (ms->dimc > 2) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "only bidimensional matrices are supported");
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
-        }
-
-        if ((Gua_ObjectToInteger(n) < 0) || (Gua_ObjectToInteger(n) > (ms->dimv[1] - 1))) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "index out of bound");
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
-        }
-        
-        os = (Gua_Object *)ms->object;
-        
-        mt = (Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix));
-        
-        mt->dimc = ms->dimc;
-        mt->dimv = Gua_Alloc(mt->dimc * sizeof(Gua_Integer));
-        
-        mt->dimv[0] = ms->dimv[0];
-        mt->dimv[1] = ms->dimv[1] - 1;
-        
-        mt->object = (struct Gua_Object *)Gua_Alloc((Gua_PObjectLength(source) - ms->dimv[0]) * sizeof(Gua_Object));
-        ot = (Gua_Object *)mt->object;
-        
-        k = 0;
-        for (j = 0; j < ms->dimv[1]; j++) {
-            if (j != Gua_ObjectToInteger(n)) {
-                for (i = 0; i < ms->dimv[0]; i++) {
-                    if (Gua_ObjectType(os[i * ms->dimv[1] + j]) == OBJECT_TYPE_STRING) {
-                        Gua_ByteArrayToObject(ot[i * mt->dimv[1] + k], Gua_ObjectToString(os[i * ms->dimv[1] + j]), Gua_ObjectLength(os[i * ms->dimv[1] + j]));
-                    } else {
-                        Gua_LinkObjects(ot[i * mt->dimv[1] + k], os[i * ms->dimv[1] + j]);
-                    }
-                }
-                k++;
-            }
-        }
-        
-        /* Fix the target matrix fields. */
-        Gua_MatrixToPObject(object, (struct Gua_Matrix *)mt, (Gua_PObjectLength(source) - ms->dimv[0]));
-        
-        return GUA_OK;
-    }
-    
-    return GUA_ERROR;
+    return Matrix_Reduce(a, MATRIX_REDUCE_SUM, -1, object, error);
 }
 
 /**
@@ -1576,10 +1881,10 @@ Gua_Status Matrix_DelCol(Gua_Object *source, Gua_Object n, Gua_Object *object, G
  *     C
  *
  * Function:
- *     Gua_Status Matrix_Min(Gua_Object *a, Gua_Object *object, Gua_String error)
+ *     Gua_Status Matrix_Sum2(Gua_Object *a, Gua_Object *object, Gua_String error)
  *
  * Description:
- *     Calculate the min object of all cells in the matrix.
+ *     Calculate the squared sum of all cells in the matrix.
  *
  * Arguments:
  *     a,         a matrix;
@@ -1587,65 +1892,11 @@ Gua_Status Matrix_DelCol(Gua_Object *source, Gua_Object n, Gua_Object *object, G
  *     error,     a pointer to the error message.
  *
  * Results:
- *     The function returns the min object of all cells in the matrix.
+ *     The function returns the squared sum of all cells in the matrix.
  */
-Gua_Status Matrix_Min(Gua_Object *a, Gua_Object *object, Gua_String error)
+Gua_Status Matrix_Sum2(Gua_Object *a, Gua_Object *object, Gua_String error)
 {
-    Gua_Matrix *m;
-    Gua_Object *o;
-    Gua_Length length;
-    Gua_Integer i;
-    Gua_Real min;
-    Gua_String errMessage;
-    
-    if (Gua_PObjectType(a) != OBJECT_TYPE_MATRIX) {
-        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-        sprintf(errMessage, "%s...\n", "illegal argument");
-        strcat(error, errMessage);
-        Gua_Free(errMessage);
-        
-        return GUA_ERROR;
-    }
-    
-    m = (Gua_Matrix *)Gua_PObjectToMatrix(a);
-    
-    if (m) {
-        if(!Gua_IsPObjectStored(object)) {
-            Gua_FreeObject(object);
-        } else {
-            Gua_ClearPObject(object);
-        }
-        
-        o = (Gua_Object *)m->object;
-        
-        length = Gua_PObjectLength(a);
-        
-        min = 0;
-        
-        for (i = 0; i < length; i++) {
-            if (i == 0) {
-                if (Gua_ObjectType(o[i]) == OBJECT_TYPE_INTEGER) {
-                    min = Gua_ObjectToInteger(o[i]);
-                } else if (Gua_ObjectType(o[i]) == OBJECT_TYPE_REAL) {
-                    min = Gua_ObjectToReal(o[i]);
-                }
-            } else {
-                if (Gua_ObjectType(o[i]) == OBJECT_TYPE_INTEGER) {
-                    if (min > Gua_ObjectToInteger(o[i])) {
-                        min = Gua_ObjectToInteger(o[i]);
-                    }
-                } else if (Gua_ObjectType(o[i]) == OBJECT_TYPE_REAL) {
-                    if (min > Gua_ObjectToReal(o[i])) {
-                        min = Gua_ObjectToReal(o[i]);
-                    }
-                }
-            }
-        }
-        
-        Gua_RealToPObject(object, min);
-    }
-    
-    return GUA_OK;
+    return Matrix_Reduce(a, MATRIX_REDUCE_SUM2, -1, object, error);
 }
 
 /**
@@ -1653,10 +1904,10 @@ Gua_Status Matrix_Min(Gua_Object *a, Gua_Object *object, Gua_String error)
  *     C
  *
  * Function:
- *     Gua_Status Matrix_MinCells(Gua_Object *a, Gua_Object x1, Gua_Object y1, Gua_Object x2, Gua_Object y2, Gua_Object *object, Gua_String error)
+ *     Gua_Status Matrix_SumCells(Gua_Object *a, Gua_Object x1, Gua_Object y1, Gua_Object x2, Gua_Object y2, Gua_Object *object, Gua_String error)
  *
  * Description:
- *     Calculate the min of specified cells in the matrix.
+ *     Calculate the sum of specified cells in the matrix.
  *
  * Arguments:
  *     a,         a matrix;
@@ -1668,15 +1919,15 @@ Gua_Status Matrix_Min(Gua_Object *a, Gua_Object *object, Gua_String error)
  *     error,     a pointer to the error message.
  *
  * Results:
- *     The function returns the min of specified cells in the matrix.
+ *     The function returns the sum of specified cells in the matrix.
  */
-Gua_Status Matrix_MinCells(Gua_Object *a, Gua_Object x1, Gua_Object y1, Gua_Object x2, Gua_Object y2, Gua_Object *object, Gua_String error)
+Gua_Status Matrix_SumCells(Gua_Object *a, Gua_Object x1, Gua_Object y1, Gua_Object x2, Gua_Object y2, Gua_Object *object, Gua_String error)
 {
     Gua_Matrix *m;
     Gua_Object *o;
     Gua_Integer i;
     Gua_Integer j;
-    Gua_Real min;
+    Gua_Real sum;
     Gua_String errMessage;
     
     if (Gua_PObjectType(a) != OBJECT_TYPE_MATRIX) {
@@ -1740,31 +1991,19 @@ Gua_Status Matrix_MinCells(Gua_Object *a, Gua_Object x1, Gua_Object y1, Gua_Obje
         
         o = (Gua_Object *)m->object;
         
-        min = 0;
-        
+        sum = 0;
+
         for (i = Gua_ObjectToInteger(x1); i <= Gua_ObjectToInteger(x2); i++) {
             for (j = Gua_ObjectToInteger(y1); j <= Gua_ObjectToInteger(y2); j++) {
-                if ((i == Gua_ObjectToInteger(x1)) && (j == Gua_ObjectToInteger(y2))) {
-                    if (Gua_ObjectType(o[i * m->dimv[1] + j]) == OBJECT_TYPE_INTEGER) {
-                        min = Gua_ObjectToInteger(o[i * m->dimv[1] + j]);
-                    } else if (Gua_ObjectType(o[i * m->dimv[1] + j]) == OBJECT_TYPE_REAL) {
-                        min = Gua_ObjectToReal(o[i * m->dimv[1] + j]);
-                    }
-                } else {
-                    if (Gua_ObjectType(o[i * m->dimv[1] + j]) == OBJECT_TYPE_INTEGER) {
-                        if (min > Gua_ObjectToInteger(o[i * m->dimv[1] + j])) {
-                            min = Gua_ObjectToInteger(o[i * m->dimv[1] + j]);
-                        }
-                    } else if (Gua_ObjectType(o[i * m->dimv[1] + j]) == OBJECT_TYPE_REAL) {
-                        if (min > Gua_ObjectToReal(o[i * m->dimv[1] + j])) {
-                            min = Gua_ObjectToReal(o[i * m->dimv[1] + j]);
-                        }
-                    }
+                if (Gua_ObjectType(o[i * m->dimv[1] + j]) == OBJECT_TYPE_INTEGER) {
+                    sum = sum + Gua_ObjectToInteger(o[i * m->dimv[1] + j]);
+                } else if (Gua_ObjectType(o[i * m->dimv[1] + j]) == OBJECT_TYPE_REAL) {
+                    sum = sum + Gua_ObjectToReal(o[i * m->dimv[1] + j]);
                 }
             }
         }
-        
-        Gua_RealToPObject(object, min);
+
+        Gua_RealToPObject(object, sum);
     }
     
     return GUA_OK;
@@ -1775,10 +2014,10 @@ Gua_Status Matrix_MinCells(Gua_Object *a, Gua_Object x1, Gua_Object y1, Gua_Obje
  *     C
  *
  * Function:
- *     Gua_Status Matrix_Max(Gua_Object *a, Gua_Object *object, Gua_String error)
+ *     Gua_Status Matrix_Avg(Gua_Object *a, Gua_Object *object, Gua_String error)
  *
  * Description:
- *     Calculate the max object of all cells in the matrix.
+ *     Calculate the average of all cells in the matrix.
  *
  * Arguments:
  *     a,         a matrix;
@@ -1786,57 +2025,11 @@ Gua_Status Matrix_MinCells(Gua_Object *a, Gua_Object x1, Gua_Object y1, Gua_Obje
  *     error,     a pointer to the error message.
  *
  * Results:
- *     The function returns the max object of all cells in the matrix.
+ *     The function returns the average of all cells in the matrix.
  */
-Gua_Status Matrix_Max(Gua_Object *a, Gua_Object *object, Gua_String error)
+Gua_Status Matrix_Avg(Gua_Object *a, Gua_Object *object, Gua_String error)
 {
-    Gua_Matrix *m;
-    Gua_Object *o;
-    Gua_Length length;
-    Gua_Integer i;
-    Gua_Real max;
-    Gua_String errMessage;
-    
-    if (Gua_PObjectType(a) != OBJECT_TYPE_MATRIX) {
-        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-        sprintf(errMessage, "%s...\n", "illegal argument");
-        strcat(error, errMessage);
-        Gua_Free(errMessage);
-        
-        return GUA_ERROR;
-    }
-    
-    m = (Gua_Matrix *)Gua_PObjectToMatrix(a);
-    
-    if (m) {
-        if(!Gua_IsPObjectStored(object)) {
-            Gua_FreeObject(object);
-        } else {
-            Gua_ClearPObject(object);
-        }
-        
-        o = (Gua_Object *)m->object;
-        
-        length = Gua_PObjectLength(a);
-
-        max = 0;
-
-        for (i = 0; i < length; i++) {
-            if (Gua_ObjectType(o[i]) == OBJECT_TYPE_INTEGER) {
-                if (max < Gua_ObjectToInteger(o[i])) {
-                    max = Gua_ObjectToInteger(o[i]);
-                }
-            } else if (Gua_ObjectType(o[i]) == OBJECT_TYPE_REAL) {
-                if (max < Gua_ObjectToReal(o[i])) {
-                    max = Gua_ObjectToReal(o[i]);
-                }
-            }
-        }
-
-        Gua_RealToPObject(object, max);
-    }
-    
-    return GUA_OK;
+    return Matrix_Reduce(a, MATRIX_REDUCE_AVG, -1, object, error);
 }
 
 /**
@@ -1844,10 +2037,10 @@ Gua_Status Matrix_Max(Gua_Object *a, Gua_Object *object, Gua_String error)
  *     C
  *
  * Function:
- *     Gua_Status Matrix_MaxCells(Gua_Object *a, Gua_Object x1, Gua_Object y1, Gua_Object x2, Gua_Object y2, Gua_Object *object, Gua_String error)
+ *     Gua_Status Matrix_AvgCells(Gua_Object *a, Gua_Object x1, Gua_Object y1, Gua_Object x2, Gua_Object y2, Gua_Object *object, Gua_String error)
  *
  * Description:
- *     Calculate the max of specified cells in the matrix.
+ *     Calculate the average of specified cells in the matrix.
  *
  * Arguments:
  *     a,         a matrix;
@@ -1859,15 +2052,17 @@ Gua_Status Matrix_Max(Gua_Object *a, Gua_Object *object, Gua_String error)
  *     error,     a pointer to the error message.
  *
  * Results:
- *     The function returns the max of specified cells in the matrix.
+ *     The function returns the average of specified cells in the matrix.
  */
-Gua_Status Matrix_MaxCells(Gua_Object *a, Gua_Object x1, Gua_Object y1, Gua_Object x2, Gua_Object y2, Gua_Object *object, Gua_String error)
+Gua_Status Matrix_AvgCells(Gua_Object *a, Gua_Object x1, Gua_Object y1, Gua_Object x2, Gua_Object y2, Gua_Object *object, Gua_String error)
 {
     Gua_Matrix *m;
     Gua_Object *o;
     Gua_Integer i;
     Gua_Integer j;
-    Gua_Real max;
+    Gua_Real sum;
+    Gua_Real avg;
+    Gua_Integer n;
     Gua_String errMessage;
     
     if (Gua_PObjectType(a) != OBJECT_TYPE_MATRIX) {
@@ -1931,23 +2126,24 @@ Gua_Status Matrix_MaxCells(Gua_Object *a, Gua_Object x1, Gua_Object y1, Gua_Obje
         
         o = (Gua_Object *)m->object;
         
-        max = 0;
-        
+        sum = 0;
+        n = 0;
+
         for (i = Gua_ObjectToInteger(x1); i <= Gua_ObjectToInteger(x2); i++) {
             for (j = Gua_ObjectToInteger(y1); j <= Gua_ObjectToInteger(y2); j++) {
                 if (Gua_ObjectType(o[i * m->dimv[1] + j]) == OBJECT_TYPE_INTEGER) {
-                    if (max < Gua_ObjectToInteger(o[i * m->dimv[1] + j])) {
-                        max = Gua_ObjectToInteger(o[i * m->dimv[1] + j]);
-                    }
+                    sum = sum + Gua_ObjectToInteger(o[i * m->dimv[1] + j]);
+                    n++;
                 } else if (Gua_ObjectType(o[i * m->dimv[1] + j]) == OBJECT_TYPE_REAL) {
-                    if (max < Gua_ObjectToReal(o[i * m->dimv[1] + j])) {
-                        max = Gua_ObjectToReal(o[i * m->dimv[1] + j]);
-                    }
+                    sum = sum + Gua_ObjectToReal(o[i * m->dimv[1] + j]);
+                    n++;
                 }
             }
         }
-        
-        Gua_RealToPObject(object, max);
+
+        avg = sum / n;
+
+        Gua_RealToPObject(object, avg);
     }
     
     return GUA_OK;
@@ -1958,44 +2154,2733 @@ Gua_Status Matrix_MaxCells(Gua_Object *a, Gua_Object x1, Gua_Object y1, Gua_Obje
  *     C
  *
  * Function:
- *     Gua_Status Matrix_MatrixFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object *argv, Gua_Object *object, Gua_String error)
+ *     Gua_Status Matrix_Count(Gua_Object *a, Gua_Object *object, Gua_String error)
  *
  * Description:
- *     Matrix functions wrapper.
+ *     Calculate the number of all cells in the matrix.
  *
  * Arguments:
- *     nspace,    a pointer to a structure Gua_Namespace. Must do a cast before use it;
- *     argc,      the number of arguments to pass to the function;
- *     argv,      an array containing the arguments to the function;
- *                argv[0] is the function name;
+ *     a,         a matrix;
  *     object,    a structure containing the return object of the function;
  *     error,     a pointer to the error message.
  *
  * Results:
- *     The return object of the wrapped funcion.
+ *     The function returns the number of all cells in the matrix.
  */
-Gua_Status Matrix_MatrixFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object *argv, Gua_Object *object, Gua_String error)
+Gua_Status Matrix_Count(Gua_Object *a, Gua_Object *object, Gua_String error)
 {
     Gua_Matrix *m;
     Gua_Object *o;
     Gua_Length length;
     Gua_Integer i;
+    Gua_Integer count;
+    Gua_String errMessage;
+    
+    if (Gua_PObjectType(a) != OBJECT_TYPE_MATRIX) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "illegal argument");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    m = (Gua_Matrix *)Gua_PObjectToMatrix(a);
+    
+    if (m) {
+        if(!Gua_IsPObjectStored(object)) {
+            Gua_FreeObject(object);
+        } else {
+            Gua_ClearPObject(object);
+        }
+        
+        o = (Gua_Object *)m->object;
+        
+        length = Gua_PObjectLength(a);
+        
+        count = 0;
+
+        for (i = 0; i < length; i++) {
+            if (Gua_ObjectType(o[i]) == OBJECT_TYPE_INTEGER) {
+				if (Gua_ObjectToInteger(o[i]) != 0) {
+                    count = count + 1;
+				}
+            } else if (Gua_ObjectType(o[i]) == OBJECT_TYPE_REAL) {
+				if (Gua_ObjectToReal(o[i]) != 0) {
+                    count = count + 1;
+				}
+            } else {
+				if (Gua_ObjectType(o[i]) != OBJECT_TYPE_UNKNOWN) {
+					count = count + 1;
+				}
+			}
+        }
+
+        Gua_IntegerToPObject(object, count);
+    }
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Matrix_CountCells(Gua_Object *a, Gua_Object x1, Gua_Object y1, Gua_Object x2, Gua_Object y2, Gua_Object *object, Gua_String error)
+ *
+ * Description:
+ *     Calculate the number of specified cells in the matrix.
+ *
+ * Arguments:
+ *     a,         a matrix;
+ *     x1,        row of the top left corner;
+ *     y1,        column of the top left corner;
+ *     x2,        row of the bottom right corner;
+ *     y2,        column of the bottom right corner;
+ *     object,    a structure containing the return object of the function;
+ *     error,     a pointer to the error message.
+ *
+ * Results:
+ *     The function returns the number of specified cells in the matrix.
+ */
+Gua_Status Matrix_CountCells(Gua_Object *a, Gua_Object x1, Gua_Object y1, Gua_Object x2, Gua_Object y2, Gua_Object *object, Gua_String error)
+{
+    Gua_Matrix *m;
+    Gua_Object *o;
+    Gua_Integer i;
     Gua_Integer j;
+    Gua_Integer count;
     Gua_String errMessage;
     
-    Gua_ClearPObject(object);
+    if (Gua_PObjectType(a) != OBJECT_TYPE_MATRIX) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "illegal argument");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    m = (Gua_Matrix *)Gua_PObjectToMatrix(a);
+    
+    if (m) {
+        if(!Gua_IsPObjectStored(object)) {
+            Gua_FreeObject(object);
+        } else {
+            Gua_ClearPObject(object);
+        }
 
-    if (argc == 0) {
+        if (m->dimc != 2) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "only bidimensional matrices are supported");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (Gua_ObjectToInteger(x1) < 0) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "index out of bound");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (Gua_ObjectToInteger(y1) < 0) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "index out of bound");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (Gua_ObjectToInteger(x2) > (m->dimv[0] - 1)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "index out of bound");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (Gua_ObjectToInteger(y2) > (m->dimv[1] - 1)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "index out of bound");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        o = (Gua_Object *)m->object;
+        
+        count = 0;
+
+        for (i = Gua_ObjectToInteger(x1); i <= Gua_ObjectToInteger(x2); i++) {
+            for (j = Gua_ObjectToInteger(y1); j <= Gua_ObjectToInteger(y2); j++) {
+				if (Gua_ObjectType(o[i * m->dimv[1] + j]) == OBJECT_TYPE_INTEGER) {
+					if (Gua_ObjectToInteger(o[i * m->dimv[1] + j]) != 0) {
+	                    count = count + 1;
+					}
+	            } else if (Gua_ObjectType(o[i * m->dimv[1] + j]) == OBJECT_TYPE_REAL) {
+					if (Gua_ObjectToReal(o[i * m->dimv[1] + j]) != 0) {
+	                    count = count + 1;
+					}
+	            } else {
+					if (Gua_ObjectType(o[i * m->dimv[1] + j]) != OBJECT_TYPE_UNKNOWN) {
+						count = count + 1;
+					}
+				}
+            }
+        }
+
+        Gua_IntegerToPObject(object, count);
+    }
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Matrix_DelRow(Gua_Object *source, Gua_Integer n, Gua_Object *object, Gua_String error)
+ *
+ * Description:
+ *     Copy a matrix to other deleting the specified row.
+ *
+ * Arguments:
+ *     source,    the source matrix;
+ *     n,         the row number;
+ *     object,    a structure containing the return object of the function;
+ *     error,     a pointer to the error message.
+ *
+ * Results:
+ *     The function makes a copy of a matrix to other deleting the specified row.
+ */
+Gua_Status Matrix_DelRow(Gua_Object *source, Gua_Object n, Gua_Object *object, Gua_String error)
+{
+    Gua_Matrix *mt;
+    Gua_Matrix *ms;
+    Gua_Object *ot;
+    Gua_Object *os;
+    Gua_Integer i;
+    Gua_Integer j;
+    Gua_Integer k;
+    Gua_String errMessage;
+    
+    if (Gua_PObjectType(source) != OBJECT_TYPE_MATRIX) {
         errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-        sprintf(errMessage, "%s\n", "no function specified");
+        sprintf(errMessage, "%s...\n", "illegal argument");
         strcat(error, errMessage);
         Gua_Free(errMessage);
         
-        return GUA_ERROR;
-    }
-    
-    if (strcmp(Gua_ObjectToString(argv[0]), "avg") == 0) {
+        return GUA_ERROR;
+    }
+    if (Gua_ObjectType(n) != OBJECT_TYPE_INTEGER) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "illegal argument");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    ms = (Gua_Matrix *)Gua_PObjectToMatrix(source);
+    
+    if (ms) {
+        if(!Gua_IsPObjectStored(object)) {
+            Gua_FreeObject(object);
+        } else {
+            Gua_ClearPObject(object);
+        }
+
+        if (ms->dimc > 2) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "only bidimensional matrices are supported");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+
+        if ((Gua_ObjectToInteger(n) < 0) || (Gua_ObjectToInteger(n) > (ms->dimv[0] - 1))) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "index out of bound");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        os = (Gua_Object *)ms->object;
+        
+        mt = (Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix));
+        
+        mt->dimc = ms->dimc;
+        mt->dimv = Gua_Alloc(mt->dimc * sizeof(Gua_Integer));
+        
+        mt->dimv[0] = ms->dimv[0] - 1;
+        mt->dimv[1] = ms->dimv[1];
+        
+        mt->object = (struct Gua_Object *)Gua_Alloc((Gua_PObjectLength(source) - ms->dimv[1]) * sizeof(Gua_Object));
+        ot = (Gua_Object *)mt->object;
+        
+        k = 0;
+        for (i = 0; i < ms->dimv[0]; i++) {
+            if (i != Gua_ObjectToInteger(n)) {
+                for (j = 0; j < ms->dimv[1]; j++) {
+                    if (Gua_ObjectType(os[i * ms->dimv[1] + j]) == OBJECT_TYPE_STRING) {
+                        Gua_ByteArrayToObject(ot[k * mt->dimv[1] + j], Gua_ObjectToString(os[i * ms->dimv[1] + j]), Gua_ObjectLength(os[i * ms->dimv[1] + j]));
+                    } else {
+                        Gua_LinkObjects(ot[k * mt->dimv[1] + j], os[i * ms->dimv[1] + j]);
+                    }
+                }
+                k++;
+            }
+        }
+        
+        /* Fix the target matrix fields. */
+        Gua_MatrixToPObject(object, (struct Gua_Matrix *)mt, (Gua_PObjectLength(source) - ms->dimv[1]));
+        
+        return GUA_OK;
+    }
+    
+    return GUA_ERROR;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Matrix_DelCol(Gua_Object *source, Gua_Integer n, Gua_Object *object, Gua_String error)
+ *
+ * Description:
+ *     Copy a matrix to other deleting the specified Column.
+ *
+ * Arguments:
+ *     source,    the source matrix;
+ *     n,         the column number;
+ *     object,    a structure containing the return object of the function;
+ *     error,     a pointer to the error message.
+ *
+ * Results:
+ *     The function makes a copy of a matrix to other deleting the specified Column.
+ */
+Gua_Status Matrix_DelCol(Gua_Object *source, Gua_Object n, Gua_Object *object, Gua_String error)
+{
+    Gua_Matrix *mt;
+    Gua_Matrix *ms;
+    Gua_Object *ot;
+    Gua_Object *os;
+    Gua_Integer i;
+    Gua_Integer j;
+    Gua_Integer k;
+    Gua_String errMessage;
+    
+    if (Gua_PObjectType(source) != OBJECT_TYPE_MATRIX) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "illegal argument");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    if (Gua_ObjectType(n) != OBJECT_TYPE_INTEGER) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "illegal argument");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    ms = (Gua_Matrix *)Gua_PObjectToMatrix(source);
+    
+    if (ms) {
+        if(!Gua_IsPObjectStored(object)) {
+            Gua_FreeObject(object);
+        } else {
+            Gua_ClearPObject(object);
+        }
+
+        if (ms->dimc > 2) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "only bidimensional matrices are supported");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+
+        if ((Gua_ObjectToInteger(n) < 0) || (Gua_ObjectToInteger(n) > (ms->dimv[1] - 1))) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "index out of bound");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        os = (Gua_Object *)ms->object;
+        
+        mt = (Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix));
+        
+        mt->dimc = ms->dimc;
+        mt->dimv = Gua_Alloc(mt->dimc * sizeof(Gua_Integer));
+        
+        mt->dimv[0] = ms->dimv[0];
+        mt->dimv[1] = ms->dimv[1] - 1;
+        
+        mt->object = (struct Gua_Object *)Gua_Alloc((Gua_PObjectLength(source) - ms->dimv[0]) * sizeof(Gua_Object));
+        ot = (Gua_Object *)mt->object;
+        
+        k = 0;
+        for (j = 0; j < ms->dimv[1]; j++) {
+            if (j != Gua_ObjectToInteger(n)) {
+                for (i = 0; i < ms->dimv[0]; i++) {
+                    if (Gua_ObjectType(os[i * ms->dimv[1] + j]) == OBJECT_TYPE_STRING) {
+                        Gua_ByteArrayToObject(ot[i * mt->dimv[1] + k], Gua_ObjectToString(os[i * ms->dimv[1] + j]), Gua_ObjectLength(os[i * ms->dimv[1] + j]));
+                    } else {
+                        Gua_LinkObjects(ot[i * mt->dimv[1] + k], os[i * ms->dimv[1] + j]);
+                    }
+                }
+                k++;
+            }
+        }
+        
+        /* Fix the target matrix fields. */
+        Gua_MatrixToPObject(object, (struct Gua_Matrix *)mt, (Gua_PObjectLength(source) - ms->dimv[0]));
+        
+        return GUA_OK;
+    }
+    
+    return GUA_ERROR;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Matrix_Min(Gua_Object *a, Gua_Object *object, Gua_String error)
+ *
+ * Description:
+ *     Calculate the min object of all cells in the matrix.
+ *
+ * Arguments:
+ *     a,         a matrix;
+ *     object,    a structure containing the return object of the function;
+ *     error,     a pointer to the error message.
+ *
+ * Results:
+ *     The function returns the min object of all cells in the matrix.
+ */
+Gua_Status Matrix_Min(Gua_Object *a, Gua_Object *object, Gua_String error)
+{
+    Gua_Matrix *m;
+    Gua_Object *o;
+    Gua_Length length;
+    Gua_Integer i;
+    Gua_Real min;
+    Gua_String errMessage;
+    
+    if (Gua_PObjectType(a) != OBJECT_TYPE_MATRIX) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "illegal argument");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    m = (Gua_Matrix *)Gua_PObjectToMatrix(a);
+    
+    if (m) {
+        if(!Gua_IsPObjectStored(object)) {
+            Gua_FreeObject(object);
+        } else {
+            Gua_ClearPObject(object);
+        }
+        
+        o = (Gua_Object *)m->object;
+        
+        length = Gua_PObjectLength(a);
+        
+        min = 0;
+        
+        for (i = 0; i < length; i++) {
+            if (i == 0) {
+                if (Gua_ObjectType(o[i]) == OBJECT_TYPE_INTEGER) {
+                    min = Gua_ObjectToInteger(o[i]);
+                } else if (Gua_ObjectType(o[i]) == OBJECT_TYPE_REAL) {
+                    min = Gua_ObjectToReal(o[i]);
+                }
+            } else {
+                if (Gua_ObjectType(o[i]) == OBJECT_TYPE_INTEGER) {
+                    if (min > Gua_ObjectToInteger(o[i])) {
+                        min = Gua_ObjectToInteger(o[i]);
+                    }
+                } else if (Gua_ObjectType(o[i]) == OBJECT_TYPE_REAL) {
+                    if (min > Gua_ObjectToReal(o[i])) {
+                        min = Gua_ObjectToReal(o[i]);
+                    }
+                }
+            }
+        }
+        
+        Gua_RealToPObject(object, min);
+    }
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Matrix_MinCells(Gua_Object *a, Gua_Object x1, Gua_Object y1, Gua_Object x2, Gua_Object y2, Gua_Object *object, Gua_String error)
+ *
+ * Description:
+ *     Calculate the min of specified cells in the matrix.
+ *
+ * Arguments:
+ *     a,         a matrix;
+ *     x1,        row of the top left corner;
+ *     y1,        column of the top left corner;
+ *     x2,        row of the bottom right corner;
+ *     y2,        column of the bottom right corner;
+ *     object,    a structure containing the return object of the function;
+ *     error,     a pointer to the error message.
+ *
+ * Results:
+ *     The function returns the min of specified cells in the matrix.
+ */
+Gua_Status Matrix_MinCells(Gua_Object *a, Gua_Object x1, Gua_Object y1, Gua_Object x2, Gua_Object y2, Gua_Object *object, Gua_String error)
+{
+    Gua_Matrix *m;
+    Gua_Object *o;
+    Gua_Integer i;
+    Gua_Integer j;
+    Gua_Real min;
+    Gua_String errMessage;
+    
+    if (Gua_PObjectType(a) != OBJECT_TYPE_MATRIX) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "illegal argument");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    m = (Gua_Matrix *)Gua_PObjectToMatrix(a);
+    
+    if (m) {
+        if(!Gua_IsPObjectStored(object)) {
+            Gua_FreeObject(object);
+        } else {
+            Gua_ClearPObject(object);
+        }
+
+        if (m->dimc != 2) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "only bidimensional matrices are supported");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (Gua_ObjectToInteger(x1) < 0) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "index out of bound");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (Gua_ObjectToInteger(y1) < 0) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "index out of bound");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (Gua_ObjectToInteger(x2) > (m->dimv[0] - 1)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "index out of bound");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (Gua_ObjectToInteger(y2) > (m->dimv[1] - 1)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "index out of bound");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        o = (Gua_Object *)m->object;
+        
+        min = 0;
+        
+        for (i = Gua_ObjectToInteger(x1); i <= Gua_ObjectToInteger(x2); i++) {
+            for (j = Gua_ObjectToInteger(y1); j <= Gua_ObjectToInteger(y2); j++) {
+                if ((i == Gua_ObjectToInteger(x1)) && (j == Gua_ObjectToInteger(y2))) {
+                    if (Gua_ObjectType(o[i * m->dimv[1] + j]) == OBJECT_TYPE_INTEGER) {
+                        min = Gua_ObjectToInteger(o[i * m->dimv[1] + j]);
+                    } else if (Gua_ObjectType(o[i * m->dimv[1] + j]) == OBJECT_TYPE_REAL) {
+                        min = Gua_ObjectToReal(o[i * m->dimv[1] + j]);
+                    }
+                } else {
+                    if (Gua_ObjectType(o[i * m->dimv[1] + j]) == OBJECT_TYPE_INTEGER) {
+                        if (min > Gua_ObjectToInteger(o[i * m->dimv[1] + j])) {
+                            min = Gua_ObjectToInteger(o[i * m->dimv[1] + j]);
+                        }
+                    } else if (Gua_ObjectType(o[i * m->dimv[1] + j]) == OBJECT_TYPE_REAL) {
+                        if (min > Gua_ObjectToReal(o[i * m->dimv[1] + j])) {
+                            min = Gua_ObjectToReal(o[i * m->dimv[1] + j]);
+                        }
+                    }
+                }
+            }
+        }
+        
+        Gua_RealToPObject(object, min);
+    }
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Matrix_Max(Gua_Object *a, Gua_Object *object, Gua_String error)
+ *
+ * Description:
+ *     Calculate the max object of all cells in the matrix.
+ *
+ * Arguments:
+ *     a,         a matrix;
+ *     object,    a structure containing the return object of the function;
+ *     error,     a pointer to the error message.
+ *
+ * Results:
+ *     The function returns the max object of all cells in the matrix.
+ */
+Gua_Status Matrix_Max(Gua_Object *a, Gua_Object *object, Gua_String error)
+{
+    Gua_Matrix *m;
+    Gua_Object *o;
+    Gua_Length length;
+    Gua_Integer i;
+    Gua_Real max;
+    Gua_String errMessage;
+    
+    if (Gua_PObjectType(a) != OBJECT_TYPE_MATRIX) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "illegal argument");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    m = (Gua_Matrix *)Gua_PObjectToMatrix(a);
+    
+    if (m) {
+        if(!Gua_IsPObjectStored(object)) {
+            Gua_FreeObject(object);
+        } else {
+            Gua_ClearPObject(object);
+        }
+        
+        o = (Gua_Object *)m->object;
+        
+        length = Gua_PObjectLength(a);
+
+        max = 0;
+
+        for (i = 0; i < length; i++) {
+            if (Gua_ObjectType(o[i]) == OBJECT_TYPE_INTEGER) {
+                if (max < Gua_ObjectToInteger(o[i])) {
+                    max = Gua_ObjectToInteger(o[i]);
+                }
+            } else if (Gua_ObjectType(o[i]) == OBJECT_TYPE_REAL) {
+                if (max < Gua_ObjectToReal(o[i])) {
+                    max = Gua_ObjectToReal(o[i]);
+                }
+            }
+        }
+
+        Gua_RealToPObject(object, max);
+    }
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Matrix_MaxCells(Gua_Object *a, Gua_Object x1, Gua_Object y1, Gua_Object x2, Gua_Object y2, Gua_Object *object, Gua_String error)
+ *
+ * Description:
+ *     Calculate the max of specified cells in the matrix.
+ *
+ * Arguments:
+ *     a,         a matrix;
+ *     x1,        row of the top left corner;
+ *     y1,        column of the top left corner;
+ *     x2,        row of the bottom right corner;
+ *     y2,        column of the bottom right corner;
+ *     object,    a structure containing the return object of the function;
+ *     error,     a pointer to the error message.
+ *
+ * Results:
+ *     The function returns the max of specified cells in the matrix.
+ */
+Gua_Status Matrix_MaxCells(Gua_Object *a, Gua_Object x1, Gua_Object y1, Gua_Object x2, Gua_Object y2, Gua_Object *object, Gua_String error)
+{
+    Gua_Matrix *m;
+    Gua_Object *o;
+    Gua_Integer i;
+    Gua_Integer j;
+    Gua_Real max;
+    Gua_String errMessage;
+    
+    if (Gua_PObjectType(a) != OBJECT_TYPE_MATRIX) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "illegal argument");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    m = (Gua_Matrix *)Gua_PObjectToMatrix(a);
+    
+    if (m) {
+        if(!Gua_IsPObjectStored(object)) {
+            Gua_FreeObject(object);
+        } else {
+            Gua_ClearPObject(object);
+        }
+
+        if (m->dimc != 2) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "only bidimensional matrices are supported");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (Gua_ObjectToInteger(x1) < 0) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "index out of bound");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (Gua_ObjectToInteger(y1) < 0) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "index out of bound");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (Gua_ObjectToInteger(x2) > (m->dimv[0] - 1)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "index out of bound");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (Gua_ObjectToInteger(y2) > (m->dimv[1] - 1)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "index out of bound");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        o = (Gua_Object *)m->object;
+        
+        max = 0;
+        
+        for (i = Gua_ObjectToInteger(x1); i <= Gua_ObjectToInteger(x2); i++) {
+            for (j = Gua_ObjectToInteger(y1); j <= Gua_ObjectToInteger(y2); j++) {
+                if (Gua_ObjectType(o[i * m->dimv[1] + j]) == OBJECT_TYPE_INTEGER) {
+                    if (max < Gua_ObjectToInteger(o[i * m->dimv[1] + j])) {
+                        max = Gua_ObjectToInteger(o[i * m->dimv[1] + j]);
+                    }
+                } else if (Gua_ObjectType(o[i * m->dimv[1] + j]) == OBJECT_TYPE_REAL) {
+                    if (max < Gua_ObjectToReal(o[i * m->dimv[1] + j])) {
+                        max = Gua_ObjectToReal(o[i * m->dimv[1] + j]);
+                    }
+                }
+            }
+        }
+        
+        Gua_RealToPObject(object, max);
+    }
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Real Matrix_PairwiseSum(Gua_Real *x, Gua_Length n)
+ *
+ * Description:
+ *     Sum a real buffer by pairwise summation. Short runs are added with four
+ *     independent accumulators, which the compiler can keep in vector
+ *     registers; longer runs are split in halves, so the rounding error
+ *     grows with log(n) instead of n.
+ *
+ * Arguments:
+ *     x,         the buffer;
+ *     n,         the number of elements.
+ *
+ * Results:
+ *     The function returns the sum of the buffer.
+ */
+Gua_Real Matrix_PairwiseSum(Gua_Real *x, Gua_Length n)
+{
+    Gua_Real s0;
+    Gua_Real s1;
+    Gua_Real s2;
+    Gua_Real s3;
+    Gua_Length i;
+    Gua_Length half;
+    
+    if (n <= MATRIX_PAIRWISE_BLOCK_SIZE) {
+        s0 = 0.0;
+        s1 = 0.0;
+        s2 = 0.0;
+        s3 = 0.0;
+        
+        for (i = 0; i + 3 < n; i = i + 4) {
+            s0 = s0 + x[i];
+            s1 = s1 + x[i + 1];
+            s2 = s2 + x[i + 2];
+            s3 = s3 + x[i + 3];
+        }
+        for (; i < n; i++) {
+            s0 = s0 + x[i];
+        }
+        
+        return (s0 + s1) + (s2 + s3);
+    }
+    
+    half = n / 2;
+    
+    return Matrix_PairwiseSum(x, half) + Matrix_PairwiseSum(x + half, n - half);
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Matrix_UnpackLanes(Gua_Object *o, Gua_Short operation, Gua_Length rows, Gua_Length cols, Gua_Length stride, Gua_Short transpose, Gua_Real *x)
+ *
+ * Description:
+ *     Copy the cells of a row-major matrix into a real buffer, prepared for a
+ *     reduction. Sums ignore non-numeric cells, sum2 stores the squares,
+ *     count stores 1 for every counted cell and min and max store NaN for
+ *     non-numeric cells. When transpose is true the buffer is column-major,
+ *     so each column becomes a contiguous lane.
+ *
+ * Arguments:
+ *     o,         the matrix cells;
+ *     operation, the reduction;
+ *     rows,      the number of rows;
+ *     cols,      the number of columns;
+ *     stride,    the distance between the rows, cols unless o is a view;
+ *     transpose, store the columns contiguously;
+ *     x,         the buffer, with rows * cols elements.
+ *
+ * Results:
+ *     The function fills the buffer x.
+ */
+void Matrix_UnpackLanes(Gua_Object *o, Gua_Short operation, Gua_Length rows, Gua_Length cols, Gua_Length stride, Gua_Short transpose, Gua_Real *x)
+{
+    Gua_Object *p;
+    Gua_Length i;
+    Gua_Length j;
+    Gua_Real v;
+    Gua_Short numeric;
+    
+    for (i = 0; i < rows; i++) {
+        for (j = 0; j < cols; j++) {
+            p = &(o[i * stride + j]);
+            numeric = true;
+            
+            if (Gua_PObjectType(p) == OBJECT_TYPE_INTEGER) {
+                v = Gua_PObjectToInteger(p);
+            } else if (Gua_PObjectType(p) == OBJECT_TYPE_REAL) {
+                v = Gua_PObjectToReal(p);
+            } else {
+                v = 0.0;
+                numeric = false;
+            }
+            
+            if (operation == MATRIX_REDUCE_SUM2) {
+                v = v * v;
+            } else if (operation == MATRIX_REDUCE_COUNT) {
+                if (numeric) {
+                    v = v != 0.0 ? 1.0 : 0.0;
+                } else {
+                    v = Gua_PObjectType(p) != OBJECT_TYPE_UNKNOWN ? 1.0 : 0.0;
+                }
+            } else if ((operation == MATRIX_REDUCE_MIN) || (operation == MATRIX_REDUCE_MAX) || (operation == MATRIX_REDUCE_ARGMIN) || (operation == MATRIX_REDUCE_ARGMAX)) {
+                if (!numeric) {
+                    v = NAN;
+                }
+            }
+            
+            if (transpose) {
+                x[j * rows + i] = v;
+            } else {
+                x[i * cols + j] = v;
+            }
+        }
+    }
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Real Matrix_ReduceLane(Gua_Short operation, Gua_Real *x, Gua_Length n, Gua_Integer *index)
+ *
+ * Description:
+ *     Reduce a lane prepared by Matrix_UnpackLanes.
+ *
+ * Arguments:
+ *     operation, the reduction;
+ *     x,         the lane;
+ *     n,         the number of elements;
+ *     index,     a pointer to the position of the min or max element,
+ *                or -1 if the lane has no numeric element.
+ *
+ * Results:
+ *     The function returns the reduced value. The min and max of a lane
+ *     without numeric elements are 0.
+ */
+Gua_Real Matrix_ReduceLane(Gua_Short operation, Gua_Real *x, Gua_Length n, Gua_Integer *index)
+{
+    Gua_Real best;
+    Gua_Length i;
+    
+    *index = -1;
+    
+    if ((operation == MATRIX_REDUCE_SUM) || (operation == MATRIX_REDUCE_SUM2) || (operation == MATRIX_REDUCE_COUNT)) {
+        return Matrix_PairwiseSum(x, n);
+    } else if (operation == MATRIX_REDUCE_AVG) {
+        return n > 0 ? Matrix_PairwiseSum(x, n) / n : 0.0;
+    }
+    
+    best = 0.0;
+    
+    if ((operation == MATRIX_REDUCE_MIN) || (operation == MATRIX_REDUCE_ARGMIN)) {
+        for (i = 0; i < n; i++) {
+            if ((x[i] < best) || ((*index < 0) && !isnan(x[i]))) {
+                best = x[i];
+                *index = i;
+            }
+        }
+    } else {
+        for (i = 0; i < n; i++) {
+            if ((x[i] > best) || ((*index < 0) && !isnan(x[i]))) {
+                best = x[i];
+                *index = i;
+            }
+        }
+    }
+    
+    return best;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Matrix_Reduce(Gua_Object *a, Gua_Short operation, Gua_Integer axis, Gua_Object *object, Gua_String error)
+ *
+ * Description:
+ *     Reduce a matrix along an axis. Axis 0 reduces each column, axis 1
+ *     reduces each row and axis -1 reduces the whole matrix. The matrix
+ *     may be a view of a block of another matrix.
+ *
+ * Arguments:
+ *     a,         a matrix;
+ *     operation, the reduction, one of MATRIX_REDUCE_*;
+ *     axis,      the axis, or -1 for the whole matrix;
+ *     object,    a structure containing the return object of the function;
+ *     error,     a pointer to the error message.
+ *
+ * Results:
+ *     For axis 0, a row vector with one value per column; for axis 1, a
+ *     column vector with one value per row. For the whole
+ *     matrix, a single value. count, argmin and argmax return integers;
+ *     argmin and argmax of the whole matrix return the cell offset.
+ */
+Gua_Status Matrix_Reduce(Gua_Object *a, Gua_Short operation, Gua_Integer axis, Gua_Object *object, Gua_String error)
+{
+    Gua_Matrix *m;
+    Gua_Matrix *r;
+    Gua_Object *o;
+    Gua_Real *x;
+    Gua_Real value;
+    Gua_Length rows;
+    Gua_Length cols;
+    Gua_Length stride;
+    Gua_Length lanes;
+    Gua_Length n;
+    Gua_Length i;
+    Gua_Integer index;
+    Gua_String errMessage;
+    
+    if ((Gua_PObjectType(a) != OBJECT_TYPE_MATRIX) || (axis < -1) || (axis > 1)) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "illegal argument");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    m = (Gua_Matrix *)Gua_PObjectToMatrix(a);
+    
+    if (m == NULL) {
+        return GUA_OK;
+    }
+    
+    if ((m->dimc > 2) && ((axis == 0) || (axis == 1))) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "only bidimensional matrices are supported");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    if (m->dimc == 2) {
+        rows = m->dimv[0];
+        cols = m->dimv[1];
+    } else if (m->dimc == 1) {
+        rows = 1;
+        cols = m->dimv[0];
+    } else {
+        rows = 1;
+        cols = Gua_PObjectLength(a);
+    }
+    
+    stride = Gua_IsPObjectView(a) ? Gua_PObjectStride(a) : cols;
+    
+    if (axis == -1) {
+        lanes = 1;
+        n = rows * cols;
+    } else {
+        lanes = axis == 0 ? cols : rows;
+        n = axis == 0 ? rows : cols;
+    }
+    
+    if(!Gua_IsPObjectStored(object)) {
+        Gua_FreeObject(object);
+    } else {
+        Gua_ClearPObject(object);
+    }
+    
+    o = (Gua_Object *)m->object;
+    
+    x = (Gua_Real *)Gua_Alloc((rows * cols + 1) * sizeof(Gua_Real));
+    
+    Matrix_UnpackLanes(o, operation, rows, cols, stride, axis == 0, x);
+    
+    if (axis == -1) {
+        value = Matrix_ReduceLane(operation, x, n, &index);
+        
+        if ((operation == MATRIX_REDUCE_ARGMIN) || (operation == MATRIX_REDUCE_ARGMAX)) {
+            Gua_IntegerToPObject(object, index);
+        } else if (operation == MATRIX_REDUCE_COUNT) {
+            Gua_IntegerToPObject(object, (Gua_Integer)value);
+        } else {
+            Gua_RealToPObject(object, value);
+        }
+        
+        Gua_Free(x);
+        
+        return GUA_OK;
+    }
+    
+    Gua_MatrixToPObject(object, (struct Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix)), lanes);
+    r = (Gua_Matrix *)Gua_PObjectToMatrix(object);
+    r->dimc = 2;
+    r->dimv = (Gua_Length *)Gua_Alloc(2 * sizeof(Gua_Length));
+    r->dimv[0] = axis == 0 ? 1 : lanes;
+    r->dimv[1] = axis == 0 ? lanes : 1;
+    r->object = (struct Gua_Object *)Gua_Alloc(lanes * sizeof(Gua_Object));
+    o = (Gua_Object *)r->object;
+    
+    for (i = 0; i < lanes; i++) {
+        value = Matrix_ReduceLane(operation, x + i * n, n, &index);
+        
+        if ((operation == MATRIX_REDUCE_ARGMIN) || (operation == MATRIX_REDUCE_ARGMAX)) {
+            Gua_IntegerToObject(o[i], index);
+        } else if (operation == MATRIX_REDUCE_COUNT) {
+            Gua_IntegerToObject(o[i], (Gua_Integer)value);
+        } else {
+            Gua_RealToObject(o[i], value);
+        }
+    }
+    
+    Gua_Free(x);
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Matrix_Sparse *Matrix_NewSparse(Gua_Length rows, Gua_Length cols, Gua_Length nnz)
+ *
+ * Description:
+ *     Allocate a sparse matrix in compressed sparse row (CSR) format. The
+ *     column indices and values of row i are stored in the positions
+ *     rowp[i] to rowp[i + 1] - 1 of colind and values.
+ *
+ * Arguments:
+ *     rows,    the number of rows;
+ *     cols,    the number of columns;
+ *     nnz,     the number of nonzero elements to reserve.
+ *
+ * Results:
+ *     The new sparse matrix, with no nonzero elements.
+ */
+Matrix_Sparse *Matrix_NewSparse(Gua_Length rows, Gua_Length cols, Gua_Length nnz)
+{
+    Matrix_Sparse *s;
+    
+    s = (Matrix_Sparse *)Gua_Alloc(sizeof(Matrix_Sparse));
+    s->rows = rows;
+    s->cols = cols;
+    s->nnz = 0;
+    s->rowp = (Gua_Length *)Gua_Alloc((rows + 1) * sizeof(Gua_Length));
+    s->colind = (Gua_Length *)Gua_Alloc((nnz + 1) * sizeof(Gua_Length));
+    s->values = (Gua_Real *)Gua_Alloc((nnz + 1) * sizeof(Gua_Real));
+    
+    memset(s->rowp, 0, (rows + 1) * sizeof(Gua_Length));
+    
+    return s;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Matrix_FreeSparse(Matrix_Sparse *s)
+ *
+ * Description:
+ *     Free a sparse matrix.
+ *
+ * Arguments:
+ *     s,    the sparse matrix.
+ *
+ * Results:
+ *     The function frees the row pointers, the column indices and the values.
+ */
+void Matrix_FreeSparse(Matrix_Sparse *s)
+{
+    if (s == NULL) {
+        return;
+    }
+    
+    Gua_Free(s->rowp);
+    Gua_Free(s->colind);
+    Gua_Free(s->values);
+    Gua_Free(s);
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Matrix_Sparse *Matrix_SparseFromTriplets(Gua_Length rows, Gua_Length cols, Gua_Length n, Gua_Length *ti, Gua_Length *tj, Gua_Real *tv, Gua_Short sum)
+ *
+ * Description:
+ *     Build a CSR matrix from coordinate (COO) triplets. The triplets are
+ *     ordered by two stable counting sorts, first by column and then by
+ *     row, so the work is linear in the number of triplets. Repeated
+ *     coordinates are summed, or the last one wins, and zeros are dropped.
+ *
+ * Arguments:
+ *     rows,    the number of rows;
+ *     cols,    the number of columns;
+ *     n,       the number of triplets;
+ *     ti,      the row indices, from 0 to rows - 1;
+ *     tj,      the column indices, from 0 to cols - 1;
+ *     tv,      the values;
+ *     sum,     true to sum the values of repeated coordinates, false to
+ *              keep the last one.
+ *
+ * Results:
+ *     The new sparse matrix, with the columns of each row in ascending order.
+ */
+Matrix_Sparse *Matrix_SparseFromTriplets(Gua_Length rows, Gua_Length cols, Gua_Length n, Gua_Length *ti, Gua_Length *tj, Gua_Real *tv, Gua_Short sum)
+{
+    Matrix_Sparse *s;
+    Gua_Length *count;
+    Gua_Length *bycol;
+    Gua_Length *order;
+    Gua_Length size;
+    Gua_Length row;
+    Gua_Length first;
+    Gua_Length i;
+    Gua_Length j;
+    Gua_Length k;
+    
+    s = Matrix_NewSparse(rows, cols, n);
+    
+    size = (rows > cols ? rows : cols) + 1;
+    
+    bycol = (Gua_Length *)Gua_Alloc((n + 1) * sizeof(Gua_Length));
+    order = (Gua_Length *)Gua_Alloc((n + 1) * sizeof(Gua_Length));
+    count = (Gua_Length *)Gua_Alloc(size * sizeof(Gua_Length));
+    
+    memset(count, 0, size * sizeof(Gua_Length));
+    for (k = 0; k < n; k++) {
+        count[tj[k] + 1]++;
+    }
+    for (j = 0; j < cols; j++) {
+        count[j + 1] += count[j];
+    }
+    for (k = 0; k < n; k++) {
+        bycol[count[tj[k]]++] = k;
+    }
+    
+    memset(count, 0, size * sizeof(Gua_Length));
+    for (k = 0; k < n; k++) {
+        count[ti[k] + 1]++;
+    }
+    for (i = 0; i < rows; i++) {
+        count[i + 1] += count[i];
+    }
+    for (k = 0; k < n; k++) {
+        order[count[ti[bycol[k]]]++] = bycol[k];
+    }
+    
+    k = 0;
+    for (row = 0; row < rows; row++) {
+        first = s->nnz;
+        
+        /* Merge the repeated coordinates, which are now adjacent. */
+        while ((k < n) && (ti[order[k]] == row)) {
+            if ((s->nnz > first) && (s->colind[s->nnz - 1] == tj[order[k]])) {
+                if (sum) {
+                    s->values[s->nnz - 1] += tv[order[k]];
+                } else {
+                    s->values[s->nnz - 1] = tv[order[k]];
+                }
+            } else {
+                s->colind[s->nnz] = tj[order[k]];
+                s->values[s->nnz] = tv[order[k]];
+                s->nnz++;
+            }
+            k++;
+        }
+        
+        /* Drop the zeros, including the sums that cancelled out. */
+        i = first;
+        for (j = first; j < s->nnz; j++) {
+            if (s->values[j] != 0.0) {
+                s->colind[i] = s->colind[j];
+                s->values[i] = s->values[j];
+                i++;
+            }
+        }
+        s->nnz = i;
+        s->rowp[row + 1] = s->nnz;
+    }
+    
+    Gua_Free(count);
+    Gua_Free(order);
+    Gua_Free(bycol);
+    
+    return s;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Matrix_Sparse *Matrix_DenseToSparse(Gua_Real *x, Gua_Length rows, Gua_Length cols)
+ *
+ * Description:
+ *     Convert a dense row-major buffer to a CSR matrix.
+ *
+ * Arguments:
+ *     x,       the dense buffer;
+ *     rows,    the number of rows;
+ *     cols,    the number of columns.
+ *
+ * Results:
+ *     The new sparse matrix, holding the nonzero elements of x.
+ */
+Matrix_Sparse *Matrix_DenseToSparse(Gua_Real *x, Gua_Length rows, Gua_Length cols)
+{
+    Matrix_Sparse *s;
+    Gua_Length nnz;
+    Gua_Length i;
+    Gua_Length j;
+    
+    nnz = 0;
+    for (i = 0; i < rows * cols; i++) {
+        if (x[i] != 0.0) {
+            nnz++;
+        }
+    }
+    
+    s = Matrix_NewSparse(rows, cols, nnz);
+    
+    for (i = 0; i < rows; i++) {
+        for (j = 0; j < cols; j++) {
+            if (x[i * cols + j] != 0.0) {
+                s->colind[s->nnz] = j;
+                s->values[s->nnz] = x[i * cols + j];
+                s->nnz++;
+            }
+        }
+        s->rowp[i + 1] = s->nnz;
+    }
+    
+    return s;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Matrix_SparseToDense(Matrix_Sparse *s, Gua_Real *x)
+ *
+ * Description:
+ *     Expand a CSR matrix to a dense row-major buffer.
+ *
+ * Arguments:
+ *     s,    the sparse matrix;
+ *     x,    a buffer with room for rows * cols elements.
+ *
+ * Results:
+ *     The function fills x.
+ */
+void Matrix_SparseToDense(Matrix_Sparse *s, Gua_Real *x)
+{
+    Gua_Length i;
+    Gua_Length k;
+    
+    memset(x, 0, s->rows * s->cols * sizeof(Gua_Real));
+    
+    for (i = 0; i < s->rows; i++) {
+        for (k = s->rowp[i]; k < s->rowp[i + 1]; k++) {
+            x[i * s->cols + s->colind[k]] = s->values[k];
+        }
+    }
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Matrix_Sparse *Matrix_SparseTranspose(Matrix_Sparse *a)
+ *
+ * Description:
+ *     Transpose a CSR matrix with a counting sort over the column indices.
+ *
+ * Arguments:
+ *     a,    the sparse matrix.
+ *
+ * Results:
+ *     The new sparse matrix, with the columns of each row in ascending order.
+ */
+Matrix_Sparse *Matrix_SparseTranspose(Matrix_Sparse *a)
+{
+    Matrix_Sparse *t;
+    Gua_Length *next;
+    Gua_Length i;
+    Gua_Length k;
+    Gua_Length p;
+    
+    t = Matrix_NewSparse(a->cols, a->rows, a->nnz);
+    
+    for (k = 0; k < a->nnz; k++) {
+        t->rowp[a->colind[k] + 1]++;
+    }
+    for (i = 0; i < a->cols; i++) {
+        t->rowp[i + 1] += t->rowp[i];
+    }
+    
+    next = (Gua_Length *)Gua_Alloc((a->cols + 1) * sizeof(Gua_Length));
+    memcpy(next, t->rowp, (a->cols + 1) * sizeof(Gua_Length));
+    
+    for (i = 0; i < a->rows; i++) {
+        for (k = a->rowp[i]; k < a->rowp[i + 1]; k++) {
+            p = next[a->colind[k]]++;
+            t->colind[p] = i;
+            t->values[p] = a->values[k];
+        }
+    }
+    
+    t->nnz = a->nnz;
+    
+    Gua_Free(next);
+    
+    return t;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Matrix_SparseMulDense(Matrix_Sparse *a, Gua_Real *x, Gua_Length p, Gua_Real *y)
+ *
+ * Description:
+ *     Multiply a CSR matrix by a dense row-major buffer. With one column
+ *     this is the sparse matrix-vector product (SpMV), computed as one dot
+ *     product per row; with more columns each nonzero element scales a
+ *     whole row of x.
+ *
+ * Arguments:
+ *     a,    the rows x cols sparse matrix;
+ *     x,    the cols x p dense buffer;
+ *     p,    the number of columns of x;
+ *     y,    the rows x p result buffer.
+ *
+ * Results:
+ *     The function fills y.
+ */
+void Matrix_SparseMulDense(Matrix_Sparse *a, Gua_Real *x, Gua_Length p, Gua_Real *y)
+{
+    Gua_Real *xr;
+    Gua_Real *yr;
+    Gua_Real v;
+    Gua_Length i;
+    Gua_Length j;
+    Gua_Length k;
+    
+    if (p == 1) {
+        for (i = 0; i < a->rows; i++) {
+            v = 0.0;
+            for (k = a->rowp[i]; k < a->rowp[i + 1]; k++) {
+                v += a->values[k] * x[a->colind[k]];
+            }
+            y[i] = v;
+        }
+        
+        return;
+    }
+    
+    memset(y, 0, a->rows * p * sizeof(Gua_Real));
+    
+    for (i = 0; i < a->rows; i++) {
+        yr = y + i * p;
+        for (k = a->rowp[i]; k < a->rowp[i + 1]; k++) {
+            v = a->values[k];
+            xr = x + a->colind[k] * p;
+            for (j = 0; j < p; j++) {
+                yr[j] += v * xr[j];
+            }
+        }
+    }
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Matrix_DenseMulSparse(Gua_Real *x, Gua_Length m, Matrix_Sparse *a, Gua_Real *y)
+ *
+ * Description:
+ *     Multiply a dense row-major buffer by a CSR matrix. Each nonzero element
+ *     of a row of x scales the matching row of a.
+ *
+ * Arguments:
+ *     x,    the m x rows dense buffer;
+ *     m,    the number of rows of x;
+ *     a,    the rows x cols sparse matrix;
+ *     y,    the m x cols result buffer.
+ *
+ * Results:
+ *     The function fills y.
+ */
+void Matrix_DenseMulSparse(Gua_Real *x, Gua_Length m, Matrix_Sparse *a, Gua_Real *y)
+{
+    Gua_Real *xr;
+    Gua_Real *yr;
+    Gua_Length r;
+    Gua_Length i;
+    Gua_Length k;
+    
+    memset(y, 0, m * a->cols * sizeof(Gua_Real));
+    
+    for (r = 0; r < m; r++) {
+        xr = x + r * a->rows;
+        yr = y + r * a->cols;
+        for (i = 0; i < a->rows; i++) {
+            if (xr[i] == 0.0) {
+                continue;
+            }
+            for (k = a->rowp[i]; k < a->rowp[i + 1]; k++) {
+                yr[a->colind[k]] += xr[i] * a->values[k];
+            }
+        }
+    }
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Matrix_Sparse *Matrix_SparseMulSparse(Matrix_Sparse *a, Matrix_Sparse *b)
+ *
+ * Description:
+ *     Multiply two CSR matrices (SpGEMM) with Gustavson's row by row
+ *     algorithm. A symbolic pass counts the nonzero elements of the product
+ *     so the result is allocated once; the numeric pass accumulates each row
+ *     in a dense work vector. The columns come out in the order they were
+ *     found, so the result is transposed twice to sort them.
+ *
+ * Arguments:
+ *     a,    the m x n sparse matrix;
+ *     b,    the n x p sparse matrix.
+ *
+ * Results:
+ *     The new m x p sparse matrix.
+ */
+Matrix_Sparse *Matrix_SparseMulSparse(Matrix_Sparse *a, Matrix_Sparse *b)
+{
+    Matrix_Sparse *c;
+    Matrix_Sparse *t;
+    Matrix_Sparse *r;
+    Gua_Length *marker;
+    Gua_Real *work;
+    Gua_Length nnz;
+    Gua_Length first;
+    Gua_Length i;
+    Gua_Length j;
+    Gua_Length ka;
+    Gua_Length kb;
+    Gua_Length q;
+    
+    marker = (Gua_Length *)Gua_Alloc((b->cols + 1) * sizeof(Gua_Length));
+    work = (Gua_Real *)Gua_Alloc((b->cols + 1) * sizeof(Gua_Real));
+    
+    for (j = 0; j < b->cols; j++) {
+        marker[j] = -1;
+    }
+    
+    nnz = 0;
+    for (i = 0; i < a->rows; i++) {
+        for (ka = a->rowp[i]; ka < a->rowp[i + 1]; ka++) {
+            for (kb = b->rowp[a->colind[ka]]; kb < b->rowp[a->colind[ka] + 1]; kb++) {
+                if (marker[b->colind[kb]] != i) {
+                    marker[b->colind[kb]] = i;
+                    nnz++;
+                }
+            }
+        }
+    }
+    
+    c = Matrix_NewSparse(a->rows, b->cols, nnz);
+    
+    for (j = 0; j < b->cols; j++) {
+        marker[j] = -1;
+    }
+    
+    for (i = 0; i < a->rows; i++) {
+        first = c->nnz;
+        for (ka = a->rowp[i]; ka < a->rowp[i + 1]; ka++) {
+            for (kb = b->rowp[a->colind[ka]]; kb < b->rowp[a->colind[ka] + 1]; kb++) {
+                j = b->colind[kb];
+                if (marker[j] != i) {
+                    marker[j] = i;
+                    work[j] = a->values[ka] * b->values[kb];
+                    c->colind[c->nnz++] = j;
+                } else {
+                    work[j] += a->values[ka] * b->values[kb];
+                }
+            }
+        }
+        
+        q = first;
+        for (kb = first; kb < c->nnz; kb++) {
+            if (work[c->colind[kb]] != 0.0) {
+                c->colind[q] = c->colind[kb];
+                c->values[q] = work[c->colind[kb]];
+                q++;
+            }
+        }
+        c->nnz = q;
+        c->rowp[i + 1] = c->nnz;
+    }
+    
+    Gua_Free(work);
+    Gua_Free(marker);
+    
+    t = Matrix_SparseTranspose(c);
+    r = Matrix_SparseTranspose(t);
+    
+    Matrix_FreeSparse(t);
+    Matrix_FreeSparse(c);
+    
+    return r;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Matrix_Sparse *Matrix_SparseCombine(Matrix_Sparse *a, Matrix_Sparse *b, Gua_Short operation)
+ *
+ * Description:
+ *     Combine two CSR matrices of the same size element by element, merging
+ *     the sorted columns of each pair of rows.
+ *
+ * Arguments:
+ *     a,            the first sparse matrix;
+ *     b,            the second sparse matrix;
+ *     operation,    MATRIX_SPARSE_ADD, MATRIX_SPARSE_SUB or MATRIX_SPARSE_MUL.
+ *
+ * Results:
+ *     The new sparse matrix.
+ */
+Matrix_Sparse *Matrix_SparseCombine(Matrix_Sparse *a, Matrix_Sparse *b, Gua_Short operation)
+{
+    Matrix_Sparse *c;
+    Gua_Real va;
+    Gua_Real vb;
+    Gua_Real v;
+    Gua_Length i;
+    Gua_Length j;
+    Gua_Length ka;
+    Gua_Length kb;
+    
+    if (operation == MATRIX_SPARSE_MUL) {
+        c = Matrix_NewSparse(a->rows, a->cols, a->nnz < b->nnz ? a->nnz : b->nnz);
+    } else {
+        c = Matrix_NewSparse(a->rows, a->cols, a->nnz + b->nnz);
+    }
+    
+    for (i = 0; i < a->rows; i++) {
+        ka = a->rowp[i];
+        kb = b->rowp[i];
+        
+        while ((ka < a->rowp[i + 1]) || (kb < b->rowp[i + 1])) {
+            if ((kb == b->rowp[i + 1]) || ((ka < a->rowp[i + 1]) && (a->colind[ka] < b->colind[kb]))) {
+                j = a->colind[ka];
+                va = a->values[ka++];
+                vb = 0.0;
+            } else if ((ka == a->rowp[i + 1]) || (b->colind[kb] < a->colind[ka])) {
+                j = b->colind[kb];
+                va = 0.0;
+                vb = b->values[kb++];
+            } else {
+                j = a->colind[ka];
+                va = a->values[ka++];
+                vb = b->values[kb++];
+            }
+            
+            if (operation == MATRIX_SPARSE_ADD) {
+                v = va + vb;
+            } else if (operation == MATRIX_SPARSE_SUB) {
+                v = va - vb;
+            } else {
+                v = va * vb;
+            }
+            
+            if (v != 0.0) {
+                c->colind[c->nnz] = j;
+                c->values[c->nnz] = v;
+                c->nnz++;
+            }
+        }
+        
+        c->rowp[i + 1] = c->nnz;
+    }
+    
+    return c;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Matrix_Sparse *Matrix_SparseScale(Matrix_Sparse *a, Gua_Real alpha)
+ *
+ * Description:
+ *     Multiply a CSR matrix by a scalar.
+ *
+ * Arguments:
+ *     a,        the sparse matrix;
+ *     alpha,    the scalar.
+ *
+ * Results:
+ *     The new sparse matrix.
+ */
+Matrix_Sparse *Matrix_SparseScale(Matrix_Sparse *a, Gua_Real alpha)
+{
+    Matrix_Sparse *c;
+    Gua_Length k;
+    
+    if (alpha == 0.0) {
+        return Matrix_NewSparse(a->rows, a->cols, 0);
+    }
+    
+    c = Matrix_NewSparse(a->rows, a->cols, a->nnz);
+    
+    memcpy(c->rowp, a->rowp, (a->rows + 1) * sizeof(Gua_Length));
+    memcpy(c->colind, a->colind, a->nnz * sizeof(Gua_Length));
+    
+    for (k = 0; k < a->nnz; k++) {
+        c->values[k] = alpha * a->values[k];
+    }
+    
+    c->nnz = a->nnz;
+    
+    return c;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Matrix_Sparse *Matrix_GetSparse(Gua_Object *o)
+ *
+ * Description:
+ *     Get the sparse matrix referenced by a handle.
+ *
+ * Arguments:
+ *     o,    the handle object.
+ *
+ * Results:
+ *     The sparse matrix, or NULL if the object is not a sparse matrix
+ *     handle or the matrix was already freed.
+ */
+Matrix_Sparse *Matrix_GetSparse(Gua_Object *o)
+{
+    Gua_Handle *h;
+    
+    if (Gua_PObjectType(o) != OBJECT_TYPE_HANDLE) {
+        return NULL;
+    }
+    
+    h = (Gua_Handle *)Gua_PObjectToHandle(o);
+    
+    if (strcmp((Gua_String)Gua_GetHandleType(h), "Matrix_Sparse") != 0) {
+        return NULL;
+    }
+    
+    return (Matrix_Sparse *)Gua_GetHandlePointer(h);
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Matrix_SparseToPObject(Gua_Object *object, Matrix_Sparse *s)
+ *
+ * Description:
+ *     Return a sparse matrix as a handle. The matrix lives until sparseFree
+ *     is called on the handle.
+ *
+ * Arguments:
+ *     object,    the target object;
+ *     s,         the sparse matrix.
+ *
+ * Results:
+ *     The function stores a new handle in object.
+ */
+void Matrix_SparseToPObject(Gua_Object *object, Matrix_Sparse *s)
+{
+    Gua_Handle *h;
+    
+    Gua_NewHandle(h, "Matrix_Sparse", s);
+    
+    Gua_HandleToPObject(object, (struct Gua_Handle *)h);
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Real *Matrix_GetRealBuffer(Gua_Object *a, Gua_Length *rows, Gua_Length *cols)
+ *
+ * Description:
+ *     Copy a real matrix to a dense row-major buffer. A vector is taken as
+ *     a single column.
+ *
+ * Arguments:
+ *     a,       the matrix;
+ *     rows,    the number of rows found;
+ *     cols,    the number of columns found.
+ *
+ * Results:
+ *     The new buffer, or NULL if a is not a bidimensional matrix of
+ *     integer and real numbers.
+ */
+Gua_Real *Matrix_GetRealBuffer(Gua_Object *a, Gua_Length *rows, Gua_Length *cols)
+{
+    Gua_Matrix *m;
+    Gua_Real *x;
+    Gua_Short type;
+    
+    if (Gua_PObjectType(a) != OBJECT_TYPE_MATRIX) {
+        return NULL;
+    }
+    
+    m = (Gua_Matrix *)Gua_PObjectToMatrix(a);
+    
+    if ((m == NULL) || (m->dimc > 2)) {
+        return NULL;
+    }
+    
+    type = Gua_GetMatrixType((Gua_Object *)m->object, Gua_PObjectLength(a));
+    
+    if ((type != OBJECT_TYPE_INTEGER) && (type != OBJECT_TYPE_REAL)) {
+        return NULL;
+    }
+    
+    *rows = m->dimv[0];
+    *cols = m->dimc == 2 ? m->dimv[1] : 1;
+    
+    x = (Gua_Real *)Gua_Alloc((Gua_PObjectLength(a) + 1) * sizeof(Gua_Real));
+    
+    Gua_PackMatrix((Gua_Object *)m->object, Gua_PObjectLength(a), x, NULL);
+    
+    return x;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Matrix_RealBufferToPObject(Gua_Object *object, Gua_Real *x, Gua_Length rows, Gua_Length cols)
+ *
+ * Description:
+ *     Return a dense row-major buffer as a matrix of real numbers.
+ *
+ * Arguments:
+ *     object,    the target object;
+ *     x,         the dense buffer;
+ *     rows,      the number of rows;
+ *     cols,      the number of columns.
+ *
+ * Results:
+ *     The function stores a new matrix in object.
+ */
+void Matrix_RealBufferToPObject(Gua_Object *object, Gua_Real *x, Gua_Length rows, Gua_Length cols)
+{
+    Gua_Matrix *m;
+    
+    if (rows * cols == 0) {
+        return;
+    }
+    
+    Gua_MatrixToPObject(object, (struct Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix)), rows * cols);
+    m = (Gua_Matrix *)Gua_PObjectToMatrix(object);
+    m->dimc = 2;
+    m->dimv = (Gua_Length *)Gua_Alloc(2 * sizeof(Gua_Length));
+    m->dimv[0] = rows;
+    m->dimv[1] = cols;
+    m->object = (struct Gua_Object *)Gua_Alloc(rows * cols * sizeof(Gua_Object));
+    
+    Gua_UnpackMatrix((Gua_Object *)m->object, rows * cols, x, NULL);
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Matrix_SparseFromObjects(Gua_Object *i, Gua_Object *j, Gua_Object *v, Gua_Length rows, Gua_Length cols, Gua_Object *object, Gua_String error)
+ *
+ * Description:
+ *     Build a sparse matrix from matrices of row indices, column indices
+ *     and values.
+ *
+ * Arguments:
+ *     i,         a matrix with the row indices, from 0 to rows - 1;
+ *     j,         a matrix with the column indices, from 0 to cols - 1;
+ *     v,         a matrix with the values, or a number used for every element;
+ *     rows,      the number of rows;
+ *     cols,      the number of columns;
+ *     object,    a structure containing the return object of the function;
+ *     error,     a pointer to the error message.
+ *
+ * Results:
+ *     A handle to the new sparse matrix.
+ */
+Gua_Status Matrix_SparseFromObjects(Gua_Object *i, Gua_Object *j, Gua_Object *v, Gua_Length rows, Gua_Length cols, Gua_Object *object, Gua_String error)
+{
+    Gua_Real *x;
+    Gua_Real *y;
+    Gua_Real *z;
+    Gua_Length *ti;
+    Gua_Length *tj;
+    Gua_Length n;
+    Gua_Length r;
+    Gua_Length c;
+    Gua_Length k;
+    Gua_Short argument;
+    Gua_String errMessage;
+    
+    x = NULL;
+    y = NULL;
+    z = NULL;
+    n = 0;
+    argument = 0;
+    
+    x = Matrix_GetRealBuffer(i, &r, &c);
+    if (x == NULL) {
+        argument = 1;
+    } else {
+        n = r * c;
+        
+        y = Matrix_GetRealBuffer(j, &r, &c);
+        if ((y == NULL) || (r * c != n)) {
+            argument = 2;
+        } else if ((Gua_PObjectType(v) == OBJECT_TYPE_INTEGER) || (Gua_PObjectType(v) == OBJECT_TYPE_REAL)) {
+            z = (Gua_Real *)Gua_Alloc((n + 1) * sizeof(Gua_Real));
+            for (k = 0; k < n; k++) {
+                z[k] = Gua_PObjectType(v) == OBJECT_TYPE_INTEGER ? Gua_PObjectToInteger(v) : Gua_PObjectToReal(v);
+            }
+        } else {
+            z = Matrix_GetRealBuffer(v, &r, &c);
+            if ((z == NULL) || (r * c != n)) {
+                argument = 3;
+            }
+        }
+    }
+    
+    if (argument != 0) {
+        if (x != NULL) {
+            Gua_Free(x);
+        }
+        if (y != NULL) {
+            Gua_Free(y);
+        }
+        if (z != NULL) {
+            Gua_Free(z);
+        }
+        
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %d %s...\n", "illegal argument", argument, "for function sparse");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    ti = (Gua_Length *)Gua_Alloc((n + 1) * sizeof(Gua_Length));
+    tj = (Gua_Length *)Gua_Alloc((n + 1) * sizeof(Gua_Length));
+    
+    for (k = 0; k < n; k++) {
+        ti[k] = (Gua_Length)x[k];
+        tj[k] = (Gua_Length)y[k];
+        
+        if ((ti[k] != x[k]) || (tj[k] != y[k]) || (ti[k] < 0) || (ti[k] >= rows) || (tj[k] < 0) || (tj[k] >= cols)) {
+            Gua_Free(tj);
+            Gua_Free(ti);
+            Gua_Free(z);
+            Gua_Free(y);
+            Gua_Free(x);
+            
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "index out of bound");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+    }
+    
+    Matrix_SparseToPObject(object, Matrix_SparseFromTriplets(rows, cols, n, ti, tj, z, true));
+    
+    Gua_Free(tj);
+    Gua_Free(ti);
+    Gua_Free(z);
+    Gua_Free(y);
+    Gua_Free(x);
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Matrix_SparseMul(Gua_Object *a, Gua_Object *b, Gua_Object *object, Gua_String error)
+ *
+ * Description:
+ *     Multiply a sparse matrix by a sparse matrix, a dense matrix or a
+ *     number, in either order.
+ *
+ * Arguments:
+ *     a,         the first operand;
+ *     b,         the second operand;
+ *     object,    a structure containing the return object of the function;
+ *     error,     a pointer to the error message.
+ *
+ * Results:
+ *     A handle to a new sparse matrix for the product of two sparse matrices
+ *     or of a sparse matrix and a number; a dense matrix of real numbers for
+ *     the product of a sparse and a dense matrix.
+ */
+Gua_Status Matrix_SparseMul(Gua_Object *a, Gua_Object *b, Gua_Object *object, Gua_String error)
+{
+    Matrix_Sparse *sa;
+    Matrix_Sparse *sb;
+    Gua_Real *x;
+    Gua_Real *y;
+    Gua_Length rows;
+    Gua_Length cols;
+    Gua_String errMessage;
+    
+    sa = Matrix_GetSparse(a);
+    sb = Matrix_GetSparse(b);
+    
+    if ((sa != NULL) && (sb != NULL)) {
+        if (sa->cols != sb->rows) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "the matrices do not have compatible dimensions");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        Matrix_SparseToPObject(object, Matrix_SparseMulSparse(sa, sb));
+        
+        return GUA_OK;
+    }
+    
+    if ((sa != NULL) && ((Gua_PObjectType(b) == OBJECT_TYPE_INTEGER) || (Gua_PObjectType(b) == OBJECT_TYPE_REAL))) {
+        Matrix_SparseToPObject(object, Matrix_SparseScale(sa, Gua_PObjectType(b) == OBJECT_TYPE_INTEGER ? Gua_PObjectToInteger(b) : Gua_PObjectToReal(b)));
+        
+        return GUA_OK;
+    }
+    if ((sb != NULL) && ((Gua_PObjectType(a) == OBJECT_TYPE_INTEGER) || (Gua_PObjectType(a) == OBJECT_TYPE_REAL))) {
+        Matrix_SparseToPObject(object, Matrix_SparseScale(sb, Gua_PObjectType(a) == OBJECT_TYPE_INTEGER ? Gua_PObjectToInteger(a) : Gua_PObjectToReal(a)));
+        
+        return GUA_OK;
+    }
+    
+    x = NULL;
+    rows = 0;
+    cols = 0;
+    
+    if (sa != NULL) {
+        x = Matrix_GetRealBuffer(b, &rows, &cols);
+        if ((x != NULL) && (rows != sa->cols)) {
+            Gua_Free(x);
+            x = NULL;
+        }
+    } else if (sb != NULL) {
+        x = Matrix_GetRealBuffer(a, &rows, &cols);
+        /* A vector multiplies from the left as a row. */
+        if ((x != NULL) && (((Gua_Matrix *)Gua_PObjectToMatrix(a))->dimc == 1)) {
+            cols = rows;
+            rows = 1;
+        }
+        if ((x != NULL) && (cols != sb->rows)) {
+            Gua_Free(x);
+            x = NULL;
+        }
+    }
+    
+    if (x == NULL) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "illegal arguments for function sparseMul");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    if (sa != NULL) {
+        y = (Gua_Real *)Gua_Alloc((sa->rows * cols + 1) * sizeof(Gua_Real));
+        Matrix_SparseMulDense(sa, x, cols, y);
+        Matrix_RealBufferToPObject(object, y, sa->rows, cols);
+    } else {
+        y = (Gua_Real *)Gua_Alloc((rows * sb->cols + 1) * sizeof(Gua_Real));
+        Matrix_DenseMulSparse(x, rows, sb, y);
+        Matrix_RealBufferToPObject(object, y, rows, sb->cols);
+    }
+    
+    Gua_Free(y);
+    Gua_Free(x);
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Matrix_SparseElementwise(Gua_Object *a, Gua_Object *b, Gua_Short operation, Gua_Object *object, Gua_String error)
+ *
+ * Description:
+ *     Add, subtract or multiply two sparse matrices element by element.
+ *
+ * Arguments:
+ *     a,            the first sparse matrix;
+ *     b,            the second sparse matrix;
+ *     operation,    MATRIX_SPARSE_ADD, MATRIX_SPARSE_SUB or MATRIX_SPARSE_MUL;
+ *     object,       a structure containing the return object of the function;
+ *     error,        a pointer to the error message.
+ *
+ * Results:
+ *     A handle to the new sparse matrix.
+ */
+Gua_Status Matrix_SparseElementwise(Gua_Object *a, Gua_Object *b, Gua_Short operation, Gua_Object *object, Gua_String error)
+{
+    Matrix_Sparse *sa;
+    Matrix_Sparse *sb;
+    Gua_String errMessage;
+    
+    sa = Matrix_GetSparse(a);
+    sb = Matrix_GetSparse(b);
+    
+    if ((sa == NULL) || (sb == NULL)) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "illegal argument");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    if ((sa->rows != sb->rows) || (sa->cols != sb->cols)) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "the matrices do not have compatible dimensions");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    Matrix_SparseToPObject(object, Matrix_SparseCombine(sa, sb, operation));
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Matrix_MatrixFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object *argv, Gua_Object *object, Gua_String error)
+ *
+ * Description:
+ *     Matrix functions wrapper.
+ *
+ * Arguments:
+ *     nspace,    a pointer to a structure Gua_Namespace. Must do a cast before use it;
+ *     argc,      the number of arguments to pass to the function;
+ *     argv,      an array containing the arguments to the function;
+ *                argv[0] is the function name;
+ *     object,    a structure containing the return object of the function;
+ *     error,     a pointer to the error message.
+ *
+ * Results:
+ *     The return object of the wrapped funcion.
+ */
+Gua_Status Matrix_MatrixFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object *argv, Gua_Object *object, Gua_String error)
+{
+    Gua_Matrix *m;
+    Gua_Object *o;
+    Gua_Length length;
+    Gua_Integer i;
+    Gua_Integer j;
+    Gua_Length dimv[2];
+    Gua_Length rows;
+    Gua_Length cols;
+    Gua_Matrix shape;
+    Gua_Object target;
+    Gua_Real *x;
+    Matrix_Sparse *s;
+    Math_RandomState *state;
+    Gua_String errMessage;
+    
+    Gua_ClearPObject(object);
+
+    if (argc == 0) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s\n", "no function specified");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    if ((strcmp(Gua_ObjectToString(argv[0]), "argmax") == 0) || (strcmp(Gua_ObjectToString(argv[0]), "argmin") == 0)) {
+        if ((argc != 2) && (argc != 3)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if ((argc == 3) && !Matrix_IsAxis(argv[2])) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Matrix_Reduce(&argv[1], strcmp(Gua_ObjectToString(argv[0]), "argmax") == 0 ? MATRIX_REDUCE_ARGMAX : MATRIX_REDUCE_ARGMIN, argc == 3 ? Gua_ObjectToInteger(argv[2]) : -1, object, error) != GUA_OK) {
+            return GUA_ERROR;
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "avg") == 0) {
+        if ((argc != 2) && (argc != 3)) {
+            if (argc != 6) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+        }
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (argc == 3) {
+            if (!Matrix_IsAxis(argv[2])) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+        }
+        if (argc == 6) {
+            if (!((Gua_ObjectType(argv[2]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(argv[3]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(argv[4]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(argv[5]) == OBJECT_TYPE_INTEGER))) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "illegal argument for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+        }
+
+        if (argc == 2) {
+            if (Matrix_Avg(&argv[1], object, error) != GUA_OK) {
+                return GUA_ERROR;
+            }
+        } else if (argc == 3) {
+            if (Matrix_Reduce(&argv[1], MATRIX_REDUCE_AVG, Gua_ObjectToInteger(argv[2]), object, error) != GUA_OK) {
+                return GUA_ERROR;
+            }
+        } else if (argc == 6) {
+            Gua_MaterializeView(&argv[1]);
+            
+            if (Matrix_AvgCells(&argv[1], argv[2], argv[3], argv[4], argv[5], object, error) != GUA_OK) {
+                return GUA_ERROR;
+            }
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "count") == 0) {
+        if ((argc != 2) && (argc != 3)) {
+            if (argc != 6) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+        }
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (argc == 3) {
+            if (!Matrix_IsAxis(argv[2])) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+        }
+        if (argc == 6) {
+            if (!((Gua_ObjectType(argv[2]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(argv[3]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(argv[4]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(argv[5]) == OBJECT_TYPE_INTEGER))) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "illegal argument for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+        }
+
+        if (argc == 2) {
+            Gua_MaterializeView(&argv[1]);
+            
+            if (Matrix_Count(&argv[1], object, error) != GUA_OK) {
+                return GUA_ERROR;
+            }
+        } else if (argc == 3) {
+            if (Matrix_Reduce(&argv[1], MATRIX_REDUCE_COUNT, Gua_ObjectToInteger(argv[2]), object, error) != GUA_OK) {
+                return GUA_ERROR;
+            }
+        } else if (argc == 6) {
+            Gua_MaterializeView(&argv[1]);
+            
+            if (Matrix_CountCells(&argv[1], argv[2], argv[3], argv[4], argv[5], object, error) != GUA_OK) {
+                return GUA_ERROR;
+            }
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "cross") == 0) {
+        if (argc != 3) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (Gua_ObjectType(argv[2]) != OBJECT_TYPE_MATRIX) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Matrix_Cross(&argv[1], &argv[2], object, error) != GUA_OK) {
+            return GUA_ERROR;
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "delcol") == 0) {
+        if (argc != 3) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (Gua_ObjectType(argv[2]) != OBJECT_TYPE_INTEGER) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Matrix_DelCol(&argv[1], argv[2], object, error) != GUA_OK) {
+            return GUA_ERROR;
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "delrow") == 0) {
+        if (argc != 3) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (Gua_ObjectType(argv[2]) != OBJECT_TYPE_INTEGER) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Matrix_DelRow(&argv[1], argv[2], object, error) != GUA_OK) {
+            return GUA_ERROR;
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "det") == 0) {
+        if (argc != 2) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Matrix_DetMatrix(&argv[1], object, error) != GUA_OK) {
+            return GUA_ERROR;
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "diag") == 0) {
+        if (argc != 4) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (!((Gua_ObjectType(argv[1]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(argv[2]) == OBJECT_TYPE_INTEGER))) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (!((Gua_ObjectType(argv[3]) == OBJECT_TYPE_INTEGER) || (Gua_ObjectType(argv[3]) == OBJECT_TYPE_REAL) || (Gua_ObjectType(argv[3]) == OBJECT_TYPE_COMPLEX))) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 3 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        length = Gua_ObjectToInteger(argv[1]) * Gua_ObjectToInteger(argv[2]);
+        
+        Gua_MatrixToPObject(object, (struct Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix)), length);
+        
+        m = (Gua_Matrix *)Gua_PObjectToMatrix(object);
+        
+        m->dimc = 2;
+        m->dimv = Gua_Alloc(m->dimc * sizeof(Gua_Integer));
+        m->dimv[0] = Gua_ObjectToInteger(argv[1]);
+        m->dimv[1] = Gua_ObjectToInteger(argv[2]);
+        
+        if (length == 0) {
+            Gua_FreeObject(object);
+            Gua_Free(m->dimv);
+            return GUA_OK;
+        }
+        
+        m->object = (struct Gua_Object *)Gua_Alloc(length * sizeof(Gua_Object));
+        o = (Gua_Object *)m->object;
+        
+        for (i = 0; i < m->dimv[0]; i++) {
+            for (j = 0; j < m->dimv[1]; j++) {
+                if (i == j) {
+                    if (Gua_ObjectType(argv[3]) == OBJECT_TYPE_INTEGER) {
+                        Gua_IntegerToObject(o[i * m->dimv[1] + j], Gua_ObjectToInteger(argv[3]));
+                    } else if (Gua_ObjectType(argv[3]) == OBJECT_TYPE_REAL) {
+                        Gua_RealToObject(o[i * m->dimv[1] + j], Gua_ObjectToReal(argv[3]));
+                    } else {
+                        Gua_ComplexToObject(o[i * m->dimv[1] + j], Gua_ObjectToReal(argv[3]), Gua_ObjectToImaginary(argv[3]));
+                    }
+                } else {
+                    if (Gua_ObjectType(argv[3]) == OBJECT_TYPE_INTEGER) {
+                        Gua_IntegerToObject(o[i * m->dimv[1] + j], 0);
+                    } else if (Gua_ObjectType(argv[3]) == OBJECT_TYPE_REAL) {
+                        Gua_RealToObject(o[i * m->dimv[1] + j], 0.0);
+                    } else {
+                        Gua_RealToObject(o[i * m->dimv[1] + j], 0.0);
+                    }
+                }
+            }
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "dot") == 0) {
+        if (argc != 3) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (Gua_ObjectType(argv[2]) != OBJECT_TYPE_MATRIX) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Matrix_Dot(&argv[1], &argv[2], object, error) != GUA_OK) {
+            return GUA_ERROR;
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "gauss") == 0) {
+        if (argc != 2) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Matrix_GaussMatrix(&argv[1], object, error) == 0) {
+            return GUA_ERROR;
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "jordan") == 0) {
+        if (argc != 2) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Matrix_JordanMatrix(&argv[1], object, error) == 0) {
+            return GUA_ERROR;
+        }
+    } else if ((strcmp(Gua_ObjectToString(argv[0]), "loadcsv") == 0) || (strcmp(Gua_ObjectToString(argv[0]), "loadtxt") == 0)) {
+        if (strcmp(Gua_ObjectToString(argv[0]), "loadcsv") == 0) {
+            i = 3;
+        } else {
+            i = 4;
+        }
+        if ((argc < 2) || (argc > i)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_STRING) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        /* loadcsv(file, skiprows) and loadtxt(file, separator, skiprows). */
+        if (strcmp(Gua_ObjectToString(argv[0]), "loadcsv") == 0) {
+            j = 2;
+        } else {
+            if ((argc > 2) && (Gua_ObjectType(argv[2]) != OBJECT_TYPE_STRING)) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+            j = 3;
+        }
+        if ((argc > j) && (Gua_ObjectType(argv[j]) != OBJECT_TYPE_INTEGER)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %ld %s %-.20s...\n", "illegal argument", j, "for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Matrix_LoadText(Gua_ObjectToString(argv[1]), j == 2 ? "," : (argc > 2 ? Gua_ObjectToString(argv[2]) : " \t"), argc > j ? Gua_ObjectToInteger(argv[j]) : 0, object, error) != GUA_OK) {
+            return GUA_ERROR;
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "matrixLoad") == 0) {
+        if (argc != 2) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_STRING) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Matrix_Load(Gua_ObjectToString(argv[1]), object, error) != GUA_OK) {
+            return GUA_ERROR;
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "matrixSave") == 0) {
+        if (argc != 3) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (Gua_ObjectType(argv[2]) != OBJECT_TYPE_STRING) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Matrix_Save(&argv[1], Gua_ObjectToString(argv[2]), error) != GUA_OK) {
+            return GUA_ERROR;
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "matrixToSparse") == 0) {
         if (argc != 2) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        x = Matrix_GetRealBuffer(&argv[1], &rows, &cols);
+        if (x == NULL) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        Matrix_SparseToPObject(object, Matrix_DenseToSparse(x, rows, cols));
+        
+        Gua_Free(x);
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "max") == 0) {
+        if ((argc != 2) && (argc != 3)) {
             if (argc != 6) {
                 errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
                 sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
@@ -2013,6 +4898,16 @@ Gua_Status Matrix_MatrixFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object
             
             return GUA_ERROR;
         }
+        if (argc == 3) {
+            if (!Matrix_IsAxis(argv[2])) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+        }
         if (argc == 6) {
             if (!((Gua_ObjectType(argv[2]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(argv[3]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(argv[4]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(argv[5]) == OBJECT_TYPE_INTEGER))) {
                 errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
@@ -2023,18 +4918,26 @@ Gua_Status Matrix_MatrixFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object
                 return GUA_ERROR;
             }
         }
-
+        
         if (argc == 2) {
-            if (Matrix_Avg(&argv[1], object, error) != GUA_OK) {
+            Gua_MaterializeView(&argv[1]);
+            
+            if (Matrix_Max(&argv[1], object, error) != GUA_OK) {
+                return GUA_ERROR;
+            }
+        } else if (argc == 3) {
+            if (Matrix_Reduce(&argv[1], MATRIX_REDUCE_MAX, Gua_ObjectToInteger(argv[2]), object, error) != GUA_OK) {
                 return GUA_ERROR;
             }
         } else if (argc == 6) {
-            if (Matrix_AvgCells(&argv[1], argv[2], argv[3], argv[4], argv[5], object, error) != GUA_OK) {
+            Gua_MaterializeView(&argv[1]);
+            
+            if (Matrix_MaxCells(&argv[1], argv[2], argv[3], argv[4], argv[5], object, error) != GUA_OK) {
                 return GUA_ERROR;
             }
         }
-    } else if (strcmp(Gua_ObjectToString(argv[0]), "count") == 0) {
-        if (argc != 2) {
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "min") == 0) {
+        if ((argc != 2) && (argc != 3)) {
             if (argc != 6) {
                 errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
                 sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
@@ -2052,6 +4955,16 @@ Gua_Status Matrix_MatrixFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object
             
             return GUA_ERROR;
         }
+        if (argc == 3) {
+            if (!Matrix_IsAxis(argv[2])) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+        }
         if (argc == 6) {
             if (!((Gua_ObjectType(argv[2]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(argv[3]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(argv[4]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(argv[5]) == OBJECT_TYPE_INTEGER))) {
                 errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
@@ -2064,15 +4977,23 @@ Gua_Status Matrix_MatrixFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object
         }
 
         if (argc == 2) {
-            if (Matrix_Count(&argv[1], object, error) != GUA_OK) {
+            Gua_MaterializeView(&argv[1]);
+            
+            if (Matrix_Min(&argv[1], object, error) != GUA_OK) {
+                return GUA_ERROR;
+            }
+        } else if (argc == 3) {
+            if (Matrix_Reduce(&argv[1], MATRIX_REDUCE_MIN, Gua_ObjectToInteger(argv[2]), object, error) != GUA_OK) {
                 return GUA_ERROR;
             }
         } else if (argc == 6) {
-            if (Matrix_CountCells(&argv[1], argv[2], argv[3], argv[4], argv[5], object, error) != GUA_OK) {
+            Gua_MaterializeView(&argv[1]);
+            
+            if (Matrix_MinCells(&argv[1], argv[2], argv[3], argv[4], argv[5], object, error) != GUA_OK) {
                 return GUA_ERROR;
             }
         }
-    } else if (strcmp(Gua_ObjectToString(argv[0]), "cross") == 0) {
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "one") == 0) {
         if (argc != 3) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
             sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
@@ -2081,29 +5002,93 @@ Gua_Status Matrix_MatrixFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object
             
             return GUA_ERROR;
         }
+        if (!((Gua_ObjectType(argv[1]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(argv[2]) == OBJECT_TYPE_INTEGER))) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
         
-        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
+        length = Gua_ObjectToInteger(argv[1]) * Gua_ObjectToInteger(argv[2]);
+        
+        Gua_MatrixToPObject(object, (struct Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix)), length);
+        
+        m = (Gua_Matrix *)Gua_PObjectToMatrix(object);
+        
+        m->dimc = 2;
+        m->dimv = Gua_Alloc(m->dimc * sizeof(Gua_Integer));
+        m->dimv[0] = Gua_ObjectToInteger(argv[1]);
+        m->dimv[1] = Gua_ObjectToInteger(argv[2]);
+        
+        if (length == 0) {
+            Gua_FreeObject(object);
+            Gua_Free(m->dimv);
+            return GUA_OK;
+        }
+        
+        m->object = (struct Gua_Object *)Gua_Alloc(length * sizeof(Gua_Object));
+        o = (Gua_Object *)m->object;
+        
+        for (i = 0; i < length; i++) {
+            Gua_RealToObject(o[i], 1.0);
+        }
+    } else if ((strcmp(Gua_ObjectToString(argv[0]), "rand") == 0) || (strcmp(Gua_ObjectToString(argv[0]), "rande") == 0) || (strcmp(Gua_ObjectToString(argv[0]), "randn") == 0)) {
+        if (argc != 3) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
             Gua_Free(errMessage);
             
             return GUA_ERROR;
         }
-        if (Gua_ObjectType(argv[2]) != OBJECT_TYPE_MATRIX) {
+        if (!((Gua_ObjectType(argv[1]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(argv[2]) == OBJECT_TYPE_INTEGER))) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
             Gua_Free(errMessage);
             
             return GUA_ERROR;
         }
         
-        if (Matrix_Cross(&argv[1], &argv[2], object, error) != GUA_OK) {
-            return GUA_ERROR;
+        length = Gua_ObjectToInteger(argv[1]) * Gua_ObjectToInteger(argv[2]);
+        
+        Gua_MatrixToPObject(object, (struct Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix)), length);
+        
+        m = (Gua_Matrix *)Gua_PObjectToMatrix(object);
+        
+        m->dimc = 2;
+        m->dimv = Gua_Alloc(m->dimc * sizeof(Gua_Integer));
+        m->dimv[0] = Gua_ObjectToInteger(argv[1]);
+        m->dimv[1] = Gua_ObjectToInteger(argv[2]);
+        
+        if (length == 0) {
+            Gua_FreeObject(object);
+            Gua_Free(m->dimv);
+            return GUA_OK;
         }
-    } else if (strcmp(Gua_ObjectToString(argv[0]), "delcol") == 0) {
-        if (argc != 3) {
+        
+        m->object = (struct Gua_Object *)Gua_Alloc(length * sizeof(Gua_Object));
+        o = (Gua_Object *)m->object;
+        
+        state = Math_GetRandomState();
+        
+        if (strcmp(Gua_ObjectToString(argv[0]), "randn") == 0) {
+            for (i = 0; i < length; i++) {
+                Gua_RealToObject(o[i], Math_NormalRandom(state));
+            }
+        } else if (strcmp(Gua_ObjectToString(argv[0]), "rande") == 0) {
+            for (i = 0; i < length; i++) {
+                Gua_RealToObject(o[i], Math_ExponentialRandom(state));
+            }
+        } else {
+            for (i = 0; i < length; i++) {
+                Gua_RealToObject(o[i], Math_UniformRandom(state));
+            }
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "reshape") == 0) {
+        if ((argc != 3) && (argc != 4)) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
             sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
@@ -2120,20 +5105,24 @@ Gua_Status Matrix_MatrixFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object
             
             return GUA_ERROR;
         }
-        if (Gua_ObjectType(argv[2]) != OBJECT_TYPE_INTEGER) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
-            return GUA_ERROR;
+        
+        for (i = 2; i < argc; i++) {
+            if ((Gua_ObjectType(argv[i]) != OBJECT_TYPE_INTEGER) || (Gua_ObjectToInteger(argv[i]) < 0)) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %ld %s %-.20s...\n", "illegal argument", i, "for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+            dimv[i - 2] = Gua_ObjectToInteger(argv[i]);
         }
         
-        if (Matrix_DelCol(&argv[1], argv[2], object, error) != GUA_OK) {
+        if (Matrix_Reshape(&argv[1], argc - 2, dimv, object, error) != GUA_OK) {
             return GUA_ERROR;
         }
-    } else if (strcmp(Gua_ObjectToString(argv[0]), "delrow") == 0) {
-        if (argc != 3) {
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "savetxt") == 0) {
+        if ((argc != 3) && (argc != 4)) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
             sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
@@ -2150,7 +5139,7 @@ Gua_Status Matrix_MatrixFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object
             
             return GUA_ERROR;
         }
-        if (Gua_ObjectType(argv[2]) != OBJECT_TYPE_INTEGER) {
+        if (Gua_ObjectType(argv[2]) != OBJECT_TYPE_STRING) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
             sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
@@ -2158,34 +5147,44 @@ Gua_Status Matrix_MatrixFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object
             
             return GUA_ERROR;
         }
-        
-        if (Matrix_DelRow(&argv[1], argv[2], object, error) != GUA_OK) {
-            return GUA_ERROR;
-        }
-    } else if (strcmp(Gua_ObjectToString(argv[0]), "det") == 0) {
-        if (argc != 2) {
+        if ((argc > 3) && (Gua_ObjectType(argv[3]) != OBJECT_TYPE_STRING)) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 3 for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
             Gua_Free(errMessage);
             
             return GUA_ERROR;
         }
         
-        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
+        if (Matrix_SaveText(&argv[1], Gua_ObjectToString(argv[2]), argc > 3 ? Gua_ObjectToString(argv[3]) : " ", error) != GUA_OK) {
+            return GUA_ERROR;
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "sparse") == 0) {
+        if (argc != 6) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
             Gua_Free(errMessage);
             
             return GUA_ERROR;
         }
         
-        if (Matrix_DetMatrix(&argv[1], object, error) != GUA_OK) {
+        for (i = 4; i < 6; i++) {
+            if ((Gua_ObjectType(argv[i]) != OBJECT_TYPE_INTEGER) || (Gua_ObjectToInteger(argv[i]) < 0)) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %ld %s %-.20s...\n", "illegal argument", i, "for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+        }
+        
+        if (Matrix_SparseFromObjects(&argv[1], &argv[2], &argv[3], Gua_ObjectToInteger(argv[4]), Gua_ObjectToInteger(argv[5]), object, error) != GUA_OK) {
             return GUA_ERROR;
         }
-    } else if (strcmp(Gua_ObjectToString(argv[0]), "diag") == 0) {
-        if (argc != 4) {
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "sparseAdd") == 0) {
+        if (argc != 3) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
             sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
@@ -2193,65 +5192,40 @@ Gua_Status Matrix_MatrixFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object
             
             return GUA_ERROR;
         }
-        if (!((Gua_ObjectType(argv[1]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(argv[2]) == OBJECT_TYPE_INTEGER))) {
+        
+        if (Matrix_SparseElementwise(&argv[1], &argv[2], MATRIX_SPARSE_ADD, object, error) != GUA_OK) {
+            return GUA_ERROR;
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "sparseDim") == 0) {
+        if (argc != 2) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "illegal argument for function", Gua_ObjectToString(argv[0]));
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
             Gua_Free(errMessage);
             
             return GUA_ERROR;
         }
-        if (!((Gua_ObjectType(argv[3]) == OBJECT_TYPE_INTEGER) || (Gua_ObjectType(argv[3]) == OBJECT_TYPE_REAL) || (Gua_ObjectType(argv[3]) == OBJECT_TYPE_COMPLEX))) {
+        
+        s = Matrix_GetSparse(&argv[1]);
+        if (s == NULL) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 3 for function", Gua_ObjectToString(argv[0]));
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
             Gua_Free(errMessage);
             
             return GUA_ERROR;
         }
         
-        length = Gua_ObjectToInteger(argv[1]) * Gua_ObjectToInteger(argv[2]);
-        
-        Gua_MatrixToPObject(object, (struct Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix)), length);
-        
-        m = (Gua_Matrix *)Gua_PObjectToMatrix(object);
-        
-        m->dimc = 2;
-        m->dimv = Gua_Alloc(m->dimc * sizeof(Gua_Integer));
-        m->dimv[0] = Gua_ObjectToInteger(argv[1]);
-        m->dimv[1] = Gua_ObjectToInteger(argv[2]);
-        
-        if (length == 0) {
-            Gua_FreeObject(object);
-            Gua_Free(m->dimv);
-            return GUA_OK;
-        }
-        
-        m->object = (struct Gua_Object *)Gua_Alloc(length * sizeof(Gua_Object));
-        o = (Gua_Object *)m->object;
+        /* Report the dimensions the same way dim does for a matrix. */
+        dimv[0] = s->rows;
+        dimv[1] = s->cols;
+        shape.dimc = 2;
+        shape.dimv = dimv;
+        shape.object = NULL;
+        Gua_MatrixToObject(target, (struct Gua_Matrix *)&shape, 0);
         
-        for (i = 0; i < m->dimv[0]; i++) {
-            for (j = 0; j < m->dimv[1]; j++) {
-                if (i == j) {
-                    if (Gua_ObjectType(argv[3]) == OBJECT_TYPE_INTEGER) {
-                        Gua_IntegerToObject(o[i * m->dimv[1] + j], Gua_ObjectToInteger(argv[3]));
-                    } else if (Gua_ObjectType(argv[3]) == OBJECT_TYPE_REAL) {
-                        Gua_RealToObject(o[i * m->dimv[1] + j], Gua_ObjectToReal(argv[3]));
-                    } else {
-                        Gua_ComplexToObject(o[i * m->dimv[1] + j], Gua_ObjectToReal(argv[3]), Gua_ObjectToImaginary(argv[3]));
-                    }
-                } else {
-                    if (Gua_ObjectType(argv[3]) == OBJECT_TYPE_INTEGER) {
-                        Gua_IntegerToObject(o[i * m->dimv[1] + j], 0);
-                    } else if (Gua_ObjectType(argv[3]) == OBJECT_TYPE_REAL) {
-                        Gua_RealToObject(o[i * m->dimv[1] + j], 0.0);
-                    } else {
-                        Gua_RealToObject(o[i * m->dimv[1] + j], 0.0);
-                    }
-                }
-            }
-        }
-    } else if (strcmp(Gua_ObjectToString(argv[0]), "dot") == 0) {
+        Gua_GetMatrixDim(object, &target);
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "sparseEmul") == 0) {
         if (argc != 3) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
             sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
@@ -2261,49 +5235,46 @@ Gua_Status Matrix_MatrixFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object
             return GUA_ERROR;
         }
         
-        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
-            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
-            strcat(error, errMessage);
-            Gua_Free(errMessage);
-            
+        if (Matrix_SparseElementwise(&argv[1], &argv[2], MATRIX_SPARSE_MUL, object, error) != GUA_OK) {
             return GUA_ERROR;
         }
-        if (Gua_ObjectType(argv[2]) != OBJECT_TYPE_MATRIX) {
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "sparseFree") == 0) {
+        if (argc != 2) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
             Gua_Free(errMessage);
             
             return GUA_ERROR;
         }
         
-        if (Matrix_Dot(&argv[1], &argv[2], object, error) != GUA_OK) {
-            return GUA_ERROR;
-        }
-    } else if (strcmp(Gua_ObjectToString(argv[0]), "gauss") == 0) {
-        if (argc != 2) {
+        s = Matrix_GetSparse(&argv[1]);
+        if (s == NULL) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
             Gua_Free(errMessage);
             
             return GUA_ERROR;
         }
         
-        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
+        Matrix_FreeSparse(s);
+        
+        Gua_SetHandlePointer((Gua_Handle *)Gua_ObjectToHandle(argv[1]), NULL);
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "sparseMul") == 0) {
+        if (argc != 3) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
             Gua_Free(errMessage);
             
             return GUA_ERROR;
         }
         
-        if (Matrix_GaussMatrix(&argv[1], object, error) == 0) {
+        if (Matrix_SparseMul(&argv[1], &argv[2], object, error) != GUA_OK) {
             return GUA_ERROR;
         }
-    } else if (strcmp(Gua_ObjectToString(argv[0]), "jordan") == 0) {
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "sparseNnz") == 0) {
         if (argc != 2) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
             sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
@@ -2313,7 +5284,8 @@ Gua_Status Matrix_MatrixFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object
             return GUA_ERROR;
         }
         
-        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
+        s = Matrix_GetSparse(&argv[1]);
+        if (s == NULL) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
             sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
@@ -2322,60 +5294,32 @@ Gua_Status Matrix_MatrixFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object
             return GUA_ERROR;
         }
         
-        if (Matrix_JordanMatrix(&argv[1], object, error) == 0) {
-            return GUA_ERROR;
-        }
-    } else if (strcmp(Gua_ObjectToString(argv[0]), "max") == 0) {
-        if (argc != 2) {
-            if (argc != 6) {
-                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-                sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
-                strcat(error, errMessage);
-                Gua_Free(errMessage);
-                
-                return GUA_ERROR;
-            }
-        }
-        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
+        Gua_IntegerToPObject(object, s->nnz);
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "sparseSub") == 0) {
+        if (argc != 3) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
             Gua_Free(errMessage);
             
             return GUA_ERROR;
         }
-        if (argc == 6) {
-            if (!((Gua_ObjectType(argv[2]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(argv[3]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(argv[4]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(argv[5]) == OBJECT_TYPE_INTEGER))) {
-                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-                sprintf(errMessage, "%s %-.20s...\n", "illegal argument for function", Gua_ObjectToString(argv[0]));
-                strcat(error, errMessage);
-                Gua_Free(errMessage);
-                
-                return GUA_ERROR;
-            }
-        }
         
-        if (argc == 2) {
-            if (Matrix_Max(&argv[1], object, error) != GUA_OK) {
-                return GUA_ERROR;
-            }
-        } else if (argc == 6) {
-            if (Matrix_MaxCells(&argv[1], argv[2], argv[3], argv[4], argv[5], object, error) != GUA_OK) {
-                return GUA_ERROR;
-            }
+        if (Matrix_SparseElementwise(&argv[1], &argv[2], MATRIX_SPARSE_SUB, object, error) != GUA_OK) {
+            return GUA_ERROR;
         }
-    } else if (strcmp(Gua_ObjectToString(argv[0]), "min") == 0) {
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "sparseToMatrix") == 0) {
         if (argc != 2) {
-            if (argc != 6) {
-                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-                sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
-                strcat(error, errMessage);
-                Gua_Free(errMessage);
-                
-                return GUA_ERROR;
-            }
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
         }
-        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
+        
+        s = Matrix_GetSparse(&argv[1]);
+        if (s == NULL) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
             sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
@@ -2383,28 +5327,15 @@ Gua_Status Matrix_MatrixFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object
             
             return GUA_ERROR;
         }
-        if (argc == 6) {
-            if (!((Gua_ObjectType(argv[2]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(argv[3]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(argv[4]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(argv[5]) == OBJECT_TYPE_INTEGER))) {
-                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-                sprintf(errMessage, "%s %-.20s...\n", "illegal argument for function", Gua_ObjectToString(argv[0]));
-                strcat(error, errMessage);
-                Gua_Free(errMessage);
-                
-                return GUA_ERROR;
-            }
-        }
-
-        if (argc == 2) {
-            if (Matrix_Min(&argv[1], object, error) != GUA_OK) {
-                return GUA_ERROR;
-            }
-        } else if (argc == 6) {
-            if (Matrix_MinCells(&argv[1], argv[2], argv[3], argv[4], argv[5], object, error) != GUA_OK) {
-                return GUA_ERROR;
-            }
-        }
-    } else if (strcmp(Gua_ObjectToString(argv[0]), "one") == 0) {
-        if (argc != 3) {
+        
+        x = (Gua_Real *)Gua_Alloc((s->rows * s->cols + 1) * sizeof(Gua_Real));
+        
+        Matrix_SparseToDense(s, x);
+        Matrix_RealBufferToPObject(object, x, s->rows, s->cols);
+        
+        Gua_Free(x);
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "sparseTrans") == 0) {
+        if (argc != 2) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
             sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
@@ -2412,40 +5343,20 @@ Gua_Status Matrix_MatrixFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object
             
             return GUA_ERROR;
         }
-        if (!((Gua_ObjectType(argv[1]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(argv[2]) == OBJECT_TYPE_INTEGER))) {
+        
+        s = Matrix_GetSparse(&argv[1]);
+        if (s == NULL) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "illegal argument for function", Gua_ObjectToString(argv[0]));
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
             Gua_Free(errMessage);
             
             return GUA_ERROR;
         }
         
-        length = Gua_ObjectToInteger(argv[1]) * Gua_ObjectToInteger(argv[2]);
-        
-        Gua_MatrixToPObject(object, (struct Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix)), length);
-        
-        m = (Gua_Matrix *)Gua_PObjectToMatrix(object);
-        
-        m->dimc = 2;
-        m->dimv = Gua_Alloc(m->dimc * sizeof(Gua_Integer));
-        m->dimv[0] = Gua_ObjectToInteger(argv[1]);
-        m->dimv[1] = Gua_ObjectToInteger(argv[2]);
-        
-        if (length == 0) {
-            Gua_FreeObject(object);
-            Gua_Free(m->dimv);
-            return GUA_OK;
-        }
-        
-        m->object = (struct Gua_Object *)Gua_Alloc(length * sizeof(Gua_Object));
-        o = (Gua_Object *)m->object;
-        
-        for (i = 0; i < length; i++) {
-            Gua_RealToObject(o[i], 1.0);
-        }
-    } else if (strcmp(Gua_ObjectToString(argv[0]), "rand") == 0) {
-        if (argc != 3) {
+        Matrix_SparseToPObject(object, Matrix_SparseTranspose(s));
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "sparseTriplets") == 0) {
+        if (argc != 2) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
             sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
@@ -2453,44 +5364,40 @@ Gua_Status Matrix_MatrixFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object
             
             return GUA_ERROR;
         }
-        if (!((Gua_ObjectType(argv[1]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(argv[2]) == OBJECT_TYPE_INTEGER))) {
+        
+        s = Matrix_GetSparse(&argv[1]);
+        if (s == NULL) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s %-.20s...\n", "illegal argument for function", Gua_ObjectToString(argv[0]));
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
             Gua_Free(errMessage);
             
             return GUA_ERROR;
         }
         
-        length = Gua_ObjectToInteger(argv[1]) * Gua_ObjectToInteger(argv[2]);
-        
-        Gua_MatrixToPObject(object, (struct Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix)), length);
-        
-        m = (Gua_Matrix *)Gua_PObjectToMatrix(object);
-        
-        m->dimc = 2;
-        m->dimv = Gua_Alloc(m->dimc * sizeof(Gua_Integer));
-        m->dimv[0] = Gua_ObjectToInteger(argv[1]);
-        m->dimv[1] = Gua_ObjectToInteger(argv[2]);
-        
-        if (length == 0) {
-            Gua_FreeObject(object);
-            Gua_Free(m->dimv);
+        if (s->nnz == 0) {
             return GUA_OK;
         }
         
-        m->object = (struct Gua_Object *)Gua_Alloc(length * sizeof(Gua_Object));
+        /* One row i, j, v per nonzero element, in row order. */
+        Gua_MatrixToPObject(object, (struct Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix)), s->nnz * 3);
+        m = (Gua_Matrix *)Gua_PObjectToMatrix(object);
+        m->dimc = 2;
+        m->dimv = (Gua_Length *)Gua_Alloc(2 * sizeof(Gua_Length));
+        m->dimv[0] = s->nnz;
+        m->dimv[1] = 3;
+        m->object = (struct Gua_Object *)Gua_Alloc(s->nnz * 3 * sizeof(Gua_Object));
         o = (Gua_Object *)m->object;
         
-        for (i = 0; i < length; i++) {
-#ifdef _WINDOWS_
-            Gua_RealToObject(o[i], (1.0 * (rand() / (RAND_MAX + 1.0))));
-#else
-            Gua_RealToObject(o[i], (1.0 * (random() / (RAND_MAX + 1.0))));
-#endif
+        for (i = 0; i < s->rows; i++) {
+            for (j = s->rowp[i]; j < s->rowp[i + 1]; j++) {
+                Gua_IntegerToObject(o[j * 3], i);
+                Gua_IntegerToObject(o[j * 3 + 1], s->colind[j]);
+                Gua_RealToObject(o[j * 3 + 2], s->values[j]);
+            }
         }
     } else if (strcmp(Gua_ObjectToString(argv[0]), "sum") == 0) {
-        if (argc != 2) {
+        if ((argc != 2) && (argc != 3)) {
             if (argc != 6) {
                 errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
                 sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
@@ -2508,6 +5415,16 @@ Gua_Status Matrix_MatrixFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object
             
             return GUA_ERROR;
         }
+        if (argc == 3) {
+            if (!Matrix_IsAxis(argv[2])) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+        }
         if (argc == 6) {
             if (!((Gua_ObjectType(argv[2]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(argv[3]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(argv[4]) == OBJECT_TYPE_INTEGER) && (Gua_ObjectType(argv[5]) == OBJECT_TYPE_INTEGER))) {
                 errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
@@ -2523,13 +5440,19 @@ Gua_Status Matrix_MatrixFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object
             if (Matrix_Sum(&argv[1], object, error) != GUA_OK) {
                 return GUA_ERROR;
             }
+        } else if (argc == 3) {
+            if (Matrix_Reduce(&argv[1], MATRIX_REDUCE_SUM, Gua_ObjectToInteger(argv[2]), object, error) != GUA_OK) {
+                return GUA_ERROR;
+            }
         } else if (argc == 6) {
+            Gua_MaterializeView(&argv[1]);
+            
             if (Matrix_SumCells(&argv[1], argv[2], argv[3], argv[4], argv[5], object, error) != GUA_OK) {
                 return GUA_ERROR;
             }
         }
     } else if (strcmp(Gua_ObjectToString(argv[0]), "sum2") == 0) {
-        if (argc != 2) {
+        if ((argc != 2) && (argc != 3)) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
             sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
@@ -2545,10 +5468,24 @@ Gua_Status Matrix_MatrixFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object
             
             return GUA_ERROR;
         }
-        
-        if (Matrix_Sum2(&argv[1], object, error) != GUA_OK) {
+        if ((argc == 3) && !Matrix_IsAxis(argv[2])) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
             return GUA_ERROR;
         }
+        
+        if (argc == 2) {
+            if (Matrix_Sum2(&argv[1], object, error) != GUA_OK) {
+                return GUA_ERROR;
+            }
+        } else if (argc == 3) {
+            if (Matrix_Reduce(&argv[1], MATRIX_REDUCE_SUM2, Gua_ObjectToInteger(argv[2]), object, error) != GUA_OK) {
+                return GUA_ERROR;
+            }
+        }
     } else if (strcmp(Gua_ObjectToString(argv[0]), "trans") == 0) {
         if (argc != 2) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
@@ -2640,17 +5577,32 @@ Gua_Status Matrix_MatrixFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object
 Gua_Status Matrix_Init(void *nspace, int argc, char *argv[], char **env, Gua_String error)
 {
     Gua_Function function;
+    Gua_Function view;
     Gua_Object object;
     Gua_String errMessage;
     
     Gua_LinkCFunctionToFunction(function, Matrix_MatrixFunctionWrapper);
-    if (Gua_SetFunction((Gua_Namespace *)nspace, "avg", &function) != GUA_OK) {
+    /* The reductions read slices of a matrix as views. */
+    Gua_LinkCViewFunctionToFunction(view, Matrix_MatrixFunctionWrapper);
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "argmax", &view) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "argmax");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "argmin", &view) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "argmin");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "avg", &view) != GUA_OK) {
         errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
         sprintf(errMessage, "%s %-.20s...\n", "can't set function", "avg");
         strcat(error, errMessage);
         Gua_Free(errMessage);
     }
-    if (Gua_SetFunction((Gua_Namespace *)nspace, "count", &function) != GUA_OK) {
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "count", &view) != GUA_OK) {
         errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
         sprintf(errMessage, "%s %-.20s...\n", "can't set function", "count");
         strcat(error, errMessage);
@@ -2704,13 +5656,43 @@ Gua_Status Matrix_Init(void *nspace, int argc, char *argv[], char **env, Gua_Str
         strcat(error, errMessage);
         Gua_Free(errMessage);
     }
-    if (Gua_SetFunction((Gua_Namespace *)nspace, "max", &function) != GUA_OK) {
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "loadcsv", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "loadcsv");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "loadtxt", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "loadtxt");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "matrixLoad", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "matrixLoad");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "matrixSave", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "matrixSave");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "matrixToSparse", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "matrixToSparse");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "max", &view) != GUA_OK) {
         errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
         sprintf(errMessage, "%s %-.20s...\n", "can't set function", "max");
         strcat(error, errMessage);
         Gua_Free(errMessage);
     }
-    if (Gua_SetFunction((Gua_Namespace *)nspace, "min", &function) != GUA_OK) {
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "min", &view) != GUA_OK) {
         errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
         sprintf(errMessage, "%s %-.20s...\n", "can't set function", "min");
         strcat(error, errMessage);
@@ -2728,13 +5710,103 @@ Gua_Status Matrix_Init(void *nspace, int argc, char *argv[], char **env, Gua_Str
         strcat(error, errMessage);
         Gua_Free(errMessage);
     }
-    if (Gua_SetFunction((Gua_Namespace *)nspace, "sum", &function) != GUA_OK) {
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "rande", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "rande");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "randn", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "randn");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "reshape", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "reshape");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "savetxt", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "savetxt");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "sparse", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "sparse");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "sparseAdd", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "sparseAdd");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "sparseDim", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "sparseDim");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "sparseEmul", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "sparseEmul");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "sparseFree", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "sparseFree");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "sparseMul", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "sparseMul");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "sparseNnz", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "sparseNnz");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "sparseSub", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "sparseSub");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "sparseToMatrix", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "sparseToMatrix");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "sparseTrans", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "sparseTrans");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "sparseTriplets", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "sparseTriplets");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "sum", &view) != GUA_OK) {
         errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
         sprintf(errMessage, "%s %-.20s...\n", "can't set function", "sum");
         strcat(error, errMessage);
         Gua_Free(errMessage);
     }
-    if (Gua_SetFunction((Gua_Namespace *)nspace, "sum2", &function) != GUA_OK) {
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "sum2", &view) != GUA_OK) {
         errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
         sprintf(errMessage, "%s %-.20s...\n", "can't set function", "sum2");
         strcat(error, errMessage);
@@ -27,6 +27,7 @@
  *
  */
 
+#include <float.h>
 #include <limits.h>
 #include <math.h>
 #include <stdlib.h>
@@ -222,41 +223,5221 @@ Gua_Status Numeric_GaussLSS(Gua_Object *a, Gua_Object *b, Gua_Object *x, Gua_Str
  *     C
  *
  * Function:
- *     Gua_Status Numeric_NumericFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object *argv, Gua_Object *object, Gua_String error)
+ *     Gua_Real Numeric_Dot(Gua_Real *x, Gua_Real *y, Gua_Length n)
  *
  * Description:
- *     Numeric computation functions wrapper.
+ *     Calculate the dot product of two vectors.
  *
  * Arguments:
- *     nspace,    a pointer to a structure Gua_Namespace. Must do a cast before use it;
- *     argc,      the number of arguments to pass to the function;
- *     argv,      an array containing the arguments to the function;
- *                argv[0] is the function name;
- *     object,    a structure containing the return object of the function;
- *     error,     a pointer to the error message.
+ *     x,    the first vector;
+ *     y,    the second vector;
+ *     n,    the number of elements.
  *
  * Results:
- *     The return object of the wrapped function.
+ *     The dot product.
  */
-Gua_Status Numeric_NumericFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object *argv, Gua_Object *object, Gua_String error)
+Gua_Real Numeric_Dot(Gua_Real *x, Gua_Real *y, Gua_Length n)
 {
-    Gua_Real eps;
-    Gua_Matrix *m1;
-    Gua_Matrix *m2;
+    Gua_Real s0;
+    Gua_Real s1;
+    Gua_Real s2;
+    Gua_Real s3;
+    Gua_Length i;
+    
+    /* Four partial sums, so that the additions do not wait on each other. */
+    s0 = 0.0;
+    s1 = 0.0;
+    s2 = 0.0;
+    s3 = 0.0;
+    for (i = 0; i + 3 < n; i += 4) {
+        s0 += x[i] * y[i];
+        s1 += x[i + 1] * y[i + 1];
+        s2 += x[i + 2] * y[i + 2];
+        s3 += x[i + 3] * y[i + 3];
+    }
+    for (; i < n; i++) {
+        s0 += x[i] * y[i];
+    }
+    
+    return (s0 + s1) + (s2 + s3);
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Real Numeric_Norm(Gua_Real *x, Gua_Length n)
+ *
+ * Description:
+ *     Calculate the Euclidean norm of a vector. The elements are scaled by
+ *     the largest magnitude first, so the squares neither overflow nor
+ *     underflow.
+ *
+ * Arguments:
+ *     x,    the vector;
+ *     n,    the number of elements.
+ *
+ * Results:
+ *     The norm.
+ */
+Gua_Real Numeric_Norm(Gua_Real *x, Gua_Length n)
+{
+    Gua_Real scale;
+    Gua_Real sum;
+    Gua_Real t;
+    Gua_Length i;
+    
+    scale = 0.0;
+    for (i = 0; i < n; i++) {
+        if (fabs(x[i]) > scale) {
+            scale = fabs(x[i]);
+        }
+    }
+    
+    if ((scale == 0.0) || isinf(scale)) {
+        return scale;
+    }
+    
+    sum = 0.0;
+    for (i = 0; i < n; i++) {
+        t = x[i] / scale;
+        sum += t * t;
+    }
+    
+    return scale * sqrt(sum);
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Numeric_NewPreconditioner(Matrix_Sparse *a, Gua_Short type, Numeric_Preconditioner *m, Gua_String error)
+ *
+ * Description:
+ *     Set up a preconditioner for a sparse matrix. The Jacobi preconditioner
+ *     keeps the inverse of the diagonal. The ILU(0) preconditioner keeps an
+ *     incomplete LU factorization with the nonzero pattern of the matrix:
+ *     the unit lower triangle L and the upper triangle U share one copy of
+ *     the matrix, as in the IKJ form of Gaussian elimination.
+ *
+ * Arguments:
+ *     a,       a square sparse matrix;
+ *     type,    one of NUMERIC_PRECONDITIONER_*;
+ *     m,       the preconditioner;
+ *     error,   a pointer to the error message.
+ *
+ * Results:
+ *     The function fails if a diagonal element is zero or missing.
+ */
+Gua_Status Numeric_NewPreconditioner(Matrix_Sparse *a, Gua_Short type, Numeric_Preconditioner *m, Gua_String error)
+{
+    Matrix_Sparse *lu;
+    Gua_Length *position;
+    Gua_Real factor;
+    Gua_Length i;
+    Gua_Length j;
+    Gua_Length k;
+    Gua_Length l;
     Gua_String errMessage;
     
-    Gua_ClearPObject(object);
+    m->type = type;
+    m->n = a->rows;
+    m->diagonal = NULL;
+    m->lu = NULL;
+    m->udiagonal = NULL;
+    
+    if (type == NUMERIC_PRECONDITIONER_NONE) {
+        return GUA_OK;
+    }
+    
+    m->udiagonal = (Gua_Length *)Gua_Alloc((a->rows + 1) * sizeof(Gua_Length));
+    
+    for (i = 0; i < a->rows; i++) {
+        m->udiagonal[i] = -1;
+        for (k = a->rowp[i]; k < a->rowp[i + 1]; k++) {
+            if (a->colind[k] == i) {
+                m->udiagonal[i] = k;
+                break;
+            }
+        }
+        if ((m->udiagonal[i] < 0) || (a->values[m->udiagonal[i]] == 0.0)) {
+            Numeric_FreePreconditioner(m);
+            
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "the matrix has a zero diagonal element");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+    }
+    
+    if (type == NUMERIC_PRECONDITIONER_JACOBI) {
+        m->diagonal = (Gua_Real *)Gua_Alloc((a->rows + 1) * sizeof(Gua_Real));
+        for (i = 0; i < a->rows; i++) {
+            m->diagonal[i] = 1.0 / a->values[m->udiagonal[i]];
+        }
+        
+        return GUA_OK;
+    }
+    
+    lu = Matrix_SparseScale(a, 1.0);
+    
+    position = (Gua_Length *)Gua_Alloc((a->cols + 1) * sizeof(Gua_Length));
+    for (j = 0; j < a->cols; j++) {
+        position[j] = -1;
+    }
+    
+    for (i = 1; i < lu->rows; i++) {
+        for (k = lu->rowp[i]; k < lu->rowp[i + 1]; k++) {
+            position[lu->colind[k]] = k;
+        }
+        
+        /* Eliminate the lower part of the row, keeping its pattern. */
+        for (k = lu->rowp[i]; (k < lu->rowp[i + 1]) && (lu->colind[k] < i); k++) {
+            j = lu->colind[k];
+            
+            if (lu->values[m->udiagonal[j]] == 0.0) {
+                break;
+            }
+            
+            factor = lu->values[k] / lu->values[m->udiagonal[j]];
+            lu->values[k] = factor;
+            
+            for (l = m->udiagonal[j] + 1; l < lu->rowp[j + 1]; l++) {
+                if (position[lu->colind[l]] >= 0) {
+                    lu->values[position[lu->colind[l]]] -= factor * lu->values[l];
+                }
+            }
+        }
+        
+        for (k = lu->rowp[i]; k < lu->rowp[i + 1]; k++) {
+            position[lu->colind[k]] = -1;
+        }
+    }
+    
+    Gua_Free(position);
+    
+    m->lu = lu;
+    
+    for (i = 0; i < lu->rows; i++) {
+        if (lu->values[m->udiagonal[i]] == 0.0) {
+            Numeric_FreePreconditioner(m);
+            
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "the incomplete factorization has a zero pivot");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+    }
+    
+    return GUA_OK;
+}
 
-    if (argc == 0) {
-        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-        sprintf(errMessage, "%s\n", "no function specified");
-        strcat(error, errMessage);
-        Gua_Free(errMessage);
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Numeric_FreePreconditioner(Numeric_Preconditioner *m)
+ *
+ * Description:
+ *     Free the buffers of a preconditioner.
+ *
+ * Arguments:
+ *     m,    the preconditioner.
+ *
+ * Results:
+ *     The function frees the buffers of m.
+ */
+void Numeric_FreePreconditioner(Numeric_Preconditioner *m)
+{
+    if (m->diagonal != NULL) {
+        Gua_Free(m->diagonal);
+        m->diagonal = NULL;
+    }
+    if (m->lu != NULL) {
+        Matrix_FreeSparse(m->lu);
+        m->lu = NULL;
+    }
+    if (m->udiagonal != NULL) {
+        Gua_Free(m->udiagonal);
+        m->udiagonal = NULL;
+    }
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Numeric_ApplyPreconditioner(Numeric_Preconditioner *m, Gua_Real *r, Gua_Real *z)
+ *
+ * Description:
+ *     Solve M z = r for the preconditioner M. For ILU(0) this is a forward
+ *     substitution with L followed by a backward substitution with U.
+ *
+ * Arguments:
+ *     m,    the preconditioner;
+ *     r,    the right-hand side;
+ *     z,    the solution, which may not be r.
+ *
+ * Results:
+ *     The function fills z.
+ */
+void Numeric_ApplyPreconditioner(Numeric_Preconditioner *m, Gua_Real *r, Gua_Real *z)
+{
+    Matrix_Sparse *lu;
+    Gua_Real sum;
+    Gua_Length i;
+    Gua_Length k;
+    
+    if (m->type == NUMERIC_PRECONDITIONER_JACOBI) {
+        for (i = 0; i < m->n; i++) {
+            z[i] = m->diagonal[i] * r[i];
+        }
+    } else if (m->type == NUMERIC_PRECONDITIONER_ILU) {
+        lu = m->lu;
+        
+        for (i = 0; i < m->n; i++) {
+            sum = r[i];
+            for (k = lu->rowp[i]; k < m->udiagonal[i]; k++) {
+                sum -= lu->values[k] * z[lu->colind[k]];
+            }
+            z[i] = sum;
+        }
+        for (i = m->n - 1; i >= 0; i--) {
+            sum = z[i];
+            for (k = m->udiagonal[i] + 1; k < lu->rowp[i + 1]; k++) {
+                sum -= lu->values[k] * z[lu->colind[k]];
+            }
+            z[i] = sum / lu->values[m->udiagonal[i]];
+        }
+    } else {
+        memcpy(z, r, m->n * sizeof(Gua_Real));
+    }
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Real Numeric_RecordResidual(Numeric_History *history, Gua_Length k, Gua_Real residual)
+ *
+ * Description:
+ *     Store the relative residual norm after iteration k, doubling the
+ *     history when it is full, so a large iteration limit costs nothing
+ *     until the iterations are actually done.
+ *
+ * Arguments:
+ *     history,     the residual history;
+ *     k,           the iteration;
+ *     residual,    the relative residual norm.
+ *
+ * Results:
+ *     The function returns the residual.
+ */
+Gua_Real Numeric_RecordResidual(Numeric_History *history, Gua_Length k, Gua_Real residual)
+{
+    if (k >= history->size) {
+        history->size = 2 * (k + 1);
+        history->value = (Gua_Real *)Gua_Realloc(history->value, history->size * sizeof(Gua_Real));
+    }
+    
+    history->value[k] = residual;
+    
+    return residual;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Length Numeric_CG(Matrix_Sparse *a, Numeric_Preconditioner *m, Gua_Real *b, Gua_Real *x, Gua_Real tolerance, Gua_Length iterations, Numeric_History *history)
+ *
+ * Description:
+ *     Solve A x = b with the preconditioned conjugate gradient method. The
+ *     matrix and the preconditioner must be symmetric and positive definite.
+ *
+ * Arguments:
+ *     a,             the matrix;
+ *     m,             the preconditioner;
+ *     b,             the right-hand side;
+ *     x,             the initial guess, overwritten with the solution;
+ *     tolerance,     the relative residual norm to stop at;
+ *     iterations,    the maximum number of iterations;
+ *     history,       the relative residual norms, grown as needed.
+ *
+ * Results:
+ *     The number of iterations done. history->value[0] to
+ *     history->value[k] hold the relative residual norm before the first
+ *     and after each iteration.
+ */
+Gua_Length Numeric_CG(Matrix_Sparse *a, Numeric_Preconditioner *m, Gua_Real *b, Gua_Real *x, Gua_Real tolerance, Gua_Length iterations, Numeric_History *history)
+{
+    Gua_Real *r;
+    Gua_Real *z;
+    Gua_Real *p;
+    Gua_Real *q;
+    Gua_Real norm;
+    Gua_Real rz;
+    Gua_Real previous;
+    Gua_Real alpha;
+    Gua_Real beta;
+    Gua_Length n;
+    Gua_Length i;
+    Gua_Length k;
+    
+    n = a->rows;
+    
+    r = (Gua_Real *)Gua_Alloc((n + 1) * sizeof(Gua_Real));
+    z = (Gua_Real *)Gua_Alloc((n + 1) * sizeof(Gua_Real));
+    p = (Gua_Real *)Gua_Alloc((n + 1) * sizeof(Gua_Real));
+    q = (Gua_Real *)Gua_Alloc((n + 1) * sizeof(Gua_Real));
+    
+    norm = Numeric_Norm(b, n);
+    if (norm == 0.0) {
+        norm = 1.0;
+    }
+    
+    Matrix_SparseMulDense(a, x, 1, q);
+    for (i = 0; i < n; i++) {
+        r[i] = b[i] - q[i];
+    }
+    
+    Numeric_ApplyPreconditioner(m, r, z);
+    memcpy(p, z, n * sizeof(Gua_Real));
+    rz = Numeric_Dot(r, z, n);
+    
+    Numeric_RecordResidual(history, 0, Numeric_Norm(r, n) / norm);
+    
+    for (k = 0; (k < iterations) && (history->value[k] > tolerance); k++) {
+        Matrix_SparseMulDense(a, p, 1, q);
+        
+        alpha = Numeric_Dot(p, q, n);
+        if (alpha == 0.0) {
+            break;
+        }
+        alpha = rz / alpha;
+        
+        for (i = 0; i < n; i++) {
+            x[i] += alpha * p[i];
+            r[i] -= alpha * q[i];
+        }
+        
+        Numeric_RecordResidual(history, k + 1, Numeric_Norm(r, n) / norm);
+        
+        Numeric_ApplyPreconditioner(m, r, z);
+        previous = rz;
+        rz = Numeric_Dot(r, z, n);
+        beta = rz / previous;
+        
+        for (i = 0; i < n; i++) {
+            p[i] = z[i] + beta * p[i];
+        }
+    }
+    
+    Gua_Free(q);
+    Gua_Free(p);
+    Gua_Free(z);
+    Gua_Free(r);
+    
+    return k;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Length Numeric_BiCGSTAB(Matrix_Sparse *a, Numeric_Preconditioner *m, Gua_Real *b, Gua_Real *x, Gua_Real tolerance, Gua_Length iterations, Numeric_History *history)
+ *
+ * Description:
+ *     Solve A x = b with the right preconditioned biconjugate gradient
+ *     stabilized method, which also works for nonsymmetric matrices.
+ *
+ * Arguments:
+ *     a,             the matrix;
+ *     m,             the preconditioner;
+ *     b,             the right-hand side;
+ *     x,             the initial guess, overwritten with the solution;
+ *     tolerance,     the relative residual norm to stop at;
+ *     iterations,    the maximum number of iterations;
+ *     history,       the relative residual norms, grown as needed.
+ *
+ * Results:
+ *     The number of iterations done, as in Numeric_CG. The method stops
+ *     early if it breaks down.
+ */
+Gua_Length Numeric_BiCGSTAB(Matrix_Sparse *a, Numeric_Preconditioner *m, Gua_Real *b, Gua_Real *x, Gua_Real tolerance, Gua_Length iterations, Numeric_History *history)
+{
+    Gua_Real *r;
+    Gua_Real *rhat;
+    Gua_Real *p;
+    Gua_Real *phat;
+    Gua_Real *v;
+    Gua_Real *s;
+    Gua_Real *shat;
+    Gua_Real *t;
+    Gua_Real norm;
+    Gua_Real rho;
+    Gua_Real previous;
+    Gua_Real alpha;
+    Gua_Real beta;
+    Gua_Real omega;
+    Gua_Length n;
+    Gua_Length i;
+    Gua_Length k;
+    
+    n = a->rows;
+    
+    r = (Gua_Real *)Gua_Alloc((n + 1) * sizeof(Gua_Real));
+    rhat = (Gua_Real *)Gua_Alloc((n + 1) * sizeof(Gua_Real));
+    p = (Gua_Real *)Gua_Alloc((n + 1) * sizeof(Gua_Real));
+    phat = (Gua_Real *)Gua_Alloc((n + 1) * sizeof(Gua_Real));
+    v = (Gua_Real *)Gua_Alloc((n + 1) * sizeof(Gua_Real));
+    s = (Gua_Real *)Gua_Alloc((n + 1) * sizeof(Gua_Real));
+    shat = (Gua_Real *)Gua_Alloc((n + 1) * sizeof(Gua_Real));
+    t = (Gua_Real *)Gua_Alloc((n + 1) * sizeof(Gua_Real));
+    
+    norm = Numeric_Norm(b, n);
+    if (norm == 0.0) {
+        norm = 1.0;
+    }
+    
+    Matrix_SparseMulDense(a, x, 1, v);
+    for (i = 0; i < n; i++) {
+        r[i] = b[i] - v[i];
+        p[i] = 0.0;
+        v[i] = 0.0;
+    }
+    memcpy(rhat, r, n * sizeof(Gua_Real));
+    
+    previous = 1.0;
+    alpha = 1.0;
+    omega = 1.0;
+    
+    Numeric_RecordResidual(history, 0, Numeric_Norm(r, n) / norm);
+    
+    for (k = 0; (k < iterations) && (history->value[k] > tolerance); k++) {
+        rho = Numeric_Dot(rhat, r, n);
+        if ((rho == 0.0) || (omega == 0.0)) {
+            break;
+        }
+        
+        beta = (rho / previous) * (alpha / omega);
+        for (i = 0; i < n; i++) {
+            p[i] = r[i] + beta * (p[i] - omega * v[i]);
+        }
+        
+        Numeric_ApplyPreconditioner(m, p, phat);
+        Matrix_SparseMulDense(a, phat, 1, v);
+        
+        alpha = Numeric_Dot(rhat, v, n);
+        if (alpha == 0.0) {
+            break;
+        }
+        alpha = rho / alpha;
+        
+        for (i = 0; i < n; i++) {
+            s[i] = r[i] - alpha * v[i];
+        }
+        
+        /* Stop halfway if s is already small enough. */
+        if (Numeric_RecordResidual(history, k + 1, Numeric_Norm(s, n) / norm) <= tolerance) {
+            for (i = 0; i < n; i++) {
+                x[i] += alpha * phat[i];
+            }
+            k++;
+            break;
+        }
+        
+        Numeric_ApplyPreconditioner(m, s, shat);
+        Matrix_SparseMulDense(a, shat, 1, t);
+        
+        omega = Numeric_Dot(t, t, n);
+        omega = omega == 0.0 ? 0.0 : Numeric_Dot(t, s, n) / omega;
+        
+        for (i = 0; i < n; i++) {
+            x[i] += alpha * phat[i] + omega * shat[i];
+            r[i] = s[i] - omega * t[i];
+        }
+        
+        Numeric_RecordResidual(history, k + 1, Numeric_Norm(r, n) / norm);
+        previous = rho;
+    }
+    
+    Gua_Free(t);
+    Gua_Free(shat);
+    Gua_Free(s);
+    Gua_Free(v);
+    Gua_Free(phat);
+    Gua_Free(p);
+    Gua_Free(rhat);
+    Gua_Free(r);
+    
+    return k;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Length Numeric_GMRES(Matrix_Sparse *a, Numeric_Preconditioner *m, Gua_Real *b, Gua_Real *x, Gua_Real tolerance, Gua_Length iterations, Gua_Length restart, Numeric_History *history)
+ *
+ * Description:
+ *     Solve A x = b with the right preconditioned GMRES method, restarted
+ *     every restart iterations. The Krylov basis is built with modified
+ *     Gram-Schmidt and the least squares problem is kept triangular with
+ *     Givens rotations, so the residual norm is known at each step.
+ *
+ * Arguments:
+ *     a,             the matrix;
+ *     m,             the preconditioner;
+ *     b,             the right-hand side;
+ *     x,             the initial guess, overwritten with the solution;
+ *     tolerance,     the relative residual norm to stop at;
+ *     iterations,    the maximum number of iterations;
+ *     restart,       the number of basis vectors kept between restarts;
+ *     history,       the relative residual norms, grown as needed.
+ *
+ * Results:
+ *     The number of iterations done, as in Numeric_CG.
+ */
+Gua_Length Numeric_GMRES(Matrix_Sparse *a, Numeric_Preconditioner *m, Gua_Real *b, Gua_Real *x, Gua_Real tolerance, Gua_Length iterations, Gua_Length restart, Numeric_History *history)
+{
+    Gua_Real *v;
+    Gua_Real *h;
+    Gua_Real *c;
+    Gua_Real *s;
+    Gua_Real *g;
+    Gua_Real *y;
+    Gua_Real *w;
+    Gua_Real *z;
+    Gua_Real norm;
+    Gua_Real beta;
+    Gua_Real temp;
+    Gua_Length n;
+    Gua_Length i;
+    Gua_Length j;
+    Gua_Length l;
+    Gua_Length k;
+    
+    n = a->rows;
+    
+    v = (Gua_Real *)Gua_Alloc(((restart + 1) * n + 1) * sizeof(Gua_Real));
+    h = (Gua_Real *)Gua_Alloc(((restart + 1) * restart + 1) * sizeof(Gua_Real));
+    c = (Gua_Real *)Gua_Alloc((restart + 1) * sizeof(Gua_Real));
+    s = (Gua_Real *)Gua_Alloc((restart + 1) * sizeof(Gua_Real));
+    g = (Gua_Real *)Gua_Alloc((restart + 2) * sizeof(Gua_Real));
+    y = (Gua_Real *)Gua_Alloc((restart + 1) * sizeof(Gua_Real));
+    w = (Gua_Real *)Gua_Alloc((n + 1) * sizeof(Gua_Real));
+    z = (Gua_Real *)Gua_Alloc((n + 1) * sizeof(Gua_Real));
+    
+    norm = Numeric_Norm(b, n);
+    if (norm == 0.0) {
+        norm = 1.0;
+    }
+    
+    Matrix_SparseMulDense(a, x, 1, w);
+    for (i = 0; i < n; i++) {
+        v[i] = b[i] - w[i];
+    }
+    beta = Numeric_Norm(v, n);
+    
+    k = 0;
+    Numeric_RecordResidual(history, 0, beta / norm);
+    
+    while ((k < iterations) && (history->value[k] > tolerance)) {
+        for (i = 0; i < n; i++) {
+            v[i] /= beta;
+        }
+        g[0] = beta;
+        
+        for (j = 0; (j < restart) && (k < iterations); j++) {
+            /* Extend the basis with the preconditioned operator. */
+            Numeric_ApplyPreconditioner(m, v + j * n, z);
+            Matrix_SparseMulDense(a, z, 1, w);
+            
+            for (l = 0; l <= j; l++) {
+                h[l * restart + j] = Numeric_Dot(w, v + l * n, n);
+                for (i = 0; i < n; i++) {
+                    w[i] -= h[l * restart + j] * v[l * n + i];
+                }
+            }
+            h[(j + 1) * restart + j] = Numeric_Norm(w, n);
+            
+            if (h[(j + 1) * restart + j] != 0.0) {
+                for (i = 0; i < n; i++) {
+                    v[(j + 1) * n + i] = w[i] / h[(j + 1) * restart + j];
+                }
+            }
+            
+            /* Apply the previous rotations, then zero the subdiagonal. */
+            for (l = 0; l < j; l++) {
+                temp = c[l] * h[l * restart + j] + s[l] * h[(l + 1) * restart + j];
+                h[(l + 1) * restart + j] = -s[l] * h[l * restart + j] + c[l] * h[(l + 1) * restart + j];
+                h[l * restart + j] = temp;
+            }
+            
+            temp = hypot(h[j * restart + j], h[(j + 1) * restart + j]);
+            if (temp == 0.0) {
+                c[j] = 1.0;
+                s[j] = 0.0;
+            } else {
+                c[j] = h[j * restart + j] / temp;
+                s[j] = h[(j + 1) * restart + j] / temp;
+            }
+            
+            h[j * restart + j] = temp;
+            h[(j + 1) * restart + j] = 0.0;
+            g[j + 1] = -s[j] * g[j];
+            g[j] = c[j] * g[j];
+            
+            k++;
+            if ((Numeric_RecordResidual(history, k, fabs(g[j + 1]) / norm) <= tolerance) || (temp == 0.0)) {
+                j++;
+                break;
+            }
+        }
+        
+        /* Solve the triangular system and update x = x + M^-1 V y. */
+        for (l = j - 1; l >= 0; l--) {
+            temp = g[l];
+            for (i = l + 1; i < j; i++) {
+                temp -= h[l * restart + i] * y[i];
+            }
+            y[l] = h[l * restart + l] == 0.0 ? 0.0 : temp / h[l * restart + l];
+        }
+        
+        memset(w, 0, n * sizeof(Gua_Real));
+        for (l = 0; l < j; l++) {
+            for (i = 0; i < n; i++) {
+                w[i] += y[l] * v[l * n + i];
+            }
+        }
+        Numeric_ApplyPreconditioner(m, w, z);
+        for (i = 0; i < n; i++) {
+            x[i] += z[i];
+        }
+        
+        /* Restart from the true residual. */
+        Matrix_SparseMulDense(a, x, 1, w);
+        for (i = 0; i < n; i++) {
+            v[i] = b[i] - w[i];
+        }
+        beta = Numeric_Norm(v, n);
+        Numeric_RecordResidual(history, k, beta / norm);
+        
+        if (beta == 0.0) {
+            break;
+        }
+    }
+    
+    Gua_Free(z);
+    Gua_Free(w);
+    Gua_Free(y);
+    Gua_Free(g);
+    Gua_Free(s);
+    Gua_Free(c);
+    Gua_Free(h);
+    Gua_Free(v);
+    
+    return k;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Numeric_IterativeLSS(Gua_Object *a, Gua_Object *b, Gua_Short method, Gua_Real tolerance, Gua_Length iterations, Gua_Short preconditioner, Gua_Length restart, Gua_Object *x, Gua_Object *history, Gua_String error)
+ *
+ * Description:
+ *     Solve a linear system with a Krylov method, starting from x = 0.
+ *
+ * Arguments:
+ *     a,                 a square matrix, dense or sparse;
+ *     b,                 the right-hand side vector;
+ *     method,            one of NUMERIC_METHOD_*;
+ *     tolerance,         the relative residual norm to stop at;
+ *     iterations,        the maximum number of iterations, or -1 for the
+ *                        number of unknowns;
+ *     preconditioner,    one of NUMERIC_PRECONDITIONER_*;
+ *     restart,           the GMRES restart length;
+ *     x,                 the solution, a column vector;
+ *     history,           a column vector with the relative residual norm
+ *                        before the first and after each iteration;
+ *     error,             a pointer to the error message.
+ *
+ * Results:
+ *     A dense matrix is converted to the sparse format once, so both kinds
+ *     of matrix run the same kernels. The function does not fail when the
+ *     method does not converge; the history shows how far it got.
+ */
+Gua_Status Numeric_IterativeLSS(Gua_Object *a, Gua_Object *b, Gua_Short method, Gua_Real tolerance, Gua_Length iterations, Gua_Short preconditioner, Gua_Length restart, Gua_Object *x, Gua_Object *history, Gua_String error)
+{
+    Matrix_Sparse *sa;
+    Matrix_Sparse *dense;
+    Numeric_Preconditioner m;
+    Gua_Real *vb;
+    Gua_Real *vx;
+    Numeric_History vh;
+    Gua_Real scale;
+    Gua_Length rows;
+    Gua_Length cols;
+    Gua_Length i;
+    Gua_Length k;
+    Gua_String errMessage;
+    
+    dense = NULL;
+    sa = Matrix_GetSparse(a);
+    
+    if (sa == NULL) {
+        vb = Matrix_GetRealBuffer(a, &rows, &cols);
+        if (vb != NULL) {
+            dense = Matrix_DenseToSparse(vb, rows, cols);
+            sa = dense;
+            Gua_Free(vb);
+        }
+    }
+    
+    if ((sa == NULL) || (sa->rows != sa->cols)) {
+        Matrix_FreeSparse(dense);
+        
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "illegal argument 1");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    vb = Matrix_GetRealBuffer(b, &rows, &cols);
+    
+    if ((vb == NULL) || (rows * cols != sa->rows)) {
+        if (vb != NULL) {
+            Gua_Free(vb);
+        }
+        Matrix_FreeSparse(dense);
+        
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "the matrices do not have compatible dimensions");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    if (Numeric_NewPreconditioner(sa, preconditioner, &m, error) != GUA_OK) {
+        Gua_Free(vb);
+        Matrix_FreeSparse(dense);
+        
+        return GUA_ERROR;
+    }
+    
+    if (iterations < 0) {
+        iterations = sa->rows;
+    }
+    
+    vx = (Gua_Real *)Gua_Alloc((sa->rows + 1) * sizeof(Gua_Real));
+    
+    /* The history starts small and grows with the iterations actually done. */
+    vh.size = (iterations < sa->rows ? iterations : sa->rows) + 1;
+    vh.value = (Gua_Real *)Gua_Alloc(vh.size * sizeof(Gua_Real));
+    
+    memset(vx, 0, sa->rows * sizeof(Gua_Real));
+    
+    /* Solve for b / max|b|, so the dot products neither overflow nor underflow. */
+    scale = 0.0;
+    for (i = 0; i < sa->rows; i++) {
+        if (fabs(vb[i]) > scale) {
+            scale = fabs(vb[i]);
+        }
+    }
+    if ((scale == 0.0) || !isfinite(scale)) {
+        scale = 1.0;
+    }
+    for (i = 0; i < sa->rows; i++) {
+        vb[i] /= scale;
+    }
+    
+    if (method == NUMERIC_METHOD_CG) {
+        k = Numeric_CG(sa, &m, vb, vx, tolerance, iterations, &vh);
+    } else if (method == NUMERIC_METHOD_BICGSTAB) {
+        k = Numeric_BiCGSTAB(sa, &m, vb, vx, tolerance, iterations, &vh);
+    } else {
+        k = Numeric_GMRES(sa, &m, vb, vx, tolerance, iterations, restart < sa->rows ? restart : sa->rows, &vh);
+    }
+    
+    for (i = 0; i < sa->rows; i++) {
+        vx[i] *= scale;
+    }
+    
+    Matrix_RealBufferToPObject(x, vx, sa->rows, 1);
+    Matrix_RealBufferToPObject(history, vh.value, k + 1, 1);
+    
+    Numeric_FreePreconditioner(&m);
+    Gua_Free(vh.value);
+    Gua_Free(vx);
+    Gua_Free(vb);
+    Matrix_FreeSparse(dense);
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Numeric_FFTPlan *Numeric_NewFFTPlan(Gua_Length n)
+ *
+ * Description:
+ *     Prepare the discrete Fourier transform of a given size. The plan keeps
+ *     the twiddle factors exp(-2 pi i k / n), grouped by stage for a power
+ *     of two size, and the factors of n. A size
+ *     that is a power of two runs an iterative radix-2 transform; a size
+ *     whose prime factors are at most NUMERIC_FFT_MAX_RADIX runs a mixed
+ *     radix transform; any other size runs Bluestein's algorithm, which
+ *     turns the transform into a convolution of power of two size.
+ *
+ * Arguments:
+ *     n,    the size of the transform.
+ *
+ * Results:
+ *     The new plan.
+ */
+Numeric_FFTPlan *Numeric_NewFFTPlan(Gua_Length n)
+{
+    Numeric_FFTPlan *plan;
+    Gua_Real angle;
+    Gua_Length m;
+    Gua_Length p;
+    Gua_Length k;
+    
+    plan = (Numeric_FFTPlan *)Gua_Alloc(sizeof(Numeric_FFTPlan));
+    plan->n = n;
+    plan->factors = 0;
+    plan->m = 0;
+    plan->chirpre = NULL;
+    plan->chirpim = NULL;
+    plan->filterre = NULL;
+    plan->filterim = NULL;
+    plan->inner = NULL;
+    
+    plan->twiddlere = (Gua_Real *)Gua_Alloc((n + 1) * sizeof(Gua_Real));
+    plan->twiddleim = (Gua_Real *)Gua_Alloc((n + 1) * sizeof(Gua_Real));
+    
+    if ((n & (n - 1)) == 0) {
+        /* The twiddles of the stage joining transforms of size h are exp(-pi i k / h), stored from h on. */
+        for (m = 1; m < n; m <<= 1) {
+            for (k = 0; k < m; k++) {
+                angle = -M_PI * k / m;
+                plan->twiddlere[m + k] = cos(angle);
+                plan->twiddleim[m + k] = sin(angle);
+            }
+        }
+        
+        return plan;
+    }
+    
+    for (k = 0; k < n; k++) {
+        angle = -2.0 * M_PI * k / n;
+        plan->twiddlere[k] = cos(angle);
+        plan->twiddleim[k] = sin(angle);
+    }
+    
+    /* Factor n, smallest primes first. */
+    m = n;
+    for (p = 2; (p * p <= m) && (plan->factors < NUMERIC_FFT_MAX_FACTORS); p++) {
+        while ((m % p == 0) && (plan->factors < NUMERIC_FFT_MAX_FACTORS)) {
+            plan->factor[plan->factors++] = p;
+            m = m / p;
+        }
+    }
+    if ((m > 1) && (plan->factors < NUMERIC_FFT_MAX_FACTORS)) {
+        plan->factor[plan->factors++] = m;
+        m = 1;
+    }
+    
+    if ((m == 1) && (plan->factor[plan->factors - 1] <= NUMERIC_FFT_MAX_RADIX)) {
+        return plan;
+    }
+    
+    /* Bluestein: X[k] = w[k] (a * b)[k], with a[j] = x[j] w[j] and b[j] = conj(w[j]). */
+    plan->factors = 0;
+    plan->m = 1;
+    while (plan->m < 2 * n - 1) {
+        plan->m = plan->m * 2;
+    }
+    
+    plan->inner = Numeric_NewFFTPlan(plan->m);
+    
+    plan->chirpre = (Gua_Real *)Gua_Alloc(n * sizeof(Gua_Real));
+    plan->chirpim = (Gua_Real *)Gua_Alloc(n * sizeof(Gua_Real));
+    plan->filterre = (Gua_Real *)Gua_Alloc(plan->m * sizeof(Gua_Real));
+    plan->filterim = (Gua_Real *)Gua_Alloc(plan->m * sizeof(Gua_Real));
+    
+    for (k = 0; k < n; k++) {
+        /* Reduce k^2 modulo 2n to keep the angle exact for large k. */
+        angle = -M_PI * (Gua_Real)((k * k) % (2 * n)) / n;
+        plan->chirpre[k] = cos(angle);
+        plan->chirpim[k] = sin(angle);
+    }
+    
+    memset(plan->filterre, 0, plan->m * sizeof(Gua_Real));
+    memset(plan->filterim, 0, plan->m * sizeof(Gua_Real));
+    
+    plan->filterre[0] = plan->chirpre[0];
+    plan->filterim[0] = -plan->chirpim[0];
+    for (k = 1; k < n; k++) {
+        plan->filterre[k] = plan->chirpre[k];
+        plan->filterim[k] = -plan->chirpim[k];
+        plan->filterre[plan->m - k] = plan->chirpre[k];
+        plan->filterim[plan->m - k] = -plan->chirpim[k];
+    }
+    
+    Numeric_FFT(plan->inner, plan->filterre, plan->filterim, false);
+    
+    return plan;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Numeric_FreeFFTPlan(Numeric_FFTPlan *plan)
+ *
+ * Description:
+ *     Free a transform plan.
+ *
+ * Arguments:
+ *     plan,    the plan.
+ *
+ * Results:
+ *     The function frees the plan and its buffers.
+ */
+void Numeric_FreeFFTPlan(Numeric_FFTPlan *plan)
+{
+    if (plan == NULL) {
+        return;
+    }
+    
+    if (plan->inner != NULL) {
+        Numeric_FreeFFTPlan(plan->inner);
+        Gua_Free(plan->chirpre);
+        Gua_Free(plan->chirpim);
+        Gua_Free(plan->filterre);
+        Gua_Free(plan->filterim);
+    }
+    
+    Gua_Free(plan->twiddlere);
+    Gua_Free(plan->twiddleim);
+    Gua_Free(plan);
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Numeric_FFTPlan *Numeric_GetFFTPlan(Gua_Length n)
+ *
+ * Description:
+ *     Get the plan of a transform size from the plan cache. The cache keeps
+ *     the last NUMERIC_FFT_PLANS sizes used, so transforming many signals
+ *     of the same size computes the twiddle factors once.
+ *
+ * Arguments:
+ *     n,    the size of the transform.
+ *
+ * Results:
+ *     The plan, valid until the next call of this function.
+ */
+Numeric_FFTPlan *Numeric_GetFFTPlan(Gua_Length n)
+{
+    static Numeric_FFTPlan *plans[NUMERIC_FFT_PLANS];
+    static Gua_Short next = 0;
+    Gua_Short i;
+    
+    for (i = 0; i < NUMERIC_FFT_PLANS; i++) {
+        if ((plans[i] != NULL) && (plans[i]->n == n)) {
+            return plans[i];
+        }
+    }
+    
+    Numeric_FreeFFTPlan(plans[next]);
+    plans[next] = Numeric_NewFFTPlan(n);
+    
+    i = next;
+    next = (next + 1) % NUMERIC_FFT_PLANS;
+    
+    return plans[i];
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Numeric_FFTPass(Numeric_FFTPlan *plan, Gua_Real *re, Gua_Real *im, Gua_Length first, Gua_Length last, Gua_Length half)
+ *
+ * Description:
+ *     One stage of the radix-2 transform: the butterflies joining pairs of
+ *     half point transforms between the elements first and last.
+ *
+ * Arguments:
+ *     plan,     the plan;
+ *     re,       the real parts;
+ *     im,       the imaginary parts;
+ *     first,    the first element;
+ *     last,     the element after the last one;
+ *     half,     the size of the transforms joined.
+ *
+ * Results:
+ *     The function overwrites the elements first to last - 1.
+ */
+void Numeric_FFTPass(Numeric_FFTPlan *plan, Gua_Real *re, Gua_Real *im, Gua_Length first, Gua_Length last, Gua_Length half)
+{
+    Gua_Real *wr;
+    Gua_Real *wi;
+    Gua_Real *ar;
+    Gua_Real *ai;
+    Gua_Real *br;
+    Gua_Real *bi;
+    Gua_Real tr;
+    Gua_Real ti;
+    Gua_Length i;
+    Gua_Length k;
+    
+    wr = plan->twiddlere + half;
+    wi = plan->twiddleim + half;
+    
+    for (i = first; i < last; i += 2 * half) {
+        ar = re + i;
+        ai = im + i;
+        br = ar + half;
+        bi = ai + half;
+        for (k = 0; k < half; k++) {
+            tr = br[k] * wr[k] - bi[k] * wi[k];
+            ti = br[k] * wi[k] + bi[k] * wr[k];
+            br[k] = ar[k] - tr;
+            bi[k] = ai[k] - ti;
+            ar[k] += tr;
+            ai[k] += ti;
+        }
+    }
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Numeric_FFTRadix2(Numeric_FFTPlan *plan, Gua_Real *re, Gua_Real *im)
+ *
+ * Description:
+ *     Iterative in place radix-2 transform of a power of two size. The
+ *     first stages work on blocks of NUMERIC_FFT_BLOCK elements, so that
+ *     large transforms do not go through memory once per stage.
+ *
+ * Arguments:
+ *     plan,    the plan;
+ *     re,      the real parts;
+ *     im,      the imaginary parts.
+ *
+ * Results:
+ *     The function overwrites re and im with the transform.
+ */
+void Numeric_FFTRadix2(Numeric_FFTPlan *plan, Gua_Real *re, Gua_Real *im)
+{
+    Gua_Real tr;
+    Gua_Real ti;
+    Gua_Length n;
+    Gua_Length block;
+    Gua_Length half;
+    Gua_Length i;
+    Gua_Length j;
+    Gua_Length k;
+    
+    n = plan->n;
+    
+    /* Bit reversal permutation. */
+    j = 0;
+    for (i = 0; i < n - 1; i++) {
+        if (i < j) {
+            tr = re[i];
+            re[i] = re[j];
+            re[j] = tr;
+            ti = im[i];
+            im[i] = im[j];
+            im[j] = ti;
+        }
+        k = n >> 1;
+        while (k <= j) {
+            j -= k;
+            k >>= 1;
+        }
+        j += k;
+    }
+    
+    /* Run the stages that fit in a block one block at a time, while the block is in the cache. */
+    block = n < NUMERIC_FFT_BLOCK ? n : NUMERIC_FFT_BLOCK;
+    
+    for (i = 0; i < n; i += block) {
+        for (half = 1; half < block; half <<= 1) {
+            Numeric_FFTPass(plan, re, im, i, i + block, half);
+        }
+    }
+    for (half = block; half < n; half <<= 1) {
+        Numeric_FFTPass(plan, re, im, 0, n, half);
+    }
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Numeric_FFTMixedRadix(Numeric_FFTPlan *plan, Gua_Real *inre, Gua_Real *inim, Gua_Real *outre, Gua_Real *outim, Gua_Short factor, Gua_Length stride, Gua_Real *scratchre, Gua_Real *scratchim)
+ *
+ * Description:
+ *     Recursive decimation in time step of the mixed radix transform. The
+ *     input elements 0, stride, 2 stride... are split in p interleaved
+ *     sequences, each transformed by the next factors, and the results are
+ *     joined by radix-p butterflies.
+ *
+ * Arguments:
+ *     plan,         the plan;
+ *     inre,         the real parts of the input;
+ *     inim,         the imaginary parts of the input;
+ *     outre,        the real parts of the output;
+ *     outim,        the imaginary parts of the output;
+ *     factor,       the index of the factor of this step;
+ *     stride,       the distance between the input elements of this step;
+ *     scratchre,    room for the largest factor;
+ *     scratchim,    room for the largest factor.
+ *
+ * Results:
+ *     The function writes n / stride outputs.
+ */
+void Numeric_FFTMixedRadix(Numeric_FFTPlan *plan, Gua_Real *inre, Gua_Real *inim, Gua_Real *outre, Gua_Real *outim, Gua_Short factor, Gua_Length stride, Gua_Real *scratchre, Gua_Real *scratchim)
+{
+    Gua_Real sumre;
+    Gua_Real sumim;
+    Gua_Length p;
+    Gua_Length m;
+    Gua_Length u;
+    Gua_Length q;
+    Gua_Length r;
+    Gua_Length k;
+    Gua_Length w;
+    
+    p = plan->factor[factor];
+    m = plan->n / stride / p;
+    
+    if (m == 1) {
+        for (q = 0; q < p; q++) {
+            outre[q] = inre[q * stride];
+            outim[q] = inim[q * stride];
+        }
+    } else {
+        for (q = 0; q < p; q++) {
+            Numeric_FFTMixedRadix(plan, inre + q * stride, inim + q * stride, outre + q * m, outim + q * m, factor + 1, stride * p, scratchre, scratchim);
+        }
+    }
+    
+    if (p == 2) {
+        for (u = 0; u < m; u++) {
+            w = stride * u;
+            sumre = outre[u + m] * plan->twiddlere[w] - outim[u + m] * plan->twiddleim[w];
+            sumim = outre[u + m] * plan->twiddleim[w] + outim[u + m] * plan->twiddlere[w];
+            outre[u + m] = outre[u] - sumre;
+            outim[u + m] = outim[u] - sumim;
+            outre[u] += sumre;
+            outim[u] += sumim;
+        }
+        
+        return;
+    }
+    
+    for (u = 0; u < m; u++) {
+        /* Twiddle the inputs, then take their p point transform with the roots exp(-2 pi i j / p). */
+        scratchre[0] = outre[u];
+        scratchim[0] = outim[u];
+        for (r = 1; r < p; r++) {
+            w = stride * r * u;
+            scratchre[r] = outre[u + r * m] * plan->twiddlere[w] - outim[u + r * m] * plan->twiddleim[w];
+            scratchim[r] = outre[u + r * m] * plan->twiddleim[w] + outim[u + r * m] * plan->twiddlere[w];
+        }
+        for (q = 0; q < p; q++) {
+            k = u + q * m;
+            sumre = scratchre[0];
+            sumim = scratchim[0];
+            w = 0;
+            for (r = 1; r < p; r++) {
+                w += q * m * stride;
+                if (w >= plan->n) {
+                    w -= plan->n;
+                }
+                sumre += scratchre[r] * plan->twiddlere[w] - scratchim[r] * plan->twiddleim[w];
+                sumim += scratchre[r] * plan->twiddleim[w] + scratchim[r] * plan->twiddlere[w];
+            }
+            outre[k] = sumre;
+            outim[k] = sumim;
+        }
+    }
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Numeric_FFT(Numeric_FFTPlan *plan, Gua_Real *re, Gua_Real *im, Gua_Short inverse)
+ *
+ * Description:
+ *     Compute the discrete Fourier transform of a complex signal in place.
+ *     The inverse transform conjugates the input and output of the forward
+ *     one and divides by n.
+ *
+ * Arguments:
+ *     plan,       the plan of the signal size;
+ *     re,         the real parts;
+ *     im,         the imaginary parts;
+ *     inverse,    true for the inverse transform.
+ *
+ * Results:
+ *     The function overwrites re and im with the transform.
+ */
+void Numeric_FFT(Numeric_FFTPlan *plan, Gua_Real *re, Gua_Real *im, Gua_Short inverse)
+{
+    Gua_Real *bufferre;
+    Gua_Real *bufferim;
+    Gua_Real *scratchre;
+    Gua_Real *scratchim;
+    Gua_Real tr;
+    Gua_Real ti;
+    Gua_Length n;
+    Gua_Length k;
+    
+    n = plan->n;
+    
+    if (n <= 1) {
+        return;
+    }
+    
+    if (inverse) {
+        for (k = 0; k < n; k++) {
+            im[k] = -im[k];
+        }
+    }
+    
+    if (plan->inner != NULL) {
+        bufferre = (Gua_Real *)Gua_Alloc(plan->m * sizeof(Gua_Real));
+        bufferim = (Gua_Real *)Gua_Alloc(plan->m * sizeof(Gua_Real));
+        
+        for (k = 0; k < n; k++) {
+            bufferre[k] = re[k] * plan->chirpre[k] - im[k] * plan->chirpim[k];
+            bufferim[k] = re[k] * plan->chirpim[k] + im[k] * plan->chirpre[k];
+        }
+        memset(bufferre + n, 0, (plan->m - n) * sizeof(Gua_Real));
+        memset(bufferim + n, 0, (plan->m - n) * sizeof(Gua_Real));
+        
+        Numeric_FFT(plan->inner, bufferre, bufferim, false);
+        for (k = 0; k < plan->m; k++) {
+            tr = bufferre[k] * plan->filterre[k] - bufferim[k] * plan->filterim[k];
+            ti = bufferre[k] * plan->filterim[k] + bufferim[k] * plan->filterre[k];
+            bufferre[k] = tr;
+            bufferim[k] = ti;
+        }
+        Numeric_FFT(plan->inner, bufferre, bufferim, true);
+        
+        for (k = 0; k < n; k++) {
+            re[k] = bufferre[k] * plan->chirpre[k] - bufferim[k] * plan->chirpim[k];
+            im[k] = bufferre[k] * plan->chirpim[k] + bufferim[k] * plan->chirpre[k];
+        }
+        
+        Gua_Free(bufferim);
+        Gua_Free(bufferre);
+    } else if (plan->factors == 0) {
+        Numeric_FFTRadix2(plan, re, im);
+    } else {
+        bufferre = (Gua_Real *)Gua_Alloc(n * sizeof(Gua_Real));
+        bufferim = (Gua_Real *)Gua_Alloc(n * sizeof(Gua_Real));
+        scratchre = (Gua_Real *)Gua_Alloc((NUMERIC_FFT_MAX_RADIX + 1) * sizeof(Gua_Real));
+        scratchim = (Gua_Real *)Gua_Alloc((NUMERIC_FFT_MAX_RADIX + 1) * sizeof(Gua_Real));
+        
+        Numeric_FFTMixedRadix(plan, re, im, bufferre, bufferim, 0, 1, scratchre, scratchim);
+        
+        memcpy(re, bufferre, n * sizeof(Gua_Real));
+        memcpy(im, bufferim, n * sizeof(Gua_Real));
+        
+        Gua_Free(scratchim);
+        Gua_Free(scratchre);
+        Gua_Free(bufferim);
+        Gua_Free(bufferre);
+    }
+    
+    if (inverse) {
+        for (k = 0; k < n; k++) {
+            re[k] = re[k] / n;
+            im[k] = -im[k] / n;
+        }
+    }
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Numeric_RealFFT(Gua_Real *x, Gua_Length n, Gua_Real *re, Gua_Real *im)
+ *
+ * Description:
+ *     Compute the first n / 2 + 1 bins of the transform of a real signal.
+ *     For an even n the signal is packed in a complex signal of half the
+ *     size, x[2k] + i x[2k + 1], whose transform is split into the even and
+ *     odd parts afterwards, halving the work.
+ *
+ * Arguments:
+ *     x,     the real signal;
+ *     n,     the signal size;
+ *     re,    room for n / 2 + 1 real parts;
+ *     im,    room for n / 2 + 1 imaginary parts.
+ *
+ * Results:
+ *     The function fills re and im.
+ */
+void Numeric_RealFFT(Gua_Real *x, Gua_Length n, Gua_Real *re, Gua_Real *im)
+{
+    Gua_Real *zre;
+    Gua_Real *zim;
+    Gua_Real evenre;
+    Gua_Real evenim;
+    Gua_Real oddre;
+    Gua_Real oddim;
+    Gua_Real angle;
+    Gua_Length h;
+    Gua_Length k;
+    
+    h = n / 2;
+    
+    if ((n % 2 != 0) || (n < 4)) {
+        zre = (Gua_Real *)Gua_Alloc((n + 1) * sizeof(Gua_Real));
+        zim = (Gua_Real *)Gua_Alloc((n + 1) * sizeof(Gua_Real));
+        
+        memcpy(zre, x, n * sizeof(Gua_Real));
+        memset(zim, 0, n * sizeof(Gua_Real));
+        
+        Numeric_FFT(Numeric_GetFFTPlan(n), zre, zim, false);
+        
+        memcpy(re, zre, (h + 1) * sizeof(Gua_Real));
+        memcpy(im, zim, (h + 1) * sizeof(Gua_Real));
+        
+        Gua_Free(zim);
+        Gua_Free(zre);
+        
+        return;
+    }
+    
+    zre = (Gua_Real *)Gua_Alloc((h + 1) * sizeof(Gua_Real));
+    zim = (Gua_Real *)Gua_Alloc((h + 1) * sizeof(Gua_Real));
+    
+    for (k = 0; k < h; k++) {
+        zre[k] = x[2 * k];
+        zim[k] = x[2 * k + 1];
+    }
+    
+    Numeric_FFT(Numeric_GetFFTPlan(h), zre, zim, false);
+    
+    zre[h] = zre[0];
+    zim[h] = zim[0];
+    
+    for (k = 0; k <= h; k++) {
+        /* E[k] = (Z[k] + conj(Z[h - k])) / 2 and O[k] = (Z[k] - conj(Z[h - k])) / 2i. */
+        evenre = 0.5 * (zre[k] + zre[h - k]);
+        evenim = 0.5 * (zim[k] - zim[h - k]);
+        oddre = 0.5 * (zim[k] + zim[h - k]);
+        oddim = -0.5 * (zre[k] - zre[h - k]);
+        
+        angle = -2.0 * M_PI * k / n;
+        re[k] = evenre + oddre * cos(angle) - oddim * sin(angle);
+        im[k] = evenim + oddre * sin(angle) + oddim * cos(angle);
+    }
+    
+    Gua_Free(zim);
+    Gua_Free(zre);
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Numeric_Transform(Gua_Object *a, Gua_Short kind, Gua_Length n, Gua_Object *object, Gua_String error)
+ *
+ * Description:
+ *     Apply a Fourier transform to a vector, or to each column of a matrix.
+ *
+ * Arguments:
+ *     a,         a vector or a matrix;
+ *     kind,      one of NUMERIC_FFT_*;
+ *     n,         the transform size, or -1 for the length of the columns
+ *                (twice the length minus one for NUMERIC_FFT_INVERSE_REAL);
+ *                shorter columns are padded with zeros, longer ones are
+ *                truncated;
+ *     object,    a structure containing the return object of the function;
+ *     error,     a pointer to the error message.
+ *
+ * Results:
+ *     A complex matrix, or a real one for NUMERIC_FFT_INVERSE_REAL, with
+ *     the shape of a and one transform per column. A real transform keeps
+ *     the bins 0 to n / 2 of each column.
+ */
+Gua_Status Numeric_Transform(Gua_Object *a, Gua_Short kind, Gua_Length n, Gua_Object *object, Gua_String error)
+{
+    Gua_Matrix *ma;
+    Gua_Matrix *mr;
+    Gua_Real *are;
+    Gua_Real *aim;
+    Gua_Real *xre;
+    Gua_Real *xim;
+    Gua_Real *rre;
+    Gua_Real *rim;
+    Gua_Length length;
+    Gua_Length lanes;
+    Gua_Length output;
+    Gua_Length size;
+    Gua_Length i;
+    Gua_Length j;
+    Gua_Short type;
+    Gua_Short row;
+    Gua_String errMessage;
+    
+    ma = Gua_PObjectType(a) == OBJECT_TYPE_MATRIX ? (Gua_Matrix *)Gua_PObjectToMatrix(a) : NULL;
+    type = ma == NULL ? OBJECT_TYPE_UNKNOWN : Gua_GetMatrixType((Gua_Object *)ma->object, Gua_PObjectLength(a));
+    
+    if ((type == OBJECT_TYPE_UNKNOWN) || (ma->dimc > 2) || ((kind == NUMERIC_FFT_REAL) && (type == OBJECT_TYPE_COMPLEX))) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "illegal argument 1");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    /* A vector is one signal, whatever its orientation. */
+    row = (ma->dimc == 1) || (ma->dimv[0] == 1);
+    if (row || (ma->dimv[1] == 1)) {
+        length = Gua_PObjectLength(a);
+        lanes = 1;
+    } else {
+        length = ma->dimv[0];
+        lanes = ma->dimv[1];
+    }
+    
+    if (n < 0) {
+        n = kind == NUMERIC_FFT_INVERSE_REAL ? 2 * (length - 1) : length;
+    }
+    
+    if (n < 1) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "illegal transform size");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    output = kind == NUMERIC_FFT_REAL ? n / 2 + 1 : n;
+    
+    are = (Gua_Real *)Gua_Alloc((Gua_PObjectLength(a) + 1) * sizeof(Gua_Real));
+    aim = (Gua_Real *)Gua_Alloc((Gua_PObjectLength(a) + 1) * sizeof(Gua_Real));
+    xre = (Gua_Real *)Gua_Alloc((n + 1) * sizeof(Gua_Real));
+    xim = (Gua_Real *)Gua_Alloc((n + 1) * sizeof(Gua_Real));
+    rre = (Gua_Real *)Gua_Alloc((output * lanes + 1) * sizeof(Gua_Real));
+    rim = (Gua_Real *)Gua_Alloc((output * lanes + 1) * sizeof(Gua_Real));
+    
+    Gua_PackMatrix((Gua_Object *)ma->object, Gua_PObjectLength(a), are, aim);
+    
+    for (j = 0; j < lanes; j++) {
+        memset(xre, 0, n * sizeof(Gua_Real));
+        memset(xim, 0, n * sizeof(Gua_Real));
+        
+        if (kind == NUMERIC_FFT_INVERSE_REAL) {
+            /* Rebuild the Hermitian spectrum from its first half. */
+            for (i = 0; (i <= n / 2) && (i < length); i++) {
+                xre[i] = are[i * lanes + j];
+                xim[i] = aim[i * lanes + j];
+                if ((i > 0) && (n - i > n / 2)) {
+                    xre[n - i] = are[i * lanes + j];
+                    xim[n - i] = -aim[i * lanes + j];
+                }
+            }
+        } else {
+            for (i = 0; (i < n) && (i < length); i++) {
+                xre[i] = are[i * lanes + j];
+                xim[i] = aim[i * lanes + j];
+            }
+        }
+        
+        if (kind == NUMERIC_FFT_REAL) {
+            Numeric_RealFFT(xre, n, xre, xim);
+            for (i = 0; i < output; i++) {
+                rre[i * lanes + j] = xre[i];
+                rim[i * lanes + j] = xim[i];
+            }
+            continue;
+        }
+        
+        Numeric_FFT(Numeric_GetFFTPlan(n), xre, xim, kind != NUMERIC_FFT_FORWARD);
+        
+        for (i = 0; i < output; i++) {
+            rre[i * lanes + j] = xre[i];
+            rim[i * lanes + j] = xim[i];
+        }
+    }
+    
+    size = output * lanes;
+    
+    Gua_MatrixToPObject(object, (struct Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix)), size);
+    mr = (Gua_Matrix *)Gua_PObjectToMatrix(object);
+    mr->dimc = 2;
+    mr->dimv = (Gua_Length *)Gua_Alloc(2 * sizeof(Gua_Length));
+    mr->dimv[0] = row ? 1 : output;
+    mr->dimv[1] = row ? output : lanes;
+    mr->object = (struct Gua_Object *)Gua_Alloc(size * sizeof(Gua_Object));
+    
+    Gua_UnpackMatrix((Gua_Object *)mr->object, size, rre, kind == NUMERIC_FFT_INVERSE_REAL ? NULL : rim);
+    
+    Gua_Free(rim);
+    Gua_Free(rre);
+    Gua_Free(xim);
+    Gua_Free(xre);
+    Gua_Free(aim);
+    Gua_Free(are);
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Numeric_Convolve(Gua_Object *a, Gua_Object *b, Gua_Short correlate, Gua_Object *object, Gua_String error)
+ *
+ * Description:
+ *     Compute the full linear convolution, or the cross-correlation, of two
+ *     vectors. Short vectors are convolved directly; longer ones through
+ *     a zero padded transform of power of two size.
+ *
+ * Arguments:
+ *     a,            the first vector;
+ *     b,            the second vector;
+ *     correlate,    true for the cross-correlation
+ *                   c[k] = sum a[j + k] conj(b[j]), with the lags from
+ *                   -(length(b) - 1) to length(a) - 1;
+ *     object,       a structure containing the return object of the function;
+ *     error,        a pointer to the error message.
+ *
+ * Results:
+ *     A vector with length(a) + length(b) - 1 elements, a column if both
+ *     arguments are columns and a row otherwise. It holds integers when
+ *     both vectors hold integers, and real numbers when neither is complex.
+ */
+Gua_Status Numeric_Convolve(Gua_Object *a, Gua_Object *b, Gua_Short correlate, Gua_Object *object, Gua_String error)
+{
+    Gua_Matrix *ma;
+    Gua_Matrix *mb;
+    Gua_Matrix *mr;
+    Gua_Object *o;
+    Gua_Real *are;
+    Gua_Real *aim;
+    Gua_Real *bre;
+    Gua_Real *bim;
+    Gua_Real *rre;
+    Gua_Real *rim;
+    Gua_Real tr;
+    Gua_Real ti;
+    Gua_Length na;
+    Gua_Length nb;
+    Gua_Length nr;
+    Gua_Length size;
+    Gua_Length i;
+    Gua_Length j;
+    Gua_Short ta;
+    Gua_Short tb;
+    Gua_Short column;
+    Gua_String errMessage;
+    
+    ma = Gua_PObjectType(a) == OBJECT_TYPE_MATRIX ? (Gua_Matrix *)Gua_PObjectToMatrix(a) : NULL;
+    mb = Gua_PObjectType(b) == OBJECT_TYPE_MATRIX ? (Gua_Matrix *)Gua_PObjectToMatrix(b) : NULL;
+    
+    ta = ma == NULL ? OBJECT_TYPE_UNKNOWN : Gua_GetMatrixType((Gua_Object *)ma->object, Gua_PObjectLength(a));
+    tb = mb == NULL ? OBJECT_TYPE_UNKNOWN : Gua_GetMatrixType((Gua_Object *)mb->object, Gua_PObjectLength(b));
+    
+    if ((ta == OBJECT_TYPE_UNKNOWN) || (tb == OBJECT_TYPE_UNKNOWN) || (Gua_PObjectLength(a) < 1) || (Gua_PObjectLength(b) < 1) || ((ma->dimc == 2) && (ma->dimv[0] != 1) && (ma->dimv[1] != 1)) || ((mb->dimc == 2) && (mb->dimv[0] != 1) && (mb->dimv[1] != 1))) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "the arguments must be vectors");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    na = Gua_PObjectLength(a);
+    nb = Gua_PObjectLength(b);
+    nr = na + nb - 1;
+    
+    column = (ma->dimc == 2) && (ma->dimv[1] == 1) && (na > 1) && (mb->dimc == 2) && (mb->dimv[1] == 1) && (nb > 1);
+    
+    if (na * nb <= NUMERIC_DIRECT_CONVOLUTION) {
+        size = nr;
+    } else {
+        size = 1;
+        while (size < nr) {
+            size = size * 2;
+        }
+    }
+    
+    are = (Gua_Real *)Gua_Alloc((size + 1) * sizeof(Gua_Real));
+    aim = (Gua_Real *)Gua_Alloc((size + 1) * sizeof(Gua_Real));
+    bre = (Gua_Real *)Gua_Alloc((size + 1) * sizeof(Gua_Real));
+    bim = (Gua_Real *)Gua_Alloc((size + 1) * sizeof(Gua_Real));
+    
+    memset(are, 0, size * sizeof(Gua_Real));
+    memset(aim, 0, size * sizeof(Gua_Real));
+    memset(bre, 0, size * sizeof(Gua_Real));
+    memset(bim, 0, size * sizeof(Gua_Real));
+    
+    Gua_PackMatrix((Gua_Object *)ma->object, na, are, aim);
+    Gua_PackMatrix((Gua_Object *)mb->object, nb, bre, bim);
+    
+    /* The correlation is the convolution with the reversed conjugate. */
+    if (correlate) {
+        for (i = 0; i < nb / 2; i++) {
+            tr = bre[i];
+            bre[i] = bre[nb - 1 - i];
+            bre[nb - 1 - i] = tr;
+            ti = bim[i];
+            bim[i] = bim[nb - 1 - i];
+            bim[nb - 1 - i] = ti;
+        }
+        for (i = 0; i < nb; i++) {
+            bim[i] = -bim[i];
+        }
+    }
+    
+    if (na * nb <= NUMERIC_DIRECT_CONVOLUTION) {
+        rre = (Gua_Real *)Gua_Alloc((nr + 1) * sizeof(Gua_Real));
+        rim = (Gua_Real *)Gua_Alloc((nr + 1) * sizeof(Gua_Real));
+        
+        memset(rre, 0, nr * sizeof(Gua_Real));
+        memset(rim, 0, nr * sizeof(Gua_Real));
+        
+        for (i = 0; i < na; i++) {
+            for (j = 0; j < nb; j++) {
+                rre[i + j] += are[i] * bre[j] - aim[i] * bim[j];
+                rim[i + j] += are[i] * bim[j] + aim[i] * bre[j];
+            }
+        }
+        
+        Gua_Free(are);
+        Gua_Free(aim);
+        are = rre;
+        aim = rim;
+    } else {
+        Numeric_FFT(Numeric_GetFFTPlan(size), are, aim, false);
+        Numeric_FFT(Numeric_GetFFTPlan(size), bre, bim, false);
+        
+        for (i = 0; i < size; i++) {
+            tr = are[i] * bre[i] - aim[i] * bim[i];
+            ti = are[i] * bim[i] + aim[i] * bre[i];
+            are[i] = tr;
+            aim[i] = ti;
+        }
+        
+        Numeric_FFT(Numeric_GetFFTPlan(size), are, aim, true);
+    }
+    
+    Gua_MatrixToPObject(object, (struct Gua_Matrix *)Gua_Alloc(sizeof(Gua_Matrix)), nr);
+    mr = (Gua_Matrix *)Gua_PObjectToMatrix(object);
+    mr->dimc = 2;
+    mr->dimv = (Gua_Length *)Gua_Alloc(2 * sizeof(Gua_Length));
+    mr->dimv[0] = column ? nr : 1;
+    mr->dimv[1] = column ? 1 : nr;
+    mr->object = (struct Gua_Object *)Gua_Alloc(nr * sizeof(Gua_Object));
+    o = (Gua_Object *)mr->object;
+    
+    if ((ta == OBJECT_TYPE_INTEGER) && (tb == OBJECT_TYPE_INTEGER)) {
+        for (i = 0; i < nr; i++) {
+            Gua_IntegerToObject(o[i], (Gua_Integer)floor(are[i] + 0.5));
+        }
+    } else {
+        Gua_UnpackMatrix(o, nr, are, (ta == OBJECT_TYPE_COMPLEX) || (tb == OBJECT_TYPE_COMPLEX) ? aim : NULL);
+    }
+    
+    Gua_Free(bim);
+    Gua_Free(bre);
+    Gua_Free(aim);
+    Gua_Free(are);
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Numeric_Householder(Gua_Real *x, Gua_Length n, Gua_Real *tau)
+ *
+ * Description:
+ *     Compute the Householder reflector H = I - tau v v' that maps x to
+ *     beta e1. The vector v has v[0] = 1 and its other elements overwrite
+ *     x[1]... x[n - 1]; beta overwrites x[0].
+ *
+ * Arguments:
+ *     x,      the vector;
+ *     n,      the vector length;
+ *     tau,    a pointer to the reflector scale factor.
+ *
+ * Results:
+ *     The function overwrites x and sets tau, which is zero when x is
+ *     already a multiple of e1.
+ */
+void Numeric_Householder(Gua_Real *x, Gua_Length n, Gua_Real *tau)
+{
+    Gua_Real alpha;
+    Gua_Real beta;
+    Gua_Real sigma;
+    Gua_Real scale;
+    Gua_Length i;
+    
+    alpha = x[0];
+    sigma = 0.0;
+    
+    for (i = 1; i < n; i++) {
+        sigma += x[i] * x[i];
+    }
+    
+    if (sigma == 0.0) {
+        *tau = 0.0;
+        
+        return;
+    }
+    
+    beta = sqrt(alpha * alpha + sigma);
+    if (alpha >= 0.0) {
+        beta = -beta;
+    }
+    
+    *tau = (beta - alpha) / beta;
+    scale = 1.0 / (alpha - beta);
+    
+    for (i = 1; i < n; i++) {
+        x[i] *= scale;
+    }
+    
+    x[0] = beta;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Numeric_QRBlockReflector(Gua_Real *a, Gua_Length m, Gua_Length k, Gua_Length nb, Gua_Real *tau, Gua_Real *t)
+ *
+ * Description:
+ *     Build the upper triangular factor T of the block reflector
+ *     H(k) H(k + 1)... H(k + nb - 1) = I - Y T Y', where the columns of Y
+ *     are the Householder vectors stored below the diagonal of a. The
+ *     products of the vectors are taken in one pass over tiles of rows.
+ *
+ * Arguments:
+ *     a,      the factored matrix, m rows stored by columns;
+ *     m,      the number of rows;
+ *     k,      the first reflector of the block;
+ *     nb,     the number of reflectors of the block;
+ *     tau,    the reflector scale factors;
+ *     t,      room for the nb x nb factor, stored by rows.
+ *
+ * Results:
+ *     The function fills t.
+ */
+void Numeric_QRBlockReflector(Gua_Real *a, Gua_Length m, Gua_Length k, Gua_Length nb, Gua_Real *tau, Gua_Real *t)
+{
+    Gua_Real *g;
+    Gua_Real *yp;
+    Gua_Real *yq;
+    Gua_Real *y0;
+    Gua_Real *y1;
+    Gua_Real *y2;
+    Gua_Real *y3;
+    Gua_Real s;
+    Gua_Real s0;
+    Gua_Real s1;
+    Gua_Real s2;
+    Gua_Real s3;
+    Gua_Length first;
+    Gua_Length last;
+    Gua_Length p;
+    Gua_Length q;
+    Gua_Length r;
+    Gua_Length i;
+    
+    g = (Gua_Real *)Gua_Alloc((nb * nb + 1) * sizeof(Gua_Real));
+    
+    /* G(p, q) = y(p)' y(q) for p < q, where y(q) is zero above row k + q and one on it. */
+    for (q = 0; q < nb; q++) {
+        for (p = 0; p < q; p++) {
+            g[p * nb + q] = a[(k + p) * m + k + q];
+        }
+    }
+    for (q = 1; q < nb; q++) {
+        yq = a + (k + q) * m;
+        for (p = 0; p < q; p++) {
+            yp = a + (k + p) * m;
+            for (i = k + q + 1; i < k + nb; i++) {
+                g[p * nb + q] += yp[i] * yq[i];
+            }
+        }
+    }
+    for (first = k + nb; first < m; first += NUMERIC_QR_TILE) {
+        last = first + NUMERIC_QR_TILE < m ? first + NUMERIC_QR_TILE : m;
+        for (q = 1; q < nb; q++) {
+            yq = a + (k + q) * m;
+            for (p = 0; p + 3 < q; p += 4) {
+                y0 = a + (k + p) * m;
+                y1 = y0 + m;
+                y2 = y1 + m;
+                y3 = y2 + m;
+                s0 = 0.0;
+                s1 = 0.0;
+                s2 = 0.0;
+                s3 = 0.0;
+                for (i = first; i < last; i++) {
+                    s0 += y0[i] * yq[i];
+                    s1 += y1[i] * yq[i];
+                    s2 += y2[i] * yq[i];
+                    s3 += y3[i] * yq[i];
+                }
+                g[p * nb + q] += s0;
+                g[(p + 1) * nb + q] += s1;
+                g[(p + 2) * nb + q] += s2;
+                g[(p + 3) * nb + q] += s3;
+            }
+            for (; p < q; p++) {
+                yp = a + (k + p) * m;
+                s = 0.0;
+                for (i = first; i < last; i++) {
+                    s += yp[i] * yq[i];
+                }
+                g[p * nb + q] += s;
+            }
+        }
+    }
+    
+    /* T(0:q - 1, q) = -tau(q) T(0:q - 1, 0:q - 1) G(0:q - 1, q). */
+    memset(t, 0, nb * nb * sizeof(Gua_Real));
+    
+    for (q = 0; q < nb; q++) {
+        t[q * nb + q] = tau[k + q];
+        for (p = 0; p < q; p++) {
+            s = 0.0;
+            for (r = p; r < q; r++) {
+                s += t[p * nb + r] * g[r * nb + q];
+            }
+            t[p * nb + q] = -tau[k + q] * s;
+        }
+    }
+    
+    Gua_Free(g);
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Numeric_QRApplyBlock(Gua_Real *a, Gua_Length m, Gua_Length k, Gua_Length nb, Gua_Real *t, Gua_Real *c, Gua_Length cols, Gua_Short transpose)
+ *
+ * Description:
+ *     Apply the block reflector I - Y T Y', or its transpose, to a matrix.
+ *     The products Y' C and Y V run over tiles of NUMERIC_QR_TILE rows, so
+ *     each tile of Y and C is read once from memory for all the reflectors
+ *     of the block, instead of once per reflector.
+ *
+ * Arguments:
+ *     a,            the factored matrix, m rows stored by columns;
+ *     m,            the number of rows;
+ *     k,            the first reflector of the block;
+ *     nb,           the number of reflectors of the block;
+ *     t,            the block reflector factor;
+ *     c,            the matrix, m rows stored by columns;
+ *     cols,         the number of columns of c;
+ *     transpose,    true to apply the transpose.
+ *
+ * Results:
+ *     The function overwrites c.
+ */
+void Numeric_QRApplyBlock(Gua_Real *a, Gua_Length m, Gua_Length k, Gua_Length nb, Gua_Real *t, Gua_Real *c, Gua_Length cols, Gua_Short transpose)
+{
+    Gua_Real *w;
+    Gua_Real *v;
+    Gua_Real *yp;
+    Gua_Real *y0;
+    Gua_Real *y1;
+    Gua_Real *y2;
+    Gua_Real *y3;
+    Gua_Real *cj;
+    Gua_Real s;
+    Gua_Real s0;
+    Gua_Real s1;
+    Gua_Real s2;
+    Gua_Real s3;
+    Gua_Length first;
+    Gua_Length last;
+    Gua_Length p;
+    Gua_Length r;
+    Gua_Length i;
+    Gua_Length j;
+    
+    if (cols < 1) {
+        return;
+    }
+    
+    w = (Gua_Real *)Gua_Alloc((nb * cols + 1) * sizeof(Gua_Real));
+    v = (Gua_Real *)Gua_Alloc((nb * cols + 1) * sizeof(Gua_Real));
+    
+    /* W = Y' C, first over the unit lower triangle of Y, then over its rows from k + nb on. */
+    for (j = 0; j < cols; j++) {
+        cj = c + j * m;
+        for (p = 0; p < nb; p++) {
+            yp = a + (k + p) * m;
+            s = cj[k + p];
+            for (i = k + p + 1; i < k + nb; i++) {
+                s += yp[i] * cj[i];
+            }
+            w[p * cols + j] = s;
+        }
+    }
+    for (first = k + nb; first < m; first += NUMERIC_QR_TILE) {
+        last = first + NUMERIC_QR_TILE < m ? first + NUMERIC_QR_TILE : m;
+        for (j = 0; j < cols; j++) {
+            cj = c + j * m;
+            for (p = 0; p + 3 < nb; p += 4) {
+                y0 = a + (k + p) * m;
+                y1 = y0 + m;
+                y2 = y1 + m;
+                y3 = y2 + m;
+                s0 = 0.0;
+                s1 = 0.0;
+                s2 = 0.0;
+                s3 = 0.0;
+                for (i = first; i < last; i++) {
+                    s0 += y0[i] * cj[i];
+                    s1 += y1[i] * cj[i];
+                    s2 += y2[i] * cj[i];
+                    s3 += y3[i] * cj[i];
+                }
+                w[p * cols + j] += s0;
+                w[(p + 1) * cols + j] += s1;
+                w[(p + 2) * cols + j] += s2;
+                w[(p + 3) * cols + j] += s3;
+            }
+            for (; p < nb; p++) {
+                yp = a + (k + p) * m;
+                s = 0.0;
+                for (i = first; i < last; i++) {
+                    s += yp[i] * cj[i];
+                }
+                w[p * cols + j] += s;
+            }
+        }
+    }
+    
+    /* V = T W or V = T' W. */
+    for (p = 0; p < nb; p++) {
+        for (j = 0; j < cols; j++) {
+            s = 0.0;
+            if (transpose) {
+                for (r = 0; r <= p; r++) {
+                    s += t[r * nb + p] * w[r * cols + j];
+                }
+            } else {
+                for (r = p; r < nb; r++) {
+                    s += t[p * nb + r] * w[r * cols + j];
+                }
+            }
+            v[p * cols + j] = s;
+        }
+    }
+    
+    /* C = C - Y V, in the same order. */
+    for (j = 0; j < cols; j++) {
+        cj = c + j * m;
+        for (p = 0; p < nb; p++) {
+            yp = a + (k + p) * m;
+            s = v[p * cols + j];
+            cj[k + p] -= s;
+            for (i = k + p + 1; i < k + nb; i++) {
+                cj[i] -= yp[i] * s;
+            }
+        }
+    }
+    for (first = k + nb; first < m; first += NUMERIC_QR_TILE) {
+        last = first + NUMERIC_QR_TILE < m ? first + NUMERIC_QR_TILE : m;
+        for (j = 0; j < cols; j++) {
+            cj = c + j * m;
+            for (p = 0; p + 3 < nb; p += 4) {
+                y0 = a + (k + p) * m;
+                y1 = y0 + m;
+                y2 = y1 + m;
+                y3 = y2 + m;
+                s0 = v[p * cols + j];
+                s1 = v[(p + 1) * cols + j];
+                s2 = v[(p + 2) * cols + j];
+                s3 = v[(p + 3) * cols + j];
+                for (i = first; i < last; i++) {
+                    cj[i] -= y0[i] * s0 + y1[i] * s1 + y2[i] * s2 + y3[i] * s3;
+                }
+            }
+            for (; p < nb; p++) {
+                yp = a + (k + p) * m;
+                s = v[p * cols + j];
+                for (i = first; i < last; i++) {
+                    cj[i] -= yp[i] * s;
+                }
+            }
+        }
+    }
+    
+    Gua_Free(v);
+    Gua_Free(w);
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Numeric_QRPanel(Gua_Real *a, Gua_Length m, Gua_Length k, Gua_Length nb, Gua_Real *tau, Gua_Real *t)
+ *
+ * Description:
+ *     Factor the columns k to k + nb - 1 of a matrix, from the row k down.
+ *     The left half of the panel is factored first, its reflectors are
+ *     applied to the right half as a block, and then the right half is
+ *     factored; a tall panel is so read a few times, not once per column.
+ *
+ * Arguments:
+ *     a,      the matrix, m rows stored by columns;
+ *     m,      the number of rows;
+ *     k,      the first column of the panel;
+ *     nb,     the number of columns of the panel;
+ *     tau,    the reflector scale factors;
+ *     t,      room for a nb x nb block reflector factor.
+ *
+ * Results:
+ *     The function overwrites the panel and sets tau[k]... tau[k + nb - 1].
+ */
+void Numeric_QRPanel(Gua_Real *a, Gua_Length m, Gua_Length k, Gua_Length nb, Gua_Real *tau, Gua_Real *t)
+{
+    Gua_Length half;
+    
+    if (nb == 1) {
+        Numeric_Householder(a + k * m + k, m - k, &tau[k]);
+        
+        return;
+    }
+    
+    half = nb / 2;
+    
+    Numeric_QRPanel(a, m, k, half, tau, t);
+    Numeric_QRBlockReflector(a, m, k, half, tau, t);
+    Numeric_QRApplyBlock(a, m, k, half, t, a + (k + half) * m, nb - half, true);
+    Numeric_QRPanel(a, m, k + half, nb - half, tau, t);
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Numeric_QR(Gua_Real *a, Gua_Length m, Gua_Length n, Gua_Real *tau)
+ *
+ * Description:
+ *     Blocked Householder QR factorization A = Q R. The columns are
+ *     factored in panels of NUMERIC_QR_BLOCK; the reflectors of a panel
+ *     are then applied together to the remaining columns as one block
+ *     reflector.
+ *
+ * Arguments:
+ *     a,      the matrix, m rows stored by columns;
+ *     m,      the number of rows;
+ *     n,      the number of columns;
+ *     tau,    room for min(m, n) reflector scale factors.
+ *
+ * Results:
+ *     The function overwrites the upper triangle of a with R and the part
+ *     below the diagonal with the Householder vectors of Q.
+ */
+void Numeric_QR(Gua_Real *a, Gua_Length m, Gua_Length n, Gua_Real *tau)
+{
+    Gua_Real *t;
+    Gua_Length kmax;
+    Gua_Length nb;
+    Gua_Length k;
+    
+    kmax = m < n ? m : n;
+    
+    t = (Gua_Real *)Gua_Alloc((NUMERIC_QR_BLOCK * NUMERIC_QR_BLOCK + 1) * sizeof(Gua_Real));
+    
+    for (k = 0; k < kmax; k += NUMERIC_QR_BLOCK) {
+        nb = kmax - k < NUMERIC_QR_BLOCK ? kmax - k : NUMERIC_QR_BLOCK;
+        
+        Numeric_QRPanel(a, m, k, nb, tau, t);
+        
+        if (k + nb < n) {
+            Numeric_QRBlockReflector(a, m, k, nb, tau, t);
+            Numeric_QRApplyBlock(a, m, k, nb, t, a + (k + nb) * m, n - k - nb, true);
+        }
+    }
+    
+    Gua_Free(t);
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Numeric_QRApply(Gua_Real *a, Gua_Length m, Gua_Length n, Gua_Real *tau, Gua_Real *c, Gua_Length cols, Gua_Short transpose)
+ *
+ * Description:
+ *     Multiply a matrix by the Q of a factorization, or by its transpose.
+ *
+ * Arguments:
+ *     a,            the matrix factored by Numeric_QR;
+ *     m,            the number of rows;
+ *     n,            the number of columns;
+ *     tau,          the reflector scale factors;
+ *     c,            the matrix, m rows stored by columns;
+ *     cols,         the number of columns of c;
+ *     transpose,    true to multiply by Q'.
+ *
+ * Results:
+ *     The function overwrites c.
+ */
+void Numeric_QRApply(Gua_Real *a, Gua_Length m, Gua_Length n, Gua_Real *tau, Gua_Real *c, Gua_Length cols, Gua_Short transpose)
+{
+    Gua_Real *t;
+    Gua_Length kmax;
+    Gua_Length nb;
+    Gua_Length k;
+    
+    kmax = m < n ? m : n;
+    
+    t = (Gua_Real *)Gua_Alloc((NUMERIC_QR_BLOCK * NUMERIC_QR_BLOCK + 1) * sizeof(Gua_Real));
+    
+    if (transpose) {
+        for (k = 0; k < kmax; k += NUMERIC_QR_BLOCK) {
+            nb = kmax - k < NUMERIC_QR_BLOCK ? kmax - k : NUMERIC_QR_BLOCK;
+            Numeric_QRBlockReflector(a, m, k, nb, tau, t);
+            Numeric_QRApplyBlock(a, m, k, nb, t, c, cols, true);
+        }
+    } else {
+        for (k = ((kmax - 1) / NUMERIC_QR_BLOCK) * NUMERIC_QR_BLOCK; k >= 0; k -= NUMERIC_QR_BLOCK) {
+            nb = kmax - k < NUMERIC_QR_BLOCK ? kmax - k : NUMERIC_QR_BLOCK;
+            Numeric_QRBlockReflector(a, m, k, nb, tau, t);
+            Numeric_QRApplyBlock(a, m, k, nb, t, c, cols, false);
+        }
+    }
+    
+    Gua_Free(t);
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Real *Numeric_ColumnBuffer(Gua_Object *a, Gua_Length *rows, Gua_Length *cols)
+ *
+ * Description:
+ *     Copy an integer or real matrix to a buffer of real numbers stored by
+ *     columns. A one dimensional vector is taken as a column.
+ *
+ * Arguments:
+ *     a,       the matrix;
+ *     rows,    a pointer to the number of rows;
+ *     cols,    a pointer to the number of columns.
+ *
+ * Results:
+ *     The new buffer, or NULL if a is not an integer or real matrix.
+ */
+Gua_Real *Numeric_ColumnBuffer(Gua_Object *a, Gua_Length *rows, Gua_Length *cols)
+{
+    Gua_Real *x;
+    Gua_Real *y;
+    Gua_Length i;
+    Gua_Length j;
+    
+    x = Matrix_GetRealBuffer(a, rows, cols);
+    
+    if (x == NULL) {
+        return NULL;
+    }
+    
+    if ((*rows == 1) || (*cols == 1)) {
+        return x;
+    }
+    
+    y = (Gua_Real *)Gua_Alloc((*rows * *cols + 1) * sizeof(Gua_Real));
+    
+    for (i = 0; i < *rows; i++) {
+        for (j = 0; j < *cols; j++) {
+            y[j * *rows + i] = x[i * *cols + j];
+        }
+    }
+    
+    Gua_Free(x);
+    
+    return y;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Numeric_QRDecomposition(Gua_Object *a, Gua_Object *q, Gua_Object *r, Gua_String error)
+ *
+ * Description:
+ *     Compute the economy size QR factorization of a matrix.
+ *
+ * Arguments:
+ *     a,        a m x n matrix;
+ *     q,        a structure for the m x min(m, n) matrix Q with orthonormal
+ *               columns, or NULL if it is not needed;
+ *     r,        a structure for the min(m, n) x n upper triangular matrix R;
+ *     error,    a pointer to the error message.
+ *
+ * Results:
+ *     The factors Q and R, with A = Q R.
+ */
+Gua_Status Numeric_QRDecomposition(Gua_Object *a, Gua_Object *q, Gua_Object *r, Gua_String error)
+{
+    Gua_Real *x;
+    Gua_Real *tau;
+    Gua_Real *y;
+    Gua_Length m;
+    Gua_Length n;
+    Gua_Length kmax;
+    Gua_Length i;
+    Gua_Length j;
+    Gua_String errMessage;
+    
+    x = Numeric_ColumnBuffer(a, &m, &n);
+    
+    if (x == NULL) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "illegal argument 1");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    kmax = m < n ? m : n;
+    
+    tau = (Gua_Real *)Gua_Alloc((kmax + 1) * sizeof(Gua_Real));
+    
+    Numeric_QR(x, m, n, tau);
+    
+    /* R is stored by rows in the result. */
+    y = (Gua_Real *)Gua_Alloc((kmax * n + 1) * sizeof(Gua_Real));
+    
+    for (i = 0; i < kmax; i++) {
+        for (j = 0; j < n; j++) {
+            y[i * n + j] = j >= i ? x[j * m + i] : 0.0;
+        }
+    }
+    
+    Matrix_RealBufferToPObject(r, y, kmax, n);
+    
+    Gua_Free(y);
+    
+    if (q != NULL) {
+        /* Q is the product of the reflectors by the first columns of the identity. */
+        y = (Gua_Real *)Gua_Alloc((m * kmax + 1) * sizeof(Gua_Real));
+        
+        memset(y, 0, m * kmax * sizeof(Gua_Real));
+        for (j = 0; j < kmax; j++) {
+            y[j * m + j] = 1.0;
+        }
+        
+        Numeric_QRApply(x, m, n, tau, y, kmax, false);
+        
+        Gua_Free(x);
+        x = (Gua_Real *)Gua_Alloc((m * kmax + 1) * sizeof(Gua_Real));
+        
+        for (i = 0; i < m; i++) {
+            for (j = 0; j < kmax; j++) {
+                x[i * kmax + j] = y[j * m + i];
+            }
+        }
+        
+        Matrix_RealBufferToPObject(q, x, m, kmax);
+        
+        Gua_Free(y);
+    }
+    
+    Gua_Free(tau);
+    Gua_Free(x);
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Numeric_LeastSquares(Gua_Object *a, Gua_Object *b, Gua_Object *x, Gua_Object *residuals, Gua_String error)
+ *
+ * Description:
+ *     Solve the least squares problem min ||A x - b|| through the QR
+ *     factorization of A: x = R \ (Q' b), and the residual is the norm of
+ *     the remaining rows of Q' b.
+ *
+ * Arguments:
+ *     a,            a m x n matrix, with m >= n and rank n;
+ *     b,            a vector of m elements, or a m x k matrix;
+ *     x,            a structure containing the n x k coefficients;
+ *     residuals,    a structure for the 1 x k sums of the squared
+ *                   residuals, or NULL if they are not needed;
+ *     error,        a pointer to the error message.
+ *
+ * Results:
+ *     The coefficients and the sums of the squared residuals.
+ */
+Gua_Status Numeric_LeastSquares(Gua_Object *a, Gua_Object *b, Gua_Object *x, Gua_Object *residuals, Gua_String error)
+{
+    Gua_Real *qr;
+    Gua_Real *tau;
+    Gua_Real *c;
+    Gua_Real *y;
+    Gua_Real rmax;
+    Gua_Real s;
+    Gua_Length m;
+    Gua_Length n;
+    Gua_Length rows;
+    Gua_Length cols;
+    Gua_Length i;
+    Gua_Length j;
+    Gua_Length l;
+    Gua_String errMessage;
+    
+    qr = Numeric_ColumnBuffer(a, &m, &n);
+    
+    if (qr == NULL) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "illegal argument 1");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    c = Numeric_ColumnBuffer(b, &rows, &cols);
+    
+    if (c == NULL) {
+        Gua_Free(qr);
+        
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "illegal argument 2");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    /* A row vector is taken as a column. */
+    if ((rows == 1) && (cols == m)) {
+        rows = m;
+        cols = 1;
+    }
+    
+    if ((rows != m) || (m < n)) {
+        Gua_Free(c);
+        Gua_Free(qr);
+        
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "the matrices do not have compatible dimensions");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    tau = (Gua_Real *)Gua_Alloc((n + 1) * sizeof(Gua_Real));
+    
+    Numeric_QR(qr, m, n, tau);
+    
+    rmax = 0.0;
+    for (j = 0; j < n; j++) {
+        if (fabs(qr[j * m + j]) > rmax) {
+            rmax = fabs(qr[j * m + j]);
+        }
+    }
+    for (j = 0; j < n; j++) {
+        if (fabs(qr[j * m + j]) <= rmax * m * DBL_EPSILON) {
+            Gua_Free(tau);
+            Gua_Free(c);
+            Gua_Free(qr);
+            
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "the matrix is rank deficient");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+    }
+    
+    Numeric_QRApply(qr, m, n, tau, c, cols, true);
+    
+    /* Back substitution on the first n rows of Q' b; the solution is stored by rows. */
+    y = (Gua_Real *)Gua_Alloc((n * cols + 1) * sizeof(Gua_Real));
+    
+    for (l = 0; l < cols; l++) {
+        for (i = n - 1; i >= 0; i--) {
+            s = c[l * m + i];
+            for (j = i + 1; j < n; j++) {
+                s -= qr[j * m + i] * y[j * cols + l];
+            }
+            y[i * cols + l] = s / qr[i * m + i];
+        }
+    }
+    
+    Matrix_RealBufferToPObject(x, y, n, cols);
+    
+    if (residuals != NULL) {
+        for (l = 0; l < cols; l++) {
+            s = 0.0;
+            for (i = n; i < m; i++) {
+                s += c[l * m + i] * c[l * m + i];
+            }
+            y[l] = s;
+        }
+        
+        Matrix_RealBufferToPObject(residuals, y, 1, cols);
+    }
+    
+    Gua_Free(y);
+    Gua_Free(tau);
+    Gua_Free(c);
+    Gua_Free(qr);
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Numeric_Tridiagonalize(Gua_Real *v, Gua_Length n, Gua_Real *d, Gua_Real *e, Gua_Short vectors)
+ *
+ * Description:
+ *     Reduce a symmetric matrix to tridiagonal form by Householder
+ *     similarity transformations (the tred2 procedure). The matrix is
+ *     stored by columns, so the inner loops, which walk the columns, read
+ *     contiguous memory.
+ *
+ * Arguments:
+ *     v,          the symmetric matrix, stored by columns;
+ *     n,          the order of the matrix;
+ *     d,          room for the diagonal;
+ *     e,          room for the subdiagonal, in e[1]... e[n - 1];
+ *     vectors,    true to accumulate the transformations in v.
+ *
+ * Results:
+ *     The function fills d and e, and overwrites v with the orthogonal
+ *     transformation if vectors is true.
+ */
+void Numeric_Tridiagonalize(Gua_Real *v, Gua_Length n, Gua_Real *d, Gua_Real *e, Gua_Short vectors)
+{
+    Gua_Real *vj;
+    Gua_Real scale;
+    Gua_Real f;
+    Gua_Real g;
+    Gua_Real h;
+    Gua_Real hh;
+    Gua_Length i;
+    Gua_Length j;
+    Gua_Length k;
+    
+    for (j = 0; j < n; j++) {
+        d[j] = v[j * n + n - 1];
+    }
+    
+    for (i = n - 1; i > 0; i--) {
+        scale = 0.0;
+        h = 0.0;
+        
+        for (k = 0; k < i; k++) {
+            scale += fabs(d[k]);
+        }
+        
+        if (scale == 0.0) {
+            e[i] = d[i - 1];
+            for (j = 0; j < i; j++) {
+                d[j] = v[j * n + i - 1];
+                v[j * n + i] = 0.0;
+                v[i * n + j] = 0.0;
+            }
+        } else {
+            /* Generate the Householder vector. */
+            for (k = 0; k < i; k++) {
+                d[k] /= scale;
+                h += d[k] * d[k];
+            }
+            f = d[i - 1];
+            g = sqrt(h);
+            if (f > 0) {
+                g = -g;
+            }
+            e[i] = scale * g;
+            h = h - f * g;
+            d[i - 1] = f - g;
+            for (j = 0; j < i; j++) {
+                e[j] = 0.0;
+            }
+            
+            /* Apply the similarity transformation to the remaining columns. */
+            for (j = 0; j < i; j++) {
+                vj = v + j * n;
+                f = d[j];
+                v[i * n + j] = f;
+                g = e[j] + vj[j] * f;
+                for (k = j + 1; k < i; k++) {
+                    g += vj[k] * d[k];
+                    e[k] += vj[k] * f;
+                }
+                e[j] = g;
+            }
+            f = 0.0;
+            for (j = 0; j < i; j++) {
+                e[j] /= h;
+                f += e[j] * d[j];
+            }
+            hh = f / (h + h);
+            for (j = 0; j < i; j++) {
+                e[j] -= hh * d[j];
+            }
+            for (j = 0; j < i; j++) {
+                vj = v + j * n;
+                f = d[j];
+                g = e[j];
+                for (k = j; k < i; k++) {
+                    vj[k] -= (f * e[k] + g * d[k]);
+                }
+                d[j] = vj[i - 1];
+                vj[i] = 0.0;
+            }
+        }
+        d[i] = h;
+    }
+    
+    if (!vectors) {
+        for (j = 0; j < n; j++) {
+            d[j] = v[j * n + j];
+        }
+        e[0] = 0.0;
+        
+        return;
+    }
+    
+    /* Accumulate the transformations. */
+    for (i = 0; i < n - 1; i++) {
+        v[i * n + n - 1] = v[i * n + i];
+        v[i * n + i] = 1.0;
+        h = d[i + 1];
+        if (h != 0.0) {
+            for (k = 0; k <= i; k++) {
+                d[k] = v[(i + 1) * n + k] / h;
+            }
+            for (j = 0; j <= i; j++) {
+                vj = v + j * n;
+                g = 0.0;
+                for (k = 0; k <= i; k++) {
+                    g += v[(i + 1) * n + k] * vj[k];
+                }
+                for (k = 0; k <= i; k++) {
+                    vj[k] -= g * d[k];
+                }
+            }
+        }
+        for (k = 0; k <= i; k++) {
+            v[(i + 1) * n + k] = 0.0;
+        }
+    }
+    for (j = 0; j < n; j++) {
+        d[j] = v[j * n + n - 1];
+        v[j * n + n - 1] = 0.0;
+    }
+    v[(n - 1) * n + n - 1] = 1.0;
+    e[0] = 0.0;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Numeric_TridiagonalQL(Gua_Real *d, Gua_Real *e, Gua_Length n, Gua_Real *v, Gua_Short vectors)
+ *
+ * Description:
+ *     Find the eigenvalues, and optionally the eigenvectors, of a symmetric
+ *     tridiagonal matrix by the QL method with implicit shifts (the tql2
+ *     procedure).
+ *
+ * Arguments:
+ *     d,          the diagonal;
+ *     e,          the subdiagonal, in e[1]... e[n - 1];
+ *     n,          the order of the matrix;
+ *     v,          the transformation from Numeric_Tridiagonalize, stored
+ *                 by columns;
+ *     vectors,    true to compute the eigenvectors.
+ *
+ * Results:
+ *     The function overwrites d with the eigenvalues in ascending order and
+ *     v with the eigenvectors in the same order. It returns GUA_ERROR if
+ *     an eigenvalue does not converge in NUMERIC_EIGEN_ITERATIONS.
+ */
+Gua_Status Numeric_TridiagonalQL(Gua_Real *d, Gua_Real *e, Gua_Length n, Gua_Real *v, Gua_Short vectors)
+{
+    Gua_Real *vi;
+    Gua_Real *vj;
+    Gua_Real f;
+    Gua_Real g;
+    Gua_Real h;
+    Gua_Real p;
+    Gua_Real r;
+    Gua_Real c;
+    Gua_Real c2;
+    Gua_Real c3;
+    Gua_Real s;
+    Gua_Real s2;
+    Gua_Real dl1;
+    Gua_Real el1;
+    Gua_Real tst1;
+    Gua_Length iterations;
+    Gua_Length i;
+    Gua_Length j;
+    Gua_Length k;
+    Gua_Length l;
+    Gua_Length m;
+    
+    for (i = 1; i < n; i++) {
+        e[i - 1] = e[i];
+    }
+    e[n - 1] = 0.0;
+    
+    f = 0.0;
+    tst1 = 0.0;
+    
+    for (l = 0; l < n; l++) {
+        /* Find a small subdiagonal element. */
+        if (fabs(d[l]) + fabs(e[l]) > tst1) {
+            tst1 = fabs(d[l]) + fabs(e[l]);
+        }
+        m = l;
+        while (m < n - 1) {
+            if (fabs(e[m]) <= DBL_EPSILON * tst1) {
+                break;
+            }
+            m++;
+        }
+        
+        /* If m == l, d[l] is already an eigenvalue; otherwise iterate. */
+        if (m > l) {
+            iterations = 0;
+            do {
+                if (++iterations > NUMERIC_EIGEN_ITERATIONS) {
+                    return GUA_ERROR;
+                }
+                
+                /* Compute the implicit shift. */
+                g = d[l];
+                p = (d[l + 1] - g) / (2.0 * e[l]);
+                r = hypot(p, 1.0);
+                if (p < 0) {
+                    r = -r;
+                }
+                d[l] = e[l] / (p + r);
+                d[l + 1] = e[l] * (p + r);
+                dl1 = d[l + 1];
+                h = g - d[l];
+                for (i = l + 2; i < n; i++) {
+                    d[i] -= h;
+                }
+                f = f + h;
+                
+                /* Implicit QL transformation. */
+                p = d[m];
+                c = 1.0;
+                c2 = c;
+                c3 = c;
+                el1 = e[l + 1];
+                s = 0.0;
+                s2 = 0.0;
+                for (i = m - 1; i >= l; i--) {
+                    c3 = c2;
+                    c2 = c;
+                    s2 = s;
+                    g = c * e[i];
+                    h = c * p;
+                    r = hypot(p, e[i]);
+                    e[i + 1] = s * r;
+                    s = e[i] / r;
+                    c = p / r;
+                    p = c * d[i] - s * g;
+                    d[i + 1] = h + s * (c * g + s * d[i]);
+                    
+                    if (vectors) {
+                        vi = v + i * n;
+                        vj = vi + n;
+                        for (k = 0; k < n; k++) {
+                            h = vj[k];
+                            vj[k] = s * vi[k] + c * h;
+                            vi[k] = c * vi[k] - s * h;
+                        }
+                    }
+                }
+                p = -s * s2 * c3 * el1 * e[l] / dl1;
+                e[l] = s * p;
+                d[l] = c * p;
+            } while (fabs(e[l]) > DBL_EPSILON * tst1);
+        }
+        d[l] = d[l] + f;
+        e[l] = 0.0;
+    }
+    
+    /* Sort the eigenvalues and the eigenvectors. */
+    for (i = 0; i < n - 1; i++) {
+        k = i;
+        p = d[i];
+        for (j = i + 1; j < n; j++) {
+            if (d[j] < p) {
+                k = j;
+                p = d[j];
+            }
+        }
+        if (k != i) {
+            d[k] = d[i];
+            d[i] = p;
+            if (vectors) {
+                for (j = 0; j < n; j++) {
+                    p = v[i * n + j];
+                    v[i * n + j] = v[k * n + j];
+                    v[k * n + j] = p;
+                }
+            }
+        }
+    }
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Numeric_SymmetricEigen(Gua_Real *a, Gua_Length n, Gua_Real *w, Gua_Short vectors)
+ *
+ * Description:
+ *     Compute the eigenvalues and, optionally, the eigenvectors of a real
+ *     symmetric matrix.
+ *
+ * Arguments:
+ *     a,          the symmetric matrix, stored by columns;
+ *     n,          the order of the matrix;
+ *     w,          room for the n eigenvalues;
+ *     vectors,    true to compute the eigenvectors.
+ *
+ * Results:
+ *     The eigenvalues in ascending order and, if vectors is true, the
+ *     eigenvectors in the columns of a. The function returns GUA_ERROR if
+ *     the QL iteration does not converge.
+ */
+Gua_Status Numeric_SymmetricEigen(Gua_Real *a, Gua_Length n, Gua_Real *w, Gua_Short vectors)
+{
+    Gua_Real *e;
+    Gua_Status status;
+    
+    if (n < 1) {
+        return GUA_OK;
+    }
+    
+    e = (Gua_Real *)Gua_Alloc((n + 1) * sizeof(Gua_Real));
+    
+    Numeric_Tridiagonalize(a, n, w, e, vectors);
+    status = Numeric_TridiagonalQL(w, e, n, a, vectors);
+    
+    Gua_Free(e);
+    
+    return status;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Numeric_JacobiSVD(Gua_Real *u, Gua_Length m, Gua_Length n, Gua_Real *s, Gua_Real *v)
+ *
+ * Description:
+ *     One-sided Jacobi singular value decomposition. Plane rotations are
+ *     applied to pairs of columns until all the columns are orthogonal;
+ *     the column norms are then the singular values.
+ *
+ * Arguments:
+ *     u,    the m x n matrix, stored by columns, with m >= n;
+ *     m,    the number of rows;
+ *     n,    the number of columns;
+ *     s,    room for the n singular values;
+ *     v,    room for the n x n right singular vectors, stored by columns,
+ *           or NULL if they are not needed.
+ *
+ * Results:
+ *     The function overwrites u with the left singular vectors, in the
+ *     order of the singular values, which is descending. It returns
+ *     GUA_ERROR if the rotations do not converge in NUMERIC_SVD_SWEEPS.
+ */
+Gua_Status Numeric_JacobiSVD(Gua_Real *u, Gua_Length m, Gua_Length n, Gua_Real *s, Gua_Real *v)
+{
+    Gua_Real *up;
+    Gua_Real *uq;
+    Gua_Real *vp;
+    Gua_Real *vq;
+    Gua_Real alpha;
+    Gua_Real beta;
+    Gua_Real gamma;
+    Gua_Real zeta;
+    Gua_Real t;
+    Gua_Real c;
+    Gua_Real sn;
+    Gua_Real x;
+    Gua_Length sweep;
+    Gua_Length rotations;
+    Gua_Length i;
+    Gua_Length j;
+    Gua_Length k;
+    Gua_Length p;
+    Gua_Length q;
+    
+    if (v != NULL) {
+        memset(v, 0, n * n * sizeof(Gua_Real));
+        for (j = 0; j < n; j++) {
+            v[j * n + j] = 1.0;
+        }
+    }
+    
+    /* The squared column norms are kept up to date through the rotations. */
+    for (j = 0; j < n; j++) {
+        s[j] = Numeric_Dot(u + j * m, u + j * m, m);
+    }
+    
+    for (sweep = 0; sweep < NUMERIC_SVD_SWEEPS; sweep++) {
+        rotations = 0;
+        
+        for (p = 0; p < n - 1; p++) {
+            for (q = p + 1; q < n; q++) {
+                up = u + p * m;
+                uq = u + q * m;
+                alpha = s[p];
+                beta = s[q];
+                gamma = Numeric_Dot(up, uq, m);
+                
+                if ((gamma == 0.0) || (fabs(gamma) <= DBL_EPSILON * sqrt(alpha * beta))) {
+                    continue;
+                }
+                
+                rotations++;
+                
+                zeta = (beta - alpha) / (2.0 * gamma);
+                t = (zeta >= 0.0 ? 1.0 : -1.0) / (fabs(zeta) + sqrt(1.0 + zeta * zeta));
+                c = 1.0 / sqrt(1.0 + t * t);
+                sn = c * t;
+                
+                for (i = 0; i < m; i++) {
+                    x = up[i];
+                    up[i] = c * x - sn * uq[i];
+                    uq[i] = sn * x + c * uq[i];
+                }
+                s[p] = alpha - t * gamma;
+                s[q] = beta + t * gamma;
+                
+                if (v != NULL) {
+                    vp = v + p * n;
+                    vq = v + q * n;
+                    for (i = 0; i < n; i++) {
+                        x = vp[i];
+                        vp[i] = c * x - sn * vq[i];
+                        vq[i] = sn * x + c * vq[i];
+                    }
+                }
+            }
+        }
+        
+        /* Refresh the norms, which drift through the updates. */
+        for (j = 0; j < n; j++) {
+            s[j] = Numeric_Dot(u + j * m, u + j * m, m);
+        }
+        
+        if (rotations == 0) {
+            break;
+        }
+    }
+    
+    if (sweep == NUMERIC_SVD_SWEEPS) {
+        return GUA_ERROR;
+    }
+    
+    for (j = 0; j < n; j++) {
+        s[j] = sqrt(s[j]);
+        if (s[j] > 0.0) {
+            for (i = 0; i < m; i++) {
+                u[j * m + i] /= s[j];
+            }
+        }
+    }
+    
+    /* Sort in descending order. */
+    for (j = 0; j < n - 1; j++) {
+        k = j;
+        for (i = j + 1; i < n; i++) {
+            if (s[i] > s[k]) {
+                k = i;
+            }
+        }
+        if (k != j) {
+            x = s[j];
+            s[j] = s[k];
+            s[k] = x;
+            for (i = 0; i < m; i++) {
+                x = u[j * m + i];
+                u[j * m + i] = u[k * m + i];
+                u[k * m + i] = x;
+            }
+            if (v != NULL) {
+                for (i = 0; i < n; i++) {
+                    x = v[j * n + i];
+                    v[j * n + i] = v[k * n + i];
+                    v[k * n + i] = x;
+                }
+            }
+        }
+    }
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Numeric_SVD(Gua_Real *a, Gua_Length m, Gua_Length n, Gua_Real *s, Gua_Real *u, Gua_Real *v)
+ *
+ * Description:
+ *     Singular value decomposition A = U S V' of a matrix with m >= n. The
+ *     matrix is first reduced to its n x n triangular factor by the blocked
+ *     Householder QR, so the Jacobi rotations work on columns of n elements
+ *     whatever the number of rows. The rotations are applied to R', on
+ *     which they converge in fewer sweeps than on R.
+ *
+ * Arguments:
+ *     a,    the m x n matrix, stored by columns; it is overwritten;
+ *     m,    the number of rows;
+ *     n,    the number of columns;
+ *     s,    room for the n singular values;
+ *     u,    room for the m x n left singular vectors, stored by columns,
+ *           or NULL if they are not needed;
+ *     v,    room for the n x n right singular vectors, stored by columns,
+ *           or NULL if they are not needed.
+ *
+ * Results:
+ *     The singular values in descending order and the singular vectors. The
+ *     function returns GUA_ERROR if the rotations do not converge.
+ */
+Gua_Status Numeric_SVD(Gua_Real *a, Gua_Length m, Gua_Length n, Gua_Real *s, Gua_Real *u, Gua_Real *v)
+{
+    Gua_Real *tau;
+    Gua_Real *r;
+    Gua_Real *z;
+    Gua_Length i;
+    Gua_Length j;
+    Gua_Status status;
+    
+    tau = (Gua_Real *)Gua_Alloc((n + 1) * sizeof(Gua_Real));
+    r = (Gua_Real *)Gua_Alloc((n * n + 1) * sizeof(Gua_Real));
+    
+    Numeric_QR(a, m, n, tau);
+    
+    /* R' = W S Z', so A = (Q Z) S W': the rotations give U and the rotated columns give V. */
+    for (j = 0; j < n; j++) {
+        for (i = 0; i < n; i++) {
+            r[j * n + i] = i >= j ? a[i * m + j] : 0.0;
+        }
+    }
+    
+    z = u != NULL ? (Gua_Real *)Gua_Alloc((n * n + 1) * sizeof(Gua_Real)) : NULL;
+    
+    status = Numeric_JacobiSVD(r, n, n, s, z);
+    
+    if ((status == GUA_OK) && (u != NULL)) {
+        memset(u, 0, m * n * sizeof(Gua_Real));
+        for (j = 0; j < n; j++) {
+            memcpy(u + j * m, z + j * n, n * sizeof(Gua_Real));
+        }
+        Numeric_QRApply(a, m, n, tau, u, n, false);
+    }
+    if ((status == GUA_OK) && (v != NULL)) {
+        memcpy(v, r, n * n * sizeof(Gua_Real));
+    }
+    
+    if (z != NULL) {
+        Gua_Free(z);
+    }
+    Gua_Free(r);
+    Gua_Free(tau);
+    
+    return status;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Numeric_ColumnBufferToPObject(Gua_Object *object, Gua_Real *x, Gua_Length rows, Gua_Length cols)
+ *
+ * Description:
+ *     Create a real matrix from a buffer stored by columns.
+ *
+ * Arguments:
+ *     object,    a structure containing the new matrix;
+ *     x,         the buffer;
+ *     rows,      the number of rows;
+ *     cols,      the number of columns.
+ *
+ * Results:
+ *     The new rows x cols matrix.
+ */
+void Numeric_ColumnBufferToPObject(Gua_Object *object, Gua_Real *x, Gua_Length rows, Gua_Length cols)
+{
+    Gua_Real *y;
+    Gua_Length i;
+    Gua_Length j;
+    
+    y = (Gua_Real *)Gua_Alloc((rows * cols + 1) * sizeof(Gua_Real));
+    
+    for (i = 0; i < rows; i++) {
+        for (j = 0; j < cols; j++) {
+            y[i * cols + j] = x[j * rows + i];
+        }
+    }
+    
+    Matrix_RealBufferToPObject(object, y, rows, cols);
+    
+    Gua_Free(y);
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Numeric_EigenDecomposition(Gua_Object *a, Gua_Object *w, Gua_Object *v, Gua_String error)
+ *
+ * Description:
+ *     Compute the eigenvalues and eigenvectors of a symmetric matrix.
+ *
+ * Arguments:
+ *     a,        a symmetric n x n matrix;
+ *     w,        a structure containing the n x 1 eigenvalues;
+ *     v,        a structure for the n x n eigenvectors, or NULL if they
+ *               are not needed;
+ *     error,    a pointer to the error message.
+ *
+ * Results:
+ *     The eigenvalues in ascending order and the matching eigenvectors in
+ *     the columns of v.
+ */
+Gua_Status Numeric_EigenDecomposition(Gua_Object *a, Gua_Object *w, Gua_Object *v, Gua_String error)
+{
+    Gua_Real *x;
+    Gua_Real *d;
+    Gua_Real amax;
+    Gua_Length rows;
+    Gua_Length cols;
+    Gua_Length i;
+    Gua_Length j;
+    Gua_String errMessage;
+    
+    x = Numeric_ColumnBuffer(a, &rows, &cols);
+    
+    if ((x == NULL) || (rows != cols) || (rows < 1)) {
+        if (x != NULL) {
+            Gua_Free(x);
+        }
+        
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "the matrix must be a square matrix");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    amax = 0.0;
+    for (i = 0; i < rows * cols; i++) {
+        if (fabs(x[i]) > amax) {
+            amax = fabs(x[i]);
+        }
+    }
+    for (j = 0; j < cols; j++) {
+        for (i = j + 1; i < rows; i++) {
+            if (fabs(x[j * rows + i] - x[i * rows + j]) > NUMERIC_TOLERANCE * amax) {
+                Gua_Free(x);
+                
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s...\n", "the matrix is not symmetric");
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+        }
+    }
+    
+    d = (Gua_Real *)Gua_Alloc((rows + 1) * sizeof(Gua_Real));
+    
+    if (Numeric_SymmetricEigen(x, rows, d, v != NULL) != GUA_OK) {
+        Gua_Free(d);
+        Gua_Free(x);
+        
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "the eigenvalues did not converge");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    Matrix_RealBufferToPObject(w, d, rows, 1);
+    
+    if (v != NULL) {
+        Numeric_ColumnBufferToPObject(v, x, rows, rows);
+    }
+    
+    Gua_Free(d);
+    Gua_Free(x);
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Numeric_SingularValueDecomposition(Gua_Object *a, Gua_Object *s, Gua_Object *u, Gua_Object *v, Gua_String error)
+ *
+ * Description:
+ *     Compute the economy size singular value decomposition A = U S V'.
+ *
+ * Arguments:
+ *     a,        a m x n matrix;
+ *     s,        a structure containing the k x 1 singular values, where
+ *               k = min(m, n);
+ *     u,        a structure for the m x k left singular vectors, or NULL
+ *               if they are not needed;
+ *     v,        a structure for the n x k right singular vectors, or NULL
+ *               if they are not needed;
+ *     error,    a pointer to the error message.
+ *
+ * Results:
+ *     The singular values in descending order and the matching singular
+ *     vectors.
+ */
+Gua_Status Numeric_SingularValueDecomposition(Gua_Object *a, Gua_Object *s, Gua_Object *u, Gua_Object *v, Gua_String error)
+{
+    Gua_Real *x;
+    Gua_Real *y;
+    Gua_Real *d;
+    Gua_Real *left;
+    Gua_Real *right;
+    Gua_Length m;
+    Gua_Length n;
+    Gua_Length i;
+    Gua_Length j;
+    Gua_Short transpose;
+    Gua_Status status;
+    Gua_String errMessage;
+    
+    x = Numeric_ColumnBuffer(a, &m, &n);
+    
+    if ((x == NULL) || (m < 1) || (n < 1)) {
+        if (x != NULL) {
+            Gua_Free(x);
+        }
+        
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "illegal argument 1");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    /* A wide matrix is decomposed through its transpose, swapping U and V. */
+    transpose = m < n;
+    if (transpose) {
+        y = (Gua_Real *)Gua_Alloc((m * n + 1) * sizeof(Gua_Real));
+        for (j = 0; j < n; j++) {
+            for (i = 0; i < m; i++) {
+                y[i * n + j] = x[j * m + i];
+            }
+        }
+        Gua_Free(x);
+        x = y;
+        i = m;
+        m = n;
+        n = i;
+    }
+    
+    d = (Gua_Real *)Gua_Alloc((n + 1) * sizeof(Gua_Real));
+    left = (transpose ? v : u) != NULL ? (Gua_Real *)Gua_Alloc((m * n + 1) * sizeof(Gua_Real)) : NULL;
+    right = (transpose ? u : v) != NULL ? (Gua_Real *)Gua_Alloc((n * n + 1) * sizeof(Gua_Real)) : NULL;
+    
+    status = Numeric_SVD(x, m, n, d, left, right);
+    
+    if (status == GUA_OK) {
+        Matrix_RealBufferToPObject(s, d, n, 1);
+        if (left != NULL) {
+            Numeric_ColumnBufferToPObject(transpose ? v : u, left, m, n);
+        }
+        if (right != NULL) {
+            Numeric_ColumnBufferToPObject(transpose ? u : v, right, n, n);
+        }
+    }
+    
+    if (right != NULL) {
+        Gua_Free(right);
+    }
+    if (left != NULL) {
+        Gua_Free(left);
+    }
+    Gua_Free(d);
+    Gua_Free(x);
+    
+    if (status != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "the singular values did not converge");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Numeric_ODEFunction(Numeric_ODE *ode, Gua_Real t, Gua_Real *y, Gua_Real *dy, Gua_String error)
+ *
+ * Description:
+ *     Evaluate the right-hand side of a system of ordinary differential
+ *     equations, calling the function found when the solver started.
+ *
+ * Arguments:
+ *     ode,      the system;
+ *     t,        the time;
+ *     y,        the state, stored by columns;
+ *     dy,       the derivative of the state, stored by columns;
+ *     error,    a pointer to the error message.
+ *
+ * Results:
+ *     The function fills dy with the value returned by the script
+ *     function f(t, y).
+ */
+Gua_Status Numeric_ODEFunction(Numeric_ODE *ode, Gua_Real t, Gua_Real *y, Gua_Real *dy, Gua_String error)
+{
+    Gua_Object argv[3];
+    Gua_Object result;
+    Gua_Real *x;
+    Gua_Length rows;
+    Gua_Length cols;
+    Gua_Length n;
+    Gua_Status status;
+    Gua_String errMessage;
+    
+    Gua_ClearArguments(3, argv);
+    Gua_ClearObject(result);
+    
+    n = ode->rows * ode->cols;
+    
+    Gua_LinkStringToObject(argv[0], Gua_PObjectToString(ode->name));
+    Gua_SetStoredObject(argv[0]);
+    Gua_RealToObject(argv[1], t);
+    if (ode->scalar) {
+        Gua_RealToObject(argv[2], y[0]);
+    } else {
+        Numeric_ColumnBufferToPObject(&argv[2], y, ode->rows, ode->cols);
+    }
+    
+    status = Gua_CallFunction(ode->nspace, &ode->function, 3, argv, &result, error);
+    
+    if (!Gua_IsObjectStored(argv[2])) {
+        Gua_FreeObject(&argv[2]);
+    }
+    
+    if (status != GUA_OK) {
+        if (!Gua_IsObjectStored(result)) {
+            Gua_FreeObject(&result);
+        }
+        
+        return GUA_ERROR;
+    }
+    
+    status = GUA_ERROR;
+    
+    if ((Gua_ObjectType(result) == OBJECT_TYPE_INTEGER) && (n == 1)) {
+        dy[0] = Gua_ObjectToInteger(result);
+        status = GUA_OK;
+    } else if ((Gua_ObjectType(result) == OBJECT_TYPE_REAL) && (n == 1)) {
+        dy[0] = Gua_ObjectToReal(result);
+        status = GUA_OK;
+    } else if (Gua_ObjectType(result) == OBJECT_TYPE_MATRIX) {
+        x = Numeric_ColumnBuffer(&result, &rows, &cols);
+        if (x != NULL) {
+            if ((rows * cols == n) && ((rows == ode->rows) || (ode->rows == 1) || (ode->cols == 1))) {
+                memcpy(dy, x, n * sizeof(Gua_Real));
+                status = GUA_OK;
+            }
+            Gua_Free(x);
+        }
+    }
+    
+    if (!Gua_IsObjectStored(result)) {
+        Gua_FreeObject(&result);
+    }
+    
+    if (status != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "the value must have the size of y in function", Gua_PObjectToString(ode->name));
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    
+    return status;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Numeric_RK4(Numeric_ODE *ode, Gua_Real *t, Gua_Length k, Gua_Real *y0, Gua_Real *x, Gua_String error)
+ *
+ * Description:
+ *     Integrate a system of ordinary differential equations with the
+ *     classic fourth order Runge-Kutta method, taking one step between
+ *     each pair of output times.
+ *
+ * Arguments:
+ *     ode,      the system;
+ *     t,        the k output times;
+ *     k,        the number of output times;
+ *     y0,       the initial state, stored by columns;
+ *     x,        a buffer with k rows of 1 + n values, where n is the
+ *               size of the state;
+ *     error,    a pointer to the error message.
+ *
+ * Results:
+ *     Each row of x holds a time followed by the state at that time.
+ */
+Gua_Status Numeric_RK4(Numeric_ODE *ode, Gua_Real *t, Gua_Length k, Gua_Real *y0, Gua_Real *x, Gua_String error)
+{
+    Gua_Real *y;
+    Gua_Real *z;
+    Gua_Real *k1;
+    Gua_Real *k2;
+    Gua_Real *k3;
+    Gua_Real *k4;
+    Gua_Real h;
+    Gua_Length n;
+    Gua_Length i;
+    Gua_Length j;
+    Gua_Status status;
+    
+    n = ode->rows * ode->cols;
+    
+    y = (Gua_Real *)Gua_Alloc((6 * n + 1) * sizeof(Gua_Real));
+    z = y + n;
+    k1 = z + n;
+    k2 = k1 + n;
+    k3 = k2 + n;
+    k4 = k3 + n;
+    
+    memcpy(y, y0, n * sizeof(Gua_Real));
+    
+    x[0] = t[0];
+    memcpy(x + 1, y, n * sizeof(Gua_Real));
+    
+    status = GUA_OK;
+    
+    for (j = 1; j < k; j++) {
+        h = t[j] - t[j - 1];
+        
+        if ((status = Numeric_ODEFunction(ode, t[j - 1], y, k1, error)) != GUA_OK) {
+            break;
+        }
+        for (i = 0; i < n; i++) {
+            z[i] = y[i] + 0.5 * h * k1[i];
+        }
+        if ((status = Numeric_ODEFunction(ode, t[j - 1] + 0.5 * h, z, k2, error)) != GUA_OK) {
+            break;
+        }
+        for (i = 0; i < n; i++) {
+            z[i] = y[i] + 0.5 * h * k2[i];
+        }
+        if ((status = Numeric_ODEFunction(ode, t[j - 1] + 0.5 * h, z, k3, error)) != GUA_OK) {
+            break;
+        }
+        for (i = 0; i < n; i++) {
+            z[i] = y[i] + h * k3[i];
+        }
+        if ((status = Numeric_ODEFunction(ode, t[j], z, k4, error)) != GUA_OK) {
+            break;
+        }
+        for (i = 0; i < n; i++) {
+            y[i] += h / 6.0 * (k1[i] + 2.0 * (k2[i] + k3[i]) + k4[i]);
+        }
+        
+        x[j * (n + 1)] = t[j];
+        memcpy(x + j * (n + 1) + 1, y, n * sizeof(Gua_Real));
+    }
+    
+    Gua_Free(y);
+    
+    return status;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Numeric_ODE45(Numeric_ODE *ode, Gua_Real *t, Gua_Length k, Gua_Real *y0, Gua_Real tol, Gua_Real **x, Gua_Length *rows, Gua_String error)
+ *
+ * Description:
+ *     Integrate a system of ordinary differential equations with the
+ *     Dormand-Prince 5(4) pair, choosing the step size from the local
+ *     error estimate. The last stage of a step is the first stage of the
+ *     next one, so an accepted step costs six function calls.
+ *
+ * Arguments:
+ *     ode,      the system;
+ *     t,        the output times. With two times, the state is given at
+ *               every accepted step between them; otherwise it is
+ *               interpolated at each time;
+ *     k,        the number of output times;
+ *     y0,       the initial state, stored by columns;
+ *     tol,      the relative and absolute error tolerance;
+ *     x,        a pointer to the new buffer with the results;
+ *     rows,     the number of rows of the new buffer;
+ *     error,    a pointer to the error message.
+ *
+ * Results:
+ *     Each row of x holds a time followed by the state at that time.
+ */
+Gua_Status Numeric_ODE45(Numeric_ODE *ode, Gua_Real *t, Gua_Length k, Gua_Real *y0, Gua_Real tol, Gua_Real **x, Gua_Length *rows, Gua_String error)
+{
+    Gua_Real *y;
+    Gua_Real *z;
+    Gua_Real *w;
+    Gua_Real *e;
+    Gua_Real *k1;
+    Gua_Real *k2;
+    Gua_Real *k3;
+    Gua_Real *k4;
+    Gua_Real *k5;
+    Gua_Real *k6;
+    Gua_Real *k7;
+    Gua_Real *out;
+    Gua_Real time;
+    Gua_Real end;
+    Gua_Real direction;
+    Gua_Real h;
+    Gua_Real s;
+    Gua_Real d0;
+    Gua_Real d1;
+    Gua_Real norm;
+    Gua_Real theta;
+    Gua_Real factor;
+    Gua_Length n;
+    Gua_Length i;
+    Gua_Length j;
+    Gua_Length steps;
+    Gua_Length size;
+    Gua_Short rejected;
+    Gua_Status status;
+    Gua_String errMessage;
+    
+    n = ode->rows * ode->cols;
+    
+    y = (Gua_Real *)Gua_Alloc((11 * n + 1) * sizeof(Gua_Real));
+    z = y + n;
+    w = z + n;
+    e = w + n;
+    k1 = e + n;
+    k2 = k1 + n;
+    k3 = k2 + n;
+    k4 = k3 + n;
+    k5 = k4 + n;
+    k6 = k5 + n;
+    k7 = k6 + n;
+    
+    size = k > 2 ? k : 64;
+    out = (Gua_Real *)Gua_Alloc((size * (n + 1) + 1) * sizeof(Gua_Real));
+    
+    memcpy(y, y0, n * sizeof(Gua_Real));
+    
+    out[0] = t[0];
+    memcpy(out + 1, y, n * sizeof(Gua_Real));
+    *rows = 1;
+    
+    time = t[0];
+    end = t[k - 1];
+    direction = end > time ? 1.0 : -1.0;
+    
+    if ((status = Numeric_ODEFunction(ode, time, y, k1, error)) != GUA_OK) {
+        Gua_Free(out);
+        Gua_Free(y);
+        
+        return GUA_ERROR;
+    }
+    
+    /* The starting step makes the first change of the state about one percent of its size. */
+    d0 = 0.0;
+    d1 = 0.0;
+    for (i = 0; i < n; i++) {
+        s = tol + tol * fabs(y[i]);
+        d0 += (y[i] / s) * (y[i] / s);
+        d1 += (k1[i] / s) * (k1[i] / s);
+    }
+    d0 = sqrt(d0 / n);
+    d1 = sqrt(d1 / n);
+    h = ((d0 < 1e-5) || (d1 < 1e-5)) ? 1e-6 : 0.01 * d0 / d1;
+    if (h > fabs(end - time)) {
+        h = fabs(end - time);
+    }
+    
+    j = 1;
+    steps = 0;
+    rejected = false;
+    
+    while (direction * (end - time) > 0.0) {
+        if (++steps > NUMERIC_ODE_STEPS) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "the maximum number of steps was reached");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            status = GUA_ERROR;
+            break;
+        }
+        if (h < 16.0 * DBL_EPSILON * fabs(time)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "the step size became too small");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            status = GUA_ERROR;
+            break;
+        }
+        if (h >= fabs(end - time)) {
+            h = fabs(end - time);
+        }
+        s = direction * h;
+        
+        for (i = 0; i < n; i++) {
+            z[i] = y[i] + s * (1.0 / 5.0) * k1[i];
+        }
+        if ((status = Numeric_ODEFunction(ode, time + s * (1.0 / 5.0), z, k2, error)) != GUA_OK) {
+            break;
+        }
+        for (i = 0; i < n; i++) {
+            z[i] = y[i] + s * ((3.0 / 40.0) * k1[i] + (9.0 / 40.0) * k2[i]);
+        }
+        if ((status = Numeric_ODEFunction(ode, time + s * (3.0 / 10.0), z, k3, error)) != GUA_OK) {
+            break;
+        }
+        for (i = 0; i < n; i++) {
+            z[i] = y[i] + s * ((44.0 / 45.0) * k1[i] - (56.0 / 15.0) * k2[i] + (32.0 / 9.0) * k3[i]);
+        }
+        if ((status = Numeric_ODEFunction(ode, time + s * (4.0 / 5.0), z, k4, error)) != GUA_OK) {
+            break;
+        }
+        for (i = 0; i < n; i++) {
+            z[i] = y[i] + s * ((19372.0 / 6561.0) * k1[i] - (25360.0 / 2187.0) * k2[i] + (64448.0 / 6561.0) * k3[i] - (212.0 / 729.0) * k4[i]);
+        }
+        if ((status = Numeric_ODEFunction(ode, time + s * (8.0 / 9.0), z, k5, error)) != GUA_OK) {
+            break;
+        }
+        for (i = 0; i < n; i++) {
+            z[i] = y[i] + s * ((9017.0 / 3168.0) * k1[i] - (355.0 / 33.0) * k2[i] + (46732.0 / 5247.0) * k3[i] + (49.0 / 176.0) * k4[i] - (5103.0 / 18656.0) * k5[i]);
+        }
+        if ((status = Numeric_ODEFunction(ode, time + s, z, k6, error)) != GUA_OK) {
+            break;
+        }
+        for (i = 0; i < n; i++) {
+            w[i] = y[i] + s * ((35.0 / 384.0) * k1[i] + (500.0 / 1113.0) * k3[i] + (125.0 / 192.0) * k4[i] - (2187.0 / 6784.0) * k5[i] + (11.0 / 84.0) * k6[i]);
+        }
+        if ((status = Numeric_ODEFunction(ode, time + s, w, k7, error)) != GUA_OK) {
+            break;
+        }
+        
+        /* The difference between the fifth and fourth order solutions. */
+        norm = 0.0;
+        for (i = 0; i < n; i++) {
+            e[i] = s * ((71.0 / 57600.0) * k1[i] - (71.0 / 16695.0) * k3[i] + (71.0 / 1920.0) * k4[i] - (17253.0 / 339200.0) * k5[i] + (22.0 / 525.0) * k6[i] - (1.0 / 40.0) * k7[i]);
+            d0 = e[i] / (tol + tol * (fabs(y[i]) > fabs(w[i]) ? fabs(y[i]) : fabs(w[i])));
+            norm += d0 * d0;
+        }
+        norm = sqrt(norm / n);
+        
+        factor = norm > 0.0 ? 0.9 * pow(norm, -0.2) : 5.0;
+        if (factor > 5.0) {
+            factor = 5.0;
+        } else if (factor < 0.2) {
+            factor = 0.2;
+        }
+        
+        if (norm > 1.0) {
+            h *= factor;
+            rejected = true;
+            continue;
+        }
+        
+        if (k > 2) {
+            /* The continuous extension of the method, of fourth order, between the ends of the step. */
+            if ((j < k) && (direction * (t[j] - (time + s)) <= 0.0)) {
+                for (i = 0; i < n; i++) {
+                    z[i] = s * ((-12715105075.0 / 11282082432.0) * k1[i] + (87487479700.0 / 32700410799.0) * k3[i] - (10690763975.0 / 1880347072.0) * k4[i] + (701980252875.0 / 199316789632.0) * k5[i] - (1453857185.0 / 822651844.0) * k6[i] + (69997945.0 / 29380423.0) * k7[i]);
+                }
+            }
+            while ((j < k) && (direction * (t[j] - (time + s)) <= 0.0)) {
+                theta = (t[j] - time) / s;
+                out[j * (n + 1)] = t[j];
+                for (i = 0; i < n; i++) {
+                    d0 = w[i] - y[i];
+                    d1 = s * k1[i] - d0;
+                    out[j * (n + 1) + 1 + i] = y[i] + theta * (d0 + (1.0 - theta) * (d1 + theta * (d0 - s * k7[i] - d1 + (1.0 - theta) * z[i])));
+                }
+                j++;
+            }
+            *rows = j;
+        } else {
+            if (*rows == size) {
+                size *= 2;
+                out = (Gua_Real *)Gua_Realloc(out, (size * (n + 1) + 1) * sizeof(Gua_Real));
+            }
+            out[*rows * (n + 1)] = h >= fabs(end - time) ? end : time + s;
+            memcpy(out + *rows * (n + 1) + 1, w, n * sizeof(Gua_Real));
+            (*rows)++;
+        }
+        
+        time = h >= fabs(end - time) ? end : time + s;
+        memcpy(y, w, n * sizeof(Gua_Real));
+        memcpy(k1, k7, n * sizeof(Gua_Real));
+        
+        h *= rejected && (factor > 1.0) ? 1.0 : factor;
+        rejected = false;
+    }
+    
+    Gua_Free(y);
+    
+    if (status != GUA_OK) {
+        Gua_Free(out);
+        
+        return GUA_ERROR;
+    }
+    
+    *x = out;
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Numeric_SolveODE(void *nspace, Gua_Short method, Gua_Object *f, Gua_Object *tspan, Gua_Object *y0, Gua_Object *option, Gua_Object *object, Gua_String error)
+ *
+ * Description:
+ *     Solve an initial value problem y' = f(t, y). When y0 is a n x m
+ *     matrix, each of its columns is an initial condition, and f gets
+ *     and returns a n x m matrix, so a single call evaluates all of them.
+ *
+ * Arguments:
+ *     nspace,    a pointer to a structure Gua_Namespace. Must do a cast before use it;
+ *     method,    NUMERIC_ODE_RK4 or NUMERIC_ODE_DORMAND_PRINCE;
+ *     f,         the name of the script function f(t, y);
+ *     tspan,     a vector with the start and end times, or with all the
+ *                output times;
+ *     y0,        the initial state, a number, a vector or a matrix;
+ *     option,    the number of steps of the RK4 method, or the error
+ *                tolerance of the Dormand-Prince method, or NULL;
+ *     object,    a structure containing the return object of the function;
+ *     error,     a pointer to the error message.
+ *
+ * Results:
+ *     A matrix with a row for each output time, holding the time and
+ *     then the state, stored by columns.
+ */
+Gua_Status Numeric_SolveODE(void *nspace, Gua_Short method, Gua_Object *f, Gua_Object *tspan, Gua_Object *y0, Gua_Object *option, Gua_Object *object, Gua_String error)
+{
+    Numeric_ODE ode;
+    Gua_Real *t;
+    Gua_Real *y;
+    Gua_Real *x;
+    Gua_Real tol;
+    Gua_Length rows;
+    Gua_Length cols;
+    Gua_Length k;
+    Gua_Length steps;
+    Gua_Length i;
+    Gua_Status status;
+    Gua_String errMessage;
+    
+    if (Gua_GetFunction((Gua_Namespace *)nspace, Gua_PObjectToString(f), &ode.function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "undefined function", Gua_PObjectToString(f));
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    ode.nspace = nspace;
+    ode.name = f;
+    
+    t = Numeric_ColumnBuffer(tspan, &rows, &cols);
+    
+    if ((t == NULL) || (rows * cols < 2)) {
+        if (t != NULL) {
+            Gua_Free(t);
+        }
+        
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "illegal argument 2");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    k = rows * cols;
+    
+    for (i = 1; i < k; i++) {
+        if (((t[i] - t[i - 1]) * (t[k - 1] - t[0]) <= 0.0) || isnan(t[i])) {
+            Gua_Free(t);
+            
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "the times must be strictly increasing or decreasing");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+    }
+    
+    if ((Gua_PObjectType(y0) == OBJECT_TYPE_INTEGER) || (Gua_PObjectType(y0) == OBJECT_TYPE_REAL)) {
+        y = (Gua_Real *)Gua_Alloc(2 * sizeof(Gua_Real));
+        y[0] = Gua_PObjectType(y0) == OBJECT_TYPE_INTEGER ? Gua_PObjectToInteger(y0) : Gua_PObjectToReal(y0);
+        ode.rows = 1;
+        ode.cols = 1;
+        ode.scalar = true;
+    } else {
+        y = Numeric_ColumnBuffer(y0, &ode.rows, &ode.cols);
+        ode.scalar = false;
+        
+        if ((y == NULL) || (ode.rows * ode.cols < 1)) {
+            if (y != NULL) {
+                Gua_Free(y);
+            }
+            Gua_Free(t);
+            
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "illegal argument 3");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+    }
+    
+    if (method == NUMERIC_ODE_RK4) {
+        steps = NUMERIC_RK4_STEPS;
+        if (option != NULL) {
+            steps = Gua_PObjectType(option) == OBJECT_TYPE_INTEGER ? Gua_PObjectToInteger(option) : (Gua_Length)Gua_PObjectToReal(option);
+        }
+        
+        /* Two times are the ends of a uniform grid. */
+        if ((k == 2) && (steps > 0)) {
+            x = (Gua_Real *)Gua_Alloc((steps + 2) * sizeof(Gua_Real));
+            for (i = 0; i <= steps; i++) {
+                x[i] = t[0] + (t[1] - t[0]) * i / steps;
+            }
+            x[steps] = t[1];
+            Gua_Free(t);
+            t = x;
+            k = steps + 1;
+        }
+        
+        x = (Gua_Real *)Gua_Alloc((k * (ode.rows * ode.cols + 1) + 1) * sizeof(Gua_Real));
+        status = Numeric_RK4(&ode, t, k, y, x, error);
+        rows = k;
+    } else {
+        tol = NUMERIC_ODE_TOLERANCE;
+        if (option != NULL) {
+            tol = Gua_PObjectType(option) == OBJECT_TYPE_INTEGER ? Gua_PObjectToInteger(option) : Gua_PObjectToReal(option);
+        }
+        
+        if (!(tol > 0.0)) {
+            Gua_Free(y);
+            Gua_Free(t);
+            
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "the tolerance must be positive");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        x = NULL;
+        status = Numeric_ODE45(&ode, t, k, y, tol, &x, &rows, error);
+    }
+    
+    if (status == GUA_OK) {
+        Matrix_RealBufferToPObject(object, x, rows, ode.rows * ode.cols + 1);
+    }
+    
+    if (x != NULL) {
+        Gua_Free(x);
+    }
+    Gua_Free(y);
+    Gua_Free(t);
+    
+    return status;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Numeric_Stats *Numeric_NewStats(Gua_Length bins, Gua_Real lower, Gua_Real upper)
+ *
+ * Description:
+ *     Create a streaming statistics accumulator.
+ *
+ * Arguments:
+ *     bins,     the number of histogram bins, or 0 for no histogram;
+ *     lower,    the lower limit of the histogram;
+ *     upper,    the upper limit of the histogram.
+ *
+ * Results:
+ *     The new accumulator, to be freed with Numeric_FreeStats.
+ */
+Numeric_Stats *Numeric_NewStats(Gua_Length bins, Gua_Real lower, Gua_Real upper)
+{
+    Numeric_Stats *s;
+    
+    s = (Numeric_Stats *)Gua_Alloc(sizeof(Numeric_Stats));
+    
+    s->count = 0.0;
+    s->mean = 0.0;
+    s->m2 = 0.0;
+    s->m3 = 0.0;
+    s->m4 = 0.0;
+    s->min = INFINITY;
+    s->max = -INFINITY;
+    
+    s->bins = bins;
+    s->lower = lower;
+    s->upper = upper;
+    s->below = 0.0;
+    s->above = 0.0;
+    s->histogram = NULL;
+    if (bins > 0) {
+        s->histogram = (Gua_Real *)Gua_Alloc(bins * sizeof(Gua_Real));
+        memset(s->histogram, 0, bins * sizeof(Gua_Real));
+    }
+    
+    s->centroids = 0;
+    s->buffered = 0;
+    s->capacity = NUMERIC_STATS_COMPRESSION + NUMERIC_STATS_BUFFER;
+    s->centroid = (Numeric_Centroid *)Gua_Alloc(s->capacity * sizeof(Numeric_Centroid));
+    s->scratch = (Numeric_Centroid *)Gua_Alloc(s->capacity * sizeof(Numeric_Centroid));
+    
+    return s;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Numeric_FreeStats(Numeric_Stats *s)
+ *
+ * Description:
+ *     Free a streaming statistics accumulator.
+ *
+ * Arguments:
+ *     s,    the accumulator.
+ *
+ * Results:
+ *     The function frees the accumulator and its buffers.
+ */
+void Numeric_FreeStats(Numeric_Stats *s)
+{
+    if (s->histogram != NULL) {
+        Gua_Free(s->histogram);
+    }
+    Gua_Free(s->scratch);
+    Gua_Free(s->centroid);
+    Gua_Free(s);
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Numeric_Stats *Numeric_GetStats(Gua_Object *o)
+ *
+ * Description:
+ *     Get the accumulator referenced by a handle.
+ *
+ * Arguments:
+ *     o,    the handle object.
+ *
+ * Results:
+ *     The accumulator, or NULL if the object is not an accumulator
+ *     handle or the accumulator was already freed.
+ */
+Numeric_Stats *Numeric_GetStats(Gua_Object *o)
+{
+    Gua_Handle *h;
+    
+    if (Gua_PObjectType(o) != OBJECT_TYPE_HANDLE) {
+        return NULL;
+    }
+    
+    h = (Gua_Handle *)Gua_PObjectToHandle(o);
+    
+    if (strcmp((Gua_String)Gua_GetHandleType(h), "Numeric_Stats") != 0) {
+        return NULL;
+    }
+    
+    return (Numeric_Stats *)Gua_GetHandlePointer(h);
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     int Numeric_CompareCentroids(const void *a, const void *b)
+ *
+ * Description:
+ *     Compare two centroids by their means, for qsort.
+ *
+ * Arguments:
+ *     a,    the first centroid;
+ *     b,    the second centroid.
+ *
+ * Results:
+ *     -1, 0 or 1.
+ */
+int Numeric_CompareCentroids(const void *a, const void *b)
+{
+    Gua_Real x;
+    Gua_Real y;
+    
+    x = ((Numeric_Centroid *)a)->mean;
+    y = ((Numeric_Centroid *)b)->mean;
+    
+    return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Numeric_StatsCompress(Numeric_Stats *s)
+ *
+ * Description:
+ *     Merge the buffered points into the centroids of the t-digest. The
+ *     buffer is sorted and merged with the sorted centroids, then
+ *     neighbours are joined while the centroid spans at most one unit of
+ *     the scale k(q) = compression / (2 pi) asin(2 q - 1), which keeps the
+ *     centroids small near the tails.
+ *
+ * Arguments:
+ *     s,    the accumulator.
+ *
+ * Results:
+ *     The buffer is empty and the centroids are sorted by mean.
+ */
+void Numeric_StatsCompress(Numeric_Stats *s)
+{
+    Numeric_Centroid *a;
+    Numeric_Centroid *b;
+    Numeric_Centroid *c;
+    Gua_Real total;
+    Gua_Real sofar;
+    Gua_Real limit;
+    Gua_Real k;
+    Gua_Length na;
+    Gua_Length nb;
+    Gua_Length n;
+    Gua_Length i;
+    Gua_Length j;
+    Gua_Length l;
+    
+    if (s->buffered == 0) {
+        return;
+    }
+    
+    a = s->centroid;
+    na = s->centroids;
+    b = s->centroid + s->centroids;
+    nb = s->buffered;
+    c = s->scratch;
+    
+    qsort(b, nb, sizeof(Numeric_Centroid), Numeric_CompareCentroids);
+    
+    total = 0.0;
+    for (i = 0, j = 0, n = 0; (i < na) || (j < nb); n++) {
+        if ((j >= nb) || ((i < na) && (a[i].mean <= b[j].mean))) {
+            c[n] = a[i++];
+        } else {
+            c[n] = b[j++];
+        }
+        total += c[n].weight;
+    }
+    
+    l = 0;
+    a[0] = c[0];
+    sofar = 0.0;
+    k = NUMERIC_STATS_COMPRESSION / (2.0 * M_PI) * asin(-1.0) + 1.0;
+    limit = k >= NUMERIC_STATS_COMPRESSION / 4.0 ? total : total * (sin(k * 2.0 * M_PI / NUMERIC_STATS_COMPRESSION) + 1.0) / 2.0;
+    
+    for (i = 1; i < n; i++) {
+        if (sofar + a[l].weight + c[i].weight <= limit) {
+            a[l].weight += c[i].weight;
+            a[l].mean += (c[i].mean - a[l].mean) * c[i].weight / a[l].weight;
+        } else {
+            sofar += a[l].weight;
+            a[++l] = c[i];
+            k = NUMERIC_STATS_COMPRESSION / (2.0 * M_PI) * asin(2.0 * sofar / total - 1.0) + 1.0;
+            limit = k >= NUMERIC_STATS_COMPRESSION / 4.0 ? total : total * (sin(k * 2.0 * M_PI / NUMERIC_STATS_COMPRESSION) + 1.0) / 2.0;
+        }
+    }
+    
+    s->centroids = l + 1;
+    s->buffered = 0;
+    
+    /* Keep room for a full buffer of new points. */
+    if (s->centroids + NUMERIC_STATS_BUFFER > s->capacity) {
+        s->capacity = s->centroids + NUMERIC_STATS_BUFFER;
+        s->centroid = (Numeric_Centroid *)Gua_Realloc(s->centroid, s->capacity * sizeof(Numeric_Centroid));
+        s->scratch = (Numeric_Centroid *)Gua_Realloc(s->scratch, s->capacity * sizeof(Numeric_Centroid));
+    }
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Numeric_StatsCombine(Numeric_Stats *s, Gua_Real n, Gua_Real mean, Gua_Real m2, Gua_Real m3, Gua_Real m4)
+ *
+ * Description:
+ *     Combine the central moments of another sample into the accumulator,
+ *     with the pairwise update formulas of Chan and Pebay.
+ *
+ * Arguments:
+ *     s,       the accumulator;
+ *     n,       the size of the other sample;
+ *     mean,    its mean;
+ *     m2,      its sum of squared deviations from the mean;
+ *     m3,      its sum of cubed deviations;
+ *     m4,      its sum of fourth power deviations.
+ *
+ * Results:
+ *     The moments of the accumulator describe both samples.
+ */
+void Numeric_StatsCombine(Numeric_Stats *s, Gua_Real n, Gua_Real mean, Gua_Real m2, Gua_Real m3, Gua_Real m4)
+{
+    Gua_Real na;
+    Gua_Real total;
+    Gua_Real delta;
+    Gua_Real d2;
+    
+    if (n == 0.0) {
+        return;
+    }
+    
+    na = s->count;
+    total = na + n;
+    delta = mean - s->mean;
+    d2 = delta * delta;
+    
+    s->m4 += m4 + d2 * d2 * na * n * (na * na - na * n + n * n) / (total * total * total) + 6.0 * d2 * (na * na * m2 + n * n * s->m2) / (total * total) + 4.0 * delta * (na * m3 - n * s->m3) / total;
+    s->m3 += m3 + d2 * delta * na * n * (na - n) / (total * total) + 3.0 * delta * (na * m2 - n * s->m2) / total;
+    s->m2 += m2 + d2 * na * n / total;
+    s->mean += delta * n / total;
+    s->count = total;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Numeric_StatsAdd(Numeric_Stats *s, Gua_Real *x, Gua_Length n)
+ *
+ * Description:
+ *     Add values to the accumulator. The moments of each block of
+ *     NUMERIC_STATS_CHUNK values are found with two passes over the block
+ *     and combined with the running moments. Values that are not a number
+ *     are skipped.
+ *
+ * Arguments:
+ *     s,    the accumulator;
+ *     x,    the values;
+ *     n,    the number of values.
+ *
+ * Results:
+ *     The accumulator holds the new values.
+ */
+void Numeric_StatsAdd(Numeric_Stats *s, Gua_Real *x, Gua_Length n)
+{
+    Gua_Real sum;
+    Gua_Real mean;
+    Gua_Real d;
+    Gua_Real d2;
+    Gua_Real m2;
+    Gua_Real m3;
+    Gua_Real m4;
+    Gua_Real scale;
+    Gua_Length count;
+    Gua_Length first;
+    Gua_Length last;
+    Gua_Length i;
+    Gua_Length k;
+    
+    scale = s->bins > 0 ? s->bins / (s->upper - s->lower) : 0.0;
+    
+    for (first = 0; first < n; first = last) {
+        last = first + NUMERIC_STATS_CHUNK < n ? first + NUMERIC_STATS_CHUNK : n;
+        
+        sum = 0.0;
+        count = 0;
+        for (i = first; i < last; i++) {
+            if (!isnan(x[i])) {
+                sum += x[i];
+                count++;
+            }
+        }
+        
+        if (count == 0) {
+            continue;
+        }
+        
+        mean = sum / count;
+        m2 = 0.0;
+        m3 = 0.0;
+        m4 = 0.0;
+        for (i = first; i < last; i++) {
+            if (isnan(x[i])) {
+                continue;
+            }
+            
+            d = x[i] - mean;
+            d2 = d * d;
+            m2 += d2;
+            m3 += d2 * d;
+            m4 += d2 * d2;
+            
+            if (x[i] < s->min) {
+                s->min = x[i];
+            }
+            if (x[i] > s->max) {
+                s->max = x[i];
+            }
+            
+            if (s->bins > 0) {
+                if (x[i] < s->lower) {
+                    s->below++;
+                } else if (x[i] > s->upper) {
+                    s->above++;
+                } else {
+                    k = (Gua_Length)((x[i] - s->lower) * scale);
+                    s->histogram[k < s->bins ? k : s->bins - 1]++;
+                }
+            }
+            
+            if (s->centroids + s->buffered == s->capacity) {
+                Numeric_StatsCompress(s);
+            }
+            s->centroid[s->centroids + s->buffered].mean = x[i];
+            s->centroid[s->centroids + s->buffered].weight = 1.0;
+            s->buffered++;
+        }
+        
+        Numeric_StatsCombine(s, count, mean, m2, m3, m4);
+    }
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Numeric_StatsMerge(Numeric_Stats *s, Numeric_Stats *t, Gua_String error)
+ *
+ * Description:
+ *     Merge an accumulator into another one, so partial results computed
+ *     in parallel can be joined.
+ *
+ * Arguments:
+ *     s,        the target accumulator;
+ *     t,        the accumulator to merge into s, which is not changed;
+ *     error,    a pointer to the error message.
+ *
+ * Results:
+ *     The accumulator s describes the values of both accumulators. The
+ *     histograms must have the same bins.
+ */
+Gua_Status Numeric_StatsMerge(Numeric_Stats *s, Numeric_Stats *t, Gua_String error)
+{
+    Numeric_Centroid *c;
+    Gua_Length n;
+    Gua_Length i;
+    Gua_String errMessage;
+    
+    if ((s->bins != t->bins) || ((s->bins > 0) && ((s->lower != t->lower) || (s->upper != t->upper)))) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "the histograms do not have the same bins");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    n = t->centroids + t->buffered;
+    c = (Numeric_Centroid *)Gua_Alloc((n + 1) * sizeof(Numeric_Centroid));
+    memcpy(c, t->centroid, n * sizeof(Numeric_Centroid));
+    
+    Numeric_StatsCombine(s, t->count, t->mean, t->m2, t->m3, t->m4);
+    
+    if (t->min < s->min) {
+        s->min = t->min;
+    }
+    if (t->max > s->max) {
+        s->max = t->max;
+    }
+    
+    if (s->bins > 0) {
+        for (i = 0; i < s->bins; i++) {
+            s->histogram[i] += t->histogram[i];
+        }
+        s->below += t->below;
+        s->above += t->above;
+    }
+    
+    for (i = 0; i < n; i++) {
+        if (s->centroids + s->buffered == s->capacity) {
+            Numeric_StatsCompress(s);
+        }
+        s->centroid[s->centroids + s->buffered] = c[i];
+        s->buffered++;
+    }
+    
+    Gua_Free(c);
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Real Numeric_StatsQuantile(Numeric_Stats *s, Gua_Real q)
+ *
+ * Description:
+ *     Estimate a quantile from the t-digest, interpolating between the
+ *     centroid means, and between the extreme centroids and the minimum
+ *     and maximum values.
+ *
+ * Arguments:
+ *     s,    the accumulator;
+ *     q,    the probability, from 0 to 1.
+ *
+ * Results:
+ *     The estimated quantile, or NaN if the accumulator is empty.
+ */
+Gua_Real Numeric_StatsQuantile(Numeric_Stats *s, Gua_Real q)
+{
+    Numeric_Centroid *c;
+    Gua_Real total;
+    Gua_Real target;
+    Gua_Real sofar;
+    Gua_Real next;
+    Gua_Length n;
+    Gua_Length i;
+    
+    Numeric_StatsCompress(s);
+    
+    c = s->centroid;
+    n = s->centroids;
+    
+    if (n == 0) {
+        return NAN;
+    }
+    if (q <= 0.0) {
+        return s->min;
+    }
+    if (q >= 1.0) {
+        return s->max;
+    }
+    if (n == 1) {
+        return c[0].mean;
+    }
+    
+    total = s->count;
+    target = q * total;
+    
+    if (target < c[0].weight / 2.0) {
+        return s->min + (c[0].mean - s->min) * target / (c[0].weight / 2.0);
+    }
+    if (target > total - c[n - 1].weight / 2.0) {
+        return s->max - (s->max - c[n - 1].mean) * (total - target) / (c[n - 1].weight / 2.0);
+    }
+    
+    sofar = c[0].weight / 2.0;
+    for (i = 0; i < n - 1; i++) {
+        next = sofar + (c[i].weight + c[i + 1].weight) / 2.0;
+        if (target <= next) {
+            return c[i].mean + (c[i + 1].mean - c[i].mean) * (target - sofar) / (next - sofar);
+        }
+        sofar = next;
+    }
+    
+    return c[n - 1].mean;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Real Numeric_StatsAddFile(Numeric_Stats *s, Gua_File *f)
+ *
+ * Description:
+ *     Add the numbers read from a file to the accumulator, a block at a
+ *     time, until the end of the file. Numbers are separated by spaces,
+ *     tabs, new lines, commas or semicolons, and fields that are not a
+ *     number, like a header line, are skipped.
+ *
+ * Arguments:
+ *     s,    the accumulator;
+ *     f,    the file.
+ *
+ * Results:
+ *     The number of values read.
+ */
+Gua_Real Numeric_StatsAddFile(Numeric_Stats *s, Gua_File *f)
+{
+    Gua_String buffer;
+    Gua_Real *x;
+    Gua_Real count;
+    Gua_Length n;
+    Gua_Length keep;
+    Gua_Length size;
+    Gua_Length start;
+    Gua_Length p;
+    Gua_Integer got;
+    char token[64];
+    char *end;
+    
+    buffer = (Gua_String)Gua_Alloc(NUMERIC_STATS_READ + 1);
+    x = (Gua_Real *)Gua_Alloc(NUMERIC_STATS_CHUNK * sizeof(Gua_Real));
+    
+    count = 0.0;
+    n = 0;
+    keep = 0;
+    
+    do {
+        got = Gua_GetFileRead(f)(buffer + keep, sizeof(char), NUMERIC_STATS_READ - keep, f);
+        if (got < 0) {
+            got = 0;
+        }
+        size = keep + got;
+        keep = 0;
+        
+        p = 0;
+        while (p < size) {
+            while ((p < size) && ((buffer[p] == ' ') || (buffer[p] == '\t') || (buffer[p] == '\r') || (buffer[p] == '\n') || (buffer[p] == ',') || (buffer[p] == ';'))) {
+                p++;
+            }
+            start = p;
+            while ((p < size) && !((buffer[p] == ' ') || (buffer[p] == '\t') || (buffer[p] == '\r') || (buffer[p] == '\n') || (buffer[p] == ',') || (buffer[p] == ';'))) {
+                p++;
+            }
+            if (p == start) {
+                break;
+            }
+            
+            /* A field cut by the end of the block is read again with the next block. */
+            if ((p == size) && (got > 0) && (start > 0)) {
+                keep = size - start;
+                memmove(buffer, buffer + start, keep);
+                break;
+            }
+            
+            if (p - start < (Gua_Length)sizeof(token)) {
+                memcpy(token, buffer + start, p - start);
+                token[p - start] = '\0';
+                x[n] = strtod(token, &end);
+                if (end == token + (p - start)) {
+                    n++;
+                    count++;
+                    if (n == NUMERIC_STATS_CHUNK) {
+                        Numeric_StatsAdd(s, x, n);
+                        n = 0;
+                    }
+                }
+            }
+        }
+    } while (got > 0);
+    
+    if (n > 0) {
+        Numeric_StatsAdd(s, x, n);
+    }
+    
+    Gua_Free(x);
+    Gua_Free(buffer);
+    
+    return count;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Numeric_StatsAddObject(Numeric_Stats *s, Gua_Object *a, Gua_Object *object, Gua_String error)
+ *
+ * Description:
+ *     Add a number, the elements of a matrix or array, or the numbers of
+ *     a file to the accumulator.
+ *
+ * Arguments:
+ *     s,         the accumulator;
+ *     a,         the values;
+ *     object,    a structure containing the number of values added;
+ *     error,     a pointer to the error message.
+ *
+ * Results:
+ *     The accumulator holds the new values. Array elements that are not
+ *     numbers are skipped.
+ */
+Gua_Status Numeric_StatsAddObject(Numeric_Stats *s, Gua_Object *a, Gua_Object *object, Gua_String error)
+{
+    Gua_Element *element;
+    Gua_Real *x;
+    Gua_Real count;
+    Gua_Length rows;
+    Gua_Length cols;
+    Gua_Length n;
+    Gua_String errMessage;
+    
+    count = 0.0;
+    
+    if ((Gua_PObjectType(a) == OBJECT_TYPE_INTEGER) || (Gua_PObjectType(a) == OBJECT_TYPE_REAL)) {
+        x = (Gua_Real *)Gua_Alloc(2 * sizeof(Gua_Real));
+        x[0] = Gua_PObjectType(a) == OBJECT_TYPE_INTEGER ? Gua_PObjectToInteger(a) : Gua_PObjectToReal(a);
+        Numeric_StatsAdd(s, x, 1);
+        Gua_Free(x);
+        count = 1.0;
+    } else if (Gua_PObjectType(a) == OBJECT_TYPE_MATRIX) {
+        x = Matrix_GetRealBuffer(a, &rows, &cols);
+        if (x == NULL) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "the matrix must be a real matrix");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        Numeric_StatsAdd(s, x, rows * cols);
+        Gua_Free(x);
+        count = rows * cols;
+    } else if (Gua_PObjectType(a) == OBJECT_TYPE_ARRAY) {
+        x = (Gua_Real *)Gua_Alloc(NUMERIC_STATS_CHUNK * sizeof(Gua_Real));
+        n = 0;
+        for (element = (Gua_Element *)Gua_PObjectToArray(a); element != NULL; element = (Gua_Element *)element->next) {
+            if (Gua_ObjectType(element->object) == OBJECT_TYPE_INTEGER) {
+                x[n++] = Gua_ObjectToInteger(element->object);
+            } else if (Gua_ObjectType(element->object) == OBJECT_TYPE_REAL) {
+                x[n++] = Gua_ObjectToReal(element->object);
+            } else {
+                continue;
+            }
+            count++;
+            if (n == NUMERIC_STATS_CHUNK) {
+                Numeric_StatsAdd(s, x, n);
+                n = 0;
+            }
+        }
+        Numeric_StatsAdd(s, x, n);
+        Gua_Free(x);
+    } else if (Gua_PObjectType(a) == OBJECT_TYPE_FILE) {
+        count = Numeric_StatsAddFile(s, (Gua_File *)Gua_PObjectToFile(a));
+    } else {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s...\n", "illegal argument 2");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    Gua_IntegerToPObject(object, (Gua_Integer)count);
+    
+    return GUA_OK;
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     void Numeric_StatsToPObject(Numeric_Stats *s, Gua_Object *object)
+ *
+ * Description:
+ *     Return the summary of an accumulator as an array indexed by the
+ *     names count, mean, variance, std, skewness, kurtosis, min and max,
+ *     and also below and above, the number of values out of the
+ *     histogram limits, if there is a histogram.
+ *
+ * Arguments:
+ *     s,         the accumulator;
+ *     object,    a structure containing the new array.
+ *
+ * Results:
+ *     The variance is the sample variance, and the kurtosis is the
+ *     excess kurtosis.
+ */
+void Numeric_StatsToPObject(Numeric_Stats *s, Gua_Object *object)
+{
+    Gua_Object key;
+    Gua_Object value;
+    Gua_String name[10] = {"count", "mean", "variance", "std", "skewness", "kurtosis", "min", "max", "below", "above"};
+    Gua_Real x[10];
+    Gua_Short n;
+    Gua_Short i;
+    
+    x[0] = s->count;
+    x[1] = s->count > 0.0 ? s->mean : NAN;
+    x[2] = s->count > 1.0 ? s->m2 / (s->count - 1.0) : (s->count > 0.0 ? 0.0 : NAN);
+    x[3] = sqrt(x[2]);
+    x[4] = s->m2 > 0.0 ? sqrt(s->count) * s->m3 / pow(s->m2, 1.5) : (s->count > 0.0 ? 0.0 : NAN);
+    x[5] = s->m2 > 0.0 ? s->count * s->m4 / (s->m2 * s->m2) - 3.0 : (s->count > 0.0 ? 0.0 : NAN);
+    x[6] = s->count > 0.0 ? s->min : NAN;
+    x[7] = s->count > 0.0 ? s->max : NAN;
+    x[8] = s->below;
+    x[9] = s->above;
+    
+    n = s->bins > 0 ? 10 : 8;
+    
+    Gua_ClearPObject(object);
+    
+    for (i = 0; i < n; i++) {
+        Gua_LinkStringToObject(key, name[i]);
+        Gua_SetStoredObject(key);
+        if ((i == 0) || (i > 7)) {
+            Gua_IntegerToObject(value, (Gua_Integer)x[i]);
+        } else {
+            Gua_RealToObject(value, x[i]);
+        }
+        Gua_SetArrayElement(object, &key, &value, false);
+    }
+}
+
+/**
+ * Group:
+ *     C
+ *
+ * Function:
+ *     Gua_Status Numeric_NumericFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object *argv, Gua_Object *object, Gua_String error)
+ *
+ * Description:
+ *     Numeric computation functions wrapper.
+ *
+ * Arguments:
+ *     nspace,    a pointer to a structure Gua_Namespace. Must do a cast before use it;
+ *     argc,      the number of arguments to pass to the function;
+ *     argv,      an array containing the arguments to the function;
+ *                argv[0] is the function name;
+ *     object,    a structure containing the return object of the function;
+ *     error,     a pointer to the error message.
+ *
+ * Results:
+ *     The return object of the wrapped function.
+ */
+Gua_Status Numeric_NumericFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object *argv, Gua_Object *object, Gua_String error)
+{
+    Numeric_Stats *stats;
+    Numeric_Stats *other;
+    Gua_Handle *h;
+    Gua_Real *x;
+    Gua_Length rows;
+    Gua_Length cols;
+    Gua_Length n;
+    Gua_Real eps;
+    Gua_Real tolerance;
+    Gua_Matrix *m1;
+    Gua_Matrix *m2;
+    Gua_Object history;
+    Gua_Object output;
+    Gua_Object right;
+    Gua_Short method;
+    Gua_Short preconditioner;
+    Gua_Short last;
+    Gua_String errMessage;
+    
+    Gua_ClearPObject(object);
+    Gua_ClearObject(history);
+    Gua_ClearObject(output);
+    Gua_ClearObject(right);
+
+    if (argc == 0) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s\n", "no function specified");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+        
+        return GUA_ERROR;
+    }
+    
+    if (strcmp(Gua_ObjectToString(argv[0]), "gaussLSS") == 0) {
+        if (argc != 3) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (Gua_ObjectType(argv[2]) != OBJECT_TYPE_MATRIX) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        m1 = (Gua_Matrix *)Gua_ObjectToMatrix(argv[1]);
+        m2 = (Gua_Matrix *)Gua_ObjectToMatrix(argv[2]);
+        
+        if (m1->dimv[0] != m2->dimv[0]) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "the matrices do not have compatible dimensions");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (m2->dimv[1] != 1) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "the matrices do not have compatible dimensions");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Numeric_GaussLSS(&argv[1], &argv[2], object, error) != GUA_OK) {
+            return GUA_ERROR;
+        }
+    } else if ((strcmp(Gua_ObjectToString(argv[0]), "bicgstabLSS") == 0) || (strcmp(Gua_ObjectToString(argv[0]), "cgLSS") == 0) || (strcmp(Gua_ObjectToString(argv[0]), "gmresLSS") == 0)) {
+        if (strcmp(Gua_ObjectToString(argv[0]), "cgLSS") == 0) {
+            method = NUMERIC_METHOD_CG;
+        } else if (strcmp(Gua_ObjectToString(argv[0]), "bicgstabLSS") == 0) {
+            method = NUMERIC_METHOD_BICGSTAB;
+        } else {
+            method = NUMERIC_METHOD_GMRES;
+        }
+        
+        /* Only gmresLSS takes the restart length, before the history variable. */
+        last = method == NUMERIC_METHOD_GMRES ? 7 : 6;
+        
+        if ((argc < 3) || (argc > last + 1)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if ((argc > 3) && (Gua_ObjectType(argv[3]) != OBJECT_TYPE_INTEGER) && (Gua_ObjectType(argv[3]) != OBJECT_TYPE_REAL)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 3 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if ((argc > 4) && (Gua_ObjectType(argv[4]) != OBJECT_TYPE_INTEGER)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 4 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if ((argc > 5) && (Gua_ObjectType(argv[5]) != OBJECT_TYPE_STRING)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 5 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if ((argc > 6) && (method == NUMERIC_METHOD_GMRES) && ((Gua_ObjectType(argv[6]) != OBJECT_TYPE_INTEGER) || (Gua_ObjectToInteger(argv[6]) < 1))) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 6 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if ((argc > last) && (Gua_ObjectType(argv[last]) != OBJECT_TYPE_STRING)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %d %s %-.20s...\n", "illegal argument", last, "for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        tolerance = NUMERIC_TOLERANCE;
+        if (argc > 3) {
+            tolerance = Gua_ObjectType(argv[3]) == OBJECT_TYPE_INTEGER ? Gua_ObjectToInteger(argv[3]) : Gua_ObjectToReal(argv[3]);
+        }
+        
+        preconditioner = NUMERIC_PRECONDITIONER_NONE;
+        if (argc > 5) {
+            if (strcmp(Gua_ObjectToString(argv[5]), "jacobi") == 0) {
+                preconditioner = NUMERIC_PRECONDITIONER_JACOBI;
+            } else if (strcmp(Gua_ObjectToString(argv[5]), "ilu") == 0) {
+                preconditioner = NUMERIC_PRECONDITIONER_ILU;
+            } else if (strcmp(Gua_ObjectToString(argv[5]), "none") != 0) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 5 for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+        }
+        
+        if (Numeric_IterativeLSS(&argv[1], &argv[2], method, tolerance, argc > 4 ? Gua_ObjectToInteger(argv[4]) : -1, preconditioner, (argc > 6) && (method == NUMERIC_METHOD_GMRES) ? Gua_ObjectToInteger(argv[6]) : NUMERIC_GMRES_RESTART, object, &history, error) != GUA_OK) {
+            return GUA_ERROR;
+        }
+        
+        if (argc > last) {
+            if (Gua_SetVariable((Gua_Namespace *)nspace, Gua_ObjectToString(argv[last]), &history, SCOPE_STACK) != GUA_OK) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "can't set variable", Gua_ObjectToString(argv[last]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+            }
+        } else {
+            Gua_FreeObject(&history);
+        }
+    } else if ((strcmp(Gua_ObjectToString(argv[0]), "fft") == 0) || (strcmp(Gua_ObjectToString(argv[0]), "ifft") == 0) || (strcmp(Gua_ObjectToString(argv[0]), "irfft") == 0) || (strcmp(Gua_ObjectToString(argv[0]), "rfft") == 0)) {
+        if ((argc < 2) || (argc > 3)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if ((argc == 3) && (Gua_ObjectType(argv[2]) != OBJECT_TYPE_INTEGER)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (strcmp(Gua_ObjectToString(argv[0]), "fft") == 0) {
+            method = NUMERIC_FFT_FORWARD;
+        } else if (strcmp(Gua_ObjectToString(argv[0]), "ifft") == 0) {
+            method = NUMERIC_FFT_INVERSE;
+        } else if (strcmp(Gua_ObjectToString(argv[0]), "rfft") == 0) {
+            method = NUMERIC_FFT_REAL;
+        } else {
+            method = NUMERIC_FFT_INVERSE_REAL;
+        }
+        
+        if (Numeric_Transform(&argv[1], method, argc == 3 ? Gua_ObjectToInteger(argv[2]) : -1, object, error) != GUA_OK) {
+            return GUA_ERROR;
+        }
+    } else if ((strcmp(Gua_ObjectToString(argv[0]), "conv") == 0) || (strcmp(Gua_ObjectToString(argv[0]), "xcorr") == 0)) {
+        if (argc != 3) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (Gua_ObjectType(argv[2]) != OBJECT_TYPE_MATRIX) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Numeric_Convolve(&argv[1], &argv[2], strcmp(Gua_ObjectToString(argv[0]), "xcorr") == 0, object, error) != GUA_OK) {
+            return GUA_ERROR;
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "lstsq") == 0) {
+        if ((argc < 3) || (argc > 4)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (Gua_ObjectType(argv[2]) != OBJECT_TYPE_MATRIX) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if ((argc == 4) && (Gua_ObjectType(argv[3]) != OBJECT_TYPE_STRING)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 3 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Numeric_LeastSquares(&argv[1], &argv[2], object, argc == 4 ? &output : NULL, error) != GUA_OK) {
+            return GUA_ERROR;
+        }
+        
+        if (argc == 4) {
+            if (Gua_SetVariable((Gua_Namespace *)nspace, Gua_ObjectToString(argv[3]), &output, SCOPE_STACK) != GUA_OK) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "can't set variable", Gua_ObjectToString(argv[3]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+            }
+        }
+    } else if ((strcmp(Gua_ObjectToString(argv[0]), "ode45") == 0) || (strcmp(Gua_ObjectToString(argv[0]), "rk4") == 0)) {
+        if ((argc < 4) || (argc > 5)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_STRING) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (Gua_ObjectType(argv[2]) != OBJECT_TYPE_MATRIX) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (!((Gua_ObjectType(argv[3]) == OBJECT_TYPE_INTEGER) || (Gua_ObjectType(argv[3]) == OBJECT_TYPE_REAL) || (Gua_ObjectType(argv[3]) == OBJECT_TYPE_MATRIX))) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 3 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if ((argc == 5) && !((Gua_ObjectType(argv[4]) == OBJECT_TYPE_INTEGER) || (Gua_ObjectType(argv[4]) == OBJECT_TYPE_REAL))) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 4 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Numeric_SolveODE(nspace, strcmp(Gua_ObjectToString(argv[0]), "rk4") == 0 ? NUMERIC_ODE_RK4 : NUMERIC_ODE_DORMAND_PRINCE, &argv[1], &argv[2], &argv[3], argc == 5 ? &argv[4] : NULL, object, error) != GUA_OK) {
+            return GUA_ERROR;
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "qr") == 0) {
+        if ((argc < 2) || (argc > 3)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if ((argc == 3) && (Gua_ObjectType(argv[2]) != OBJECT_TYPE_STRING)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Numeric_QRDecomposition(&argv[1], argc == 3 ? &output : NULL, object, error) != GUA_OK) {
+            return GUA_ERROR;
+        }
+        
+        if (argc == 3) {
+            if (Gua_SetVariable((Gua_Namespace *)nspace, Gua_ObjectToString(argv[2]), &output, SCOPE_STACK) != GUA_OK) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "can't set variable", Gua_ObjectToString(argv[2]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+            }
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "eig") == 0) {
+        if ((argc < 2) || (argc > 3)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if ((argc == 3) && (Gua_ObjectType(argv[2]) != OBJECT_TYPE_STRING)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Numeric_EigenDecomposition(&argv[1], object, argc == 3 ? &output : NULL, error) != GUA_OK) {
+            return GUA_ERROR;
+        }
+        
+        if (argc == 3) {
+            if (Gua_SetVariable((Gua_Namespace *)nspace, Gua_ObjectToString(argv[2]), &output, SCOPE_STACK) != GUA_OK) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "can't set variable", Gua_ObjectToString(argv[2]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+            }
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "statsAdd") == 0) {
+        if (argc != 3) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        stats = Numeric_GetStats(&argv[1]);
+        if (stats == NULL) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
         
-        return GUA_ERROR;
-    }
-    
-    if (strcmp(Gua_ObjectToString(argv[0]), "gaussLSS") == 0) {
+        if (Numeric_StatsAddObject(stats, &argv[2], object, error) != GUA_OK) {
+            return GUA_ERROR;
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "statsFree") == 0) {
+        if (argc != 2) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        stats = Numeric_GetStats(&argv[1]);
+        if (stats == NULL) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        Numeric_FreeStats(stats);
+        
+        Gua_SetHandlePointer((Gua_Handle *)Gua_ObjectToHandle(argv[1]), NULL);
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "statsHistogram") == 0) {
+        if (argc != 2) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        stats = Numeric_GetStats(&argv[1]);
+        if (stats == NULL) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if (stats->bins == 0) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s...\n", "the accumulator has no histogram");
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        Matrix_RealBufferToPObject(object, stats->histogram, 1, stats->bins);
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "statsMerge") == 0) {
         if (argc != 3) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
             sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
@@ -266,7 +5447,8 @@ Gua_Status Numeric_NumericFunctionWrapper(void *nspace, Gua_Short argc, Gua_Obje
             return GUA_ERROR;
         }
         
-        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
+        stats = Numeric_GetStats(&argv[1]);
+        if (stats == NULL) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
             sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
@@ -274,7 +5456,8 @@ Gua_Status Numeric_NumericFunctionWrapper(void *nspace, Gua_Short argc, Gua_Obje
             
             return GUA_ERROR;
         }
-        if (Gua_ObjectType(argv[2]) != OBJECT_TYPE_MATRIX) {
+        other = Numeric_GetStats(&argv[2]);
+        if (other == NULL) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
             sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
@@ -283,29 +5466,187 @@ Gua_Status Numeric_NumericFunctionWrapper(void *nspace, Gua_Short argc, Gua_Obje
             return GUA_ERROR;
         }
         
-        m1 = (Gua_Matrix *)Gua_ObjectToMatrix(argv[1]);
-        m2 = (Gua_Matrix *)Gua_ObjectToMatrix(argv[2]);
+        if (Numeric_StatsMerge(stats, other, error) != GUA_OK) {
+            return GUA_ERROR;
+        }
         
-        if (m1->dimv[0] != m2->dimv[0]) {
+        Gua_IntegerToPObject(object, (Gua_Integer)stats->count);
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "statsNew") == 0) {
+        if ((argc != 1) && (argc != 4)) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "the matrices do not have compatible dimensions");
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
             Gua_Free(errMessage);
             
             return GUA_ERROR;
         }
-        if (m2->dimv[1] != 1) {
+        
+        if (argc == 4) {
+            if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_INTEGER) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+            if (!((Gua_ObjectType(argv[2]) == OBJECT_TYPE_INTEGER) || (Gua_ObjectType(argv[2]) == OBJECT_TYPE_REAL))) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+            if (!((Gua_ObjectType(argv[3]) == OBJECT_TYPE_INTEGER) || (Gua_ObjectType(argv[3]) == OBJECT_TYPE_REAL))) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 3 for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+            if ((Gua_ObjectToInteger(argv[1]) < 1) || !((Gua_ObjectType(argv[3]) == OBJECT_TYPE_INTEGER ? Gua_ObjectToInteger(argv[3]) : Gua_ObjectToReal(argv[3])) > (Gua_ObjectType(argv[2]) == OBJECT_TYPE_INTEGER ? Gua_ObjectToInteger(argv[2]) : Gua_ObjectToReal(argv[2])))) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s...\n", "the histogram needs at least one bin and a lower limit below the upper limit");
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+            
+            stats = Numeric_NewStats(Gua_ObjectToInteger(argv[1]), (Gua_ObjectType(argv[2]) == OBJECT_TYPE_INTEGER ? Gua_ObjectToInteger(argv[2]) : Gua_ObjectToReal(argv[2])), (Gua_ObjectType(argv[3]) == OBJECT_TYPE_INTEGER ? Gua_ObjectToInteger(argv[3]) : Gua_ObjectToReal(argv[3])));
+        } else {
+            stats = Numeric_NewStats(0, 0.0, 0.0);
+        }
+        
+        Gua_NewHandle(h, "Numeric_Stats", stats);
+        
+        Gua_HandleToPObject(object, (struct Gua_Handle *)h);
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "statsQuantile") == 0) {
+        if (argc != 3) {
             errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
-            sprintf(errMessage, "%s...\n", "the matrices do not have compatible dimensions");
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
             strcat(error, errMessage);
             Gua_Free(errMessage);
             
             return GUA_ERROR;
         }
         
-        if (Numeric_GaussLSS(&argv[1], &argv[2], object, error) != GUA_OK) {
+        stats = Numeric_GetStats(&argv[1]);
+        if (stats == NULL) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (((Gua_ObjectType(argv[2]) == OBJECT_TYPE_INTEGER) || (Gua_ObjectType(argv[2]) == OBJECT_TYPE_REAL))) {
+            Gua_RealToPObject(object, Numeric_StatsQuantile(stats, (Gua_ObjectType(argv[2]) == OBJECT_TYPE_INTEGER ? Gua_ObjectToInteger(argv[2]) : Gua_ObjectToReal(argv[2]))));
+        } else if (Gua_ObjectType(argv[2]) == OBJECT_TYPE_MATRIX) {
+            x = Matrix_GetRealBuffer(&argv[2], &rows, &cols);
+            if (x == NULL) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+                
+                return GUA_ERROR;
+            }
+            
+            for (n = 0; n < rows * cols; n++) {
+                x[n] = Numeric_StatsQuantile(stats, x[n]);
+            }
+            
+            Matrix_RealBufferToPObject(object, x, rows, cols);
+            
+            Gua_Free(x);
+        } else {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "statsSummary") == 0) {
+        if (argc != 2) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        stats = Numeric_GetStats(&argv[1]);
+        if (stats == NULL) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        Numeric_StatsToPObject(stats, object);
+    } else if (strcmp(Gua_ObjectToString(argv[0]), "svd") == 0) {
+        if ((argc < 2) || (argc > 4)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Gua_ObjectType(argv[1]) != OBJECT_TYPE_MATRIX) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if ((argc > 2) && (Gua_ObjectType(argv[2]) != OBJECT_TYPE_STRING)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        if ((argc > 3) && (Gua_ObjectType(argv[3]) != OBJECT_TYPE_STRING)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 3 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        
+        if (Numeric_SingularValueDecomposition(&argv[1], object, argc > 2 ? &output : NULL, argc > 3 ? &right : NULL, error) != GUA_OK) {
             return GUA_ERROR;
         }
+        
+        if (argc > 2) {
+            if (Gua_SetVariable((Gua_Namespace *)nspace, Gua_ObjectToString(argv[2]), &output, SCOPE_STACK) != GUA_OK) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "can't set variable", Gua_ObjectToString(argv[2]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+            }
+        }
+        if (argc > 3) {
+            if (Gua_SetVariable((Gua_Namespace *)nspace, Gua_ObjectToString(argv[3]), &right, SCOPE_STACK) != GUA_OK) {
+                errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+                sprintf(errMessage, "%s %-.20s...\n", "can't set variable", Gua_ObjectToString(argv[3]));
+                strcat(error, errMessage);
+                Gua_Free(errMessage);
+            }
+        }
     } else if (strcmp(Gua_ObjectToString(argv[0]), "epsilon") == 0) {
         eps = 1.0;
         
@@ -358,12 +5699,166 @@ Gua_Status Numeric_Init(void *nspace, int argc, char *argv[], char **env, Gua_St
         Gua_Free(errMessage);
     }
     Gua_LinkCFunctionToFunction(function, Numeric_NumericFunctionWrapper);
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "bicgstabLSS", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "bicgstabLSS");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    Gua_LinkCFunctionToFunction(function, Numeric_NumericFunctionWrapper);
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "cgLSS", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "cgLSS");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    Gua_LinkCFunctionToFunction(function, Numeric_NumericFunctionWrapper);
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "gmresLSS", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "gmresLSS");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    Gua_LinkCFunctionToFunction(function, Numeric_NumericFunctionWrapper);
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "conv", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "conv");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    Gua_LinkCFunctionToFunction(function, Numeric_NumericFunctionWrapper);
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "eig", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "eig");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    Gua_LinkCFunctionToFunction(function, Numeric_NumericFunctionWrapper);
     if (Gua_SetFunction((Gua_Namespace *)nspace, "epsilon", &function) != GUA_OK) {
         errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
         sprintf(errMessage, "%s %-.20s...\n", "can't set function", "epsilon");
         strcat(error, errMessage);
         Gua_Free(errMessage);
     }
+    Gua_LinkCFunctionToFunction(function, Numeric_NumericFunctionWrapper);
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "fft", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "fft");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    Gua_LinkCFunctionToFunction(function, Numeric_NumericFunctionWrapper);
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "ifft", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "ifft");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    Gua_LinkCFunctionToFunction(function, Numeric_NumericFunctionWrapper);
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "irfft", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "irfft");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    Gua_LinkCFunctionToFunction(function, Numeric_NumericFunctionWrapper);
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "lstsq", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "lstsq");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    Gua_LinkCFunctionToFunction(function, Numeric_NumericFunctionWrapper);
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "ode45", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "ode45");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    Gua_LinkCFunctionToFunction(function, Numeric_NumericFunctionWrapper);
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "qr", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "qr");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    Gua_LinkCFunctionToFunction(function, Numeric_NumericFunctionWrapper);
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "rfft", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "rfft");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    Gua_LinkCFunctionToFunction(function, Numeric_NumericFunctionWrapper);
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "rk4", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "rk4");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    Gua_LinkCFunctionToFunction(function, Numeric_NumericFunctionWrapper);
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "statsAdd", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "statsAdd");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    Gua_LinkCFunctionToFunction(function, Numeric_NumericFunctionWrapper);
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "statsFree", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "statsFree");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    Gua_LinkCFunctionToFunction(function, Numeric_NumericFunctionWrapper);
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "statsHistogram", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "statsHistogram");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    Gua_LinkCFunctionToFunction(function, Numeric_NumericFunctionWrapper);
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "statsMerge", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "statsMerge");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    Gua_LinkCFunctionToFunction(function, Numeric_NumericFunctionWrapper);
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "statsNew", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "statsNew");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    Gua_LinkCFunctionToFunction(function, Numeric_NumericFunctionWrapper);
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "statsQuantile", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "statsQuantile");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    Gua_LinkCFunctionToFunction(function, Numeric_NumericFunctionWrapper);
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "statsSummary", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "statsSummary");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    Gua_LinkCFunctionToFunction(function, Numeric_NumericFunctionWrapper);
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "svd", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "svd");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
+    Gua_LinkCFunctionToFunction(function, Numeric_NumericFunctionWrapper);
+    if (Gua_SetFunction((Gua_Namespace *)nspace, "xcorr", &function) != GUA_OK) {
+        errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+        sprintf(errMessage, "%s %-.20s...\n", "can't set function", "xcorr");
+        strcat(error, errMessage);
+        Gua_Free(errMessage);
+    }
     
     Gua_RealToObject(object, NUMERIC_GOLDEN_NUMBER);
     Gua_SetStoredObject(object);
@@ -121,7 +121,7 @@ int Sqlite_Callback(void *argument, int n, char **value, char **key)
         }
         
         p = args->script;
-        p = Gua_Evaluate((Gua_Namespace *)(args->nspace), p, &object, &status, error);
+        p = Gua_CachedEvaluate((Gua_Namespace *)(args->nspace), p, &object, &status, error);
         if (!Gua_IsObjectStored(object)) {
             Gua_FreeObject(&object);
         }
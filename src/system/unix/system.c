@@ -461,6 +461,8 @@ Gua_Status System_LoadFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object *
 Gua_Status System_PrintFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object *argv, Gua_Object *object, Gua_String error)
 {
     Gua_Object objectAsString;
+    Gua_Char number[GUA_NUMBER_SIZE * 2 + 4];
+    Gua_Short precision;
     Gua_String errMessage;
         
     Gua_ClearObject(objectAsString);
@@ -474,7 +476,7 @@ Gua_Status System_PrintFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object
         return GUA_ERROR;
     }
     
-    if (argc > 2) {
+    if (argc > 3) {
         errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
         sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
         strcat(error, errMessage);
@@ -483,6 +485,20 @@ Gua_Status System_PrintFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object
         return GUA_ERROR;
     }
     
+    precision = GUA_SHORTEST_PRECISION;
+    
+    if (argc == 3) {
+        if ((Gua_ObjectType(argv[2]) != OBJECT_TYPE_INTEGER) || (Gua_ObjectToInteger(argv[2]) < 0)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        precision = Gua_ObjectToInteger(argv[2]);
+    }
+    
     if (!((Gua_ObjectType(argv[1]) == OBJECT_TYPE_INTEGER) || (Gua_ObjectType(argv[1]) == OBJECT_TYPE_REAL) || (Gua_ObjectType(argv[1]) == OBJECT_TYPE_COMPLEX) || (Gua_ObjectType(argv[1]) == OBJECT_TYPE_STRING) || (Gua_ObjectType(argv[1]) == OBJECT_TYPE_ARRAY) || (Gua_ObjectType(argv[1]) == OBJECT_TYPE_MATRIX) || (Gua_ObjectType(argv[1]) == OBJECT_TYPE_FILE))) {
         errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
         sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
@@ -494,34 +510,18 @@ Gua_Status System_PrintFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object
     
     Gua_StringToPObject(object, " ");
 
-    if (argc == 2) {
-        if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_INTEGER) {
-            printf("%ld", Gua_ObjectToInteger(argv[1]));
-        } else if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_REAL) {
-            if (fabs(Gua_ObjectToReal(argv[1])) >= ZERO) {
-                printf("%g", Gua_ObjectToReal(argv[1]));
-            } else {
-                printf("%g", 0.0);
-            }
-        } else if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_COMPLEX) {
-            if (fabs(Gua_ObjectToReal(argv[1])) >= ZERO) {
-                printf("%g", Gua_ObjectToReal(argv[1]));
-            } else {
-                printf("%g", 0.0);
-            }
-            if (fabs(Gua_ObjectToImaginary(argv[1])) >= ZERO) {
-                printf("%+g*i", Gua_ObjectToImaginary(argv[1]));
-            } else {
-                printf("%+g*i", 0.0);
-            }
+    if (argc >= 2) {
+        if ((Gua_ObjectType(argv[1]) == OBJECT_TYPE_INTEGER) || (Gua_ObjectType(argv[1]) == OBJECT_TYPE_REAL) || (Gua_ObjectType(argv[1]) == OBJECT_TYPE_COMPLEX)) {
+            Gua_FormatObject(number, &argv[1], precision);
+            printf("%s", number);
         } else if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_STRING) {
             printf("%s", Gua_ObjectToString(argv[1]));
         } else if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_ARRAY) {
-            Gua_ArrayToString(&argv[1], &objectAsString);
+            Gua_FormatArray(&argv[1], &objectAsString, precision);
             printf("%s", Gua_ObjectToString(objectAsString));
             Gua_FreeObject(&objectAsString);
         } else if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_MATRIX) {
-            Gua_MatrixToString(&argv[1], &objectAsString);
+            Gua_FormatMatrix(&argv[1], &objectAsString, precision);
             printf("%s", Gua_ObjectToString(objectAsString));
             Gua_FreeObject(&objectAsString);
         } else if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_FILE) {
@@ -558,6 +558,8 @@ Gua_Status System_PrintFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object
 Gua_Status System_PrintlnFunctionWrapper(void *nspace, Gua_Short argc, Gua_Object *argv, Gua_Object *object, Gua_String error)
 {
     Gua_Object objectAsString;
+    Gua_Char number[GUA_NUMBER_SIZE * 2 + 4];
+    Gua_Short precision;
     Gua_String errMessage;
     
     Gua_ClearObject(objectAsString);
@@ -571,7 +573,7 @@ Gua_Status System_PrintlnFunctionWrapper(void *nspace, Gua_Short argc, Gua_Objec
         return GUA_ERROR;
     }
     
-    if (argc > 2) {
+    if (argc > 3) {
         errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
         sprintf(errMessage, "%s %-.20s...\n", "wrong number of arguments for function", Gua_ObjectToString(argv[0]));
         strcat(error, errMessage);
@@ -580,6 +582,20 @@ Gua_Status System_PrintlnFunctionWrapper(void *nspace, Gua_Short argc, Gua_Objec
         return GUA_ERROR;
     }
     
+    precision = GUA_SHORTEST_PRECISION;
+    
+    if (argc == 3) {
+        if ((Gua_ObjectType(argv[2]) != OBJECT_TYPE_INTEGER) || (Gua_ObjectToInteger(argv[2]) < 0)) {
+            errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
+            sprintf(errMessage, "%s %-.20s...\n", "illegal argument 2 for function", Gua_ObjectToString(argv[0]));
+            strcat(error, errMessage);
+            Gua_Free(errMessage);
+            
+            return GUA_ERROR;
+        }
+        precision = Gua_ObjectToInteger(argv[2]);
+    }
+    
     if (!((Gua_ObjectType(argv[1]) == OBJECT_TYPE_INTEGER) || (Gua_ObjectType(argv[1]) == OBJECT_TYPE_REAL) || (Gua_ObjectType(argv[1]) == OBJECT_TYPE_COMPLEX) || (Gua_ObjectType(argv[1]) == OBJECT_TYPE_STRING) || (Gua_ObjectType(argv[1]) == OBJECT_TYPE_ARRAY) || (Gua_ObjectType(argv[1]) == OBJECT_TYPE_MATRIX) || (Gua_ObjectType(argv[1]) == OBJECT_TYPE_FILE))) {
         errMessage = (Gua_String) Gua_Alloc(sizeof(char) * MAX_ERROR_MSG_SIZE + 1);
         sprintf(errMessage, "%s %-.20s...\n", "illegal argument 1 for function", Gua_ObjectToString(argv[0]));
@@ -592,34 +608,18 @@ Gua_Status System_PrintlnFunctionWrapper(void *nspace, Gua_Short argc, Gua_Objec
     Gua_LinkStringToPObject(object, " ");
     Gua_SetStoredPObject(object);
     
-    if (argc == 2) {
-        if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_INTEGER) {
-            printf("%ld\n", Gua_ObjectToInteger(argv[1]));
-        } else if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_REAL) {
-            if (fabs(Gua_ObjectToReal(argv[1])) >= ZERO) {
-                printf("%g\n", Gua_ObjectToReal(argv[1]));
-            } else {
-                printf("%g\n", 0.0);
-            }
-        } else if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_COMPLEX) {
-            if (fabs(Gua_ObjectToReal(argv[1])) >= ZERO) {
-                printf("%g", Gua_ObjectToReal(argv[1]));
-            } else {
-                printf("%g", 0.0);
-            }
-            if (fabs(Gua_ObjectToImaginary(argv[1])) >= ZERO) {
-                printf("%+g*i\n", Gua_ObjectToImaginary(argv[1]));
-            } else {
-                printf("%+g*i\n", 0.0);
-            }
+    if (argc >= 2) {
+        if ((Gua_ObjectType(argv[1]) == OBJECT_TYPE_INTEGER) || (Gua_ObjectType(argv[1]) == OBJECT_TYPE_REAL) || (Gua_ObjectType(argv[1]) == OBJECT_TYPE_COMPLEX)) {
+            Gua_FormatObject(number, &argv[1], precision);
+            printf("%s\n", number);
         } else if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_STRING) {
             printf("%s\n", Gua_ObjectToString(argv[1]));
         } else if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_ARRAY) {
-            Gua_ArrayToString(&argv[1], &objectAsString);
+            Gua_FormatArray(&argv[1], &objectAsString, precision);
             printf("%s\n", Gua_ObjectToString(objectAsString));
             Gua_FreeObject(&objectAsString);
         } else if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_MATRIX) {
-            Gua_MatrixToString(&argv[1], &objectAsString);
+            Gua_FormatMatrix(&argv[1], &objectAsString, precision);
             printf("%s\n", Gua_ObjectToString(objectAsString));
             Gua_FreeObject(&objectAsString);
         } else if (Gua_ObjectType(argv[1]) == OBJECT_TYPE_FILE) {